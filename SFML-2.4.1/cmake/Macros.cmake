@@ -200,6 +200,53 @@ macro(sfml_add_example target)
 
 endmacro()
 
+# add a new target which is a SFML test or benchmark
+# ex: sfml_add_test(test-render-queue
+#                   SOURCES RenderQueue.cpp ...
+#                   DEPENDS sfml-graphics)
+# tests are run by CTest, benchmarks (BENCHMARK option) are only built and run by hand
+macro(sfml_add_test target)
+
+    # parse the arguments
+    cmake_parse_arguments(THIS "BENCHMARK" "" "SOURCES;DEPENDS" ${ARGN})
+
+    # set a source group for the source files
+    source_group("" FILES ${THIS_SOURCES})
+
+    # create the target
+    add_executable(${target} ${THIS_SOURCES})
+
+    # set the debug suffix
+    set_target_properties(${target} PROPERTIES DEBUG_POSTFIX -d)
+
+    # set the target's folder (for IDEs that support it, e.g. Visual Studio)
+    if(THIS_BENCHMARK)
+        set_target_properties(${target} PROPERTIES FOLDER "Benchmarks")
+    else()
+        set_target_properties(${target} PROPERTIES FOLDER "Tests")
+    endif()
+
+    # for gcc >= 4.0 on Windows, apply the SFML_USE_STATIC_STD_LIBS option if it is enabled
+    if(SFML_OS_WINDOWS AND SFML_COMPILER_GCC AND NOT SFML_GCC_VERSION VERSION_LESS "4")
+        if(SFML_USE_STATIC_STD_LIBS AND NOT SFML_COMPILER_GCC_TDM)
+            set_target_properties(${target} PROPERTIES LINK_FLAGS "-static-libgcc -static-libstdc++")
+        elseif(NOT SFML_USE_STATIC_STD_LIBS AND SFML_COMPILER_GCC_TDM)
+            set_target_properties(${target} PROPERTIES LINK_FLAGS "-shared-libgcc -shared-libstdc++")
+        endif()
+    endif()
+
+    # link the target to its SFML dependencies
+    if(THIS_DEPENDS)
+        target_link_libraries(${target} ${THIS_DEPENDS})
+    endif()
+
+    # register the tests (benchmarks take too long and don't pass or fail)
+    if(NOT THIS_BENCHMARK)
+        add_test(NAME ${target} COMMAND ${target})
+    endif()
+
+endmacro()
+
 # macro to find packages on the host OS
 # this is the same as in the toolchain file, which is here for Nsight Tegra VS
 # since it won't use the Android toolchain file
@@ -30,6 +30,8 @@ public:
     m_host(host),
     m_port(port)
     {
+        // Send small chunks as soon as they are captured, to keep the voice latency low
+        setLowLatencyMode(true, sf::milliseconds(20));
     }
 
     ////////////////////////////////////////////////////////////
@@ -39,7 +39,9 @@
 #include <SFML/Audio/SoundBufferRecorder.hpp>
 #include <SFML/Audio/SoundFileFactory.hpp>
 #include <SFML/Audio/SoundFileReader.hpp>
+#include <SFML/Audio/SoundFileTranscoder.hpp>
 #include <SFML/Audio/SoundFileWriter.hpp>
+#include <SFML/Audio/SoundMixer.hpp>
 #include <SFML/Audio/SoundRecorder.hpp>
 #include <SFML/Audio/SoundSource.hpp>
 #include <SFML/Audio/SoundStream.hpp>
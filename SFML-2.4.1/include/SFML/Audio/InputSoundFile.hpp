@@ -178,6 +178,34 @@ public:
     ////////////////////////////////////////////////////////////
     void seek(Time timeOffset);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Build a seek index to make seeking faster
+    ///
+    /// Compressed formats (OGG/Vorbis and FLAC) don't map sample
+    /// offsets to positions in the file, so a seek normally has
+    /// to search the stream. This function scans the whole file
+    /// once and records where decoding can resume for each
+    /// page or frame, so that later seeks jump directly to the
+    /// right place and only decode the few samples before the
+    /// target.
+    ///
+    /// If \a cacheFilename is not empty, the index is loaded
+    /// from this file when it exists and matches the open sound
+    /// file; otherwise it is built and saved there, so that the
+    /// next run doesn't need to scan the file again.
+    ///
+    /// Building the index moves the read position back to the
+    /// beginning of the file, so it should be done right after
+    /// opening it. Formats that can already seek directly (WAV)
+    /// don't need an index; this function returns false for them.
+    ///
+    /// \param cacheFilename Path of the file to load the index from / save it to
+    ///
+    /// \return True if a seek index is in use
+    ///
+    ////////////////////////////////////////////////////////////
+    bool buildSeekIndex(const std::string& cacheFilename = "");
+
     ////////////////////////////////////////////////////////////
     /// \brief Read audio samples from the open file
     ///
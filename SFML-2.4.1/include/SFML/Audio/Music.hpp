@@ -134,6 +134,19 @@ public:
     ////////////////////////////////////////////////////////////
     Time getDuration() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Build a seek index to make setPlayingOffset faster
+    ///
+    /// See sf::InputSoundFile::buildSeekIndex for details.
+    /// The music must be stopped when this function is called.
+    ///
+    /// \param cacheFilename Path of the file to load the index from / save it to
+    ///
+    /// \return True if a seek index is in use
+    ///
+    ////////////////////////////////////////////////////////////
+    bool buildSeekIndex(const std::string& cacheFilename = "");
+
 protected:
 
     ////////////////////////////////////////////////////////////
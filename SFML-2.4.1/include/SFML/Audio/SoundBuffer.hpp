@@ -223,6 +223,18 @@ public:
     ////////////////////////////////////////////////////////////
     SoundBuffer& operator =(const SoundBuffer& right);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Swap the contents of this buffer with those of another
+    ///
+    /// The samples are exchanged without being copied. Sounds
+    /// keep using the same buffer instance, which now holds the
+    /// other audio data; they are stopped by the operation.
+    ///
+    /// \param right Instance to swap with
+    ///
+    ////////////////////////////////////////////////////////////
+    void swap(SoundBuffer& right);
+
 private:
 
     friend class Sound;
@@ -30,6 +30,7 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Audio/Export.hpp>
 #include <string>
+#include <vector>
 
 
 namespace sf
@@ -55,6 +56,20 @@ public:
         unsigned int sampleRate;   ///< Samples rate of the sound, in samples per second
     };
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Entry of a seek index
+    ///
+    /// A seek point associates a sample offset with the position
+    /// in the stream from which decoding can resume at (or just
+    /// before) that sample.
+    ///
+    ////////////////////////////////////////////////////////////
+    struct SeekPoint
+    {
+        Uint64 sampleOffset; ///< Offset of the first sample decoded from this point, including channels
+        Uint64 byteOffset;   ///< Position in the source stream where decoding resumes, in bytes
+    };
+
     ////////////////////////////////////////////////////////////
     /// \brief Virtual destructor
     ///
@@ -100,6 +115,41 @@ public:
     ///
     ////////////////////////////////////////////////////////////
     virtual Uint64 read(Int16* samples, Uint64 maxCount) = 0;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Scan the open file and build its seek index
+    ///
+    /// Readers of formats that cannot seek in constant time can
+    /// override this function to fill \a index with seek points
+    /// sorted by sample offset. The index is then used by the
+    /// reader itself, and can be saved and given back later through
+    /// setSeekIndex to avoid scanning the file again.
+    ///
+    /// After this function returns, the read position is
+    /// back at the beginning of the file.
+    ///
+    /// The default implementation does nothing and returns false.
+    ///
+    /// \param index Array to fill with the seek points
+    ///
+    /// \return True if the index was built, false if the reader doesn't support it
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool buildSeekIndex(std::vector<SeekPoint>& index) {(void)index; return false;}
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Give the reader a previously built seek index
+    ///
+    /// The index must have been built by the same reader type,
+    /// from the same file. An empty index reverts the reader to
+    /// its default seeking strategy.
+    ///
+    /// The default implementation does nothing.
+    ///
+    /// \param index Seek points of the file, sorted by sample offset
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void setSeekIndex(const std::vector<SeekPoint>& index) {(void)index;}
 };
 
 } // namespace sf
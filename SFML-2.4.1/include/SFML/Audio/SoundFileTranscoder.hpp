@@ -0,0 +1,257 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2016 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_SOUNDFILETRANSCODER_HPP
+#define SFML_SOUNDFILETRANSCODER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/Export.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/Time.hpp>
+#include <string>
+#include <vector>
+
+
+namespace sf
+{
+class InputStream;
+class InputSoundFile;
+
+////////////////////////////////////////////////////////////
+/// \brief Convert sound files from one format to another
+///
+////////////////////////////////////////////////////////////
+class SFML_AUDIO_API SoundFileTranscoder : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Throughput counters of the transcoding stages
+    ///
+    ////////////////////////////////////////////////////////////
+    struct SFML_AUDIO_API Statistics
+    {
+        ////////////////////////////////////////////////////////////
+        /// \brief Default constructor
+        ///
+        /// Sets all the counters to zero.
+        ///
+        ////////////////////////////////////////////////////////////
+        Statistics();
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Get the throughput of the decoding stage
+        ///
+        /// \return Number of samples decoded per second of decoding time
+        ///
+        ////////////////////////////////////////////////////////////
+        float getDecodeThroughput() const;
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Get the throughput of the encoding stage
+        ///
+        /// \return Number of samples encoded per second of encoding time
+        ///
+        ////////////////////////////////////////////////////////////
+        float getEncodeThroughput() const;
+
+        unsigned int fileCount;      ///< Number of files successfully transcoded
+        unsigned int failureCount;   ///< Number of files that couldn't be transcoded
+        Uint64       sampleCount;    ///< Number of samples transcoded
+        Time         decodeTime;     ///< Time spent decoding samples
+        Time         encodeTime;     ///< Time spent encoding samples
+        Time         decodeWaitTime; ///< Time the decoding stage spent waiting for a free buffer
+        Time         encodeWaitTime; ///< Time the encoding stage spent waiting for decoded samples
+        Time         elapsedTime;    ///< Wall-clock time spent in the transcoding functions
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    SoundFileTranscoder();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the size of the blocks passed between the stages
+    ///
+    /// The default block size is 16384 frames.
+    ///
+    /// \param frameCount Number of frames per block
+    ///
+    ////////////////////////////////////////////////////////////
+    void setBlockSize(std::size_t frameCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Transcode a sound file to another file
+    ///
+    /// The input file is decoded by any of the registered readers
+    /// and encoded by the writer that matches the extension of the
+    /// output file. Decoding runs in a separate thread, so that it
+    /// overlaps with encoding: while a block of samples is being
+    /// encoded, the next one is decoded into a second buffer.
+    ///
+    /// \param inputFilename  Path of the sound file to read
+    /// \param outputFilename Path of the sound file to write
+    ///
+    /// \return True if the file was successfully transcoded
+    ///
+    ////////////////////////////////////////////////////////////
+    bool transcode(const std::string& inputFilename, const std::string& outputFilename);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Transcode a sound file read from a custom stream
+    ///
+    /// \param inputStream    Source stream to read from
+    /// \param outputFilename Path of the sound file to write
+    ///
+    /// \return True if the file was successfully transcoded
+    ///
+    /// \see transcode
+    ///
+    ////////////////////////////////////////////////////////////
+    bool transcode(InputStream& inputStream, const std::string& outputFilename);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Transcode a list of sound files in parallel
+    ///
+    /// The files are distributed among \a threadCount worker
+    /// threads; each worker transcodes its files one at a time.
+    /// A file that fails doesn't stop the others.
+    ///
+    /// \param inputFilenames  Paths of the sound files to read
+    /// \param outputFilenames Paths of the sound files to write, in the same order
+    /// \param threadCount     Number of worker threads, or 0 to use one per core
+    ///
+    /// \return Number of files successfully transcoded
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t transcodeBatch(const std::vector<std::string>& inputFilenames, const std::vector<std::string>& outputFilenames, unsigned int threadCount = 0);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the counters accumulated by the transcoding functions
+    ///
+    /// In batch mode, the times of the stages are summed over
+    /// all the worker threads. It is safe to call this function
+    /// while a batch is running in another thread: it returns a
+    /// consistent snapshot of the counters.
+    ///
+    /// \return Accumulated statistics
+    ///
+    /// \see resetStatistics
+    ///
+    ////////////////////////////////////////////////////////////
+    Statistics getStatistics() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Reset all the counters to zero
+    ///
+    /// \see getStatistics
+    ///
+    ////////////////////////////////////////////////////////////
+    void resetStatistics();
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Transcode an opened sound file
+    ///
+    /// \param input          Sound file to read
+    /// \param outputFilename Path of the sound file to write
+    /// \param pipelined      True to decode in a separate thread
+    /// \param statistics     Counters to update
+    ///
+    /// \return True if the file was successfully transcoded
+    ///
+    ////////////////////////////////////////////////////////////
+    bool transcodeFile(InputSoundFile& input, const std::string& outputFilename, bool pipelined, Statistics& statistics) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Worker function of the batch mode
+    ///
+    ////////////////////////////////////////////////////////////
+    void processBatch();
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::size_t                     m_blockSize;       ///< Number of frames per block
+    Statistics                      m_statistics;      ///< Accumulated counters
+    const std::vector<std::string>* m_batchInputs;     ///< Input files of the current batch
+    const std::vector<std::string>* m_batchOutputs;    ///< Output files of the current batch
+    std::size_t                     m_batchNext;       ///< Index of the next file of the batch to process
+    std::size_t                     m_batchSuccesses;  ///< Number of files of the batch successfully transcoded
+    mutable Mutex                   m_batchMutex;      ///< Mutex protecting the batch state and the statistics
+};
+
+} // namespace sf
+
+
+#endif // SFML_SOUNDFILETRANSCODER_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::SoundFileTranscoder
+/// \ingroup audio
+///
+/// sf::SoundFileTranscoder streams audio data from any format
+/// supported by sf::InputSoundFile (including custom readers
+/// registered with sf::SoundFileFactory) to any format supported
+/// by sf::OutputSoundFile, without ever loading a whole file
+/// in memory.
+///
+/// A single transcoding runs as a two-stage pipeline: the samples
+/// are decoded in a separate thread into one of two buffers while
+/// the calling thread encodes the other one. The batch mode
+/// converts a list of files on several worker threads at once,
+/// one file per thread, which scales across all the cores of the
+/// machine for build-time conversion of large asset libraries.
+///
+/// The time spent in each stage, as well as the time each stage
+/// spent waiting for the other one, is accumulated in the
+/// statistics of the transcoder.
+///
+/// Usage example:
+/// \code
+/// sf::SoundFileTranscoder transcoder;
+///
+/// // Convert a single file
+/// if (!transcoder.transcode("music.wav", "music.ogg"))
+///     /* error */;
+///
+/// // Convert a whole list of files, using all the cores
+/// std::vector<std::string> inputs, outputs;
+/// ...
+/// std::size_t converted = transcoder.transcodeBatch(inputs, outputs);
+///
+/// sf::SoundFileTranscoder::Statistics stats = transcoder.getStatistics();
+/// std::cout << converted << " files, " << stats.getEncodeThroughput() << " samples/s encoded" << std::endl;
+/// \endcode
+///
+/// \see sf::InputSoundFile, sf::OutputSoundFile
+///
+////////////////////////////////////////////////////////////
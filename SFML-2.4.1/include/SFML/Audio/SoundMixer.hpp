@@ -0,0 +1,445 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2016 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_SOUNDMIXER_HPP
+#define SFML_SOUNDMIXER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/Export.hpp>
+#include <SFML/Audio/SoundStream.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <string>
+#include <vector>
+
+
+namespace sf
+{
+class Sound;
+class SoundBuffer;
+
+////////////////////////////////////////////////////////////
+/// \brief Software mixing bus that plays many sounds
+///        through a single audio source
+///
+////////////////////////////////////////////////////////////
+class SFML_AUDIO_API SoundMixer : public SoundStream
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Identifier of a voice played by the mixer
+    ///
+    ////////////////////////////////////////////////////////////
+    typedef Uint32 VoiceId;
+
+    static const VoiceId InvalidVoice; ///< Identifier returned when a voice couldn't be played
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// The mixer always outputs 16-bit stereo samples.
+    ///
+    /// \param sampleRate Output sample rate of the mixer
+    /// \param maxVoices  Maximum number of voices mixed at the same time
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit SoundMixer(unsigned int sampleRate = 44100, std::size_t maxVoices = 64);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~SoundMixer();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start playing a sound buffer on a new voice
+    ///
+    /// The buffer must be mono or stereo, and it must remain
+    /// alive as long as the voice is playing.
+    ///
+    /// If all the voices are in use, the voice with the lowest
+    /// priority is culled (the quietest one if several voices
+    /// have the same priority) to make room for the new one.
+    /// If the new voice is less important than all the playing
+    /// voices (lower priority, or same priority and quieter),
+    /// it is culled instead and InvalidVoice is returned.
+    ///
+    /// \param buffer   Sound buffer to play
+    /// \param volume   Volume of the voice, in the range [0, 100]
+    /// \param pitch    Pitch of the voice (1 = original pitch)
+    /// \param pan      Panning of the voice, from -1 (left) to 1 (right)
+    /// \param priority Priority of the voice, higher values are culled last
+    /// \param loop     True to loop the voice
+    ///
+    /// \return Identifier of the new voice, or InvalidVoice if it couldn't be played
+    ///
+    ////////////////////////////////////////////////////////////
+    VoiceId playVoice(const SoundBuffer& buffer, float volume = 100.f, float pitch = 1.f, float pan = 0.f, int priority = 0, bool loop = false);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start playing a sound on a new voice
+    ///
+    /// The voice plays the buffer of the sound, starting at its
+    /// current playing offset, with its volume, pitch and loop
+    /// state. The sound itself is not played and can be destroyed,
+    /// but its buffer must remain alive as long as the voice is
+    /// playing.
+    ///
+    /// \param sound    Sound to play
+    /// \param pan      Panning of the voice, from -1 (left) to 1 (right)
+    /// \param priority Priority of the voice, higher values are culled last
+    ///
+    /// \return Identifier of the new voice, or InvalidVoice if it couldn't be played
+    ///
+    /// \see playVoice
+    ///
+    ////////////////////////////////////////////////////////////
+    VoiceId playSound(const Sound& sound, float pan = 0.f, int priority = 0);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start playing a sound stream on a new voice
+    ///
+    /// The mixer pulls the audio data of the stream (sf::Music or
+    /// any custom stream) directly, from its current position and
+    /// with its volume, pitch and loop state, instead of letting
+    /// the stream play through its own audio source. The stream
+    /// must not be played while the voice is playing, and it must
+    /// remain alive as long as the voice is playing. It must be
+    /// mono or stereo.
+    ///
+    /// \param stream   Sound stream to play
+    /// \param pan      Panning of the voice, from -1 (left) to 1 (right)
+    /// \param priority Priority of the voice, higher values are culled last
+    ///
+    /// \return Identifier of the new voice, or InvalidVoice if it couldn't be played
+    ///
+    /// \see playVoice
+    ///
+    ////////////////////////////////////////////////////////////
+    VoiceId playStream(SoundStream& stream, float pan = 0.f, int priority = 0);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Stop a voice
+    ///
+    /// This function does nothing if the voice is not playing.
+    ///
+    /// \param voice Identifier of the voice to stop
+    ///
+    ////////////////////////////////////////////////////////////
+    void stopVoice(VoiceId voice);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Stop all the voices
+    ///
+    ////////////////////////////////////////////////////////////
+    void stopAllVoices();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether a voice is still playing
+    ///
+    /// A voice stops playing when it reaches the end of its
+    /// buffer (unless it loops), when it is stopped or when
+    /// it is culled.
+    ///
+    /// \param voice Identifier of the voice
+    ///
+    /// \return True if the voice is playing
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isVoicePlaying(VoiceId voice) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the volume of a voice
+    ///
+    /// Voices with a volume of 0 are not mixed, but they
+    /// keep advancing.
+    ///
+    /// \param voice  Identifier of the voice
+    /// \param volume New volume, in the range [0, 100]
+    ///
+    ////////////////////////////////////////////////////////////
+    void setVoiceVolume(VoiceId voice, float volume);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the pitch of a voice
+    ///
+    /// \param voice Identifier of the voice
+    /// \param pitch New pitch (1 = original pitch)
+    ///
+    ////////////////////////////////////////////////////////////
+    void setVoicePitch(VoiceId voice, float pitch);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the panning of a voice
+    ///
+    /// \param voice Identifier of the voice
+    /// \param pan   New panning, from -1 (left) to 1 (right)
+    ///
+    ////////////////////////////////////////////////////////////
+    void setVoicePan(VoiceId voice, float pan);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of voices currently playing
+    ///
+    /// \return Number of playing voices
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getVoiceCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of voices culled so far
+    ///
+    /// \return Number of voices that were culled because
+    ///         the maximum number of voices was reached
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint64 getCulledVoiceCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Mix the next frames of all the playing voices
+    ///
+    /// This function is called by the streaming thread while the
+    /// mixer is playing, but it can also be called directly to
+    /// render the voices offline, without any audio output
+    /// (in this case, don't play the mixer).
+    ///
+    /// \param samples    Output buffer, must hold 2 * \a frameCount samples
+    /// \param frameCount Number of stereo frames to mix
+    ///
+    ////////////////////////////////////////////////////////////
+    void mix(Int16* samples, std::size_t frameCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Render the voices offline to an audio file
+    ///
+    /// The voices are mixed as fast as possible, without any
+    /// audio output, and written to a 16-bit stereo file at the
+    /// sample rate of the mixer. The result doesn't depend on
+    /// timing, which makes it suitable for baking mixes and
+    /// for testing. The mixer must be stopped.
+    ///
+    /// The supported audio formats are: WAV, OGG/Vorbis, FLAC.
+    ///
+    /// \param filename Path of the sound file to write
+    /// \param duration Duration of audio to render
+    ///
+    /// \return True if the file was successfully written
+    ///
+    /// \see renderToBuffer, mix
+    ///
+    ////////////////////////////////////////////////////////////
+    bool renderToFile(const std::string& filename, Time duration);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Render the voices offline to a sound buffer
+    ///
+    /// This function works like renderToFile, but it stores
+    /// the result in memory. The mixer must be stopped.
+    ///
+    /// \param buffer   Sound buffer to fill
+    /// \param duration Duration of audio to render
+    ///
+    /// \return True if the buffer was successfully filled
+    ///
+    /// \see renderToFile, mix
+    ///
+    ////////////////////////////////////////////////////////////
+    bool renderToBuffer(SoundBuffer& buffer, Time duration);
+
+protected:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Request a new chunk of audio samples from the stream source
+    ///
+    /// \param data Chunk of data to fill
+    ///
+    /// \return True to continue playback, false to stop
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool onGetData(Chunk& data);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the current playing position in the stream source
+    ///
+    /// The voices are not affected by seeking the mixer.
+    ///
+    /// \param timeOffset New playing position, from the beginning of the stream
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void onSeek(Time timeOffset);
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Voice played by the mixer
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Voice
+    {
+        VoiceId            id;            ///< Identifier of the voice
+        const SoundBuffer* buffer;        ///< Sound buffer played by the voice (NULL for stream voices)
+        SoundStream*       stream;        ///< Sound stream played by the voice (NULL for buffer voices)
+        float              volume;        ///< Volume, in the range [0, 100]
+        float              pitch;         ///< Pitch (1 = original pitch)
+        float              pan;           ///< Panning, from -1 (left) to 1 (right)
+        int                priority;      ///< Priority, higher values are culled last
+        bool               loop;          ///< Loop flag
+        double             position;      ///< Read position in the source, in frames
+        std::vector<Int16> streamSamples; ///< Samples pulled from the stream and not consumed yet
+        bool               streamEnded;   ///< Has the stream reached its end?
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a new voice, culling another one if needed
+    ///
+    /// \param voice Voice to add (its identifier is assigned by the function)
+    ///
+    /// \return Identifier of the new voice, or InvalidVoice if it was culled
+    ///
+    ////////////////////////////////////////////////////////////
+    VoiceId addVoice(Voice& voice);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Find a playing voice
+    ///
+    /// \param voice Identifier of the voice
+    ///
+    /// \return Pointer to the voice, or NULL if it is not playing
+    ///
+    ////////////////////////////////////////////////////////////
+    Voice* findVoice(VoiceId voice);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Mix a voice into the mix buffer
+    ///
+    /// \param voice      Voice to mix
+    /// \param frameCount Number of frames to mix
+    ///
+    /// \return True if the voice is still playing, false if it reached its end
+    ///
+    ////////////////////////////////////////////////////////////
+    bool mixVoice(Voice& voice, std::size_t frameCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Pull audio data from the stream of a voice
+    ///
+    /// \param voice      Stream voice to fill
+    /// \param frameCount Number of source frames that must be available
+    ///
+    ////////////////////////////////////////////////////////////
+    void fillStreamVoice(Voice& voice, std::size_t frameCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Accumulate resampled samples into the mix buffer
+    ///
+    /// \param voice        Voice being mixed
+    /// \param channelCount Number of channels of the voice
+    /// \param frameCount   Number of resampled frames to accumulate
+    ///
+    ////////////////////////////////////////////////////////////
+    void accumulate(const Voice& voice, unsigned int channelCount, std::size_t frameCount);
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<Voice> m_voices;      ///< Playing voices
+    std::size_t        m_maxVoices;   ///< Maximum number of voices
+    VoiceId            m_nextId;      ///< Identifier of the next voice
+    Uint64             m_culledCount; ///< Number of voices culled so far
+    std::vector<float> m_mixBuffer;   ///< Stereo mix buffer
+    std::vector<float> m_voiceBuffer; ///< Resampled samples of the voice being mixed
+    std::vector<Int16> m_samples;     ///< Buffer of samples passed to the stream
+    mutable Mutex      m_mutex;       ///< Mutex protecting the voices
+};
+
+} // namespace sf
+
+
+#endif // SFML_SOUNDMIXER_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::SoundMixer
+/// \ingroup audio
+///
+/// Every sf::Sound uses its own audio source, and audio drivers
+/// only provide a limited number of them (sometimes as few as 32,
+/// on mobile devices); sounds played beyond this limit are silent.
+///
+/// sf::SoundMixer mixes any number of "voices" in software into a
+/// single 16-bit stereo stream, which uses only one audio source.
+/// Each voice plays a sf::SoundBuffer with its own volume, pitch
+/// and panning; the resampling and mixing kernels use SSE2 or NEON
+/// instructions when they are available. Several mixers can be used
+/// at the same time, for example one per category of sounds.
+///
+/// The number of voices mixed at the same time is limited by the
+/// \a maxVoices constructor argument. When it is reached, the voices
+/// with the lowest priority are culled first, so that important
+/// sounds are never dropped in favor of less important ones.
+///
+/// Since sf::SoundMixer is a sf::SoundStream, the mixer itself can
+/// be played, paused and stopped, and its global volume, pitch and
+/// 3D position can be changed like for any other sound source.
+/// Voices are not spatialized individually.
+///
+/// Besides sound buffers, the mixer can play sf::Sound instances
+/// (playSound) and pull the data of any sf::SoundStream such as
+/// sf::Music (playStream), which are then played through the mixer
+/// rather than through their own audio source.
+///
+/// The mixer also provides an offline rendering mode: instead of
+/// playing it, call renderToFile() or renderToBuffer() (or mix()
+/// for raw samples) to mix the voices as fast as the CPU allows,
+/// with no dependency on the audio hardware or on timing. This
+/// is useful to bake mixes and to run audio tests in a fraction
+/// of the duration of the clips.
+///
+/// Usage example:
+/// \code
+/// sf::SoundBuffer explosion;
+/// explosion.loadFromFile("explosion.wav");
+///
+/// sf::SoundMixer mixer;
+/// mixer.play();
+///
+/// // Play hundreds of explosions through a single audio source
+/// for (int i = 0; i < 200; ++i)
+///     mixer.playVoice(explosion, 50.f, 0.8f + i * 0.002f, (i % 20) / 10.f - 1.f);
+///
+/// // Bake a music with some sound effects into a file, offline
+/// sf::SoundMixer baker;
+/// sf::Music music;
+/// music.openFromFile("music.ogg");
+/// baker.playStream(music);
+/// baker.playVoice(explosion);
+/// baker.renderToFile("baked.ogg", music.getDuration());
+/// \endcode
+///
+/// \see sf::Sound, sf::SoundStream
+///
+////////////////////////////////////////////////////////////
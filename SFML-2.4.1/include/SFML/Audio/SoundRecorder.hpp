@@ -31,6 +31,7 @@
 #include <SFML/Audio/Export.hpp>
 #include <SFML/Audio/AlResource.hpp>
 #include <SFML/System/Thread.hpp>
+#include <SFML/System/Mutex.hpp>
 #include <SFML/System/Time.hpp>
 #include <vector>
 #include <string>
@@ -172,6 +173,44 @@ public:
     ////////////////////////////////////////////////////////////
     unsigned int getChannelCount() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the latency of the last chunk of captured samples
+    ///
+    /// The latency is the age of the oldest sample of the last
+    /// chunk forwarded to onProcessSamples, i.e. the time it
+    /// spent waiting in the capture device before being processed.
+    /// It is reset every time a new capture starts.
+    ///
+    /// \return Latency of the last processed chunk
+    ///
+    /// \see getMaxCaptureLatency
+    ///
+    ////////////////////////////////////////////////////////////
+    Time getCaptureLatency() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the highest latency observed since the capture started
+    ///
+    /// \return Highest latency of all the processed chunks
+    ///
+    /// \see getCaptureLatency
+    ///
+    ////////////////////////////////////////////////////////////
+    Time getMaxCaptureLatency() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of capture overruns
+    ///
+    /// An overrun happens when the internal buffer of the capture
+    /// device is full when the recorder reads from it, which means
+    /// that samples were most likely lost. It is reset every
+    /// time a new capture starts.
+    ///
+    /// \return Number of overruns since the capture started
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getOverrunCount() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Check if the system supports audio capture
     ///
@@ -213,6 +252,29 @@ protected:
     ////////////////////////////////////////////////////////////
     void setProcessingInterval(Time interval);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the low-latency capture mode
+    ///
+    /// In low-latency mode, the recorder forwards the captured
+    /// data in fixed chunks of \a chunkDuration as soon as the
+    /// capture device has recorded them. Rather than sleeping for
+    /// the processing interval, the recording thread computes
+    /// from the number of samples available in the device how
+    /// long it has to wait for the next chunk to be complete,
+    /// and sleeps exactly that long. The processing interval is
+    /// ignored while this mode is enabled.
+    ///
+    /// This mode can only be changed while the recorder is not
+    /// capturing. It is disabled by default.
+    ///
+    /// \param enabled       True to enable the low-latency mode, false to disable it
+    /// \param chunkDuration Duration of the chunks passed to onProcessSamples
+    ///
+    /// \see setProcessingInterval
+    ///
+    ////////////////////////////////////////////////////////////
+    void setLowLatencyMode(bool enabled, Time chunkDuration = milliseconds(10));
+
     ////////////////////////////////////////////////////////////
     /// \brief Start capturing audio data
     ///
@@ -271,8 +333,21 @@ private:
     /// capture loop. It retrieves the captured samples and
     /// forwards them to the derived class.
     ///
+    /// \param flush True to forward all the remaining samples, even
+    ///              if they don't fill a complete chunk
+    ///
+    /// \return Number of frames left in the capture device
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t processCapturedSamples(bool flush = false);
+
     ////////////////////////////////////////////////////////////
-    void processCapturedSamples();
+    /// \brief Prepare the ring buffer and reset the statistics
+    ///
+    /// This function is called when the capture starts.
+    ///
+    ////////////////////////////////////////////////////////////
+    void initialize();
 
     ////////////////////////////////////////////////////////////
     /// \brief Clean up the recorder's internal resources
@@ -286,12 +361,20 @@ private:
     // Member data
     ////////////////////////////////////////////////////////////
     Thread             m_thread;             ///< Thread running the background recording task
-    std::vector<Int16> m_samples;            ///< Buffer to store captured samples
+    std::vector<Int16> m_samples;            ///< Preallocated ring buffer to store captured samples
+    std::size_t        m_writeOffset;        ///< Write position in the ring buffer, in samples
     unsigned int       m_sampleRate;         ///< Sample rate
     Time               m_processingInterval; ///< Time period between calls to onProcessSamples
+    bool               m_lowLatency;         ///< Is the low-latency mode enabled?
+    Time               m_chunkDuration;      ///< Duration of the chunks forwarded in low-latency mode
+    std::size_t        m_chunkFrameCount;    ///< Number of frames per chunk in low-latency mode
     bool               m_isCapturing;        ///< Capturing state
     std::string        m_deviceName;         ///< Name of the audio capture device
     unsigned int       m_channelCount;       ///< Number of recording channels
+    mutable Mutex      m_statisticsMutex;    ///< Mutex protecting the capture statistics
+    Time               m_latency;            ///< Latency of the last processed chunk
+    Time               m_maxLatency;         ///< Highest latency since the capture started
+    unsigned int       m_overrunCount;       ///< Number of capture overruns since the capture started
 };
 
 } // namespace sf
@@ -326,6 +409,15 @@ private:
 /// CPU, but it can be changed to a smaller value if you need to process
 /// the recorded data in real time, for example.
 ///
+/// For latency-sensitive uses such as voice chat, the
+/// setLowLatencyMode protected function makes the recorder forward
+/// small fixed-size chunks as soon as they are captured, sleeping
+/// only as long as needed for the next chunk to be complete. The
+/// captured data always goes through a ring buffer allocated once
+/// when the capture starts, and the capture latency and number of
+/// overruns can be monitored with getCaptureLatency(),
+/// getMaxCaptureLatency() and getOverrunCount().
+///
 /// The audio capture feature may not be supported or activated
 /// on every platform, thus it is recommended to check its
 /// availability with the isAvailable() function. If it returns
@@ -236,6 +236,8 @@ protected:
 
 private:
 
+    friend class SoundMixer;
+
     ////////////////////////////////////////////////////////////
     /// \brief Function called as the entry point of the thread
     ///
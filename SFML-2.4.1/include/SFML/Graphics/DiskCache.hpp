@@ -0,0 +1,296 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2016 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_DISKCACHE_HPP
+#define SFML_DISKCACHE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Time.hpp>
+#include <string>
+#include <vector>
+
+
+namespace sf
+{
+class Image;
+class InputStream;
+class Shader;
+class Texture;
+
+////////////////////////////////////////////////////////////
+/// \brief Directory storing decoded images and compiled
+///        shader programs, to speed up the next launches
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API DiskCache : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Usage statistics of a cache
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Statistics
+    {
+        Uint64 imageHits;     ///< Number of images read from the cache
+        Uint64 imageMisses;   ///< Number of images that had to be decoded
+        Uint64 programHits;   ///< Number of shader programs restored from the cache
+        Uint64 programMisses; ///< Number of shader programs that had to be compiled
+        Time   hitTime;       ///< Total time spent loading cached resources
+        Time   missTime;      ///< Total time spent decoding, compiling and storing the missed resources
+        Time   timeSaved;     ///< Estimated time saved by the hits, compared to decoding or compiling again
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the cache
+    ///
+    /// The directory is not created, it must exist and be
+    /// writable for the cache to store anything. If it
+    /// doesn't, every request is a miss and the resources
+    /// are loaded as if there was no cache.
+    ///
+    /// \param directory Path of the directory storing the cached files
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit DiskCache(const std::string& directory);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the directory storing the cached files
+    ///
+    /// \return Path of the directory, as passed to the constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    const std::string& getDirectory() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load an image from a file, through the cache
+    ///
+    /// The contents of the file are hashed: if a decoded copy
+    /// of the same data is cached it is read directly,
+    /// otherwise the file is decoded as by Image::loadFromFile
+    /// and the result is stored for the next time.
+    ///
+    /// \param filename Path of the image file to load
+    /// \param image    Image to fill
+    ///
+    /// \return True if loading was successful
+    ///
+    /// \see loadImageFromMemory, loadImageFromStream
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadImageFromFile(const std::string& filename, Image& image);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load an image from a file in memory, through the cache
+    ///
+    /// \param data  Pointer to the file data in memory
+    /// \param size  Size of the data to load, in bytes
+    /// \param image Image to fill
+    ///
+    /// \return True if loading was successful
+    ///
+    /// \see loadImageFromFile, loadImageFromStream
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadImageFromMemory(const void* data, std::size_t size, Image& image);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load an image from a custom stream, through the cache
+    ///
+    /// \param stream Source stream to read from
+    /// \param image  Image to fill
+    ///
+    /// \return True if loading was successful
+    ///
+    /// \see loadImageFromFile, loadImageFromMemory
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadImageFromStream(InputStream& stream, Image& image);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load a texture from a file, through the cache
+    ///
+    /// This function is a shortcut for loadImageFromFile
+    /// followed by Texture::loadFromImage.
+    ///
+    /// \param filename Path of the image file to load
+    /// \param texture  Texture to fill
+    /// \param area     Area of the image to load
+    ///
+    /// \return True if loading was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadTextureFromFile(const std::string& filename, Texture& texture, const IntRect& area = IntRect());
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the usage statistics of the cache
+    ///
+    /// \return Statistics since the creation of the cache or the last call to resetStatistics
+    ///
+    ////////////////////////////////////////////////////////////
+    Statistics getStatistics() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Reset the statistics
+    ///
+    ////////////////////////////////////////////////////////////
+    void resetStatistics();
+
+private:
+
+    friend class Shader;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Compute the hash of a block of data
+    ///
+    /// \param data Data to hash
+    /// \param size Size of the data, in bytes
+    /// \param seed Hash of the previous blocks, to hash several blocks as one
+    ///
+    /// \return 64-bit hash of the data
+    ///
+    ////////////////////////////////////////////////////////////
+    static Uint64 computeHash(const void* data, std::size_t size, Uint64 seed = 0);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read a cached shader program binary
+    ///
+    /// \param sourceKey   Hash of the sources of the program
+    /// \param driverKey   Hash identifying the OpenGL driver
+    /// \param binary      Filled with the program binary
+    /// \param format      Filled with the format of the binary
+    /// \param compileTime Filled with the time that compiling the program took
+    ///
+    /// \return True if a binary built by the same driver was found
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadProgram(Uint64 sourceKey, Uint64 driverKey, std::vector<char>& binary, Uint32& format, Time& compileTime) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Store a shader program binary
+    ///
+    /// \param sourceKey   Hash of the sources of the program
+    /// \param driverKey   Hash identifying the OpenGL driver
+    /// \param binary      Program binary
+    /// \param format      Format of the binary
+    /// \param compileTime Time that compiling the program took
+    ///
+    ////////////////////////////////////////////////////////////
+    void saveProgram(Uint64 sourceKey, Uint64 driverKey, const std::vector<char>& binary, Uint32 format, Time compileTime) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Record a request in the statistics
+    ///
+    /// \param program  Was a shader program requested (rather than an image)?
+    /// \param hit      Was the resource found in the cache?
+    /// \param elapsed  Time that the request took
+    /// \param original Time that decoding or compiling the resource took, for hits
+    ///
+    ////////////////////////////////////////////////////////////
+    void record(bool program, bool hit, Time elapsed, Time original);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the path of a cached file
+    ///
+    /// \param key       Hash of the source of the resource
+    /// \param extension Extension of the file
+    ///
+    /// \return Path of the file
+    ///
+    ////////////////////////////////////////////////////////////
+    std::string getPath(Uint64 key, const char* extension) const;
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::string   m_directory;  ///< Directory storing the cached files
+    Statistics    m_statistics; ///< Usage statistics
+    mutable Mutex m_mutex;      ///< Protects the statistics, shaders may be compiled from several threads
+};
+
+} // namespace sf
+
+
+#endif // SFML_DISKCACHE_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::DiskCache
+/// \ingroup graphics
+///
+/// sf::DiskCache keeps the results of expensive loading steps
+/// in a directory, so that they don't have to be repeated
+/// every time the application starts.
+///
+/// Images are stored decoded, as raw RGBA pixels: reading
+/// them back is a plain file read, which is much faster than
+/// decoding a PNG or a JPEG. Cached images are identified by
+/// a hash of the contents of the source file, so editing the
+/// source invalidates its cached copy.
+///
+/// Shader programs are stored as binaries retrieved from the
+/// driver, when it supports it (OpenGL 4.1 or
+/// GL_ARB_get_program_binary). A cache enabled with
+/// sf::Shader::setProgramCache is used by every shader that
+/// gets loaded; the programs are identified by a hash of
+/// their sources, and the binaries are discarded when the
+/// graphics driver changes or refuses them.
+///
+/// Stale files are never deleted: they are overwritten when
+/// the same resource is stored again. Clearing the directory
+/// is always safe.
+///
+/// getStatistics() reports how many resources were found in
+/// the cache and an estimate of the time it saved, which is
+/// useful to measure the startup time of an application.
+///
+/// Usage example:
+/// \code
+/// sf::DiskCache cache("cache");
+/// sf::Shader::setProgramCache(&cache);
+///
+/// sf::Texture background;
+/// if (!cache.loadTextureFromFile("background.png", background))
+///     return -1;
+///
+/// sf::Shader shader;
+/// if (!shader.loadFromFile("blur.frag", sf::Shader::Fragment))
+///     return -1;
+///
+/// sf::DiskCache::Statistics statistics = cache.getStatistics();
+/// std::cout << statistics.imageHits << " images and "
+///           << statistics.programHits << " programs cached, "
+///           << statistics.timeSaved.asMilliseconds() << " ms saved" << std::endl;
+/// \endcode
+///
+/// \see sf::Image, sf::Shader
+///
+////////////////////////////////////////////////////////////
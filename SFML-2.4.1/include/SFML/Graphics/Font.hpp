@@ -263,6 +263,17 @@ public:
     ////////////////////////////////////////////////////////////
     Font& operator =(const Font& right);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Swap the contents of this font with those of another
+    ///
+    /// The font faces and the glyph pages are exchanged
+    /// without being copied.
+    ///
+    /// \param right Instance to swap with
+    ///
+    ////////////////////////////////////////////////////////////
+    void swap(Font& right);
+
 private:
 
     ////////////////////////////////////////////////////////////
@@ -0,0 +1,168 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2016 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_GPUFENCE_HPP
+#define SFML_GPUFENCE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Window/GlResource.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Time.hpp>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Completion marker for the OpenGL commands
+///        issued by a thread
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API GpuFence : GlResource, NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates a fence that is not inserted, and thus ready.
+    ///
+    ////////////////////////////////////////////////////////////
+    GpuFence();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~GpuFence();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Insert the fence after the OpenGL commands issued so far
+    ///
+    /// The fence becomes ready once the graphics card has
+    /// completed all the commands issued before on the calling
+    /// thread, for example the upload of a texture. Inserting
+    /// it again replaces the previous position.
+    ///
+    /// If the system doesn't support fences (see isAvailable()),
+    /// this function waits for the commands to complete, and
+    /// the fence is ready when it returns.
+    ///
+    ////////////////////////////////////////////////////////////
+    void insert();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Check if the commands before the fence are complete
+    ///
+    /// This function doesn't block.
+    ///
+    /// \return True if the fence is ready
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isReady() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait until the commands before the fence are complete
+    ///
+    /// \param timeout Maximum time to wait
+    ///
+    /// \return True if the fence is ready, false if the timeout expired
+    ///
+    ////////////////////////////////////////////////////////////
+    bool wait(Time timeout) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether or not the system supports fences
+    ///
+    /// \return True if fences are supported, false otherwise
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isAvailable();
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    mutable void* m_sync; ///< OpenGL sync object, NULL when not inserted or already signaled
+};
+
+} // namespace sf
+
+
+#endif // SFML_GPUFENCE_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::GpuFence
+/// \ingroup graphics
+///
+/// OpenGL commands run asynchronously: when a function like
+/// sf::Texture::loadFromFile returns, the graphics card may
+/// still be processing the upload. Within a thread this is
+/// invisible, but a texture loaded on a worker thread can
+/// be drawn by the render thread only once its upload is
+/// complete.
+///
+/// Each thread that loads resources without an active
+/// context (a worker thread, typically) uses its own hidden
+/// context, shared with all the others, so several threads
+/// (up to 8; more wait for a context to be free) can upload
+/// at the same time. sf::GpuFence tells the other
+/// threads when these uploads are complete: insert it on the
+/// loading thread after the uploads, hand it to the render
+/// thread, which then polls it with isReady() or blocks on
+/// it with wait().
+///
+/// Inserting and checking the same fence from two threads at
+/// the same time is not allowed; the hand-over must be
+/// synchronized, with a sf::Mutex for example.
+///
+/// Usage example:
+/// \code
+/// // Loader thread
+/// texture->loadFromFile("background.png");
+/// fence->insert();
+/// {
+///     sf::Lock lock(mutex);
+///     loaded.push_back(std::make_pair(texture, fence));
+/// }
+///
+/// // Render thread, every frame
+/// {
+///     sf::Lock lock(mutex);
+///     for (std::size_t i = 0; i < loaded.size(); ++i)
+///     {
+///         if (loaded[i].second->isReady())
+///             ...; // the texture can be drawn
+///     }
+/// }
+/// \endcode
+///
+/// \see sf::Texture
+///
+////////////////////////////////////////////////////////////
@@ -37,6 +37,7 @@
 
 namespace sf
 {
+class ImageView;
 class InputStream;
 
 ////////////////////////////////////////////////////////////
@@ -47,6 +48,76 @@ class SFML_GRAPHICS_API Image
 {
 public:
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Encoding settings used when saving an image
+    ///
+    ////////////////////////////////////////////////////////////
+    struct SaveSettings
+    {
+        ////////////////////////////////////////////////////////////
+        /// \brief Filter applied to the rows of a PNG image before compression
+        ///
+        ////////////////////////////////////////////////////////////
+        enum PngFilter
+        {
+            PngFilterNone,    ///< No filter, fastest
+            PngFilterSub,     ///< Difference with the pixel on the left
+            PngFilterUp,      ///< Difference with the pixel above
+            PngFilterAverage, ///< Difference with the average of the left and above pixels
+            PngFilterPaeth,   ///< Difference with the Paeth predictor
+            PngFilterAdaptive ///< Best filter chosen for each row, smallest files but slowest
+        };
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Resolution of the color channels of a JPEG image
+        ///
+        ////////////////////////////////////////////////////////////
+        enum ChromaSubsampling
+        {
+            Subsampling444, ///< Full color resolution
+            Subsampling422, ///< Half horizontal color resolution
+            Subsampling420  ///< Half horizontal and vertical color resolution, smallest files
+        };
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Default constructor
+        ///
+        /// The default settings produce the same files as
+        /// saveToFile without settings.
+        ///
+        /// \param compressionLevel PNG compression level, from 0 (no compression, fastest) to 9 (smallest)
+        /// \param filter           PNG row filter
+        /// \param quality          JPEG quality, from 1 (smallest) to 100 (best)
+        /// \param subsampling      JPEG chroma subsampling
+        ///
+        ////////////////////////////////////////////////////////////
+        explicit SaveSettings(unsigned int compressionLevel = 6, PngFilter filter = PngFilterAdaptive, unsigned int quality = 90, ChromaSubsampling subsampling = Subsampling420) :
+        pngCompressionLevel(compressionLevel),
+        pngFilter          (filter),
+        jpgQuality         (quality),
+        jpgSubsampling     (subsampling)
+        {
+        }
+
+        ////////////////////////////////////////////////////////////
+        // Member data
+        ////////////////////////////////////////////////////////////
+        unsigned int      pngCompressionLevel; ///< PNG compression level, from 0 to 9
+        PngFilter         pngFilter;           ///< PNG row filter
+        unsigned int      jpgQuality;          ///< JPEG quality, from 1 to 100
+        ChromaSubsampling jpgSubsampling;      ///< JPEG chroma subsampling
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Filters used to build mipmap levels
+    ///
+    ////////////////////////////////////////////////////////////
+    enum MipmapFilter
+    {
+        BoxFilter,   ///< Average of 2x2 pixels, fast
+        KaiserFilter ///< Kaiser-windowed sinc, sharper but slower
+    };
+
     ////////////////////////////////////////////////////////////
     /// \brief Default constructor
     ///
@@ -138,6 +209,81 @@ public:
     ////////////////////////////////////////////////////////////
     bool loadFromStream(InputStream& stream);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Load several images from files, in parallel
+    ///
+    /// The files are read and decoded by a pool of threads,
+    /// which makes loading many images (sprites of a level,
+    /// for example) much faster than calling loadFromFile
+    /// in a loop.
+    ///
+    /// \a images is resized to the number of files; the images
+    /// that fail to load are left empty. The errors are written
+    /// to sf::err() by the calling thread, once all the files
+    /// are processed.
+    ///
+    /// \param filenames   Paths of the image files to load
+    /// \param images      Array to fill with the loaded images
+    /// \param threadCount Number of decoding threads, 0 to use one per CPU core
+    ///
+    /// \return Number of images successfully loaded
+    ///
+    /// \see loadFromFile
+    ///
+    ////////////////////////////////////////////////////////////
+    static std::size_t loadFromFiles(const std::vector<std::string>& filenames, std::vector<Image>& images, unsigned int threadCount = 0);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load a chain of mipmap levels from a file on disk
+    ///
+    /// The file must be a KTX or DDS container, such as the
+    /// ones written by saveMipmapsToFile. Compressed levels are
+    /// decompressed if their format is supported (S3TC, ETC).
+    /// If this function fails, \a levels is left unchanged.
+    ///
+    /// \param filename Path of the file to load
+    /// \param levels   Array to fill with the levels, largest first
+    ///
+    /// \return True if loading was successful
+    ///
+    /// \see saveMipmapsToFile, createMipmaps
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool loadMipmapsFromFile(const std::string& filename, std::vector<Image>& levels);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load a chain of mipmap levels from a custom stream
+    ///
+    /// \param stream Source stream to read from
+    /// \param levels Array to fill with the levels, largest first
+    ///
+    /// \return True if loading was successful
+    ///
+    /// \see loadMipmapsFromFile
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool loadMipmapsFromStream(InputStream& stream, std::vector<Image>& levels);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Save a chain of mipmap levels to a file on disk
+    ///
+    /// The levels are stored uncompressed in a KTX file, so
+    /// that chains can be built offline (with createMipmaps)
+    /// and loaded directly with Texture::loadFromCompressedFile.
+    /// Each level must be half the size of the previous one
+    /// (rounded down, at least 1).
+    ///
+    /// \param filename Path of the file to save
+    /// \param levels   Mipmap levels, largest first
+    /// \param sRgb     Are the pixels in the sRGB color space?
+    ///
+    /// \return True if saving was successful
+    ///
+    /// \see loadMipmapsFromFile, createMipmaps
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool saveMipmapsToFile(const std::string& filename, const std::vector<Image>& levels, bool sRgb = false);
+
     ////////////////////////////////////////////////////////////
     /// \brief Save the image to a file on disk
     ///
@@ -155,6 +301,43 @@ public:
     ////////////////////////////////////////////////////////////
     bool saveToFile(const std::string& filename) const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Save the image to a file on disk, with custom encoding settings
+    ///
+    /// This function works like the other overload of saveToFile,
+    /// the settings that don't apply to the format of the file
+    /// are ignored.
+    ///
+    /// \param filename Path of the file to save
+    /// \param settings Encoding settings
+    ///
+    /// \return True if saving was successful
+    ///
+    /// \see saveToMemory
+    ///
+    ////////////////////////////////////////////////////////////
+    bool saveToFile(const std::string& filename, const SaveSettings& settings) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Save the image to a buffer in memory
+    ///
+    /// The format of the image must be specified, like the
+    /// extension of a file: bmp, png, tga or jpg. The content
+    /// of \a output is replaced by the encoded file.
+    /// This function fails if the image is empty, or if
+    /// the format is invalid.
+    ///
+    /// \param output   Buffer to fill with the encoded data
+    /// \param format   Encoding format to use
+    /// \param settings Encoding settings
+    ///
+    /// \return True if saving was successful
+    ///
+    /// \see saveToFile, loadFromMemory
+    ///
+    ////////////////////////////////////////////////////////////
+    bool saveToMemory(std::vector<Uint8>& output, const std::string& format, const SaveSettings& settings = SaveSettings()) const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Return the size (width and height) of the image
     ///
@@ -198,6 +381,23 @@ public:
     ////////////////////////////////////////////////////////////
     void copy(const Image& source, unsigned int destX, unsigned int destY, const IntRect& sourceRect = IntRect(0, 0, 0, 0), bool applyAlpha = false);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Copy pixels from an external buffer onto this image
+    ///
+    /// This overload works like the other one, but reads the
+    /// pixels through a view, so that buffers that are not
+    /// owned by an sf::Image (or parts of an image) can be
+    /// copied without an intermediate image.
+    ///
+    /// \param source     View on the source pixels
+    /// \param destX      X coordinate of the destination position
+    /// \param destY      Y coordinate of the destination position
+    /// \param sourceRect Sub-rectangle of the source pixels to copy
+    /// \param applyAlpha Should the copy take into account the source transparency?
+    ///
+    ////////////////////////////////////////////////////////////
+    void copy(const ImageView& source, unsigned int destX, unsigned int destY, const IntRect& sourceRect = IntRect(0, 0, 0, 0), bool applyAlpha = false);
+
     ////////////////////////////////////////////////////////////
     /// \brief Change the color of a pixel
     ///
@@ -258,8 +458,45 @@ public:
     ////////////////////////////////////////////////////////////
     void flipVertically();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Build the full chain of mipmap levels of the image
+    ///
+    /// \a levels is filled with a copy of the image followed
+    /// by all its reductions, down to 1x1. Each level is half
+    /// the size of the previous one (rounded down).
+    /// When \a sRgb is true, the color components are filtered
+    /// in linear space, which avoids the darkening of the
+    /// smaller levels.
+    ///
+    /// \param levels Array to fill with the levels, largest first
+    /// \param filter Downsampling filter
+    /// \param sRgb   Are the pixels in the sRGB color space?
+    ///
+    /// \see saveMipmapsToFile, Texture::loadFromMipmaps
+    ///
+    ////////////////////////////////////////////////////////////
+    void createMipmaps(std::vector<Image>& levels, MipmapFilter filter = BoxFilter, bool sRgb = false) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Swap the contents of this image with those of another
+    ///
+    /// No pixel is copied, which makes it the cheap way to
+    /// move a large image, for example into a container:
+    /// \code
+    /// images.push_back(sf::Image());
+    /// images.back().swap(image);
+    /// \endcode
+    ///
+    /// \param right Instance to swap with
+    ///
+    ////////////////////////////////////////////////////////////
+    void swap(Image& right);
+
 private:
 
+    friend class DiskCache;
+    friend class ImageDecoder;
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
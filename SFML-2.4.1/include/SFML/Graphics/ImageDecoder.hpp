@@ -0,0 +1,284 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2016 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_IMAGEDECODER_HPP
+#define SFML_IMAGEDECODER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/ImageView.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <vector>
+
+
+namespace sf
+{
+class InputStream;
+
+////////////////////////////////////////////////////////////
+/// \brief Incremental image decoder, fed with data as it arrives
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API ImageDecoder : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief State of the decoding
+    ///
+    ////////////////////////////////////////////////////////////
+    enum Status
+    {
+        NeedMoreData, ///< All the data fed so far has been decoded
+        Complete,     ///< The image is fully decoded
+        Error         ///< The data is invalid or its format is not supported
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ImageDecoder();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~ImageDecoder();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Restrict the decoding to a part of the image
+    ///
+    /// Only the pixels inside \a region are kept; the decoded
+    /// image has the size of the region (clamped to the bounds
+    /// of the image). For JPEG files, the decoding stops after
+    /// the last row of the region, the rest of the data is not
+    /// even needed.
+    ///
+    /// The region must be set before the first call to decode,
+    /// an empty rectangle selects the whole image.
+    ///
+    /// \param region Area of the image to decode
+    ///
+    ////////////////////////////////////////////////////////////
+    void setRegion(const IntRect& region);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Forget the current image, to decode a new one
+    ///
+    /// The region is reset to the whole image.
+    ///
+    ////////////////////////////////////////////////////////////
+    void reset();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add encoded data
+    ///
+    /// The data is copied, it can be released after the call.
+    /// Nothing is decoded until decode is called.
+    ///
+    /// \param data Pointer to the data
+    /// \param size Size of the data, in bytes
+    ///
+    /// \see close, decode
+    ///
+    ////////////////////////////////////////////////////////////
+    void feed(const void* data, std::size_t size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add encoded data read from a stream
+    ///
+    /// At most \a size bytes are read. When the end of the
+    /// stream is reached, the input is closed.
+    ///
+    /// \param stream Stream to read from
+    /// \param size   Maximum number of bytes to read
+    ///
+    /// \return Number of bytes read
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t feed(InputStream& stream, std::size_t size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell the decoder that no more data will be fed
+    ///
+    /// A truncated JPEG file is completed with gray pixels.
+    ///
+    ////////////////////////////////////////////////////////////
+    void close();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Decode as much of the data fed so far as possible
+    ///
+    /// JPEG files are decoded progressively, band by band.
+    /// The other formats (PNG, BMP, TGA, GIF, PSD, HDR, PIC)
+    /// are decoded in one go once the input is closed.
+    ///
+    /// \return Status of the decoding
+    ///
+    ////////////////////////////////////////////////////////////
+    Status decode();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the size of the decoded image
+    ///
+    /// The size is known as soon as the header of the file
+    /// is decoded; it is the size of the region, if one was set.
+    ///
+    /// \return Size of the image, in pixels (0x0 if not known yet)
+    ///
+    ////////////////////////////////////////////////////////////
+    Vector2u getSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of rows already decoded
+    ///
+    /// Rows are decoded from top to bottom.
+    ///
+    /// \return Number of complete rows
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getDecodedRows() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the rows decoded since the previous call
+    ///
+    /// The band can be uploaded directly to a texture with
+    /// Texture::update(band, 0, top). It stays valid until
+    /// the decoder is reset or destroyed.
+    ///
+    /// \param band Filled with a view on the new rows
+    /// \param top  Filled with the index of the first row of the band
+    ///
+    /// \return True if new rows are available
+    ///
+    ////////////////////////////////////////////////////////////
+    bool getNextBand(ImageView& band, unsigned int& top);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the image being decoded
+    ///
+    /// The rows that are not decoded yet are transparent.
+    ///
+    /// \return Read-only reference to the image
+    ///
+    ////////////////////////////////////////////////////////////
+    const Image& getImage() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Decode the available data of a JPEG file
+    ///
+    /// \return Status of the decoding
+    ///
+    ////////////////////////////////////////////////////////////
+    Status decodeJpeg();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Decode a whole file of another format
+    ///
+    /// \return Status of the decoding
+    ///
+    ////////////////////////////////////////////////////////////
+    Status decodeWhole();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Allocate the image, once its full size is known
+    ///
+    /// \param width  Width of the whole image
+    /// \param height Height of the whole image
+    ///
+    ////////////////////////////////////////////////////////////
+    void allocate(unsigned int width, unsigned int height);
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<Uint8> m_input;     ///< Data fed and not consumed yet
+    bool               m_closed;    ///< Has the end of the input been signaled?
+    Status             m_status;    ///< Current state of the decoding
+    IntRect            m_region;    ///< Area to decode, in the whole image
+    Image              m_image;     ///< Decoded pixels
+    unsigned int       m_rows;      ///< Number of rows decoded
+    unsigned int       m_bandTop;   ///< First row not returned by getNextBand yet
+    void*              m_jpeg;      ///< State of libjpeg (it is typeless to avoid exposing implementation details)
+};
+
+} // namespace sf
+
+
+#endif // SFML_IMAGEDECODER_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::ImageDecoder
+/// \ingroup graphics
+///
+/// sf::Image::loadFromStream blocks until the whole file is
+/// read and decoded. sf::ImageDecoder is fed with the data as
+/// it arrives (from the network, or read in chunks from a
+/// large file) and decodes it incrementally: for JPEG files,
+/// each call to decode produces the rows that can be decoded
+/// from the data received so far, so that a viewer can show
+/// the top of a large picture long before the end is loaded.
+///
+/// A region of interest can be set, to decode only a part of
+/// a large image (a tile of a map, for example).
+///
+/// Usage example:
+/// \code
+/// sf::FileInputStream file;
+/// file.open("panorama.jpg");
+///
+/// sf::ImageDecoder decoder;
+/// sf::Texture texture;
+///
+/// sf::ImageDecoder::Status status = sf::ImageDecoder::NeedMoreData;
+/// while (status == sf::ImageDecoder::NeedMoreData)
+/// {
+///     decoder.feed(file, 64 * 1024);
+///     status = decoder.decode();
+///
+///     // Upload the new rows as soon as they are decoded
+///     if ((texture.getSize().x == 0) && (decoder.getSize().x > 0))
+///         texture.create(decoder.getSize().x, decoder.getSize().y);
+///
+///     sf::ImageView band;
+///     unsigned int top;
+///     if (decoder.getNextBand(band, top))
+///         texture.update(band, 0, top);
+///
+///     // ...draw the partially loaded texture...
+/// }
+/// \endcode
+///
+/// \see sf::Image, sf::ImageView
+///
+////////////////////////////////////////////////////////////
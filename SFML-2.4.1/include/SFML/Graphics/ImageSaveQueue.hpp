@@ -0,0 +1,187 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2016 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_IMAGESAVEQUEUE_HPP
+#define SFML_IMAGESAVEQUEUE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Semaphore.hpp>
+#include <deque>
+#include <string>
+#include <vector>
+
+
+namespace sf
+{
+class Thread;
+
+////////////////////////////////////////////////////////////
+/// \brief Queue of images saved to files by background threads
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API ImageSaveQueue : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Constructor
+    ///
+    /// Starts the worker threads that encode and write the images.
+    ///
+    /// \param threadCount Number of worker threads, 0 to use one per logical processor
+    /// \param maxPending  Maximum number of images waiting to be saved (0 for no limit),
+    ///                    push blocks when it is reached
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit ImageSaveQueue(unsigned int threadCount = 0, std::size_t maxPending = 0);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// Waits until all the pending images are saved, then
+    /// stops the worker threads.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~ImageSaveQueue();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add an image to save
+    ///
+    /// The image is copied, so it can be modified or destroyed
+    /// as soon as this function returns. The file is saved by
+    /// one of the worker threads, exactly like Image::saveToFile
+    /// would do.
+    ///
+    /// \param image    Image to save
+    /// \param filename Path of the file to save
+    /// \param settings Encoding settings
+    ///
+    ////////////////////////////////////////////////////////////
+    void push(const Image& image, const std::string& filename, const Image::SaveSettings& settings = Image::SaveSettings());
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait until all the pending images are saved
+    ///
+    ////////////////////////////////////////////////////////////
+    void wait();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of images that are not saved yet
+    ///
+    /// \return Number of images queued or being saved
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getPendingCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of images that failed to be saved
+    ///
+    /// The reason of each failure is written to the standard
+    /// error output (see sf::err).
+    ///
+    /// \return Number of failures since the queue was created
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getFailureCount() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Image waiting to be saved
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Job
+    {
+        Image               image;    ///< Copy of the image to save
+        std::string         filename; ///< Path of the file to save
+        Image::SaveSettings settings; ///< Encoding settings
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Function run by the worker threads
+    ///
+    ////////////////////////////////////////////////////////////
+    void run();
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<Thread*> m_threads;    ///< Worker threads
+    std::deque<Job*>     m_jobs;       ///< Images waiting to be saved
+    std::size_t          m_active;     ///< Number of images being saved
+    std::size_t          m_maxPending; ///< Maximum number of pending images, 0 for no limit
+    std::size_t          m_failures;   ///< Number of images that failed to be saved
+    std::size_t          m_waiters;    ///< Number of threads blocked in wait()
+    mutable Mutex        m_mutex;      ///< Mutex protecting the queue and the counters
+    Semaphore            m_freeSlots;  ///< Number of images that can still be pushed without exceeding maxPending
+    Semaphore            m_wakeUps;    ///< Number of queued images, plus one per worker when the queue stops
+    Semaphore            m_idle;       ///< Posted once per waiter when the last pending image is saved
+};
+
+} // namespace sf
+
+
+#endif // SFML_IMAGESAVEQUEUE_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::ImageSaveQueue
+/// \ingroup graphics
+///
+/// Encoding an image, especially to PNG, is much slower than
+/// producing its pixels. sf::ImageSaveQueue moves this work
+/// to background threads: push returns immediately after
+/// copying the image, and the files are written in parallel
+/// by the workers.
+///
+/// To bound the memory used by the copies when images are
+/// produced faster than they can be encoded, give a maximum
+/// number of pending images to the constructor: push then
+/// waits for a slot to become free.
+///
+/// Usage example:
+/// \code
+/// sf::ImageSaveQueue queue(0, 32);
+///
+/// // Fast PNG settings: light compression, cheap filter
+/// sf::Image::SaveSettings settings(1, sf::Image::SaveSettings::PngFilterUp);
+///
+/// for (std::size_t i = 0; i < frames.size(); ++i)
+///     queue.push(frames[i], filenames[i], settings);
+///
+/// queue.wait();
+/// if (queue.getFailureCount() > 0)
+///     std::cerr << "Some frames could not be saved" << std::endl;
+/// \endcode
+///
+/// \see sf::Image
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,219 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2016 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_IMAGEVIEW_HPP
+#define SFML_IMAGEVIEW_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <string>
+#include <vector>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Non-owning view on an array of RGBA pixels
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API ImageView
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty view.
+    ///
+    ////////////////////////////////////////////////////////////
+    ImageView();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the view from an array of pixels
+    ///
+    /// The pixels must be in 32-bits RGBA format, and stay
+    /// alive as long as the view is used.
+    ///
+    /// \param pixels Pointer to the first pixel of the image
+    /// \param width  Width of the image, in pixels
+    /// \param height Height of the image, in pixels
+    /// \param stride Number of bytes between two rows, 0 if the rows are contiguous (width * 4)
+    ///
+    ////////////////////////////////////////////////////////////
+    ImageView(const Uint8* pixels, unsigned int width, unsigned int height, std::size_t stride = 0);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the view from an image
+    ///
+    /// This constructor is implicit, so that images can be
+    /// passed directly to functions that take a view.
+    /// The view is invalidated if the image is modified.
+    ///
+    /// \param image Image to view
+    ///
+    ////////////////////////////////////////////////////////////
+    ImageView(const Image& image);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the size of the viewed image
+    ///
+    /// \return Size of the image, in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    Vector2u getSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of bytes between two rows
+    ///
+    /// \return Stride of the image, in bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getStride() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a read-only pointer to the first pixel
+    ///
+    /// If the view is empty, a null pointer is returned.
+    ///
+    /// \return Pointer to the pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    const Uint8* getPixelsPtr() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a read-only pointer to the first pixel of a row
+    ///
+    /// \param y Index of the row, starting from the top
+    ///
+    /// \return Pointer to the pixels of the row
+    ///
+    ////////////////////////////////////////////////////////////
+    const Uint8* getRow(unsigned int y) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the rows follow each other without padding
+    ///
+    /// \return True if the stride is equal to width * 4
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isContiguous() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a view on a part of the image
+    ///
+    /// The rectangle is clamped to the bounds of the image.
+    /// No pixel is copied.
+    ///
+    /// \param area Area of the image to view
+    ///
+    /// \return View on the sub-rectangle
+    ///
+    ////////////////////////////////////////////////////////////
+    ImageView getSubView(const IntRect& area) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Copy the viewed pixels to an image
+    ///
+    /// \param image Image to fill
+    ///
+    ////////////////////////////////////////////////////////////
+    void copyToImage(Image& image) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Save the viewed pixels to a file on disk
+    ///
+    /// See Image::saveToFile for the list of supported formats.
+    ///
+    /// \param filename Path of the file to save
+    /// \param settings Encoding settings
+    ///
+    /// \return True if saving was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool saveToFile(const std::string& filename, const Image::SaveSettings& settings = Image::SaveSettings()) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Save the viewed pixels to a buffer in memory
+    ///
+    /// See Image::saveToMemory for the list of supported formats.
+    ///
+    /// \param output   Buffer to fill with the encoded data
+    /// \param format   Encoding format to use
+    /// \param settings Encoding settings
+    ///
+    /// \return True if saving was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool saveToMemory(std::vector<Uint8>& output, const std::string& format, const Image::SaveSettings& settings = Image::SaveSettings()) const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    const Uint8* m_pixels; ///< First pixel of the image
+    Vector2u     m_size;   ///< Size of the image
+    std::size_t  m_stride; ///< Number of bytes between two rows
+};
+
+} // namespace sf
+
+
+#endif // SFML_IMAGEVIEW_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::ImageView
+/// \ingroup graphics
+///
+/// sf::ImageView describes pixels that it doesn't own: a
+/// pointer, a size and a stride. It is cheap to copy and lets
+/// externally owned buffers (camera frames, video decoders,
+/// mapped memory...) or parts of an image be passed to
+/// sf::Texture::update, sf::Image::copy and the save functions
+/// without copying them into an sf::Image first.
+///
+/// The pixels are always 32-bits RGBA, but the rows may be
+/// padded: the stride is the number of bytes between the
+/// start of two consecutive rows.
+///
+/// Usage example:
+/// \code
+/// // Frame owned by a capture library
+/// const sf::Uint8* frame = camera.getFrame();
+/// sf::ImageView view(frame, 1280, 720, camera.getStride());
+///
+/// // Upload it to a texture, and save the center of the frame
+/// texture.update(view, 0, 0);
+/// view.getSubView(sf::IntRect(320, 180, 640, 360)).saveToFile("center.png");
+/// \endcode
+///
+/// \see sf::Image, sf::Texture
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,280 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2016 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_RENDERQUEUE_HPP
+#define SFML_RENDERQUEUE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/PrimitiveType.hpp>
+#include <SFML/Graphics/RenderStates.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <map>
+#include <vector>
+
+
+namespace sf
+{
+class RenderTarget;
+
+////////////////////////////////////////////////////////////
+/// \brief Retained list of draws, executed sorted by
+///        render states to minimize state changes
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API RenderQueue : public Drawable, NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Statistics of the last execution of a queue
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Statistics
+    {
+        std::size_t commandCount;           ///< Number of draws submitted to the queue
+        std::size_t batchCount;             ///< Number of draws executed, after merging the ones that share their states
+        std::size_t stateChanges;           ///< Number of texture, shader and blend mode changes in execution order
+        std::size_t submissionStateChanges; ///< Number of changes that executing the draws in submission order would cause
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty queue.
+    ///
+    ////////////////////////////////////////////////////////////
+    RenderQueue();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~RenderQueue();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Submit a drawable object to the queue
+    ///
+    /// The drawable is drawn immediately, but to the queue: the
+    /// vertices that it produces are copied, so it doesn't need
+    /// to stay alive until the queue is drawn. Textures and
+    /// shaders are referenced, not copied; they must stay alive
+    /// and their uniforms are the ones set when the queue is
+    /// drawn.
+    ///
+    /// While it is submitted, the drawable sees a render target
+    /// with a null size.
+    ///
+    /// \param drawable Object to draw
+    /// \param states   Render states to use for drawing
+    /// \param layer    Layer of the draw, from -32768 to 32767; lower layers are drawn first
+    /// \param depth    Order of the draw among the ones with the same layer and states; lower depths are drawn first
+    ///
+    ////////////////////////////////////////////////////////////
+    void add(const Drawable& drawable, const RenderStates& states = RenderStates::Default, int layer = 0, float depth = 0.f);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Submit primitives defined by an array of vertices to the queue
+    ///
+    /// \param vertices    Pointer to the vertices
+    /// \param vertexCount Number of vertices in the array
+    /// \param type        Type of primitives to draw
+    /// \param states      Render states to use for drawing
+    /// \param layer       Layer of the draw, from -32768 to 32767; lower layers are drawn first
+    /// \param depth       Order of the draw among the ones with the same layer and states; lower depths are drawn first
+    ///
+    ////////////////////////////////////////////////////////////
+    void add(const Vertex* vertices, std::size_t vertexCount, PrimitiveType type,
+             const RenderStates& states = RenderStates::Default, int layer = 0, float depth = 0.f);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove all the draws from the queue
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of draws submitted to the queue
+    ///
+    /// \return Number of draws
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getCommandCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the statistics of the last time the queue was drawn
+    ///
+    /// \return Statistics of the last execution
+    ///
+    ////////////////////////////////////////////////////////////
+    Statistics getStatistics() const;
+
+private:
+
+    friend class RenderTarget;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Execute the queue on a render target
+    ///
+    /// Only the transform of \a states is used, the other
+    /// states are the ones of each draw.
+    ///
+    /// \param target Render target to draw to
+    /// \param states Current render states
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void draw(RenderTarget& target, RenderStates states) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Record a draw, with the current layer and depth
+    ///
+    /// \param vertices    Pointer to the vertices
+    /// \param vertexCount Number of vertices in the array
+    /// \param type        Type of primitives to draw
+    /// \param states      Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void record(const Vertex* vertices, std::size_t vertexCount, PrimitiveType type, const RenderStates& states);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Sort the draws and merge them into batches
+    ///
+    ////////////////////////////////////////////////////////////
+    void sort() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Recorded draw
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Command
+    {
+        Uint64                  key;            ///< Sort key: layer, shader, texture, blend mode and type of primitives
+        Uint32                  depth;          ///< Depth, encoded to sort as an unsigned integer
+        PrimitiveType           type;           ///< Type of primitives (Points, Lines or Triangles)
+        const Texture*          texture;        ///< Texture of the draw
+        Texture::CoordinateType coordinateType; ///< Type of the texture coordinates
+        const Shader*           shader;         ///< Shader of the draw
+        BlendMode               blendMode;      ///< Blend mode of the draw
+        std::size_t             first;          ///< Index of the first vertex, in m_vertices
+        std::size_t             count;          ///< Number of vertices
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Consecutive draws that share their states, executed at once
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Batch
+    {
+        PrimitiveType           type;           ///< Type of primitives
+        const Texture*          texture;        ///< Texture of the batch
+        Texture::CoordinateType coordinateType; ///< Type of the texture coordinates
+        const Shader*           shader;         ///< Shader of the batch
+        BlendMode               blendMode;      ///< Blend mode of the batch
+        std::size_t             first;          ///< Index of the first vertex, in m_batchVertices
+        std::size_t             count;          ///< Number of vertices
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    RenderTarget*                                    m_recorder;      ///< Target that records the draws of submitted drawables
+    int                                              m_layer;         ///< Layer of the drawable being submitted
+    float                                            m_depth;         ///< Depth of the drawable being submitted
+    std::vector<Vertex>                              m_vertices;      ///< Vertices of the draws, transformed, in submission order
+    std::vector<Command>                             m_commands;      ///< Draws, in submission order
+    std::map<std::pair<const Texture*, int>, Uint32> m_textureIds;    ///< Index of the textures (with the type of their coordinates), in order of first use
+    std::map<const Shader*, Uint32>                  m_shaderIds;     ///< Index of the shaders, in order of first use
+    std::vector<BlendMode>                           m_blendModes;    ///< Blend modes, in order of first use
+    mutable bool                                     m_sorted;        ///< Are the batches up to date?
+    mutable std::vector<Vertex>                      m_batchVertices; ///< Vertices of the batches, in execution order
+    mutable std::vector<Batch>                       m_batches;       ///< Batches, in execution order
+    mutable Statistics                               m_statistics;    ///< Statistics of the last execution
+};
+
+} // namespace sf
+
+
+#endif // SFML_RENDERQUEUE_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::RenderQueue
+/// \ingroup graphics
+///
+/// sf::RenderQueue collects the draws of a frame instead of
+/// executing them immediately, and executes them in an order
+/// that minimizes the changes of texture, shader and blend
+/// mode. Consecutive draws that end up with the same states
+/// are merged into a single draw call.
+///
+/// The draws are sorted by layer first, then by shader,
+/// texture, blend mode and finally depth. Textures, shaders
+/// and blend modes are ordered by their first use in the
+/// frame, and the sort is stable: draws that have the same
+/// key keep their submission order.
+///
+/// Sorting reorders draws that don't share their states,
+/// which matters for translucent objects that overlap:
+/// put them in different layers (or give them different
+/// depths, if they share their states) to enforce their
+/// order. Everything in a layer is drawn after the lower
+/// layers.
+///
+/// The vertices of the draws are copied and transformed when
+/// they are submitted, so the submitted objects can change or
+/// be destroyed right after. A queue is retained until it is
+/// cleared, and drawing it again doesn't sort it again.
+///
+/// getStatistics() compares the state changes of the sorted
+/// execution with the ones that drawing in submission order
+/// would cause.
+///
+/// Usage example:
+/// \code
+/// sf::RenderQueue queue;
+///
+/// // Every frame...
+/// queue.clear();
+/// queue.add(background, sf::RenderStates::Default, 0);
+/// for (std::size_t i = 0; i < sprites.size(); ++i)
+///     queue.add(sprites[i], sf::RenderStates::Default, 1);
+/// queue.add(hud, sf::RenderStates::Default, 2);
+///
+/// window.clear();
+/// window.draw(queue);
+/// window.display();
+///
+/// sf::RenderQueue::Statistics statistics = queue.getStatistics();
+/// std::cout << statistics.submissionStateChanges - statistics.stateChanges
+///           << " state changes saved" << std::endl;
+/// \endcode
+///
+/// \see sf::RenderTarget, sf::VertexArray
+///
+////////////////////////////////////////////////////////////
@@ -30,13 +30,13 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/Export.hpp>
 #include <SFML/Graphics/BlendMode.hpp>
+#include <SFML/Graphics/Texture.hpp>
 #include <SFML/Graphics/Transform.hpp>
 
 
 namespace sf
 {
 class Shader;
-class Texture;
 
 ////////////////////////////////////////////////////////////
 /// \brief Define the states used for drawing to a RenderTarget
@@ -56,6 +56,7 @@ public:
     /// \li the identity transform
     /// \li a null texture
     /// \li a null shader
+    /// \li texture coordinates in pixels
     ///
     ////////////////////////////////////////////////////////////
     RenderStates();
@@ -112,10 +113,11 @@ public:
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    BlendMode      blendMode; ///< Blending mode
-    Transform      transform; ///< Transform
-    const Texture* texture;   ///< Texture
-    const Shader*  shader;    ///< Shader
+    BlendMode               blendMode;      ///< Blending mode
+    Transform               transform;      ///< Transform
+    const Texture*          texture;        ///< Texture
+    const Shader*           shader;         ///< Shader
+    Texture::CoordinateType coordinateType; ///< Type of the texture coordinates of the vertices
 };
 
 } // namespace sf
@@ -169,6 +171,20 @@ public:
 /// current transform with its own transform. A sprite will
 /// set its texture. Etc.
 ///
+/// The texture coordinates of the vertices are in pixels
+/// by default, and the render target converts them with a
+/// texture matrix. Vertex data that is built once can store
+/// normalized coordinates instead (in the range [0 .. 1],
+/// relative to the OpenGL texture, see Texture::bind) and set
+/// \a coordinateType to sf::Texture::Normalized: switching
+/// between textures of different sizes then doesn't change
+/// the texture matrix.
+/// \code
+/// sf::RenderStates states(&atlas);
+/// states.coordinateType = sf::Texture::Normalized;
+/// window.draw(normalizedVertices, states);
+/// \endcode
+///
 /// \see sf::RenderTarget, sf::Drawable
 ///
 ////////////////////////////////////////////////////////////
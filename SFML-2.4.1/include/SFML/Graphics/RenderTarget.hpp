@@ -38,11 +38,20 @@
 #include <SFML/Graphics/PrimitiveType.hpp>
 #include <SFML/Graphics/Vertex.hpp>
 #include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Vector3.hpp>
 
 
 namespace sf
 {
 class Drawable;
+class RenderQueue;
+class SpriteBatch;
+class SoftwareRenderTarget;
+
+namespace priv
+{
+    class SoftwareRasterizer;
+}
 
 ////////////////////////////////////////////////////////////
 /// \brief Base class for all render targets (window, texture, ...)
@@ -255,6 +264,30 @@ public:
     ////////////////////////////////////////////////////////////
     virtual Vector2u getSize() const = 0;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Activate or deactivate the render target for rendering
+    ///
+    /// This function makes the target's context current for
+    /// future OpenGL rendering operations (so you shouldn't care
+    /// about it if you're not doing direct OpenGL stuff).
+    /// A render target's context is active only on the current
+    /// thread, if you want to make it active on another thread
+    /// you have to deactivate it on the previous thread first
+    /// if it was active.
+    ///
+    /// Several targets can render through the same context
+    /// (render textures use the context that is active when
+    /// they are drawn to): the derived classes call this base
+    /// version after activating their context, to record which
+    /// target is current in it.
+    ///
+    /// \param active True to activate, false to deactivate
+    ///
+    /// \return True if operation was successful, false otherwise
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool setActive(bool active = true);
+
     ////////////////////////////////////////////////////////////
     /// \brief Save the current OpenGL render states and matrices
     ///
@@ -342,6 +375,40 @@ protected:
 
 private:
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Activate the target, unless it is already the
+    ///        current one of the active context
+    ///
+    /// \return True if the target is active
+    ///
+    ////////////////////////////////////////////////////////////
+    bool makeActive();
+
+    friend class RenderQueue;
+    friend class SpriteBatch;
+    friend class SoftwareRenderTarget;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Prepare the states for drawing
+    ///
+    /// Applies the persistent OpenGL states, the view, the blend
+    /// mode, the texture and the shader. The transform is applied
+    /// only if the vertices are not pre-transformed.
+    ///
+    /// \param useVertexCache Are the vertices pre-transformed into the vertex cache?
+    /// \param states         Render states to apply
+    ///
+    ////////////////////////////////////////////////////////////
+    void setupDraw(bool useVertexCache, const RenderStates& states);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Restore the states after drawing
+    ///
+    /// \param states Render states that were used for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void cleanupDraw(const RenderStates& states);
+
     ////////////////////////////////////////////////////////////
     /// \brief Apply the current view
     ///
@@ -367,10 +434,20 @@ private:
     ////////////////////////////////////////////////////////////
     /// \brief Apply a new texture
     ///
-    /// \param texture Texture to apply
+    /// The texture matrix that it requires is computed, but
+    /// only loaded by applyTextureMatrix.
+    ///
+    /// \param texture        Texture to apply
+    /// \param coordinateType Type of the texture coordinates of the vertices
+    ///
+    ////////////////////////////////////////////////////////////
+    void applyTexture(const Texture* texture, Texture::CoordinateType coordinateType = Texture::Pixels);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load the texture matrix required by the current texture
     ///
     ////////////////////////////////////////////////////////////
-    void applyTexture(const Texture* texture);
+    void applyTextureMatrix();
 
     ////////////////////////////////////////////////////////////
     /// \brief Apply a new shader
@@ -402,20 +479,26 @@ private:
     {
         enum {VertexCacheSize = 4};
 
-        bool      glStatesSet;    ///< Are our internal GL states set yet?
-        bool      viewChanged;    ///< Has the current view changed since last draw?
-        BlendMode lastBlendMode;  ///< Cached blending mode
-        Uint64    lastTextureId;  ///< Cached texture
-        bool      useVertexCache; ///< Did we previously use the vertex cache?
-        Vertex    vertexCache[VertexCacheSize]; ///< Pre-transformed vertices cache
+        bool                    glStatesSet;         ///< Are our internal GL states set yet?
+        bool                    viewChanged;         ///< Has the current view changed since last draw?
+        BlendMode               lastBlendMode;       ///< Cached blending mode
+        Uint64                  lastTextureId;       ///< Cached texture
+        Texture::CoordinateType lastCoordinateType;  ///< Cached type of texture coordinates
+        Vector3f                textureMatrix;       ///< Texture matrix required by the cached texture (x scale, y scale, y offset)
+        Vector3f                loadedTextureMatrix; ///< Texture matrix loaded in OpenGL, or a null one if unknown
+        bool                    useVertexCache;      ///< Did we previously use the vertex cache?
+        Vertex                  vertexCache[VertexCacheSize]; ///< Pre-transformed vertices cache
     };
 
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    View        m_defaultView; ///< Default view
-    View        m_view;        ///< Current view
-    StatesCache m_cache;       ///< Render states cache
+    View                      m_defaultView; ///< Default view
+    View                      m_view;        ///< Current view
+    StatesCache               m_cache;       ///< Render states cache
+    RenderQueue*              m_queue;       ///< Queue recording the draws instead of executing them, if any
+    priv::SoftwareRasterizer* m_rasterizer;  ///< Rasterizer executing the draws instead of OpenGL, if any
+    Uint64                    m_id;          ///< Unique number that identifies the target
 };
 
 } // namespace sf
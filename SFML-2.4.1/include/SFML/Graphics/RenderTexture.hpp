@@ -150,12 +150,15 @@ public:
     ////////////////////////////////////////////////////////////
     /// \brief Activate or deactivate the render-texture for rendering
     ///
-    /// This function makes the render-texture's context current for
+    /// This function makes the render-texture current for
     /// future OpenGL rendering operations (so you shouldn't care
     /// about it if you're not doing direct OpenGL stuff).
-    /// Only one context can be current in a thread, so if you
-    /// want to draw OpenGL geometry to another render target
-    /// (like a RenderWindow) don't forget to activate it again.
+    /// When frame buffer objects are supported, the render-texture
+    /// renders through the context that is already active (the
+    /// one of a window, usually) and only creates its own context
+    /// if none is. Either way, if you want to draw OpenGL geometry
+    /// to another render target (like a RenderWindow) don't forget
+    /// to activate it again.
     ///
     /// \param active True to activate, false to deactivate
     ///
@@ -112,6 +112,27 @@ public:
     ////////////////////////////////////////////////////////////
     virtual Vector2u getSize() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Activate or deactivate the window as the current target
+    ///        for OpenGL rendering
+    ///
+    /// A window is active only on the current thread, if you want to
+    /// make it active on another thread you have to deactivate it
+    /// on the previous thread first if it was active.
+    /// Only one window can be active on a thread at a time, thus
+    /// the window previously active (if any) automatically gets deactivated.
+    /// Render textures may render through the context of the
+    /// window: activating the window also makes sure that the
+    /// following OpenGL calls render to the window itself.
+    /// This is not to be confused with requestFocus().
+    ///
+    /// \param active True to activate, false to deactivate
+    ///
+    /// \return True if operation was successful, false otherwise
+    ///
+    ////////////////////////////////////////////////////////////
+    bool setActive(bool active = true);
+
     ////////////////////////////////////////////////////////////
     /// \brief Copy the current contents of the window to an image
     ///
@@ -36,11 +36,13 @@
 #include <SFML/System/Vector3.hpp>
 #include <map>
 #include <string>
+#include <vector>
 
 
 namespace sf
 {
 class Color;
+class DiskCache;
 class InputStream;
 class Texture;
 class Transform;
@@ -81,6 +83,12 @@ public:
     ////////////////////////////////////////////////////////////
     static CurrentTextureType CurrentTexture;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Handle of a uniform, returned by getUniformHandle()
+    ///
+    ////////////////////////////////////////////////////////////
+    typedef int UniformHandle;
+
 public:
 
     ////////////////////////////////////////////////////////////
@@ -545,6 +553,240 @@ public:
     ////////////////////////////////////////////////////////////
     void setUniformArray(const std::string& name, const Glsl::Mat4* matrixArray, std::size_t length);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the handle of a uniform, to stage its values
+    ///
+    /// The setUniform() and setUniformArray() overloads that take
+    /// a handle don't touch OpenGL: they only store the value,
+    /// and the values that changed are all uploaded at once the
+    /// next time the shader is bound for drawing. This is much
+    /// cheaper than setting uniforms by name when many of them
+    /// change every frame.
+    ///
+    /// Resolve the handles once, after loading the shader. They
+    /// become invalid when the shader is loaded again.
+    ///
+    /// A uniform can be set both by name and by handle: setting
+    /// it by name drops the value staged in its handle, if it
+    /// was not uploaded yet.
+    ///
+    /// \param name Name of the uniform variable in GLSL
+    ///
+    /// \return Handle of the uniform, or -1 if the shader has no such uniform
+    ///
+    /// \see setUniform, setUniformArray
+    ///
+    ////////////////////////////////////////////////////////////
+    UniformHandle getUniformHandle(const std::string& name);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Stage a value for a \p float uniform
+    ///
+    /// \param handle Handle of the uniform, returned by getUniformHandle
+    /// \param x      Value of the float scalar
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(UniformHandle handle, float x);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Stage a value for a \p vec2 uniform
+    ///
+    /// \param handle Handle of the uniform, returned by getUniformHandle
+    /// \param vector Value of the vec2 vector
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(UniformHandle handle, const Glsl::Vec2& vector);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Stage a value for a \p vec3 uniform
+    ///
+    /// \param handle Handle of the uniform, returned by getUniformHandle
+    /// \param vector Value of the vec3 vector
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(UniformHandle handle, const Glsl::Vec3& vector);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Stage a value for a \p vec4 uniform
+    ///
+    /// \param handle Handle of the uniform, returned by getUniformHandle
+    /// \param vector Value of the vec4 vector
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(UniformHandle handle, const Glsl::Vec4& vector);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Stage a value for a \p int uniform
+    ///
+    /// \param handle Handle of the uniform, returned by getUniformHandle
+    /// \param x      Value of the int scalar
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(UniformHandle handle, int x);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Stage a value for a \p ivec2 uniform
+    ///
+    /// \param handle Handle of the uniform, returned by getUniformHandle
+    /// \param vector Value of the ivec2 vector
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(UniformHandle handle, const Glsl::Ivec2& vector);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Stage a value for a \p ivec3 uniform
+    ///
+    /// \param handle Handle of the uniform, returned by getUniformHandle
+    /// \param vector Value of the ivec3 vector
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(UniformHandle handle, const Glsl::Ivec3& vector);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Stage a value for a \p ivec4 uniform
+    ///
+    /// \param handle Handle of the uniform, returned by getUniformHandle
+    /// \param vector Value of the ivec4 vector
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(UniformHandle handle, const Glsl::Ivec4& vector);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Stage a value for a \p bool uniform
+    ///
+    /// \param handle Handle of the uniform, returned by getUniformHandle
+    /// \param x      Value of the bool scalar
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(UniformHandle handle, bool x);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Stage a value for a \p bvec2 uniform
+    ///
+    /// \param handle Handle of the uniform, returned by getUniformHandle
+    /// \param vector Value of the bvec2 vector
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(UniformHandle handle, const Glsl::Bvec2& vector);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Stage a value for a \p bvec3 uniform
+    ///
+    /// \param handle Handle of the uniform, returned by getUniformHandle
+    /// \param vector Value of the bvec3 vector
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(UniformHandle handle, const Glsl::Bvec3& vector);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Stage a value for a \p bvec4 uniform
+    ///
+    /// \param handle Handle of the uniform, returned by getUniformHandle
+    /// \param vector Value of the bvec4 vector
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(UniformHandle handle, const Glsl::Bvec4& vector);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Stage a value for a \p mat3 uniform
+    ///
+    /// \param handle Handle of the uniform, returned by getUniformHandle
+    /// \param matrix Value of the mat3 matrix
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(UniformHandle handle, const Glsl::Mat3& matrix);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Stage a value for a \p mat4 uniform
+    ///
+    /// \param handle Handle of the uniform, returned by getUniformHandle
+    /// \param matrix Value of the mat4 matrix
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(UniformHandle handle, const Glsl::Mat4& matrix);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Stage a texture for a \p sampler2D uniform
+    ///
+    /// The texture must remain alive as long as the shader
+    /// uses it, no copy is made internally.
+    ///
+    /// \param handle  Handle of the uniform, returned by getUniformHandle
+    /// \param texture Texture to assign
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(UniformHandle handle, const Texture& texture);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Map a \p sampler2D uniform to the current texture
+    ///
+    /// The second argument must be sf::Shader::CurrentTexture.
+    ///
+    /// \param handle Handle of the uniform, returned by getUniformHandle
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(UniformHandle handle, CurrentTextureType);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Stage values for a \p float[] array uniform
+    ///
+    /// \param handle      Handle of the uniform, returned by getUniformHandle
+    /// \param scalarArray pointer to array of \p float values
+    /// \param length      Number of elements in the array
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniformArray(UniformHandle handle, const float* scalarArray, std::size_t length);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Stage values for a \p vec2[] array uniform
+    ///
+    /// \param handle      Handle of the uniform, returned by getUniformHandle
+    /// \param vectorArray pointer to array of \p vec2 values
+    /// \param length      Number of elements in the array
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniformArray(UniformHandle handle, const Glsl::Vec2* vectorArray, std::size_t length);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Stage values for a \p vec3[] array uniform
+    ///
+    /// \param handle      Handle of the uniform, returned by getUniformHandle
+    /// \param vectorArray pointer to array of \p vec3 values
+    /// \param length      Number of elements in the array
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniformArray(UniformHandle handle, const Glsl::Vec3* vectorArray, std::size_t length);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Stage values for a \p vec4[] array uniform
+    ///
+    /// \param handle      Handle of the uniform, returned by getUniformHandle
+    /// \param vectorArray pointer to array of \p vec4 values
+    /// \param length      Number of elements in the array
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniformArray(UniformHandle handle, const Glsl::Vec4* vectorArray, std::size_t length);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Stage values for a \p mat3[] array uniform
+    ///
+    /// \param handle      Handle of the uniform, returned by getUniformHandle
+    /// \param matrixArray pointer to array of \p mat3 values
+    /// \param length      Number of elements in the array
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniformArray(UniformHandle handle, const Glsl::Mat3* matrixArray, std::size_t length);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Stage values for a \p mat4[] array uniform
+    ///
+    /// \param handle      Handle of the uniform, returned by getUniformHandle
+    /// \param matrixArray pointer to array of \p mat4 values
+    /// \param length      Number of elements in the array
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniformArray(UniformHandle handle, const Glsl::Mat4* matrixArray, std::size_t length);
+
     ////////////////////////////////////////////////////////////
     /// \brief Change a float parameter of the shader
     ///
@@ -691,6 +933,28 @@ public:
     ////////////////////////////////////////////////////////////
     static bool isGeometryAvailable();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the cache storing the compiled shader programs
+    ///
+    /// When a cache is set and the driver can save program
+    /// binaries (OpenGL 4.1 or GL_ARB_get_program_binary), every
+    /// shader that gets loaded first looks for a binary of the
+    /// same sources in the cache, and only compiles them if
+    /// none is found; the binary of a newly compiled program is
+    /// then stored in the cache.
+    ///
+    /// The cache is not owned by sf::Shader, it must stay alive
+    /// as long as it is set. It should be set before loading
+    /// the shaders, and not changed while other threads are
+    /// loading shaders.
+    ///
+    /// \param cache Cache to use, or NULL to always compile the shaders
+    ///
+    /// \see sf::DiskCache
+    ///
+    ////////////////////////////////////////////////////////////
+    static void setProgramCache(DiskCache* cache);
+
 private:
 
     ////////////////////////////////////////////////////////////
@@ -727,6 +991,51 @@ private:
     ////////////////////////////////////////////////////////////
     int getUniformLocation(const std::string& name);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Stage a value in a uniform slot
+    ///
+    /// The slot is marked dirty only if the value changed.
+    ///
+    /// \param handle Handle of the uniform
+    /// \param type   Type of the value (see the .cpp file)
+    /// \param floats Float components of the value, or NULL
+    /// \param ints   Integer components of the value, or NULL
+    /// \param size   Number of components
+    /// \param count  Number of array elements
+    ///
+    ////////////////////////////////////////////////////////////
+    void stageUniform(UniformHandle handle, int type, const float* floats, const int* ints, std::size_t size, std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Forget the staged value of a uniform set by name
+    ///
+    /// The pending upload of the slot is dropped, and the next
+    /// value staged in it is uploaded even if it is the same
+    /// as the previous one.
+    ///
+    /// \param location Location of the uniform
+    ///
+    ////////////////////////////////////////////////////////////
+    void discardStagedUniform(int location);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Assign a texture to a sampler uniform
+    ///
+    /// \param location Location of the uniform
+    /// \param texture  Texture to assign
+    /// \param name     Name of the uniform, for error messages
+    ///
+    ////////////////////////////////////////////////////////////
+    void setTextureUniform(int location, const Texture& texture, const std::string& name);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Upload the staged uniforms that changed
+    ///
+    /// The program must be bound.
+    ///
+    ////////////////////////////////////////////////////////////
+    void uploadUniforms() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief RAII object to save and restore the program
     ///        binding while uniforms are being set
@@ -742,13 +1051,30 @@ private:
     typedef std::map<int, const Texture*> TextureTable;
     typedef std::map<std::string, int> UniformTable;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Staged value of a uniform
+    ///
+    ////////////////////////////////////////////////////////////
+    struct UniformSlot
+    {
+        std::string        name;     ///< Name of the uniform
+        int                location; ///< Location of the uniform in the program
+        int                type;     ///< Type of the staged value (see the .cpp file)
+        std::size_t        count;    ///< Number of array elements of the staged value
+        std::vector<float> floats;   ///< Float components of the staged value
+        std::vector<int>   ints;     ///< Integer components of the staged value
+        bool               dirty;    ///< Has the value changed since it was uploaded?
+    };
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    unsigned int m_shaderProgram;  ///< OpenGL identifier for the program
-    int          m_currentTexture; ///< Location of the current texture in the shader
-    TextureTable m_textures;       ///< Texture variables in the shader, mapped to their location
-    UniformTable m_uniforms;       ///< Parameters location cache
+    unsigned int                       m_shaderProgram;  ///< OpenGL identifier for the program
+    int                                m_currentTexture; ///< Location of the current texture in the shader
+    TextureTable                       m_textures;       ///< Texture variables in the shader, mapped to their location
+    UniformTable                       m_uniforms;       ///< Parameters location cache
+    mutable std::vector<UniformSlot>   m_slots;          ///< Staged uniforms, indexed by handle
+    mutable std::vector<UniformHandle> m_dirtySlots;     ///< Handles of the staged uniforms to upload
 };
 
 } // namespace sf
@@ -814,6 +1140,18 @@ private:
 /// shader.setUniform("current", sf::Shader::CurrentTexture);
 /// \endcode
 ///
+/// Setting a uniform by name switches to the program and
+/// back, and looks the name up. For uniforms that change
+/// every frame, resolve a handle once and stage the values
+/// instead; they are uploaded together when the shader is
+/// bound for drawing, and only if they changed:
+/// \code
+/// sf::Shader::UniformHandle offset = shader.getUniformHandle("offset");
+/// ...
+/// // Every frame
+/// shader.setUniform(offset, time.asSeconds());
+/// \endcode
+///
 /// The old setParameter() overloads are deprecated and will be removed in a
 /// future version. You should use their setUniform() equivalents instead.
 ///
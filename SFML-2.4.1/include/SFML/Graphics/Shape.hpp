@@ -185,6 +185,69 @@ public:
     ////////////////////////////////////////////////////////////
     float getOutlineThickness() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Choose whether the geometry is built as triangle lists
+    ///
+    /// By default the inside of the shape is a triangle fan and
+    /// its outline a triangle strip: it's the most compact form,
+    /// but fans and strips can't be concatenated, so every shape
+    /// ends up in its own draw call. As triangle lists (3 vertices
+    /// per point for the inside, 6 for the outline) the vertices
+    /// returned by getFillVertices() and getOutlineVertices() of
+    /// many shapes can be transformed and appended to a single
+    /// sf::Triangles array, and drawn at once.
+    /// sf::RenderQueue doesn't need this option: it converts fans
+    /// and strips to triangles when they are submitted.
+    /// By default, this option is disabled.
+    ///
+    /// \param triangleList True to build triangle lists, false to build a fan and a strip
+    ///
+    /// \see isTriangleList, getFillVertices, getOutlineVertices
+    ///
+    ////////////////////////////////////////////////////////////
+    void setTriangleList(bool triangleList);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the geometry is built as triangle lists
+    ///
+    /// \return True if the shape builds triangle lists, false otherwise
+    ///
+    /// \see setTriangleList
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isTriangleList() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the vertices of the inside of the shape
+    ///
+    /// The vertices are in local coordinates: the transform of
+    /// the shape (see getTransform()) is not applied. Their
+    /// primitive type is sf::TriangleFan, or sf::Triangles if
+    /// the shape builds triangle lists.
+    ///
+    /// \return Vertices of the inside of the shape
+    ///
+    /// \see getOutlineVertices, setTriangleList
+    ///
+    ////////////////////////////////////////////////////////////
+    const VertexArray& getFillVertices() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the vertices of the outline of the shape
+    ///
+    /// The vertices are in local coordinates: the transform of
+    /// the shape (see getTransform()) is not applied. Their
+    /// primitive type is sf::TriangleStrip, or sf::Triangles if
+    /// the shape builds triangle lists. When the outline
+    /// thickness is 0 they are degenerate, and draw() skips them.
+    ///
+    /// \return Vertices of the outline of the shape
+    ///
+    /// \see getFillVertices, setTriangleList
+    ///
+    ////////////////////////////////////////////////////////////
+    const VertexArray& getOutlineVertices() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Get the total number of points of the shape
     ///
@@ -310,6 +373,7 @@ private:
     Color          m_fillColor;        ///< Fill color
     Color          m_outlineColor;     ///< Outline color
     float          m_outlineThickness; ///< Thickness of the shape's outline
+    bool           m_triangleList;     ///< Is the geometry built as triangle lists?
     VertexArray    m_vertices;         ///< Vertex array containing the fill geometry
     VertexArray    m_outlineVertices;  ///< Vertex array containing the outline geometry
     FloatRect      m_insideBounds;     ///< Bounding rectangle of the inside (fill)
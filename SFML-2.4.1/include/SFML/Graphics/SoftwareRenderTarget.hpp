@@ -0,0 +1,207 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2016 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_SOFTWARERENDERTARGET_HPP
+#define SFML_SOFTWARERENDERTARGET_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Target for 2D rendering on the CPU into an image
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API SoftwareRenderTarget : public RenderTarget
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Constructs an empty, invalid target. You must call
+    /// create to have a valid target.
+    ///
+    /// \see create
+    ///
+    ////////////////////////////////////////////////////////////
+    SoftwareRenderTarget();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual ~SoftwareRenderTarget();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create the target
+    ///
+    /// The contents are initialized to transparent black.
+    /// The size can't exceed 16384 pixels in each direction.
+    ///
+    /// \param width  Width of the target
+    /// \param height Height of the target
+    ///
+    /// \return True if creation has been successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool create(unsigned int width, unsigned int height);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the number of threads that rasterize the image
+    ///
+    /// The image is split into tiles of 64x64 pixels, which
+    /// are rasterized in parallel by display(). The calling
+    /// thread counts as one of them. The default value, 0,
+    /// uses one thread per hardware thread.
+    ///
+    /// \param count Maximum number of threads, 0 for automatic
+    ///
+    /// \see getThreadCount
+    ///
+    ////////////////////////////////////////////////////////////
+    void setThreadCount(unsigned int count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of threads that rasterize the image
+    ///
+    /// \return Maximum number of threads, 0 for automatic
+    ///
+    /// \see setThreadCount
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getThreadCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update the contents of the target image
+    ///
+    /// The draw calls only record the primitives: this function
+    /// rasterizes them, and copies the result to the image
+    /// returned by getImage.
+    ///
+    ////////////////////////////////////////////////////////////
+    void display();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Return the size of the rendering region of the target
+    ///
+    /// \return Size in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual Vector2u getSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a read-only reference to the target image
+    ///
+    /// The image is updated by display().
+    ///
+    /// \return Const reference to the image
+    ///
+    ////////////////////////////////////////////////////////////
+    const Image& getImage() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Activate the target for rendering
+    ///
+    /// Software targets have no OpenGL context, this function
+    /// always fails so that the base class doesn't issue any
+    /// OpenGL call.
+    ///
+    /// \param active True to make the target active, false to deactivate it
+    ///
+    /// \return Always false
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool activate(bool active);
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Image        m_image;       ///< Image that receives the rendered pixels
+    unsigned int m_threadCount; ///< Maximum number of rasterizer threads, 0 for automatic
+};
+
+} // namespace sf
+
+
+#endif // SFML_SOFTWARERENDERTARGET_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::SoftwareRenderTarget
+/// \ingroup graphics
+///
+/// sf::SoftwareRenderTarget renders the same drawables as
+/// sf::RenderTexture, but on the CPU: it doesn't need a GPU
+/// nor an OpenGL context, which makes it suitable for
+/// generating images on servers.
+///
+/// Vertices are transformed by the render states and the view
+/// as with OpenGL, then every primitive type is rasterized with
+/// the same coverage rules (pixel centers, top-left edges),
+/// using the blend mode and the texture of the render states.
+/// Lines are drawn as quads one pixel wide and points as
+/// squares of one pixel, which covers the same pixels as
+/// aliased OpenGL lines and points.
+///
+/// Limitations:
+/// \li shaders are ignored
+/// \li sf::Texture still lives in video memory: the first draw
+///     that uses a texture reads it back with copyToImage, then
+///     its copy is sampled until the texture changes. Textured
+///     drawables (sprites, text) therefore need an OpenGL
+///     implementation, which can be a software one such as
+///     Mesa's llvmpipe; untextured ones don't use OpenGL at all
+/// \li direct OpenGL calls have no effect on the target
+///
+/// Usage example:
+///
+/// \code
+/// sf::SoftwareRenderTarget target;
+/// if (!target.create(1200, 630))
+///     return -1;
+///
+/// // Draw the scene, with the same code as on screen
+/// target.clear(sf::Color::White);
+/// target.setView(mapView);
+/// target.draw(map);     // map is a sf::Drawable
+/// target.draw(markers); // markers is a sf::VertexArray
+///
+/// // Rasterize it and save the result
+/// target.display();
+/// target.getImage().saveToFile("preview.png");
+/// \endcode
+///
+/// \see sf::RenderTarget, sf::RenderTexture, sf::Image
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,360 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2016 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_SPATIALINDEX_HPP
+#define SFML_SPATIALINDEX_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/RenderStates.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <utility>
+#include <vector>
+
+
+namespace sf
+{
+class Drawable;
+class RenderTarget;
+class View;
+
+////////////////////////////////////////////////////////////
+/// \brief Spatial index of drawables, to draw only the
+///        ones that are visible in a view
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API SpatialIndex : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// The cell size should be close to the size of the typical
+    /// object: objects that cover more than 4x4 cells are kept
+    /// apart and tested against every query.
+    ///
+    /// \param cellSize Size of the cells of the grid, in world units
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit SpatialIndex(float cellSize = 256.f);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Insert an object that provides its global bounds
+    ///
+    /// \a object can be any drawable that has a getGlobalBounds()
+    /// function (sf::Sprite, sf::Shape, sf::Text, ...). The index
+    /// keeps a pointer to it: it must stay alive while it is in
+    /// the index, and its bounds are read again by update().
+    ///
+    /// \param object Object to insert
+    ///
+    /// \return Identifier of the object in the index
+    ///
+    ////////////////////////////////////////////////////////////
+    template <typename T>
+    std::size_t insert(const T& object);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Insert a drawable with explicit bounds
+    ///
+    /// The index keeps a pointer to the drawable: it must stay
+    /// alive while it is in the index. Since the index can't
+    /// read the bounds of this object by itself, they must be
+    /// given to update() when they change.
+    ///
+    /// \param drawable Drawable to insert
+    /// \param bounds   Bounds of the drawable, in world coordinates
+    ///
+    /// \return Identifier of the drawable in the index
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t insert(const Drawable& drawable, const FloatRect& bounds);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove an object from the index
+    ///
+    /// Its identifier may be reused by the next insertion.
+    ///
+    /// \param id Identifier of the object
+    ///
+    ////////////////////////////////////////////////////////////
+    void remove(std::size_t id);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read the bounds of an object again
+    ///
+    /// This function must be called after an object inserted
+    /// with insert(const T&) moved or changed its size. It has
+    /// no effect on drawables inserted with explicit bounds.
+    ///
+    /// \param id Identifier of the object
+    ///
+    ////////////////////////////////////////////////////////////
+    void update(std::size_t id);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the bounds of an object
+    ///
+    /// \param id     Identifier of the object
+    /// \param bounds New bounds of the object, in world coordinates
+    ///
+    ////////////////////////////////////////////////////////////
+    void update(std::size_t id, const FloatRect& bounds);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read the bounds of all the objects again
+    ///
+    /// Only the objects that moved to other cells are moved
+    /// in the grid. This is convenient when most objects are
+    /// animated; otherwise, updating the objects that changed
+    /// is cheaper.
+    ///
+    ////////////////////////////////////////////////////////////
+    void update();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove all the objects from the index
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of objects in the index
+    ///
+    /// \return Number of objects
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getObjectCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the drawables that intersect an area
+    ///
+    /// The drawables are returned in the order they were
+    /// inserted.
+    ///
+    /// \param area      Area to test, in world coordinates
+    /// \param drawables Filled with the drawables (previous content is lost)
+    ///
+    ////////////////////////////////////////////////////////////
+    void query(const FloatRect& area, std::vector<const Drawable*>& drawables) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw the drawables that are visible in a view
+    ///
+    /// The visible drawables are drawn in the order they were
+    /// inserted. \a view is only used to find them; the target
+    /// draws with its own view, so \a view is usually
+    /// target.getView(). The transform of \a states is taken
+    /// into account, like for the other draws.
+    ///
+    /// \param target Render target to draw to
+    /// \param view   View that defines the visible area
+    /// \param states Render states to use for drawing
+    ///
+    /// \return Number of drawables that were drawn
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t drawVisible(RenderTarget& target, const View& view, const RenderStates& states = RenderStates::Default) const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Insert an object
+    ///
+    /// \param drawable  Drawable to insert
+    /// \param object    Object to pass to \a getBounds
+    /// \param getBounds Function that returns the bounds of the object, or NULL
+    /// \param bounds    Bounds of the object
+    ///
+    /// \return Identifier of the object
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t insert(const Drawable& drawable, const void* object, FloatRect (*getBounds)(const void*), const FloatRect& bounds);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Compute the range of cells covered by a rectangle
+    ///
+    /// \param rect    Rectangle, in world coordinates
+    /// \param maxSpan Maximum number of columns and rows
+    /// \param cells   Receives the range of cells (left, top, number of columns and rows)
+    ///
+    /// \return True if the range is not empty and spans at most \a maxSpan columns and rows
+    ///
+    ////////////////////////////////////////////////////////////
+    bool getCells(const FloatRect& rect, Int64 maxSpan, IntRect& cells) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the bucket that stores a cell
+    ///
+    /// \param x Horizontal coordinate of the cell
+    /// \param y Vertical coordinate of the cell
+    ///
+    /// \return Index of the bucket
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getBucket(int x, int y) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add an object to the buckets of its cells
+    ///
+    /// \param id Identifier of the object
+    ///
+    ////////////////////////////////////////////////////////////
+    void link(std::size_t id);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove an object from the buckets of its cells
+    ///
+    /// \param id Identifier of the object
+    ///
+    ////////////////////////////////////////////////////////////
+    void unlink(std::size_t id);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Store new bounds for an object
+    ///
+    /// \param id     Identifier of the object
+    /// \param bounds New bounds
+    ///
+    ////////////////////////////////////////////////////////////
+    void move(std::size_t id, const FloatRect& bounds);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Distribute the objects in a new number of buckets
+    ///
+    /// \param bucketCount New number of buckets (a power of two)
+    ///
+    ////////////////////////////////////////////////////////////
+    void rehash(std::size_t bucketCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Find the objects that intersect an area
+    ///
+    /// The result is stored in m_found.
+    ///
+    /// \param area Area to test, in world coordinates
+    ///
+    ////////////////////////////////////////////////////////////
+    void find(const FloatRect& area) const;
+
+    ////////////////////////////////////////////////////////////
+    // Types
+    ////////////////////////////////////////////////////////////
+    struct Object
+    {
+        const Drawable* drawable;                ///< Drawable, or NULL if the slot is free
+        const void*     source;                  ///< Object passed to getBounds
+        FloatRect     (*getBounds)(const void*); ///< Function that reads the bounds, or NULL if they are explicit
+        FloatRect       bounds;                  ///< Bounds, in world coordinates
+        IntRect         cells;                   ///< Range of cells covered, or empty if the object is large
+        Uint64          order;                   ///< Insertion order
+        mutable Uint32  stamp;                   ///< Last query that found the object
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    float                                                m_cellSize;     ///< Size of a cell, in world units
+    std::vector<Object>                                  m_objects;      ///< Objects, indexed by identifier
+    std::vector<std::size_t>                             m_freeIds;      ///< Identifiers of the free slots of m_objects
+    std::vector<std::vector<std::size_t> >               m_buckets;      ///< Identifiers of the objects of each bucket of cells
+    std::vector<std::size_t>                             m_largeObjects; ///< Identifiers of the objects that cover too many cells
+    Uint64                                               m_nextOrder;    ///< Insertion order of the next object
+    mutable Uint32                                       m_stamp;        ///< Identifier of the last query
+    mutable std::vector<std::pair<Uint64, std::size_t> > m_found;        ///< Insertion order and identifier of the objects found by the last query
+};
+
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Read the global bounds of an object of type T
+///
+////////////////////////////////////////////////////////////
+template <typename T>
+FloatRect getGlobalBounds(const void* object);
+
+} // namespace priv
+
+#include <SFML/Graphics/SpatialIndex.inl>
+
+} // namespace sf
+
+
+#endif // SFML_SPATIALINDEX_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::SpatialIndex
+/// \ingroup graphics
+///
+/// sf::SpatialIndex keeps track of where drawables are, so
+/// that the ones that are outside the view can be skipped
+/// without even computing their bounds. It's meant for big
+/// worlds, where most objects are off-screen: only the
+/// visible ones are sent to the render target.
+///
+/// The index is a grid of square cells, stored in a hash
+/// table so that the world has no limits. An object is
+/// linked to all the cells that its bounds cover; objects
+/// that cover too many cells are stored in a separate list
+/// and tested by every query. The cost of a query depends
+/// on the number of objects around the queried area, not on
+/// the total number of objects.
+///
+/// The index doesn't own the objects, it only keeps pointers
+/// to them. It doesn't know when they move either: call
+/// update() with the identifier returned by insert() after
+/// changing the position, rotation, scale or size of an
+/// object, or update() without argument to refresh all of
+/// them at once.
+///
+/// The queries of an index can't run concurrently.
+///
+/// Usage example:
+/// \code
+/// std::vector<sf::Sprite> trees(200000, sf::Sprite(texture));
+/// sf::SpatialIndex index(64.f);
+/// for (std::size_t i = 0; i < trees.size(); ++i)
+/// {
+///     trees[i].setPosition(positions[i]);
+///     index.insert(trees[i]);
+/// }
+///
+/// // Every frame...
+/// player.move(offset);
+/// index.update(playerId);
+///
+/// window.clear();
+/// index.drawVisible(window, window.getView());
+/// window.display();
+/// \endcode
+///
+/// \see sf::View, sf::RenderQueue
+///
+////////////////////////////////////////////////////////////
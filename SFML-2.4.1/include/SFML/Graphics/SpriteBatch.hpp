@@ -0,0 +1,386 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2016 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_SPRITEBATCH_HPP
+#define SFML_SPRITEBATCH_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/Shader.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/Window/GlResource.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <vector>
+
+
+namespace sf
+{
+class Texture;
+
+////////////////////////////////////////////////////////////
+/// \brief Large set of sprites that share a texture,
+///        drawn with a single draw call
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API SpriteBatch : public Drawable, GlResource, NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty batch with no texture.
+    ///
+    ////////////////////////////////////////////////////////////
+    SpriteBatch();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct an empty batch from a texture
+    ///
+    /// \param texture Source texture
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit SpriteBatch(const Texture& texture);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~SpriteBatch();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the texture shared by the sprites
+    ///
+    /// The \a texture argument refers to a texture that must
+    /// exist as long as the batch uses it. Indeed, the batch
+    /// doesn't store its own copy of the texture, but rather keeps
+    /// a pointer to the one that you passed to this function.
+    ///
+    /// \param texture New texture
+    ///
+    /// \see getTexture
+    ///
+    ////////////////////////////////////////////////////////////
+    void setTexture(const Texture& texture);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the texture shared by the sprites
+    ///
+    /// \return Pointer to the texture, or NULL if there is none
+    ///
+    /// \see setTexture
+    ///
+    ////////////////////////////////////////////////////////////
+    const Texture* getTexture() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a sprite to the batch
+    ///
+    /// The sprite is transformed like a sf::Sprite with the
+    /// same attributes: scaled and rotated around its origin,
+    /// which is then placed at \a position.
+    ///
+    /// \param position    Position of the sprite
+    /// \param textureRect Part of the texture displayed by the sprite, in pixels
+    /// \param color       Global color of the sprite
+    /// \param rotation    Orientation of the sprite, in degrees
+    /// \param scale       Scale factors of the sprite
+    /// \param origin      Local origin of the sprite, in pixels
+    ///
+    /// \return Index of the new sprite
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t add(const Vector2f& position, const IntRect& textureRect, const Color& color = Color::White,
+                    float rotation = 0.f, const Vector2f& scale = Vector2f(1.f, 1.f), const Vector2f& origin = Vector2f(0.f, 0.f));
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the number of sprites
+    ///
+    /// New sprites are placed at (0, 0), with an empty texture
+    /// rectangle, a white color, no rotation, a scale of (1, 1)
+    /// and an origin at (0, 0).
+    ///
+    /// \param count New number of sprites
+    ///
+    ////////////////////////////////////////////////////////////
+    void resize(std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove all the sprites from the batch
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of sprites in the batch
+    ///
+    /// \return Number of sprites
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getSpriteCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the position of a sprite
+    ///
+    /// \param index    Index of the sprite
+    /// \param position New position
+    ///
+    ////////////////////////////////////////////////////////////
+    void setPosition(std::size_t index, const Vector2f& position);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the texture rectangle of a sprite
+    ///
+    /// \param index       Index of the sprite
+    /// \param textureRect New texture rectangle, in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    void setTextureRect(std::size_t index, const IntRect& textureRect);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the color of a sprite
+    ///
+    /// \param index Index of the sprite
+    /// \param color New color
+    ///
+    ////////////////////////////////////////////////////////////
+    void setColor(std::size_t index, const Color& color);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the orientation of a sprite
+    ///
+    /// \param index Index of the sprite
+    /// \param angle New rotation, in degrees
+    ///
+    ////////////////////////////////////////////////////////////
+    void setRotation(std::size_t index, float angle);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the scale factors of a sprite
+    ///
+    /// \param index Index of the sprite
+    /// \param scale New scale factors
+    ///
+    ////////////////////////////////////////////////////////////
+    void setScale(std::size_t index, const Vector2f& scale);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the local origin of a sprite
+    ///
+    /// \param index  Index of the sprite
+    /// \param origin New origin, in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    void setOrigin(std::size_t index, const Vector2f& origin);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the position of a sprite
+    ///
+    /// \param index Index of the sprite
+    ///
+    /// \return Position of the sprite
+    ///
+    ////////////////////////////////////////////////////////////
+    const Vector2f& getPosition(std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the texture rectangle of a sprite
+    ///
+    /// \param index Index of the sprite
+    ///
+    /// \return Texture rectangle of the sprite
+    ///
+    ////////////////////////////////////////////////////////////
+    const IntRect& getTextureRect(std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the color of a sprite
+    ///
+    /// \param index Index of the sprite
+    ///
+    /// \return Color of the sprite
+    ///
+    ////////////////////////////////////////////////////////////
+    const Color& getColor(std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the orientation of a sprite
+    ///
+    /// \param index Index of the sprite
+    ///
+    /// \return Rotation of the sprite, in degrees
+    ///
+    ////////////////////////////////////////////////////////////
+    float getRotation(std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the scale factors of a sprite
+    ///
+    /// \param index Index of the sprite
+    ///
+    /// \return Scale factors of the sprite
+    ///
+    ////////////////////////////////////////////////////////////
+    const Vector2f& getScale(std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the local origin of a sprite
+    ///
+    /// \param index Index of the sprite
+    ///
+    /// \return Origin of the sprite, in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    const Vector2f& getOrigin(std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Expand the sprites into triangles
+    ///
+    /// Each sprite produces 6 vertices (2 triangles), with its
+    /// transform applied. This is what the batch draws when
+    /// instancing is not available.
+    ///
+    /// \param vertices Array to fill with the vertices
+    ///
+    ////////////////////////////////////////////////////////////
+    void getVertices(std::vector<Vertex>& vertices) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether or not the system supports instanced drawing
+    ///
+    /// When instancing is available, the attributes of the
+    /// sprites are uploaded as they are and the GPU expands
+    /// them; otherwise the batch is expanded on the CPU.
+    ///
+    /// \return True if instanced drawing is supported, false otherwise
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isInstancingAvailable();
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw the batch to a render target
+    ///
+    /// \param target Render target to draw to
+    /// \param states Current render states
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void draw(RenderTarget& target, RenderStates states) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw the batch with a single instanced draw call
+    ///
+    /// \param target Render target to draw to
+    /// \param states Current render states
+    ///
+    /// \return True on success, false if the internal shader could not be created
+    ///
+    ////////////////////////////////////////////////////////////
+    bool drawInstanced(RenderTarget& target, RenderStates states) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Flag the sprites as modified
+    ///
+    ////////////////////////////////////////////////////////////
+    void invalidate();
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    const Texture*              m_texture;       ///< Texture shared by the sprites
+    std::vector<Vector2f>       m_positions;     ///< Position of each sprite
+    std::vector<IntRect>        m_textureRects;  ///< Texture rectangle of each sprite
+    std::vector<Color>          m_colors;        ///< Color of each sprite
+    std::vector<float>          m_rotations;     ///< Rotation of each sprite, in degrees
+    std::vector<Vector2f>       m_scales;        ///< Scale factors of each sprite
+    std::vector<Vector2f>       m_origins;       ///< Origin of each sprite
+    mutable std::vector<Vertex> m_vertices;      ///< Expanded sprites, for drawing without instancing
+    mutable bool                m_verticesDirty; ///< Do the expanded sprites need to be updated?
+    mutable unsigned int        m_buffer;        ///< OpenGL identifier of the buffer holding the attributes of the sprites
+    mutable bool                m_bufferDirty;   ///< Does the buffer need to be updated?
+    mutable Shader              m_shader;        ///< Internal shader expanding the sprites, for instanced drawing
+    mutable int                 m_attributes[7]; ///< Locations of the attributes of the internal shader
+    mutable bool                m_shaderFailed;  ///< Did the creation of the internal shader fail?
+};
+
+} // namespace sf
+
+
+#endif // SFML_SPRITEBATCH_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::SpriteBatch
+/// \ingroup graphics
+///
+/// sf::SpriteBatch draws many sprites that share a texture
+/// (particles, bullets, tiles, ...) at once, which is much
+/// faster than drawing as many sf::Sprite instances.
+///
+/// The attributes of the sprites are stored in separate
+/// arrays, one per attribute: updating the positions of all
+/// the sprites every frame only touches the positions.
+///
+/// When the system supports instanced drawing (see
+/// isInstancingAvailable()), these arrays are uploaded to the
+/// graphics card as they are, and a small internal shader
+/// computes the 6 vertices of each sprite. Otherwise the
+/// batch is expanded into triangles on the CPU and drawn with
+/// a single regular draw call; this is also what happens if
+/// the batch is drawn with a custom shader, or submitted to a
+/// sf::RenderQueue. Both paths produce the same result, and
+/// unmodified batches are not uploaded or expanded again.
+///
+/// The sprites are drawn in the order of their indices.
+/// Like for sf::Sprite, the texture must stay alive as long
+/// as the batch uses it.
+///
+/// Usage example:
+/// \code
+/// sf::Texture texture;
+/// texture.loadFromFile("bullets.png");
+///
+/// sf::SpriteBatch bullets(texture);
+/// for (int i = 0; i < 10000; ++i)
+///     bullets.add(sf::Vector2f(i % 100 * 8.f, i / 100 * 8.f), sf::IntRect(0, 0, 8, 8),
+///                 sf::Color::White, 0.f, sf::Vector2f(1.f, 1.f), sf::Vector2f(4.f, 4.f));
+///
+/// // Every frame...
+/// for (std::size_t i = 0; i < bullets.getSpriteCount(); ++i)
+///     bullets.setRotation(i, bullets.getRotation(i) + 5.f);
+///
+/// window.draw(bullets);
+/// \endcode
+///
+/// \see sf::Sprite, sf::VertexArray
+///
+////////////////////////////////////////////////////////////
@@ -39,6 +39,12 @@ class Window;
 class RenderTarget;
 class RenderTexture;
 class InputStream;
+class ImageView;
+
+namespace priv
+{
+    class SoftwareRasterizer;
+}
 
 ////////////////////////////////////////////////////////////
 /// \brief Image living on the graphics card that can be used for drawing
@@ -213,6 +219,105 @@ public:
     ////////////////////////////////////////////////////////////
     bool loadFromImage(const Image& image, const IntRect& area = IntRect());
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Load the texture from a block-compressed image file
+    ///
+    /// The supported containers are KTX (version 1) and DDS,
+    /// holding a 2D image in one of the following formats:
+    /// S3TC (DXT1, DXT3, DXT5), ETC1, ETC2 (RGB, RGB with
+    /// punch-through alpha, RGBA) or ASTC (LDR, any block size).
+    /// sRGB variants of these formats are supported as well and
+    /// enable the sRGB conversion of the texture (see setSrgb).
+    ///
+    /// The compressed data is uploaded as is when the graphics
+    /// driver supports its format, which saves both the decoding
+    /// time and 4 to 8 times the video memory of an uncompressed
+    /// texture. If the file contains a complete mipmap chain,
+    /// all the levels are uploaded and the texture uses them
+    /// like after a call to generateMipmap.
+    ///
+    /// When the format is not supported by the driver, the first
+    /// level is decompressed on the CPU and loaded like a regular
+    /// image. ASTC cannot be decompressed: loading an ASTC file
+    /// fails if the driver doesn't support it.
+    ///
+    /// The update and generateMipmap functions cannot be used
+    /// on a texture that holds compressed data, they leave it
+    /// unchanged and report an error. This doesn't apply when
+    /// the data was decompressed on the CPU.
+    ///
+    /// If this function fails, the texture is left unchanged.
+    ///
+    /// \param filename Path of the KTX or DDS file to load
+    ///
+    /// \return True if loading was successful
+    ///
+    /// \see loadFromCompressedMemory, loadFromCompressedStream
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadFromCompressedFile(const std::string& filename);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load the texture from a block-compressed image file in memory
+    ///
+    /// See loadFromCompressedFile for the list of supported
+    /// containers and formats.
+    ///
+    /// If this function fails, the texture is left unchanged.
+    ///
+    /// \param data Pointer to the file data in memory
+    /// \param size Size of the data to load, in bytes
+    ///
+    /// \return True if loading was successful
+    ///
+    /// \see loadFromCompressedFile, loadFromCompressedStream
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadFromCompressedMemory(const void* data, std::size_t size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load the texture from a block-compressed image file in a custom stream
+    ///
+    /// See loadFromCompressedFile for the list of supported
+    /// containers and formats.
+    ///
+    /// If this function fails, the texture is left unchanged.
+    ///
+    /// \param stream Source stream to read from
+    ///
+    /// \return True if loading was successful
+    ///
+    /// \see loadFromCompressedFile, loadFromCompressedMemory
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadFromCompressedStream(InputStream& stream);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load the texture and its mipmap from a chain of images
+    ///
+    /// The first image is the base level of the texture, the
+    /// following ones are its mipmap levels: each one must be
+    /// half the size of the previous one (rounded down) and
+    /// the chain must go down to 1x1, like the ones built by
+    /// Image::createMipmaps. A single image is loaded like
+    /// with loadFromImage.
+    ///
+    /// Unlike generateMipmap, this lets you choose how the
+    /// levels are filtered, or build them offline.
+    /// Mipmaps require a texture whose size is valid for the
+    /// graphics driver (see getValidSize).
+    ///
+    /// If this function fails, the texture is left unchanged.
+    ///
+    /// \param levels Images of the base level and of the mipmap levels
+    ///
+    /// \return True if loading was successful
+    ///
+    /// \see loadFromImage, generateMipmap, Image::createMipmaps
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadFromMipmaps(const std::vector<Image>& levels);
+
     ////////////////////////////////////////////////////////////
     /// \brief Return the size of the texture
     ///
@@ -313,6 +418,27 @@ public:
     ////////////////////////////////////////////////////////////
     void update(const Image& image, unsigned int x, unsigned int y);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Update a part of the texture from a view on pixels
+    ///
+    /// The pixels are uploaded straight from the buffer of the
+    /// view, padded rows included, without being copied to an
+    /// intermediate image.
+    ///
+    /// No additional check is performed on the size of the view,
+    /// passing an invalid combination of size and offset
+    /// will lead to an undefined behavior.
+    ///
+    /// This function does nothing if the texture was not
+    /// previously created.
+    ///
+    /// \param view View on the pixels to copy to the texture
+    /// \param x    X offset in the texture where to copy the source pixels
+    /// \param y    Y offset in the texture where to copy the source pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    void update(const ImageView& view, unsigned int x, unsigned int y);
+
     ////////////////////////////////////////////////////////////
     /// \brief Update the texture from the contents of a window
     ///
@@ -459,8 +585,9 @@ public:
     /// can also improve rendering performance in certain scenarios.
     ///
     /// Mipmap generation relies on the necessary OpenGL extension being
-    /// available. If it is unavailable or generation fails due to another
-    /// reason, this function will return false. Mipmap data is only valid from
+    /// available. If it is unavailable, the levels are built on the CPU
+    /// from a copy of the texture, which is much slower. If generation
+    /// fails for another reason, this function will return false. Mipmap data is only valid from
     /// the time it is generated until the next time the base level image is
     /// modified, at which point this function will have to be called again to
     /// regenerate it.
@@ -480,6 +607,31 @@ public:
     ////////////////////////////////////////////////////////////
     Texture& operator =(const Texture& right);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Swap the contents of this texture with those of another
+    ///
+    /// Only the OpenGL handles and the properties are exchanged,
+    /// no pixel is copied, unlike with the copy constructor
+    /// and the assignment operator.
+    ///
+    /// \param right Instance to swap with
+    ///
+    ////////////////////////////////////////////////////////////
+    void swap(Texture& right);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get an estimate of the graphics memory used by the texture
+    ///
+    /// The estimate counts 4 bytes per pixel of the actual
+    /// OpenGL texture (padding included) plus a third for
+    /// the mipmap, if any. Block-compressed textures use
+    /// less memory than reported.
+    ///
+    /// \return Memory used by the texture, in bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getMemoryUsage() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Get the underlying OpenGL handle of the texture.
     ///
@@ -541,6 +693,8 @@ private:
 
     friend class RenderTexture;
     friend class RenderTarget;
+    friend class TextureStream;
+    friend class priv::SoftwareRasterizer;
 
     ////////////////////////////////////////////////////////////
     /// \brief Get a valid image size according to hardware support
@@ -566,6 +720,30 @@ private:
     ////////////////////////////////////////////////////////////
     void invalidateMipmap();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Upload the mipmap levels of the texture
+    ///
+    /// \a levels must be a complete chain starting at the
+    /// size of the texture; the first image (base level)
+    /// is not uploaded.
+    ///
+    /// \param levels Images of the base level and of the mipmap levels
+    ///
+    /// \return True if the levels were uploaded
+    ///
+    ////////////////////////////////////////////////////////////
+    bool uploadMipmap(const std::vector<Image>& levels);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update the whole texture from the bound pixel unpack buffer
+    ///
+    /// The pixels are read from the start of the buffer bound to
+    /// GL_PIXEL_UNPACK_BUFFER, which must be large enough.
+    /// This function is for internal use by TextureStream.
+    ///
+    ////////////////////////////////////////////////////////////
+    void updateFromPixelBuffer();
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
@@ -578,6 +756,7 @@ private:
     mutable bool m_pixelsFlipped; ///< To work around the inconsistency in Y orientation
     bool         m_fboAttachment; ///< Is this texture owned by a framebuffer object?
     bool         m_hasMipmap;     ///< Has the mipmap been generated?
+    bool         m_isCompressed;  ///< Does the texture hold block-compressed data?
     Uint64       m_cacheId;       ///< Unique number that identifies the texture to the render target's cache
 };
 
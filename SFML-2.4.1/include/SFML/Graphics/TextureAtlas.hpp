@@ -0,0 +1,217 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2016 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_TEXTUREATLAS_HPP
+#define SFML_TEXTUREATLAS_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <map>
+#include <string>
+#include <vector>
+
+
+namespace sf
+{
+class Image;
+
+////////////////////////////////////////////////////////////
+/// \brief Set of images packed into a few large textures
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API TextureAtlas
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Location of an image in the atlas
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Region
+    {
+        ////////////////////////////////////////////////////////////
+        /// \brief Default constructor
+        ///
+        ////////////////////////////////////////////////////////////
+        Region();
+
+        std::size_t page; ///< Index of the texture that contains the image
+        IntRect     rect; ///< Area of the image in the texture (empty if it could not be loaded or packed)
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty atlas.
+    ///
+    ////////////////////////////////////////////////////////////
+    TextureAtlas();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load images from files and pack them
+    ///
+    /// The files are decoded in parallel (see Image::loadFromFiles),
+    /// then packed with loadFromImages. Each image is named after
+    /// the path it was loaded from.
+    ///
+    /// \param filenames   Paths of the image files to load
+    /// \param pageSize    Maximum width and height of the textures
+    /// \param padding     Number of empty pixels kept between images
+    /// \param threadCount Number of decoding threads, 0 to use one per CPU core
+    ///
+    /// \return True if every image was loaded and packed
+    ///
+    /// \see loadFromImages
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadFromFiles(const std::vector<std::string>& filenames, unsigned int pageSize = 2048, unsigned int padding = 1, unsigned int threadCount = 0);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Pack images into textures
+    ///
+    /// The images are packed, largest first, into as few
+    /// textures (pages) as possible. Each page is at most
+    /// \a pageSize pixels wide and high (and never larger than
+    /// Texture::getMaximumSize()), and is cropped to the area
+    /// actually used.
+    ///
+    /// Images that are empty or larger than a page are skipped:
+    /// their region has an empty rectangle, and the function
+    /// returns false, but all the other images are still available.
+    ///
+    /// \param images   Images to pack
+    /// \param names    Names of the images, used by findRegion (may be empty)
+    /// \param pageSize Maximum width and height of the textures
+    /// \param padding  Number of empty pixels kept between images
+    ///
+    /// \return True if every image was packed
+    ///
+    /// \see loadFromFiles
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadFromImages(const std::vector<Image>& images, const std::vector<std::string>& names, unsigned int pageSize = 2048, unsigned int padding = 1);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of images in the atlas
+    ///
+    /// \return Number of images, including those that failed to load
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getRegionCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the location of an image, by index
+    ///
+    /// \param index Index of the image, in the order given when loading
+    ///
+    /// \return Page and area of the image
+    ///
+    ////////////////////////////////////////////////////////////
+    const Region& getRegion(std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the location of an image, by name
+    ///
+    /// \param name   Name of the image
+    /// \param region Filled with the page and area of the image
+    ///
+    /// \return True if an image of that name was packed
+    ///
+    ////////////////////////////////////////////////////////////
+    bool findRegion(const std::string& name, Region& region) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of textures of the atlas
+    ///
+    /// \return Number of pages
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getPageCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get one of the textures of the atlas
+    ///
+    /// \param page Index of the page
+    ///
+    /// \return Texture of the page
+    ///
+    ////////////////////////////////////////////////////////////
+    const Texture& getTexture(std::size_t page) const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<Texture>               m_pages;   ///< Textures holding the packed images
+    std::vector<Region>                m_regions; ///< Location of each image
+    std::map<std::string, std::size_t> m_names;   ///< Index of the images, by name
+};
+
+} // namespace sf
+
+
+#endif // SFML_TEXTUREATLAS_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::TextureAtlas
+/// \ingroup graphics
+///
+/// Drawing many sprites that each use their own texture
+/// forces a texture switch between every draw call. sf::TextureAtlas
+/// loads a set of images and packs them into a few large
+/// textures instead, so that sprites can share them and only
+/// differ by their texture rectangle.
+///
+/// Loading from files decodes the images on several threads,
+/// which also makes it a fast way to load many images at once.
+///
+/// Usage example:
+/// \code
+/// std::vector<std::string> files;
+/// files.push_back("player.png");
+/// files.push_back("enemy.png");
+/// files.push_back("bullet.png");
+///
+/// sf::TextureAtlas atlas;
+/// if (!atlas.loadFromFiles(files))
+///     return -1;
+///
+/// sf::TextureAtlas::Region region;
+/// if (atlas.findRegion("enemy.png", region))
+/// {
+///     sf::Sprite enemy(atlas.getTexture(region.page), region.rect);
+///     window.draw(enemy);
+/// }
+/// \endcode
+///
+/// \see sf::Texture, sf::Image, sf::Sprite
+///
+////////////////////////////////////////////////////////////
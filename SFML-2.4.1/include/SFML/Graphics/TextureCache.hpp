@@ -0,0 +1,329 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2016 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_TEXTURECACHE_HPP
+#define SFML_TEXTURECACHE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <list>
+#include <map>
+#include <string>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Set of textures loaded on demand, within a memory budget
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API TextureCache : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Hook that loads and unloads the textures of a cache
+    ///
+    /// The default implementation loads the texture from the
+    /// file whose path is the key. Override it to load textures
+    /// from streams or archives, or to replace the uploads
+    /// by a mock in tests.
+    ///
+    ////////////////////////////////////////////////////////////
+    class SFML_GRAPHICS_API Loader
+    {
+    public:
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Virtual destructor
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual ~Loader();
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Load a texture
+        ///
+        /// \param key     Key of the texture, as passed to TextureCache::get
+        /// \param texture Texture to load
+        ///
+        /// \return True if loading was successful
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual bool load(const std::string& key, Texture& texture);
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Release the graphics memory of a texture
+        ///
+        /// The default implementation destroys the OpenGL texture,
+        /// but keeps the smooth, repeated and sRGB settings so that
+        /// they still apply after the texture is reloaded.
+        ///
+        /// \param texture Texture to unload
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual void unload(Texture& texture);
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Get the graphics memory used by a loaded texture
+        ///
+        /// The default implementation returns the estimate of
+        /// Texture::getMemoryUsage.
+        ///
+        /// \param texture Loaded texture
+        ///
+        /// \return Memory used by the texture, in bytes
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual std::size_t getMemoryUsage(const Texture& texture);
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Usage statistics of a cache
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Statistics
+    {
+        Uint64      hits;          ///< Number of requests for textures that were resident
+        Uint64      misses;        ///< Number of requests that needed a load
+        Uint64      failures;      ///< Number of loads that failed
+        Uint64      evictions;     ///< Number of textures unloaded to respect the budget
+        float       hitRate;       ///< Ratio of hits to requests, from 0 to 1
+        std::size_t textureCount;  ///< Number of textures known by the cache, resident or not
+        std::size_t residentCount; ///< Number of textures currently loaded
+        std::size_t residentBytes; ///< Memory used by the loaded textures, in bytes
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the cache
+    ///
+    /// The loader is not owned by the cache, it must stay
+    /// alive as long as the cache uses it.
+    ///
+    /// \param budget Maximum memory used by the resident textures, in bytes (0 for no limit)
+    /// \param loader Loader to use, or NULL to load the textures from files
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit TextureCache(std::size_t budget = 0, Loader* loader = NULL);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// All the textures are destroyed, pointers returned by
+    /// get become invalid.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~TextureCache();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the memory budget
+    ///
+    /// If the resident textures use more memory than the new
+    /// budget, the least recently used ones are unloaded.
+    ///
+    /// \param budget Maximum memory used by the resident textures, in bytes (0 for no limit)
+    ///
+    /// \see getBudget
+    ///
+    ////////////////////////////////////////////////////////////
+    void setBudget(std::size_t budget);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the memory budget
+    ///
+    /// \return Maximum memory used by the resident textures, in bytes (0 for no limit)
+    ///
+    /// \see setBudget
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getBudget() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a texture, loading it if it is not resident
+    ///
+    /// The texture becomes the most recently used one. If
+    /// loading it exceeds the budget, the least recently used
+    /// textures are unloaded until the budget is respected
+    /// (the requested texture is always kept).
+    ///
+    /// The address of the texture never changes until it is
+    /// removed from the cache: an evicted texture is empty but
+    /// stays valid, and is reloaded by the next call to get.
+    /// Calling get for every texture drawn in a frame keeps
+    /// the visible textures resident.
+    ///
+    /// \param key Key of the texture (file name, by default)
+    ///
+    /// \return Pointer to the texture, or NULL if it failed to load
+    ///
+    ////////////////////////////////////////////////////////////
+    Texture* get(const std::string& key);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether a texture is currently loaded
+    ///
+    /// This function doesn't change the usage order.
+    ///
+    /// \param key Key of the texture
+    ///
+    /// \return True if the texture is resident
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isResident(const std::string& key) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove a texture from the cache
+    ///
+    /// The texture is destroyed, pointers to it become invalid.
+    ///
+    /// \param key Key of the texture
+    ///
+    ////////////////////////////////////////////////////////////
+    void remove(const std::string& key);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove all the textures from the cache
+    ///
+    /// The statistics are kept.
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the usage statistics of the cache
+    ///
+    /// \return Statistics since the creation of the cache or the last call to resetStatistics
+    ///
+    ////////////////////////////////////////////////////////////
+    Statistics getStatistics() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Reset the counters of requests, failures and evictions
+    ///
+    ////////////////////////////////////////////////////////////
+    void resetStatistics();
+
+private:
+
+    struct Entry;
+    typedef std::list<Entry*> UsageList;              ///< Resident entries, most recently used first
+    typedef std::map<std::string, Entry*> EntryTable;     ///< Entries by key
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Cached texture
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Entry
+    {
+        Texture             texture;  ///< The texture (empty when not resident)
+        bool                resident; ///< Is the texture loaded?
+        std::size_t         bytes;    ///< Memory used by the texture, when loaded
+        UsageList::iterator usage;    ///< Position in the usage list, when loaded
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Unload an entry and remove it from the usage list
+    ///
+    /// \param entry Entry to unload
+    ///
+    ////////////////////////////////////////////////////////////
+    void unload(Entry& entry);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Unload the least recently used textures until the budget is respected
+    ///
+    /// \param keep Entry that must not be unloaded (can be NULL)
+    ///
+    ////////////////////////////////////////////////////////////
+    void evict(const Entry* keep);
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Loader      m_defaultLoader; ///< Loader used when none is provided
+    Loader*     m_loader;        ///< Loader of the textures
+    std::size_t m_budget;        ///< Maximum memory used by the resident textures
+    EntryTable  m_entries;       ///< All the entries, by key
+    UsageList   m_usage;         ///< Resident entries, most recently used first
+    std::size_t m_residentBytes; ///< Memory used by the resident textures
+    Uint64      m_hits;          ///< Number of requests for resident textures
+    Uint64      m_misses;        ///< Number of requests that needed a load
+    Uint64      m_failures;      ///< Number of loads that failed
+    Uint64      m_evictions;     ///< Number of textures unloaded to respect the budget
+};
+
+} // namespace sf
+
+
+#endif // SFML_TEXTURECACHE_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::TextureCache
+/// \ingroup graphics
+///
+/// sf::TextureCache keeps a set of textures identified by keys
+/// (file names by default) and limits the graphics memory they
+/// use: when loading a texture makes the resident textures
+/// exceed the budget, the least recently used ones are
+/// unloaded. They are transparently reloaded the next time
+/// they are requested.
+///
+/// Textures are used through get(), which also records the
+/// order of use: calling it each time a texture is drawn
+/// keeps the textures of the current frame resident, and
+/// evicts the ones that are no longer visible.
+///
+/// Loading is delegated to a sf::TextureCache::Loader, which
+/// can be overridden to read textures from other sources or
+/// to test the eviction policy without uploading anything.
+///
+/// getStatistics() reports the hit rate of the cache and the
+/// memory used by the resident textures.
+///
+/// Usage example:
+/// \code
+/// // Keep at most 256 MB of gallery pictures on the graphics card
+/// sf::TextureCache cache(256 * 1024 * 1024);
+///
+/// // Every frame...
+/// for (std::size_t i = first; i < last; ++i)
+/// {
+///     sf::Texture* texture = cache.get(pictures[i]);
+///     if (texture)
+///         window.draw(sf::Sprite(*texture));
+/// }
+///
+/// sf::TextureCache::Statistics statistics = cache.getStatistics();
+/// std::cout << statistics.hitRate * 100 << "% hits, "
+///           << statistics.residentBytes / 1024 << " KB resident" << std::endl;
+/// \endcode
+///
+/// \see sf::Texture
+///
+////////////////////////////////////////////////////////////
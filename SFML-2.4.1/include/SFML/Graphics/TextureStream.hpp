@@ -0,0 +1,302 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2016 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_TEXTURESTREAM_HPP
+#define SFML_TEXTURESTREAM_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Window/GlResource.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <vector>
+
+
+namespace sf
+{
+class Texture;
+
+////////////////////////////////////////////////////////////
+/// \brief Asynchronous transfers of pixels between
+///        the CPU and a texture
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API TextureStream : GlResource, NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Handle to a transfer started by the stream
+    ///
+    /// A valid handle is never 0.
+    ///
+    ////////////////////////////////////////////////////////////
+    typedef Uint64 Transfer;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    TextureStream();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~TextureStream();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Attach the stream to a texture
+    ///
+    /// The stream allocates \a bufferCount pixel buffers of the
+    /// size of the texture, which are used in turn by successive
+    /// transfers: 2 buffers give double-buffered streaming,
+    /// 3 buffers triple-buffered streaming.
+    ///
+    /// The texture must be created before calling this function,
+    /// and it must stay alive and keep the same size as long as
+    /// the stream is attached to it. If the texture is resized,
+    /// this function must be called again.
+    ///
+    /// If pixel buffer objects are not supported by the graphics
+    /// driver, transfers are executed synchronously.
+    ///
+    /// \param texture     Texture to stream pixels to and from
+    /// \param bufferCount Number of pixel buffers to use
+    ///
+    /// \return True if the stream was successfully created
+    ///
+    ////////////////////////////////////////////////////////////
+    bool create(Texture& texture, unsigned int bufferCount = 2);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start uploading pixels to the whole texture
+    ///
+    /// The \a pixels array is copied into the next pixel buffer
+    /// and can be reused as soon as this function returns; the
+    /// copy from the buffer to the texture is then executed by
+    /// the graphics driver without blocking the caller. Drawing
+    /// the texture afterwards always uses the new pixels.
+    ///
+    /// The \a pixels array is assumed to have the same size as
+    /// the texture.
+    ///
+    /// \param pixels Array of pixels to copy to the texture
+    ///
+    /// \return Handle to the transfer, 0 if it failed
+    ///
+    ////////////////////////////////////////////////////////////
+    Transfer upload(const Uint8* pixels);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start uploading an image to the whole texture
+    ///
+    /// The image must have the same size as the texture.
+    ///
+    /// \param image Image to copy to the texture
+    ///
+    /// \return Handle to the transfer, 0 if it failed
+    ///
+    ////////////////////////////////////////////////////////////
+    Transfer upload(const Image& image);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start downloading the pixels of the texture
+    ///
+    /// The pixels are copied to the next pixel buffer by the
+    /// graphics driver, without blocking the caller. They can
+    /// be retrieved with getImage once the transfer is complete.
+    ///
+    /// The result must be retrieved before the buffer is reused,
+    /// i.e. before \a bufferCount other transfers are started.
+    ///
+    /// \return Handle to the transfer, 0 if it failed
+    ///
+    /// \see getImage
+    ///
+    ////////////////////////////////////////////////////////////
+    Transfer download();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether a transfer is complete
+    ///
+    /// This function never blocks. It requires fences
+    /// (ARB_sync, core since OpenGL 3.2): without them,
+    /// transfers are always reported as complete and
+    /// retrieving the result of a download may block.
+    ///
+    /// \param transfer Handle to the transfer
+    ///
+    /// \return True if the transfer is complete
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isComplete(Transfer transfer) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait until a transfer is complete
+    ///
+    /// \param transfer Handle to the transfer
+    ///
+    ////////////////////////////////////////////////////////////
+    void wait(Transfer transfer);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Retrieve the pixels of a download
+    ///
+    /// This function waits until the transfer is complete,
+    /// then copies the downloaded pixels to \a image.
+    ///
+    /// \param transfer Handle to the download
+    /// \param image    Image to fill with the texture's pixels
+    ///
+    /// \return True if the pixels were retrieved, false if the
+    ///         handle doesn't refer to a download or if its
+    ///         buffer has already been reused
+    ///
+    /// \see download
+    ///
+    ////////////////////////////////////////////////////////////
+    bool getImage(Transfer transfer, Image& image);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the transfers are asynchronous
+    ///
+    /// \return True if pixel buffer objects are used, false if
+    ///         the synchronous fallback is used
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isAsynchronous() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Pixel buffer of the ring
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Buffer
+    {
+        unsigned int buffer;   ///< OpenGL identifier of the pixel buffer object
+        void*        fence;    ///< Fence placed after the last transfer, if any
+        Transfer     transfer; ///< Last transfer that used this buffer
+        bool         download; ///< Is the last transfer a download?
+        bool         flipped;  ///< Were the downloaded pixels flipped vertically?
+        Image        image;    ///< Result of the last download, in synchronous mode
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destroy the buffers and fences
+    ///
+    ////////////////////////////////////////////////////////////
+    void cleanup();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Take the next buffer of the ring for a new transfer
+    ///
+    /// \param download Is the new transfer a download?
+    ///
+    /// \return Buffer to use
+    ///
+    ////////////////////////////////////////////////////////////
+    Buffer& nextBuffer(bool download);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Find the buffer used by a transfer
+    ///
+    /// \param transfer Handle to the transfer
+    ///
+    /// \return Buffer used by the transfer, or NULL if it has been reused
+    ///
+    ////////////////////////////////////////////////////////////
+    Buffer* findBuffer(Transfer transfer);
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Texture*            m_texture;      ///< Texture attached to the stream
+    Vector2u            m_size;         ///< Size of the texture when the stream was created
+    Vector2u            m_actualSize;   ///< Actual (padded) size of the texture
+    std::vector<Buffer> m_buffers;      ///< Ring of pixel buffers
+    std::size_t         m_next;         ///< Index of the next buffer to use
+    Transfer            m_lastTransfer; ///< Handle to the last transfer started
+    bool                m_asynchronous; ///< Are pixel buffer objects used?
+};
+
+} // namespace sf
+
+
+#endif // SFML_TEXTURESTREAM_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::TextureStream
+/// \ingroup graphics
+///
+/// sf::Texture::update and sf::Texture::copyToImage are
+/// synchronous: the calling thread waits until the graphics
+/// driver has copied the pixels, which makes them too slow
+/// to stream video frames or to capture screenshots every frame.
+///
+/// sf::TextureStream performs the same transfers through a ring
+/// of pixel buffer objects: the calling thread only copies the
+/// pixels to or from a buffer, while the graphics driver moves
+/// them between the buffer and the texture in the background.
+/// Each transfer returns a handle that can be polled (isComplete),
+/// waited for (wait) and, for downloads, used to get the result
+/// (getImage).
+///
+/// When pixel buffer objects are not available (old drivers,
+/// OpenGL ES), the stream falls back to sf::Texture::update and
+/// sf::Texture::copyToImage and the transfers are complete as
+/// soon as they are started.
+///
+/// Usage example:
+/// \code
+/// sf::Texture frame;
+/// frame.create(1920, 1080);
+///
+/// sf::TextureStream stream;
+/// stream.create(frame, 3);
+///
+/// // Every frame of the video...
+/// stream.upload(decoder.getPixels());
+/// window.draw(sf::Sprite(frame));
+///
+/// // Capture a screenshot without stalling the frame
+/// sf::TextureStream::Transfer capture = stream.download();
+///
+/// // ...a few frames later
+/// if (stream.isComplete(capture))
+/// {
+///     sf::Image screenshot;
+///     stream.getImage(capture, screenshot);
+///     screenshot.saveToFile("screenshot.png");
+/// }
+/// \endcode
+///
+/// \see sf::Texture
+///
+////////////////////////////////////////////////////////////
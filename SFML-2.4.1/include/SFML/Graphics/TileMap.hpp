@@ -0,0 +1,391 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2016 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_TILEMAP_HPP
+#define SFML_TILEMAP_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/Transformable.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/Time.hpp>
+#include <map>
+#include <vector>
+
+
+namespace sf
+{
+class Texture;
+
+////////////////////////////////////////////////////////////
+/// \brief Drawable grid of tiles taken from a tileset texture,
+///        split in chunks that are built and drawn on demand
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API TileMap : public Drawable, public Transformable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Number of tiles of a chunk, horizontally and vertically
+    ///
+    ////////////////////////////////////////////////////////////
+    enum {ChunkSize = 32};
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty tile map, with no tileset texture.
+    ///
+    ////////////////////////////////////////////////////////////
+    TileMap();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create the layers of the map
+    ///
+    /// All the tiles are empty (0) after this call; the previous
+    /// tiles are lost. The tileset texture, the texture
+    /// rectangles and the animations are kept.
+    ///
+    /// \param size       Number of tiles of the map, horizontally and vertically
+    /// \param tileSize   Size of a tile, in pixels (both in the map and in the tileset)
+    /// \param layerCount Number of layers, drawn on top of each other
+    ///
+    ////////////////////////////////////////////////////////////
+    void create(const Vector2u& size, const Vector2u& tileSize, unsigned int layerCount = 1);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the tileset texture
+    ///
+    /// The \a texture argument refers to a texture that must
+    /// exist as long as the map uses it. Indeed, the map
+    /// doesn't store its own copy of the texture, but rather
+    /// keeps a pointer to the one that you passed to this
+    /// function.
+    /// By default, the tile n is the n-th tile of the texture,
+    /// counting from the top-left corner row by row: see
+    /// setTileRect to use other layouts.
+    ///
+    /// \param texture New tileset texture
+    ///
+    /// \see getTexture
+    ///
+    ////////////////////////////////////////////////////////////
+    void setTexture(const Texture& texture);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the tileset texture
+    ///
+    /// \return Pointer to the tileset texture, or NULL if there's none
+    ///
+    /// \see setTexture
+    ///
+    ////////////////////////////////////////////////////////////
+    const Texture* getTexture() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of tiles of the map
+    ///
+    /// \return Number of tiles, horizontally and vertically
+    ///
+    ////////////////////////////////////////////////////////////
+    const Vector2u& getSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the size of a tile
+    ///
+    /// \return Size of a tile, in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    const Vector2u& getTileSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of layers of the map
+    ///
+    /// \return Number of layers
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getLayerCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change a tile
+    ///
+    /// Only the chunk that contains the tile is rebuilt, the
+    /// next time it is drawn. Coordinates outside of the map
+    /// are ignored.
+    ///
+    /// \param x     Horizontal coordinate of the tile
+    /// \param y     Vertical coordinate of the tile
+    /// \param tile  New tile: 0 for none, n for the n-th tile of the tileset
+    /// \param layer Layer of the tile
+    ///
+    /// \see getTile
+    ///
+    ////////////////////////////////////////////////////////////
+    void setTile(unsigned int x, unsigned int y, Uint32 tile, unsigned int layer = 0);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a tile
+    ///
+    /// \param x     Horizontal coordinate of the tile
+    /// \param y     Vertical coordinate of the tile
+    /// \param layer Layer of the tile
+    ///
+    /// \return Tile at the given coordinates, or 0 if they are outside of the map
+    ///
+    /// \see setTile
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint32 getTile(unsigned int x, unsigned int y, unsigned int layer = 0) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the area of the tileset displayed by a tile
+    ///
+    /// This overrides the default layout of the tileset for
+    /// this tile. Passing an empty rectangle restores it.
+    ///
+    /// \param tile Tile to change (1 or more)
+    /// \param rect Area of the texture to display, in pixels
+    ///
+    /// \see getTileRect
+    ///
+    ////////////////////////////////////////////////////////////
+    void setTileRect(Uint32 tile, const IntRect& rect);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the area of the tileset displayed by a tile
+    ///
+    /// For animated tiles, this is the area of the current frame.
+    ///
+    /// \param tile Tile (1 or more)
+    ///
+    /// \return Area of the texture, in pixels
+    ///
+    /// \see setTileRect
+    ///
+    ////////////////////////////////////////////////////////////
+    IntRect getTileRect(Uint32 tile) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Animate a tile
+    ///
+    /// The tile cycles through the areas of \a frames, showing
+    /// each of them during \a frameDuration. Only the texture
+    /// coordinates of the animated tiles are updated when the
+    /// frame changes, the chunks are not rebuilt.
+    /// Passing an empty list of frames stops the animation.
+    ///
+    /// \param tile          Tile to animate (1 or more)
+    /// \param frames        Areas of the texture to display, in order, in pixels
+    /// \param frameDuration Duration of each frame
+    ///
+    /// \see update
+    ///
+    ////////////////////////////////////////////////////////////
+    void setAnimation(Uint32 tile, const std::vector<IntRect>& frames, Time frameDuration);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Advance the animations
+    ///
+    /// \param elapsed Time elapsed since the last update
+    ///
+    /// \see setAnimation
+    ///
+    ////////////////////////////////////////////////////////////
+    void update(Time elapsed);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the local bounding rectangle of the map
+    ///
+    /// \return Local bounding rectangle of the map
+    ///
+    ////////////////////////////////////////////////////////////
+    FloatRect getLocalBounds() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the global bounding rectangle of the map
+    ///
+    /// \return Global bounding rectangle of the map
+    ///
+    ////////////////////////////////////////////////////////////
+    FloatRect getGlobalBounds() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw the visible chunks of the map to a render target
+    ///
+    /// \param target Render target to draw to
+    /// \param states Current render states
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void draw(RenderTarget& target, RenderStates states) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Geometry of a square of tiles of a layer
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Chunk
+    {
+        std::vector<Vertex>                          vertices;       ///< Two triangles for each non-empty tile
+        std::vector<std::pair<std::size_t, Uint32> > animatedTiles;  ///< First vertex and tile of the animated tiles
+        bool                                         built;          ///< Is the geometry up to date?
+        bool                                         resident;       ///< Does the chunk hold geometry memory?
+        Uint32                                       animationStamp; ///< Animation state of the texture coordinates
+        Uint32                                       lastDrawn;      ///< Last draw of the map that drew this chunk
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Animation of a tile
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Animation
+    {
+        std::vector<IntRect> frames;        ///< Areas of the texture, in order
+        Int64                frameDuration; ///< Duration of a frame, in microseconds
+        std::size_t          current;       ///< Index of the current frame
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Mark all the chunks to be rebuilt
+    ///
+    ////////////////////////////////////////////////////////////
+    void invalidate();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Build the geometry of a chunk
+    ///
+    /// \param chunk  Chunk to build
+    /// \param layer  Layer of the chunk
+    /// \param chunkX Horizontal coordinate of the chunk
+    /// \param chunkY Vertical coordinate of the chunk
+    ///
+    ////////////////////////////////////////////////////////////
+    void build(Chunk& chunk, unsigned int layer, unsigned int chunkX, unsigned int chunkY) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update the texture coordinates of the animated tiles of a chunk
+    ///
+    /// \param chunk Chunk to update
+    ///
+    ////////////////////////////////////////////////////////////
+    void animate(Chunk& chunk) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Release the geometry of the chunks not drawn recently
+    ///
+    /// \param keep Number of chunks to keep, the most recently drawn ones
+    ///
+    ////////////////////////////////////////////////////////////
+    void releaseChunks(std::size_t keep) const;
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    const Texture*                   m_texture;        ///< Tileset texture
+    Vector2u                         m_size;           ///< Number of tiles, horizontally and vertically
+    Vector2u                         m_tileSize;       ///< Size of a tile, in pixels
+    unsigned int                     m_layerCount;     ///< Number of layers
+    Vector2u                         m_chunkCount;     ///< Number of chunks of a layer, horizontally and vertically
+    std::vector<Uint32>              m_tiles;          ///< Tiles of all the layers, row by row
+    std::vector<IntRect>             m_tileRects;      ///< Areas of the texture that override the default layout, by tile
+    std::map<Uint32, Animation>      m_animations;     ///< Animations, by tile
+    Int64                            m_time;           ///< Time of the animations, in microseconds
+    Uint32                           m_animationStamp; ///< Changes whenever an animation shows another frame
+    mutable std::vector<Chunk>       m_chunks;         ///< Chunks of all the layers, row by row
+    mutable std::vector<std::size_t> m_residentChunks; ///< Indices of the chunks that hold geometry memory
+    mutable Uint32                   m_drawCount;      ///< Number of times the map was drawn
+};
+
+} // namespace sf
+
+
+#endif // SFML_TILEMAP_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::TileMap
+/// \ingroup graphics
+///
+/// sf::TileMap displays a grid of tiles taken from a single
+/// tileset texture, on one or more layers. It's the usual way
+/// to draw the background of a 2D game.
+///
+/// Each layer is split in chunks of ChunkSize x ChunkSize
+/// tiles, that have their own geometry (plain triangles, so
+/// that it works on OpenGL ES too). Only the chunks that are
+/// visible in the view of the render target are drawn, and a
+/// chunk is built the first time it becomes visible: the cost
+/// of a frame depends on the size of the view, not on the size
+/// of the map. Changing a tile only rebuilds its chunk, the
+/// next time it is drawn. The geometry of chunks that haven't
+/// been visible for a while is released, so scrolling through
+/// a huge map doesn't accumulate memory.
+///
+/// Tiles are numbered like in most map editors: 0 is an empty
+/// tile, and n is the n-th tile of the tileset (counting from
+/// its top-left corner, row by row). setTileRect overrides the
+/// area of the texture that a tile displays, and setAnimation
+/// makes it cycle through several areas; call update() every
+/// frame to advance the animations.
+///
+/// The layers are drawn in order, with the render states of the
+/// draw (and the map's own transform). The visible area is
+/// computed from the current view of the target; when it is
+/// drawn to a target with no view (like sf::RenderQueue), the
+/// whole map is drawn.
+///
+/// Usage example:
+/// \code
+/// sf::Texture tileset;
+/// tileset.loadFromFile("tileset.png");
+///
+/// sf::TileMap map;
+/// map.create(sf::Vector2u(4096, 4096), sf::Vector2u(16, 16), 2);
+/// map.setTexture(tileset);
+/// for (unsigned int y = 0; y < 4096; ++y)
+///     for (unsigned int x = 0; x < 4096; ++x)
+///         map.setTile(x, y, level[y * 4096 + x]);
+///
+/// // Water is animated with 4 frames
+/// std::vector<sf::IntRect> water;
+/// for (int i = 0; i < 4; ++i)
+///     water.push_back(sf::IntRect(i * 16, 128, 16, 16));
+/// map.setAnimation(waterTile, water, sf::milliseconds(250));
+///
+/// // Every frame...
+/// map.update(clock.restart());
+/// window.clear();
+/// window.draw(map);
+/// window.display();
+/// \endcode
+///
+/// \see sf::Texture, sf::VertexArray, sf::SpriteBatch
+///
+////////////////////////////////////////////////////////////
@@ -86,6 +86,17 @@ public:
     ////////////////////////////////////////////////////////////
     void clear();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Swap the contents of this packet with those of another
+    ///
+    /// The data and the reading positions are exchanged
+    /// without being copied.
+    ///
+    /// \param right Instance to swap with
+    ///
+    ////////////////////////////////////////////////////////////
+    void swap(Packet& right);
+
     ////////////////////////////////////////////////////////////
     /// \brief Get a pointer to the data contained in the packet
     ///
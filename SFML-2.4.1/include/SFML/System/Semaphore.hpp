@@ -0,0 +1,151 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2016 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_SEMAPHORE_HPP
+#define SFML_SEMAPHORE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/Export.hpp>
+#include <SFML/System/NonCopyable.hpp>
+
+
+namespace sf
+{
+namespace priv
+{
+    class SemaphoreImpl;
+}
+
+////////////////////////////////////////////////////////////
+/// \brief Counter that threads can wait on until another
+///        thread signals it
+///
+////////////////////////////////////////////////////////////
+class SFML_SYSTEM_API Semaphore : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// \param count Initial value of the counter
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit Semaphore(unsigned int count = 0);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~Semaphore();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Decrement the counter, waiting until it is positive
+    ///
+    /// If the counter is 0, this call blocks the execution
+    /// until another thread calls post().
+    ///
+    /// \see tryWait, post
+    ///
+    ////////////////////////////////////////////////////////////
+    void wait();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Decrement the counter if it is positive, without waiting
+    ///
+    /// \return True if the counter was decremented, false if it was 0
+    ///
+    /// \see wait
+    ///
+    ////////////////////////////////////////////////////////////
+    bool tryWait();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Increment the counter
+    ///
+    /// If threads are waiting on the semaphore, one of them
+    /// is unblocked.
+    ///
+    /// \see wait
+    ///
+    ////////////////////////////////////////////////////////////
+    void post();
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    priv::SemaphoreImpl* m_semaphoreImpl; ///< OS-specific implementation
+};
+
+} // namespace sf
+
+
+#endif // SFML_SEMAPHORE_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::Semaphore
+/// \ingroup system
+///
+/// A semaphore is a counter shared by several threads: wait()
+/// takes one unit from it, blocking while it is 0, and post()
+/// gives one back. It's the usual way for a thread to sleep
+/// until another one has something for it, instead of polling
+/// a shared variable with sf::sleep.
+///
+/// Usage example (a producer and a consumer sharing a
+/// fixed number of buffers):
+/// \code
+/// sf::Semaphore freeBuffers(2); // both buffers can be filled
+/// sf::Semaphore fullBuffers(0); // nothing to consume yet
+///
+/// void producer()
+/// {
+///     for (int i = 0; ; ++i)
+///     {
+///         freeBuffers.wait(); // wait until the consumer releases a buffer
+///         fill(buffers[i % 2]);
+///         fullBuffers.post(); // wake up the consumer
+///     }
+/// }
+///
+/// void consumer()
+/// {
+///     for (int i = 0; ; ++i)
+///     {
+///         fullBuffers.wait(); // wait until the producer fills a buffer
+///         use(buffers[i % 2]);
+///         freeBuffers.post(); // give it back to the producer
+///     }
+/// }
+/// \endcode
+///
+/// \see sf::Mutex, sf::Thread
+///
+////////////////////////////////////////////////////////////
@@ -171,6 +171,18 @@ public:
     ////////////////////////////////////////////////////////////
     void terminate();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of threads that can run concurrently
+    ///
+    /// This is the number of logical processors available on the
+    /// system. It is useful to decide how many threads to create
+    /// to spread work across all the cores.
+    ///
+    /// \return Number of concurrent threads supported (at least 1)
+    ///
+    ////////////////////////////////////////////////////////////
+    static unsigned int getHardwareConcurrency();
+
 private:
 
     friend class priv::ThreadImpl;
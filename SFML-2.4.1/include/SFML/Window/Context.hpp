@@ -117,6 +117,19 @@ public:
     ////////////////////////////////////////////////////////////
     static const Context* getActiveContext();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the identifier of the context active on the current thread
+    ///
+    /// Every context has a unique identifier, including the
+    /// ones of windows. OpenGL objects that can't be shared
+    /// between contexts, such as frame buffer objects, can be
+    /// managed per context with it.
+    ///
+    /// \return Identifier of the active context, or 0 if none is active
+    ///
+    ////////////////////////////////////////////////////////////
+    static Uint64 getActiveContextId();
+
     ////////////////////////////////////////////////////////////
     /// \brief Construct a in-memory context
     ///
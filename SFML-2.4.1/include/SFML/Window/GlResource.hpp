@@ -37,6 +37,13 @@ namespace sf
 
 class Context;
 
+namespace priv
+{
+    class GlContext;
+}
+
+typedef void(*ContextDestroyCallback)(void*);
+
 ////////////////////////////////////////////////////////////
 /// \brief Base class for classes that require an OpenGL context
 ///
@@ -63,6 +70,20 @@ protected:
     ////////////////////////////////////////////////////////////
     static void ensureGlContext();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Register a function to be called when a context is destroyed
+    ///
+    /// This is used for internal purposes in order to properly
+    /// clean up OpenGL resources that cannot be shared between
+    /// contexts. The callback is called with the context being
+    /// destroyed active, once for each context.
+    ///
+    /// \param callback Function to be called when a context is destroyed
+    /// \param arg      Argument to pass when calling the function
+    ///
+    ////////////////////////////////////////////////////////////
+    static void registerContextDestroyCallback(ContextDestroyCallback callback, void* arg);
+
     ////////////////////////////////////////////////////////////
     /// \brief RAII helper class to temporarily lock an available context for use
     ///
@@ -83,7 +104,8 @@ protected:
         ~TransientContextLock();
 
     private:
-        Context* m_context; ///< Temporary context, in case we needed to create one
+        Context*         m_context;          ///< Temporary context, in case we needed to create one
+        priv::GlContext* m_transientContext; ///< Context borrowed for the lifetime of the lock, if any
     };
 };
 
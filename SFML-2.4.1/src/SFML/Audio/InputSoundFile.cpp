@@ -32,6 +32,87 @@
 #include <SFML/System/FileInputStream.hpp>
 #include <SFML/System/MemoryInputStream.hpp>
 #include <SFML/System/Err.hpp>
+#include <fstream>
+#include <vector>
+
+
+namespace
+{
+    // Header of the seek index cache files: magic "SFSI" and format version
+    const sf::Uint32 seekIndexMagic   = 0x49534653;
+    const sf::Uint32 seekIndexVersion = 1;
+
+    void writeUint64(std::ostream& stream, sf::Uint64 value)
+    {
+        char bytes[8];
+        for (int i = 0; i < 8; ++i)
+            bytes[i] = static_cast<char>((value >> (i * 8)) & 0xFF);
+        stream.write(bytes, sizeof(bytes));
+    }
+
+    bool readUint64(std::istream& stream, sf::Uint64& value)
+    {
+        unsigned char bytes[8];
+        if (!stream.read(reinterpret_cast<char*>(bytes), sizeof(bytes)))
+            return false;
+
+        value = 0;
+        for (int i = 0; i < 8; ++i)
+            value |= static_cast<sf::Uint64>(bytes[i]) << (i * 8);
+        return true;
+    }
+
+    bool loadSeekIndex(const std::string& filename, sf::Uint64 streamSize, sf::Uint64 sampleCount, std::vector<sf::SoundFileReader::SeekPoint>& index)
+    {
+        std::ifstream file(filename.c_str(), std::ios_base::binary);
+        if (!file)
+            return false;
+
+        // The index is only valid for the file it was built from
+        sf::Uint64 header, size, samples, count;
+        if (!readUint64(file, header) || (header != ((static_cast<sf::Uint64>(seekIndexVersion) << 32) | seekIndexMagic)))
+            return false;
+        if (!readUint64(file, size) || !readUint64(file, samples) || !readUint64(file, count))
+            return false;
+        if ((size != streamSize) || (samples != sampleCount))
+            return false;
+
+        index.clear();
+        for (sf::Uint64 i = 0; i < count; ++i)
+        {
+            sf::SoundFileReader::SeekPoint point;
+            if (!readUint64(file, point.sampleOffset) || !readUint64(file, point.byteOffset))
+                return false;
+
+            // Entries must be sorted and lie within the file
+            if ((point.byteOffset >= streamSize) || (!index.empty() && (point.sampleOffset <= index.back().sampleOffset)))
+                return false;
+
+            index.push_back(point);
+        }
+
+        return !index.empty();
+    }
+
+    bool saveSeekIndex(const std::string& filename, sf::Uint64 streamSize, sf::Uint64 sampleCount, const std::vector<sf::SoundFileReader::SeekPoint>& index)
+    {
+        std::ofstream file(filename.c_str(), std::ios_base::binary);
+        if (!file)
+            return false;
+
+        writeUint64(file, (static_cast<sf::Uint64>(seekIndexVersion) << 32) | seekIndexMagic);
+        writeUint64(file, streamSize);
+        writeUint64(file, sampleCount);
+        writeUint64(file, index.size());
+        for (std::size_t i = 0; i < index.size(); ++i)
+        {
+            writeUint64(file, index[i].sampleOffset);
+            writeUint64(file, index[i].byteOffset);
+        }
+
+        return file.good();
+    }
+}
 
 
 namespace sf
@@ -214,6 +295,40 @@ void InputSoundFile::seek(Time timeOffset)
 }
 
 
+////////////////////////////////////////////////////////////
+bool InputSoundFile::buildSeekIndex(const std::string& cacheFilename)
+{
+    if (!m_reader)
+        return false;
+
+    Int64 streamSize = m_stream->getSize();
+    std::vector<SoundFileReader::SeekPoint> index;
+
+    // Try the cached index first
+    if (!cacheFilename.empty() && (streamSize > 0))
+    {
+        if (loadSeekIndex(cacheFilename, static_cast<Uint64>(streamSize), m_sampleCount, index))
+        {
+            m_reader->setSeekIndex(index);
+            m_reader->seek(0);
+            return true;
+        }
+    }
+
+    // Scan the file
+    if (!m_reader->buildSeekIndex(index))
+        return false;
+
+    if (!cacheFilename.empty() && (streamSize > 0))
+    {
+        if (!saveSeekIndex(cacheFilename, static_cast<Uint64>(streamSize), m_sampleCount, index))
+            err() << "Failed to save the seek index to \"" << cacheFilename << "\"" << std::endl;
+    }
+
+    return true;
+}
+
+
 ////////////////////////////////////////////////////////////
 Uint64 InputSoundFile::read(Int16* samples, Uint64 maxCount)
 {
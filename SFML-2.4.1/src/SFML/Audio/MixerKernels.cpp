@@ -0,0 +1,326 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2016 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/MixerKernels.hpp>
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+    #include <emmintrin.h>
+    #define SFML_MIXER_SSE2
+#elif defined(__ARM_NEON__) || defined(__ARM_NEON)
+    #include <arm_neon.h>
+    #define SFML_MIXER_NEON
+#endif
+
+
+namespace
+{
+    ////////////////////////////////////////////////////////////
+    // Convert 16-bit samples to floats, without any scaling
+    ////////////////////////////////////////////////////////////
+    void convertFromInt16(const sf::Int16* input, float* output, std::size_t sampleCount)
+    {
+        std::size_t i = 0;
+
+    #if defined(SFML_MIXER_SSE2)
+
+        for (; i + 8 <= sampleCount; i += 8)
+        {
+            __m128i samples = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i));
+            __m128i low     = _mm_srai_epi32(_mm_unpacklo_epi16(samples, samples), 16);
+            __m128i high    = _mm_srai_epi32(_mm_unpackhi_epi16(samples, samples), 16);
+            _mm_storeu_ps(output + i,     _mm_cvtepi32_ps(low));
+            _mm_storeu_ps(output + i + 4, _mm_cvtepi32_ps(high));
+        }
+
+    #elif defined(SFML_MIXER_NEON)
+
+        for (; i + 8 <= sampleCount; i += 8)
+        {
+            int16x8_t samples = vld1q_s16(input + i);
+            vst1q_f32(output + i,     vcvtq_f32_s32(vmovl_s16(vget_low_s16(samples))));
+            vst1q_f32(output + i + 4, vcvtq_f32_s32(vmovl_s16(vget_high_s16(samples))));
+        }
+
+    #endif
+
+        for (; i < sampleCount; ++i)
+            output[i] = input[i];
+    }
+
+
+    ////////////////////////////////////////////////////////////
+    // Compute a + (b - a) * t on 4 lanes
+    ////////////////////////////////////////////////////////////
+    void lerp4(const float* a, const float* b, const float* t, float* output)
+    {
+    #if defined(SFML_MIXER_SSE2)
+
+        __m128 va = _mm_loadu_ps(a);
+        __m128 vb = _mm_loadu_ps(b);
+        _mm_storeu_ps(output, _mm_add_ps(va, _mm_mul_ps(_mm_sub_ps(vb, va), _mm_loadu_ps(t))));
+
+    #elif defined(SFML_MIXER_NEON)
+
+        float32x4_t va = vld1q_f32(a);
+        float32x4_t vb = vld1q_f32(b);
+        vst1q_f32(output, vaddq_f32(va, vmulq_f32(vsubq_f32(vb, va), vld1q_f32(t))));
+
+    #else
+
+        for (int i = 0; i < 4; ++i)
+            output[i] = a[i] + (b[i] - a[i]) * t[i];
+
+    #endif
+    }
+
+
+    ////////////////////////////////////////////////////////////
+    // Interpolate frames that all have their next frame inside the source
+    ////////////////////////////////////////////////////////////
+    void interpolate(const sf::Int16* samples, unsigned int channelCount, double position, double step, float* output, std::size_t frameCount)
+    {
+        // Gather 4 samples at a time (4 mono frames or 2 stereo frames) and blend them
+        std::size_t framesPerBlock = 4 / channelCount;
+        std::size_t frame = 0;
+        float a[4], b[4], t[4];
+
+        for (; frame + framesPerBlock <= frameCount; frame += framesPerBlock)
+        {
+            for (std::size_t lane = 0; lane < 4; ++lane)
+            {
+                double      current = position + (frame + lane / channelCount) * step;
+                std::size_t index   = static_cast<std::size_t>(current);
+                std::size_t offset  = index * channelCount + lane % channelCount;
+
+                a[lane] = samples[offset];
+                b[lane] = samples[offset + channelCount];
+                t[lane] = static_cast<float>(current - index);
+            }
+
+            lerp4(a, b, t, output + frame * channelCount);
+        }
+
+        for (; frame < frameCount; ++frame)
+        {
+            double      current = position + frame * step;
+            std::size_t index   = static_cast<std::size_t>(current);
+            float       factor  = static_cast<float>(current - index);
+
+            for (unsigned int channel = 0; channel < channelCount; ++channel)
+            {
+                float first  = samples[index * channelCount + channel];
+                float second = samples[(index + 1) * channelCount + channel];
+                output[frame * channelCount + channel] = first + (second - first) * factor;
+            }
+        }
+    }
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+std::size_t resample(const Int16* samples, unsigned int channelCount, std::size_t frameCount, double& position,
+                     double step, bool loop, float* output, std::size_t outputFrameCount)
+{
+    std::size_t produced = 0;
+
+    if (frameCount == 0)
+        return 0;
+
+    while (produced < outputFrameCount)
+    {
+        // Wrap around or stop at the end of the source
+        if (position >= frameCount)
+        {
+            if (!loop)
+                break;
+
+            position = std::fmod(position, static_cast<double>(frameCount));
+        }
+
+        std::size_t index = static_cast<std::size_t>(position);
+        float* out = output + produced * channelCount;
+
+        // Same rate, aligned on a frame: no interpolation needed
+        if ((step == 1.0) && (position == static_cast<double>(index)))
+        {
+            std::size_t count = std::min(outputFrameCount - produced, frameCount - index);
+            convertFromInt16(samples + index * channelCount, out, count * channelCount);
+            produced += count;
+            position += static_cast<double>(count);
+            continue;
+        }
+
+        // Interpolate the run of frames whose next frame is inside the source
+        double      available = (static_cast<double>(frameCount - 1) - position) / step;
+        std::size_t count     = available > 0 ? std::min(static_cast<std::size_t>(available), outputFrameCount - produced) : 0;
+        if (count > 0)
+        {
+            interpolate(samples, channelCount, position, step, out, count);
+            produced += count;
+            position += count * step;
+            continue;
+        }
+
+        // Last frame of the source: interpolate with the first frame if looping, or hold it
+        std::size_t next   = (index + 1 < frameCount) ? index + 1 : (loop ? 0 : index);
+        float       factor = static_cast<float>(position - index);
+        for (unsigned int channel = 0; channel < channelCount; ++channel)
+        {
+            float first  = samples[index * channelCount + channel];
+            float second = samples[next * channelCount + channel];
+            out[channel] = first + (second - first) * factor;
+        }
+        produced += 1;
+        position += step;
+    }
+
+    return produced;
+}
+
+
+////////////////////////////////////////////////////////////
+void mixMono(float* mix, const float* input, std::size_t frameCount, float leftGain, float rightGain)
+{
+    std::size_t i = 0;
+
+#if defined(SFML_MIXER_SSE2)
+
+    __m128 gains = _mm_setr_ps(leftGain, rightGain, leftGain, rightGain);
+    for (; i + 4 <= frameCount; i += 4)
+    {
+        __m128 samples = _mm_loadu_ps(input + i);
+        float* out = mix + i * 2;
+        _mm_storeu_ps(out,     _mm_add_ps(_mm_loadu_ps(out),     _mm_mul_ps(_mm_unpacklo_ps(samples, samples), gains)));
+        _mm_storeu_ps(out + 4, _mm_add_ps(_mm_loadu_ps(out + 4), _mm_mul_ps(_mm_unpackhi_ps(samples, samples), gains)));
+    }
+
+#elif defined(SFML_MIXER_NEON)
+
+    float gainValues[4] = {leftGain, rightGain, leftGain, rightGain};
+    float32x4_t gains = vld1q_f32(gainValues);
+    for (; i + 4 <= frameCount; i += 4)
+    {
+        float32x4_t   samples    = vld1q_f32(input + i);
+        float32x4x2_t duplicated = vzipq_f32(samples, samples);
+        float* out = mix + i * 2;
+        vst1q_f32(out,     vaddq_f32(vld1q_f32(out),     vmulq_f32(duplicated.val[0], gains)));
+        vst1q_f32(out + 4, vaddq_f32(vld1q_f32(out + 4), vmulq_f32(duplicated.val[1], gains)));
+    }
+
+#endif
+
+    for (; i < frameCount; ++i)
+    {
+        mix[i * 2]     += input[i] * leftGain;
+        mix[i * 2 + 1] += input[i] * rightGain;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void mixStereo(float* mix, const float* input, std::size_t frameCount, float leftGain, float rightGain)
+{
+    std::size_t i = 0;
+
+#if defined(SFML_MIXER_SSE2)
+
+    __m128 gains = _mm_setr_ps(leftGain, rightGain, leftGain, rightGain);
+    for (; i + 2 <= frameCount; i += 2)
+        _mm_storeu_ps(mix + i * 2, _mm_add_ps(_mm_loadu_ps(mix + i * 2), _mm_mul_ps(_mm_loadu_ps(input + i * 2), gains)));
+
+#elif defined(SFML_MIXER_NEON)
+
+    float gainValues[4] = {leftGain, rightGain, leftGain, rightGain};
+    float32x4_t gains = vld1q_f32(gainValues);
+    for (; i + 2 <= frameCount; i += 2)
+        vst1q_f32(mix + i * 2, vaddq_f32(vld1q_f32(mix + i * 2), vmulq_f32(vld1q_f32(input + i * 2), gains)));
+
+#endif
+
+    for (; i < frameCount; ++i)
+    {
+        mix[i * 2]     += input[i * 2] * leftGain;
+        mix[i * 2 + 1] += input[i * 2 + 1] * rightGain;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void convertToInt16(const float* input, Int16* output, std::size_t sampleCount)
+{
+    std::size_t i = 0;
+
+#if defined(SFML_MIXER_SSE2)
+
+    __m128 minimum  = _mm_set1_ps(-32768.f);
+    __m128 maximum  = _mm_set1_ps(32767.f);
+    __m128 half     = _mm_set1_ps(0.5f);
+    __m128 signMask = _mm_set1_ps(-0.f);
+    for (; i + 8 <= sampleCount; i += 8)
+    {
+        __m128 low  = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(input + i),     minimum), maximum);
+        __m128 high = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(input + i + 4), minimum), maximum);
+        low  = _mm_add_ps(low,  _mm_or_ps(_mm_and_ps(low,  signMask), half));
+        high = _mm_add_ps(high, _mm_or_ps(_mm_and_ps(high, signMask), half));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i), _mm_packs_epi32(_mm_cvttps_epi32(low), _mm_cvttps_epi32(high)));
+    }
+
+#elif defined(SFML_MIXER_NEON)
+
+    float32x4_t minimum  = vdupq_n_f32(-32768.f);
+    float32x4_t maximum  = vdupq_n_f32(32767.f);
+    uint32x4_t  half     = vreinterpretq_u32_f32(vdupq_n_f32(0.5f));
+    uint32x4_t  signMask = vdupq_n_u32(0x80000000u);
+    for (; i + 8 <= sampleCount; i += 8)
+    {
+        float32x4_t low  = vminq_f32(vmaxq_f32(vld1q_f32(input + i),     minimum), maximum);
+        float32x4_t high = vminq_f32(vmaxq_f32(vld1q_f32(input + i + 4), minimum), maximum);
+        low  = vaddq_f32(low,  vreinterpretq_f32_u32(vorrq_u32(vandq_u32(vreinterpretq_u32_f32(low),  signMask), half)));
+        high = vaddq_f32(high, vreinterpretq_f32_u32(vorrq_u32(vandq_u32(vreinterpretq_u32_f32(high), signMask), half)));
+        vst1q_s16(output + i, vcombine_s16(vqmovn_s32(vcvtq_s32_f32(low)), vqmovn_s32(vcvtq_s32_f32(high))));
+    }
+
+#endif
+
+    for (; i < sampleCount; ++i)
+    {
+        float value = std::min(std::max(input[i], -32768.f), 32767.f);
+        value += (value < 0.f) ? -0.5f : 0.5f;
+        output[i] = static_cast<Int16>(value);
+    }
+}
+
+} // namespace priv
+
+} // namespace sf
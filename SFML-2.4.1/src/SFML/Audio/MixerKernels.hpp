@@ -0,0 +1,108 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2016 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_MIXERKERNELS_HPP
+#define SFML_MIXERKERNELS_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Config.hpp>
+#include <cstddef>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Resample 16-bit samples to floating point samples
+///
+/// The source is read from \a position, advancing by \a step
+/// frames for every output frame, with linear interpolation
+/// between source frames. The output has the same number of
+/// channels as the source (1 or 2). When \a step is exactly 1
+/// and the position lies on a frame, the samples are simply
+/// converted.
+///
+/// \param samples          Source samples
+/// \param channelCount     Number of channels of the source (1 or 2)
+/// \param frameCount       Number of frames in the source
+/// \param position         Read position in the source, in frames; updated by the function
+/// \param step             Number of source frames per output frame
+/// \param loop             True to wrap around at the end of the source
+/// \param output           Output buffer, must hold \a outputFrameCount * \a channelCount floats
+/// \param outputFrameCount Number of frames to produce
+///
+/// \return Number of frames produced (less than \a outputFrameCount
+///         if the end of a non-looping source was reached)
+///
+////////////////////////////////////////////////////////////
+std::size_t resample(const Int16* samples, unsigned int channelCount, std::size_t frameCount, double& position,
+                     double step, bool loop, float* output, std::size_t outputFrameCount);
+
+////////////////////////////////////////////////////////////
+/// \brief Accumulate mono samples into a stereo mix buffer
+///
+/// \param mix        Interleaved stereo mix buffer
+/// \param input      Mono samples to add
+/// \param frameCount Number of frames to process
+/// \param leftGain   Gain applied to the left channel
+/// \param rightGain  Gain applied to the right channel
+///
+////////////////////////////////////////////////////////////
+void mixMono(float* mix, const float* input, std::size_t frameCount, float leftGain, float rightGain);
+
+////////////////////////////////////////////////////////////
+/// \brief Accumulate stereo samples into a stereo mix buffer
+///
+/// \param mix        Interleaved stereo mix buffer
+/// \param input      Interleaved stereo samples to add
+/// \param frameCount Number of frames to process
+/// \param leftGain   Gain applied to the left channel
+/// \param rightGain  Gain applied to the right channel
+///
+////////////////////////////////////////////////////////////
+void mixStereo(float* mix, const float* input, std::size_t frameCount, float leftGain, float rightGain);
+
+////////////////////////////////////////////////////////////
+/// \brief Convert floating point samples to saturated 16-bit samples
+///
+/// Values are rounded to the nearest integer (halfway cases
+/// away from zero) and clamped to the 16-bit range.
+///
+/// \param input       Samples to convert
+/// \param output      Output buffer
+/// \param sampleCount Number of samples to convert
+///
+////////////////////////////////////////////////////////////
+void convertToInt16(const float* input, Int16* output, std::size_t sampleCount);
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_MIXERKERNELS_HPP
@@ -109,6 +109,22 @@ Time Music::getDuration() const
 }
 
 
+////////////////////////////////////////////////////////////
+bool Music::buildSeekIndex(const std::string& cacheFilename)
+{
+    // Building the index rewinds the file, which would disturb the playback
+    if (getStatus() != Stopped)
+    {
+        err() << "Failed to build the seek index of the music (it must be stopped first)" << std::endl;
+        return false;
+    }
+
+    Lock lock(m_mutex);
+
+    return m_file.buildSeekIndex(cacheFilename);
+}
+
+
 ////////////////////////////////////////////////////////////
 bool Music::onGetData(SoundStream::Chunk& data)
 {
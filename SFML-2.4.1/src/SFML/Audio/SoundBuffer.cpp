@@ -214,6 +214,24 @@ SoundBuffer& SoundBuffer::operator =(const SoundBuffer& right)
 }
 
 
+////////////////////////////////////////////////////////////
+void SoundBuffer::swap(SoundBuffer& right)
+{
+    std::swap(m_samples,  right.m_samples);
+    std::swap(m_buffer,   right.m_buffer);
+    std::swap(m_duration, right.m_duration);
+
+    // The sounds stay attached to the same instance, but their source must use its new OpenAL buffer
+    SoundList sounds = m_sounds;
+    for (SoundList::const_iterator it = sounds.begin(); it != sounds.end(); ++it)
+        (*it)->setBuffer(*this);
+
+    sounds = right.m_sounds;
+    for (SoundList::const_iterator it = sounds.begin(); it != sounds.end(); ++it)
+        (*it)->setBuffer(right);
+}
+
+
 ////////////////////////////////////////////////////////////
 bool SoundBuffer::initialize(InputSoundFile& file)
 {
@@ -28,6 +28,7 @@
 #include <SFML/Audio/SoundFileReaderFlac.hpp>
 #include <SFML/System/InputStream.hpp>
 #include <SFML/System/Err.hpp>
+#include <algorithm>
 #include <cassert>
 
 
@@ -176,6 +177,14 @@ namespace
         sf::priv::SoundFileReaderFlac::ClientData* data = static_cast<sf::priv::SoundFileReaderFlac::ClientData*>(clientData);
         data->error = true;
     }
+
+    struct SeekPointLess
+    {
+        bool operator ()(const sf::SoundFileReader::SeekPoint& left, const sf::SoundFileReader::SeekPoint& right) const
+        {
+            return left.sampleOffset < right.sampleOffset;
+        }
+    };
 }
 
 namespace sf
@@ -209,9 +218,10 @@ bool SoundFileReaderFlac::check(InputStream& stream)
 
 ////////////////////////////////////////////////////////////
 SoundFileReaderFlac::SoundFileReaderFlac() :
-m_decoder(NULL),
-m_clientData(),
-m_channelCount(0)
+m_decoder         (NULL),
+m_clientData      (),
+m_channelCount    (0),
+m_firstFrameOffset(0)
 {
 }
 
@@ -252,6 +262,11 @@ bool SoundFileReaderFlac::open(InputStream& stream, Info& info)
     // We must keep the channel count for the seek function
     m_channelCount = info.channelCount;
 
+    // Remember where the audio data starts, for the seek index
+    FLAC__uint64 position = 0;
+    if (FLAC__stream_decoder_get_decode_position(m_decoder, &position))
+        m_firstFrameOffset = position;
+
     return true;
 }
 
@@ -266,6 +281,9 @@ void SoundFileReaderFlac::seek(Uint64 sampleOffset)
     m_clientData.remaining = 0;
     m_clientData.leftovers.clear();
 
+    if (seekIndexed(sampleOffset))
+        return;
+
     // FLAC decoder expects absolute sample offset, so we take the channel count out
     FLAC__stream_decoder_seek_absolute(m_decoder, sampleOffset / m_channelCount);
 }
@@ -317,6 +335,103 @@ Uint64 SoundFileReaderFlac::read(Int16* samples, Uint64 maxCount)
 }
 
 
+////////////////////////////////////////////////////////////
+bool SoundFileReaderFlac::buildSeekIndex(std::vector<SeekPoint>& index)
+{
+    assert(m_decoder);
+
+    index.clear();
+
+    // Go back to the first frame
+    m_clientData.buffer = NULL;
+    m_clientData.remaining = 0;
+    m_clientData.leftovers.clear();
+    if (m_clientData.stream->seek(m_firstFrameOffset) < 0)
+        return false;
+    FLAC__stream_decoder_flush(m_decoder);
+
+    // Skip the frames one by one, recording where each of them starts
+    Uint64 frame = 0;
+    for (;;)
+    {
+        FLAC__uint64 position = 0;
+        if (!FLAC__stream_decoder_get_decode_position(m_decoder, &position))
+            break;
+
+        if (!FLAC__stream_decoder_skip_single_frame(m_decoder))
+            break;
+
+        FLAC__uint64 next = 0;
+        if (!FLAC__stream_decoder_get_decode_position(m_decoder, &next) || (next == position))
+            break;
+
+        SeekPoint point;
+        point.sampleOffset = frame * m_channelCount;
+        point.byteOffset   = position;
+        index.push_back(point);
+
+        frame += FLAC__stream_decoder_get_blocksize(m_decoder);
+    }
+
+    // Rewind
+    m_clientData.stream->seek(m_firstFrameOffset);
+    FLAC__stream_decoder_flush(m_decoder);
+
+    m_seekIndex = index;
+    return !index.empty();
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundFileReaderFlac::setSeekIndex(const std::vector<SeekPoint>& index)
+{
+    m_seekIndex = index;
+}
+
+
+////////////////////////////////////////////////////////////
+bool SoundFileReaderFlac::seekIndexed(Uint64 sampleOffset)
+{
+    if (m_seekIndex.empty() || (sampleOffset >= m_clientData.info.sampleCount))
+        return false;
+
+    // Find the frame that contains the target sample
+    SeekPoint target;
+    target.sampleOffset = sampleOffset;
+    target.byteOffset = 0;
+    std::vector<SeekPoint>::const_iterator it = std::upper_bound(m_seekIndex.begin(), m_seekIndex.end(), target, SeekPointLess());
+    if (it == m_seekIndex.begin())
+        return false;
+    --it;
+
+    if (m_clientData.stream->seek(it->byteOffset) < 0)
+        return false;
+    FLAC__stream_decoder_flush(m_decoder);
+
+    // Decode the frame entirely into the leftovers (an empty output
+    // buffer sends everything there), then drop what precedes the target
+    Int16 unused = 0;
+    m_clientData.buffer = &unused;
+    Uint64 skip = sampleOffset - it->sampleOffset;
+    while (m_clientData.leftovers.size() <= skip)
+    {
+        skip -= m_clientData.leftovers.size();
+        m_clientData.leftovers.clear();
+
+        if (!FLAC__stream_decoder_process_single(m_decoder))
+            break;
+        if (FLAC__stream_decoder_get_state(m_decoder) == FLAC__STREAM_DECODER_END_OF_STREAM)
+            break;
+    }
+    m_clientData.buffer = NULL;
+
+    skip = std::min<Uint64>(skip, m_clientData.leftovers.size());
+    m_clientData.leftovers.erase(m_clientData.leftovers.begin(), m_clientData.leftovers.begin() + static_cast<std::size_t>(skip));
+
+    return true;
+}
+
+
 ////////////////////////////////////////////////////////////
 void SoundFileReaderFlac::close()
 {
@@ -326,6 +441,8 @@ void SoundFileReaderFlac::close()
         FLAC__stream_decoder_delete(m_decoder);
         m_decoder = NULL;
     }
+
+    m_seekIndex.clear();
 }
 
 } // namespace priv
@@ -104,6 +104,28 @@ public:
     ////////////////////////////////////////////////////////////
     virtual Uint64 read(Int16* samples, Uint64 maxCount);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Scan the open file and build its seek index
+    ///
+    /// One seek point is created for every FLAC frame. Frames
+    /// are skipped without being decoded, so the scan only
+    /// costs the parsing of the frame headers.
+    ///
+    /// \param index Array to fill with the seek points
+    ///
+    /// \return True if the index was built
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool buildSeekIndex(std::vector<SeekPoint>& index);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Give the reader a previously built seek index
+    ///
+    /// \param index Seek points of the file, sorted by sample offset
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void setSeekIndex(const std::vector<SeekPoint>& index);
+
 public:
 
     ////////////////////////////////////////////////////////////
@@ -128,12 +150,24 @@ private:
     ////////////////////////////////////////////////////////////
     void close();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Jump to a sample offset using the seek index
+    ///
+    /// \param sampleOffset Index of the sample to jump to, relative to the beginning
+    ///
+    /// \return True on success, false if the regular seek must be used
+    ///
+    ////////////////////////////////////////////////////////////
+    bool seekIndexed(Uint64 sampleOffset);
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    FLAC__StreamDecoder* m_decoder;      ///< FLAC decoder
-    ClientData           m_clientData;   ///< Structure passed to the decoder callbacks
-    unsigned int         m_channelCount; ///< number of channels of the sound file
+    FLAC__StreamDecoder*   m_decoder;          ///< FLAC decoder
+    ClientData             m_clientData;       ///< Structure passed to the decoder callbacks
+    unsigned int           m_channelCount;     ///< number of channels of the sound file
+    Uint64                 m_firstFrameOffset; ///< Position of the first audio frame in the stream
+    std::vector<SeekPoint> m_seekIndex;        ///< Seek points of the open file, if any
 };
 
 } // namespace priv
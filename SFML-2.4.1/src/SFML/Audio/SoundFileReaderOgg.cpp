@@ -64,6 +64,14 @@ namespace
     }
 
     static ov_callbacks callbacks = {&read, &seek, NULL, &tell};
+
+    struct SeekPointLess
+    {
+        bool operator ()(const sf::SoundFileReader::SeekPoint& left, const sf::SoundFileReader::SeekPoint& right) const
+        {
+            return left.sampleOffset < right.sampleOffset;
+        }
+    };
 }
 
 namespace sf
@@ -131,7 +139,8 @@ void SoundFileReaderOgg::seek(Uint64 sampleOffset)
 {
     assert(m_vorbis.datasource);
 
-    ov_pcm_seek(&m_vorbis, sampleOffset / m_channelCount);
+    if (!seekIndexed(sampleOffset))
+        ov_pcm_seek(&m_vorbis, sampleOffset / m_channelCount);
 }
 
 
@@ -163,6 +172,142 @@ Uint64 SoundFileReaderOgg::read(Int16* samples, Uint64 maxCount)
 }
 
 
+////////////////////////////////////////////////////////////
+bool SoundFileReaderOgg::buildSeekIndex(std::vector<SeekPoint>& index)
+{
+    assert(m_vorbis.datasource);
+
+    index.clear();
+
+    // Scan the raw pages of the stream; vorbisfile doesn't expose them
+    InputStream& stream = *static_cast<InputStream*>(m_vorbis.datasource);
+    if (stream.seek(0) != 0)
+        return false;
+
+    ogg_sync_state sync;
+    ogg_sync_init(&sync);
+
+    Int64       offset          = 0;  // position of the next page in the stream
+    Int64       resumeOffset    = 0;  // position of the first page following the last granule
+    ogg_int64_t previousGranule = -1; // granule of the last page that completed a packet
+    long        serial          = 0;
+    bool        firstPage       = true;
+    bool        supported       = true;
+
+    for (;;)
+    {
+        ogg_page page;
+        long result = ogg_sync_pageseek(&sync, &page);
+        if (result == 0)
+        {
+            // More data is needed to complete the page
+            char* buffer = ogg_sync_buffer(&sync, 4096);
+            Int64 count = stream.read(buffer, 4096);
+            if (count <= 0)
+                break;
+            ogg_sync_wrote(&sync, static_cast<long>(count));
+        }
+        else if (result < 0)
+        {
+            // Garbage before the page: skip it
+            offset -= result;
+        }
+        else
+        {
+            // Chained or multiplexed streams would need one index per logical stream
+            if (firstPage)
+            {
+                serial = ogg_page_serialno(&page);
+                firstPage = false;
+            }
+            else if (ogg_page_serialno(&page) != serial)
+            {
+                supported = false;
+                break;
+            }
+
+            // Pages that don't complete any packet have no granule position;
+            // decoding must then resume at the first page of the run
+            ogg_int64_t granule = ogg_page_granulepos(&page);
+            if (granule >= 0)
+            {
+                if ((granule > 0) && (previousGranule >= 0))
+                {
+                    SeekPoint point;
+                    point.sampleOffset = static_cast<Uint64>(previousGranule) * m_channelCount;
+                    point.byteOffset   = static_cast<Uint64>(resumeOffset);
+                    if (index.empty() || (point.sampleOffset > index.back().sampleOffset))
+                        index.push_back(point);
+                }
+
+                previousGranule = granule;
+                resumeOffset = offset + result;
+            }
+
+            offset += result;
+        }
+    }
+
+    ogg_sync_clear(&sync);
+
+    if (!supported)
+        index.clear();
+
+    // Give vorbisfile its stream position back
+    ov_pcm_seek(&m_vorbis, 0);
+
+    m_seekIndex = index;
+    return supported && !index.empty();
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundFileReaderOgg::setSeekIndex(const std::vector<SeekPoint>& index)
+{
+    m_seekIndex = index;
+}
+
+
+////////////////////////////////////////////////////////////
+bool SoundFileReaderOgg::seekIndexed(Uint64 sampleOffset)
+{
+    if (m_seekIndex.empty())
+        return false;
+
+    // Find the last seek point before the target; start one page earlier,
+    // since the first packet decoded after a raw seek only primes the decoder
+    SeekPoint target;
+    target.sampleOffset = sampleOffset;
+    target.byteOffset = 0;
+    std::vector<SeekPoint>::const_iterator it = std::upper_bound(m_seekIndex.begin(), m_seekIndex.end(), target, SeekPointLess());
+    if (it == m_seekIndex.begin())
+        return false;
+    if (--it != m_seekIndex.begin())
+        --it;
+
+    if (ov_raw_seek(&m_vorbis, static_cast<ogg_int64_t>(it->byteOffset)) != 0)
+        return false;
+
+    // Decode and discard the frames up to the target
+    ogg_int64_t frame = ov_pcm_tell(&m_vorbis);
+    ogg_int64_t targetFrame = static_cast<ogg_int64_t>(sampleOffset / m_channelCount);
+    if ((frame < 0) || (frame > targetFrame))
+        return false;
+
+    Int16 buffer[4096];
+    while (frame < targetFrame)
+    {
+        ogg_int64_t frames = std::min<ogg_int64_t>(targetFrame - frame, sizeof(buffer) / sizeof(Int16) / m_channelCount);
+        long bytesRead = ov_read(&m_vorbis, reinterpret_cast<char*>(buffer), static_cast<int>(frames * m_channelCount * sizeof(Int16)), 0, 2, 1, NULL);
+        if (bytesRead <= 0)
+            break;
+        frame += bytesRead / sizeof(Int16) / m_channelCount;
+    }
+
+    return true;
+}
+
+
 ////////////////////////////////////////////////////////////
 void SoundFileReaderOgg::close()
 {
@@ -171,6 +316,7 @@ void SoundFileReaderOgg::close()
         ov_clear(&m_vorbis);
         m_vorbis.datasource = NULL;
         m_channelCount = 0;
+        m_seekIndex.clear();
     }
 }
 
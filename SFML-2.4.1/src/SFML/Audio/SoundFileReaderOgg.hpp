@@ -30,6 +30,7 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Audio/SoundFileReader.hpp>
 #include <vorbis/vorbisfile.h>
+#include <vector>
 
 
 namespace sf
@@ -104,6 +105,27 @@ public:
     ////////////////////////////////////////////////////////////
     virtual Uint64 read(Int16* samples, Uint64 maxCount);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Scan the open file and build its seek index
+    ///
+    /// One seek point is created for every Ogg page that ends
+    /// a packet. Chained or multiplexed streams are not indexed.
+    ///
+    /// \param index Array to fill with the seek points
+    ///
+    /// \return True if the index was built
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool buildSeekIndex(std::vector<SeekPoint>& index);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Give the reader a previously built seek index
+    ///
+    /// \param index Seek points of the file, sorted by sample offset
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void setSeekIndex(const std::vector<SeekPoint>& index);
+
 private:
 
     ////////////////////////////////////////////////////////////
@@ -112,11 +134,22 @@ private:
     ////////////////////////////////////////////////////////////
     void close();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Jump to a sample offset using the seek index
+    ///
+    /// \param sampleOffset Index of the sample to jump to, relative to the beginning
+    ///
+    /// \return True on success, false if the regular seek must be used
+    ///
+    ////////////////////////////////////////////////////////////
+    bool seekIndexed(Uint64 sampleOffset);
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    OggVorbis_File m_vorbis;       // ogg/vorbis file handle
-    unsigned int   m_channelCount; // number of channels of the open sound file
+    OggVorbis_File         m_vorbis;       // ogg/vorbis file handle
+    unsigned int           m_channelCount; // number of channels of the open sound file
+    std::vector<SeekPoint> m_seekIndex;    // seek points of the open file, if any
 };
 
 } // namespace priv
@@ -0,0 +1,360 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2016 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/SoundFileTranscoder.hpp>
+#include <SFML/Audio/InputSoundFile.hpp>
+#include <SFML/Audio/OutputSoundFile.hpp>
+#include <SFML/System/Thread.hpp>
+#include <SFML/System/Clock.hpp>
+#include <SFML/System/Semaphore.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Err.hpp>
+#include <algorithm>
+
+
+namespace
+{
+    // Decoding stage of a pipelined transcoding; it runs in its own
+    // thread and fills two buffers alternately, while the encoding
+    // stage consumes them in the same order
+    struct Decoder
+    {
+        enum
+        {
+            BlockCount = 2 ///< Number of buffers shared by the two stages
+        };
+
+        Decoder(sf::InputSoundFile& input, std::size_t blockSize) :
+        file      (input),
+        freeBlocks(BlockCount),
+        fullBlocks(0)
+        {
+            for (int i = 0; i < BlockCount; ++i)
+            {
+                blocks[i].resize(blockSize);
+                counts[i] = 0;
+            }
+        }
+
+        void run()
+        {
+            for (std::size_t index = 0; ; index = (index + 1) % BlockCount)
+            {
+                // Wait until the encoding stage releases the buffer
+                sf::Clock waitClock;
+                freeBlocks.wait();
+                waitTime += waitClock.getElapsedTime();
+
+                // Decode the next block
+                sf::Clock decodeClock;
+                sf::Uint64 count = file.read(&blocks[index][0], blocks[index].size());
+                decodeTime += decodeClock.getElapsedTime();
+
+                // Hand it over to the encoding stage; an empty block marks the end of the file
+                counts[index] = count;
+                fullBlocks.post();
+                if (count == 0)
+                    return;
+            }
+        }
+
+        sf::InputSoundFile&    file;              ///< Sound file to decode
+        std::vector<sf::Int16> blocks[BlockCount]; ///< Buffers of decoded samples
+        sf::Uint64             counts[BlockCount]; ///< Number of samples in each buffer
+        sf::Semaphore          freeBlocks;        ///< Number of buffers that the decoding stage can fill
+        sf::Semaphore          fullBlocks;        ///< Number of buffers waiting to be encoded
+        sf::Time               decodeTime;        ///< Time spent decoding
+        sf::Time               waitTime;          ///< Time spent waiting for a free buffer
+    };
+
+    // Add the counters of a transcoding to the accumulated ones
+    void merge(sf::SoundFileTranscoder::Statistics& target, const sf::SoundFileTranscoder::Statistics& source)
+    {
+        target.fileCount      += source.fileCount;
+        target.failureCount   += source.failureCount;
+        target.sampleCount    += source.sampleCount;
+        target.decodeTime     += source.decodeTime;
+        target.encodeTime     += source.encodeTime;
+        target.decodeWaitTime += source.decodeWaitTime;
+        target.encodeWaitTime += source.encodeWaitTime;
+        target.elapsedTime    += source.elapsedTime;
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+SoundFileTranscoder::Statistics::Statistics() :
+fileCount     (0),
+failureCount  (0),
+sampleCount   (0),
+decodeTime    (Time::Zero),
+encodeTime    (Time::Zero),
+decodeWaitTime(Time::Zero),
+encodeWaitTime(Time::Zero),
+elapsedTime   (Time::Zero)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+float SoundFileTranscoder::Statistics::getDecodeThroughput() const
+{
+    return decodeTime > Time::Zero ? static_cast<float>(sampleCount) / decodeTime.asSeconds() : 0.f;
+}
+
+
+////////////////////////////////////////////////////////////
+float SoundFileTranscoder::Statistics::getEncodeThroughput() const
+{
+    return encodeTime > Time::Zero ? static_cast<float>(sampleCount) / encodeTime.asSeconds() : 0.f;
+}
+
+
+////////////////////////////////////////////////////////////
+SoundFileTranscoder::SoundFileTranscoder() :
+m_blockSize     (16384),
+m_statistics    (),
+m_batchInputs   (NULL),
+m_batchOutputs  (NULL),
+m_batchNext     (0),
+m_batchSuccesses(0)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundFileTranscoder::setBlockSize(std::size_t frameCount)
+{
+    m_blockSize = std::max<std::size_t>(frameCount, 1);
+}
+
+
+////////////////////////////////////////////////////////////
+bool SoundFileTranscoder::transcode(const std::string& inputFilename, const std::string& outputFilename)
+{
+    Clock clock;
+    Statistics statistics;
+
+    InputSoundFile input;
+    bool success = input.openFromFile(inputFilename) && transcodeFile(input, outputFilename, true, statistics);
+
+    if (!success)
+        statistics.failureCount++;
+    statistics.elapsedTime = clock.getElapsedTime();
+
+    Lock lock(m_batchMutex);
+    merge(m_statistics, statistics);
+
+    return success;
+}
+
+
+////////////////////////////////////////////////////////////
+bool SoundFileTranscoder::transcode(InputStream& inputStream, const std::string& outputFilename)
+{
+    Clock clock;
+    Statistics statistics;
+
+    InputSoundFile input;
+    bool success = input.openFromStream(inputStream) && transcodeFile(input, outputFilename, true, statistics);
+
+    if (!success)
+        statistics.failureCount++;
+    statistics.elapsedTime = clock.getElapsedTime();
+
+    Lock lock(m_batchMutex);
+    merge(m_statistics, statistics);
+
+    return success;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t SoundFileTranscoder::transcodeBatch(const std::vector<std::string>& inputFilenames, const std::vector<std::string>& outputFilenames, unsigned int threadCount)
+{
+    if (inputFilenames.size() != outputFilenames.size())
+    {
+        err() << "Failed to transcode sound files (the number of input and output files differ)" << std::endl;
+        return 0;
+    }
+
+    Clock clock;
+
+    m_batchInputs    = &inputFilenames;
+    m_batchOutputs   = &outputFilenames;
+    m_batchNext      = 0;
+    m_batchSuccesses = 0;
+
+    // Don't create more workers than there are files to transcode
+    if (threadCount == 0)
+        threadCount = Thread::getHardwareConcurrency();
+    threadCount = static_cast<unsigned int>(std::min<std::size_t>(threadCount, inputFilenames.size()));
+
+    // Start the workers, and wait until all the files are processed
+    std::vector<Thread*> workers;
+    for (unsigned int i = 0; i < threadCount; ++i)
+    {
+        workers.push_back(new Thread(&SoundFileTranscoder::processBatch, this));
+        workers.back()->launch();
+    }
+
+    for (std::vector<Thread*>::iterator it = workers.begin(); it != workers.end(); ++it)
+    {
+        (*it)->wait();
+        delete *it;
+    }
+
+    m_batchInputs  = NULL;
+    m_batchOutputs = NULL;
+
+    // The stages times are summed over the workers, but the elapsed time is the wall-clock time of the batch
+    Lock lock(m_batchMutex);
+    m_statistics.elapsedTime += clock.getElapsedTime();
+
+    return m_batchSuccesses;
+}
+
+
+////////////////////////////////////////////////////////////
+SoundFileTranscoder::Statistics SoundFileTranscoder::getStatistics() const
+{
+    Lock lock(m_batchMutex);
+    return m_statistics;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundFileTranscoder::resetStatistics()
+{
+    Lock lock(m_batchMutex);
+    m_statistics = Statistics();
+}
+
+
+////////////////////////////////////////////////////////////
+bool SoundFileTranscoder::transcodeFile(InputSoundFile& input, const std::string& outputFilename, bool pipelined, Statistics& statistics) const
+{
+    OutputSoundFile output;
+    if (!output.openFromFile(outputFilename, input.getSampleRate(), input.getChannelCount()))
+        return false;
+
+    // Blocks must hold whole frames
+    std::size_t blockSize = m_blockSize * input.getChannelCount();
+
+    if (pipelined)
+    {
+        // Start the decoding stage
+        Decoder decoder(input, blockSize);
+        Thread thread(&Decoder::run, &decoder);
+        thread.launch();
+
+        // Encode the blocks in the order they are decoded
+        for (std::size_t index = 0; ; index = (index + 1) % Decoder::BlockCount)
+        {
+            // Wait until the decoding stage fills the buffer
+            Clock waitClock;
+            decoder.fullBlocks.wait();
+            Uint64 count = decoder.counts[index];
+            statistics.encodeWaitTime += waitClock.getElapsedTime();
+
+            // An empty block marks the end of the file
+            if (count == 0)
+                break;
+
+            Clock encodeClock;
+            output.write(&decoder.blocks[index][0], count);
+            statistics.encodeTime += encodeClock.getElapsedTime();
+            statistics.sampleCount += count;
+
+            // Give the buffer back to the decoding stage
+            decoder.freeBlocks.post();
+        }
+
+        thread.wait();
+
+        statistics.decodeTime     += decoder.decodeTime;
+        statistics.decodeWaitTime += decoder.waitTime;
+    }
+    else
+    {
+        // Decode and encode alternately in the calling thread
+        std::vector<Int16> block(blockSize);
+        for (;;)
+        {
+            Clock decodeClock;
+            Uint64 count = input.read(&block[0], block.size());
+            statistics.decodeTime += decodeClock.getElapsedTime();
+
+            if (count == 0)
+                break;
+
+            Clock encodeClock;
+            output.write(&block[0], count);
+            statistics.encodeTime += encodeClock.getElapsedTime();
+            statistics.sampleCount += count;
+        }
+    }
+
+    statistics.fileCount++;
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundFileTranscoder::processBatch()
+{
+    for (;;)
+    {
+        // Take the next file of the batch
+        std::size_t index;
+        {
+            Lock lock(m_batchMutex);
+            if (m_batchNext >= m_batchInputs->size())
+                return;
+            index = m_batchNext++;
+        }
+
+        // Each worker already runs in parallel with the others, so there's no need to pipeline the stages
+        Statistics statistics;
+        InputSoundFile input;
+        bool success = input.openFromFile((*m_batchInputs)[index]) && transcodeFile(input, (*m_batchOutputs)[index], false, statistics);
+
+        if (!success)
+            statistics.failureCount++;
+
+        Lock lock(m_batchMutex);
+        merge(m_statistics, statistics);
+        if (success)
+            m_batchSuccesses++;
+    }
+}
+
+} // namespace sf
@@ -0,0 +1,513 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2016 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/SoundMixer.hpp>
+#include <SFML/Audio/Sound.hpp>
+#include <SFML/Audio/SoundBuffer.hpp>
+#include <SFML/Audio/OutputSoundFile.hpp>
+#include <SFML/Audio/MixerKernels.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Err.hpp>
+#include <algorithm>
+#include <cmath>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+const SoundMixer::VoiceId SoundMixer::InvalidVoice = 0;
+
+
+////////////////////////////////////////////////////////////
+SoundMixer::SoundMixer(unsigned int sampleRate, std::size_t maxVoices) :
+m_voices     (),
+m_maxVoices  (std::max<std::size_t>(maxVoices, 1)),
+m_nextId     (1),
+m_culledCount(0),
+m_mixBuffer  (),
+m_voiceBuffer(),
+m_samples    ()
+{
+    // Reserve the voices up front, so that starting a voice never allocates
+    m_voices.reserve(m_maxVoices);
+
+    // Stream chunks of 25 ms: small enough to keep the latency low
+    m_samples.resize(std::max(sampleRate / 40, 1u) * 2);
+
+    initialize(2, sampleRate);
+}
+
+
+////////////////////////////////////////////////////////////
+SoundMixer::~SoundMixer()
+{
+    // We must stop before destroying the voices :)
+    stop();
+}
+
+
+////////////////////////////////////////////////////////////
+SoundMixer::VoiceId SoundMixer::playVoice(const SoundBuffer& buffer, float volume, float pitch, float pan, int priority, bool loop)
+{
+    if ((buffer.getChannelCount() != 1) && (buffer.getChannelCount() != 2))
+    {
+        err() << "Failed to play voice: only mono and stereo sound buffers can be mixed" << std::endl;
+        return InvalidVoice;
+    }
+
+    Voice voice;
+    voice.buffer      = &buffer;
+    voice.stream      = NULL;
+    voice.volume      = volume;
+    voice.pitch       = pitch;
+    voice.pan         = pan;
+    voice.priority    = priority;
+    voice.loop        = loop;
+    voice.position    = 0.0;
+    voice.streamEnded = false;
+
+    return addVoice(voice);
+}
+
+
+////////////////////////////////////////////////////////////
+SoundMixer::VoiceId SoundMixer::playSound(const Sound& sound, float pan, int priority)
+{
+    const SoundBuffer* buffer = sound.getBuffer();
+    if (!buffer)
+    {
+        err() << "Failed to play voice: the sound has no buffer" << std::endl;
+        return InvalidVoice;
+    }
+
+    if ((buffer->getChannelCount() != 1) && (buffer->getChannelCount() != 2))
+    {
+        err() << "Failed to play voice: only mono and stereo sound buffers can be mixed" << std::endl;
+        return InvalidVoice;
+    }
+
+    Voice voice;
+    voice.buffer      = buffer;
+    voice.stream      = NULL;
+    voice.volume      = sound.getVolume();
+    voice.pitch       = sound.getPitch();
+    voice.pan         = pan;
+    voice.priority    = priority;
+    voice.loop        = sound.getLoop();
+    voice.position    = static_cast<double>(sound.getPlayingOffset().asSeconds()) * buffer->getSampleRate();
+    voice.streamEnded = false;
+
+    return addVoice(voice);
+}
+
+
+////////////////////////////////////////////////////////////
+SoundMixer::VoiceId SoundMixer::playStream(SoundStream& stream, float pan, int priority)
+{
+    if (&stream == this)
+    {
+        err() << "Failed to play voice: a mixer can't play itself" << std::endl;
+        return InvalidVoice;
+    }
+
+    if ((stream.getChannelCount() != 1) && (stream.getChannelCount() != 2))
+    {
+        err() << "Failed to play voice: only mono and stereo sound streams can be mixed" << std::endl;
+        return InvalidVoice;
+    }
+
+    Voice voice;
+    voice.buffer      = NULL;
+    voice.stream      = &stream;
+    voice.volume      = stream.getVolume();
+    voice.pitch       = stream.getPitch();
+    voice.pan         = pan;
+    voice.priority    = priority;
+    voice.loop        = stream.getLoop();
+    voice.position    = 0.0;
+    voice.streamEnded = false;
+
+    return addVoice(voice);
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundMixer::stopVoice(VoiceId voice)
+{
+    Lock lock(m_mutex);
+
+    for (std::vector<Voice>::iterator it = m_voices.begin(); it != m_voices.end(); ++it)
+    {
+        if (it->id == voice)
+        {
+            *it = m_voices.back();
+            m_voices.pop_back();
+            break;
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundMixer::stopAllVoices()
+{
+    Lock lock(m_mutex);
+
+    m_voices.clear();
+}
+
+
+////////////////////////////////////////////////////////////
+bool SoundMixer::isVoicePlaying(VoiceId voice) const
+{
+    Lock lock(m_mutex);
+
+    for (std::vector<Voice>::const_iterator it = m_voices.begin(); it != m_voices.end(); ++it)
+    {
+        if (it->id == voice)
+            return true;
+    }
+
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundMixer::setVoiceVolume(VoiceId voice, float volume)
+{
+    Lock lock(m_mutex);
+
+    if (Voice* found = findVoice(voice))
+        found->volume = std::min(std::max(volume, 0.f), 100.f);
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundMixer::setVoicePitch(VoiceId voice, float pitch)
+{
+    Lock lock(m_mutex);
+
+    if (Voice* found = findVoice(voice))
+        found->pitch = std::max(pitch, 0.f);
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundMixer::setVoicePan(VoiceId voice, float pan)
+{
+    Lock lock(m_mutex);
+
+    if (Voice* found = findVoice(voice))
+        found->pan = std::min(std::max(pan, -1.f), 1.f);
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t SoundMixer::getVoiceCount() const
+{
+    Lock lock(m_mutex);
+
+    return m_voices.size();
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 SoundMixer::getCulledVoiceCount() const
+{
+    Lock lock(m_mutex);
+
+    return m_culledCount;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundMixer::mix(Int16* samples, std::size_t frameCount)
+{
+    Lock lock(m_mutex);
+
+    // Start from silence
+    m_mixBuffer.resize(std::max(m_mixBuffer.size(), frameCount * 2));
+    std::fill(m_mixBuffer.begin(), m_mixBuffer.begin() + frameCount * 2, 0.f);
+
+    // Accumulate all the voices, and remove the ones that reached their end
+    for (std::size_t i = 0; i < m_voices.size();)
+    {
+        if (mixVoice(m_voices[i], frameCount))
+        {
+            ++i;
+        }
+        else
+        {
+            m_voices[i] = m_voices.back();
+            m_voices.pop_back();
+        }
+    }
+
+    // Convert the mix to 16-bit samples
+    if (frameCount > 0)
+        priv::convertToInt16(&m_mixBuffer[0], samples, frameCount * 2);
+}
+
+
+////////////////////////////////////////////////////////////
+bool SoundMixer::renderToFile(const std::string& filename, Time duration)
+{
+    if (getStatus() != Stopped)
+    {
+        err() << "Failed to render the mixer to \"" << filename << "\": the mixer must be stopped" << std::endl;
+        return false;
+    }
+
+    OutputSoundFile file;
+    if (!file.openFromFile(filename, getSampleRate(), 2))
+        return false;
+
+    // Mix and write the audio data chunk by chunk, as fast as possible
+    Uint64 frameCount = static_cast<Uint64>(static_cast<double>(duration.asMicroseconds()) * getSampleRate() / 1000000);
+    while (frameCount > 0)
+    {
+        std::size_t count = static_cast<std::size_t>(std::min<Uint64>(frameCount, m_samples.size() / 2));
+        mix(&m_samples[0], count);
+        file.write(&m_samples[0], count * 2);
+        frameCount -= count;
+    }
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool SoundMixer::renderToBuffer(SoundBuffer& buffer, Time duration)
+{
+    if (getStatus() != Stopped)
+    {
+        err() << "Failed to render the mixer to a sound buffer: the mixer must be stopped" << std::endl;
+        return false;
+    }
+
+    // Mix everything in one pass
+    std::size_t frameCount = static_cast<std::size_t>(static_cast<double>(duration.asMicroseconds()) * getSampleRate() / 1000000);
+    std::vector<Int16> samples(frameCount * 2);
+    if (frameCount > 0)
+        mix(&samples[0], frameCount);
+
+    return buffer.loadFromSamples(samples.empty() ? NULL : &samples[0], samples.size(), 2, getSampleRate());
+}
+
+
+////////////////////////////////////////////////////////////
+bool SoundMixer::onGetData(SoundStream::Chunk& data)
+{
+    // The mixer never ends: it plays silence when no voice is playing
+    mix(&m_samples[0], m_samples.size() / 2);
+
+    data.samples     = &m_samples[0];
+    data.sampleCount = m_samples.size();
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundMixer::onSeek(Time)
+{
+    // Nothing to do: the voices have their own position
+}
+
+
+////////////////////////////////////////////////////////////
+SoundMixer::VoiceId SoundMixer::addVoice(Voice& voice)
+{
+    voice.volume = std::min(std::max(voice.volume, 0.f), 100.f);
+    voice.pitch  = std::max(voice.pitch, 0.f);
+    voice.pan    = std::min(std::max(voice.pan, -1.f), 1.f);
+
+    Lock lock(m_mutex);
+
+    voice.id = m_nextId;
+
+    if (m_voices.size() < m_maxVoices)
+    {
+        m_voices.push_back(voice);
+    }
+    else
+    {
+        // All the voices are in use: find the least important one (lowest priority, then quietest)
+        std::vector<Voice>::iterator victim = m_voices.begin();
+        for (std::vector<Voice>::iterator it = m_voices.begin(); it != m_voices.end(); ++it)
+        {
+            if ((it->priority < victim->priority) || ((it->priority == victim->priority) && (it->volume < victim->volume)))
+                victim = it;
+        }
+
+        ++m_culledCount;
+
+        // Cull the new voice itself if it is less important than all the others
+        if ((voice.priority < victim->priority) || ((voice.priority == victim->priority) && (voice.volume < victim->volume)))
+            return InvalidVoice;
+
+        *victim = voice;
+    }
+
+    // Skip the invalid identifier when wrapping around
+    if (++m_nextId == InvalidVoice)
+        ++m_nextId;
+
+    return voice.id;
+}
+
+
+////////////////////////////////////////////////////////////
+SoundMixer::Voice* SoundMixer::findVoice(VoiceId voice)
+{
+    for (std::vector<Voice>::iterator it = m_voices.begin(); it != m_voices.end(); ++it)
+    {
+        if (it->id == voice)
+            return &*it;
+    }
+
+    return NULL;
+}
+
+
+////////////////////////////////////////////////////////////
+bool SoundMixer::mixVoice(Voice& voice, std::size_t frameCount)
+{
+    unsigned int channelCount = voice.stream ? voice.stream->getChannelCount() : voice.buffer->getChannelCount();
+    unsigned int sampleRate   = voice.stream ? voice.stream->getSampleRate()   : voice.buffer->getSampleRate();
+    double       step         = static_cast<double>(voice.pitch) * sampleRate / getSampleRate();
+
+    // A voice with a null pitch is frozen
+    if (step <= 0.0)
+        return true;
+
+    const Int16* samples      = NULL;
+    std::size_t  sourceFrames = 0;
+    bool         loop         = voice.loop;
+
+    if (voice.stream)
+    {
+        // Make sure that all the source frames needed by this mix are available, plus one for interpolation;
+        // the stream itself handles looping, so the voice never wraps around
+        fillStreamVoice(voice, static_cast<std::size_t>(voice.position + step * frameCount) + 2);
+        sourceFrames = voice.streamSamples.size() / channelCount;
+        samples      = sourceFrames > 0 ? &voice.streamSamples[0] : NULL;
+        loop         = false;
+
+        if (sourceFrames == 0)
+            return !voice.streamEnded;
+    }
+    else
+    {
+        sourceFrames = static_cast<std::size_t>(voice.buffer->getSampleCount() / channelCount);
+        samples      = voice.buffer->getSamples();
+
+        if (sourceFrames == 0)
+            return false;
+    }
+
+    std::size_t produced = 0;
+    if (voice.volume > 0.f)
+    {
+        // Resample the voice to the output rate and accumulate it into the mix
+        m_voiceBuffer.resize(std::max(m_voiceBuffer.size(), frameCount * channelCount));
+        produced = priv::resample(samples, channelCount, sourceFrames, voice.position, step, loop, &m_voiceBuffer[0], frameCount);
+        accumulate(voice, channelCount, produced);
+    }
+    else
+    {
+        // Inaudible voices are not mixed, but keep advancing
+        voice.position += step * frameCount;
+        if (loop && (voice.position >= sourceFrames))
+            voice.position = std::fmod(voice.position, static_cast<double>(sourceFrames));
+        produced = (voice.position < sourceFrames) ? frameCount : 0;
+    }
+
+    if (voice.stream)
+    {
+        // Drop the frames that won't be needed anymore
+        std::size_t consumed = std::min(static_cast<std::size_t>(voice.position), sourceFrames);
+        voice.streamSamples.erase(voice.streamSamples.begin(), voice.streamSamples.begin() + consumed * channelCount);
+        voice.position -= static_cast<double>(consumed);
+
+        if (!voice.streamEnded)
+            return true;
+    }
+
+    return produced == frameCount;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundMixer::fillStreamVoice(Voice& voice, std::size_t frameCount)
+{
+    SoundStream& stream       = *voice.stream;
+    std::size_t  channelCount = stream.getChannelCount();
+    std::size_t  sizeAtSeek   = voice.streamSamples.size();
+
+    while (!voice.streamEnded && (voice.streamSamples.size() < frameCount * channelCount))
+    {
+        // Acquire audio data
+        SoundStream::Chunk chunk = {NULL, 0};
+        bool hasMore = stream.onGetData(chunk);
+
+        if (chunk.samples && chunk.sampleCount)
+            voice.streamSamples.insert(voice.streamSamples.end(), chunk.samples, chunk.samples + chunk.sampleCount);
+
+        if (!hasMore)
+        {
+            // Return to the beginning of the stream source if it loops (and is not empty)
+            if (voice.loop && (voice.streamSamples.size() > sizeAtSeek))
+            {
+                stream.onSeek(Time::Zero);
+                sizeAtSeek = voice.streamSamples.size();
+            }
+            else
+            {
+                voice.streamEnded = true;
+            }
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundMixer::accumulate(const Voice& voice, unsigned int channelCount, std::size_t frameCount)
+{
+    // Compute the gains of each channel; a centered voice plays at full volume on both sides
+    float gain      = voice.volume * 0.01f;
+    float leftGain  = gain * std::min(1.f, 1.f - voice.pan);
+    float rightGain = gain * std::min(1.f, 1.f + voice.pan);
+
+    if (channelCount == 1)
+        priv::mixMono(&m_mixBuffer[0], &m_voiceBuffer[0], frameCount, leftGain, rightGain);
+    else
+        priv::mixStereo(&m_mixBuffer[0], &m_voiceBuffer[0], frameCount, leftGain, rightGain);
+}
+
+} // namespace sf
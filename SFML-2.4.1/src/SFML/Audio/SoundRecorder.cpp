@@ -29,7 +29,9 @@
 #include <SFML/Audio/AudioDevice.hpp>
 #include <SFML/Audio/ALCheck.hpp>
 #include <SFML/System/Sleep.hpp>
+#include <SFML/System/Lock.hpp>
 #include <SFML/System/Err.hpp>
+#include <algorithm>
 #include <cstring>
 #include <cassert>
 
@@ -48,11 +50,18 @@ namespace sf
 ////////////////////////////////////////////////////////////
 SoundRecorder::SoundRecorder() :
 m_thread            (&SoundRecorder::record, this),
+m_writeOffset       (0),
 m_sampleRate        (0),
 m_processingInterval(milliseconds(100)),
+m_lowLatency        (false),
+m_chunkDuration     (milliseconds(10)),
+m_chunkFrameCount   (0),
 m_isCapturing       (false),
 m_deviceName        (getDefaultDevice()),
-m_channelCount      (1)
+m_channelCount      (1),
+m_latency           (Time::Zero),
+m_maxLatency        (Time::Zero),
+m_overrunCount      (0)
 {
 
 }
@@ -98,12 +107,12 @@ bool SoundRecorder::start(unsigned int sampleRate)
         return false;
     }
 
-    // Clear the array of samples
-    m_samples.clear();
-
     // Store the sample rate
     m_sampleRate = sampleRate;
 
+    // Allocate the ring buffer and reset the statistics
+    initialize();
+
     // Notify derived class
     if (onStart())
     {
@@ -198,6 +207,9 @@ bool SoundRecorder::setDevice(const std::string& name)
             return false;
         }
 
+        // Restart with an empty ring buffer
+        initialize();
+
         // Start the capture
         alcCaptureStart(captureDevice);
 
@@ -243,6 +255,33 @@ unsigned int SoundRecorder::getChannelCount() const
 }
 
 
+////////////////////////////////////////////////////////////
+Time SoundRecorder::getCaptureLatency() const
+{
+    Lock lock(m_statisticsMutex);
+
+    return m_latency;
+}
+
+
+////////////////////////////////////////////////////////////
+Time SoundRecorder::getMaxCaptureLatency() const
+{
+    Lock lock(m_statisticsMutex);
+
+    return m_maxLatency;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int SoundRecorder::getOverrunCount() const
+{
+    Lock lock(m_statisticsMutex);
+
+    return m_overrunCount;
+}
+
+
 ////////////////////////////////////////////////////////////
 bool SoundRecorder::isAvailable()
 {
@@ -258,6 +297,26 @@ void SoundRecorder::setProcessingInterval(Time interval)
 }
 
 
+////////////////////////////////////////////////////////////
+void SoundRecorder::setLowLatencyMode(bool enabled, Time chunkDuration)
+{
+    if (m_isCapturing)
+    {
+        err() << "It's not possible to change the latency mode while recording." << std::endl;
+        return;
+    }
+
+    if (enabled && (chunkDuration <= Time::Zero))
+    {
+        err() << "Invalid chunk duration for the low-latency mode: " << chunkDuration.asMilliseconds() << " ms" << std::endl;
+        return;
+    }
+
+    m_lowLatency = enabled;
+    m_chunkDuration = chunkDuration;
+}
+
+
 ////////////////////////////////////////////////////////////
 bool SoundRecorder::onStart()
 {
@@ -279,10 +338,19 @@ void SoundRecorder::record()
     while (m_isCapturing)
     {
         // Process available samples
-        processCapturedSamples();
+        std::size_t pendingFrames = processCapturedSamples();
 
-        // Don't bother the CPU while waiting for more captured data
-        sleep(m_processingInterval);
+        if (m_chunkFrameCount > 0)
+        {
+            // Sleep until the capture device is expected to have recorded the next chunk
+            std::size_t missingFrames = (pendingFrames < m_chunkFrameCount) ? m_chunkFrameCount - pendingFrames : 0;
+            sleep(seconds(static_cast<float>(missingFrames) / m_sampleRate));
+        }
+        else
+        {
+            // Don't bother the CPU while waiting for more captured data
+            sleep(m_processingInterval);
+        }
     }
 
     // Capture is finished: clean up everything
@@ -291,25 +359,96 @@ void SoundRecorder::record()
 
 
 ////////////////////////////////////////////////////////////
-void SoundRecorder::processCapturedSamples()
+std::size_t SoundRecorder::processCapturedSamples(bool flush)
 {
     // Get the number of samples available
     ALCint samplesAvailable;
     alcGetIntegerv(captureDevice, ALC_CAPTURE_SAMPLES, 1, &samplesAvailable);
 
-    if (samplesAvailable > 0)
+    if (samplesAvailable <= 0)
+        return 0;
+
+    std::size_t availableFrames = static_cast<std::size_t>(samplesAvailable);
+
+    // The capture device holds one second of audio: if it is full, new samples are being dropped
+    if (availableFrames >= m_sampleRate)
     {
-        // Get the recorded samples
-        m_samples.resize(samplesAvailable * getChannelCount());
-        alcCaptureSamples(captureDevice, &m_samples[0], samplesAvailable);
+        Lock lock(m_statisticsMutex);
+        ++m_overrunCount;
+    }
 
-        // Forward them to the derived class
-        if (!onProcessSamples(&m_samples[0], m_samples.size()))
+    // In low-latency mode, only complete chunks are processed (unless we're flushing the device)
+    std::size_t channelCount = getChannelCount();
+    std::size_t frameCount = std::min(availableFrames, m_samples.size() / channelCount);
+    if ((m_chunkFrameCount > 0) && !flush)
+        frameCount -= frameCount % m_chunkFrameCount;
+
+    if (frameCount == 0)
+        return availableFrames;
+
+    // The oldest frame that we read has been waiting in the device for as long as it took to record all the available frames
+    {
+        Lock lock(m_statisticsMutex);
+        m_latency = seconds(static_cast<float>(availableFrames) / m_sampleRate);
+        m_maxLatency = std::max(m_maxLatency, m_latency);
+    }
+
+    // Get the recorded samples, in two parts if they wrap around the end of the ring buffer
+    std::size_t sampleCount = frameCount * channelCount;
+    std::size_t readOffset = m_writeOffset;
+    std::size_t firstPart = std::min(sampleCount, m_samples.size() - readOffset);
+    alcCaptureSamples(captureDevice, &m_samples[readOffset], static_cast<ALCsizei>(firstPart / channelCount));
+    if (firstPart < sampleCount)
+        alcCaptureSamples(captureDevice, &m_samples[0], static_cast<ALCsizei>((sampleCount - firstPart) / channelCount));
+    m_writeOffset = (readOffset + sampleCount) % m_samples.size();
+
+    // Forward them to the derived class, chunk by chunk in low-latency mode
+    std::size_t chunkSize = (m_chunkFrameCount > 0) ? m_chunkFrameCount * channelCount : sampleCount;
+    while (sampleCount > 0)
+    {
+        std::size_t count = std::min(std::min(chunkSize, sampleCount), m_samples.size() - readOffset);
+
+        if (!onProcessSamples(&m_samples[readOffset], count))
         {
             // The user wants to stop the capture
             m_isCapturing = false;
+            break;
         }
+
+        readOffset = (readOffset + count) % m_samples.size();
+        sampleCount -= count;
+    }
+
+    return availableFrames - frameCount;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundRecorder::initialize()
+{
+    // Compute the chunk size of the low-latency mode; a chunk can't exceed half the capacity of the capture device
+    m_chunkFrameCount = 0;
+    if (m_lowLatency)
+    {
+        m_chunkFrameCount = static_cast<std::size_t>(m_chunkDuration.asSeconds() * m_sampleRate);
+        m_chunkFrameCount = std::max<std::size_t>(std::min<std::size_t>(m_chunkFrameCount, m_sampleRate / 2), 1);
     }
+
+    // The ring buffer must be able to hold the whole content of the capture device (one second of audio),
+    // and in low-latency mode its size must be a multiple of the chunk size so that chunks are never split
+    std::size_t frameCapacity = m_sampleRate;
+    if (m_chunkFrameCount > 0)
+        frameCapacity = (frameCapacity + m_chunkFrameCount - 1) / m_chunkFrameCount * m_chunkFrameCount;
+
+    // Allocate it once, so that the capture loop never has to
+    m_samples.resize(frameCapacity * getChannelCount());
+    m_writeOffset = 0;
+
+    // Reset the statistics
+    Lock lock(m_statisticsMutex);
+    m_latency = Time::Zero;
+    m_maxLatency = Time::Zero;
+    m_overrunCount = 0;
 }
 
 
@@ -320,7 +459,7 @@ void SoundRecorder::cleanup()
     alcCaptureStop(captureDevice);
 
     // Get the samples left in the buffer
-    processCapturedSamples();
+    processCapturedSamples(true);
 
     // Close the device
     alcCaptureCloseDevice(captureDevice);
@@ -26,7 +26,63 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/CircleShape.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Mutex.hpp>
 #include <cmath>
+#include <map>
+#include <vector>
+
+
+namespace
+{
+    // Mutex protecting the tessellations; it is a function-local static, so that
+    // circles constructed during static initialization never find it unconstructed
+    sf::Mutex& getUnitCirclesMutex()
+    {
+        static sf::Mutex mutex;
+        return mutex;
+    }
+
+    // Construct the mutex during static initialization, which is single-threaded,
+    // so that the first circles of concurrent threads don't race to construct it
+    struct UnitCirclesMutexInitializer
+    {
+        UnitCirclesMutexInitializer()
+        {
+            getUnitCirclesMutex();
+        }
+    };
+    UnitCirclesMutexInitializer unitCirclesMutexInitializer;
+
+    // Get the points of the unit circle with the given number of points
+    const sf::Vector2f* getUnitCircle(std::size_t pointCount)
+    {
+        static const float pi = 3.141592654f;
+
+        if (pointCount == 0)
+            return NULL;
+
+        sf::Lock lock(getUnitCirclesMutex());
+
+        // Tessellations of the unit circle, shared by all the circles
+        // with the same number of points; they are never released, so
+        // that the circles can keep a pointer to them
+        static std::map<std::size_t, std::vector<sf::Vector2f> > unitCircles;
+
+        std::vector<sf::Vector2f>& points = unitCircles[pointCount];
+        if (points.empty())
+        {
+            points.resize(pointCount);
+            for (std::size_t i = 0; i < pointCount; ++i)
+            {
+                float angle = i * 2 * pi / pointCount - pi / 2;
+                points[i] = sf::Vector2f(std::cos(angle), std::sin(angle));
+            }
+        }
+
+        return &points[0];
+    }
+}
 
 
 namespace sf
@@ -34,7 +90,8 @@ namespace sf
 ////////////////////////////////////////////////////////////
 CircleShape::CircleShape(float radius, std::size_t pointCount) :
 m_radius    (radius),
-m_pointCount(pointCount)
+m_pointCount(pointCount),
+m_unitCircle(getUnitCircle(pointCount))
 {
     update();
 }
@@ -59,6 +116,7 @@ float CircleShape::getRadius() const
 void CircleShape::setPointCount(std::size_t count)
 {
     m_pointCount = count;
+    m_unitCircle = getUnitCircle(count);
     update();
 }
 
@@ -72,11 +130,13 @@ std::size_t CircleShape::getPointCount() const
 ////////////////////////////////////////////////////////////
 Vector2f CircleShape::getPoint(std::size_t index) const
 {
-    static const float pi = 3.141592654f;
+    if (!m_unitCircle)
+        return Vector2f(m_radius, m_radius);
 
-    float angle = index * 2 * pi / m_pointCount - pi / 2;
-    float x = std::cos(angle) * m_radius;
-    float y = std::sin(angle) * m_radius;
+    // Indices beyond the last point wrap around the circle
+    const Vector2f& point = m_unitCircle[index % m_pointCount];
+    float x = point.x * m_radius;
+    float y = point.y * m_radius;
 
     return Vector2f(m_radius + x, m_radius + y);
 }
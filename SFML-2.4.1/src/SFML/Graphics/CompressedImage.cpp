@@ -0,0 +1,903 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2016 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/CompressedImage.hpp>
+#include <SFML/System/InputStream.hpp>
+#include <SFML/System/Err.hpp>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+
+namespace
+{
+    ////////////////////////////////////////////////////////////
+    // Read integers from a byte array
+    ////////////////////////////////////////////////////////////
+    sf::Uint32 readLittleEndian(const sf::Uint8* bytes)
+    {
+        return bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) | (static_cast<sf::Uint32>(bytes[3]) << 24);
+    }
+
+    sf::Uint32 readBigEndian(const sf::Uint8* bytes)
+    {
+        return (static_cast<sf::Uint32>(bytes[0]) << 24) | (bytes[1] << 16) | (bytes[2] << 8) | bytes[3];
+    }
+
+    sf::Uint8 clamp(int value)
+    {
+        return static_cast<sf::Uint8>(value < 0 ? 0 : (value > 255 ? 255 : value));
+    }
+
+
+    ////////////////////////////////////////////////////////////
+    // Fill the block properties of a format, returns false if unknown
+    ////////////////////////////////////////////////////////////
+    bool setFormat(sf::priv::CompressedImage& image, unsigned int format)
+    {
+        using namespace sf::priv;
+
+        // Bring sRGB formats back to their linear variant
+        image.sRgb = true;
+        switch (format)
+        {
+            case 0x8C4C: format = CompressedRgbDxt1;   break;
+            case 0x8C4D: format = CompressedRgbaDxt1;  break;
+            case 0x8C4E: format = CompressedRgbaDxt3;  break;
+            case 0x8C4F: format = CompressedRgbaDxt5;  break;
+            case 0x9275: format = CompressedRgbEtc2;   break;
+            case 0x9277: format = CompressedRgbA1Etc2; break;
+            case 0x9279: format = CompressedRgbaEtc2;  break;
+            case 0x8C43: format = UncompressedRgba8;   break;
+            default:
+                if ((format >= 0x93D0) && (format <= 0x93DD))
+                    format -= 0x20;
+                else
+                    image.sRgb = false;
+                break;
+        }
+
+        image.format = format;
+        image.blockSize = sf::Vector2u(4, 4);
+        switch (format)
+        {
+            case UncompressedRgba8:
+                image.blockSize = sf::Vector2u(1, 1);
+                image.blockBytes = 4;
+                return true;
+
+            case CompressedRgbDxt1:
+            case CompressedRgbaDxt1:
+            case CompressedRgbEtc1:
+            case CompressedRgbEtc2:
+            case CompressedRgbA1Etc2:
+                image.blockBytes = 8;
+                return true;
+
+            case CompressedRgbaDxt3:
+            case CompressedRgbaDxt5:
+            case CompressedRgbaEtc2:
+                image.blockBytes = 16;
+                return true;
+
+            default:
+                break;
+        }
+
+        if ((format >= CompressedRgbaAstc4x4) && (format <= CompressedRgbaAstc12x12))
+        {
+            static const unsigned int astcBlocks[][2] =
+            {
+                {4, 4}, {5, 4}, {5, 5}, {6, 5}, {6, 6}, {8, 5}, {8, 6},
+                {8, 8}, {10, 5}, {10, 6}, {10, 8}, {10, 10}, {12, 10}, {12, 12}
+            };
+
+            const unsigned int* block = astcBlocks[format - CompressedRgbaAstc4x4];
+            image.blockSize = sf::Vector2u(block[0], block[1]);
+            image.blockBytes = 16;
+            return true;
+        }
+
+        return false;
+    }
+
+
+    ////////////////////////////////////////////////////////////
+    // Get the number of bytes of a mipmap level; sizes that
+    // don't fit in 64 bits are clamped (the file can't hold them anyway)
+    ////////////////////////////////////////////////////////////
+    sf::Uint64 getLevelSize(const sf::priv::CompressedImage& image, std::size_t level)
+    {
+        unsigned int width   = std::max(image.size.x >> level, 1u);
+        unsigned int height  = std::max(image.size.y >> level, 1u);
+        sf::Uint64   blocksX = (static_cast<sf::Uint64>(width) + image.blockSize.x - 1) / image.blockSize.x;
+        sf::Uint64   blocksY = (static_cast<sf::Uint64>(height) + image.blockSize.y - 1) / image.blockSize.y;
+        sf::Uint64   blocks  = blocksX * blocksY;
+
+        const sf::Uint64 maxSize = static_cast<sf::Uint64>(-1);
+        return (blocks > maxSize / image.blockBytes) ? maxSize : blocks * image.blockBytes;
+    }
+
+
+    ////////////////////////////////////////////////////////////
+    // Get the number of levels of a complete mipmap chain,
+    // which is the maximum that a file can declare
+    ////////////////////////////////////////////////////////////
+    sf::Uint32 getMaxLevelCount(const sf::Vector2u& size)
+    {
+        sf::Uint32 count = 1;
+        for (unsigned int largest = std::max(size.x, size.y); largest > 1; largest >>= 1)
+            ++count;
+
+        return count;
+    }
+
+
+    ////////////////////////////////////////////////////////////
+    // Parse a KTX (version 1) file
+    ////////////////////////////////////////////////////////////
+    bool loadKtx(const std::vector<sf::Uint8>& file, sf::priv::CompressedImage& image)
+    {
+        const std::size_t headerSize = 64;
+        if (file.size() < headerSize)
+            return false;
+
+        // The endianness field tells in which byte order the file was written
+        const sf::Uint8* header = &file[12];
+        bool bigEndian = (readLittleEndian(header) != 0x04030201);
+        sf::Uint32 fields[13];
+        for (int i = 0; i < 13; ++i)
+            fields[i] = bigEndian ? readBigEndian(header + i * 4) : readLittleEndian(header + i * 4);
+
+        sf::Uint32 glType           = fields[1];
+        sf::Uint32 glFormat         = fields[3];
+        sf::Uint32 glInternalFormat = fields[4];
+        sf::Uint32 width            = fields[6];
+        sf::Uint32 height           = fields[7];
+        sf::Uint32 depth            = fields[8];
+        sf::Uint32 arrayElements    = fields[9];
+        sf::Uint32 faces            = fields[10];
+        sf::Uint32 levels           = std::max<sf::Uint32>(fields[11], 1);
+        sf::Uint32 keyValueBytes    = fields[12];
+
+        // Uncompressed data is only accepted as RGBA with 8-bit components
+        bool rgba8 = (glInternalFormat == 0x8058) || (glInternalFormat == 0x8C43);
+        if (((glType != 0) || (glFormat != 0)) && (!rgba8 || (glType != 0x1401) || (glFormat != 0x1908)))
+        {
+            sf::err() << "Failed to load KTX file (only compressed formats and RGBA8 are supported)" << std::endl;
+            return false;
+        }
+
+        if ((width == 0) || (height == 0) || (depth > 1) || (arrayElements > 0) || (faces != 1))
+        {
+            sf::err() << "Failed to load KTX file (only 2D textures are supported)" << std::endl;
+            return false;
+        }
+
+        if (!setFormat(image, glInternalFormat))
+        {
+            sf::err() << "Failed to load KTX file (unsupported format 0x" << std::hex << glInternalFormat << std::dec << ")" << std::endl;
+            return false;
+        }
+
+        image.size = sf::Vector2u(width, height);
+
+        if (levels > getMaxLevelCount(image.size))
+        {
+            sf::err() << "Failed to load KTX file (invalid number of mipmap levels: " << levels << ")" << std::endl;
+            return false;
+        }
+
+        // Check that all the levels are in the file before allocating them;
+        // each one is preceded by its size and padded to 4 bytes
+        std::vector<std::size_t> offsets(levels);
+        sf::Uint64 offset = static_cast<sf::Uint64>(headerSize) + keyValueBytes;
+        for (sf::Uint32 i = 0; i < levels; ++i)
+        {
+            if (offset + 4 > file.size())
+            {
+                sf::err() << "Failed to load KTX file (level " << i << " is truncated)" << std::endl;
+                return false;
+            }
+
+            std::size_t position = static_cast<std::size_t>(offset);
+            sf::Uint64 size = bigEndian ? readBigEndian(&file[position]) : readLittleEndian(&file[position]);
+            offset += 4;
+
+            if ((size < getLevelSize(image, i)) || (size > file.size() - offset))
+            {
+                sf::err() << "Failed to load KTX file (level " << i << " is truncated)" << std::endl;
+                return false;
+            }
+
+            offsets[i] = static_cast<std::size_t>(offset);
+            offset += (size + 3) & ~static_cast<sf::Uint64>(3);
+        }
+
+        image.levels.resize(levels);
+        for (sf::Uint32 i = 0; i < levels; ++i)
+            image.levels[i].assign(file.begin() + offsets[i], file.begin() + offsets[i] + static_cast<std::size_t>(getLevelSize(image, i)));
+
+        return true;
+    }
+
+
+    ////////////////////////////////////////////////////////////
+    // Parse a DDS file (with or without the DX10 header extension)
+    ////////////////////////////////////////////////////////////
+    bool loadDds(const std::vector<sf::Uint8>& file, sf::priv::CompressedImage& image)
+    {
+        using namespace sf::priv;
+
+        std::size_t offset = 128;
+        if ((file.size() < offset) || (readLittleEndian(&file[4]) != 124))
+            return false;
+
+        sf::Uint32 flags       = readLittleEndian(&file[8]);
+        sf::Uint32 height      = readLittleEndian(&file[12]);
+        sf::Uint32 width       = readLittleEndian(&file[16]);
+        sf::Uint32 levels      = (flags & 0x20000) ? std::max<sf::Uint32>(readLittleEndian(&file[28]), 1) : 1;
+        sf::Uint32 formatFlags = readLittleEndian(&file[80]);
+        sf::Uint32 fourCC      = readLittleEndian(&file[84]);
+        sf::Uint32 caps2       = readLittleEndian(&file[112]);
+
+        if ((width == 0) || (height == 0) || (caps2 & 0x200) || (caps2 & 0x200000))
+        {
+            sf::err() << "Failed to load DDS file (only 2D textures are supported)" << std::endl;
+            return false;
+        }
+
+        unsigned int format = 0;
+        if (formatFlags & 0x4)
+        {
+            switch (fourCC)
+            {
+                case 0x31545844: format = CompressedRgbaDxt1; break; // "DXT1"
+                case 0x33545844: format = CompressedRgbaDxt3; break; // "DXT3"
+                case 0x35545844: format = CompressedRgbaDxt5; break; // "DXT5"
+
+                case 0x30315844: // "DX10"
+                {
+                    offset += 20;
+                    if (file.size() < offset)
+                        return false;
+
+                    if ((readLittleEndian(&file[132]) != 3) || (readLittleEndian(&file[140]) > 1) || (readLittleEndian(&file[136]) & 0x4))
+                    {
+                        sf::err() << "Failed to load DDS file (only 2D textures are supported)" << std::endl;
+                        return false;
+                    }
+
+                    switch (readLittleEndian(&file[128]))
+                    {
+                        case 71: format = CompressedRgbaDxt1; break;
+                        case 72: format = 0x8C4D;             break;
+                        case 74: format = CompressedRgbaDxt3; break;
+                        case 75: format = 0x8C4E;             break;
+                        case 77: format = CompressedRgbaDxt5; break;
+                        case 78: format = 0x8C4F;             break;
+                        default:                              break;
+                    }
+                    break;
+                }
+
+                default:
+                    break;
+            }
+        }
+
+        if ((format == 0) || !setFormat(image, format))
+        {
+            sf::err() << "Failed to load DDS file (only DXT1, DXT3 and DXT5 formats are supported)" << std::endl;
+            return false;
+        }
+
+        image.size = sf::Vector2u(width, height);
+
+        if (levels > getMaxLevelCount(image.size))
+        {
+            sf::err() << "Failed to load DDS file (invalid number of mipmap levels: " << levels << ")" << std::endl;
+            return false;
+        }
+
+        // Levels are stored one after the other, without any header;
+        // check that they are all in the file before allocating them
+        sf::Uint64 end = offset;
+        for (sf::Uint32 i = 0; i < levels; ++i)
+        {
+            sf::Uint64 size = getLevelSize(image, i);
+            if (size > file.size() - end)
+            {
+                sf::err() << "Failed to load DDS file (level " << i << " is truncated)" << std::endl;
+                return false;
+            }
+
+            end += size;
+        }
+
+        image.levels.resize(levels);
+        for (sf::Uint32 i = 0; i < levels; ++i)
+        {
+            std::size_t size = static_cast<std::size_t>(getLevelSize(image, i));
+            image.levels[i].assign(file.begin() + offset, file.begin() + offset + size);
+            offset += size;
+        }
+
+        return true;
+    }
+
+
+    ////////////////////////////////////////////////////////////
+    // Decode an S3TC color block (BC1, or color part of BC2/BC3)
+    // Output is 16 RGBA texels, row by row
+    // BC1 blocks switch to 3 colors + black when color0 <= color1,
+    // the black being transparent in the RGBA variant; the color
+    // blocks of BC2/BC3 always use 4 colors
+    ////////////////////////////////////////////////////////////
+    void decodeDxtColor(const sf::Uint8* block, sf::Uint8* texels, bool allowThreeColors, bool transparentBlack)
+    {
+        sf::Uint32 color0 = block[0] | (block[1] << 8);
+        sf::Uint32 color1 = block[2] | (block[3] << 8);
+        sf::Uint32 indices = readLittleEndian(block + 4);
+
+        sf::Uint8 palette[4][4];
+        for (int i = 0; i < 2; ++i)
+        {
+            sf::Uint32 color = (i == 0) ? color0 : color1;
+            sf::Uint32 r = (color >> 11) & 31;
+            sf::Uint32 g = (color >> 5) & 63;
+            sf::Uint32 b = color & 31;
+            palette[i][0] = static_cast<sf::Uint8>((r << 3) | (r >> 2));
+            palette[i][1] = static_cast<sf::Uint8>((g << 2) | (g >> 4));
+            palette[i][2] = static_cast<sf::Uint8>((b << 3) | (b >> 2));
+            palette[i][3] = 255;
+        }
+
+        bool threeColors = allowThreeColors && (color0 <= color1);
+        for (int c = 0; c < 3; ++c)
+        {
+            if (!threeColors)
+            {
+                palette[2][c] = static_cast<sf::Uint8>((2 * palette[0][c] + palette[1][c]) / 3);
+                palette[3][c] = static_cast<sf::Uint8>((palette[0][c] + 2 * palette[1][c]) / 3);
+            }
+            else
+            {
+                palette[2][c] = static_cast<sf::Uint8>((palette[0][c] + palette[1][c]) / 2);
+                palette[3][c] = 0;
+            }
+        }
+        palette[2][3] = 255;
+        palette[3][3] = (threeColors && transparentBlack) ? 0 : 255;
+
+        for (int i = 0; i < 16; ++i)
+            std::memcpy(texels + i * 4, palette[(indices >> (i * 2)) & 3], 4);
+    }
+
+
+    ////////////////////////////////////////////////////////////
+    // Decode the explicit alpha of a BC2 block
+    ////////////////////////////////////////////////////////////
+    void decodeDxt3Alpha(const sf::Uint8* block, sf::Uint8* texels)
+    {
+        for (int i = 0; i < 16; ++i)
+        {
+            sf::Uint8 alpha = (block[i / 2] >> ((i % 2) * 4)) & 15;
+            texels[i * 4 + 3] = static_cast<sf::Uint8>(alpha * 17);
+        }
+    }
+
+
+    ////////////////////////////////////////////////////////////
+    // Decode the interpolated alpha of a BC3 block
+    ////////////////////////////////////////////////////////////
+    void decodeDxt5Alpha(const sf::Uint8* block, sf::Uint8* texels)
+    {
+        int alpha0 = block[0];
+        int alpha1 = block[1];
+
+        sf::Uint8 palette[8];
+        palette[0] = static_cast<sf::Uint8>(alpha0);
+        palette[1] = static_cast<sf::Uint8>(alpha1);
+        if (alpha0 > alpha1)
+        {
+            for (int i = 1; i < 7; ++i)
+                palette[i + 1] = static_cast<sf::Uint8>(((7 - i) * alpha0 + i * alpha1) / 7);
+        }
+        else
+        {
+            for (int i = 1; i < 5; ++i)
+                palette[i + 1] = static_cast<sf::Uint8>(((5 - i) * alpha0 + i * alpha1) / 5);
+            palette[6] = 0;
+            palette[7] = 255;
+        }
+
+        // 16 indices of 3 bits, little endian
+        sf::Uint64 indices = 0;
+        for (int i = 0; i < 6; ++i)
+            indices |= static_cast<sf::Uint64>(block[2 + i]) << (i * 8);
+
+        for (int i = 0; i < 16; ++i)
+            texels[i * 4 + 3] = palette[(indices >> (i * 3)) & 7];
+    }
+
+
+    ////////////////////////////////////////////////////////////
+    // Decode an ETC1 / ETC2 color block
+    ////////////////////////////////////////////////////////////
+    enum EtcVariant
+    {
+        Etc1,
+        Etc2,
+        Etc2PunchThrough
+    };
+
+    void setEtcTexel(sf::Uint8* texels, int x, int y, int r, int g, int b)
+    {
+        sf::Uint8* texel = texels + (y * 4 + x) * 4;
+        texel[0] = clamp(r);
+        texel[1] = clamp(g);
+        texel[2] = clamp(b);
+        texel[3] = 255;
+    }
+
+    void decodeEtc(const sf::Uint8* block, sf::Uint8* texels, EtcVariant variant)
+    {
+        static const int modifiers[8][2] =
+        {
+            {2, 8}, {5, 17}, {9, 29}, {13, 42}, {18, 60}, {24, 80}, {33, 106}, {47, 183}
+        };
+        static const int distances[8] = {3, 6, 11, 16, 23, 32, 41, 64};
+
+        sf::Uint32 high = readBigEndian(block);
+        sf::Uint32 low  = readBigEndian(block + 4);
+
+        // In the punch-through variant the "diff" bit tells whether the block is opaque,
+        // and the differential mode is always used
+        bool differential = (high & 2) != 0;
+        bool opaque       = true;
+        if (variant == Etc2PunchThrough)
+        {
+            opaque = differential;
+            differential = true;
+        }
+
+        // Pixel indices are stored column by column, most significant bits first
+        int indices[4][4];
+        for (int x = 0; x < 4; ++x)
+        {
+            for (int y = 0; y < 4; ++y)
+            {
+                int j = x * 4 + y;
+                indices[x][y] = static_cast<int>((((low >> (j + 16)) & 1) << 1) | ((low >> j) & 1));
+            }
+        }
+
+        int base[2][3];
+        if (!differential)
+        {
+            // Individual mode: two 4-bit colors
+            for (int c = 0; c < 3; ++c)
+            {
+                base[0][c] = ((high >> (28 - c * 8)) & 15) * 17;
+                base[1][c] = ((high >> (24 - c * 8)) & 15) * 17;
+            }
+        }
+        else
+        {
+            // Differential mode: a 5-bit color and a 3-bit signed offset
+            int value[3];
+            int delta[3];
+            for (int c = 0; c < 3; ++c)
+            {
+                value[c] = (high >> (27 - c * 8)) & 31;
+                delta[c] = (high >> (24 - c * 8)) & 7;
+                if (delta[c] >= 4)
+                    delta[c] -= 8;
+            }
+
+            // ETC2 uses the overflows to encode its additional modes
+            if (variant != Etc1)
+            {
+                if ((value[0] + delta[0] < 0) || (value[0] + delta[0] > 31))
+                {
+                    // T mode
+                    int color1[3] = {static_cast<int>((((high >> 27) & 3) << 2) | ((high >> 24) & 3)), static_cast<int>((high >> 20) & 15), static_cast<int>((high >> 16) & 15)};
+                    int color2[3] = {static_cast<int>((high >> 12) & 15), static_cast<int>((high >> 8) & 15), static_cast<int>((high >> 4) & 15)};
+                    int distance = distances[(((high >> 2) & 3) << 1) | (high & 1)];
+
+                    int paint[4][3];
+                    for (int c = 0; c < 3; ++c)
+                    {
+                        paint[0][c] = color1[c] * 17;
+                        paint[1][c] = color2[c] * 17 + distance;
+                        paint[2][c] = color2[c] * 17;
+                        paint[3][c] = color2[c] * 17 - distance;
+                    }
+
+                    for (int y = 0; y < 4; ++y)
+                    {
+                        for (int x = 0; x < 4; ++x)
+                        {
+                            const int* color = paint[indices[x][y]];
+                            setEtcTexel(texels, x, y, color[0], color[1], color[2]);
+                            if (!opaque && (indices[x][y] == 2))
+                                std::memset(texels + (y * 4 + x) * 4, 0, 4);
+                        }
+                    }
+                    return;
+                }
+                else if ((value[1] + delta[1] < 0) || (value[1] + delta[1] > 31))
+                {
+                    // H mode
+                    int color1[3] = {static_cast<int>((high >> 27) & 15),
+                                     static_cast<int>((((high >> 24) & 7) << 1) | ((high >> 20) & 1)),
+                                     static_cast<int>((((high >> 19) & 1) << 3) | ((high >> 15) & 7))};
+                    int color2[3] = {static_cast<int>((high >> 11) & 15), static_cast<int>((high >> 7) & 15), static_cast<int>((high >> 3) & 15)};
+                    int order = ((color1[0] << 8) | (color1[1] << 4) | color1[2]) >= ((color2[0] << 8) | (color2[1] << 4) | color2[2]) ? 1 : 0;
+                    int distance = distances[(((high >> 2) & 1) << 2) | ((high & 1) << 1) | order];
+
+                    int paint[4][3];
+                    for (int c = 0; c < 3; ++c)
+                    {
+                        paint[0][c] = color1[c] * 17 + distance;
+                        paint[1][c] = color1[c] * 17 - distance;
+                        paint[2][c] = color2[c] * 17 + distance;
+                        paint[3][c] = color2[c] * 17 - distance;
+                    }
+
+                    for (int y = 0; y < 4; ++y)
+                    {
+                        for (int x = 0; x < 4; ++x)
+                        {
+                            const int* color = paint[indices[x][y]];
+                            setEtcTexel(texels, x, y, color[0], color[1], color[2]);
+                            if (!opaque && (indices[x][y] == 2))
+                                std::memset(texels + (y * 4 + x) * 4, 0, 4);
+                        }
+                    }
+                    return;
+                }
+                else if ((value[2] + delta[2] < 0) || (value[2] + delta[2] > 31))
+                {
+                    // Planar mode: three colors at the corners, interpolated over the block
+                    int origin[3]     = {static_cast<int>((high >> 25) & 63),
+                                         static_cast<int>((((high >> 24) & 1) << 6) | ((high >> 17) & 63)),
+                                         static_cast<int>((((high >> 16) & 1) << 5) | (((high >> 11) & 3) << 3) | ((high >> 7) & 7))};
+                    int horizontal[3] = {static_cast<int>((((high >> 2) & 31) << 1) | (high & 1)),
+                                         static_cast<int>((low >> 25) & 127),
+                                         static_cast<int>((low >> 19) & 63)};
+                    int vertical[3]   = {static_cast<int>((low >> 13) & 63),
+                                         static_cast<int>((low >> 6) & 127),
+                                         static_cast<int>(low & 63)};
+
+                    // Red and blue have 6 bits, green has 7
+                    for (int c = 0; c < 3; ++c)
+                    {
+                        if (c == 1)
+                        {
+                            origin[c]     = (origin[c] << 1) | (origin[c] >> 6);
+                            horizontal[c] = (horizontal[c] << 1) | (horizontal[c] >> 6);
+                            vertical[c]   = (vertical[c] << 1) | (vertical[c] >> 6);
+                        }
+                        else
+                        {
+                            origin[c]     = (origin[c] << 2) | (origin[c] >> 4);
+                            horizontal[c] = (horizontal[c] << 2) | (horizontal[c] >> 4);
+                            vertical[c]   = (vertical[c] << 2) | (vertical[c] >> 4);
+                        }
+                    }
+
+                    for (int y = 0; y < 4; ++y)
+                    {
+                        for (int x = 0; x < 4; ++x)
+                        {
+                            int color[3];
+                            for (int c = 0; c < 3; ++c)
+                                color[c] = (x * (horizontal[c] - origin[c]) + y * (vertical[c] - origin[c]) + 4 * origin[c] + 2) >> 2;
+                            setEtcTexel(texels, x, y, color[0], color[1], color[2]);
+                        }
+                    }
+                    return;
+                }
+            }
+
+            for (int c = 0; c < 3; ++c)
+            {
+                int second = value[c] + delta[c];
+                base[0][c] = (value[c] << 3) | (value[c] >> 2);
+                base[1][c] = (second << 3) | (second >> 2);
+            }
+        }
+
+        // Two sub-blocks of 2x4 (or 4x2 if flipped), each with its own base color and modifier table
+        bool flipped = (high & 1) != 0;
+        int  tables[2] = {static_cast<int>((high >> 5) & 7), static_cast<int>((high >> 2) & 7)};
+        for (int y = 0; y < 4; ++y)
+        {
+            for (int x = 0; x < 4; ++x)
+            {
+                int subBlock = flipped ? (y >= 2) : (x >= 2);
+                int index    = indices[x][y];
+
+                // Index values 0 to 3 map to +small, +large, -small, -large
+                int modifier = modifiers[tables[subBlock]][index & 1];
+                if (index & 2)
+                    modifier = -modifier;
+
+                if (!opaque)
+                {
+                    // Non-opaque punch-through blocks: index 2 is transparent, index 0 has no modifier
+                    if (index == 2)
+                    {
+                        std::memset(texels + (y * 4 + x) * 4, 0, 4);
+                        continue;
+                    }
+                    else if (index == 0)
+                    {
+                        modifier = 0;
+                    }
+                }
+
+                const int* color = base[subBlock];
+                setEtcTexel(texels, x, y, color[0] + modifier, color[1] + modifier, color[2] + modifier);
+            }
+        }
+    }
+
+
+    ////////////////////////////////////////////////////////////
+    // Decode an EAC alpha block (alpha part of ETC2 RGBA8)
+    ////////////////////////////////////////////////////////////
+    void decodeEacAlpha(const sf::Uint8* block, sf::Uint8* texels)
+    {
+        static const int modifiers[16][8] =
+        {
+            {-3, -6,  -9, -15, 2, 5, 8, 14},
+            {-3, -7, -10, -13, 2, 6, 9, 12},
+            {-2, -5,  -8, -13, 1, 4, 7, 12},
+            {-2, -4,  -6, -13, 1, 3, 5, 12},
+            {-3, -6,  -8, -12, 2, 5, 7, 11},
+            {-3, -7,  -9, -11, 2, 6, 8, 10},
+            {-4, -7,  -8, -11, 3, 6, 7, 10},
+            {-3, -5,  -8, -11, 2, 4, 7, 10},
+            {-2, -6,  -8, -10, 1, 5, 7,  9},
+            {-2, -5,  -8, -10, 1, 4, 7,  9},
+            {-2, -4,  -8, -10, 1, 3, 7,  9},
+            {-2, -5,  -7, -10, 1, 4, 6,  9},
+            {-3, -4,  -7, -10, 2, 3, 6,  9},
+            {-1, -2,  -3, -10, 0, 1, 2,  9},
+            {-4, -6,  -8,  -9, 3, 5, 7,  8},
+            {-3, -5,  -7,  -9, 2, 4, 6,  8}
+        };
+
+        int base       = block[0];
+        int multiplier = block[1] >> 4;
+        const int* table = modifiers[block[1] & 15];
+
+        // 16 indices of 3 bits, big endian, column by column
+        sf::Uint64 indices = 0;
+        for (int i = 0; i < 6; ++i)
+            indices = (indices << 8) | block[2 + i];
+
+        for (int j = 0; j < 16; ++j)
+        {
+            int x = j / 4;
+            int y = j % 4;
+            int index = static_cast<int>((indices >> (45 - j * 3)) & 7);
+            texels[(y * 4 + x) * 4 + 3] = clamp(base + table[index] * multiplier);
+        }
+    }
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+bool loadCompressedImage(InputStream& stream, CompressedImage& image)
+{
+    // Read the whole file, the containers are simple enough to be parsed from memory
+    Int64 size = stream.getSize();
+    if ((size <= 0) || (stream.seek(0) != 0))
+    {
+        err() << "Failed to load compressed image (cannot read stream)" << std::endl;
+        return false;
+    }
+
+    std::vector<Uint8> file(static_cast<std::size_t>(size));
+    if (stream.read(&file[0], size) != size)
+    {
+        err() << "Failed to load compressed image (cannot read stream)" << std::endl;
+        return false;
+    }
+
+    image.levels.clear();
+
+    static const Uint8 ktxIdentifier[12] = {0xAB, 'K', 'T', 'X', ' ', '1', '1', 0xBB, '\r', '\n', 0x1A, '\n'};
+    if ((file.size() >= 12) && (std::memcmp(&file[0], ktxIdentifier, 12) == 0))
+        return loadKtx(file, image);
+    else if ((file.size() >= 4) && (std::memcmp(&file[0], "DDS ", 4) == 0))
+        return loadDds(file, image);
+
+    err() << "Failed to load compressed image (not a KTX or DDS file)" << std::endl;
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+bool saveCompressedImage(const std::string& filename, const CompressedImage& image)
+{
+    bool uncompressed = (image.format == UncompressedRgba8);
+    unsigned int internalFormat = image.sRgb ? getSrgbFormat(image.format) : image.format;
+
+    bool opaque = (image.format == CompressedRgbDxt1) || (image.format == CompressedRgbEtc1) || (image.format == CompressedRgbEtc2);
+
+    // The rows are stored top to bottom, which must be told to readers with the orientation key
+    static const char orientation[] = "KTXorientation\0S=r,T=d";
+    Uint32 keyValueSize = sizeof(orientation);
+    Uint32 keyValueBytes = (4 + keyValueSize + 3) & ~3u;
+
+    Uint32 fields[16] =
+    {
+        0x04030201,                      // endianness
+        uncompressed ? 0x1401u : 0u,     // glType (GL_UNSIGNED_BYTE)
+        1,                               // glTypeSize
+        uncompressed ? 0x1908u : 0u,     // glFormat (GL_RGBA)
+        internalFormat,                  // glInternalFormat
+        opaque ? 0x1907u : 0x1908u,      // glBaseInternalFormat (GL_RGB or GL_RGBA)
+        image.size.x,                    // pixelWidth
+        image.size.y,                    // pixelHeight
+        0,                               // pixelDepth
+        0,                               // numberOfArrayElements
+        1,                               // numberOfFaces
+        static_cast<Uint32>(image.levels.size()),
+        keyValueBytes
+    };
+
+    std::vector<Uint8> file;
+    static const Uint8 ktxIdentifier[12] = {0xAB, 'K', 'T', 'X', ' ', '1', '1', 0xBB, '\r', '\n', 0x1A, '\n'};
+    file.insert(file.end(), ktxIdentifier, ktxIdentifier + 12);
+
+    // KTX files are written in the byte order of the machine, readers swap them if needed
+    Uint8 bytes[4];
+    for (int i = 0; i < 13; ++i)
+    {
+        std::memcpy(bytes, &fields[i], 4);
+        file.insert(file.end(), bytes, bytes + 4);
+    }
+
+    std::memcpy(bytes, &keyValueSize, 4);
+    file.insert(file.end(), bytes, bytes + 4);
+    file.insert(file.end(), orientation, orientation + keyValueSize);
+    file.resize(file.size() + keyValueBytes - 4 - keyValueSize, 0);
+
+    for (std::size_t i = 0; i < image.levels.size(); ++i)
+    {
+        Uint32 size = static_cast<Uint32>(image.levels[i].size());
+        std::memcpy(bytes, &size, 4);
+        file.insert(file.end(), bytes, bytes + 4);
+        file.insert(file.end(), image.levels[i].begin(), image.levels[i].end());
+        file.resize((file.size() + 3) & ~static_cast<std::size_t>(3), 0);
+    }
+
+    std::FILE* output = std::fopen(filename.c_str(), "wb");
+    if (!output)
+    {
+        err() << "Failed to save image \"" << filename << "\" (cannot open file)" << std::endl;
+        return false;
+    }
+
+    bool success = (std::fwrite(&file[0], 1, file.size(), output) == file.size());
+    success = (std::fclose(output) == 0) && success;
+    if (!success)
+        err() << "Failed to save image \"" << filename << "\" (cannot write file)" << std::endl;
+
+    return success;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int getSrgbFormat(unsigned int format)
+{
+    switch (format)
+    {
+        case CompressedRgbDxt1:   return 0x8C4C;
+        case CompressedRgbaDxt1:  return 0x8C4D;
+        case CompressedRgbaDxt3:  return 0x8C4E;
+        case CompressedRgbaDxt5:  return 0x8C4F;
+        case CompressedRgbEtc1:   return 0x9275; // ETC1 is a subset of ETC2
+        case CompressedRgbEtc2:   return 0x9275;
+        case CompressedRgbA1Etc2: return 0x9277;
+        case CompressedRgbaEtc2:  return 0x9279;
+        case UncompressedRgba8:   return 0x8C43;
+        default:                  return format + 0x20; // ASTC
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool canDecompress(unsigned int format)
+{
+    return (format < CompressedRgbaAstc4x4) || (format > CompressedRgbaAstc12x12);
+}
+
+
+////////////////////////////////////////////////////////////
+bool decompressImage(const CompressedImage& image, std::size_t level, std::vector<Uint8>& pixels)
+{
+    if (!canDecompress(image.format) || (level >= image.levels.size()))
+        return false;
+
+    if (image.format == UncompressedRgba8)
+    {
+        pixels = image.levels[level];
+        return true;
+    }
+
+    unsigned int width   = std::max(image.size.x >> level, 1u);
+    unsigned int height  = std::max(image.size.y >> level, 1u);
+    unsigned int blocksX = (width + 3) / 4;
+    unsigned int blocksY = (height + 3) / 4;
+
+    pixels.resize(width * height * 4);
+
+    const Uint8* block = &image.levels[level][0];
+    Uint8 texels[16 * 4];
+    for (unsigned int by = 0; by < blocksY; ++by)
+    {
+        for (unsigned int bx = 0; bx < blocksX; ++bx, block += image.blockBytes)
+        {
+            switch (image.format)
+            {
+                case CompressedRgbDxt1:   decodeDxtColor(block, texels, true, false); break;
+                case CompressedRgbaDxt1:  decodeDxtColor(block, texels, true, true);  break;
+                case CompressedRgbaDxt3:  decodeDxtColor(block + 8, texels, false, false); decodeDxt3Alpha(block, texels); break;
+                case CompressedRgbaDxt5:  decodeDxtColor(block + 8, texels, false, false); decodeDxt5Alpha(block, texels); break;
+                case CompressedRgbEtc1:   decodeEtc(block, texels, Etc1); break;
+                case CompressedRgbEtc2:   decodeEtc(block, texels, Etc2); break;
+                case CompressedRgbA1Etc2: decodeEtc(block, texels, Etc2PunchThrough); break;
+                case CompressedRgbaEtc2:  decodeEtc(block + 8, texels, Etc2); decodeEacAlpha(block, texels); break;
+                default:                  return false;
+            }
+
+            // Copy the texels that lie inside the image (blocks may overlap the borders)
+            unsigned int columns = std::min(4u, width - bx * 4);
+            unsigned int rows    = std::min(4u, height - by * 4);
+            for (unsigned int y = 0; y < rows; ++y)
+                std::memcpy(&pixels[((by * 4 + y) * width + bx * 4) * 4], texels + y * 16, columns * 4);
+        }
+    }
+
+    return true;
+}
+
+} // namespace priv
+
+} // namespace sf
@@ -0,0 +1,146 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2016 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_COMPRESSEDIMAGE_HPP
+#define SFML_COMPRESSEDIMAGE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Config.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <string>
+#include <vector>
+
+
+namespace sf
+{
+class InputStream;
+
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Block-compressed formats, identified by their OpenGL internal format
+///
+/// Uncompressed RGBA is also accepted, to store mipmap
+/// chains built offline in the same containers.
+///
+////////////////////////////////////////////////////////////
+enum CompressedFormat
+{
+    UncompressedRgba8       = 0x8058, ///< Not compressed, 8 bits per component
+    CompressedRgbDxt1       = 0x83F0, ///< S3TC / BC1, opaque
+    CompressedRgbaDxt1      = 0x83F1, ///< S3TC / BC1, with 1-bit alpha
+    CompressedRgbaDxt3      = 0x83F2, ///< S3TC / BC2
+    CompressedRgbaDxt5      = 0x83F3, ///< S3TC / BC3
+    CompressedRgbEtc1       = 0x8D64, ///< ETC1
+    CompressedRgbEtc2       = 0x9274, ///< ETC2, opaque
+    CompressedRgbA1Etc2     = 0x9276, ///< ETC2 with 1-bit alpha
+    CompressedRgbaEtc2      = 0x9278, ///< ETC2 with EAC alpha
+    CompressedRgbaAstc4x4   = 0x93B0, ///< First ASTC format (4x4 blocks)
+    CompressedRgbaAstc12x12 = 0x93BD  ///< Last ASTC format (12x12 blocks)
+};
+
+////////////////////////////////////////////////////////////
+/// \brief Block-compressed image loaded from a KTX or DDS file
+///
+////////////////////////////////////////////////////////////
+struct CompressedImage
+{
+    unsigned int                     format;     ///< Compressed format (linear variant, see CompressedFormat)
+    bool                             sRgb;       ///< Are the colors in the sRGB color space?
+    Vector2u                         size;       ///< Size of the first level, in pixels
+    Vector2u                         blockSize;  ///< Size of a block, in pixels
+    unsigned int                     blockBytes; ///< Size of a block, in bytes
+    std::vector<std::vector<Uint8> > levels;     ///< Data of each mipmap level, largest first
+};
+
+////////////////////////////////////////////////////////////
+/// \brief Load a block-compressed image from a KTX or DDS container
+///
+/// Only 2D images are supported (no arrays, cube maps or
+/// volumes). The rows are expected top to bottom.
+///
+/// \param stream Source stream to read from
+/// \param image  Structure to fill
+///
+/// \return True if loading was successful
+///
+////////////////////////////////////////////////////////////
+bool loadCompressedImage(InputStream& stream, CompressedImage& image);
+
+////////////////////////////////////////////////////////////
+/// \brief Save an image and its mipmap levels to a KTX file
+///
+/// \param filename Path of the file to write
+/// \param image    Image to save
+///
+/// \return True if saving was successful
+///
+////////////////////////////////////////////////////////////
+bool saveCompressedImage(const std::string& filename, const CompressedImage& image);
+
+////////////////////////////////////////////////////////////
+/// \brief Get the sRGB variant of a compressed format
+///
+/// \param format Linear format (see CompressedFormat)
+///
+/// \return Corresponding sRGB format
+///
+////////////////////////////////////////////////////////////
+unsigned int getSrgbFormat(unsigned int format);
+
+////////////////////////////////////////////////////////////
+/// \brief Check if a compressed format can be decompressed on the CPU
+///
+/// \param format Compressed format (see CompressedFormat)
+///
+/// \return True if decompressImage supports the format
+///
+////////////////////////////////////////////////////////////
+bool canDecompress(unsigned int format);
+
+////////////////////////////////////////////////////////////
+/// \brief Decompress a level of a compressed image to RGBA pixels
+///
+/// S3TC (BC1-3), ETC1 and ETC2 (all modes, with EAC or
+/// punch-through alpha) are supported. Uncompressed levels
+/// are copied as they are.
+///
+/// \param image  Compressed image
+/// \param level  Index of the mipmap level to decompress
+/// \param pixels Filled with the RGBA pixels of the level
+///
+/// \return True on success, false if the format is not supported
+///
+////////////////////////////////////////////////////////////
+bool decompressImage(const CompressedImage& image, std::size_t level, std::vector<Uint8>& pixels);
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_COMPRESSEDIMAGE_HPP
@@ -0,0 +1,386 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2016 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/DiskCache.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/System/InputStream.hpp>
+#include <SFML/System/FileInputStream.hpp>
+#include <SFML/System/Clock.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Err.hpp>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+
+namespace
+{
+    // Headers of the cached files: magic ("SFCI" for images, "SFCP" for
+    // programs) and format version
+    const sf::Uint32 imageMagic   = 0x49434653;
+    const sf::Uint32 programMagic = 0x50434653;
+    const sf::Uint32 cacheVersion = 1;
+
+    void writeUint64(std::ostream& stream, sf::Uint64 value)
+    {
+        char bytes[8];
+        for (int i = 0; i < 8; ++i)
+            bytes[i] = static_cast<char>((value >> (i * 8)) & 0xFF);
+        stream.write(bytes, sizeof(bytes));
+    }
+
+    bool readUint64(std::istream& stream, sf::Uint64& value)
+    {
+        unsigned char bytes[8];
+        if (!stream.read(reinterpret_cast<char*>(bytes), sizeof(bytes)))
+            return false;
+
+        value = 0;
+        for (int i = 0; i < 8; ++i)
+            value |= static_cast<sf::Uint64>(bytes[i]) << (i * 8);
+        return true;
+    }
+
+    // Get the number of bytes between the reading position and the end of a file
+    sf::Uint64 getRemainingSize(std::istream& stream)
+    {
+        std::streampos position = stream.tellg();
+        if ((position < 0) || !stream.seekg(0, std::ios_base::end))
+            return 0;
+
+        std::streampos end = stream.tellg();
+        if ((end < position) || !stream.seekg(position))
+            return 0;
+
+        return static_cast<sf::Uint64>(end - position);
+    }
+
+    sf::Uint64 makeHeader(sf::Uint32 magic)
+    {
+        return (static_cast<sf::Uint64>(cacheVersion) << 32) | magic;
+    }
+
+    // Write the file under a temporary name first, so that an interrupted
+    // write (or another process reading the cache) never sees a partial file
+    bool commitFile(std::ofstream& file, const std::string& temporary, const std::string& path)
+    {
+        bool success = file.good();
+        file.close();
+        if (success)
+        {
+            std::remove(path.c_str());
+            success = (std::rename(temporary.c_str(), path.c_str()) == 0);
+        }
+
+        if (!success)
+            std::remove(temporary.c_str());
+
+        return success;
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+DiskCache::DiskCache(const std::string& directory) :
+m_directory (directory),
+m_statistics(),
+m_mutex     ()
+{
+    resetStatistics();
+}
+
+
+////////////////////////////////////////////////////////////
+const std::string& DiskCache::getDirectory() const
+{
+    return m_directory;
+}
+
+
+////////////////////////////////////////////////////////////
+bool DiskCache::loadImageFromFile(const std::string& filename, Image& image)
+{
+    FileInputStream stream;
+    if (!stream.open(filename))
+    {
+        err() << "Failed to load image \"" << filename << "\". Reason: Unable to open file" << std::endl;
+        return false;
+    }
+
+    return loadImageFromStream(stream, image);
+}
+
+
+////////////////////////////////////////////////////////////
+bool DiskCache::loadImageFromMemory(const void* data, std::size_t size, Image& image)
+{
+    Clock clock;
+
+    // Cached images are identified by the contents of their source
+    Uint64 key = computeHash(data, size);
+    std::string path = getPath(key, ".sfimg");
+
+    // Read the decoded pixels if they are cached
+    {
+        std::ifstream file(path.c_str(), std::ios_base::binary);
+        Uint64 header, sourceKey, sourceSize, dimensions, decodeTime;
+        if (file && readUint64(file, header) && (header == makeHeader(imageMagic)) &&
+            readUint64(file, sourceKey) && readUint64(file, sourceSize) &&
+            readUint64(file, dimensions) && readUint64(file, decodeTime) &&
+            (sourceKey == key) && (sourceSize == size))
+        {
+            // The file must hold exactly the pixels announced by its header; a truncated
+            // or corrupt file is a cache miss, checked before allocating anything
+            Vector2u imageSize(static_cast<unsigned int>(dimensions >> 32), static_cast<unsigned int>(dimensions & 0xFFFFFFFF));
+            Uint64 pixelCount = static_cast<Uint64>(imageSize.x) * imageSize.y;
+            Uint64 remaining = getRemainingSize(file);
+            bool valid = (pixelCount > 0) && (pixelCount <= remaining / 4) && (pixelCount * 4 == remaining) &&
+                         (remaining <= static_cast<std::size_t>(-1));
+
+            std::vector<Uint8> pixels(valid ? static_cast<std::size_t>(remaining) : 0);
+            if (valid && file.read(reinterpret_cast<char*>(&pixels[0]), pixels.size()))
+            {
+                image.m_size = imageSize;
+                image.m_pixels.swap(pixels);
+
+                record(false, true, clock.getElapsedTime(), microseconds(static_cast<Int64>(decodeTime)));
+                return true;
+            }
+        }
+    }
+
+    // Not cached (or invalid): decode the source
+    Clock decodeClock;
+    if (!image.loadFromMemory(data, size))
+        return false;
+    Time decodeTime = decodeClock.getElapsedTime();
+
+    // Store the pixels for the next time; failing to write the cache is not an error
+    std::string temporary = path + ".tmp";
+    std::ofstream file(temporary.c_str(), std::ios_base::binary);
+    if (file)
+    {
+        Vector2u imageSize = image.getSize();
+        writeUint64(file, makeHeader(imageMagic));
+        writeUint64(file, key);
+        writeUint64(file, size);
+        writeUint64(file, (static_cast<Uint64>(imageSize.x) << 32) | imageSize.y);
+        writeUint64(file, static_cast<Uint64>(decodeTime.asMicroseconds()));
+        if (!image.m_pixels.empty())
+            file.write(reinterpret_cast<const char*>(&image.m_pixels[0]), image.m_pixels.size());
+
+        commitFile(file, temporary, path);
+    }
+
+    record(false, false, clock.getElapsedTime(), Time::Zero);
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool DiskCache::loadImageFromStream(InputStream& stream, Image& image)
+{
+    // The whole source is needed to compute its hash: read it once,
+    // and decode it from memory if it is not cached
+    Int64 size = stream.getSize();
+    if ((size <= 0) || (stream.seek(0) == -1))
+    {
+        err() << "Failed to load image from stream. Reason: Unable to read the stream" << std::endl;
+        return false;
+    }
+
+    std::vector<char> data(static_cast<std::size_t>(size));
+    if (stream.read(&data[0], size) != size)
+    {
+        err() << "Failed to load image from stream. Reason: Unable to read the stream" << std::endl;
+        return false;
+    }
+
+    return loadImageFromMemory(&data[0], data.size(), image);
+}
+
+
+////////////////////////////////////////////////////////////
+bool DiskCache::loadTextureFromFile(const std::string& filename, Texture& texture, const IntRect& area)
+{
+    Image image;
+    return loadImageFromFile(filename, image) && texture.loadFromImage(image, area);
+}
+
+
+////////////////////////////////////////////////////////////
+DiskCache::Statistics DiskCache::getStatistics() const
+{
+    Lock lock(m_mutex);
+
+    return m_statistics;
+}
+
+
+////////////////////////////////////////////////////////////
+void DiskCache::resetStatistics()
+{
+    Lock lock(m_mutex);
+
+    m_statistics.imageHits     = 0;
+    m_statistics.imageMisses   = 0;
+    m_statistics.programHits   = 0;
+    m_statistics.programMisses = 0;
+    m_statistics.hitTime       = Time::Zero;
+    m_statistics.missTime      = Time::Zero;
+    m_statistics.timeSaved     = Time::Zero;
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 DiskCache::computeHash(const void* data, std::size_t size, Uint64 seed)
+{
+    // FNV-1a, applied to 64-bit words rather than bytes for speed (large
+    // files are hashed on every load); the extra shift spreads the high
+    // bits of each word to the low bits of the hash
+    const Uint64 prime = (static_cast<Uint64>(0x100) << 32) | 0x1B3;
+    Uint64 hash = seed ? seed : ((static_cast<Uint64>(0xCBF29CE4) << 32) | 0x84222325);
+
+    const Uint8* bytes = static_cast<const Uint8*>(data);
+    std::size_t i = 0;
+    for (; i + 8 <= size; i += 8)
+    {
+        Uint64 word;
+        std::memcpy(&word, bytes + i, sizeof(word));
+        hash = (hash ^ word) * prime;
+        hash ^= hash >> 32;
+    }
+
+    for (; i < size; ++i)
+        hash = (hash ^ bytes[i]) * prime;
+
+    // Mix the size in, so that blocks hashed one after the other don't collide
+    return (hash ^ size) * prime;
+}
+
+
+////////////////////////////////////////////////////////////
+bool DiskCache::loadProgram(Uint64 sourceKey, Uint64 driverKey, std::vector<char>& binary, Uint32& format, Time& compileTime) const
+{
+    std::ifstream file(getPath(sourceKey, ".sfprog").c_str(), std::ios_base::binary);
+    if (!file)
+        return false;
+
+    // The binary is only valid for the driver that produced it
+    Uint64 header, key, driver, description, time;
+    if (!readUint64(file, header) || (header != makeHeader(programMagic)))
+        return false;
+    if (!readUint64(file, key) || !readUint64(file, driver) || !readUint64(file, description) || !readUint64(file, time))
+        return false;
+    if ((key != sourceKey) || (driver != driverKey))
+        return false;
+
+    // A truncated or corrupt file is ignored, checked before allocating anything
+    Uint64 size = description & 0xFFFFFFFF;
+    if ((size == 0) || (size != getRemainingSize(file)))
+        return false;
+
+    binary.resize(static_cast<std::size_t>(size));
+    if (!file.read(&binary[0], binary.size()))
+        return false;
+
+    format = static_cast<Uint32>(description >> 32);
+    compileTime = microseconds(static_cast<Int64>(time));
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void DiskCache::saveProgram(Uint64 sourceKey, Uint64 driverKey, const std::vector<char>& binary, Uint32 format, Time compileTime) const
+{
+    if (binary.empty())
+        return;
+
+    std::string path = getPath(sourceKey, ".sfprog");
+    std::string temporary = path + ".tmp";
+    std::ofstream file(temporary.c_str(), std::ios_base::binary);
+    if (!file)
+        return;
+
+    writeUint64(file, makeHeader(programMagic));
+    writeUint64(file, sourceKey);
+    writeUint64(file, driverKey);
+    writeUint64(file, (static_cast<Uint64>(format) << 32) | binary.size());
+    writeUint64(file, static_cast<Uint64>(compileTime.asMicroseconds()));
+    file.write(&binary[0], binary.size());
+
+    commitFile(file, temporary, path);
+}
+
+
+////////////////////////////////////////////////////////////
+void DiskCache::record(bool program, bool hit, Time elapsed, Time original)
+{
+    Lock lock(m_mutex);
+
+    if (hit)
+    {
+        if (program)
+            m_statistics.programHits++;
+        else
+            m_statistics.imageHits++;
+
+        m_statistics.hitTime += elapsed;
+        if (original > elapsed)
+            m_statistics.timeSaved += original - elapsed;
+    }
+    else
+    {
+        if (program)
+            m_statistics.programMisses++;
+        else
+            m_statistics.imageMisses++;
+
+        m_statistics.missTime += elapsed;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+std::string DiskCache::getPath(Uint64 key, const char* extension) const
+{
+    char name[17];
+    std::sprintf(name, "%08X%08X", static_cast<unsigned int>(key >> 32), static_cast<unsigned int>(key & 0xFFFFFFFF));
+
+    std::string path = m_directory;
+    if (!path.empty() && (path[path.size() - 1] != '/') && (path[path.size() - 1] != '\\'))
+        path += '/';
+
+    return path + name + extension;
+}
+
+} // namespace sf
@@ -447,20 +447,27 @@ Font& Font::operator =(const Font& right)
 {
     Font temp(right);
 
-    std::swap(m_library,     temp.m_library);
-    std::swap(m_face,        temp.m_face);
-    std::swap(m_streamRec,   temp.m_streamRec);
-    std::swap(m_stroker,     temp.m_stroker);
-    std::swap(m_refCount,    temp.m_refCount);
-    std::swap(m_info,        temp.m_info);
-    std::swap(m_pages,       temp.m_pages);
-    std::swap(m_pixelBuffer, temp.m_pixelBuffer);
+    swap(temp);
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+void Font::swap(Font& right)
+{
+    std::swap(m_library,     right.m_library);
+    std::swap(m_face,        right.m_face);
+    std::swap(m_streamRec,   right.m_streamRec);
+    std::swap(m_stroker,     right.m_stroker);
+    std::swap(m_refCount,    right.m_refCount);
+    std::swap(m_info,        right.m_info);
+    std::swap(m_pages,       right.m_pages);
+    std::swap(m_pixelBuffer, right.m_pixelBuffer);
 
     #ifdef SFML_SYSTEM_ANDROID
-        std::swap(m_stream, temp.m_stream);
+        std::swap(m_stream, right.m_stream);
     #endif
-
-    return *this;
 }
 
 
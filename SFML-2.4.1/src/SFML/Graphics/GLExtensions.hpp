@@ -52,6 +52,10 @@
     #define GLEXT_GL_TEXTURE0                         GL_TEXTURE0
     #define GLEXT_GL_CLAMP                            GL_CLAMP_TO_EDGE
     #define GLEXT_GL_CLAMP_TO_EDGE                    GL_CLAMP_TO_EDGE
+    #define GLEXT_texture_compression                 true
+    #define GLEXT_glCompressedTexImage2D              glCompressedTexImage2D
+    #define GLEXT_GL_NUM_COMPRESSED_TEXTURE_FORMATS   GL_NUM_COMPRESSED_TEXTURE_FORMATS
+    #define GLEXT_GL_COMPRESSED_TEXTURE_FORMATS       GL_COMPRESSED_TEXTURE_FORMATS
 
     // The following extensions are listed chronologically
     // Extension macro first, followed by tokens then
@@ -120,6 +124,28 @@
         #define GLEXT_GL_SRGB8_ALPHA8                     0
     #endif
 
+    // Compressed texture formats (EXT_texture_compression_s3tc,
+    // OES_compressed_ETC1_RGB8_texture, core ETC2 since 3.0,
+    // KHR_texture_compression_astc_ldr) are all reported in
+    // GL_COMPRESSED_TEXTURE_FORMATS, which is checked instead
+    #define GLEXT_texture_compression_s3tc            false
+    #define GLEXT_ES3_compatibility                   false
+    #define GLEXT_texture_compression_astc_ldr        false
+
+    // Buffer objects are core in OpenGL ES 2.0 and pixel buffer objects
+    // and fences in OpenGL ES 3.0, which are not targeted yet
+    #define GLEXT_vertex_buffer_object                false
+    #define GLEXT_pixel_buffer_object                 false
+    #define GLEXT_sync                                false
+
+    // Shaders are not supported on OpenGL ES 1, there is
+    // no program binary to save either
+    #define GLEXT_get_program_binary                  false
+
+    // Instancing needs shaders
+    #define GLEXT_draw_instanced                      false
+    #define GLEXT_instanced_arrays                    false
+
 #else
 
     #include <SFML/Graphics/GLLoader.hpp>
@@ -161,10 +187,34 @@
     #define GLEXT_glActiveTexture                     glActiveTextureARB
     #define GLEXT_GL_TEXTURE0                         GL_TEXTURE0_ARB
 
+    // Core since 1.3 - ARB_texture_compression
+    #define GLEXT_texture_compression                 sfogl_ext_ARB_texture_compression
+    #define GLEXT_glCompressedTexImage2D              glCompressedTexImage2DARB
+    #define GLEXT_GL_NUM_COMPRESSED_TEXTURE_FORMATS   GL_NUM_COMPRESSED_TEXTURE_FORMATS_ARB
+    #define GLEXT_GL_COMPRESSED_TEXTURE_FORMATS       GL_COMPRESSED_TEXTURE_FORMATS_ARB
+
+    // EXT_texture_compression_s3tc
+    #define GLEXT_texture_compression_s3tc            sfogl_ext_EXT_texture_compression_s3tc
+
     // Core since 1.4 - EXT_blend_func_separate
     #define GLEXT_blend_func_separate                 sfogl_ext_EXT_blend_func_separate
     #define GLEXT_glBlendFuncSeparate                 glBlendFuncSeparateEXT
 
+    // Core since 1.5 - ARB_vertex_buffer_object
+    #define GLEXT_vertex_buffer_object                sfogl_ext_ARB_vertex_buffer_object
+    #define GLEXT_glBindBuffer                        glBindBufferARB
+    #define GLEXT_glBufferData                        glBufferDataARB
+    #define GLEXT_glBufferSubData                     glBufferSubDataARB
+    #define GLEXT_glDeleteBuffers                     glDeleteBuffersARB
+    #define GLEXT_glGenBuffers                        glGenBuffersARB
+    #define GLEXT_glMapBuffer                         glMapBufferARB
+    #define GLEXT_glUnmapBuffer                       glUnmapBufferARB
+    #define GLEXT_GL_ARRAY_BUFFER                     GL_ARRAY_BUFFER_ARB
+    #define GLEXT_GL_STREAM_DRAW                      GL_STREAM_DRAW_ARB
+    #define GLEXT_GL_STREAM_READ                      GL_STREAM_READ_ARB
+    #define GLEXT_GL_READ_ONLY                        GL_READ_ONLY_ARB
+    #define GLEXT_GL_WRITE_ONLY                       GL_WRITE_ONLY_ARB
+
     // Core since 2.0 - ARB_shading_language_100
     #define GLEXT_shading_language_100                sfogl_ext_ARB_shading_language_100
 
@@ -205,6 +255,10 @@
     // Core since 2.0 - ARB_vertex_shader
     #define GLEXT_vertex_shader                       sfogl_ext_ARB_vertex_shader
     #define GLEXT_GL_VERTEX_SHADER                    GL_VERTEX_SHADER_ARB
+    #define GLEXT_glGetAttribLocation                 glGetAttribLocationARB
+    #define GLEXT_glVertexAttribPointer                glVertexAttribPointerARB
+    #define GLEXT_glEnableVertexAttribArray            glEnableVertexAttribArrayARB
+    #define GLEXT_glDisableVertexAttribArray           glDisableVertexAttribArrayARB
     #define GLEXT_GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS_ARB
 
     // Core since 2.0 - ARB_fragment_shader
@@ -222,6 +276,11 @@
     #define GLEXT_texture_sRGB                        sfogl_ext_EXT_texture_sRGB
     #define GLEXT_GL_SRGB8_ALPHA8                     GL_SRGB8_ALPHA8_EXT
 
+    // Core since 2.1 - ARB_pixel_buffer_object
+    #define GLEXT_pixel_buffer_object                 sfogl_ext_ARB_pixel_buffer_object
+    #define GLEXT_GL_PIXEL_PACK_BUFFER                GL_PIXEL_PACK_BUFFER_ARB
+    #define GLEXT_GL_PIXEL_UNPACK_BUFFER              GL_PIXEL_UNPACK_BUFFER_ARB
+
     // Core since 3.0 - EXT_framebuffer_object
     #define GLEXT_framebuffer_object                  sfogl_ext_EXT_framebuffer_object
     #define GLEXT_glBindRenderbuffer                  glBindRenderbufferEXT
@@ -243,10 +302,46 @@
     #define GLEXT_GL_FRAMEBUFFER_BINDING              GL_FRAMEBUFFER_BINDING_EXT
     #define GLEXT_GL_INVALID_FRAMEBUFFER_OPERATION    GL_INVALID_FRAMEBUFFER_OPERATION_EXT
 
+    // Core since 3.1 - ARB_draw_instanced
+    #define GLEXT_draw_instanced                      sfogl_ext_ARB_draw_instanced
+    #define GLEXT_glDrawArraysInstanced               glDrawArraysInstancedARB
+
     // Core since 3.2 - ARB_geometry_shader4
     #define GLEXT_geometry_shader4                    sfogl_ext_ARB_geometry_shader4
     #define GLEXT_GL_GEOMETRY_SHADER                  GL_GEOMETRY_SHADER_ARB
 
+    // Core since 3.2 - ARB_sync
+    #define GLEXT_sync                                sfogl_ext_ARB_sync
+    #define GLEXT_glFenceSync                         glFenceSync
+    #define GLEXT_glClientWaitSync                    glClientWaitSync
+    #define GLEXT_glDeleteSync                        glDeleteSync
+    #define GLEXT_GL_SYNC_GPU_COMMANDS_COMPLETE       GL_SYNC_GPU_COMMANDS_COMPLETE
+    #define GLEXT_GL_SYNC_FLUSH_COMMANDS_BIT          GL_SYNC_FLUSH_COMMANDS_BIT
+    #define GLEXT_GL_ALREADY_SIGNALED                 GL_ALREADY_SIGNALED
+    #define GLEXT_GL_CONDITION_SATISFIED              GL_CONDITION_SATISFIED
+    #define GLEXT_GL_TIMEOUT_EXPIRED                  GL_TIMEOUT_EXPIRED
+    #define GLEXT_GLsync                              GLsync
+
+    // Core since 3.3 - ARB_instanced_arrays
+    #define GLEXT_instanced_arrays                    sfogl_ext_ARB_instanced_arrays
+    #define GLEXT_glVertexAttribDivisor               glVertexAttribDivisorARB
+
+    // Core since 4.1 - ARB_get_program_binary
+    #define GLEXT_get_program_binary                  sfogl_ext_ARB_get_program_binary
+    #define GLEXT_glGetProgramBinary                  glGetProgramBinary
+    #define GLEXT_glGetProgramiv                      glGetProgramiv
+    #define GLEXT_glProgramBinary                     glProgramBinary
+    #define GLEXT_glProgramParameteri                 glProgramParameteri
+    #define GLEXT_GL_NUM_PROGRAM_BINARY_FORMATS       GL_NUM_PROGRAM_BINARY_FORMATS
+    #define GLEXT_GL_PROGRAM_BINARY_LENGTH            GL_PROGRAM_BINARY_LENGTH
+    #define GLEXT_GL_PROGRAM_BINARY_RETRIEVABLE_HINT  GL_PROGRAM_BINARY_RETRIEVABLE_HINT
+
+    // Core since 4.3 - ARB_ES3_compatibility (ETC2/EAC formats)
+    #define GLEXT_ES3_compatibility                   sfogl_ext_ARB_ES3_compatibility
+
+    // KHR_texture_compression_astc_ldr
+    #define GLEXT_texture_compression_astc_ldr        sfogl_ext_KHR_texture_compression_astc_ldr
+
 #endif
 
 namespace sf
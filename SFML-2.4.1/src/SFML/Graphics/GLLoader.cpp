@@ -48,6 +48,16 @@ int sfogl_ext_EXT_blend_equation_separate = sfogl_LOAD_FAILED;
 int sfogl_ext_EXT_texture_sRGB = sfogl_LOAD_FAILED;
 int sfogl_ext_EXT_framebuffer_object = sfogl_LOAD_FAILED;
 int sfogl_ext_ARB_geometry_shader4 = sfogl_LOAD_FAILED;
+int sfogl_ext_ARB_texture_compression = sfogl_LOAD_FAILED;
+int sfogl_ext_EXT_texture_compression_s3tc = sfogl_LOAD_FAILED;
+int sfogl_ext_ARB_ES3_compatibility = sfogl_LOAD_FAILED;
+int sfogl_ext_KHR_texture_compression_astc_ldr = sfogl_LOAD_FAILED;
+int sfogl_ext_ARB_vertex_buffer_object = sfogl_LOAD_FAILED;
+int sfogl_ext_ARB_pixel_buffer_object = sfogl_LOAD_FAILED;
+int sfogl_ext_ARB_sync = sfogl_LOAD_FAILED;
+int sfogl_ext_ARB_get_program_binary = sfogl_LOAD_FAILED;
+int sfogl_ext_ARB_draw_instanced = sfogl_LOAD_FAILED;
+int sfogl_ext_ARB_instanced_arrays = sfogl_LOAD_FAILED;
 
 void (GL_FUNCPTR *sf_ptrc_glBlendEquationEXT)(GLenum) = NULL;
 
@@ -828,6 +838,214 @@ static int Load_ARB_geometry_shader4()
     return numFailed;
 }
 
+void (GL_FUNCPTR *sf_ptrc_glCompressedTexImage1DARB)(GLenum, GLint, GLenum, GLsizei, GLint, GLsizei, const void*) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glCompressedTexImage2DARB)(GLenum, GLint, GLenum, GLsizei, GLsizei, GLint, GLsizei, const void*) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glCompressedTexImage3DARB)(GLenum, GLint, GLenum, GLsizei, GLsizei, GLsizei, GLint, GLsizei, const void*) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glCompressedTexSubImage1DARB)(GLenum, GLint, GLint, GLsizei, GLenum, GLsizei, const void*) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glCompressedTexSubImage2DARB)(GLenum, GLint, GLint, GLint, GLsizei, GLsizei, GLenum, GLsizei, const void*) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glCompressedTexSubImage3DARB)(GLenum, GLint, GLint, GLint, GLint, GLsizei, GLsizei, GLsizei, GLenum, GLsizei, const void*) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glGetCompressedTexImageARB)(GLenum, GLint, void*) = NULL;
+
+static int Load_ARB_texture_compression()
+{
+    int numFailed = 0;
+
+    sf_ptrc_glCompressedTexImage1DARB = reinterpret_cast<void (GL_FUNCPTR *)(GLenum, GLint, GLenum, GLsizei, GLint, GLsizei, const void*)>(glLoaderGetProcAddress("glCompressedTexImage1DARB"));
+    if (!sf_ptrc_glCompressedTexImage1DARB)
+        numFailed++;
+
+    sf_ptrc_glCompressedTexImage2DARB = reinterpret_cast<void (GL_FUNCPTR *)(GLenum, GLint, GLenum, GLsizei, GLsizei, GLint, GLsizei, const void*)>(glLoaderGetProcAddress("glCompressedTexImage2DARB"));
+    if (!sf_ptrc_glCompressedTexImage2DARB)
+        numFailed++;
+
+    sf_ptrc_glCompressedTexImage3DARB = reinterpret_cast<void (GL_FUNCPTR *)(GLenum, GLint, GLenum, GLsizei, GLsizei, GLsizei, GLint, GLsizei, const void*)>(glLoaderGetProcAddress("glCompressedTexImage3DARB"));
+    if (!sf_ptrc_glCompressedTexImage3DARB)
+        numFailed++;
+
+    sf_ptrc_glCompressedTexSubImage1DARB = reinterpret_cast<void (GL_FUNCPTR *)(GLenum, GLint, GLint, GLsizei, GLenum, GLsizei, const void*)>(glLoaderGetProcAddress("glCompressedTexSubImage1DARB"));
+    if (!sf_ptrc_glCompressedTexSubImage1DARB)
+        numFailed++;
+
+    sf_ptrc_glCompressedTexSubImage2DARB = reinterpret_cast<void (GL_FUNCPTR *)(GLenum, GLint, GLint, GLint, GLsizei, GLsizei, GLenum, GLsizei, const void*)>(glLoaderGetProcAddress("glCompressedTexSubImage2DARB"));
+    if (!sf_ptrc_glCompressedTexSubImage2DARB)
+        numFailed++;
+
+    sf_ptrc_glCompressedTexSubImage3DARB = reinterpret_cast<void (GL_FUNCPTR *)(GLenum, GLint, GLint, GLint, GLint, GLsizei, GLsizei, GLsizei, GLenum, GLsizei, const void*)>(glLoaderGetProcAddress("glCompressedTexSubImage3DARB"));
+    if (!sf_ptrc_glCompressedTexSubImage3DARB)
+        numFailed++;
+
+    sf_ptrc_glGetCompressedTexImageARB = reinterpret_cast<void (GL_FUNCPTR *)(GLenum, GLint, void*)>(glLoaderGetProcAddress("glGetCompressedTexImageARB"));
+    if (!sf_ptrc_glGetCompressedTexImageARB)
+        numFailed++;
+
+    return numFailed;
+}
+
+void (GL_FUNCPTR *sf_ptrc_glBindBufferARB)(GLenum, GLuint) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glBufferDataARB)(GLenum, GLsizeiptrARB, const void*, GLenum) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glBufferSubDataARB)(GLenum, GLintptrARB, GLsizeiptrARB, const void*) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glDeleteBuffersARB)(GLsizei, const GLuint*) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glGenBuffersARB)(GLsizei, GLuint*) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glGetBufferParameterivARB)(GLenum, GLenum, GLint*) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glGetBufferPointervARB)(GLenum, GLenum, void**) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glGetBufferSubDataARB)(GLenum, GLintptrARB, GLsizeiptrARB, void*) = NULL;
+GLboolean (GL_FUNCPTR *sf_ptrc_glIsBufferARB)(GLuint) = NULL;
+void* (GL_FUNCPTR *sf_ptrc_glMapBufferARB)(GLenum, GLenum) = NULL;
+GLboolean (GL_FUNCPTR *sf_ptrc_glUnmapBufferARB)(GLenum) = NULL;
+
+static int Load_ARB_vertex_buffer_object()
+{
+    int numFailed = 0;
+
+    sf_ptrc_glBindBufferARB = reinterpret_cast<void (GL_FUNCPTR *)(GLenum, GLuint)>(glLoaderGetProcAddress("glBindBufferARB"));
+    if (!sf_ptrc_glBindBufferARB)
+        numFailed++;
+
+    sf_ptrc_glBufferDataARB = reinterpret_cast<void (GL_FUNCPTR *)(GLenum, GLsizeiptrARB, const void*, GLenum)>(glLoaderGetProcAddress("glBufferDataARB"));
+    if (!sf_ptrc_glBufferDataARB)
+        numFailed++;
+
+    sf_ptrc_glBufferSubDataARB = reinterpret_cast<void (GL_FUNCPTR *)(GLenum, GLintptrARB, GLsizeiptrARB, const void*)>(glLoaderGetProcAddress("glBufferSubDataARB"));
+    if (!sf_ptrc_glBufferSubDataARB)
+        numFailed++;
+
+    sf_ptrc_glDeleteBuffersARB = reinterpret_cast<void (GL_FUNCPTR *)(GLsizei, const GLuint*)>(glLoaderGetProcAddress("glDeleteBuffersARB"));
+    if (!sf_ptrc_glDeleteBuffersARB)
+        numFailed++;
+
+    sf_ptrc_glGenBuffersARB = reinterpret_cast<void (GL_FUNCPTR *)(GLsizei, GLuint*)>(glLoaderGetProcAddress("glGenBuffersARB"));
+    if (!sf_ptrc_glGenBuffersARB)
+        numFailed++;
+
+    sf_ptrc_glGetBufferParameterivARB = reinterpret_cast<void (GL_FUNCPTR *)(GLenum, GLenum, GLint*)>(glLoaderGetProcAddress("glGetBufferParameterivARB"));
+    if (!sf_ptrc_glGetBufferParameterivARB)
+        numFailed++;
+
+    sf_ptrc_glGetBufferPointervARB = reinterpret_cast<void (GL_FUNCPTR *)(GLenum, GLenum, void**)>(glLoaderGetProcAddress("glGetBufferPointervARB"));
+    if (!sf_ptrc_glGetBufferPointervARB)
+        numFailed++;
+
+    sf_ptrc_glGetBufferSubDataARB = reinterpret_cast<void (GL_FUNCPTR *)(GLenum, GLintptrARB, GLsizeiptrARB, void*)>(glLoaderGetProcAddress("glGetBufferSubDataARB"));
+    if (!sf_ptrc_glGetBufferSubDataARB)
+        numFailed++;
+
+    sf_ptrc_glIsBufferARB = reinterpret_cast<GLboolean (GL_FUNCPTR *)(GLuint)>(glLoaderGetProcAddress("glIsBufferARB"));
+    if (!sf_ptrc_glIsBufferARB)
+        numFailed++;
+
+    sf_ptrc_glMapBufferARB = reinterpret_cast<void* (GL_FUNCPTR *)(GLenum, GLenum)>(glLoaderGetProcAddress("glMapBufferARB"));
+    if (!sf_ptrc_glMapBufferARB)
+        numFailed++;
+
+    sf_ptrc_glUnmapBufferARB = reinterpret_cast<GLboolean (GL_FUNCPTR *)(GLenum)>(glLoaderGetProcAddress("glUnmapBufferARB"));
+    if (!sf_ptrc_glUnmapBufferARB)
+        numFailed++;
+
+    return numFailed;
+}
+
+GLenum (GL_FUNCPTR *sf_ptrc_glClientWaitSync)(GLsync, GLbitfield, GLuint64) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glDeleteSync)(GLsync) = NULL;
+GLsync (GL_FUNCPTR *sf_ptrc_glFenceSync)(GLenum, GLbitfield) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glGetInteger64v)(GLenum, GLint64*) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glGetSynciv)(GLsync, GLenum, GLsizei, GLsizei*, GLint*) = NULL;
+GLboolean (GL_FUNCPTR *sf_ptrc_glIsSync)(GLsync) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glWaitSync)(GLsync, GLbitfield, GLuint64) = NULL;
+
+static int Load_ARB_sync()
+{
+    int numFailed = 0;
+
+    sf_ptrc_glClientWaitSync = reinterpret_cast<GLenum (GL_FUNCPTR *)(GLsync, GLbitfield, GLuint64)>(glLoaderGetProcAddress("glClientWaitSync"));
+    if (!sf_ptrc_glClientWaitSync)
+        numFailed++;
+
+    sf_ptrc_glDeleteSync = reinterpret_cast<void (GL_FUNCPTR *)(GLsync)>(glLoaderGetProcAddress("glDeleteSync"));
+    if (!sf_ptrc_glDeleteSync)
+        numFailed++;
+
+    sf_ptrc_glFenceSync = reinterpret_cast<GLsync (GL_FUNCPTR *)(GLenum, GLbitfield)>(glLoaderGetProcAddress("glFenceSync"));
+    if (!sf_ptrc_glFenceSync)
+        numFailed++;
+
+    sf_ptrc_glGetInteger64v = reinterpret_cast<void (GL_FUNCPTR *)(GLenum, GLint64*)>(glLoaderGetProcAddress("glGetInteger64v"));
+    if (!sf_ptrc_glGetInteger64v)
+        numFailed++;
+
+    sf_ptrc_glGetSynciv = reinterpret_cast<void (GL_FUNCPTR *)(GLsync, GLenum, GLsizei, GLsizei*, GLint*)>(glLoaderGetProcAddress("glGetSynciv"));
+    if (!sf_ptrc_glGetSynciv)
+        numFailed++;
+
+    sf_ptrc_glIsSync = reinterpret_cast<GLboolean (GL_FUNCPTR *)(GLsync)>(glLoaderGetProcAddress("glIsSync"));
+    if (!sf_ptrc_glIsSync)
+        numFailed++;
+
+    sf_ptrc_glWaitSync = reinterpret_cast<void (GL_FUNCPTR *)(GLsync, GLbitfield, GLuint64)>(glLoaderGetProcAddress("glWaitSync"));
+    if (!sf_ptrc_glWaitSync)
+        numFailed++;
+
+    return numFailed;
+}
+
+void (GL_FUNCPTR *sf_ptrc_glGetProgramBinary)(GLuint, GLsizei, GLsizei*, GLenum*, void*) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glGetProgramiv)(GLuint, GLenum, GLint*) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glProgramBinary)(GLuint, GLenum, const void*, GLsizei) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glProgramParameteri)(GLuint, GLenum, GLint) = NULL;
+
+static int Load_ARB_get_program_binary()
+{
+    int numFailed = 0;
+
+    sf_ptrc_glGetProgramBinary = reinterpret_cast<void (GL_FUNCPTR *)(GLuint, GLsizei, GLsizei*, GLenum*, void*)>(glLoaderGetProcAddress("glGetProgramBinary"));
+    if (!sf_ptrc_glGetProgramBinary)
+        numFailed++;
+
+    sf_ptrc_glGetProgramiv = reinterpret_cast<void (GL_FUNCPTR *)(GLuint, GLenum, GLint*)>(glLoaderGetProcAddress("glGetProgramiv"));
+    if (!sf_ptrc_glGetProgramiv)
+        numFailed++;
+
+    sf_ptrc_glProgramBinary = reinterpret_cast<void (GL_FUNCPTR *)(GLuint, GLenum, const void*, GLsizei)>(glLoaderGetProcAddress("glProgramBinary"));
+    if (!sf_ptrc_glProgramBinary)
+        numFailed++;
+
+    sf_ptrc_glProgramParameteri = reinterpret_cast<void (GL_FUNCPTR *)(GLuint, GLenum, GLint)>(glLoaderGetProcAddress("glProgramParameteri"));
+    if (!sf_ptrc_glProgramParameteri)
+        numFailed++;
+
+    return numFailed;
+}
+
+void (GL_FUNCPTR *sf_ptrc_glDrawArraysInstancedARB)(GLenum, GLint, GLsizei, GLsizei) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glDrawElementsInstancedARB)(GLenum, GLsizei, GLenum, const void*, GLsizei) = NULL;
+
+static int Load_ARB_draw_instanced()
+{
+    int numFailed = 0;
+
+    sf_ptrc_glDrawArraysInstancedARB = reinterpret_cast<void (GL_FUNCPTR *)(GLenum, GLint, GLsizei, GLsizei)>(glLoaderGetProcAddress("glDrawArraysInstancedARB"));
+    if (!sf_ptrc_glDrawArraysInstancedARB)
+        numFailed++;
+
+    sf_ptrc_glDrawElementsInstancedARB = reinterpret_cast<void (GL_FUNCPTR *)(GLenum, GLsizei, GLenum, const void*, GLsizei)>(glLoaderGetProcAddress("glDrawElementsInstancedARB"));
+    if (!sf_ptrc_glDrawElementsInstancedARB)
+        numFailed++;
+
+    return numFailed;
+}
+
+void (GL_FUNCPTR *sf_ptrc_glVertexAttribDivisorARB)(GLuint, GLuint) = NULL;
+
+static int Load_ARB_instanced_arrays()
+{
+    int numFailed = 0;
+
+    sf_ptrc_glVertexAttribDivisorARB = reinterpret_cast<void (GL_FUNCPTR *)(GLuint, GLuint)>(glLoaderGetProcAddress("glVertexAttribDivisorARB"));
+    if (!sf_ptrc_glVertexAttribDivisorARB)
+        numFailed++;
+
+    return numFailed;
+}
+
 typedef int (*PFN_LOADFUNCPOINTERS)();
 typedef struct sfogl_StrToExtMap_s
 {
@@ -836,7 +1054,7 @@ typedef struct sfogl_StrToExtMap_s
     PFN_LOADFUNCPOINTERS LoadExtension;
 } sfogl_StrToExtMap;
 
-static sfogl_StrToExtMap ExtensionMap[15] = {
+static sfogl_StrToExtMap ExtensionMap[25] = {
     {"GL_SGIS_texture_edge_clamp", &sfogl_ext_SGIS_texture_edge_clamp, NULL},
     {"GL_EXT_texture_edge_clamp", &sfogl_ext_EXT_texture_edge_clamp, NULL},
     {"GL_EXT_blend_minmax", &sfogl_ext_EXT_blend_minmax, Load_EXT_blend_minmax},
@@ -851,10 +1069,20 @@ static sfogl_StrToExtMap ExtensionMap[15] = {
     {"GL_EXT_blend_equation_separate", &sfogl_ext_EXT_blend_equation_separate, Load_EXT_blend_equation_separate},
     {"GL_EXT_texture_sRGB", &sfogl_ext_EXT_texture_sRGB, NULL},
     {"GL_EXT_framebuffer_object", &sfogl_ext_EXT_framebuffer_object, Load_EXT_framebuffer_object},
-    {"GL_ARB_geometry_shader4", &sfogl_ext_ARB_geometry_shader4, Load_ARB_geometry_shader4}
+    {"GL_ARB_geometry_shader4", &sfogl_ext_ARB_geometry_shader4, Load_ARB_geometry_shader4},
+    {"GL_ARB_texture_compression", &sfogl_ext_ARB_texture_compression, Load_ARB_texture_compression},
+    {"GL_EXT_texture_compression_s3tc", &sfogl_ext_EXT_texture_compression_s3tc, NULL},
+    {"GL_ARB_ES3_compatibility", &sfogl_ext_ARB_ES3_compatibility, NULL},
+    {"GL_KHR_texture_compression_astc_ldr", &sfogl_ext_KHR_texture_compression_astc_ldr, NULL},
+    {"GL_ARB_vertex_buffer_object", &sfogl_ext_ARB_vertex_buffer_object, Load_ARB_vertex_buffer_object},
+    {"GL_ARB_pixel_buffer_object", &sfogl_ext_ARB_pixel_buffer_object, NULL},
+    {"GL_ARB_sync", &sfogl_ext_ARB_sync, Load_ARB_sync},
+    {"GL_ARB_get_program_binary", &sfogl_ext_ARB_get_program_binary, Load_ARB_get_program_binary},
+    {"GL_ARB_draw_instanced", &sfogl_ext_ARB_draw_instanced, Load_ARB_draw_instanced},
+    {"GL_ARB_instanced_arrays", &sfogl_ext_ARB_instanced_arrays, Load_ARB_instanced_arrays}
 };
 
-static int g_extensionMapSize = 15;
+static int g_extensionMapSize = 25;
 
 
 static void ClearExtensionVars()
@@ -874,6 +1102,16 @@ static void ClearExtensionVars()
     sfogl_ext_EXT_texture_sRGB = sfogl_LOAD_FAILED;
     sfogl_ext_EXT_framebuffer_object = sfogl_LOAD_FAILED;
     sfogl_ext_ARB_geometry_shader4 = sfogl_LOAD_FAILED;
+    sfogl_ext_ARB_texture_compression = sfogl_LOAD_FAILED;
+    sfogl_ext_EXT_texture_compression_s3tc = sfogl_LOAD_FAILED;
+    sfogl_ext_ARB_ES3_compatibility = sfogl_LOAD_FAILED;
+    sfogl_ext_KHR_texture_compression_astc_ldr = sfogl_LOAD_FAILED;
+    sfogl_ext_ARB_vertex_buffer_object = sfogl_LOAD_FAILED;
+    sfogl_ext_ARB_pixel_buffer_object = sfogl_LOAD_FAILED;
+    sfogl_ext_ARB_sync = sfogl_LOAD_FAILED;
+    sfogl_ext_ARB_get_program_binary = sfogl_LOAD_FAILED;
+    sfogl_ext_ARB_draw_instanced = sfogl_LOAD_FAILED;
+    sfogl_ext_ARB_instanced_arrays = sfogl_LOAD_FAILED;
 }
 
 
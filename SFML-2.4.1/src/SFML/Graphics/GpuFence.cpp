@@ -0,0 +1,158 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2016 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/GpuFence.hpp>
+#include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/Lock.hpp>
+#include <cstddef>
+
+
+namespace
+{
+    sf::Mutex isAvailableMutex;
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+GpuFence::GpuFence() :
+m_sync(NULL)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+GpuFence::~GpuFence()
+{
+#ifndef SFML_OPENGL_ES
+
+    if (m_sync)
+    {
+        TransientContextLock lock;
+
+        glCheck(GLEXT_glDeleteSync(static_cast<GLEXT_GLsync>(m_sync)));
+    }
+
+#endif
+}
+
+
+////////////////////////////////////////////////////////////
+void GpuFence::insert()
+{
+#ifndef SFML_OPENGL_ES
+
+    if (isAvailable())
+    {
+        TransientContextLock lock;
+
+        if (m_sync)
+            glCheck(GLEXT_glDeleteSync(static_cast<GLEXT_GLsync>(m_sync)));
+
+        glCheck(m_sync = GLEXT_glFenceSync(GLEXT_GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+
+        // Make sure that the fence reaches the graphics card, even if the thread
+        // issues no more commands (other threads can't flush our context)
+        glCheck(glFlush());
+
+        return;
+    }
+
+#endif
+
+    TransientContextLock lock;
+
+    // No fences: wait for the commands to complete now
+    glCheck(glFinish());
+}
+
+
+////////////////////////////////////////////////////////////
+bool GpuFence::isReady() const
+{
+    return wait(Time::Zero);
+}
+
+
+////////////////////////////////////////////////////////////
+bool GpuFence::wait(Time timeout) const
+{
+    if (!m_sync)
+        return true;
+
+#ifndef SFML_OPENGL_ES
+
+    TransientContextLock lock;
+
+    GLEXT_GLsync sync = static_cast<GLEXT_GLsync>(m_sync);
+
+    GLenum status;
+    glCheck(status = GLEXT_glClientWaitSync(sync, 0, static_cast<GLuint64>(timeout.asMicroseconds()) * 1000));
+    if ((status != GLEXT_GL_ALREADY_SIGNALED) && (status != GLEXT_GL_CONDITION_SATISFIED))
+        return false;
+
+    // Once signaled, a fence stays signaled: we don't need it anymore
+    glCheck(GLEXT_glDeleteSync(sync));
+    m_sync = NULL;
+
+#else
+
+    (void)timeout;
+
+#endif
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool GpuFence::isAvailable()
+{
+    Lock lock(isAvailableMutex);
+
+    static bool checked = false;
+    static bool available = false;
+
+    if (!checked)
+    {
+        checked = true;
+
+        TransientContextLock contextLock;
+
+        // Make sure that extensions are initialized
+        priv::ensureExtensionsInit();
+
+        available = GLEXT_sync != 0;
+    }
+
+    return available;
+}
+
+} // namespace sf
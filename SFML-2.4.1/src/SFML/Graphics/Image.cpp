@@ -26,8 +26,15 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/CompressedImage.hpp>
 #include <SFML/Graphics/ImageLoader.hpp>
+#include <SFML/Graphics/ImageView.hpp>
+#include <SFML/Graphics/PixelKernels.hpp>
 #include <SFML/System/Err.hpp>
+#include <SFML/System/FileInputStream.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/Thread.hpp>
 #ifdef SFML_SYSTEM_ANDROID
     #include <SFML/System/Android/ResourceStream.hpp>
 #endif
@@ -35,6 +42,72 @@
 #include <cstring>
 
 
+namespace
+{
+    // Shared state of the threads of Image::loadFromFiles
+    struct BatchLoader
+    {
+        const std::vector<std::string>* filenames;
+        std::vector<sf::Image>*         images;
+        std::vector<std::string>        errors;
+        std::size_t                     next;
+        std::size_t                     loaded;
+        sf::Mutex                       mutex;
+
+        void run()
+        {
+            std::vector<sf::Uint8> data;
+            std::vector<sf::Uint8> pixels;
+            for (;;)
+            {
+                // Take the next file to decode
+                std::size_t index;
+                {
+                    sf::Lock lock(mutex);
+                    if (next >= filenames->size())
+                        return;
+                    index = next++;
+                }
+
+                // Each thread writes to its own image and error, no need to lock; the
+                // errors are reported by the calling thread, sf::err() isn't thread-safe
+                const std::string& filename = (*filenames)[index];
+                std::string reason;
+                sf::Vector2u size;
+                if (!readFile(filename, data))
+                    reason = "cannot open file";
+                else if (sf::priv::ImageLoader::getInstance().decodeImage(data.empty() ? NULL : &data[0], data.size(), pixels, size, reason))
+                    (*images)[index].create(size.x, size.y, pixels.empty() ? NULL : &pixels[0]);
+
+                if (!reason.empty())
+                {
+                    errors[index] = "Failed to load image \"" + filename + "\". Reason: " + reason;
+                    continue;
+                }
+
+                sf::Lock lock(mutex);
+                loaded++;
+            }
+        }
+
+        // Read a whole file in memory, to decode it without reporting errors
+        static bool readFile(const std::string& filename, std::vector<sf::Uint8>& data)
+        {
+            sf::FileInputStream stream;
+            if (!stream.open(filename))
+                return false;
+
+            sf::Int64 size = stream.getSize();
+            if (size < 0)
+                return false;
+
+            data.resize(static_cast<std::size_t>(size));
+            return data.empty() || (stream.read(&data[0], size) == size);
+        }
+    };
+}
+
+
 namespace sf
 {
 ////////////////////////////////////////////////////////////
@@ -74,15 +147,8 @@ void Image::create(unsigned int width, unsigned int height, const Color& color)
         m_pixels.resize(width * height * 4);
 
         // Fill it with the specified color
-        Uint8* ptr = &m_pixels[0];
-        Uint8* end = ptr + m_pixels.size();
-        while (ptr < end)
-        {
-            *ptr++ = color.r;
-            *ptr++ = color.g;
-            *ptr++ = color.b;
-            *ptr++ = color.a;
-        }
+        const Uint8 components[] = {color.r, color.g, color.b, color.a};
+        priv::fillPixels(&m_pixels[0], width * height, components);
     }
     else
     {
@@ -151,10 +217,156 @@ bool Image::loadFromStream(InputStream& stream)
 }
 
 
+////////////////////////////////////////////////////////////
+std::size_t Image::loadFromFiles(const std::vector<std::string>& filenames, std::vector<Image>& images, unsigned int threadCount)
+{
+    images.clear();
+    images.resize(filenames.size());
+
+    if (threadCount == 0)
+        threadCount = Thread::getHardwareConcurrency();
+    if (threadCount > filenames.size())
+        threadCount = static_cast<unsigned int>(filenames.size());
+
+    // Make sure that the loader singleton is created before the threads use it
+    priv::ImageLoader::getInstance();
+
+    BatchLoader batch;
+    batch.filenames = &filenames;
+    batch.images    = &images;
+    batch.errors.resize(filenames.size());
+    batch.next      = 0;
+    batch.loaded    = 0;
+
+    // The calling thread takes part in the decoding
+    std::vector<Thread*> workers;
+    for (unsigned int i = 1; i < threadCount; ++i)
+    {
+        workers.push_back(new Thread(&BatchLoader::run, &batch));
+        workers.back()->launch();
+    }
+
+    batch.run();
+
+    for (std::vector<Thread*>::iterator it = workers.begin(); it != workers.end(); ++it)
+    {
+        (*it)->wait();
+        delete *it;
+    }
+
+    for (std::vector<std::string>::const_iterator it = batch.errors.begin(); it != batch.errors.end(); ++it)
+    {
+        if (!it->empty())
+            err() << *it << std::endl;
+    }
+
+    return batch.loaded;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Image::loadMipmapsFromFile(const std::string& filename, std::vector<Image>& levels)
+{
+    FileInputStream stream;
+    if (!stream.open(filename))
+    {
+        err() << "Failed to load mipmaps from file \"" << filename << "\" (cannot open file)" << std::endl;
+        return false;
+    }
+
+    return loadMipmapsFromStream(stream, levels);
+}
+
+
+////////////////////////////////////////////////////////////
+bool Image::loadMipmapsFromStream(InputStream& stream, std::vector<Image>& levels)
+{
+    priv::CompressedImage image;
+    if (!priv::loadCompressedImage(stream, image))
+        return false;
+
+    std::vector<Image> result(image.levels.size());
+    std::vector<Uint8> pixels;
+    for (std::size_t i = 0; i < image.levels.size(); ++i)
+    {
+        if (!priv::decompressImage(image, i, pixels))
+        {
+            err() << "Failed to load mipmaps, their format (0x" << std::hex << image.format << std::dec
+                  << ") cannot be decompressed" << std::endl;
+            return false;
+        }
+
+        result[i].create(std::max(image.size.x >> i, 1u), std::max(image.size.y >> i, 1u), &pixels[0]);
+    }
+
+    levels.swap(result);
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Image::saveMipmapsToFile(const std::string& filename, const std::vector<Image>& levels, bool sRgb)
+{
+    if (levels.empty() || (levels[0].m_size.x == 0) || (levels[0].m_size.y == 0))
+    {
+        err() << "Failed to save mipmaps to file \"" << filename << "\", no level provided" << std::endl;
+        return false;
+    }
+
+    priv::CompressedImage image;
+    image.format     = priv::UncompressedRgba8;
+    image.sRgb       = sRgb;
+    image.size       = levels[0].m_size;
+    image.blockSize  = Vector2u(1, 1);
+    image.blockBytes = 4;
+    image.levels.resize(levels.size());
+
+    // A chain can't go further than 1x1
+    std::size_t maxLevels = 1;
+    for (unsigned int largest = std::max(image.size.x, image.size.y); largest > 1; largest >>= 1)
+        ++maxLevels;
+    if (levels.size() > maxLevels)
+    {
+        err() << "Failed to save mipmaps to file \"" << filename << "\", too many levels (" << levels.size()
+              << ", maximum is " << maxLevels << ")" << std::endl;
+        return false;
+    }
+
+    for (std::size_t i = 0; i < levels.size(); ++i)
+    {
+        Vector2u size(std::max(image.size.x >> i, 1u), std::max(image.size.y >> i, 1u));
+        if (levels[i].m_size != size)
+        {
+            err() << "Failed to save mipmaps to file \"" << filename << "\", level " << i << " should be "
+                  << size.x << "x" << size.y << std::endl;
+            return false;
+        }
+
+        image.levels[i] = levels[i].m_pixels;
+    }
+
+    return priv::saveCompressedImage(filename, image);
+}
+
+
 ////////////////////////////////////////////////////////////
 bool Image::saveToFile(const std::string& filename) const
 {
-    return priv::ImageLoader::getInstance().saveImageToFile(filename, m_pixels, m_size);
+    return priv::ImageLoader::getInstance().saveImageToFile(filename, ImageView(*this), SaveSettings());
+}
+
+
+////////////////////////////////////////////////////////////
+bool Image::saveToFile(const std::string& filename, const SaveSettings& settings) const
+{
+    return priv::ImageLoader::getInstance().saveImageToFile(filename, ImageView(*this), settings);
+}
+
+
+////////////////////////////////////////////////////////////
+bool Image::saveToMemory(std::vector<Uint8>& output, const std::string& format, const SaveSettings& settings) const
+{
+    return priv::ImageLoader::getInstance().saveImageToMemory(format, output, ImageView(*this), settings);
 }
 
 
@@ -172,23 +384,25 @@ void Image::createMaskFromColor(const Color& color, Uint8 alpha)
     if (!m_pixels.empty())
     {
         // Replace the alpha of the pixels that match the transparent color
-        Uint8* ptr = &m_pixels[0];
-        Uint8* end = ptr + m_pixels.size();
-        while (ptr < end)
-        {
-            if ((ptr[0] == color.r) && (ptr[1] == color.g) && (ptr[2] == color.b) && (ptr[3] == color.a))
-                ptr[3] = alpha;
-            ptr += 4;
-        }
+        const Uint8 components[] = {color.r, color.g, color.b, color.a};
+        priv::maskPixels(&m_pixels[0], m_pixels.size() / 4, components, alpha);
     }
 }
 
 
 ////////////////////////////////////////////////////////////
 void Image::copy(const Image& source, unsigned int destX, unsigned int destY, const IntRect& sourceRect, bool applyAlpha)
+{
+    copy(ImageView(source), destX, destY, sourceRect, applyAlpha);
+}
+
+
+////////////////////////////////////////////////////////////
+void Image::copy(const ImageView& source, unsigned int destX, unsigned int destY, const IntRect& sourceRect, bool applyAlpha)
 {
     // Make sure that both images are valid
-    if ((source.m_size.x == 0) || (source.m_size.y == 0) || (m_size.x == 0) || (m_size.y == 0))
+    Vector2u sourceSize = source.getSize();
+    if ((sourceSize.x == 0) || (sourceSize.y == 0) || (m_size.x == 0) || (m_size.y == 0))
         return;
 
     // Adjust the source rectangle
@@ -197,15 +411,15 @@ void Image::copy(const Image& source, unsigned int destX, unsigned int destY, co
     {
         srcRect.left   = 0;
         srcRect.top    = 0;
-        srcRect.width  = source.m_size.x;
-        srcRect.height = source.m_size.y;
+        srcRect.width  = sourceSize.x;
+        srcRect.height = sourceSize.y;
     }
     else
     {
         if (srcRect.left   < 0) srcRect.left = 0;
         if (srcRect.top    < 0) srcRect.top  = 0;
-        if (srcRect.width  > static_cast<int>(source.m_size.x)) srcRect.width  = source.m_size.x;
-        if (srcRect.height > static_cast<int>(source.m_size.y)) srcRect.height = source.m_size.y;
+        if (srcRect.width  > static_cast<int>(sourceSize.x)) srcRect.width  = sourceSize.x;
+        if (srcRect.height > static_cast<int>(sourceSize.y)) srcRect.height = sourceSize.y;
     }
 
     // Then find the valid bounds of the destination rectangle
@@ -221,30 +435,18 @@ void Image::copy(const Image& source, unsigned int destX, unsigned int destY, co
     // Precompute as much as possible
     int          pitch     = width * 4;
     int          rows      = height;
-    int          srcStride = source.m_size.x * 4;
+    int          srcStride = static_cast<int>(source.getStride());
     int          dstStride = m_size.x * 4;
-    const Uint8* srcPixels = &source.m_pixels[0] + (srcRect.left + srcRect.top * source.m_size.x) * 4;
+    const Uint8* srcPixels = source.getRow(srcRect.top) + srcRect.left * 4;
     Uint8*       dstPixels = &m_pixels[0] + (destX + destY * m_size.x) * 4;
 
     // Copy the pixels
     if (applyAlpha)
     {
-        // Interpolation using alpha values, pixel by pixel (slower)
+        // Interpolation using alpha values, row by row (slower)
         for (int i = 0; i < rows; ++i)
         {
-            for (int j = 0; j < width; ++j)
-            {
-                // Get a direct pointer to the components of the current pixel
-                const Uint8* src = srcPixels + j * 4;
-                Uint8*       dst = dstPixels + j * 4;
-
-                // Interpolate RGBA components using the alpha value of the source pixel
-                Uint8 alpha = src[3];
-                dst[0] = (src[0] * alpha + dst[0] * (255 - alpha)) / 255;
-                dst[1] = (src[1] * alpha + dst[1] * (255 - alpha)) / 255;
-                dst[2] = (src[2] * alpha + dst[2] * (255 - alpha)) / 255;
-                dst[3] = alpha + dst[3] * (255 - alpha) / 255;
-            }
+            priv::blendPixels(dstPixels, srcPixels, width);
 
             srcPixels += srcStride;
             dstPixels += dstStride;
@@ -305,22 +507,54 @@ void Image::flipHorizontally()
         std::size_t rowSize = m_size.x * 4;
 
         for (std::size_t y = 0; y < m_size.y; ++y)
-        {
-            std::vector<Uint8>::iterator left = m_pixels.begin() + y * rowSize;
-            std::vector<Uint8>::iterator right = m_pixels.begin() + (y + 1) * rowSize - 4;
+            priv::reversePixels(&m_pixels[y * rowSize], m_size.x);
+    }
+}
 
-            for (std::size_t x = 0; x < m_size.x / 2; ++x)
-            {
-                std::swap_ranges(left, left + 4, right);
 
-                left += 4;
-                right -= 4;
-            }
-        }
+////////////////////////////////////////////////////////////
+void Image::createMipmaps(std::vector<Image>& levels, MipmapFilter filter, bool sRgb) const
+{
+    levels.clear();
+    if (m_pixels.empty())
+        return;
+
+    // Reserve the whole chain up front, so that references to the levels stay valid
+    std::size_t count = 1;
+    while ((std::max(m_size.x, m_size.y) >> count) > 0)
+        ++count;
+    levels.reserve(count);
+    levels.push_back(*this);
+
+    for (std::size_t i = 1; i < count; ++i)
+    {
+        levels.push_back(Image());
+        const Image& previous = levels[i - 1];
+        Image& level = levels[i];
+        level.m_size.x = std::max(previous.m_size.x / 2, 1u);
+        level.m_size.y = std::max(previous.m_size.y / 2, 1u);
+        level.m_pixels.resize(level.m_size.x * level.m_size.y * 4);
+
+        if (filter == KaiserFilter)
+            priv::downsampleKaiser(&previous.m_pixels[0], previous.m_size.x, previous.m_size.y, &level.m_pixels[0], sRgb);
+        else
+            priv::downsampleBox(&previous.m_pixels[0], previous.m_size.x, previous.m_size.y, &level.m_pixels[0], sRgb);
     }
 }
 
 
+////////////////////////////////////////////////////////////
+void Image::swap(Image& right)
+{
+    std::swap(m_size,   right.m_size);
+    std::swap(m_pixels, right.m_pixels);
+
+    #ifdef SFML_SYSTEM_ANDROID
+        std::swap(m_stream, right.m_stream);
+    #endif
+}
+
+
 ////////////////////////////////////////////////////////////
 void Image::flipVertically()
 {
@@ -328,12 +562,12 @@ void Image::flipVertically()
     {
         std::size_t rowSize = m_size.x * 4;
 
-        std::vector<Uint8>::iterator top = m_pixels.begin();
-        std::vector<Uint8>::iterator bottom = m_pixels.end() - rowSize;
+        Uint8* top = &m_pixels[0];
+        Uint8* bottom = &m_pixels[0] + m_pixels.size() - rowSize;
 
         for (std::size_t y = 0; y < m_size.y / 2; ++y)
         {
-            std::swap_ranges(top, top + rowSize, bottom);
+            priv::swapBytes(top, bottom, rowSize);
 
             top += rowSize;
             bottom -= rowSize;
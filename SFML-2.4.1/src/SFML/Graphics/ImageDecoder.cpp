@@ -0,0 +1,446 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2016 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/ImageDecoder.hpp>
+#include <SFML/Graphics/ImageLoader.hpp>
+#include <SFML/System/InputStream.hpp>
+#include <SFML/System/Err.hpp>
+#include <algorithm>
+#include <csetjmp>
+#include <cstdio>
+#include <cstring>
+extern "C"
+{
+    #include <jpeglib.h>
+    #include <jerror.h>
+}
+
+
+namespace
+{
+    ////////////////////////////////////////////////////////////
+    // State of a JPEG decoding in progress
+    ////////////////////////////////////////////////////////////
+    struct JpegState
+    {
+        enum Phase
+        {
+            Header,
+            Start,
+            Scanlines
+        };
+
+        jpeg_decompress_struct info;
+        jpeg_error_mgr         error;
+        jmp_buf                jump;
+        jpeg_source_mgr        source;
+        Phase                  phase;
+        std::size_t            skip;   // Bytes to skip that were not fed yet
+        bool*                  closed; // Has the input been closed?
+        std::vector<JSAMPLE>   rows;   // RGB scanlines returned by libjpeg
+    };
+
+    JpegState& getState(j_decompress_ptr info)
+    {
+        return *static_cast<JpegState*>(info->client_data);
+    }
+
+    ////////////////////////////////////////////////////////////
+    // libjpeg callbacks
+    ////////////////////////////////////////////////////////////
+    void errorExit(j_common_ptr info)
+    {
+        char message[JMSG_LENGTH_MAX];
+        (*info->err->format_message)(info, message);
+        sf::err() << "Failed to decode JPEG image. Reason: " << message << std::endl;
+
+        // Return to decodeJpeg, libjpeg must not continue after an error
+        longjmp(static_cast<JpegState*>(info->client_data)->jump, 1);
+    }
+
+    void outputMessage(j_common_ptr)
+    {
+        // Warnings (corrupt data that could be decoded anyway) are ignored
+    }
+
+    void initSource(j_decompress_ptr)
+    {
+    }
+
+    boolean fillInputBuffer(j_decompress_ptr info)
+    {
+        JpegState& state = getState(info);
+        if (!*state.closed)
+            return FALSE; // suspend until more data is fed
+
+        // The file is truncated: insert a fake end of image marker, like the standard sources do
+        static const JOCTET endOfImage[2] = {0xFF, JPEG_EOI};
+        WARNMS(info, JWRN_JPEG_EOF);
+        state.source.next_input_byte = endOfImage;
+        state.source.bytes_in_buffer = 2;
+        return TRUE;
+    }
+
+    void skipInputData(j_decompress_ptr info, long count)
+    {
+        JpegState& state = getState(info);
+        if (count <= 0)
+            return;
+
+        std::size_t size = static_cast<std::size_t>(count);
+        if (size <= state.source.bytes_in_buffer)
+        {
+            state.source.next_input_byte += size;
+            state.source.bytes_in_buffer -= size;
+        }
+        else
+        {
+            // Skip the rest when it arrives
+            state.skip += size - state.source.bytes_in_buffer;
+            state.source.next_input_byte += state.source.bytes_in_buffer;
+            state.source.bytes_in_buffer = 0;
+        }
+    }
+
+    void termSource(j_decompress_ptr)
+    {
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+ImageDecoder::ImageDecoder() :
+m_input  (),
+m_closed (false),
+m_status (NeedMoreData),
+m_region (),
+m_image  (),
+m_rows   (0),
+m_bandTop(0),
+m_jpeg   (NULL)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+ImageDecoder::~ImageDecoder()
+{
+    reset();
+}
+
+
+////////////////////////////////////////////////////////////
+void ImageDecoder::setRegion(const IntRect& region)
+{
+    m_region = region;
+}
+
+
+////////////////////////////////////////////////////////////
+void ImageDecoder::reset()
+{
+    if (m_jpeg)
+    {
+        JpegState* state = static_cast<JpegState*>(m_jpeg);
+        jpeg_destroy_decompress(&state->info);
+        delete state;
+        m_jpeg = NULL;
+    }
+
+    m_input.clear();
+    m_closed  = false;
+    m_status  = NeedMoreData;
+    m_region  = IntRect();
+    m_image   = Image();
+    m_rows    = 0;
+    m_bandTop = 0;
+}
+
+
+////////////////////////////////////////////////////////////
+void ImageDecoder::feed(const void* data, std::size_t size)
+{
+    if (!data || (size == 0) || m_closed)
+        return;
+
+    const Uint8* bytes = static_cast<const Uint8*>(data);
+
+    if (m_jpeg)
+    {
+        // Drop the data already consumed by libjpeg
+        JpegState& state = *static_cast<JpegState*>(m_jpeg);
+        std::size_t consumed = m_input.size() - state.source.bytes_in_buffer;
+        m_input.erase(m_input.begin(), m_input.begin() + consumed);
+
+        // Skip the data that libjpeg asked to skip before it arrived
+        std::size_t skipped = std::min(state.skip, size);
+        state.skip -= skipped;
+        bytes += skipped;
+        size -= skipped;
+    }
+
+    m_input.insert(m_input.end(), bytes, bytes + size);
+
+    if (m_jpeg)
+    {
+        // The buffer may have moved
+        JpegState& state = *static_cast<JpegState*>(m_jpeg);
+        state.source.next_input_byte = m_input.empty() ? NULL : &m_input[0];
+        state.source.bytes_in_buffer = m_input.size();
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t ImageDecoder::feed(InputStream& stream, std::size_t size)
+{
+    std::vector<Uint8> buffer(size);
+    Int64 read = size > 0 ? stream.read(&buffer[0], size) : 0;
+    if (read > 0)
+        feed(&buffer[0], static_cast<std::size_t>(read));
+
+    if (read < static_cast<Int64>(size))
+        close();
+
+    return read > 0 ? static_cast<std::size_t>(read) : 0;
+}
+
+
+////////////////////////////////////////////////////////////
+void ImageDecoder::close()
+{
+    m_closed = true;
+}
+
+
+////////////////////////////////////////////////////////////
+ImageDecoder::Status ImageDecoder::decode()
+{
+    if (m_status != NeedMoreData)
+        return m_status;
+
+    // The format is recognized from the first bytes, JPEG files start with a SOI marker
+    if (!m_jpeg && (m_input.size() >= 3) && (m_input[0] == 0xFF) && (m_input[1] == 0xD8) && (m_input[2] == 0xFF))
+    {
+        JpegState* state = new JpegState;
+        state->info.err            = jpeg_std_error(&state->error);
+        state->error.error_exit     = &errorExit;
+        state->error.output_message = &outputMessage;
+        jpeg_create_decompress(&state->info);
+        state->info.client_data = state;
+
+        state->source.init_source       = &initSource;
+        state->source.fill_input_buffer = &fillInputBuffer;
+        state->source.skip_input_data   = &skipInputData;
+        state->source.resync_to_restart = &jpeg_resync_to_restart;
+        state->source.term_source       = &termSource;
+        state->source.next_input_byte   = &m_input[0];
+        state->source.bytes_in_buffer   = m_input.size();
+        state->info.src                 = &state->source;
+
+        state->phase  = JpegState::Header;
+        state->skip   = 0;
+        state->closed = &m_closed;
+
+        m_jpeg = state;
+    }
+
+    if (m_jpeg)
+        m_status = decodeJpeg();
+    else if (m_closed)
+        m_status = decodeWhole();
+
+    return m_status;
+}
+
+
+////////////////////////////////////////////////////////////
+Vector2u ImageDecoder::getSize() const
+{
+    return m_image.getSize();
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int ImageDecoder::getDecodedRows() const
+{
+    return m_rows;
+}
+
+
+////////////////////////////////////////////////////////////
+bool ImageDecoder::getNextBand(ImageView& band, unsigned int& top)
+{
+    if (m_bandTop >= m_rows)
+        return false;
+
+    unsigned int width = m_image.getSize().x;
+    band = ImageView(m_image.getPixelsPtr() + m_bandTop * width * 4, width, m_rows - m_bandTop);
+    top = m_bandTop;
+    m_bandTop = m_rows;
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+const Image& ImageDecoder::getImage() const
+{
+    return m_image;
+}
+
+
+////////////////////////////////////////////////////////////
+ImageDecoder::Status ImageDecoder::decodeJpeg()
+{
+    JpegState& state = *static_cast<JpegState*>(m_jpeg);
+    jpeg_decompress_struct& info = state.info;
+
+    // libjpeg reports errors with a long jump: no local object with a destructor may live in this function
+    if (setjmp(state.jump))
+        return Error;
+
+    if (state.phase == JpegState::Header)
+    {
+        if (jpeg_read_header(&info, TRUE) == JPEG_SUSPENDED)
+            return NeedMoreData;
+
+        info.out_color_space = JCS_RGB;
+        allocate(info.image_width, info.image_height);
+        if (m_image.getSize().x == 0)
+        {
+            err() << "Failed to decode JPEG image, the region to decode is empty" << std::endl;
+            return Error;
+        }
+
+        state.phase = JpegState::Start;
+    }
+
+    if (state.phase == JpegState::Start)
+    {
+        // Progressive files are entirely buffered by this call, their rows only come at the end
+        if (!jpeg_start_decompress(&info))
+            return NeedMoreData;
+
+        state.rows.resize(info.output_width * info.output_components * info.rec_outbuf_height);
+        state.phase = JpegState::Scanlines;
+    }
+
+    // Decode the scanlines, up to the last row of the region
+    unsigned int last = static_cast<unsigned int>(m_region.top) + m_image.getSize().y;
+    while (info.output_scanline < last)
+    {
+        JSAMPROW rows[16];
+        int count = std::min(info.rec_outbuf_height, 16);
+        for (int i = 0; i < count; ++i)
+            rows[i] = &state.rows[i * info.output_width * info.output_components];
+
+        JDIMENSION first = info.output_scanline;
+        JDIMENSION read = jpeg_read_scanlines(&info, rows, count);
+        if (read == 0)
+            return NeedMoreData;
+
+        // Keep the rows and columns of the region, and add the alpha channel
+        for (JDIMENSION i = 0; i < read; ++i)
+        {
+            unsigned int y = first + i;
+            if ((y < static_cast<unsigned int>(m_region.top)) || (y >= last))
+                continue;
+
+            const JSAMPLE* source = rows[i] + m_region.left * 3;
+            Uint8* destination = &m_image.m_pixels[(y - m_region.top) * m_image.m_size.x * 4];
+            for (unsigned int x = 0; x < m_image.m_size.x; ++x)
+            {
+                destination[x * 4 + 0] = source[x * 3 + 0];
+                destination[x * 4 + 1] = source[x * 3 + 1];
+                destination[x * 4 + 2] = source[x * 3 + 2];
+                destination[x * 4 + 3] = 255;
+            }
+
+            m_rows = y - m_region.top + 1;
+        }
+    }
+
+    // The rest of the file is not needed
+    jpeg_abort_decompress(&info);
+
+    return Complete;
+}
+
+
+////////////////////////////////////////////////////////////
+ImageDecoder::Status ImageDecoder::decodeWhole()
+{
+    if (m_input.empty())
+    {
+        err() << "Failed to decode image, no data provided" << std::endl;
+        return Error;
+    }
+
+    std::vector<Uint8> pixels;
+    Vector2u size;
+    if (!priv::ImageLoader::getInstance().loadImageFromMemory(&m_input[0], m_input.size(), pixels, size))
+        return Error;
+
+    std::vector<Uint8>().swap(m_input);
+
+    allocate(size.x, size.y);
+    if (m_image.getSize().x == 0)
+    {
+        err() << "Failed to decode image, the region to decode is empty" << std::endl;
+        return Error;
+    }
+
+    // Take the pixels as they are when the whole image is decoded, otherwise copy the region
+    if (m_image.getSize() == size)
+        m_image.m_pixels.swap(pixels);
+    else
+        m_image.copy(ImageView(&pixels[0], size.x, size.y).getSubView(m_region), 0, 0);
+
+    m_rows = m_image.getSize().y;
+
+    return Complete;
+}
+
+
+////////////////////////////////////////////////////////////
+void ImageDecoder::allocate(unsigned int width, unsigned int height)
+{
+    // Clamp the region to the image
+    IntRect bounds(0, 0, static_cast<int>(width), static_cast<int>(height));
+    if ((m_region.width == 0) || (m_region.height == 0))
+        m_region = bounds;
+    else if (!m_region.intersects(bounds, m_region))
+        m_region = IntRect();
+
+    m_image.create(m_region.width, m_region.height, Color::Transparent);
+}
+
+} // namespace sf
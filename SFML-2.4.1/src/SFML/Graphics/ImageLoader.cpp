@@ -37,7 +37,11 @@ extern "C"
     #include <jpeglib.h>
     #include <jerror.h>
 }
+#include <algorithm>
 #include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
 
 
 namespace
@@ -66,8 +70,382 @@ namespace
         sf::InputStream* stream = static_cast<sf::InputStream*>(user);
         return stream->tell() >= stream->getSize();
     }
-}
 
+    // Get the reason of the last stb_image failure in the calling thread
+    std::string getFailureReason()
+    {
+        const char* reason = stbi_failure_reason();
+        return reason ? reason : "unknown error";
+    }
+
+    // Append integers to an encoded buffer
+    void writeBigEndian(std::vector<sf::Uint8>& output, sf::Uint32 value)
+    {
+        output.push_back(static_cast<sf::Uint8>(value >> 24));
+        output.push_back(static_cast<sf::Uint8>(value >> 16));
+        output.push_back(static_cast<sf::Uint8>(value >> 8));
+        output.push_back(static_cast<sf::Uint8>(value));
+    }
+    void writeLittleEndian(std::vector<sf::Uint8>& output, sf::Uint32 value, std::size_t bytes)
+    {
+        for (std::size_t i = 0; i < bytes; ++i)
+            output.push_back(static_cast<sf::Uint8>(value >> (i * 8)));
+    }
+
+    // CRC-32 of the PNG chunks; the table is built during static initialization
+    // so that encoders running in parallel never race on it
+    struct CrcTable
+    {
+        CrcTable()
+        {
+            for (sf::Uint32 i = 0; i < 256; ++i)
+            {
+                sf::Uint32 crc = i;
+                for (int j = 0; j < 8; ++j)
+                    crc = (crc >> 1) ^ ((crc & 1) ? 0xEDB88320 : 0);
+                values[i] = crc;
+            }
+        }
+
+        sf::Uint32 values[256];
+    };
+    const CrcTable crcTable;
+
+    // Append a PNG chunk, the data starts at the given offset of the buffer
+    void writePngChunk(std::vector<sf::Uint8>& output, const char* type, const sf::Uint8* data, std::size_t size)
+    {
+        writeBigEndian(output, static_cast<sf::Uint32>(size));
+        output.insert(output.end(), type, type + 4);
+        output.insert(output.end(), data, data + size);
+
+        sf::Uint32 crc = 0xFFFFFFFF;
+        for (std::size_t i = output.size() - size - 4; i < output.size(); ++i)
+            crc = (crc >> 8) ^ crcTable.values[(crc ^ output[i]) & 0xFF];
+        writeBigEndian(output, ~crc);
+    }
+
+    // Paeth predictor of the PNG filters
+    sf::Uint8 paeth(int a, int b, int c)
+    {
+        int p  = a + b - c;
+        int pa = std::abs(p - a);
+        int pb = std::abs(p - b);
+        int pc = std::abs(p - c);
+        if ((pa <= pb) && (pa <= pc))
+            return static_cast<sf::Uint8>(a);
+        else if (pb <= pc)
+            return static_cast<sf::Uint8>(b);
+        else
+            return static_cast<sf::Uint8>(c);
+    }
+
+    // Apply a PNG filter to a row of RGBA pixels (previous is NULL for the first row)
+    void filterPngRow(int filter, const sf::Uint8* row, const sf::Uint8* previous, std::size_t size, sf::Uint8* output)
+    {
+        switch (filter)
+        {
+            case 0:
+                std::memcpy(output, row, size);
+                break;
+
+            case 1:
+                std::memcpy(output, row, 4);
+                for (std::size_t i = 4; i < size; ++i)
+                    output[i] = static_cast<sf::Uint8>(row[i] - row[i - 4]);
+                break;
+
+            case 2:
+                for (std::size_t i = 0; i < size; ++i)
+                    output[i] = static_cast<sf::Uint8>(row[i] - (previous ? previous[i] : 0));
+                break;
+
+            case 3:
+                for (std::size_t i = 0; i < size; ++i)
+                {
+                    int left  = (i >= 4) ? row[i - 4] : 0;
+                    int above = previous ? previous[i] : 0;
+                    output[i] = static_cast<sf::Uint8>(row[i] - ((left + above) >> 1));
+                }
+                break;
+
+            case 4:
+                for (std::size_t i = 0; i < size; ++i)
+                {
+                    int left      = (i >= 4) ? row[i - 4] : 0;
+                    int above     = previous ? previous[i] : 0;
+                    int aboveLeft = (previous && (i >= 4)) ? previous[i - 4] : 0;
+                    output[i] = static_cast<sf::Uint8>(row[i] - paeth(left, above, aboveLeft));
+                }
+                break;
+        }
+    }
+
+    // Encode an image in PNG format
+    bool encodePng(std::vector<sf::Uint8>& output, const sf::Uint8* pixels, unsigned int width, unsigned int height, std::size_t stride, const sf::Image::SaveSettings& settings)
+    {
+        // Filter the rows, each one is preceded by its filter type
+        std::size_t rowSize = width * 4;
+        std::vector<sf::Uint8> filtered((rowSize + 1) * height);
+        std::vector<sf::Uint8> candidate(settings.pngFilter == sf::Image::SaveSettings::PngFilterAdaptive ? rowSize : 0);
+        for (unsigned int y = 0; y < height; ++y)
+        {
+            const sf::Uint8* row      = pixels + y * stride;
+            const sf::Uint8* previous = (y > 0) ? row - stride : NULL;
+            sf::Uint8*       line     = &filtered[y * (rowSize + 1)];
+
+            if (settings.pngFilter != sf::Image::SaveSettings::PngFilterAdaptive)
+            {
+                line[0] = static_cast<sf::Uint8>(settings.pngFilter);
+                filterPngRow(line[0], row, previous, rowSize, line + 1);
+            }
+            else
+            {
+                // Keep the filter that gives the smallest sum of absolute differences,
+                // which is usually the one that compresses best
+                unsigned long bestSum = static_cast<unsigned long>(-1);
+                for (int filter = 0; filter < 5; ++filter)
+                {
+                    filterPngRow(filter, row, previous, rowSize, &candidate[0]);
+
+                    unsigned long sum = 0;
+                    for (std::size_t i = 0; i < rowSize; ++i)
+                        sum += static_cast<unsigned long>(std::abs(static_cast<signed char>(candidate[i])));
+
+                    if (sum < bestSum)
+                    {
+                        bestSum = sum;
+                        line[0] = static_cast<sf::Uint8>(filter);
+                        std::memcpy(line + 1, &candidate[0], rowSize);
+                    }
+                }
+            }
+        }
+
+        // Compress the filtered rows in a zlib stream
+        std::vector<sf::Uint8> compressed;
+        if (settings.pngCompressionLevel == 0)
+        {
+            // Level 0 stores the data in uncompressed deflate blocks
+            compressed.reserve(filtered.size() + filtered.size() / 65535 * 5 + 11);
+            compressed.push_back(0x78);
+            compressed.push_back(0x01);
+
+            std::size_t offset = 0;
+            do
+            {
+                std::size_t size = std::min<std::size_t>(filtered.size() - offset, 65535);
+                compressed.push_back(offset + size == filtered.size() ? 1 : 0);
+                writeLittleEndian(compressed, static_cast<sf::Uint32>(size), 2);
+                writeLittleEndian(compressed, static_cast<sf::Uint32>(~size), 2);
+                compressed.insert(compressed.end(), filtered.begin() + offset, filtered.begin() + offset + size);
+                offset += size;
+            }
+            while (offset < filtered.size());
+
+            sf::Uint32 a = 1;
+            sf::Uint32 b = 0;
+            for (std::size_t i = 0; i < filtered.size(); ++i)
+            {
+                a = (a + filtered[i]) % 65521;
+                b = (b + a) % 65521;
+            }
+            writeBigEndian(compressed, (b << 16) | a);
+        }
+        else
+        {
+            // The compression level controls the length of the hash chains searched for matches
+            static const int qualities[10] = {0, 5, 5, 6, 6, 7, 8, 12, 16, 32};
+            int quality = qualities[std::min(settings.pngCompressionLevel, 9u)];
+
+            int size = 0;
+            unsigned char* data = stbi_zlib_compress(&filtered[0], static_cast<int>(filtered.size()), &size, quality);
+            if (!data)
+                return false;
+
+            compressed.assign(data, data + size);
+            std::free(data);
+        }
+
+        // Assemble the file
+        static const sf::Uint8 signature[8] = {137, 80, 78, 71, 13, 10, 26, 10};
+        sf::Uint8 header[13] = {0};
+        header[0] = static_cast<sf::Uint8>(width >> 24);
+        header[1] = static_cast<sf::Uint8>(width >> 16);
+        header[2] = static_cast<sf::Uint8>(width >> 8);
+        header[3] = static_cast<sf::Uint8>(width);
+        header[4] = static_cast<sf::Uint8>(height >> 24);
+        header[5] = static_cast<sf::Uint8>(height >> 16);
+        header[6] = static_cast<sf::Uint8>(height >> 8);
+        header[7] = static_cast<sf::Uint8>(height);
+        header[8] = 8; // bits per channel
+        header[9] = 6; // RGBA
+
+        output.clear();
+        output.reserve(compressed.size() + 57);
+        output.insert(output.end(), signature, signature + 8);
+        writePngChunk(output, "IHDR", header, sizeof(header));
+        writePngChunk(output, "IDAT", &compressed[0], compressed.size());
+        writePngChunk(output, "IEND", NULL, 0);
+
+        return true;
+    }
+
+    // libjpeg destination manager that writes to a vector
+    struct JpegDestination
+    {
+        jpeg_destination_mgr    manager;
+        std::vector<sf::Uint8>* output;
+        JOCTET                  buffer[16384];
+    };
+    void initDestination(j_compress_ptr compressInfos)
+    {
+        JpegDestination* destination = reinterpret_cast<JpegDestination*>(compressInfos->dest);
+        destination->manager.next_output_byte = destination->buffer;
+        destination->manager.free_in_buffer   = sizeof(destination->buffer);
+    }
+    boolean emptyOutputBuffer(j_compress_ptr compressInfos)
+    {
+        JpegDestination* destination = reinterpret_cast<JpegDestination*>(compressInfos->dest);
+        destination->output->insert(destination->output->end(), destination->buffer, destination->buffer + sizeof(destination->buffer));
+        initDestination(compressInfos);
+        return TRUE;
+    }
+    void termDestination(j_compress_ptr compressInfos)
+    {
+        JpegDestination* destination = reinterpret_cast<JpegDestination*>(compressInfos->dest);
+        std::size_t size = sizeof(destination->buffer) - destination->manager.free_in_buffer;
+        destination->output->insert(destination->output->end(), destination->buffer, destination->buffer + size);
+    }
+
+    // Encode an image in JPEG format
+    bool encodeJpg(std::vector<sf::Uint8>& output, const sf::Uint8* pixels, unsigned int width, unsigned int height, std::size_t stride, const sf::Image::SaveSettings& settings)
+    {
+        output.clear();
+
+        JpegDestination destination;
+        destination.manager.init_destination    = &initDestination;
+        destination.manager.empty_output_buffer = &emptyOutputBuffer;
+        destination.manager.term_destination    = &termDestination;
+        destination.output                      = &output;
+
+        // Initialize the error handler
+        jpeg_compress_struct compressInfos;
+        jpeg_error_mgr errorManager;
+        compressInfos.err = jpeg_std_error(&errorManager);
+
+        // Initialize all the writing and compression infos
+        jpeg_create_compress(&compressInfos);
+        compressInfos.image_width      = width;
+        compressInfos.image_height     = height;
+        compressInfos.input_components = 3;
+        compressInfos.in_color_space   = JCS_RGB;
+        compressInfos.dest             = &destination.manager;
+        jpeg_set_defaults(&compressInfos);
+        jpeg_set_quality(&compressInfos, std::max(1, std::min(static_cast<int>(settings.jpgQuality), 100)), TRUE);
+
+        // The luminance sampling factors define the resolution of the chroma channels
+        compressInfos.comp_info[0].h_samp_factor = (settings.jpgSubsampling == sf::Image::SaveSettings::Subsampling444) ? 1 : 2;
+        compressInfos.comp_info[0].v_samp_factor = (settings.jpgSubsampling == sf::Image::SaveSettings::Subsampling420) ? 2 : 1;
+
+        // Get rid of the alpha channel
+        std::vector<sf::Uint8> buffer(width * height * 3);
+        for (unsigned int y = 0; y < height; ++y)
+        {
+            const sf::Uint8* source = pixels + y * stride;
+            sf::Uint8* destination = &buffer[y * width * 3];
+            for (unsigned int x = 0; x < width; ++x)
+            {
+                destination[x * 3 + 0] = source[x * 4 + 0];
+                destination[x * 3 + 1] = source[x * 4 + 1];
+                destination[x * 3 + 2] = source[x * 4 + 2];
+            }
+        }
+
+        std::vector<JSAMPROW> rows(height);
+        for (unsigned int i = 0; i < height; ++i)
+            rows[i] = &buffer[i * width * 3];
+
+        // Start compression
+        jpeg_start_compress(&compressInfos, TRUE);
+
+        // Write the rows, as many as possible at once
+        while (compressInfos.next_scanline < compressInfos.image_height)
+            jpeg_write_scanlines(&compressInfos, &rows[compressInfos.next_scanline], compressInfos.image_height - compressInfos.next_scanline);
+
+        // Finish compression
+        jpeg_finish_compress(&compressInfos);
+        jpeg_destroy_compress(&compressInfos);
+
+        return true;
+    }
+
+    // Encode an image in BMP format (24 bits, the alpha channel is lost)
+    bool encodeBmp(std::vector<sf::Uint8>& output, const sf::Uint8* pixels, unsigned int width, unsigned int height, std::size_t stride)
+    {
+        // Rows are stored bottom to top and padded to 4 bytes
+        std::size_t pitch = (width * 3 + 3) & ~static_cast<std::size_t>(3);
+        std::size_t dataSize = pitch * height;
+
+        output.clear();
+        output.reserve(54 + dataSize);
+        output.push_back('B');
+        output.push_back('M');
+        writeLittleEndian(output, static_cast<sf::Uint32>(54 + dataSize), 4); // file size
+        writeLittleEndian(output, 0, 4);                                       // reserved
+        writeLittleEndian(output, 54, 4);                                      // offset of the pixels
+        writeLittleEndian(output, 40, 4);                                      // size of the info header
+        writeLittleEndian(output, width, 4);
+        writeLittleEndian(output, height, 4);
+        writeLittleEndian(output, 1, 2);                                       // planes
+        writeLittleEndian(output, 24, 2);                                      // bits per pixel
+        writeLittleEndian(output, 0, 4);                                       // no compression
+        writeLittleEndian(output, static_cast<sf::Uint32>(dataSize), 4);
+        writeLittleEndian(output, 0, 16);                                      // resolution and palette
+
+        output.resize(54 + dataSize, 0);
+        for (unsigned int y = 0; y < height; ++y)
+        {
+            const sf::Uint8* source = pixels + (height - 1 - y) * stride;
+            sf::Uint8* destination = &output[54 + y * pitch];
+            for (unsigned int x = 0; x < width; ++x)
+            {
+                destination[x * 3 + 0] = source[x * 4 + 2];
+                destination[x * 3 + 1] = source[x * 4 + 1];
+                destination[x * 3 + 2] = source[x * 4 + 0];
+            }
+        }
+
+        return true;
+    }
+
+    // Encode an image in TGA format (32 bits, uncompressed)
+    bool encodeTga(std::vector<sf::Uint8>& output, const sf::Uint8* pixels, unsigned int width, unsigned int height, std::size_t stride)
+    {
+        output.clear();
+        output.reserve(18 + width * height * 4);
+        writeLittleEndian(output, 0, 2);      // no identifier, no color map
+        output.push_back(2);                  // uncompressed true-color
+        writeLittleEndian(output, 0, 9);      // color map and origin
+        writeLittleEndian(output, width, 2);
+        writeLittleEndian(output, height, 2);
+        output.push_back(32);                 // bits per pixel
+        output.push_back(0x28);               // 8 alpha bits, rows stored top to bottom
+
+        for (unsigned int y = 0; y < height; ++y)
+        {
+            const sf::Uint8* row = pixels + y * stride;
+            for (unsigned int x = 0; x < width; ++x)
+            {
+                output.push_back(row[x * 4 + 2]);
+                output.push_back(row[x * 4 + 1]);
+                output.push_back(row[x * 4 + 0]);
+                output.push_back(row[x * 4 + 3]);
+            }
+        }
+
+        return true;
+    }
+}
 
 namespace sf
 {
@@ -85,7 +463,10 @@ ImageLoader& ImageLoader::getInstance()
 ////////////////////////////////////////////////////////////
 ImageLoader::ImageLoader()
 {
-    // Nothing to do
+    // stb_image builds the fixed zlib tables on their first use, which
+    // isn't thread-safe; build them up front so that images can be decoded
+    // concurrently (the failure reason is thread-local in our copy of stb_image)
+    stbi__init_zdefaults();
 }
 
 
@@ -129,7 +510,7 @@ bool ImageLoader::loadImageFromFile(const std::string& filename, std::vector<Uin
     else
     {
         // Error, failed to load the image
-        err() << "Failed to load image \"" << filename << "\". Reason: " << stbi_failure_reason() << std::endl;
+        err() << "Failed to load image \"" << filename << "\". Reason: " << getFailureReason() << std::endl;
 
         return false;
     }
@@ -142,41 +523,14 @@ bool ImageLoader::loadImageFromMemory(const void* data, std::size_t dataSize, st
     // Check input parameters
     if (data && dataSize)
     {
-        // Clear the array (just in case)
-        pixels.clear();
-
-        // Load the image and get a pointer to the pixels in memory
-        int width = 0;
-        int height = 0;
-        int channels = 0;
-        const unsigned char* buffer = static_cast<const unsigned char*>(data);
-        unsigned char* ptr = stbi_load_from_memory(buffer, static_cast<int>(dataSize), &width, &height, &channels, STBI_rgb_alpha);
-
-        if (ptr)
-        {
-            // Assign the image properties
-            size.x = width;
-            size.y = height;
-
-            if (width && height)
-            {
-                // Copy the loaded pixels to the pixel buffer
-                pixels.resize(width * height * 4);
-                memcpy(&pixels[0], ptr, pixels.size());
-            }
-
-            // Free the loaded pixels (they are now in our own pixel buffer)
-            stbi_image_free(ptr);
-
+        std::string reason;
+        if (decodeImage(data, dataSize, pixels, size, reason))
             return true;
-        }
-        else
-        {
-            // Error, failed to load the image
-            err() << "Failed to load image from memory. Reason: " << stbi_failure_reason() << std::endl;
 
-            return false;
-        }
+        // Error, failed to load the image
+        err() << "Failed to load image from memory. Reason: " << reason << std::endl;
+
+        return false;
     }
     else
     {
@@ -228,7 +582,7 @@ bool ImageLoader::loadImageFromStream(InputStream& stream, std::vector<Uint8>& p
     else
     {
         // Error, failed to load the image
-        err() << "Failed to load image from stream. Reason: " << stbi_failure_reason() << std::endl;
+        err() << "Failed to load image from stream. Reason: " << getFailureReason() << std::endl;
 
         return false;
     }
@@ -236,101 +590,113 @@ bool ImageLoader::loadImageFromStream(InputStream& stream, std::vector<Uint8>& p
 
 
 ////////////////////////////////////////////////////////////
-bool ImageLoader::saveImageToFile(const std::string& filename, const std::vector<Uint8>& pixels, const Vector2u& size)
+bool ImageLoader::decodeImage(const void* data, std::size_t dataSize, std::vector<Uint8>& pixels, Vector2u& size, std::string& reason)
 {
-    // Make sure the image is not empty
-    if (!pixels.empty() && (size.x > 0) && (size.y > 0))
+    // Clear the array (just in case)
+    pixels.clear();
+
+    if (!data || !dataSize)
+    {
+        reason = "no data provided";
+        return false;
+    }
+
+    // Load the image and get a pointer to the pixels in memory
+    int width = 0;
+    int height = 0;
+    int channels = 0;
+    const unsigned char* buffer = static_cast<const unsigned char*>(data);
+    unsigned char* ptr = stbi_load_from_memory(buffer, static_cast<int>(dataSize), &width, &height, &channels, STBI_rgb_alpha);
+    if (!ptr)
+    {
+        reason = getFailureReason();
+        return false;
+    }
+
+    // Assign the image properties
+    size.x = width;
+    size.y = height;
+
+    if (width && height)
     {
-        // Deduce the image type from its extension
+        // Copy the loaded pixels to the pixel buffer
+        pixels.resize(width * height * 4);
+        memcpy(&pixels[0], ptr, pixels.size());
+    }
+
+    // Free the loaded pixels (they are now in our own pixel buffer)
+    stbi_image_free(ptr);
+
+    return true;
+}
+
 
-        // Extract the extension
-        const std::size_t dot = filename.find_last_of('.');
-        const std::string extension = dot != std::string::npos ? toLower(filename.substr(dot + 1)) : "";
+////////////////////////////////////////////////////////////
+bool ImageLoader::saveImageToFile(const std::string& filename, const ImageView& image, const Image::SaveSettings& settings)
+{
+    // Deduce the image type from its extension
+    const std::size_t dot = filename.find_last_of('.');
+    const std::string extension = dot != std::string::npos ? filename.substr(dot + 1) : "";
+
+    // Encode the image in memory, then write it in one go
+    std::vector<Uint8> buffer;
+    if (saveImageToMemory(extension, buffer, image, settings))
+    {
+        FILE* file = std::fopen(filename.c_str(), "wb");
+        if (file)
+        {
+            bool written = std::fwrite(&buffer[0], 1, buffer.size(), file) == buffer.size();
+            if ((std::fclose(file) == 0) && written)
+                return true;
+        }
+    }
+
+    err() << "Failed to save image \"" << filename << "\"" << std::endl;
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+bool ImageLoader::saveImageToMemory(const std::string& format, std::vector<Uint8>& output, const ImageView& image, const Image::SaveSettings& settings)
+{
+    // Make sure the image is not empty
+    const Uint8* pixels = image.getPixelsPtr();
+    Vector2u size = image.getSize();
+    std::size_t stride = image.getStride();
+    if (pixels && (size.x > 0) && (size.y > 0))
+    {
+        const std::string specified = toLower(format);
 
-        if (extension == "bmp")
+        if (specified == "bmp")
         {
             // BMP format
-            if (stbi_write_bmp(filename.c_str(), size.x, size.y, 4, &pixels[0]))
+            if (encodeBmp(output, pixels, size.x, size.y, stride))
                 return true;
         }
-        else if (extension == "tga")
+        else if (specified == "tga")
         {
             // TGA format
-            if (stbi_write_tga(filename.c_str(), size.x, size.y, 4, &pixels[0]))
+            if (encodeTga(output, pixels, size.x, size.y, stride))
                 return true;
         }
-        else if (extension == "png")
+        else if (specified == "png")
         {
             // PNG format
-            if (stbi_write_png(filename.c_str(), size.x, size.y, 4, &pixels[0], 0))
+            if (encodePng(output, pixels, size.x, size.y, stride, settings))
                 return true;
         }
-        else if (extension == "jpg" || extension == "jpeg")
+        else if (specified == "jpg" || specified == "jpeg")
         {
             // JPG format
-            if (writeJpg(filename, pixels, size.x, size.y))
+            if (encodeJpg(output, pixels, size.x, size.y, stride, settings))
                 return true;
         }
     }
 
-    err() << "Failed to save image \"" << filename << "\"" << std::endl;
+    output.clear();
     return false;
 }
 
-
-////////////////////////////////////////////////////////////
-bool ImageLoader::writeJpg(const std::string& filename, const std::vector<Uint8>& pixels, unsigned int width, unsigned int height)
-{
-    // Open the file to write in
-    FILE* file = fopen(filename.c_str(), "wb");
-    if (!file)
-        return false;
-
-    // Initialize the error handler
-    jpeg_compress_struct compressInfos;
-    jpeg_error_mgr errorManager;
-    compressInfos.err = jpeg_std_error(&errorManager);
-
-    // Initialize all the writing and compression infos
-    jpeg_create_compress(&compressInfos);
-    compressInfos.image_width      = width;
-    compressInfos.image_height     = height;
-    compressInfos.input_components = 3;
-    compressInfos.in_color_space   = JCS_RGB;
-    jpeg_stdio_dest(&compressInfos, file);
-    jpeg_set_defaults(&compressInfos);
-    jpeg_set_quality(&compressInfos, 90, TRUE);
-
-    // Get rid of the alpha channel
-    std::vector<Uint8> buffer(width * height * 3);
-    for (std::size_t i = 0; i < width * height; ++i)
-    {
-        buffer[i * 3 + 0] = pixels[i * 4 + 0];
-        buffer[i * 3 + 1] = pixels[i * 4 + 1];
-        buffer[i * 3 + 2] = pixels[i * 4 + 2];
-    }
-    Uint8* ptr = &buffer[0];
-
-    // Start compression
-    jpeg_start_compress(&compressInfos, TRUE);
-
-    // Write each row of the image
-    while (compressInfos.next_scanline < compressInfos.image_height)
-    {
-        JSAMPROW rawPointer = ptr + (compressInfos.next_scanline * width * 3);
-        jpeg_write_scanlines(&compressInfos, &rawPointer, 1);
-    }
-
-    // Finish compression
-    jpeg_finish_compress(&compressInfos);
-    jpeg_destroy_compress(&compressInfos);
-
-    // Close the file
-    fclose(file);
-
-    return true;
-}
-
 } // namespace priv
 
 } // namespace sf
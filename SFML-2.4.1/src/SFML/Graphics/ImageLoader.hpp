@@ -28,6 +28,8 @@
 ////////////////////////////////////////////////////////////
 // Headers
 ////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/ImageView.hpp>
 #include <SFML/System/NonCopyable.hpp>
 #include <SFML/System/Vector2.hpp>
 #include <string>
@@ -93,17 +95,49 @@ public:
     ////////////////////////////////////////////////////////////
     bool loadImageFromStream(InputStream& stream, std::vector<Uint8>& pixels, Vector2u& size);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Decode an image file in memory, without reporting errors
+    ///
+    /// This function is thread-safe, it's meant for threads
+    /// that report their errors from another thread.
+    ///
+    /// \param data     Pointer to the file data in memory
+    /// \param dataSize Size of the data to load, in bytes
+    /// \param pixels   Array of pixels to fill with loaded image
+    /// \param size     Size of loaded image, in pixels
+    /// \param reason   Filled with the reason of the failure, if any
+    ///
+    /// \return True if loading was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool decodeImage(const void* data, std::size_t dataSize, std::vector<Uint8>& pixels, Vector2u& size, std::string& reason);
+
     ////////////////////////////////////////////////////////////
     /// \brief Save an array of pixels as an image file
     ///
     /// \param filename Path of image file to save
-    /// \param pixels   Array of pixels to save to image
-    /// \param size     Size of image to save, in pixels
+    /// \param image    Pixels to save to image
+    /// \param settings Encoding settings
+    ///
+    /// \return True if saving was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool saveImageToFile(const std::string& filename, const ImageView& image, const Image::SaveSettings& settings);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Save an array of pixels as an encoded image buffer
+    ///
+    /// This function is thread-safe.
+    ///
+    /// \param format   Format of the encoded image (bmp, png, tga or jpg)
+    /// \param output   Buffer to fill with the encoded image
+    /// \param image    Pixels to save to image
+    /// \param settings Encoding settings
     ///
     /// \return True if saving was successful
     ///
     ////////////////////////////////////////////////////////////
-    bool saveImageToFile(const std::string& filename, const std::vector<Uint8>& pixels, const Vector2u& size);
+    bool saveImageToMemory(const std::string& format, std::vector<Uint8>& output, const ImageView& image, const Image::SaveSettings& settings);
 
 private:
 
@@ -118,19 +152,6 @@ private:
     ///
     ////////////////////////////////////////////////////////////
     ~ImageLoader();
-
-    ////////////////////////////////////////////////////////////
-    /// \brief Save an image file in JPEG format
-    ///
-    /// \param filename Path of image file to save
-    /// \param pixels   Array of pixels to save to image
-    /// \param width    Width of image to save, in pixels
-    /// \param height   Height of image to save, in pixels
-    ///
-    /// \return True if saving was successful
-    ///
-    ////////////////////////////////////////////////////////////
-    bool writeJpg(const std::string& filename, const std::vector<Uint8>& pixels, unsigned int width, unsigned int height);
 };
 
 } // namespace priv
@@ -0,0 +1,174 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2016 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/ImageSaveQueue.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Thread.hpp>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+ImageSaveQueue::ImageSaveQueue(unsigned int threadCount, std::size_t maxPending) :
+m_threads   (),
+m_jobs      (),
+m_active    (0),
+m_maxPending(maxPending),
+m_failures  (0),
+m_waiters   (0),
+m_mutex     (),
+m_freeSlots (static_cast<unsigned int>(maxPending)),
+m_wakeUps   (0),
+m_idle      (0)
+{
+    if (threadCount == 0)
+        threadCount = Thread::getHardwareConcurrency();
+
+    for (unsigned int i = 0; i < threadCount; ++i)
+    {
+        m_threads.push_back(new Thread(&ImageSaveQueue::run, this));
+        m_threads.back()->launch();
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+ImageSaveQueue::~ImageSaveQueue()
+{
+    // The workers finish the pending images, then each one is woken
+    // up once more, finds the queue empty and stops
+    for (std::size_t i = 0; i < m_threads.size(); ++i)
+        m_wakeUps.post();
+
+    for (std::vector<Thread*>::iterator it = m_threads.begin(); it != m_threads.end(); ++it)
+    {
+        (*it)->wait();
+        delete *it;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void ImageSaveQueue::push(const Image& image, const std::string& filename, const Image::SaveSettings& settings)
+{
+    // Take a slot, waiting for one to be released if the queue is full;
+    // the slot is given back by the worker once the image is saved
+    if (m_maxPending > 0)
+        m_freeSlots.wait();
+
+    Job* job = new Job;
+    job->image    = image;
+    job->filename = filename;
+    job->settings = settings;
+
+    {
+        Lock lock(m_mutex);
+        m_jobs.push_back(job);
+    }
+
+    m_wakeUps.post();
+}
+
+
+////////////////////////////////////////////////////////////
+void ImageSaveQueue::wait()
+{
+    {
+        Lock lock(m_mutex);
+        if (m_jobs.empty() && (m_active == 0))
+            return;
+
+        m_waiters++;
+    }
+
+    m_idle.wait();
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t ImageSaveQueue::getPendingCount() const
+{
+    Lock lock(m_mutex);
+
+    return m_jobs.size() + m_active;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t ImageSaveQueue::getFailureCount() const
+{
+    Lock lock(m_mutex);
+
+    return m_failures;
+}
+
+
+////////////////////////////////////////////////////////////
+void ImageSaveQueue::run()
+{
+    for (;;)
+    {
+        // Sleep until there's an image to save, or the queue stops
+        m_wakeUps.wait();
+
+        Job* job = NULL;
+        {
+            Lock lock(m_mutex);
+
+            // The pending images are all saved before the workers stop
+            if (m_jobs.empty())
+                return;
+
+            job = m_jobs.front();
+            m_jobs.pop_front();
+            m_active++;
+        }
+
+        bool success = job->image.saveToFile(job->filename, job->settings);
+        delete job;
+
+        {
+            Lock lock(m_mutex);
+            m_active--;
+            if (!success)
+                m_failures++;
+
+            // Release the threads blocked in wait() when the queue becomes empty
+            if (m_jobs.empty() && (m_active == 0))
+            {
+                for (; m_waiters > 0; --m_waiters)
+                    m_idle.post();
+            }
+        }
+
+        if (m_maxPending > 0)
+            m_freeSlots.post();
+    }
+}
+
+} // namespace sf
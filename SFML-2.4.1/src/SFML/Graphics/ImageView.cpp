@@ -0,0 +1,148 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2016 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/ImageView.hpp>
+#include <SFML/Graphics/ImageLoader.hpp>
+#include <algorithm>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+ImageView::ImageView() :
+m_pixels(NULL),
+m_size  (0, 0),
+m_stride(0)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+ImageView::ImageView(const Uint8* pixels, unsigned int width, unsigned int height, std::size_t stride) :
+m_pixels(pixels),
+m_size  (width, height),
+m_stride(stride ? stride : width * 4)
+{
+    // An empty view has no pixels
+    if (!pixels || (width == 0) || (height == 0))
+    {
+        m_pixels = NULL;
+        m_size   = Vector2u(0, 0);
+        m_stride = 0;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+ImageView::ImageView(const Image& image) :
+m_pixels(image.getPixelsPtr()),
+m_size  (image.getSize()),
+m_stride(image.getSize().x * 4)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+Vector2u ImageView::getSize() const
+{
+    return m_size;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t ImageView::getStride() const
+{
+    return m_stride;
+}
+
+
+////////////////////////////////////////////////////////////
+const Uint8* ImageView::getPixelsPtr() const
+{
+    return m_pixels;
+}
+
+
+////////////////////////////////////////////////////////////
+const Uint8* ImageView::getRow(unsigned int y) const
+{
+    return m_pixels + y * m_stride;
+}
+
+
+////////////////////////////////////////////////////////////
+bool ImageView::isContiguous() const
+{
+    return m_stride == m_size.x * 4;
+}
+
+
+////////////////////////////////////////////////////////////
+ImageView ImageView::getSubView(const IntRect& area) const
+{
+    int left   = std::max(area.left, 0);
+    int top    = std::max(area.top, 0);
+    int right  = std::min(area.left + area.width, static_cast<int>(m_size.x));
+    int bottom = std::min(area.top + area.height, static_cast<int>(m_size.y));
+
+    if ((left >= right) || (top >= bottom))
+        return ImageView();
+
+    return ImageView(getRow(top) + left * 4, right - left, bottom - top, m_stride);
+}
+
+
+////////////////////////////////////////////////////////////
+void ImageView::copyToImage(Image& image) const
+{
+    if (isContiguous())
+    {
+        image.create(m_size.x, m_size.y, m_pixels);
+    }
+    else
+    {
+        image.create(m_size.x, m_size.y);
+        image.copy(*this, 0, 0);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool ImageView::saveToFile(const std::string& filename, const Image::SaveSettings& settings) const
+{
+    return priv::ImageLoader::getInstance().saveImageToFile(filename, *this, settings);
+}
+
+
+////////////////////////////////////////////////////////////
+bool ImageView::saveToMemory(std::vector<Uint8>& output, const std::string& format, const Image::SaveSettings& settings) const
+{
+    return priv::ImageLoader::getInstance().saveImageToMemory(format, output, *this, settings);
+}
+
+} // namespace sf
@@ -0,0 +1,1115 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2016 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/PixelKernels.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+    #include <emmintrin.h>
+    #define SFML_PIXEL_SSE2
+
+    // AVX2 is not part of the baseline: its kernels are compiled for it
+    // explicitly and only used when the CPU supports it
+    #if defined(__clang__) || (defined(__GNUC__) && ((__GNUC__ > 4) || ((__GNUC__ == 4) && (__GNUC_MINOR__ >= 9))))
+        #include <immintrin.h>
+        #define SFML_PIXEL_AVX2
+        #define SFML_PIXEL_AVX2_TARGET __attribute__((target("avx2")))
+    #elif defined(_MSC_VER) && (_MSC_VER >= 1700)
+        #include <immintrin.h>
+        #include <intrin.h>
+        #define SFML_PIXEL_AVX2
+        #define SFML_PIXEL_AVX2_TARGET
+    #endif
+#elif defined(__ARM_NEON__) || defined(__ARM_NEON)
+    #include <arm_neon.h>
+    #define SFML_PIXEL_NEON
+#endif
+
+
+namespace
+{
+    ////////////////////////////////////////////////////////////
+    // Load/store a pixel as a 32-bit word (in memory order)
+    ////////////////////////////////////////////////////////////
+    sf::Uint32 loadPixel(const sf::Uint8* pixel)
+    {
+        sf::Uint32 value;
+        std::memcpy(&value, pixel, sizeof(value));
+        return value;
+    }
+
+    void storePixel(sf::Uint8* pixel, sf::Uint32 value)
+    {
+        std::memcpy(pixel, &value, sizeof(value));
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Bits of the alpha component in a pixel loaded as a 32-bit word
+    ////////////////////////////////////////////////////////////
+    sf::Uint32 getAlphaBits()
+    {
+        const sf::Uint8 bytes[] = {0, 0, 0, 0xFF};
+        return loadPixel(bytes);
+    }
+
+
+    ////////////////////////////////////////////////////////////
+    // Reference implementation of the alpha blending of one pixel
+    ////////////////////////////////////////////////////////////
+    void blendPixel(sf::Uint8* dst, const sf::Uint8* src)
+    {
+        sf::Uint8 alpha = src[3];
+        dst[0] = static_cast<sf::Uint8>((src[0] * alpha + dst[0] * (255 - alpha)) / 255);
+        dst[1] = static_cast<sf::Uint8>((src[1] * alpha + dst[1] * (255 - alpha)) / 255);
+        dst[2] = static_cast<sf::Uint8>((src[2] * alpha + dst[2] * (255 - alpha)) / 255);
+        dst[3] = static_cast<sf::Uint8>(alpha + dst[3] * (255 - alpha) / 255);
+    }
+
+
+    ////////////////////////////////////////////////////////////
+    // Reference implementation of the modulation of one pixel
+    ////////////////////////////////////////////////////////////
+    void modulatePixel(sf::Uint8* pixel, const sf::Uint8* color)
+    {
+        for (int c = 0; c < 4; ++c)
+            pixel[c] = static_cast<sf::Uint8>(pixel[c] * color[c] / 255);
+    }
+
+
+    ////////////////////////////////////////////////////////////
+    // Conversion tables between sRGB and linear components
+    ////////////////////////////////////////////////////////////
+    struct SrgbTables
+    {
+        SrgbTables()
+        {
+            for (int i = 0; i < 256; ++i)
+            {
+                float value = i / 255.f;
+                float linear = (value <= 0.04045f) ? value / 12.92f : std::pow((value + 0.055f) / 1.055f, 2.4f);
+                toLinear[i] = linear;
+                toLinear16[i] = static_cast<sf::Uint16>(linear * 65535.f + 0.5f);
+            }
+
+            // Linear values are looked up with 12 bits of precision
+            for (int i = 0; i < 4096; ++i)
+            {
+                float linear = (i + 0.5f) / 4096.f;
+                float value = (linear <= 0.0031308f) ? linear * 12.92f : 1.055f * std::pow(linear, 1.f / 2.4f) - 0.055f;
+                toSrgb[i] = static_cast<sf::Uint8>(std::min(value * 255.f + 0.5f, 255.f));
+            }
+        }
+
+        float      toLinear[256];
+        sf::Uint16 toLinear16[256];
+        sf::Uint8  toSrgb[4096];
+    };
+    const SrgbTables srgbTables;
+
+    ////////////////////////////////////////////////////////////
+    // Weights of the 6-tap Kaiser-windowed sinc used for 2:1 reduction
+    ////////////////////////////////////////////////////////////
+    struct KaiserWeights
+    {
+        KaiserWeights()
+        {
+            const double pi    = 3.14159265358979323846;
+            const double alpha = 4.0;
+            const double width = 3.0;
+
+            double sum = 0.0;
+            double raw[6];
+            for (int i = 0; i < 6; ++i)
+            {
+                // Distance between the source pixel and the center of the destination pixel, in source pixels
+                double distance = i - 2.5;
+                double x = distance / 2.0;
+                double sinc = std::sin(pi * x) / (pi * x);
+                double ratio = distance / width;
+                raw[i] = sinc * besselI0(alpha * std::sqrt(1.0 - ratio * ratio)) / besselI0(alpha);
+                sum += raw[i];
+            }
+
+            for (int i = 0; i < 6; ++i)
+                values[i] = static_cast<float>(raw[i] / sum);
+        }
+
+        static double besselI0(double x)
+        {
+            double sum = 1.0;
+            double term = 1.0;
+            for (int k = 1; k < 30; ++k)
+            {
+                term *= (x / (2.0 * k)) * (x / (2.0 * k));
+                sum += term;
+            }
+            return sum;
+        }
+
+        float values[6];
+    };
+    const KaiserWeights kaiserWeights;
+
+    ////////////////////////////////////////////////////////////
+    // Average a 2x2 block whose pixels are p0/p1 on the first row and p2/p3 on the second
+    ////////////////////////////////////////////////////////////
+    void averagePixels(const sf::Uint8* p0, const sf::Uint8* p1, const sf::Uint8* p2, const sf::Uint8* p3, sf::Uint8* result, bool sRgb)
+    {
+        for (int c = 0; c < 4; ++c)
+        {
+            if (sRgb && (c < 3))
+            {
+                const sf::Uint16* linear = srgbTables.toLinear16;
+                unsigned int sum = linear[p0[c]] + linear[p1[c]] + linear[p2[c]] + linear[p3[c]];
+                result[c] = srgbTables.toSrgb[((sum + 2) >> 2) >> 4];
+            }
+            else
+            {
+                result[c] = static_cast<sf::Uint8>((p0[c] + p1[c] + p2[c] + p3[c] + 2) >> 2);
+            }
+        }
+    }
+
+#if defined(SFML_PIXEL_AVX2)
+
+    ////////////////////////////////////////////////////////////
+    // Check whether the CPU and the OS support AVX2
+    ////////////////////////////////////////////////////////////
+    bool checkAvx2()
+    {
+    #if defined(_MSC_VER)
+
+        int info[4];
+        __cpuid(info, 0);
+        if (info[0] < 7)
+            return false;
+
+        // The OS must save the YMM registers (OSXSAVE and XCR0 bits 1-2)
+        __cpuid(info, 1);
+        if (!(info[2] & (1 << 27)) || ((_xgetbv(0) & 6) != 6))
+            return false;
+
+        __cpuidex(info, 7, 0);
+        return (info[1] & (1 << 5)) != 0;
+
+    #else
+
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2") != 0;
+
+    #endif
+    }
+
+    bool hasAvx2()
+    {
+        static const bool supported = checkAvx2();
+        return supported;
+    }
+
+#endif
+
+    ////////////////////////////////////////////////////////////
+    // Instruction set used by the kernels, the best one by default
+    ////////////////////////////////////////////////////////////
+    sf::priv::PixelInstructionSet getBestInstructionSet()
+    {
+    #if defined(SFML_PIXEL_AVX2)
+        if (hasAvx2())
+            return sf::priv::PixelAvx2;
+    #endif
+
+    #if defined(SFML_PIXEL_SSE2)
+        return sf::priv::PixelSse2;
+    #elif defined(SFML_PIXEL_NEON)
+        return sf::priv::PixelNeon;
+    #else
+        return sf::priv::PixelScalar;
+    #endif
+    }
+
+    sf::priv::PixelInstructionSet& getInstructionSet()
+    {
+        static sf::priv::PixelInstructionSet instructionSet = getBestInstructionSet();
+        return instructionSet;
+    }
+
+#if defined(SFML_PIXEL_AVX2)
+
+    bool useAvx2()
+    {
+        return getInstructionSet() == sf::priv::PixelAvx2;
+    }
+
+#endif
+
+#if defined(SFML_PIXEL_SSE2)
+
+    // The AVX2 kernels leave their remainders (and the kernels they lack) to the SSE2 ones
+    bool useSse2()
+    {
+        return (getInstructionSet() == sf::priv::PixelSse2) || (getInstructionSet() == sf::priv::PixelAvx2);
+    }
+
+#endif
+
+#if defined(SFML_PIXEL_NEON)
+
+    bool useNeon()
+    {
+        return getInstructionSet() == sf::priv::PixelNeon;
+    }
+
+#endif
+
+
+#if defined(SFML_PIXEL_SSE2)
+
+    ////////////////////////////////////////////////////////////
+    // Exact x / 255 for x in [0, 65025], on 16-bit lanes
+    ////////////////////////////////////////////////////////////
+    __m128i divideBy255(__m128i x)
+    {
+        return _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(x, _mm_set1_epi16(1)), _mm_srli_epi16(x, 8)), 8);
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Blend 2 pixels expanded to 16-bit lanes
+    ////////////////////////////////////////////////////////////
+    __m128i blend2(__m128i src, __m128i dst)
+    {
+        const __m128i alphaLanes = _mm_set_epi16(-1, 0, 0, 0, -1, 0, 0, 0);
+
+        __m128i alpha   = _mm_shufflehi_epi16(_mm_shufflelo_epi16(src, 0xFF), 0xFF);
+        __m128i inverse = _mm_sub_epi16(_mm_set1_epi16(255), alpha);
+        __m128i kept    = _mm_mullo_epi16(dst, inverse);
+        __m128i color   = divideBy255(_mm_add_epi16(_mm_mullo_epi16(src, alpha), kept));
+        __m128i opacity = _mm_add_epi16(alpha, divideBy255(kept));
+
+        return _mm_or_si128(_mm_and_si128(alphaLanes, opacity), _mm_andnot_si128(alphaLanes, color));
+    }
+
+    ////////////////////////////////////////////////////////////
+    std::size_t blendSse2(sf::Uint8* destination, const sf::Uint8* source, std::size_t count, sf::Uint32 alphaBits)
+    {
+        const __m128i zero      = _mm_setzero_si128();
+        const __m128i alphaMask = _mm_set1_epi32(static_cast<int>(alphaBits));
+
+        std::size_t i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128i src = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i * 4));
+            int opaque = _mm_movemask_epi8(_mm_cmpeq_epi32(_mm_and_si128(src, alphaMask), alphaMask));
+            int clear  = _mm_movemask_epi8(_mm_cmpeq_epi32(_mm_and_si128(src, alphaMask), zero));
+
+            // Fully opaque or fully transparent groups are frequent and trivial
+            if (opaque == 0xFFFF)
+            {
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i * 4), src);
+            }
+            else if (clear != 0xFFFF)
+            {
+                __m128i dst  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(destination + i * 4));
+                __m128i low  = blend2(_mm_unpacklo_epi8(src, zero), _mm_unpacklo_epi8(dst, zero));
+                __m128i high = blend2(_mm_unpackhi_epi8(src, zero), _mm_unpackhi_epi8(dst, zero));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i * 4), _mm_packus_epi16(low, high));
+            }
+        }
+
+        return i;
+    }
+
+    ////////////////////////////////////////////////////////////
+    std::size_t modulateSse2(sf::Uint8* pixels, std::size_t count, sf::Uint32 color)
+    {
+        const __m128i zero   = _mm_setzero_si128();
+        const __m128i factor = _mm_unpacklo_epi8(_mm_set1_epi32(static_cast<int>(color)), zero);
+
+        std::size_t i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128i* ptr = reinterpret_cast<__m128i*>(pixels + i * 4);
+            __m128i value = _mm_loadu_si128(ptr);
+            __m128i low   = divideBy255(_mm_mullo_epi16(_mm_unpacklo_epi8(value, zero), factor));
+            __m128i high  = divideBy255(_mm_mullo_epi16(_mm_unpackhi_epi8(value, zero), factor));
+            _mm_storeu_si128(ptr, _mm_packus_epi16(low, high));
+        }
+
+        return i;
+    }
+
+    ////////////////////////////////////////////////////////////
+    std::size_t interpolateSse2(sf::Uint8* pixels, std::size_t count, __m128& color, __m128 step)
+    {
+        const __m128 half = _mm_set1_ps(0.5f);
+
+        std::size_t i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            // Truncating (x + 0.5) then saturating matches the scalar rounding
+            __m128i first  = _mm_cvttps_epi32(_mm_add_ps(color, half));
+            color = _mm_add_ps(color, step);
+            __m128i second = _mm_cvttps_epi32(_mm_add_ps(color, half));
+            color = _mm_add_ps(color, step);
+            __m128i third  = _mm_cvttps_epi32(_mm_add_ps(color, half));
+            color = _mm_add_ps(color, step);
+            __m128i fourth = _mm_cvttps_epi32(_mm_add_ps(color, half));
+            color = _mm_add_ps(color, step);
+
+            __m128i packed = _mm_packus_epi16(_mm_packs_epi32(first, second), _mm_packs_epi32(third, fourth));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(pixels + i * 4), packed);
+        }
+
+        return i;
+    }
+
+    ////////////////////////////////////////////////////////////
+    std::size_t maskSse2(sf::Uint8* pixels, std::size_t count, sf::Uint32 color, sf::Uint32 alphaMask, sf::Uint32 alpha)
+    {
+        const __m128i key      = _mm_set1_epi32(static_cast<int>(color));
+        const __m128i mask     = _mm_set1_epi32(static_cast<int>(alphaMask));
+        const __m128i newAlpha = _mm_set1_epi32(static_cast<int>(alpha));
+
+        std::size_t i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128i* ptr = reinterpret_cast<__m128i*>(pixels + i * 4);
+            __m128i value    = _mm_loadu_si128(ptr);
+            __m128i selected = _mm_and_si128(_mm_cmpeq_epi32(value, key), mask);
+            _mm_storeu_si128(ptr, _mm_or_si128(_mm_andnot_si128(selected, value), _mm_and_si128(selected, newAlpha)));
+        }
+
+        return i;
+    }
+
+    ////////////////////////////////////////////////////////////
+    void fillSse2(sf::Uint8* pixels, std::size_t count, sf::Uint32 color)
+    {
+        const __m128i value = _mm_set1_epi32(static_cast<int>(color));
+
+        std::size_t i = 0;
+        for (; i + 4 <= count; i += 4)
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(pixels + i * 4), value);
+        for (; i < count; ++i)
+            storePixel(pixels + i * 4, color);
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Returns the number of pixels reversed at each end
+    ////////////////////////////////////////////////////////////
+    std::size_t reverseSse2(sf::Uint8* pixels, std::size_t count)
+    {
+        std::size_t i = 0;
+        for (; i + 4 <= count / 2; i += 4)
+        {
+            __m128i* left  = reinterpret_cast<__m128i*>(pixels + i * 4);
+            __m128i* right = reinterpret_cast<__m128i*>(pixels + (count - i - 4) * 4);
+            __m128i first  = _mm_loadu_si128(left);
+            __m128i second = _mm_loadu_si128(right);
+            _mm_storeu_si128(left,  _mm_shuffle_epi32(second, _MM_SHUFFLE(0, 1, 2, 3)));
+            _mm_storeu_si128(right, _mm_shuffle_epi32(first,  _MM_SHUFFLE(0, 1, 2, 3)));
+        }
+
+        return i;
+    }
+
+    ////////////////////////////////////////////////////////////
+    std::size_t swapSse2(sf::Uint8* first, sf::Uint8* second, std::size_t size)
+    {
+        std::size_t i = 0;
+        for (; i + 16 <= size; i += 16)
+        {
+            __m128i* a = reinterpret_cast<__m128i*>(first + i);
+            __m128i* b = reinterpret_cast<__m128i*>(second + i);
+            __m128i valueA = _mm_loadu_si128(a);
+            __m128i valueB = _mm_loadu_si128(b);
+            _mm_storeu_si128(a, valueB);
+            _mm_storeu_si128(b, valueA);
+        }
+
+        return i;
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Sum the pairs of adjacent pixels of 2 rows of 4 pixels, and average them
+    ////////////////////////////////////////////////////////////
+    __m128i average2x2(__m128i row0, __m128i row1)
+    {
+        const __m128i zero = _mm_setzero_si128();
+
+        __m128i low  = _mm_add_epi16(_mm_unpacklo_epi8(row0, zero), _mm_unpacklo_epi8(row1, zero));
+        __m128i high = _mm_add_epi16(_mm_unpackhi_epi8(row0, zero), _mm_unpackhi_epi8(row1, zero));
+        low  = _mm_add_epi16(low, _mm_srli_si128(low, 8));
+        high = _mm_add_epi16(high, _mm_srli_si128(high, 8));
+
+        return _mm_srli_epi16(_mm_add_epi16(_mm_unpacklo_epi64(low, high), _mm_set1_epi16(2)), 2);
+    }
+
+    ////////////////////////////////////////////////////////////
+    std::size_t downsampleRowSse2(const sf::Uint8* row0, const sf::Uint8* row1, sf::Uint8* destination, std::size_t count)
+    {
+        std::size_t i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128i first  = average2x2(_mm_loadu_si128(reinterpret_cast<const __m128i*>(row0 + i * 8)),
+                                        _mm_loadu_si128(reinterpret_cast<const __m128i*>(row1 + i * 8)));
+            __m128i second = average2x2(_mm_loadu_si128(reinterpret_cast<const __m128i*>(row0 + i * 8 + 16)),
+                                        _mm_loadu_si128(reinterpret_cast<const __m128i*>(row1 + i * 8 + 16)));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i * 4), _mm_packus_epi16(first, second));
+        }
+
+        return i;
+    }
+
+#endif
+
+
+#if defined(SFML_PIXEL_AVX2)
+
+    ////////////////////////////////////////////////////////////
+    SFML_PIXEL_AVX2_TARGET __m256i divideBy255Avx2(__m256i x)
+    {
+        return _mm256_srli_epi16(_mm256_add_epi16(_mm256_add_epi16(x, _mm256_set1_epi16(1)), _mm256_srli_epi16(x, 8)), 8);
+    }
+
+    ////////////////////////////////////////////////////////////
+    SFML_PIXEL_AVX2_TARGET __m256i blend4Avx2(__m256i src, __m256i dst)
+    {
+        const __m256i alphaLanes = _mm256_set_epi16(-1, 0, 0, 0, -1, 0, 0, 0, -1, 0, 0, 0, -1, 0, 0, 0);
+
+        __m256i alpha   = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(src, 0xFF), 0xFF);
+        __m256i inverse = _mm256_sub_epi16(_mm256_set1_epi16(255), alpha);
+        __m256i kept    = _mm256_mullo_epi16(dst, inverse);
+        __m256i color   = divideBy255Avx2(_mm256_add_epi16(_mm256_mullo_epi16(src, alpha), kept));
+        __m256i opacity = _mm256_add_epi16(alpha, divideBy255Avx2(kept));
+
+        return _mm256_blendv_epi8(color, opacity, alphaLanes);
+    }
+
+    ////////////////////////////////////////////////////////////
+    SFML_PIXEL_AVX2_TARGET std::size_t blendAvx2(sf::Uint8* destination, const sf::Uint8* source, std::size_t count, sf::Uint32 alphaBits)
+    {
+        const __m256i zero      = _mm256_setzero_si256();
+        const __m256i alphaMask = _mm256_set1_epi32(static_cast<int>(alphaBits));
+
+        std::size_t i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            __m256i src = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + i * 4));
+            unsigned int opaque = static_cast<unsigned int>(_mm256_movemask_epi8(_mm256_cmpeq_epi32(_mm256_and_si256(src, alphaMask), alphaMask)));
+            unsigned int clear  = static_cast<unsigned int>(_mm256_movemask_epi8(_mm256_cmpeq_epi32(_mm256_and_si256(src, alphaMask), zero)));
+
+            if (opaque == 0xFFFFFFFF)
+            {
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + i * 4), src);
+            }
+            else if (clear != 0xFFFFFFFF)
+            {
+                // Unpack and pack work within 128-bit lanes, so the pixel order is preserved
+                __m256i dst  = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(destination + i * 4));
+                __m256i low  = blend4Avx2(_mm256_unpacklo_epi8(src, zero), _mm256_unpacklo_epi8(dst, zero));
+                __m256i high = blend4Avx2(_mm256_unpackhi_epi8(src, zero), _mm256_unpackhi_epi8(dst, zero));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + i * 4), _mm256_packus_epi16(low, high));
+            }
+        }
+
+        return i;
+    }
+
+    ////////////////////////////////////////////////////////////
+    SFML_PIXEL_AVX2_TARGET std::size_t maskAvx2(sf::Uint8* pixels, std::size_t count, sf::Uint32 color, sf::Uint32 alphaMask, sf::Uint32 alpha)
+    {
+        const __m256i key      = _mm256_set1_epi32(static_cast<int>(color));
+        const __m256i mask     = _mm256_set1_epi32(static_cast<int>(alphaMask));
+        const __m256i newAlpha = _mm256_set1_epi32(static_cast<int>(alpha));
+
+        std::size_t i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            __m256i* ptr = reinterpret_cast<__m256i*>(pixels + i * 4);
+            __m256i value    = _mm256_loadu_si256(ptr);
+            __m256i selected = _mm256_and_si256(_mm256_cmpeq_epi32(value, key), mask);
+            _mm256_storeu_si256(ptr, _mm256_or_si256(_mm256_andnot_si256(selected, value), _mm256_and_si256(selected, newAlpha)));
+        }
+
+        return i;
+    }
+
+    ////////////////////////////////////////////////////////////
+    SFML_PIXEL_AVX2_TARGET std::size_t fillAvx2(sf::Uint8* pixels, std::size_t count, sf::Uint32 color)
+    {
+        const __m256i value = _mm256_set1_epi32(static_cast<int>(color));
+
+        std::size_t i = 0;
+        for (; i + 8 <= count; i += 8)
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(pixels + i * 4), value);
+
+        return i;
+    }
+
+    ////////////////////////////////////////////////////////////
+    SFML_PIXEL_AVX2_TARGET std::size_t reverseAvx2(sf::Uint8* pixels, std::size_t count)
+    {
+        const __m256i order = _mm256_set_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+
+        std::size_t i = 0;
+        for (; i + 8 <= count / 2; i += 8)
+        {
+            __m256i* left  = reinterpret_cast<__m256i*>(pixels + i * 4);
+            __m256i* right = reinterpret_cast<__m256i*>(pixels + (count - i - 8) * 4);
+            __m256i first  = _mm256_loadu_si256(left);
+            __m256i second = _mm256_loadu_si256(right);
+            _mm256_storeu_si256(left,  _mm256_permutevar8x32_epi32(second, order));
+            _mm256_storeu_si256(right, _mm256_permutevar8x32_epi32(first,  order));
+        }
+
+        return i;
+    }
+
+    ////////////////////////////////////////////////////////////
+    SFML_PIXEL_AVX2_TARGET std::size_t swapAvx2(sf::Uint8* first, sf::Uint8* second, std::size_t size)
+    {
+        std::size_t i = 0;
+        for (; i + 32 <= size; i += 32)
+        {
+            __m256i* a = reinterpret_cast<__m256i*>(first + i);
+            __m256i* b = reinterpret_cast<__m256i*>(second + i);
+            __m256i valueA = _mm256_loadu_si256(a);
+            __m256i valueB = _mm256_loadu_si256(b);
+            _mm256_storeu_si256(a, valueB);
+            _mm256_storeu_si256(b, valueA);
+        }
+
+        return i;
+    }
+
+#endif
+
+
+#if defined(SFML_PIXEL_NEON)
+
+    ////////////////////////////////////////////////////////////
+    // Exact x / 255 for x in [0, 65025], narrowed to 8 bits
+    ////////////////////////////////////////////////////////////
+    uint8x8_t divideBy255(uint16x8_t x)
+    {
+        return vshrn_n_u16(vaddq_u16(vaddq_u16(x, vdupq_n_u16(1)), vshrq_n_u16(x, 8)), 8);
+    }
+
+    ////////////////////////////////////////////////////////////
+    std::size_t blendNeon(sf::Uint8* destination, const sf::Uint8* source, std::size_t count)
+    {
+        std::size_t i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            // Deinterleaved loads give one register per component
+            uint8x8x4_t src = vld4_u8(source + i * 4);
+            uint8x8x4_t dst = vld4_u8(destination + i * 4);
+
+            uint8x8_t  alpha   = src.val[3];
+            uint8x8_t  inverse = vsub_u8(vdup_n_u8(255), alpha);
+            for (int c = 0; c < 3; ++c)
+                dst.val[c] = divideBy255(vmlal_u8(vmull_u8(src.val[c], alpha), dst.val[c], inverse));
+            dst.val[3] = vadd_u8(alpha, divideBy255(vmull_u8(dst.val[3], inverse)));
+
+            vst4_u8(destination + i * 4, dst);
+        }
+
+        return i;
+    }
+
+    ////////////////////////////////////////////////////////////
+    std::size_t modulateNeon(sf::Uint8* pixels, std::size_t count, const sf::Uint8* color)
+    {
+        std::size_t i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            uint8x8x4_t value = vld4_u8(pixels + i * 4);
+            for (int c = 0; c < 4; ++c)
+                value.val[c] = divideBy255(vmull_u8(value.val[c], vdup_n_u8(color[c])));
+
+            vst4_u8(pixels + i * 4, value);
+        }
+
+        return i;
+    }
+
+    ////////////////////////////////////////////////////////////
+    std::size_t interpolateNeon(sf::Uint8* pixels, std::size_t count, float32x4_t& color, float32x4_t step)
+    {
+        const float32x4_t half = vdupq_n_f32(0.5f);
+
+        std::size_t i = 0;
+        for (; i + 2 <= count; i += 2)
+        {
+            int32x4_t first = vcvtq_s32_f32(vaddq_f32(color, half));
+            color = vaddq_f32(color, step);
+            int32x4_t second = vcvtq_s32_f32(vaddq_f32(color, half));
+            color = vaddq_f32(color, step);
+
+            uint8x8_t packed = vqmovn_u16(vcombine_u16(vqmovun_s32(first), vqmovun_s32(second)));
+            vst1_u8(pixels + i * 4, packed);
+        }
+
+        return i;
+    }
+
+    ////////////////////////////////////////////////////////////
+    std::size_t maskNeon(sf::Uint8* pixels, std::size_t count, sf::Uint32 color, sf::Uint32 alphaMask, sf::Uint32 alpha)
+    {
+        const uint32x4_t key      = vdupq_n_u32(color);
+        const uint32x4_t mask     = vdupq_n_u32(alphaMask);
+        const uint32x4_t newAlpha = vdupq_n_u32(alpha);
+
+        std::size_t i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            uint32x4_t value    = vreinterpretq_u32_u8(vld1q_u8(pixels + i * 4));
+            uint32x4_t selected = vandq_u32(vceqq_u32(value, key), mask);
+            vst1q_u8(pixels + i * 4, vreinterpretq_u8_u32(vbslq_u32(selected, newAlpha, value)));
+        }
+
+        return i;
+    }
+
+    ////////////////////////////////////////////////////////////
+    void fillNeon(sf::Uint8* pixels, std::size_t count, sf::Uint32 color)
+    {
+        const uint8x16_t value = vreinterpretq_u8_u32(vdupq_n_u32(color));
+
+        std::size_t i = 0;
+        for (; i + 4 <= count; i += 4)
+            vst1q_u8(pixels + i * 4, value);
+        for (; i < count; ++i)
+            storePixel(pixels + i * 4, color);
+    }
+
+    ////////////////////////////////////////////////////////////
+    uint8x16_t reverse4(uint8x16_t pixels)
+    {
+        uint32x4_t swapped = vrev64q_u32(vreinterpretq_u32_u8(pixels));
+        return vreinterpretq_u8_u32(vcombine_u32(vget_high_u32(swapped), vget_low_u32(swapped)));
+    }
+
+    ////////////////////////////////////////////////////////////
+    std::size_t reverseNeon(sf::Uint8* pixels, std::size_t count)
+    {
+        std::size_t i = 0;
+        for (; i + 4 <= count / 2; i += 4)
+        {
+            sf::Uint8* left  = pixels + i * 4;
+            sf::Uint8* right = pixels + (count - i - 4) * 4;
+            uint8x16_t first  = vld1q_u8(left);
+            uint8x16_t second = vld1q_u8(right);
+            vst1q_u8(left,  reverse4(second));
+            vst1q_u8(right, reverse4(first));
+        }
+
+        return i;
+    }
+
+    ////////////////////////////////////////////////////////////
+    std::size_t swapNeon(sf::Uint8* first, sf::Uint8* second, std::size_t size)
+    {
+        std::size_t i = 0;
+        for (; i + 16 <= size; i += 16)
+        {
+            uint8x16_t valueA = vld1q_u8(first + i);
+            uint8x16_t valueB = vld1q_u8(second + i);
+            vst1q_u8(first + i,  valueB);
+            vst1q_u8(second + i, valueA);
+        }
+
+        return i;
+    }
+
+    ////////////////////////////////////////////////////////////
+    std::size_t downsampleRowNeon(const sf::Uint8* row0, const sf::Uint8* row1, sf::Uint8* destination, std::size_t count)
+    {
+        std::size_t i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            // Deinterleave 16 pixels of each row, then add the adjacent pixels of each channel
+            uint8x16x4_t first  = vld4q_u8(row0 + i * 8);
+            uint8x16x4_t second = vld4q_u8(row1 + i * 8);
+
+            uint8x8x4_t result;
+            for (int c = 0; c < 4; ++c)
+                result.val[c] = vrshrn_n_u16(vaddq_u16(vpaddlq_u8(first.val[c]), vpaddlq_u8(second.val[c])), 2);
+
+            vst4_u8(destination + i * 4, result);
+        }
+
+        return i;
+    }
+
+#endif
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+bool isPixelInstructionSetSupported(PixelInstructionSet instructionSet)
+{
+    switch (instructionSet)
+    {
+        case PixelScalar:
+            return true;
+
+    #if defined(SFML_PIXEL_SSE2)
+        case PixelSse2:
+            return true;
+    #endif
+
+    #if defined(SFML_PIXEL_AVX2)
+        case PixelAvx2:
+            return hasAvx2();
+    #endif
+
+    #if defined(SFML_PIXEL_NEON)
+        case PixelNeon:
+            return true;
+    #endif
+
+        default:
+            return false;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+PixelInstructionSet getPixelInstructionSet()
+{
+    return getInstructionSet();
+}
+
+
+////////////////////////////////////////////////////////////
+void setPixelInstructionSet(PixelInstructionSet instructionSet)
+{
+    if (isPixelInstructionSetSupported(instructionSet))
+        getInstructionSet() = instructionSet;
+}
+
+
+////////////////////////////////////////////////////////////
+void fillPixels(Uint8* pixels, std::size_t count, const Uint8* color)
+{
+    Uint32 value = loadPixel(color);
+    std::size_t i = 0;
+
+#if defined(SFML_PIXEL_AVX2)
+    if (useAvx2())
+        i = fillAvx2(pixels, count, value);
+#endif
+
+#if defined(SFML_PIXEL_SSE2)
+    if (useSse2())
+    {
+        fillSse2(pixels + i * 4, count - i, value);
+        return;
+    }
+#elif defined(SFML_PIXEL_NEON)
+    if (useNeon())
+    {
+        fillNeon(pixels, count, value);
+        return;
+    }
+#endif
+
+    for (; i < count; ++i)
+        storePixel(pixels + i * 4, value);
+}
+
+
+////////////////////////////////////////////////////////////
+void blendPixels(Uint8* destination, const Uint8* source, std::size_t count)
+{
+    std::size_t i = 0;
+
+#if defined(SFML_PIXEL_AVX2)
+    if (useAvx2())
+        i = blendAvx2(destination, source, count, getAlphaBits());
+#endif
+
+#if defined(SFML_PIXEL_SSE2)
+    if (useSse2())
+        i += blendSse2(destination + i * 4, source + i * 4, count - i, getAlphaBits());
+#elif defined(SFML_PIXEL_NEON)
+    if (useNeon())
+        i = blendNeon(destination, source, count);
+#endif
+
+    for (; i < count; ++i)
+        blendPixel(destination + i * 4, source + i * 4);
+}
+
+
+////////////////////////////////////////////////////////////
+void modulatePixels(Uint8* pixels, std::size_t count, const Uint8* color)
+{
+    std::size_t i = 0;
+
+#if defined(SFML_PIXEL_SSE2)
+    if (useSse2())
+        i = modulateSse2(pixels, count, loadPixel(color));
+#elif defined(SFML_PIXEL_NEON)
+    if (useNeon())
+        i = modulateNeon(pixels, count, color);
+#endif
+
+    for (; i < count; ++i)
+        modulatePixel(pixels + i * 4, color);
+}
+
+
+////////////////////////////////////////////////////////////
+void interpolatePixels(Uint8* pixels, std::size_t count, const float* color, const float* step)
+{
+    float value[4] = {color[0], color[1], color[2], color[3]};
+    std::size_t i = 0;
+
+#if defined(SFML_PIXEL_SSE2)
+    if (useSse2())
+    {
+        __m128 current = _mm_loadu_ps(value);
+        i = interpolateSse2(pixels, count, current, _mm_loadu_ps(step));
+        _mm_storeu_ps(value, current);
+    }
+#elif defined(SFML_PIXEL_NEON)
+    if (useNeon())
+    {
+        float32x4_t current = vld1q_f32(value);
+        i = interpolateNeon(pixels, count, current, vld1q_f32(step));
+        vst1q_f32(value, current);
+    }
+#endif
+
+    for (; i < count; ++i)
+    {
+        for (int c = 0; c < 4; ++c)
+        {
+            int component = static_cast<int>(value[c] + 0.5f);
+            pixels[i * 4 + c] = static_cast<Uint8>(std::max(0, std::min(component, 255)));
+            value[c] += step[c];
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void maskPixels(Uint8* pixels, std::size_t count, const Uint8* color, Uint8 alpha)
+{
+    const Uint8 newAlphaBytes[] = {0, 0, 0, alpha};
+
+    Uint32 key       = loadPixel(color);
+    Uint32 alphaMask = getAlphaBits();
+    Uint32 newAlpha  = loadPixel(newAlphaBytes);
+    std::size_t i = 0;
+
+#if defined(SFML_PIXEL_AVX2)
+    if (useAvx2())
+        i = maskAvx2(pixels, count, key, alphaMask, newAlpha);
+#endif
+
+#if defined(SFML_PIXEL_SSE2)
+    if (useSse2())
+        i += maskSse2(pixels + i * 4, count - i, key, alphaMask, newAlpha);
+#elif defined(SFML_PIXEL_NEON)
+    if (useNeon())
+        i = maskNeon(pixels, count, key, alphaMask, newAlpha);
+#endif
+
+    for (; i < count; ++i)
+    {
+        if (loadPixel(pixels + i * 4) == key)
+            pixels[i * 4 + 3] = alpha;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void reversePixels(Uint8* pixels, std::size_t count)
+{
+    // Pixels are exchanged from both ends towards the middle
+    std::size_t i = 0;
+
+#if defined(SFML_PIXEL_AVX2)
+    if (useAvx2())
+        i = reverseAvx2(pixels, count);
+#endif
+
+#if defined(SFML_PIXEL_SSE2)
+    if (useSse2())
+        i += reverseSse2(pixels + i * 4, count - 2 * i);
+#elif defined(SFML_PIXEL_NEON)
+    if (useNeon())
+        i = reverseNeon(pixels, count);
+#endif
+
+    for (; i < count / 2; ++i)
+    {
+        Uint32 left  = loadPixel(pixels + i * 4);
+        Uint32 right = loadPixel(pixels + (count - i - 1) * 4);
+        storePixel(pixels + i * 4, right);
+        storePixel(pixels + (count - i - 1) * 4, left);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void swapBytes(Uint8* first, Uint8* second, std::size_t size)
+{
+    std::size_t i = 0;
+
+#if defined(SFML_PIXEL_AVX2)
+    if (useAvx2())
+        i = swapAvx2(first, second, size);
+#endif
+
+#if defined(SFML_PIXEL_SSE2)
+    if (useSse2())
+        i += swapSse2(first + i, second + i, size - i);
+#elif defined(SFML_PIXEL_NEON)
+    if (useNeon())
+        i = swapNeon(first, second, size);
+#endif
+
+    for (; i < size; ++i)
+    {
+        Uint8 value = first[i];
+        first[i] = second[i];
+        second[i] = value;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void downsampleBox(const Uint8* source, unsigned int width, unsigned int height, Uint8* destination, bool sRgb)
+{
+    unsigned int targetWidth  = std::max(width / 2, 1u);
+    unsigned int targetHeight = std::max(height / 2, 1u);
+
+    for (unsigned int y = 0; y < targetHeight; ++y)
+    {
+        const Uint8* row0 = source + (y * 2) * width * 4;
+        const Uint8* row1 = source + std::min(y * 2 + 1, height - 1) * width * 4;
+        Uint8* row = destination + y * targetWidth * 4;
+
+        std::size_t x = 0;
+
+        // The vector kernels need two source pixels for each destination pixel
+        if (!sRgb && (width > 1))
+        {
+#if defined(SFML_PIXEL_SSE2)
+            if (useSse2())
+                x = downsampleRowSse2(row0, row1, row, targetWidth);
+#elif defined(SFML_PIXEL_NEON)
+            if (useNeon())
+                x = downsampleRowNeon(row0, row1, row, targetWidth);
+#endif
+        }
+
+        for (; x < targetWidth; ++x)
+        {
+            std::size_t left  = x * 2 * 4;
+            std::size_t right = std::min<std::size_t>(x * 2 + 1, width - 1) * 4;
+            averagePixels(row0 + left, row0 + right, row1 + left, row1 + right, row + x * 4, sRgb);
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void downsampleKaiser(const Uint8* source, unsigned int width, unsigned int height, Uint8* destination, bool sRgb)
+{
+    unsigned int targetWidth  = std::max(width / 2, 1u);
+    unsigned int targetHeight = std::max(height / 2, 1u);
+    const float* weights = kaiserWeights.values;
+
+    // Convert the source to linear floating point components
+    float linear[256];
+    for (int i = 0; i < 256; ++i)
+        linear[i] = i / 255.f;
+    const float* colorTable = sRgb ? srgbTables.toLinear : linear;
+
+    // Horizontal pass, the filter is separable
+    std::vector<float> filtered(targetWidth * height * 4);
+    for (unsigned int y = 0; y < height; ++y)
+    {
+        const Uint8* row = source + y * width * 4;
+        float* result = &filtered[y * targetWidth * 4];
+        for (unsigned int x = 0; x < targetWidth; ++x)
+        {
+            float sum[4] = {0.f, 0.f, 0.f, 0.f};
+            for (int t = 0; t < 6; ++t)
+            {
+                int sourceX = std::min(std::max(static_cast<int>(x * 2) + t - 2, 0), static_cast<int>(width) - 1);
+                const Uint8* pixel = row + sourceX * 4;
+                sum[0] += colorTable[pixel[0]] * weights[t];
+                sum[1] += colorTable[pixel[1]] * weights[t];
+                sum[2] += colorTable[pixel[2]] * weights[t];
+                sum[3] += linear[pixel[3]] * weights[t];
+            }
+
+            for (int c = 0; c < 4; ++c)
+                result[x * 4 + c] = sum[c];
+        }
+    }
+
+    // Vertical pass, and conversion back to 8-bit components
+    for (unsigned int y = 0; y < targetHeight; ++y)
+    {
+        Uint8* row = destination + y * targetWidth * 4;
+        for (std::size_t i = 0; i < targetWidth * 4; ++i)
+        {
+            float sum = 0.f;
+            for (int t = 0; t < 6; ++t)
+            {
+                int sourceY = std::min(std::max(static_cast<int>(y * 2) + t - 2, 0), static_cast<int>(height) - 1);
+                sum += filtered[sourceY * targetWidth * 4 + i] * weights[t];
+            }
+
+            // The negative lobes of the filter can overshoot
+            sum = std::min(std::max(sum, 0.f), 1.f);
+            if (sRgb && ((i % 4) < 3))
+                row[i] = srgbTables.toSrgb[static_cast<unsigned int>(sum * 65535.f + 0.5f) >> 4];
+            else
+                row[i] = static_cast<Uint8>(sum * 255.f + 0.5f);
+        }
+    }
+}
+
+} // namespace priv
+
+} // namespace sf
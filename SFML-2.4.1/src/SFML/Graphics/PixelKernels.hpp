@@ -0,0 +1,207 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2016 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_PIXELKERNELS_HPP
+#define SFML_PIXELKERNELS_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Config.hpp>
+#include <cstddef>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Instruction sets of the pixel kernels
+///
+////////////////////////////////////////////////////////////
+enum PixelInstructionSet
+{
+    PixelScalar, ///< Portable code, always supported
+    PixelSse2,   ///< SSE2 kernels
+    PixelAvx2,   ///< AVX2 kernels, with SSE2 for the kernels that have no AVX2 version
+    PixelNeon    ///< NEON kernels
+};
+
+////////////////////////////////////////////////////////////
+/// \brief Check whether the kernels can use an instruction set
+///
+/// \param instructionSet Instruction set to check
+///
+/// \return True if the kernels were compiled for it and the CPU supports it
+///
+////////////////////////////////////////////////////////////
+bool isPixelInstructionSetSupported(PixelInstructionSet instructionSet);
+
+////////////////////////////////////////////////////////////
+/// \brief Get the instruction set used by the kernels
+///
+/// By default, it is the best one supported by the CPU.
+///
+/// \return Current instruction set
+///
+////////////////////////////////////////////////////////////
+PixelInstructionSet getPixelInstructionSet();
+
+////////////////////////////////////////////////////////////
+/// \brief Change the instruction set used by the kernels
+///
+/// This exists so that the vector kernels can be compared
+/// with the scalar ones in tests and benchmarks; it must not
+/// be called while kernels are running in other threads.
+/// Unsupported instruction sets are ignored.
+///
+/// \param instructionSet New instruction set
+///
+////////////////////////////////////////////////////////////
+void setPixelInstructionSet(PixelInstructionSet instructionSet);
+
+////////////////////////////////////////////////////////////
+/// \brief Fill RGBA pixels with a single color
+///
+/// \param pixels Pixels to fill
+/// \param count  Number of pixels
+/// \param color  RGBA components of the color
+///
+////////////////////////////////////////////////////////////
+void fillPixels(Uint8* pixels, std::size_t count, const Uint8* color);
+
+////////////////////////////////////////////////////////////
+/// \brief Blend RGBA pixels over others using the source alpha
+///
+/// The result is exactly the one of the reference formula:
+/// `dst = (src * a + dst * (255 - a)) / 255` for the color
+/// components, and `a + dst * (255 - a) / 255` for the alpha.
+///
+/// \param destination Pixels to blend onto
+/// \param source      Pixels to blend
+/// \param count       Number of pixels
+///
+////////////////////////////////////////////////////////////
+void blendPixels(Uint8* destination, const Uint8* source, std::size_t count);
+
+////////////////////////////////////////////////////////////
+/// \brief Multiply RGBA pixels by a color
+///
+/// Each component becomes `pixel * color / 255` (rounded
+/// down), which is what OpenGL's texture modulation gives.
+///
+/// \param pixels Pixels to modulate
+/// \param count  Number of pixels
+/// \param color  RGBA components of the color
+///
+////////////////////////////////////////////////////////////
+void modulatePixels(Uint8* pixels, std::size_t count, const Uint8* color);
+
+////////////////////////////////////////////////////////////
+/// \brief Fill RGBA pixels with a linear color gradient
+///
+/// The components of each pixel are the ones of the previous
+/// pixel plus \a step, starting from \a color. They are
+/// rounded to the nearest integer and saturated to [0, 255].
+///
+/// \param pixels Pixels to fill
+/// \param count  Number of pixels
+/// \param color  RGBA components of the first pixel
+/// \param step   Change of the components from one pixel to the next
+///
+////////////////////////////////////////////////////////////
+void interpolatePixels(Uint8* pixels, std::size_t count, const float* color, const float* step);
+
+////////////////////////////////////////////////////////////
+/// \brief Replace the alpha of the pixels that match a color
+///
+/// \param pixels Pixels to process
+/// \param count  Number of pixels
+/// \param color  RGBA components of the color to match
+/// \param alpha  New alpha of the matching pixels
+///
+////////////////////////////////////////////////////////////
+void maskPixels(Uint8* pixels, std::size_t count, const Uint8* color, Uint8 alpha);
+
+////////////////////////////////////////////////////////////
+/// \brief Reverse the order of RGBA pixels
+///
+/// \param pixels Pixels to reverse
+/// \param count  Number of pixels
+///
+////////////////////////////////////////////////////////////
+void reversePixels(Uint8* pixels, std::size_t count);
+
+////////////////////////////////////////////////////////////
+/// \brief Exchange the contents of two non-overlapping memory areas
+///
+/// \param first  First area
+/// \param second Second area
+/// \param size   Size of each area, in bytes
+///
+////////////////////////////////////////////////////////////
+void swapBytes(Uint8* first, Uint8* second, std::size_t size);
+
+////////////////////////////////////////////////////////////
+/// \brief Halve the size of an RGBA image with a box filter
+///
+/// Each pixel of the destination is the average of 2x2 pixels
+/// of the source. The size of the destination is
+/// max(width / 2, 1) x max(height / 2, 1).
+///
+/// \param source      Pixels of the source image
+/// \param width       Width of the source image
+/// \param height      Height of the source image
+/// \param destination Pixels of the destination image
+/// \param sRgb        Are the color components sRGB encoded? If so
+///                    they are averaged in linear space
+///
+////////////////////////////////////////////////////////////
+void downsampleBox(const Uint8* source, unsigned int width, unsigned int height, Uint8* destination, bool sRgb);
+
+////////////////////////////////////////////////////////////
+/// \brief Halve the size of an RGBA image with a Kaiser filter
+///
+/// The Kaiser-windowed sinc filter (6 taps per axis) keeps
+/// minified details sharper than the box filter, at a
+/// higher cost. The size of the destination is
+/// max(width / 2, 1) x max(height / 2, 1).
+///
+/// \param source      Pixels of the source image
+/// \param width       Width of the source image
+/// \param height      Height of the source image
+/// \param destination Pixels of the destination image
+/// \param sRgb        Are the color components sRGB encoded? If so
+///                    they are filtered in linear space
+///
+////////////////////////////////////////////////////////////
+void downsampleKaiser(const Uint8* source, unsigned int width, unsigned int height, Uint8* destination, bool sRgb);
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_PIXELKERNELS_HPP
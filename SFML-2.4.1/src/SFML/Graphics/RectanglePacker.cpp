@@ -0,0 +1,156 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2016 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/RectanglePacker.hpp>
+#include <algorithm>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+RectanglePacker::RectanglePacker(unsigned int width, unsigned int height) :
+m_width  (width),
+m_height (height),
+m_skyline(),
+m_used   (0, 0)
+{
+    Segment segment = {0, 0, width};
+    m_skyline.push_back(segment);
+}
+
+
+////////////////////////////////////////////////////////////
+bool RectanglePacker::insert(unsigned int width, unsigned int height, Vector2u& position)
+{
+    if ((width == 0) || (height == 0))
+        return false;
+
+    // Find the segment where the rectangle ends the lowest, then the narrowest
+    std::size_t  bestIndex  = m_skyline.size();
+    unsigned int bestBottom = 0;
+    unsigned int bestWidth  = 0;
+    unsigned int bestY      = 0;
+    for (std::size_t i = 0; i < m_skyline.size(); ++i)
+    {
+        unsigned int y;
+        if (fit(i, width, height, y))
+        {
+            unsigned int bottom = y + height;
+            if ((bestIndex == m_skyline.size()) || (bottom < bestBottom) || ((bottom == bestBottom) && (m_skyline[i].width < bestWidth)))
+            {
+                bestIndex  = i;
+                bestBottom = bottom;
+                bestWidth  = m_skyline[i].width;
+                bestY      = y;
+            }
+        }
+    }
+
+    if (bestIndex == m_skyline.size())
+        return false;
+
+    position.x = m_skyline[bestIndex].x;
+    position.y = bestY;
+
+    // Raise the skyline over the new rectangle
+    Segment segment = {position.x, bestBottom, width};
+    m_skyline.insert(m_skyline.begin() + bestIndex, segment);
+
+    // Shrink or remove the segments that are now covered
+    unsigned int right = position.x + width;
+    std::size_t i = bestIndex + 1;
+    while ((i < m_skyline.size()) && (m_skyline[i].x < right))
+    {
+        unsigned int end = m_skyline[i].x + m_skyline[i].width;
+        if (end <= right)
+        {
+            m_skyline.erase(m_skyline.begin() + i);
+        }
+        else
+        {
+            m_skyline[i].width = end - right;
+            m_skyline[i].x = right;
+            break;
+        }
+    }
+
+    // Merge neighbours of the same height
+    for (std::size_t j = 0; j + 1 < m_skyline.size();)
+    {
+        if (m_skyline[j].y == m_skyline[j + 1].y)
+        {
+            m_skyline[j].width += m_skyline[j + 1].width;
+            m_skyline.erase(m_skyline.begin() + j + 1);
+        }
+        else
+        {
+            ++j;
+        }
+    }
+
+    m_used.x = std::max(m_used.x, right);
+    m_used.y = std::max(m_used.y, bestBottom);
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+Vector2u RectanglePacker::getUsedSize() const
+{
+    return m_used;
+}
+
+
+////////////////////////////////////////////////////////////
+bool RectanglePacker::fit(std::size_t index, unsigned int width, unsigned int height, unsigned int& y) const
+{
+    if (m_skyline[index].x + width > m_width)
+        return false;
+
+    // The rectangle rests on the highest segment it spans
+    y = 0;
+    unsigned int remaining = width;
+    for (std::size_t i = index; remaining > 0; ++i)
+    {
+        // The segments always cover the whole width, so this can't go past the end
+        y = std::max(y, m_skyline[i].y);
+        if (y + height > m_height)
+            return false;
+
+        remaining -= std::min(remaining, m_skyline[i].width);
+    }
+
+    return true;
+}
+
+} // namespace priv
+
+} // namespace sf
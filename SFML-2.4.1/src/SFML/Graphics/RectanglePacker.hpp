@@ -0,0 +1,121 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2016 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_RECTANGLEPACKER_HPP
+#define SFML_RECTANGLEPACKER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/Vector2.hpp>
+#include <vector>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Pack rectangles into a fixed-size area
+///
+/// Uses the skyline bottom-left heuristic: the top edge of the
+/// packed rectangles is kept as a list of horizontal segments,
+/// and each new rectangle goes where its top would be the lowest.
+///
+////////////////////////////////////////////////////////////
+class RectanglePacker
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the packer for an empty area
+    ///
+    /// \param width  Width of the area
+    /// \param height Height of the area
+    ///
+    ////////////////////////////////////////////////////////////
+    RectanglePacker(unsigned int width, unsigned int height);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Find room for a rectangle
+    ///
+    /// \param width    Width of the rectangle
+    /// \param height   Height of the rectangle
+    /// \param position Filled with the top-left corner of the rectangle
+    ///
+    /// \return True if the rectangle was placed, false if there's no room left for it
+    ///
+    ////////////////////////////////////////////////////////////
+    bool insert(unsigned int width, unsigned int height, Vector2u& position);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the size of the area actually covered by the rectangles
+    ///
+    /// \return Bottom-right corner of the bounding box of the packed rectangles
+    ///
+    ////////////////////////////////////////////////////////////
+    Vector2u getUsedSize() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Horizontal segment of the skyline
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Segment
+    {
+        unsigned int x;
+        unsigned int y;
+        unsigned int width;
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Check if a rectangle can start at the given segment
+    ///
+    /// \param index  Index of the segment where the rectangle starts
+    /// \param width  Width of the rectangle
+    /// \param height Height of the rectangle
+    /// \param y      Filled with the top of the rectangle
+    ///
+    /// \return True if the rectangle fits there
+    ///
+    ////////////////////////////////////////////////////////////
+    bool fit(std::size_t index, unsigned int width, unsigned int height, unsigned int& y) const;
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    unsigned int         m_width;   ///< Width of the area
+    unsigned int         m_height;  ///< Height of the area
+    std::vector<Segment> m_skyline; ///< Top edge of the packed rectangles, sorted by x
+    Vector2u             m_used;    ///< Size of the area covered so far
+};
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_RECTANGLEPACKER_HPP
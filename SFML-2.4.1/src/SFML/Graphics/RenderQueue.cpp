@@ -0,0 +1,389 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2016 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/RenderQueue.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <cstring>
+
+
+namespace
+{
+    // Target given to the drawables submitted to a queue; the draws
+    // are recorded by RenderTarget::draw, this class never draws anything
+    class Recorder : public sf::RenderTarget
+    {
+    public:
+
+        virtual sf::Vector2u getSize() const
+        {
+            return sf::Vector2u(0, 0);
+        }
+
+    private:
+
+        virtual bool activate(bool)
+        {
+            return false;
+        }
+    };
+
+    // Layout of the sort keys, from the most significant bits
+    const int layerBits     = 16;
+    const int shaderBits    = 14;
+    const int textureBits   = 20;
+    const int blendModeBits = 12;
+    const int typeBits      = 2;
+
+    // Build the sort key of a draw; indices that don't fit in their
+    // field are wrapped, which only makes the grouping less efficient
+    sf::Uint64 makeKey(int layer, sf::Uint32 shader, sf::Uint32 texture, sf::Uint32 blendMode, sf::Uint32 type)
+    {
+        if (layer < -32768)
+            layer = -32768;
+        if (layer > 32767)
+            layer = 32767;
+
+        sf::Uint64 key = static_cast<sf::Uint64>(layer + 32768);
+        key = (key << shaderBits)    | (shader    & ((1 << shaderBits) - 1));
+        key = (key << textureBits)   | (texture   & ((1 << textureBits) - 1));
+        key = (key << blendModeBits) | (blendMode & ((1 << blendModeBits) - 1));
+        key = (key << typeBits)      | (type      & ((1 << typeBits) - 1));
+
+        return key;
+    }
+
+    // Encode a float so that it sorts as an unsigned integer
+    sf::Uint32 encodeDepth(float depth)
+    {
+        sf::Uint32 bits;
+        std::memcpy(&bits, &depth, sizeof(bits));
+
+        return (bits & 0x80000000) ? ~bits : (bits | 0x80000000);
+    }
+
+    // Append a vertex, transformed
+    void append(std::vector<sf::Vertex>& vertices, const sf::Vertex& vertex, const sf::Transform& transform)
+    {
+        vertices.push_back(sf::Vertex(transform.transformPoint(vertex.position), vertex.color, vertex.texCoords));
+    }
+
+    // Count the state changes between two consecutive draws
+    template <typename T, typename U>
+    std::size_t countChanges(const T& previous, const U& current)
+    {
+        return ((previous.texture != current.texture) || (previous.coordinateType != current.coordinateType) ? 1 : 0) +
+               (previous.shader != current.shader ? 1 : 0) +
+               (previous.blendMode != current.blendMode ? 1 : 0);
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+RenderQueue::RenderQueue() :
+m_recorder     (new Recorder),
+m_layer        (0),
+m_depth        (0.f),
+m_vertices     (),
+m_commands     (),
+m_textureIds   (),
+m_shaderIds    (),
+m_blendModes   (),
+m_sorted       (true),
+m_batchVertices(),
+m_batches      (),
+m_statistics   ()
+{
+    m_recorder->m_queue = this;
+}
+
+
+////////////////////////////////////////////////////////////
+RenderQueue::~RenderQueue()
+{
+    delete m_recorder;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderQueue::add(const Drawable& drawable, const RenderStates& states, int layer, float depth)
+{
+    m_layer = layer;
+    m_depth = depth;
+
+    m_recorder->draw(drawable, states);
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderQueue::add(const Vertex* vertices, std::size_t vertexCount, PrimitiveType type, const RenderStates& states, int layer, float depth)
+{
+    m_layer = layer;
+    m_depth = depth;
+
+    record(vertices, vertexCount, type, states);
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderQueue::clear()
+{
+    m_vertices.clear();
+    m_commands.clear();
+    m_textureIds.clear();
+    m_shaderIds.clear();
+    m_blendModes.clear();
+    m_batchVertices.clear();
+    m_batches.clear();
+    m_sorted = true;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t RenderQueue::getCommandCount() const
+{
+    return m_commands.size();
+}
+
+
+////////////////////////////////////////////////////////////
+RenderQueue::Statistics RenderQueue::getStatistics() const
+{
+    return m_statistics;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderQueue::draw(RenderTarget& target, RenderStates states) const
+{
+    if (!m_sorted)
+        sort();
+
+    for (std::size_t i = 0; i < m_batches.size(); ++i)
+    {
+        const Batch& batch = m_batches[i];
+
+        states.blendMode      = batch.blendMode;
+        states.texture        = batch.texture;
+        states.coordinateType = batch.coordinateType;
+        states.shader         = batch.shader;
+        target.draw(&m_batchVertices[batch.first], batch.count, batch.type, states);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderQueue::record(const Vertex* vertices, std::size_t vertexCount, PrimitiveType type, const RenderStates& states)
+{
+    if (!vertices || (vertexCount == 0))
+        return;
+
+    Command command;
+    command.depth          = encodeDepth(m_depth);
+    command.texture        = states.texture;
+    command.coordinateType = states.coordinateType;
+    command.shader         = states.shader;
+    command.blendMode      = states.blendMode;
+    command.first          = m_vertices.size();
+
+    // Convert the primitives to lists, so that consecutive draws can be merged
+    const Transform& transform = states.transform;
+    switch (type)
+    {
+        case Points:
+        case Lines:
+        case Triangles:
+        {
+            command.type = type;
+            for (std::size_t i = 0; i < vertexCount; ++i)
+                append(m_vertices, vertices[i], transform);
+            break;
+        }
+
+        case LineStrip:
+        {
+            command.type = Lines;
+            for (std::size_t i = 0; i + 1 < vertexCount; ++i)
+            {
+                append(m_vertices, vertices[i], transform);
+                append(m_vertices, vertices[i + 1], transform);
+            }
+            break;
+        }
+
+        case TriangleStrip:
+        {
+            command.type = Triangles;
+            for (std::size_t i = 0; i + 2 < vertexCount; ++i)
+            {
+                append(m_vertices, vertices[i], transform);
+                append(m_vertices, vertices[i + 1], transform);
+                append(m_vertices, vertices[i + 2], transform);
+            }
+            break;
+        }
+
+        case TriangleFan:
+        {
+            command.type = Triangles;
+            for (std::size_t i = 1; i + 1 < vertexCount; ++i)
+            {
+                append(m_vertices, vertices[0], transform);
+                append(m_vertices, vertices[i], transform);
+                append(m_vertices, vertices[i + 1], transform);
+            }
+            break;
+        }
+
+        case Quads:
+        {
+            command.type = Triangles;
+            for (std::size_t i = 0; i + 3 < vertexCount; i += 4)
+            {
+                append(m_vertices, vertices[i], transform);
+                append(m_vertices, vertices[i + 1], transform);
+                append(m_vertices, vertices[i + 2], transform);
+                append(m_vertices, vertices[i], transform);
+                append(m_vertices, vertices[i + 2], transform);
+                append(m_vertices, vertices[i + 3], transform);
+            }
+            break;
+        }
+    }
+
+    command.count = m_vertices.size() - command.first;
+    if (command.count == 0)
+        return;
+
+    // Index the states in order of first use, so that the groups of
+    // draws are executed in the order of their first submission
+    std::pair<const Texture*, int> textureKey(states.texture, states.coordinateType);
+    Uint32 texture = static_cast<Uint32>(m_textureIds.insert(std::make_pair(textureKey, static_cast<Uint32>(m_textureIds.size()))).first->second);
+    Uint32 shader = static_cast<Uint32>(m_shaderIds.insert(std::make_pair(states.shader, static_cast<Uint32>(m_shaderIds.size()))).first->second);
+
+    Uint32 blendMode = 0;
+    while ((blendMode < m_blendModes.size()) && (m_blendModes[blendMode] != states.blendMode))
+        ++blendMode;
+    if (blendMode == m_blendModes.size())
+        m_blendModes.push_back(states.blendMode);
+
+    Uint32 primitive = (command.type == Points) ? 0 : ((command.type == Lines) ? 1 : 2);
+    command.key = makeKey(m_layer, shader, texture, blendMode, primitive);
+
+    m_commands.push_back(command);
+    m_sorted = false;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderQueue::sort() const
+{
+    std::size_t count = m_commands.size();
+
+    // Least significant digit radix sort of the command indices, on the
+    // 32 bits of the depth then the 64 bits of the key, one byte at a
+    // time; each pass is stable, so equal keys keep their submission order
+    std::vector<Uint32> order(count);
+    std::vector<Uint32> buffer(count);
+    for (std::size_t i = 0; i < count; ++i)
+        order[i] = static_cast<Uint32>(i);
+
+    for (int pass = 0; pass < 12; ++pass)
+    {
+        std::size_t histogram[256] = {0};
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const Command& command = m_commands[order[i]];
+            Uint32 digit = (pass < 4) ? ((command.depth >> (pass * 8)) & 0xFF) : static_cast<Uint32>((command.key >> ((pass - 4) * 8)) & 0xFF);
+            histogram[digit]++;
+        }
+
+        // Skip the passes where all the commands have the same digit (most of them, usually)
+        bool trivial = false;
+        for (int digit = 0; digit < 256; ++digit)
+            trivial = trivial || (histogram[digit] == count);
+        if (trivial)
+            continue;
+
+        std::size_t offset = 0;
+        for (int digit = 0; digit < 256; ++digit)
+        {
+            std::size_t size = histogram[digit];
+            histogram[digit] = offset;
+            offset += size;
+        }
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const Command& command = m_commands[order[i]];
+            Uint32 digit = (pass < 4) ? ((command.depth >> (pass * 8)) & 0xFF) : static_cast<Uint32>((command.key >> ((pass - 4) * 8)) & 0xFF);
+            buffer[histogram[digit]++] = order[i];
+        }
+
+        order.swap(buffer);
+    }
+
+    // Merge the consecutive commands that share their states into batches
+    m_batchVertices.clear();
+    m_batches.clear();
+    m_statistics.commandCount = count;
+    m_statistics.stateChanges = 0;
+    m_statistics.submissionStateChanges = 0;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const Command& command = m_commands[order[i]];
+
+        if (i > 0)
+        {
+            m_statistics.stateChanges += countChanges(m_commands[order[i - 1]], command);
+            m_statistics.submissionStateChanges += countChanges(m_commands[i - 1], m_commands[i]);
+        }
+
+        if (m_batches.empty() || (m_batches.back().type != command.type) || countChanges(m_batches.back(), command))
+        {
+            Batch batch;
+            batch.type           = command.type;
+            batch.texture        = command.texture;
+            batch.coordinateType = command.coordinateType;
+            batch.shader         = command.shader;
+            batch.blendMode      = command.blendMode;
+            batch.first          = m_batchVertices.size();
+            batch.count          = 0;
+            m_batches.push_back(batch);
+        }
+
+        m_batchVertices.insert(m_batchVertices.end(), m_vertices.begin() + command.first, m_vertices.begin() + command.first + command.count);
+        m_batches.back().count += command.count;
+    }
+
+    m_statistics.batchCount = m_batches.size();
+    m_sorted = true;
+}
+
+} // namespace sf
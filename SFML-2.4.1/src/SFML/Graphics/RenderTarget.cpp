@@ -27,16 +27,55 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/RenderTarget.hpp>
 #include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/RenderQueue.hpp>
 #include <SFML/Graphics/Shader.hpp>
+#include <SFML/Graphics/SoftwareRasterizer.hpp>
 #include <SFML/Graphics/Texture.hpp>
 #include <SFML/Graphics/VertexArray.hpp>
 #include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/Window/Context.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/Lock.hpp>
 #include <SFML/System/Err.hpp>
 #include <cassert>
 #include <iostream>
+#include <map>
 
 namespace
 {
+    // Mutex to protect ID generation and our context-RenderTarget-map
+    sf::Mutex mutex;
+
+    // Unique identifier, used for identifying RenderTargets when
+    // tracking the currently active RenderTarget within a given context
+    sf::Uint64 getUniqueId()
+    {
+        sf::Lock lock(mutex);
+
+        static sf::Uint64 id = 1; // start at 1, zero is "no RenderTarget"
+
+        return id++;
+    }
+
+    // Map to help us detect whether a different RenderTarget
+    // has been activated within a single context
+    typedef std::map<sf::Uint64, sf::Uint64> ContextRenderTargetMap;
+    ContextRenderTargetMap contextRenderTargetMap;
+
+    // Check if a RenderTarget with the given ID is active in the current context
+    bool isActive(sf::Uint64 id)
+    {
+        sf::Uint64 contextId = sf::Context::getActiveContextId();
+        if (!contextId)
+            return false;
+
+        sf::Lock lock(mutex);
+
+        ContextRenderTargetMap::const_iterator iter = contextRenderTargetMap.find(contextId);
+
+        return (iter != contextRenderTargetMap.end()) && (iter->second == id);
+    }
+
     // Convert an sf::BlendMode::Factor constant to the corresponding OpenGL constant.
     sf::Uint32 factorToGlConstant(sf::BlendMode::Factor blendFactor)
     {
@@ -83,7 +122,10 @@ namespace sf
 RenderTarget::RenderTarget() :
 m_defaultView(),
 m_view       (),
-m_cache      ()
+m_cache      (),
+m_queue      (NULL),
+m_rasterizer (NULL),
+m_id         (getUniqueId())
 {
     m_cache.glStatesSet = false;
 }
@@ -98,7 +140,13 @@ RenderTarget::~RenderTarget()
 ////////////////////////////////////////////////////////////
 void RenderTarget::clear(const Color& color)
 {
-    if (activate(true))
+    if (m_rasterizer)
+    {
+        m_rasterizer->clear(color);
+        return;
+    }
+
+    if (makeActive())
     {
         // Unbind texture to fix RenderTexture preventing clear
         applyTexture(NULL);
@@ -204,6 +252,20 @@ void RenderTarget::draw(const Vertex* vertices, std::size_t vertexCount,
     if (!vertices || (vertexCount == 0))
         return;
 
+    // Draws submitted to a render queue are recorded, to be sorted and executed later
+    if (m_queue)
+    {
+        m_queue->record(vertices, vertexCount, type, states);
+        return;
+    }
+
+    // Software targets rasterize the primitives on the CPU
+    if (m_rasterizer)
+    {
+        m_rasterizer->draw(vertices, vertexCount, type, states, m_view.getTransform(), getViewport(m_view));
+        return;
+    }
+
     // GL_QUADS is unavailable on OpenGL ES
     #ifdef SFML_OPENGL_ES
         if (type == Quads)
@@ -214,12 +276,8 @@ void RenderTarget::draw(const Vertex* vertices, std::size_t vertexCount,
         #define GL_QUADS 0
     #endif
 
-    if (activate(true))
+    if (makeActive())
     {
-        // First set the persistent OpenGL states if it's the very first call
-        if (!m_cache.glStatesSet)
-            resetGLStates();
-
         // Check if the vertex count is low enough so that we can pre-transform them
         bool useVertexCache = (vertexCount <= StatesCache::VertexCacheSize);
         if (useVertexCache)
@@ -232,32 +290,24 @@ void RenderTarget::draw(const Vertex* vertices, std::size_t vertexCount,
                 vertex.color = vertices[i].color;
                 vertex.texCoords = vertices[i].texCoords;
             }
-
-            // Since vertices are transformed, we must use an identity transform to render them
-            if (!m_cache.useVertexCache)
-                applyTransform(Transform::Identity);
         }
-        else
-        {
-            applyTransform(states.transform);
-        }
-
-        // Apply the view
-        if (m_cache.viewChanged)
-            applyCurrentView();
 
-        // Apply the blend mode
-        if (states.blendMode != m_cache.lastBlendMode)
-            applyBlendMode(states.blendMode);
+        setupDraw(useVertexCache, states);
 
-        // Apply the texture
-        Uint64 textureId = states.texture ? states.texture->m_cacheId : 0;
-        if (textureId != m_cache.lastTextureId)
-            applyTexture(states.texture);
-
-        // Apply the shader
-        if (states.shader)
-            applyShader(states.shader);
+        // Instead of loading another texture matrix, the texture coordinates of
+        // pre-transformed vertices are adjusted to the one that is loaded
+        // (shaders may read the coordinates without the matrix, so they always get it)
+        if (useVertexCache && !states.shader && (m_cache.textureMatrix != m_cache.loadedTextureMatrix))
+        {
+            const Vector3f& required = m_cache.textureMatrix;
+            const Vector3f& loaded = m_cache.loadedTextureMatrix;
+            for (std::size_t i = 0; i < vertexCount; ++i)
+            {
+                Vector2f& texCoords = m_cache.vertexCache[i].texCoords;
+                texCoords.x = texCoords.x * required.x / loaded.x;
+                texCoords.y = (texCoords.y * required.y + required.z - loaded.z) / loaded.y;
+            }
+        }
 
         // If we pre-transform the vertices, we must use our internal vertex cache
         if (useVertexCache)
@@ -286,14 +336,7 @@ void RenderTarget::draw(const Vertex* vertices, std::size_t vertexCount,
         // Draw the primitives
         glCheck(glDrawArrays(mode, 0, vertexCount));
 
-        // Unbind the shader, if any
-        if (states.shader)
-            applyShader(NULL);
-
-        // If the texture we used to draw belonged to a RenderTexture, then forcibly unbind that texture.
-        // This prevents a bug where some drivers do not clear RenderTextures properly.
-        if (states.texture && states.texture->m_fboAttachment)
-            applyTexture(NULL);
+        cleanupDraw(states);
 
         // Update the cache
         m_cache.useVertexCache = useVertexCache;
@@ -301,10 +344,41 @@ void RenderTarget::draw(const Vertex* vertices, std::size_t vertexCount,
 }
 
 
+////////////////////////////////////////////////////////////
+bool RenderTarget::setActive(bool active)
+{
+    Uint64 contextId = Context::getActiveContextId();
+    if (!contextId)
+        return true;
+
+    // Mark this target as active or no longer active in the tracking map
+    Lock lock(mutex);
+
+    ContextRenderTargetMap::iterator iter = contextRenderTargetMap.find(contextId);
+
+    if (active)
+    {
+        if ((iter == contextRenderTargetMap.end()) || (iter->second != m_id))
+        {
+            contextRenderTargetMap[contextId] = m_id;
+
+            // Another target may have changed the OpenGL states of the context
+            m_cache.glStatesSet = false;
+        }
+    }
+    else if ((iter != contextRenderTargetMap.end()) && (iter->second == m_id))
+    {
+        contextRenderTargetMap.erase(iter);
+    }
+
+    return true;
+}
+
+
 ////////////////////////////////////////////////////////////
 void RenderTarget::pushGLStates()
 {
-    if (activate(true))
+    if (makeActive())
     {
         #ifdef SFML_DEBUG
             // make sure that the user didn't leave an unchecked OpenGL error
@@ -336,7 +410,7 @@ void RenderTarget::pushGLStates()
 ////////////////////////////////////////////////////////////
 void RenderTarget::popGLStates()
 {
-    if (activate(true))
+    if (makeActive())
     {
         glCheck(glMatrixMode(GL_PROJECTION));
         glCheck(glPopMatrix());
@@ -348,6 +422,9 @@ void RenderTarget::popGLStates()
             glCheck(glPopClientAttrib());
             glCheck(glPopAttrib());
         #endif
+
+        // The texture matrix is the user's one again
+        m_cache.loadedTextureMatrix = Vector3f();
     }
 }
 
@@ -355,10 +432,14 @@ void RenderTarget::popGLStates()
 ////////////////////////////////////////////////////////////
 void RenderTarget::resetGLStates()
 {
-    // Check here to make sure a context change does not happen after activate(true)
+    // Software targets have no OpenGL states
+    if (m_rasterizer)
+        return;
+
+    // Check here to make sure a context change does not happen after makeActive()
     bool shaderAvailable = Shader::isAvailable();
 
-    if (activate(true))
+    if (makeActive())
     {
         // Make sure that extensions are initialized
         priv::ensureExtensionsInit();
@@ -387,6 +468,7 @@ void RenderTarget::resetGLStates()
         applyBlendMode(BlendAlpha);
         applyTransform(Transform::Identity);
         applyTexture(NULL);
+        applyTextureMatrix();
         if (shaderAvailable)
             applyShader(NULL);
 
@@ -410,6 +492,74 @@ void RenderTarget::initialize()
 }
 
 
+////////////////////////////////////////////////////////////
+bool RenderTarget::makeActive()
+{
+    return isActive(m_id) || activate(true);
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::setupDraw(bool useVertexCache, const RenderStates& states)
+{
+    // First set the persistent OpenGL states if it's the very first call
+    if (!m_cache.glStatesSet)
+        resetGLStates();
+
+    if (useVertexCache)
+    {
+        // Since vertices are transformed, we must use an identity transform to render them
+        if (!m_cache.useVertexCache)
+            applyTransform(Transform::Identity);
+    }
+    else
+    {
+        applyTransform(states.transform);
+    }
+
+    // Apply the view
+    if (m_cache.viewChanged)
+        applyCurrentView();
+
+    // Apply the blend mode
+    if (states.blendMode != m_cache.lastBlendMode)
+        applyBlendMode(states.blendMode);
+
+    // Apply the texture
+    Uint64 textureId = states.texture ? states.texture->m_cacheId : 0;
+    if ((textureId != m_cache.lastTextureId) || (states.coordinateType != m_cache.lastCoordinateType))
+        applyTexture(states.texture, states.coordinateType);
+
+    // Most textures require the same texture matrix (same size, or normalized
+    // coordinates), so it is only loaded when it changes; pre-transformed vertices
+    // without shader and untextured draws don't even need it
+    if (m_cache.textureMatrix != m_cache.loadedTextureMatrix)
+    {
+        bool unknown = (m_cache.loadedTextureMatrix.x == 0.f);
+        if (unknown || states.shader || (!useVertexCache && states.texture))
+            applyTextureMatrix();
+    }
+
+    // Apply the shader
+    if (states.shader)
+        applyShader(states.shader);
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::cleanupDraw(const RenderStates& states)
+{
+    // Unbind the shader, if any
+    if (states.shader)
+        applyShader(NULL);
+
+    // If the texture we used to draw belonged to a RenderTexture, then forcibly unbind that texture.
+    // This prevents a bug where some drivers do not clear RenderTextures properly.
+    if (states.texture && states.texture->m_fboAttachment)
+        applyTexture(NULL);
+}
+
+
 ////////////////////////////////////////////////////////////
 void RenderTarget::applyCurrentView()
 {
@@ -487,11 +637,55 @@ void RenderTarget::applyTransform(const Transform& transform)
 
 
 ////////////////////////////////////////////////////////////
-void RenderTarget::applyTexture(const Texture* texture)
+void RenderTarget::applyTexture(const Texture* texture, Texture::CoordinateType coordinateType)
 {
-    Texture::bind(texture, Texture::Pixels);
+    Vector3f matrix(1.f, 1.f, 0.f);
+
+    if (texture && texture->m_texture)
+    {
+        glCheck(glBindTexture(GL_TEXTURE_2D, texture->m_texture));
+
+        // Coordinates in pixels are scaled from the range [0 .. size] to [0 .. 1]
+        if (coordinateType == Texture::Pixels)
+        {
+            matrix.x = 1.f / texture->m_actualSize.x;
+            matrix.y = 1.f / texture->m_actualSize.y;
+        }
+
+        // If pixels are flipped we must invert the Y axis
+        if (texture->m_pixelsFlipped)
+        {
+            matrix.y = -matrix.y;
+            matrix.z = static_cast<float>(texture->m_size.y) / texture->m_actualSize.y;
+        }
+    }
+    else
+    {
+        glCheck(glBindTexture(GL_TEXTURE_2D, 0));
+    }
 
     m_cache.lastTextureId = texture ? texture->m_cacheId : 0;
+    m_cache.lastCoordinateType = coordinateType;
+    m_cache.textureMatrix = matrix;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::applyTextureMatrix()
+{
+    const Vector3f& matrix = m_cache.textureMatrix;
+    GLfloat values[16] = {matrix.x, 0.f,      0.f, 0.f,
+                          0.f,      matrix.y, 0.f, 0.f,
+                          0.f,      0.f,      1.f, 0.f,
+                          0.f,      matrix.z, 0.f, 1.f};
+
+    glCheck(glMatrixMode(GL_TEXTURE));
+    glCheck(glLoadMatrixf(values));
+
+    // Go back to model-view mode (sf::RenderTarget relies on it)
+    glCheck(glMatrixMode(GL_MODELVIEW));
+
+    m_cache.loadedTextureMatrix = matrix;
 }
 
 
@@ -531,6 +725,12 @@ void RenderTarget::applyShader(const Shader* shader)
 //   both the pointer and the OpenGL ID might be recycled in
 //   a new texture instance. We need to use our own unique
 //   identifier system to ensure consistent caching.
+//   The texture matrix (which converts pixels to normalized
+//   coordinates) only depends on the size of the texture, so
+//   it is cached separately and reloaded only when a draw
+//   needs a different one. Pre-transformed vertices have
+//   their texture coordinates adjusted to the loaded matrix
+//   instead, so interleaved sprites never reload it.
 //
 // * Shader
 //   Shaders are very hard to optimize, because they have
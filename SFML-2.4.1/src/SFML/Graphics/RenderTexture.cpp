@@ -126,7 +126,19 @@ bool RenderTexture::generateMipmap()
 ////////////////////////////////////////////////////////////
 bool RenderTexture::setActive(bool active)
 {
-    return m_impl && m_impl->activate(active);
+    if (!m_impl)
+        return false;
+
+    // The context must still be active to stop tracking the texture in it
+    if (!active)
+        RenderTarget::setActive(false);
+
+    bool result = m_impl->activate(active);
+
+    if (result && active)
+        RenderTarget::setActive(true);
+
+    return result;
 }
 
 
@@ -28,7 +28,107 @@
 #include <SFML/Graphics/RenderTextureImplFBO.hpp>
 #include <SFML/Graphics/Texture.hpp>
 #include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/Lock.hpp>
 #include <SFML/System/Err.hpp>
+#include <utility>
+#include <set>
+
+
+namespace
+{
+    sf::Mutex isAvailableMutex;
+
+    // Mutex to protect the pools and the frame buffers waiting for their context
+    sf::Mutex mutex;
+
+    // Frame buffers can't be shared between contexts: the released ones are pooled per
+    // context, and the ones released while their context is not active wait for it
+    typedef std::multimap<sf::Uint64, unsigned int> FrameBufferPool;
+    FrameBufferPool frameBufferPool;
+    FrameBufferPool staleFrameBuffers;
+
+    // Depth buffers are shared between contexts, and all have the same format: they are pooled by size
+    typedef std::multimap<std::pair<unsigned int, unsigned int>, unsigned int> DepthBufferPool;
+    DepthBufferPool depthBufferPool;
+
+    // Frame buffers of the live render textures, to forget the ones of the contexts that are destroyed
+    typedef std::map<sf::Uint64, unsigned int> FrameBufferMap;
+    std::set<FrameBufferMap*> frameBufferMaps;
+
+    // Maximum number of frame buffers pooled per context, and of depth buffers pooled in total
+    const std::size_t maxPooledFrameBuffers = 16;
+    const std::size_t maxPooledDepthBuffers = 16;
+
+    // Detach the texture and the depth buffer of a frame buffer of the active context, and pool it
+    void releaseFrameBuffer(sf::Uint64 contextId, unsigned int frameBuffer)
+    {
+        GLuint buffer = static_cast<GLuint>(frameBuffer);
+
+        if (frameBufferPool.count(contextId) >= maxPooledFrameBuffers)
+        {
+            glCheck(GLEXT_glDeleteFramebuffers(1, &buffer));
+            return;
+        }
+
+        // Make sure that the frame buffer binding will be preserved
+        GLint previous = 0;
+        glCheck(glGetIntegerv(GLEXT_GL_FRAMEBUFFER_BINDING, &previous));
+
+        glCheck(GLEXT_glBindFramebuffer(GLEXT_GL_FRAMEBUFFER, buffer));
+        glCheck(GLEXT_glFramebufferTexture2D(GLEXT_GL_FRAMEBUFFER, GLEXT_GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, 0, 0));
+        glCheck(GLEXT_glFramebufferRenderbuffer(GLEXT_GL_FRAMEBUFFER, GLEXT_GL_DEPTH_ATTACHMENT, GLEXT_GL_RENDERBUFFER, 0));
+        glCheck(GLEXT_glBindFramebuffer(GLEXT_GL_FRAMEBUFFER, (static_cast<GLuint>(previous) == buffer) ? 0 : static_cast<GLuint>(previous)));
+
+        frameBufferPool.insert(std::make_pair(contextId, frameBuffer));
+    }
+
+    // Release the frame buffers that were waiting for the active context
+    void releaseStaleFrameBuffers(sf::Uint64 contextId)
+    {
+        std::pair<FrameBufferPool::iterator, FrameBufferPool::iterator> range = staleFrameBuffers.equal_range(contextId);
+
+        for (FrameBufferPool::iterator it = range.first; it != range.second; ++it)
+            releaseFrameBuffer(contextId, it->second);
+
+        staleFrameBuffers.erase(range.first, range.second);
+    }
+
+    // Delete the frame buffers of a context that is being destroyed (it is active)
+    void destroyContextFrameBuffers(void*)
+    {
+        sf::Uint64 contextId = sf::Context::getActiveContextId();
+
+        sf::Lock lock(mutex);
+
+        // The pooled and the stale frame buffers of the context
+        FrameBufferPool* pools[] = {&frameBufferPool, &staleFrameBuffers};
+        for (std::size_t i = 0; i < 2; ++i)
+        {
+            std::pair<FrameBufferPool::iterator, FrameBufferPool::iterator> range = pools[i]->equal_range(contextId);
+
+            for (FrameBufferPool::iterator it = range.first; it != range.second; ++it)
+            {
+                GLuint frameBuffer = static_cast<GLuint>(it->second);
+                glCheck(GLEXT_glDeleteFramebuffers(1, &frameBuffer));
+            }
+
+            pools[i]->erase(range.first, range.second);
+        }
+
+        // The frame buffers that the live render textures own in the context
+        for (std::set<FrameBufferMap*>::iterator it = frameBufferMaps.begin(); it != frameBufferMaps.end(); ++it)
+        {
+            FrameBufferMap::iterator frameBufferIt = (*it)->find(contextId);
+            if (frameBufferIt != (*it)->end())
+            {
+                GLuint frameBuffer = static_cast<GLuint>(frameBufferIt->second);
+                glCheck(GLEXT_glDeleteFramebuffers(1, &frameBuffer));
+                (*it)->erase(frameBufferIt);
+            }
+        }
+    }
+}
 
 
 namespace sf
@@ -38,33 +138,75 @@ namespace priv
 ////////////////////////////////////////////////////////////
 RenderTextureImplFBO::RenderTextureImplFBO() :
 m_context    (NULL),
-m_frameBuffer(0),
+m_contextId  (0),
+m_textureId  (0),
+m_width      (0),
+m_height     (0),
 m_depthBuffer(0)
 {
+    // Register the callback that forgets the frame buffers of destroyed contexts
+    registerContextDestroyCallback(destroyContextFrameBuffers, NULL);
+
+    Lock lock(mutex);
 
+    frameBufferMaps.insert(&m_frameBuffers);
 }
 
 
 ////////////////////////////////////////////////////////////
 RenderTextureImplFBO::~RenderTextureImplFBO()
 {
-    m_context->setActive(true);
+    TransientContextLock contextLock;
 
-    // Destroy the depth buffer
-    if (m_depthBuffer)
-    {
-        GLuint depthBuffer = static_cast<GLuint>(m_depthBuffer);
-        glCheck(GLEXT_glDeleteRenderbuffers(1, &depthBuffer));
-    }
+    Uint64 contextId = Context::getActiveContextId();
 
-    // Destroy the frame buffer
-    if (m_frameBuffer)
     {
-        GLuint frameBuffer = static_cast<GLuint>(m_frameBuffer);
-        glCheck(GLEXT_glDeleteFramebuffers(1, &frameBuffer));
+        Lock lock(mutex);
+
+        // Our frame buffers are released here, not when their context is destroyed
+        frameBufferMaps.erase(&m_frameBuffers);
+
+        // Release the frame buffers: the ones of the active context now, the other ones when their context is active
+        for (std::map<Uint64, unsigned int>::const_iterator it = m_frameBuffers.begin(); it != m_frameBuffers.end(); ++it)
+        {
+            // The frame buffers of our own context are destroyed with it
+            if (m_context && (it->first == m_contextId))
+                continue;
+
+            if (it->first == contextId)
+                releaseFrameBuffer(contextId, it->second);
+            else
+                staleFrameBuffers.insert(*it);
+        }
+
+        // Pool the depth buffer, or destroy it if the pool is full or if we are the last render texture
+        if (m_depthBuffer)
+        {
+            if (!frameBufferMaps.empty() && (depthBufferPool.size() < maxPooledDepthBuffers))
+            {
+                depthBufferPool.insert(std::make_pair(std::make_pair(m_width, m_height), m_depthBuffer));
+            }
+            else
+            {
+                GLuint depthBuffer = static_cast<GLuint>(m_depthBuffer);
+                glCheck(GLEXT_glDeleteRenderbuffers(1, &depthBuffer));
+            }
+        }
+
+        // Nobody will reuse the pooled depth buffers once the last render texture is gone
+        if (frameBufferMaps.empty())
+        {
+            for (DepthBufferPool::iterator it = depthBufferPool.begin(); it != depthBufferPool.end(); ++it)
+            {
+                GLuint depthBuffer = static_cast<GLuint>(it->second);
+                glCheck(GLEXT_glDeleteRenderbuffers(1, &depthBuffer));
+            }
+
+            depthBufferPool.clear();
+        }
     }
 
-    // Delete the context
+    // Delete our own context
     delete m_context;
 }
 
@@ -72,50 +214,116 @@ RenderTextureImplFBO::~RenderTextureImplFBO()
 ////////////////////////////////////////////////////////////
 bool RenderTextureImplFBO::isAvailable()
 {
-    TransientContextLock lock;
+    Lock lock(isAvailableMutex);
 
-    // Make sure that extensions are initialized
-    priv::ensureExtensionsInit();
+    static bool checked = false;
+    static bool available = false;
 
-    return GLEXT_framebuffer_object != 0;
+    if (!checked)
+    {
+        checked = true;
+
+        TransientContextLock contextLock;
+
+        // Make sure that extensions are initialized
+        priv::ensureExtensionsInit();
+
+        available = GLEXT_framebuffer_object != 0;
+    }
+
+    return available;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTextureImplFBO::unbind()
+{
+    glCheck(GLEXT_glBindFramebuffer(GLEXT_GL_FRAMEBUFFER, 0));
 }
 
 
 ////////////////////////////////////////////////////////////
 bool RenderTextureImplFBO::create(unsigned int width, unsigned int height, unsigned int textureId, bool depthBuffer)
 {
-    // Create the context
-    m_context = new Context;
+    m_textureId = textureId;
+    m_width = width;
+    m_height = height;
 
-    // Create the framebuffer object
-    GLuint frameBuffer = 0;
-    glCheck(GLEXT_glGenFramebuffers(1, &frameBuffer));
-    m_frameBuffer = static_cast<unsigned int>(frameBuffer);
-    if (!m_frameBuffer)
+    // Render through the active context if there is one, otherwise create our own
+    Uint64 contextId = Context::getActiveContextId();
+    if (!contextId)
     {
-        err() << "Impossible to create render texture (failed to create the frame buffer object)" << std::endl;
-        return false;
+        m_context = new Context;
+        m_contextId = contextId = Context::getActiveContextId();
     }
-    glCheck(GLEXT_glBindFramebuffer(GLEXT_GL_FRAMEBUFFER, m_frameBuffer));
 
-    // Create the depth buffer if requested
+    Lock lock(mutex);
+
+    // Create the depth buffer if requested, or reuse a released one of the same size
     if (depthBuffer)
     {
-        GLuint depth = 0;
-        glCheck(GLEXT_glGenRenderbuffers(1, &depth));
-        m_depthBuffer = static_cast<unsigned int>(depth);
-        if (!m_depthBuffer)
+        DepthBufferPool::iterator it = depthBufferPool.find(std::make_pair(width, height));
+        if (it != depthBufferPool.end())
+        {
+            m_depthBuffer = it->second;
+            depthBufferPool.erase(it);
+        }
+        else
         {
-            err() << "Impossible to create render texture (failed to create the attached depth buffer)" << std::endl;
+            GLuint depth = 0;
+            glCheck(GLEXT_glGenRenderbuffers(1, &depth));
+            m_depthBuffer = static_cast<unsigned int>(depth);
+            if (!m_depthBuffer)
+            {
+                err() << "Impossible to create render texture (failed to create the attached depth buffer)" << std::endl;
+                return false;
+            }
+            glCheck(GLEXT_glBindRenderbuffer(GLEXT_GL_RENDERBUFFER, m_depthBuffer));
+            glCheck(GLEXT_glRenderbufferStorage(GLEXT_GL_RENDERBUFFER, GLEXT_GL_DEPTH_COMPONENT, width, height));
+        }
+    }
+
+    // The context may be the one of another target: make sure that its frame buffer binding will be preserved
+    GLint previous = 0;
+    glCheck(glGetIntegerv(GLEXT_GL_FRAMEBUFFER_BINDING, &previous));
+
+    // Creating the frame buffer of the context checks that the texture can be rendered to
+    bool result = createFrameBuffer(contextId);
+
+    glCheck(GLEXT_glBindFramebuffer(GLEXT_GL_FRAMEBUFFER, static_cast<GLuint>(previous)));
+
+    return result;
+}
+
+
+////////////////////////////////////////////////////////////
+bool RenderTextureImplFBO::createFrameBuffer(Uint64 contextId)
+{
+    // Reuse a released frame buffer of the context, or create a new one
+    GLuint frameBuffer = 0;
+    FrameBufferPool::iterator it = frameBufferPool.find(contextId);
+    if (it != frameBufferPool.end())
+    {
+        frameBuffer = static_cast<GLuint>(it->second);
+        frameBufferPool.erase(it);
+    }
+    else
+    {
+        glCheck(GLEXT_glGenFramebuffers(1, &frameBuffer));
+        if (!frameBuffer)
+        {
+            err() << "Impossible to create render texture (failed to create the frame buffer object)" << std::endl;
             return false;
         }
-        glCheck(GLEXT_glBindRenderbuffer(GLEXT_GL_RENDERBUFFER, m_depthBuffer));
-        glCheck(GLEXT_glRenderbufferStorage(GLEXT_GL_RENDERBUFFER, GLEXT_GL_DEPTH_COMPONENT, width, height));
-        glCheck(GLEXT_glFramebufferRenderbuffer(GLEXT_GL_FRAMEBUFFER, GLEXT_GL_DEPTH_ATTACHMENT, GLEXT_GL_RENDERBUFFER, m_depthBuffer));
     }
 
-    // Link the texture to the frame buffer
-    glCheck(GLEXT_glFramebufferTexture2D(GLEXT_GL_FRAMEBUFFER, GLEXT_GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, textureId, 0));
+    m_frameBuffers[contextId] = static_cast<unsigned int>(frameBuffer);
+    glCheck(GLEXT_glBindFramebuffer(GLEXT_GL_FRAMEBUFFER, frameBuffer));
+
+    // Link the depth buffer, if any, and the texture to the frame buffer
+    if (m_depthBuffer)
+        glCheck(GLEXT_glFramebufferRenderbuffer(GLEXT_GL_FRAMEBUFFER, GLEXT_GL_DEPTH_ATTACHMENT, GLEXT_GL_RENDERBUFFER, m_depthBuffer));
+    glCheck(GLEXT_glFramebufferTexture2D(GLEXT_GL_FRAMEBUFFER, GLEXT_GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_textureId, 0));
 
     // A final check, just to be sure...
     GLenum status;
@@ -134,7 +342,43 @@ bool RenderTextureImplFBO::create(unsigned int width, unsigned int height, unsig
 ////////////////////////////////////////////////////////////
 bool RenderTextureImplFBO::activate(bool active)
 {
-    return m_context->setActive(active);
+    if (!active)
+    {
+        // Render to the default frame buffer of the active context again
+        if (Context::getActiveContextId())
+            unbind();
+
+        // Deactivate our own context if it is the active one
+        if (m_context && (Context::getActiveContextId() == m_contextId))
+            return m_context->setActive(false);
+
+        return true;
+    }
+
+    // Render through the active context if there is one, otherwise use our own
+    Uint64 contextId = Context::getActiveContextId();
+    if (!contextId)
+    {
+        if (!m_context)
+            m_context = new Context;
+        else if (!m_context->setActive(true))
+            return false;
+
+        m_contextId = contextId = Context::getActiveContextId();
+    }
+
+    Lock lock(mutex);
+
+    releaseStaleFrameBuffers(contextId);
+
+    // Frame buffers are not shared: the first activation in a context creates its own
+    std::map<Uint64, unsigned int>::const_iterator it = m_frameBuffers.find(contextId);
+    if (it == m_frameBuffers.end())
+        return createFrameBuffer(contextId);
+
+    glCheck(GLEXT_glBindFramebuffer(GLEXT_GL_FRAMEBUFFER, it->second));
+
+    return true;
 }
 
 
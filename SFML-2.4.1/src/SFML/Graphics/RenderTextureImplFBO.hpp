@@ -31,6 +31,7 @@
 #include <SFML/Graphics/RenderTextureImpl.hpp>
 #include <SFML/Window/Context.hpp>
 #include <SFML/Window/GlResource.hpp>
+#include <map>
 
 
 namespace sf
@@ -66,6 +67,15 @@ public:
     ////////////////////////////////////////////////////////////
     static bool isAvailable();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Unbind the currently bound FBO
+    ///
+    /// Rendering then goes to the default frame buffer of
+    /// the active context.
+    ///
+    ////////////////////////////////////////////////////////////
+    static void unbind();
+
 private:
 
     ////////////////////////////////////////////////////////////
@@ -99,12 +109,29 @@ private:
     ////////////////////////////////////////////////////////////
     virtual void updateTexture(unsigned textureId);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Create the frame buffer object of the active context
+    ///
+    /// A released frame buffer of the context is reused if
+    /// there is one.
+    ///
+    /// \param contextId Identifier of the active context
+    ///
+    /// \return True if the frame buffer is complete
+    ///
+    ////////////////////////////////////////////////////////////
+    bool createFrameBuffer(Uint64 contextId);
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    Context*     m_context;     ///< Needs a separate OpenGL context for not messing up the other ones
-    unsigned int m_frameBuffer; ///< OpenGL frame buffer object
-    unsigned int m_depthBuffer; ///< Optional depth buffer attached to the frame buffer
+    std::map<Uint64, unsigned int> m_frameBuffers; ///< OpenGL frame buffer objects, one per context that rendered to the texture
+    Context*                       m_context;      ///< Context used when no other one is active, if any
+    Uint64                         m_contextId;    ///< Identifier of m_context
+    unsigned int                   m_textureId;    ///< OpenGL identifier of the target texture
+    unsigned int                   m_width;        ///< Width of the target texture
+    unsigned int                   m_height;       ///< Height of the target texture
+    unsigned int                   m_depthBuffer;  ///< Optional depth buffer attached to the frame buffers
 };
 
 } // namespace priv
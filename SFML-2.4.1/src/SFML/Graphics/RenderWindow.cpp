@@ -27,6 +27,7 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/RenderWindow.hpp>
 #include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/RenderTextureImplFBO.hpp>
 
 
 namespace sf
@@ -75,6 +76,29 @@ Vector2u RenderWindow::getSize() const
 }
 
 
+////////////////////////////////////////////////////////////
+bool RenderWindow::setActive(bool active)
+{
+    // The context must still be active to stop tracking the window in it
+    if (!active)
+        RenderTarget::setActive(false);
+
+    bool result = Window::setActive(active);
+
+    if (result && active)
+    {
+        // If FBOs are available, make sure none are bound when we
+        // try to draw to the default framebuffer of the window
+        if (priv::RenderTextureImplFBO::isAvailable())
+            priv::RenderTextureImplFBO::unbind();
+
+        RenderTarget::setActive(true);
+    }
+
+    return result;
+}
+
+
 ////////////////////////////////////////////////////////////
 Image RenderWindow::capture() const
 {
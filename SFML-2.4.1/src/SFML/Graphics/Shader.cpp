@@ -27,6 +27,7 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/Shader.hpp>
+#include <SFML/Graphics/DiskCache.hpp>
 #include <SFML/Graphics/Texture.hpp>
 #include <SFML/Graphics/Transform.hpp>
 #include <SFML/Graphics/Color.hpp>
@@ -35,7 +36,10 @@
 #include <SFML/System/InputStream.hpp>
 #include <SFML/System/Mutex.hpp>
 #include <SFML/System/Lock.hpp>
+#include <SFML/System/Clock.hpp>
 #include <SFML/System/Err.hpp>
+#include <algorithm>
+#include <cstring>
 #include <fstream>
 #include <vector>
 
@@ -59,6 +63,17 @@ namespace
     sf::Mutex maxTextureUnitsMutex;
     sf::Mutex isAvailableMutex;
 
+    sf::DiskCache* programCache = NULL;
+
+    // Types of the staged uniform values, they select the function that uploads them
+    enum UniformType
+    {
+        FloatUniform,   // glUniform[1-4]fv, depending on the number of components
+        IntUniform,     // glUniform[1-4]i, depending on the number of components
+        Matrix3Uniform, // glUniformMatrix3fv
+        Matrix4Uniform  // glUniformMatrix4fv
+    };
+
     GLint checkMaxTextureUnits()
     {
         GLint maxUnits = 0;
@@ -197,6 +212,10 @@ struct Shader::UniformBinder : private NonCopyable
 
             // Store uniform location for further use outside constructor
             location = shader.getUniformLocation(name);
+
+            // The value set by name replaces the one staged in the slot of the uniform
+            if (location != -1)
+                shader.discardStagedUniform(location);
         }
     }
 
@@ -223,7 +242,9 @@ Shader::Shader() :
 m_shaderProgram (0),
 m_currentTexture(-1),
 m_textures      (),
-m_uniforms      ()
+m_uniforms      (),
+m_slots         (),
+m_dirtySlots    ()
 {
 }
 
@@ -550,27 +571,7 @@ void Shader::setUniform(const std::string& name, const Texture& texture)
         // Find the location of the variable in the shader
         int location = getUniformLocation(name);
         if (location != -1)
-        {
-            // Store the location -> texture mapping
-            TextureTable::iterator it = m_textures.find(location);
-            if (it == m_textures.end())
-            {
-                // New entry, make sure there are enough texture units
-                GLint maxUnits = getMaxTextureUnits();
-                if (m_textures.size() + 1 >= static_cast<std::size_t>(maxUnits))
-                {
-                    err() << "Impossible to use texture \"" << name << "\" for shader: all available texture units are used" << std::endl;
-                    return;
-                }
-
-                m_textures[location] = &texture;
-            }
-            else
-            {
-                // Location already used, just replace the texture
-                it->second = &texture;
-            }
-        }
+            setTextureUniform(location, texture, name);
     }
 }
 
@@ -660,6 +661,215 @@ void Shader::setUniformArray(const std::string& name, const Glsl::Mat4* matrixAr
 }
 
 
+////////////////////////////////////////////////////////////
+Shader::UniformHandle Shader::getUniformHandle(const std::string& name)
+{
+    if (!m_shaderProgram)
+        return -1;
+
+    // Reuse the slot of the uniform if it already has one
+    for (std::size_t i = 0; i < m_slots.size(); ++i)
+    {
+        if (m_slots[i].name == name)
+            return static_cast<UniformHandle>(i);
+    }
+
+    TransientContextLock lock;
+
+    int location = getUniformLocation(name);
+    if (location == -1)
+        return -1;
+
+    UniformSlot slot;
+    slot.name     = name;
+    slot.location = location;
+    slot.type     = -1;
+    slot.count    = 0;
+    slot.dirty    = false;
+    m_slots.push_back(slot);
+
+    return static_cast<UniformHandle>(m_slots.size() - 1);
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, float x)
+{
+    stageUniform(handle, FloatUniform, &x, NULL, 1, 1);
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, const Glsl::Vec2& v)
+{
+    const float values[] = {v.x, v.y};
+    stageUniform(handle, FloatUniform, values, NULL, 2, 1);
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, const Glsl::Vec3& v)
+{
+    const float values[] = {v.x, v.y, v.z};
+    stageUniform(handle, FloatUniform, values, NULL, 3, 1);
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, const Glsl::Vec4& v)
+{
+    const float values[] = {v.x, v.y, v.z, v.w};
+    stageUniform(handle, FloatUniform, values, NULL, 4, 1);
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, int x)
+{
+    stageUniform(handle, IntUniform, NULL, &x, 1, 1);
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, const Glsl::Ivec2& v)
+{
+    const int values[] = {v.x, v.y};
+    stageUniform(handle, IntUniform, NULL, values, 2, 1);
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, const Glsl::Ivec3& v)
+{
+    const int values[] = {v.x, v.y, v.z};
+    stageUniform(handle, IntUniform, NULL, values, 3, 1);
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, const Glsl::Ivec4& v)
+{
+    const int values[] = {v.x, v.y, v.z, v.w};
+    stageUniform(handle, IntUniform, NULL, values, 4, 1);
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, bool x)
+{
+    setUniform(handle, static_cast<int>(x));
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, const Glsl::Bvec2& v)
+{
+    setUniform(handle, Glsl::Ivec2(v));
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, const Glsl::Bvec3& v)
+{
+    setUniform(handle, Glsl::Ivec3(v));
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, const Glsl::Bvec4& v)
+{
+    setUniform(handle, Glsl::Ivec4(v));
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, const Glsl::Mat3& matrix)
+{
+    stageUniform(handle, Matrix3Uniform, matrix.array, NULL, 3 * 3, 1);
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, const Glsl::Mat4& matrix)
+{
+    stageUniform(handle, Matrix4Uniform, matrix.array, NULL, 4 * 4, 1);
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, const Texture& texture)
+{
+    // Textures are bound when the shader is, there is nothing to stage
+    if ((handle >= 0) && (static_cast<std::size_t>(handle) < m_slots.size()))
+        setTextureUniform(m_slots[handle].location, texture, m_slots[handle].name);
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, CurrentTextureType)
+{
+    if ((handle >= 0) && (static_cast<std::size_t>(handle) < m_slots.size()))
+        m_currentTexture = m_slots[handle].location;
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniformArray(UniformHandle handle, const float* scalarArray, std::size_t length)
+{
+    stageUniform(handle, FloatUniform, scalarArray, NULL, length, length);
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniformArray(UniformHandle handle, const Glsl::Vec2* vectorArray, std::size_t length)
+{
+    std::vector<float> contiguous = flatten(vectorArray, length);
+    stageUniform(handle, FloatUniform, &contiguous[0], NULL, contiguous.size(), length);
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniformArray(UniformHandle handle, const Glsl::Vec3* vectorArray, std::size_t length)
+{
+    std::vector<float> contiguous = flatten(vectorArray, length);
+    stageUniform(handle, FloatUniform, &contiguous[0], NULL, contiguous.size(), length);
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniformArray(UniformHandle handle, const Glsl::Vec4* vectorArray, std::size_t length)
+{
+    std::vector<float> contiguous = flatten(vectorArray, length);
+    stageUniform(handle, FloatUniform, &contiguous[0], NULL, contiguous.size(), length);
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniformArray(UniformHandle handle, const Glsl::Mat3* matrixArray, std::size_t length)
+{
+    const std::size_t matrixSize = 3 * 3;
+
+    std::vector<float> contiguous(matrixSize * length);
+    for (std::size_t i = 0; i < length; ++i)
+        priv::copyMatrix(matrixArray[i].array, matrixSize, &contiguous[matrixSize * i]);
+
+    stageUniform(handle, Matrix3Uniform, &contiguous[0], NULL, contiguous.size(), length);
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniformArray(UniformHandle handle, const Glsl::Mat4* matrixArray, std::size_t length)
+{
+    const std::size_t matrixSize = 4 * 4;
+
+    std::vector<float> contiguous(matrixSize * length);
+    for (std::size_t i = 0; i < length; ++i)
+        priv::copyMatrix(matrixArray[i].array, matrixSize, &contiguous[matrixSize * i]);
+
+    stageUniform(handle, Matrix4Uniform, &contiguous[0], NULL, contiguous.size(), length);
+}
+
+
 ////////////////////////////////////////////////////////////
 void Shader::setParameter(const std::string& name, float x)
 {
@@ -755,6 +965,10 @@ void Shader::bind(const Shader* shader)
         // Enable the program
         glCheck(GLEXT_glUseProgramObject(castToGlHandle(shader->m_shaderProgram)));
 
+        // Upload the staged uniforms that changed since the last bind
+        if (!shader->m_dirtySlots.empty())
+            shader->uploadUniforms();
+
         // Bind the textures
         shader->bindTextures();
 
@@ -822,6 +1036,13 @@ bool Shader::isGeometryAvailable()
 }
 
 
+////////////////////////////////////////////////////////////
+void Shader::setProgramCache(DiskCache* cache)
+{
+    programCache = cache;
+}
+
+
 ////////////////////////////////////////////////////////////
 bool Shader::compile(const char* vertexShaderCode, const char* geometryShaderCode, const char* fragmentShaderCode)
 {
@@ -854,6 +1075,60 @@ bool Shader::compile(const char* vertexShaderCode, const char* geometryShaderCod
     m_currentTexture = -1;
     m_textures.clear();
     m_uniforms.clear();
+    m_slots.clear();
+    m_dirtySlots.clear();
+
+    // Use the program cache only if the driver can save programs
+    Clock clock;
+    DiskCache* cache = GLEXT_get_program_binary ? programCache : NULL;
+    if (cache)
+    {
+        GLint formats = 0;
+        glCheck(glGetIntegerv(GLEXT_GL_NUM_PROGRAM_BINARY_FORMATS, &formats));
+        if (formats <= 0)
+            cache = NULL;
+    }
+
+    // Look for a binary of the same sources, built by the same driver
+    Uint64 sourceKey = 0;
+    Uint64 driverKey = 0;
+    if (cache)
+    {
+        const char* sources[] = {vertexShaderCode, geometryShaderCode, fragmentShaderCode};
+        for (int i = 0; i < 3; ++i)
+            sourceKey = DiskCache::computeHash(sources[i], sources[i] ? std::strlen(sources[i]) : 0, sourceKey);
+
+        const GLenum names[] = {GL_VENDOR, GL_RENDERER, GL_VERSION};
+        for (int i = 0; i < 3; ++i)
+        {
+            const char* value = reinterpret_cast<const char*>(glGetString(names[i]));
+            driverKey = DiskCache::computeHash(value, value ? std::strlen(value) : 0, driverKey);
+        }
+
+        std::vector<char> binary;
+        Uint32 format = 0;
+        Time compileTime;
+        if (cache->loadProgram(sourceKey, driverKey, binary, format, compileTime))
+        {
+            GLEXT_GLhandle cachedProgram;
+            glCheck(cachedProgram = GLEXT_glCreateProgramObject());
+            glCheck(GLEXT_glProgramBinary(castFromGlHandle(cachedProgram), format, &binary[0], static_cast<GLsizei>(binary.size())));
+
+            // The driver may still refuse the binary, in which case the sources are compiled
+            GLint success;
+            glCheck(GLEXT_glGetProgramiv(castFromGlHandle(cachedProgram), GLEXT_GL_OBJECT_LINK_STATUS, &success));
+            if (success != GL_FALSE)
+            {
+                m_shaderProgram = castFromGlHandle(cachedProgram);
+                glCheck(glFlush());
+
+                cache->record(true, true, clock.getElapsedTime(), compileTime);
+                return true;
+            }
+
+            glCheck(GLEXT_glDeleteObject(cachedProgram));
+        }
+    }
 
     // Create the program
     GLEXT_GLhandle shaderProgram;
@@ -942,6 +1217,10 @@ bool Shader::compile(const char* vertexShaderCode, const char* geometryShaderCod
         glCheck(GLEXT_glDeleteObject(fragmentShader));
     }
 
+    // Ask the driver to keep the binary of the program, to store it in the cache
+    if (cache)
+        glCheck(GLEXT_glProgramParameteri(castFromGlHandle(shaderProgram), GLEXT_GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE));
+
     // Link the program
     glCheck(GLEXT_glLinkProgram(shaderProgram));
 
@@ -960,6 +1239,26 @@ bool Shader::compile(const char* vertexShaderCode, const char* geometryShaderCod
 
     m_shaderProgram = castFromGlHandle(shaderProgram);
 
+    // Store the binary of the program in the cache
+    if (cache)
+    {
+        Time compileTime = clock.getElapsedTime();
+
+        GLint length = 0;
+        glCheck(GLEXT_glGetProgramiv(m_shaderProgram, GLEXT_GL_PROGRAM_BINARY_LENGTH, &length));
+        if (length > 0)
+        {
+            std::vector<char> binary(static_cast<std::size_t>(length));
+            GLenum format = 0;
+            glCheck(GLEXT_glGetProgramBinary(m_shaderProgram, length, &length, &format, &binary[0]));
+            binary.resize(static_cast<std::size_t>(length));
+
+            cache->saveProgram(sourceKey, driverKey, binary, format, compileTime);
+        }
+
+        cache->record(true, false, clock.getElapsedTime(), Time::Zero);
+    }
+
     // Force an OpenGL flush, so that the shader will appear updated
     // in all contexts immediately (solves problems in multi-threaded apps)
     glCheck(glFlush());
@@ -1009,6 +1308,133 @@ int Shader::getUniformLocation(const std::string& name)
     }
 }
 
+
+////////////////////////////////////////////////////////////
+void Shader::stageUniform(UniformHandle handle, int type, const float* floats, const int* ints, std::size_t size, std::size_t count)
+{
+    if ((handle < 0) || (static_cast<std::size_t>(handle) >= m_slots.size()) || (size == 0))
+        return;
+
+    UniformSlot& slot = m_slots[handle];
+
+    // Setting the same value again doesn't need an upload
+    std::size_t floatCount = floats ? size : 0;
+    std::size_t intCount   = ints   ? size : 0;
+    if ((slot.type == type) && (slot.count == count) && (slot.floats.size() == floatCount) && (slot.ints.size() == intCount) &&
+        std::equal(slot.floats.begin(), slot.floats.end(), floats) && std::equal(slot.ints.begin(), slot.ints.end(), ints))
+        return;
+
+    slot.type  = type;
+    slot.count = count;
+    slot.floats.assign(floats, floats + floatCount);
+    slot.ints.assign(ints, ints + intCount);
+
+    if (!slot.dirty)
+    {
+        slot.dirty = true;
+        m_dirtySlots.push_back(handle);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::discardStagedUniform(int location)
+{
+    for (std::size_t i = 0; i < m_slots.size(); ++i)
+    {
+        UniformSlot& slot = m_slots[i];
+        if (slot.location != location)
+            continue;
+
+        if (slot.dirty)
+        {
+            slot.dirty = false;
+            m_dirtySlots.erase(std::find(m_dirtySlots.begin(), m_dirtySlots.end(), static_cast<UniformHandle>(i)));
+        }
+
+        slot.type  = -1;
+        slot.count = 0;
+        slot.floats.clear();
+        slot.ints.clear();
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setTextureUniform(int location, const Texture& texture, const std::string& name)
+{
+    // Store the location -> texture mapping
+    TextureTable::iterator it = m_textures.find(location);
+    if (it == m_textures.end())
+    {
+        // New entry, make sure there are enough texture units
+        GLint maxUnits = getMaxTextureUnits();
+        if (m_textures.size() + 1 >= static_cast<std::size_t>(maxUnits))
+        {
+            err() << "Impossible to use texture \"" << name << "\" for shader: all available texture units are used" << std::endl;
+            return;
+        }
+
+        m_textures[location] = &texture;
+    }
+    else
+    {
+        // Location already used, just replace the texture
+        it->second = &texture;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::uploadUniforms() const
+{
+    for (std::size_t i = 0; i < m_dirtySlots.size(); ++i)
+    {
+        UniformSlot& slot = m_slots[m_dirtySlots[i]];
+        slot.dirty = false;
+
+        GLint location = slot.location;
+        GLsizei count = static_cast<GLsizei>(slot.count);
+        switch (slot.type)
+        {
+            case FloatUniform:
+            {
+                switch (slot.floats.size() / slot.count)
+                {
+                    case 1: glCheck(GLEXT_glUniform1fv(location, count, &slot.floats[0])); break;
+                    case 2: glCheck(GLEXT_glUniform2fv(location, count, &slot.floats[0])); break;
+                    case 3: glCheck(GLEXT_glUniform3fv(location, count, &slot.floats[0])); break;
+                    case 4: glCheck(GLEXT_glUniform4fv(location, count, &slot.floats[0])); break;
+                }
+                break;
+            }
+
+            case IntUniform:
+            {
+                const std::vector<int>& v = slot.ints;
+                switch (v.size())
+                {
+                    case 1: glCheck(GLEXT_glUniform1i(location, v[0])); break;
+                    case 2: glCheck(GLEXT_glUniform2i(location, v[0], v[1])); break;
+                    case 3: glCheck(GLEXT_glUniform3i(location, v[0], v[1], v[2])); break;
+                    case 4: glCheck(GLEXT_glUniform4i(location, v[0], v[1], v[2], v[3])); break;
+                }
+                break;
+            }
+
+            case Matrix3Uniform:
+                glCheck(GLEXT_glUniformMatrix3fv(location, count, GL_FALSE, &slot.floats[0]));
+                break;
+
+            case Matrix4Uniform:
+                glCheck(GLEXT_glUniformMatrix4fv(location, count, GL_FALSE, &slot.floats[0]));
+                break;
+        }
+    }
+
+    m_dirtySlots.clear();
+}
+
 } // namespace sf
 
 #else // SFML_OPENGL_ES
@@ -1230,6 +1656,145 @@ void Shader::setUniformArray(const std::string& name, const Glsl::Mat4* matrixAr
 }
 
 
+////////////////////////////////////////////////////////////
+Shader::UniformHandle Shader::getUniformHandle(const std::string& name)
+{
+    return -1;
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, float x)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, const Glsl::Vec2& v)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, const Glsl::Vec3& v)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, const Glsl::Vec4& v)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, int x)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, const Glsl::Ivec2& v)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, const Glsl::Ivec3& v)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, const Glsl::Ivec4& v)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, bool x)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, const Glsl::Bvec2& v)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, const Glsl::Bvec3& v)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, const Glsl::Bvec4& v)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, const Glsl::Mat3& matrix)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, const Glsl::Mat4& matrix)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, const Texture& texture)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, CurrentTextureType)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniformArray(UniformHandle handle, const float* scalarArray, std::size_t length)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniformArray(UniformHandle handle, const Glsl::Vec2* vectorArray, std::size_t length)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniformArray(UniformHandle handle, const Glsl::Vec3* vectorArray, std::size_t length)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniformArray(UniformHandle handle, const Glsl::Vec4* vectorArray, std::size_t length)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniformArray(UniformHandle handle, const Glsl::Mat3* matrixArray, std::size_t length)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniformArray(UniformHandle handle, const Glsl::Mat4* matrixArray, std::size_t length)
+{
+}
+
+
 ////////////////////////////////////////////////////////////
 void Shader::setParameter(const std::string& name, float x)
 {
@@ -1317,6 +1882,12 @@ bool Shader::isGeometryAvailable()
 }
 
 
+////////////////////////////////////////////////////////////
+void Shader::setProgramCache(DiskCache* cache)
+{
+}
+
+
 ////////////////////////////////////////////////////////////
 bool Shader::compile(const char* vertexShaderCode, const char* geometryShaderCode, const char* fragmentShaderCode)
 {
@@ -29,11 +29,24 @@
 #include <SFML/Graphics/RenderTarget.hpp>
 #include <SFML/Graphics/Texture.hpp>
 #include <SFML/System/Err.hpp>
+#include <algorithm>
 #include <cmath>
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+    #include <emmintrin.h>
+    #define SFML_SHAPE_SSE2
+#elif defined(__aarch64__) || defined(_M_ARM64)
+    // 32-bit NEON has no exact division nor square root, so it keeps the scalar path
+    #include <arm_neon.h>
+    #define SFML_SHAPE_NEON
+#endif
+
 
 namespace
 {
+    // Number of points extruded at once by Shape::updateOutline
+    const std::size_t outlineBlockSize = 64;
+
     // Compute the normal of a segment
     sf::Vector2f computeNormal(const sf::Vector2f& p1, const sf::Vector2f& p2)
     {
@@ -49,6 +62,156 @@ namespace
     {
         return p1.x * p2.x + p1.y * p2.y;
     }
+
+    // Get the index of a point of the shape in its fill vertices
+    std::size_t getFillIndex(std::size_t point, bool triangleList)
+    {
+        return triangleList ? point * 3 + 1 : point + 1;
+    }
+
+    // Compute the normals of the segments [p(i), p(i + 1)], for i in [0, count)
+    void computeNormals(const float* x, const float* y, std::size_t count, float* nx, float* ny)
+    {
+        std::size_t i = 0;
+
+#if defined(SFML_SHAPE_SSE2)
+
+        const __m128 zero = _mm_setzero_ps();
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128 a = _mm_sub_ps(_mm_loadu_ps(y + i), _mm_loadu_ps(y + i + 1));
+            __m128 b = _mm_sub_ps(_mm_loadu_ps(x + i + 1), _mm_loadu_ps(x + i));
+            __m128 length = _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(a, a), _mm_mul_ps(b, b)));
+
+            // Degenerate segments keep their null normal
+            __m128 valid = _mm_cmpneq_ps(length, zero);
+            _mm_storeu_ps(nx + i, _mm_or_ps(_mm_and_ps(valid, _mm_div_ps(a, length)), _mm_andnot_ps(valid, a)));
+            _mm_storeu_ps(ny + i, _mm_or_ps(_mm_and_ps(valid, _mm_div_ps(b, length)), _mm_andnot_ps(valid, b)));
+        }
+
+#elif defined(SFML_SHAPE_NEON)
+
+        const float32x4_t zero = vdupq_n_f32(0.f);
+        for (; i + 4 <= count; i += 4)
+        {
+            float32x4_t a = vsubq_f32(vld1q_f32(y + i), vld1q_f32(y + i + 1));
+            float32x4_t b = vsubq_f32(vld1q_f32(x + i + 1), vld1q_f32(x + i));
+            float32x4_t length = vsqrtq_f32(vaddq_f32(vmulq_f32(a, a), vmulq_f32(b, b)));
+
+            // Degenerate segments keep their null normal
+            uint32x4_t valid = vmvnq_u32(vceqq_f32(length, zero));
+            vst1q_f32(nx + i, vbslq_f32(valid, vdivq_f32(a, length), a));
+            vst1q_f32(ny + i, vbslq_f32(valid, vdivq_f32(b, length), b));
+        }
+
+#endif
+
+        for (; i < count; ++i)
+        {
+            sf::Vector2f normal = computeNormal(sf::Vector2f(x[i], y[i]), sf::Vector2f(x[i + 1], y[i + 1]));
+            nx[i] = normal.x;
+            ny[i] = normal.y;
+        }
+    }
+
+    // Extrude the points p(i + 1), for i in [0, count), along the normals of their two segments
+    void extrudePoints(const float* x, const float* y, const float* nx, const float* ny, std::size_t count,
+                       const sf::Vector2f& center, float thickness, float* outX, float* outY)
+    {
+        std::size_t i = 0;
+
+#if defined(SFML_SHAPE_SSE2)
+
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 one = _mm_set1_ps(1.f);
+        const __m128 sign = _mm_set1_ps(-0.f);
+        const __m128 centerX = _mm_set1_ps(center.x);
+        const __m128 centerY = _mm_set1_ps(center.y);
+        const __m128 offset = _mm_set1_ps(thickness);
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128 px = _mm_loadu_ps(x + i + 1);
+            __m128 py = _mm_loadu_ps(y + i + 1);
+            __m128 dx = _mm_sub_ps(centerX, px);
+            __m128 dy = _mm_sub_ps(centerY, py);
+            __m128 n1x = _mm_loadu_ps(nx + i);
+            __m128 n1y = _mm_loadu_ps(ny + i);
+            __m128 n2x = _mm_loadu_ps(nx + i + 1);
+            __m128 n2y = _mm_loadu_ps(ny + i + 1);
+
+            // Make the normals point towards the outside of the shape
+            __m128 flip1 = _mm_and_ps(_mm_cmpgt_ps(_mm_add_ps(_mm_mul_ps(n1x, dx), _mm_mul_ps(n1y, dy)), zero), sign);
+            __m128 flip2 = _mm_and_ps(_mm_cmpgt_ps(_mm_add_ps(_mm_mul_ps(n2x, dx), _mm_mul_ps(n2y, dy)), zero), sign);
+            n1x = _mm_xor_ps(n1x, flip1);
+            n1y = _mm_xor_ps(n1y, flip1);
+            n2x = _mm_xor_ps(n2x, flip2);
+            n2y = _mm_xor_ps(n2y, flip2);
+
+            // Combine them to get the extrusion direction
+            __m128 factor = _mm_add_ps(one, _mm_add_ps(_mm_mul_ps(n1x, n2x), _mm_mul_ps(n1y, n2y)));
+            __m128 normalX = _mm_div_ps(_mm_add_ps(n1x, n2x), factor);
+            __m128 normalY = _mm_div_ps(_mm_add_ps(n1y, n2y), factor);
+            _mm_storeu_ps(outX + i, _mm_add_ps(px, _mm_mul_ps(normalX, offset)));
+            _mm_storeu_ps(outY + i, _mm_add_ps(py, _mm_mul_ps(normalY, offset)));
+        }
+
+#elif defined(SFML_SHAPE_NEON)
+
+        const float32x4_t zero = vdupq_n_f32(0.f);
+        const float32x4_t one = vdupq_n_f32(1.f);
+        const float32x4_t centerX = vdupq_n_f32(center.x);
+        const float32x4_t centerY = vdupq_n_f32(center.y);
+        for (; i + 4 <= count; i += 4)
+        {
+            float32x4_t px = vld1q_f32(x + i + 1);
+            float32x4_t py = vld1q_f32(y + i + 1);
+            float32x4_t dx = vsubq_f32(centerX, px);
+            float32x4_t dy = vsubq_f32(centerY, py);
+            float32x4_t n1x = vld1q_f32(nx + i);
+            float32x4_t n1y = vld1q_f32(ny + i);
+            float32x4_t n2x = vld1q_f32(nx + i + 1);
+            float32x4_t n2y = vld1q_f32(ny + i + 1);
+
+            // Make the normals point towards the outside of the shape
+            uint32x4_t flip1 = vcgtq_f32(vaddq_f32(vmulq_f32(n1x, dx), vmulq_f32(n1y, dy)), zero);
+            uint32x4_t flip2 = vcgtq_f32(vaddq_f32(vmulq_f32(n2x, dx), vmulq_f32(n2y, dy)), zero);
+            n1x = vbslq_f32(flip1, vnegq_f32(n1x), n1x);
+            n1y = vbslq_f32(flip1, vnegq_f32(n1y), n1y);
+            n2x = vbslq_f32(flip2, vnegq_f32(n2x), n2x);
+            n2y = vbslq_f32(flip2, vnegq_f32(n2y), n2y);
+
+            // Combine them to get the extrusion direction
+            float32x4_t factor = vaddq_f32(one, vaddq_f32(vmulq_f32(n1x, n2x), vmulq_f32(n1y, n2y)));
+            float32x4_t normalX = vdivq_f32(vaddq_f32(n1x, n2x), factor);
+            float32x4_t normalY = vdivq_f32(vaddq_f32(n1y, n2y), factor);
+            vst1q_f32(outX + i, vaddq_f32(px, vmulq_n_f32(normalX, thickness)));
+            vst1q_f32(outY + i, vaddq_f32(py, vmulq_n_f32(normalY, thickness)));
+        }
+
+#endif
+
+        for (; i < count; ++i)
+        {
+            sf::Vector2f p1(x[i + 1], y[i + 1]);
+            sf::Vector2f n1(nx[i], ny[i]);
+            sf::Vector2f n2(nx[i + 1], ny[i + 1]);
+
+            // Make sure that the normals point towards the outside of the shape
+            // (this depends on the order in which the points were defined)
+            if (dotProduct(n1, center - p1) > 0)
+                n1 = -n1;
+            if (dotProduct(n2, center - p1) > 0)
+                n2 = -n2;
+
+            // Combine them to get the extrusion direction
+            float factor = 1.f + (n1.x * n2.x + n1.y * n2.y);
+            sf::Vector2f normal = (n1 + n2) / factor;
+
+            sf::Vector2f extruded = p1 + normal * thickness;
+            outX[i] = extruded.x;
+            outY[i] = extruded.y;
+        }
+    }
 }
 
 
@@ -142,6 +305,37 @@ float Shape::getOutlineThickness() const
 }
 
 
+////////////////////////////////////////////////////////////
+void Shape::setTriangleList(bool triangleList)
+{
+    m_triangleList = triangleList;
+    m_vertices.setPrimitiveType(triangleList ? Triangles : TriangleFan);
+    m_outlineVertices.setPrimitiveType(triangleList ? Triangles : TriangleStrip);
+    update();
+}
+
+
+////////////////////////////////////////////////////////////
+bool Shape::isTriangleList() const
+{
+    return m_triangleList;
+}
+
+
+////////////////////////////////////////////////////////////
+const VertexArray& Shape::getFillVertices() const
+{
+    return m_vertices;
+}
+
+
+////////////////////////////////////////////////////////////
+const VertexArray& Shape::getOutlineVertices() const
+{
+    return m_outlineVertices;
+}
+
+
 ////////////////////////////////////////////////////////////
 FloatRect Shape::getLocalBounds() const
 {
@@ -163,6 +357,7 @@ m_textureRect     (),
 m_fillColor       (255, 255, 255),
 m_outlineColor    (255, 255, 255),
 m_outlineThickness(0),
+m_triangleList    (false),
 m_vertices        (TriangleFan),
 m_outlineVertices (TriangleStrip),
 m_insideBounds    (),
@@ -204,6 +399,23 @@ void Shape::update()
     // Texture coordinates
     updateTexCoords();
 
+    // Expand the fan to a triangle list: the triangle i is (center, p(i), p(i + 1)).
+    // Going backwards, the vertices of the fan are always read before being overwritten
+    if (m_triangleList)
+    {
+        m_vertices.resize(count * 3);
+        Vertex* vertices = &m_vertices[0];
+        Vertex center = vertices[0];
+        for (std::size_t i = count; i-- > 0;)
+        {
+            Vertex p1 = vertices[i + 1];
+            Vertex p2 = vertices[i + 2];
+            vertices[i * 3 + 0] = center;
+            vertices[i * 3 + 1] = p1;
+            vertices[i * 3 + 2] = p2;
+        }
+    }
+
     // Outline
     updateOutline();
 }
@@ -216,6 +428,7 @@ void Shape::draw(RenderTarget& target, RenderStates states) const
 
     // Render the inside
     states.texture = m_texture;
+    states.coordinateType = Texture::Pixels;
     target.draw(m_vertices, states);
 
     // Render the outline
@@ -230,7 +443,8 @@ void Shape::draw(RenderTarget& target, RenderStates states) const
 ////////////////////////////////////////////////////////////
 void Shape::updateFillColors()
 {
-    for (std::size_t i = 0; i < m_vertices.getVertexCount(); ++i)
+    std::size_t count = m_vertices.getVertexCount();
+    for (std::size_t i = 0; i < count; ++i)
         m_vertices[i].color = m_fillColor;
 }
 
@@ -238,7 +452,8 @@ void Shape::updateFillColors()
 ////////////////////////////////////////////////////////////
 void Shape::updateTexCoords()
 {
-    for (std::size_t i = 0; i < m_vertices.getVertexCount(); ++i)
+    std::size_t count = m_vertices.getVertexCount();
+    for (std::size_t i = 0; i < count; ++i)
     {
         float xratio = m_insideBounds.width > 0 ? (m_vertices[i].position.x - m_insideBounds.left) / m_insideBounds.width : 0;
         float yratio = m_insideBounds.height > 0 ? (m_vertices[i].position.y - m_insideBounds.top) / m_insideBounds.height : 0;
@@ -251,41 +466,65 @@ void Shape::updateTexCoords()
 ////////////////////////////////////////////////////////////
 void Shape::updateOutline()
 {
-    std::size_t count = m_vertices.getVertexCount() - 2;
-    m_outlineVertices.resize((count + 1) * 2);
-
-    for (std::size_t i = 0; i < count; ++i)
+    std::size_t count = m_triangleList ? m_vertices.getVertexCount() / 3 : m_vertices.getVertexCount() - 2;
+    m_outlineVertices.resize(m_triangleList ? count * 6 : (count + 1) * 2);
+
+    const Vertex* vertices = &m_vertices[0];
+    Vertex* outlineVertices = &m_outlineVertices[0];
+    Vector2f center = vertices[0].position;
+
+    // Extrude the points by blocks: each block gathers its points, plus the previous
+    // and the next ones, so that the normals and extrusions can be computed in batch
+    float x[outlineBlockSize + 2];
+    float y[outlineBlockSize + 2];
+    float nx[outlineBlockSize + 1];
+    float ny[outlineBlockSize + 1];
+    float outX[outlineBlockSize];
+    float outY[outlineBlockSize];
+    for (std::size_t start = 0; start < count; start += outlineBlockSize)
     {
-        std::size_t index = i + 1;
-
-        // Get the two segments shared by the current point
-        Vector2f p0 = (i == 0) ? m_vertices[count].position : m_vertices[index - 1].position;
-        Vector2f p1 = m_vertices[index].position;
-        Vector2f p2 = m_vertices[index + 1].position;
+        std::size_t size = std::min(outlineBlockSize, count - start);
+        for (std::size_t i = 0; i < size + 2; ++i)
+        {
+            const Vector2f& point = vertices[getFillIndex((start + i + count - 1) % count, m_triangleList)].position;
+            x[i] = point.x;
+            y[i] = point.y;
+        }
 
-        // Compute their normal
-        Vector2f n1 = computeNormal(p0, p1);
-        Vector2f n2 = computeNormal(p1, p2);
-
-        // Make sure that the normals point towards the outside of the shape
-        // (this depends on the order in which the points were defined)
-        if (dotProduct(n1, m_vertices[0].position - p1) > 0)
-            n1 = -n1;
-        if (dotProduct(n2, m_vertices[0].position - p1) > 0)
-            n2 = -n2;
-
-        // Combine them to get the extrusion direction
-        float factor = 1.f + (n1.x * n2.x + n1.y * n2.y);
-        Vector2f normal = (n1 + n2) / factor;
+        computeNormals(x, y, size + 1, nx, ny);
+        extrudePoints(x, y, nx, ny, size, center, m_outlineThickness, outX, outY);
 
         // Update the outline points
-        m_outlineVertices[i * 2 + 0].position = p1;
-        m_outlineVertices[i * 2 + 1].position = p1 + normal * m_outlineThickness;
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            std::size_t index = start + i;
+            Vector2f inner(x[i + 1], y[i + 1]);
+            Vector2f outer(outX[i], outY[i]);
+            if (m_triangleList)
+            {
+                // The segment i is made of the triangles (in(i), out(i), in(i + 1)) and (out(i), in(i + 1), out(i + 1))
+                std::size_t previous = (index + count - 1) % count;
+                outlineVertices[index * 6 + 0].position = inner;
+                outlineVertices[index * 6 + 1].position = outer;
+                outlineVertices[index * 6 + 3].position = outer;
+                outlineVertices[previous * 6 + 2].position = inner;
+                outlineVertices[previous * 6 + 4].position = inner;
+                outlineVertices[previous * 6 + 5].position = outer;
+            }
+            else
+            {
+                outlineVertices[index * 2 + 0].position = inner;
+                outlineVertices[index * 2 + 1].position = outer;
+            }
+        }
     }
 
     // Duplicate the first point at the end, to close the outline
-    m_outlineVertices[count * 2 + 0].position = m_outlineVertices[0].position;
-    m_outlineVertices[count * 2 + 1].position = m_outlineVertices[1].position;
+    if (!m_triangleList)
+    {
+        m_outlineVertices[count * 2 + 0].position = m_outlineVertices[0].position;
+        m_outlineVertices[count * 2 + 1].position = m_outlineVertices[1].position;
+    }
 
     // Update outline colors
     updateOutlineColors();
@@ -298,7 +537,8 @@ void Shape::updateOutline()
 ////////////////////////////////////////////////////////////
 void Shape::updateOutlineColors()
 {
-    for (std::size_t i = 0; i < m_outlineVertices.getVertexCount(); ++i)
+    std::size_t count = m_outlineVertices.getVertexCount();
+    for (std::size_t i = 0; i < count; ++i)
         m_outlineVertices[i].color = m_outlineColor;
 }
 
@@ -0,0 +1,1012 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2016 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/SoftwareRasterizer.hpp>
+#include <SFML/Graphics/PixelKernels.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/System/Thread.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Err.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+
+namespace
+{
+    // Size of the tiles that are rasterized in parallel, in pixels
+    const int tileSize = 64;
+
+    // Vertices are snapped to 1/256 pixel
+    const sf::Int64 subpixels = 256;
+
+    // Primitives are clipped to this distance from the origin, in pixels,
+    // so that the edge functions never overflow 64 bits
+    const float guardBand = 524288.f;
+
+
+    ////////////////////////////////////////////////////////////
+    // Integer divisions rounded towards -infinity / +infinity,
+    // for a positive denominator
+    ////////////////////////////////////////////////////////////
+    sf::Int64 floorDivide(sf::Int64 numerator, sf::Int64 denominator)
+    {
+        return (numerator >= 0) ? numerator / denominator : -((-numerator + denominator - 1) / denominator);
+    }
+
+    sf::Int64 ceilDivide(sf::Int64 numerator, sf::Int64 denominator)
+    {
+        return -floorDivide(-numerator, denominator);
+    }
+
+
+    ////////////////////////////////////////////////////////////
+    // Check that a coordinate is neither infinite nor NaN
+    ////////////////////////////////////////////////////////////
+    bool isFinite(float value)
+    {
+        return (value - value) == 0.f;
+    }
+
+
+    ////////////////////////////////////////////////////////////
+    // Interpolate all the attributes of two vertices
+    ////////////////////////////////////////////////////////////
+    sf::Uint8 interpolate(sf::Uint8 first, sf::Uint8 second, float factor)
+    {
+        return static_cast<sf::Uint8>(first + (second - first) * factor + 0.5f);
+    }
+
+    sf::Vertex interpolate(const sf::Vertex& first, const sf::Vertex& second, float factor)
+    {
+        sf::Vertex result;
+        result.position  = first.position + (second.position - first.position) * factor;
+        result.texCoords = first.texCoords + (second.texCoords - first.texCoords) * factor;
+        result.color.r   = interpolate(first.color.r, second.color.r, factor);
+        result.color.g   = interpolate(first.color.g, second.color.g, factor);
+        result.color.b   = interpolate(first.color.b, second.color.b, factor);
+        result.color.a   = interpolate(first.color.a, second.color.a, factor);
+
+        return result;
+    }
+
+
+    ////////////////////////////////////////////////////////////
+    // Check whether two vertices are identical
+    ////////////////////////////////////////////////////////////
+    bool isSame(const sf::Vertex& first, const sf::Vertex& second)
+    {
+        return (first.position == second.position) && (first.color == second.color) && (first.texCoords == second.texCoords);
+    }
+
+
+    ////////////////////////////////////////////////////////////
+    // Clip a polygon against one side of the guard band
+    // (Sutherland-Hodgman), returns the new number of vertices
+    ////////////////////////////////////////////////////////////
+    std::size_t clipPolygon(const sf::Vertex* input, std::size_t count, sf::Vertex* output, bool vertical, float side)
+    {
+        std::size_t result = 0;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const sf::Vertex& current = input[i];
+            const sf::Vertex& next    = input[(i + 1) % count];
+
+            // Positive distances are inside
+            float currentDistance = guardBand - side * (vertical ? current.position.y : current.position.x);
+            float nextDistance    = guardBand - side * (vertical ? next.position.y : next.position.x);
+
+            if (currentDistance >= 0.f)
+                output[result++] = current;
+
+            if ((currentDistance >= 0.f) != (nextDistance >= 0.f))
+                output[result++] = interpolate(current, next, currentDistance / (currentDistance - nextDistance));
+        }
+
+        return result;
+    }
+
+
+    ////////////////////////////////////////////////////////////
+    // Convert a texture coordinate to the index of the texel it falls into
+    ////////////////////////////////////////////////////////////
+    int toTexel(float coordinate)
+    {
+        const float limit = 1073741824.f;
+        return static_cast<int>(std::floor(std::max(-limit, std::min(coordinate, limit))));
+    }
+
+    int wrap(int texel, int size, bool repeated)
+    {
+        if (repeated)
+        {
+            texel %= size;
+            return (texel < 0) ? texel + size : texel;
+        }
+
+        return (texel < 0) ? 0 : ((texel >= size) ? size - 1 : texel);
+    }
+
+
+    ////////////////////////////////////////////////////////////
+    // Sample a row of pixels from a texture, with texture
+    // coordinates in pixels
+    ////////////////////////////////////////////////////////////
+    void sampleTexture(const sf::Uint8* pixels, int width, int height, bool smooth, bool repeated,
+                       float u, float v, float stepU, float stepV, int count, sf::Uint8* buffer)
+    {
+        if (!smooth)
+        {
+            // Unscaled, unrotated rows are copied directly (sprites, text)
+            if ((stepU == 1.f) && (stepV == 0.f))
+            {
+                int x = toTexel(u);
+                if ((x >= 0) && (x + count <= width))
+                {
+                    int y = wrap(toTexel(v), height, repeated);
+                    std::memcpy(buffer, pixels + (static_cast<std::size_t>(y) * width + x) * 4, count * 4);
+                    return;
+                }
+            }
+
+            for (int i = 0; i < count; ++i)
+            {
+                int x = wrap(toTexel(u), width, repeated);
+                int y = wrap(toTexel(v), height, repeated);
+                std::memcpy(buffer + i * 4, pixels + (static_cast<std::size_t>(y) * width + x) * 4, 4);
+
+                u += stepU;
+                v += stepV;
+            }
+        }
+        else
+        {
+            // Bilinear filtering, with weights of 8 bits
+            u -= 0.5f;
+            v -= 0.5f;
+            for (int i = 0; i < count; ++i)
+            {
+                int x = toTexel(u);
+                int y = toTexel(v);
+                int weightX = static_cast<int>((u - x) * 256.f);
+                int weightY = static_cast<int>((v - y) * 256.f);
+
+                std::size_t x0 = wrap(x, width, repeated);
+                std::size_t x1 = wrap(x + 1, width, repeated);
+                std::size_t y0 = wrap(y, height, repeated) * width;
+                std::size_t y1 = wrap(y + 1, height, repeated) * width;
+
+                const sf::Uint8* topLeft     = pixels + (y0 + x0) * 4;
+                const sf::Uint8* topRight    = pixels + (y0 + x1) * 4;
+                const sf::Uint8* bottomLeft  = pixels + (y1 + x0) * 4;
+                const sf::Uint8* bottomRight = pixels + (y1 + x1) * 4;
+
+                for (int c = 0; c < 4; ++c)
+                {
+                    int top    = topLeft[c] * (256 - weightX) + topRight[c] * weightX;
+                    int bottom = bottomLeft[c] * (256 - weightX) + bottomRight[c] * weightX;
+                    buffer[i * 4 + c] = static_cast<sf::Uint8>((top * (256 - weightY) + bottom * weightY + 32768) >> 16);
+                }
+
+                u += stepU;
+                v += stepV;
+            }
+        }
+    }
+
+
+    ////////////////////////////////////////////////////////////
+    // Generic blending, for the modes that have no dedicated kernel
+    ////////////////////////////////////////////////////////////
+    int getFactor(sf::BlendMode::Factor factor, const sf::Uint8* source, const sf::Uint8* destination, int component)
+    {
+        switch (factor)
+        {
+            case sf::BlendMode::Zero:             return 0;
+            case sf::BlendMode::One:              return 255;
+            case sf::BlendMode::SrcColor:         return source[component];
+            case sf::BlendMode::OneMinusSrcColor: return 255 - source[component];
+            case sf::BlendMode::DstColor:         return destination[component];
+            case sf::BlendMode::OneMinusDstColor: return 255 - destination[component];
+            case sf::BlendMode::SrcAlpha:         return source[3];
+            case sf::BlendMode::OneMinusSrcAlpha: return 255 - source[3];
+            case sf::BlendMode::DstAlpha:         return destination[3];
+            case sf::BlendMode::OneMinusDstAlpha: return 255 - destination[3];
+        }
+
+        return 0;
+    }
+
+    sf::Uint8 applyEquation(sf::BlendMode::Equation equation, int source, int destination)
+    {
+        int value;
+        switch (equation)
+        {
+            default:
+            case sf::BlendMode::Add:             value = source + destination; break;
+            case sf::BlendMode::Subtract:        value = source - destination; break;
+            case sf::BlendMode::ReverseSubtract: value = destination - source; break;
+        }
+
+        // Both terms are scaled by 255, the result is rounded and saturated like in an 8-bit framebuffer
+        value = std::max(0, std::min(value, 255 * 255));
+        return static_cast<sf::Uint8>((value + 127) / 255);
+    }
+
+    void blendGeneric(sf::Uint8* destination, const sf::Uint8* source, std::size_t count, const sf::BlendMode& mode)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const sf::Uint8* src = source + i * 4;
+            sf::Uint8* dst = destination + i * 4;
+            sf::Uint8 result[4];
+
+            for (int c = 0; c < 3; ++c)
+            {
+                result[c] = applyEquation(mode.colorEquation,
+                                          src[c] * getFactor(mode.colorSrcFactor, src, dst, c),
+                                          dst[c] * getFactor(mode.colorDstFactor, src, dst, c));
+            }
+
+            result[3] = applyEquation(mode.alphaEquation,
+                                      src[3] * getFactor(mode.alphaSrcFactor, src, dst, 3),
+                                      dst[3] * getFactor(mode.alphaDstFactor, src, dst, 3));
+
+            std::memcpy(dst, result, 4);
+        }
+    }
+
+
+    ////////////////////////////////////////////////////////////
+    // Write shaded pixels to the color buffer
+    ////////////////////////////////////////////////////////////
+    void writePixels(sf::Uint8* destination, const sf::Uint8* source, std::size_t count, const sf::BlendMode& mode)
+    {
+        if (mode == sf::BlendAlpha)
+            sf::priv::blendPixels(destination, source, count);
+        else if (mode == sf::BlendNone)
+            std::memcpy(destination, source, count * 4);
+        else
+            blendGeneric(destination, source, count, mode);
+    }
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+SoftwareRasterizer::SoftwareRasterizer() :
+m_width        (0),
+m_height       (0),
+m_pixels       (),
+m_clear        (false),
+m_vertices     (),
+m_triangles    (),
+m_states       (),
+m_textures     (),
+m_frame        (0),
+m_shaderIgnored(false),
+m_bins         (),
+m_tileMutex    (),
+m_nextTile     (0)
+{
+    std::memset(m_clearColor, 0, sizeof(m_clearColor));
+}
+
+
+////////////////////////////////////////////////////////////
+void SoftwareRasterizer::resize(unsigned int width, unsigned int height)
+{
+    m_width  = width;
+    m_height = height;
+    m_pixels.assign(static_cast<std::size_t>(width) * height * 4, 0);
+
+    m_clear = false;
+    m_triangles.clear();
+    m_states.clear();
+}
+
+
+////////////////////////////////////////////////////////////
+void SoftwareRasterizer::clear(const Color& color)
+{
+    m_clear = true;
+    m_clearColor[0] = color.r;
+    m_clearColor[1] = color.g;
+    m_clearColor[2] = color.b;
+    m_clearColor[3] = color.a;
+
+    m_triangles.clear();
+    m_states.clear();
+}
+
+
+////////////////////////////////////////////////////////////
+void SoftwareRasterizer::draw(const Vertex* vertices, std::size_t vertexCount, PrimitiveType type,
+                              const RenderStates& states, const Transform& viewTransform, const IntRect& viewport)
+{
+    if (states.shader && !m_shaderIgnored)
+    {
+        err() << "Shaders are not supported by software render targets, they are ignored" << std::endl;
+        m_shaderIgnored = true;
+    }
+
+    // Nothing is drawn outside of the viewport
+    IntRect clip;
+    if (!viewport.intersects(IntRect(0, 0, m_width, m_height), clip))
+        return;
+
+    // Register the states, unless they are the same as the previous draw
+    DrawState state;
+    state.blendMode = states.blendMode;
+    state.texture   = (states.texture && states.texture->getNativeHandle()) ? getTextureData(*states.texture) : NULL;
+    state.smooth    = states.texture && states.texture->isSmooth();
+    state.repeated  = states.texture && states.texture->isRepeated();
+
+    if (state.texture && state.texture->pixels.empty())
+        state.texture = NULL;
+
+    if (m_states.empty() ||
+        (m_states.back().blendMode != state.blendMode) ||
+        (m_states.back().texture != state.texture) ||
+        (m_states.back().smooth != state.smooth) ||
+        (m_states.back().repeated != state.repeated))
+    {
+        m_states.push_back(state);
+    }
+
+    // Transform the vertices to pixel coordinates
+    float halfWidth  = viewport.width / 2.f;
+    float halfHeight = viewport.height / 2.f;
+    Transform transform(halfWidth, 0.f,         viewport.left + halfWidth,
+                        0.f,       -halfHeight, viewport.top + halfHeight,
+                        0.f,       0.f,         1.f);
+    transform *= viewTransform;
+    transform *= states.transform;
+
+    // Normalized texture coordinates are relative to the whole OpenGL texture, padding included
+    Vector2f texCoordsScale(1.f, 1.f);
+    if (states.texture && (states.coordinateType == Texture::Normalized))
+        texCoordsScale = Vector2f(static_cast<float>(states.texture->m_actualSize.x), static_cast<float>(states.texture->m_actualSize.y));
+
+    m_vertices.resize(vertexCount);
+    for (std::size_t i = 0; i < vertexCount; ++i)
+    {
+        m_vertices[i].position  = transform.transformPoint(vertices[i].position);
+        m_vertices[i].color     = vertices[i].color;
+        m_vertices[i].texCoords = Vector2f(vertices[i].texCoords.x * texCoordsScale.x, vertices[i].texCoords.y * texCoordsScale.y);
+    }
+
+    // Assemble the primitives; consecutive triangles are submitted by pairs, so
+    // that the ones forming rectangles (sprites, glyphs, tiles) are drawn at once
+    const Vertex* v = &m_vertices[0];
+    switch (type)
+    {
+        case Points:
+            for (std::size_t i = 0; i < vertexCount; ++i)
+                addPoint(v[i], clip);
+            break;
+
+        case Lines:
+            for (std::size_t i = 1; i < vertexCount; i += 2)
+                addLine(v[i - 1], v[i], clip);
+            break;
+
+        case LineStrip:
+            for (std::size_t i = 1; i < vertexCount; ++i)
+                addLine(v[i - 1], v[i], clip);
+            break;
+
+        case Triangles:
+        {
+            std::size_t i = 5;
+            for (; i < vertexCount; i += 6)
+                addTrianglePair(v[i - 5], v[i - 4], v[i - 3], v[i - 2], v[i - 1], v[i], clip);
+            if (i - 3 < vertexCount)
+                addTriangle(v[i - 5], v[i - 4], v[i - 3], clip);
+            break;
+        }
+
+        case TriangleStrip:
+        {
+            std::size_t i = 3;
+            for (; i < vertexCount; i += 2)
+                addTrianglePair(v[i - 3], v[i - 2], v[i - 1], v[i - 2], v[i - 1], v[i], clip);
+            if (i - 1 < vertexCount)
+                addTriangle(v[i - 3], v[i - 2], v[i - 1], clip);
+            break;
+        }
+
+        case TriangleFan:
+        {
+            std::size_t i = 3;
+            for (; i < vertexCount; i += 2)
+                addTrianglePair(v[0], v[i - 2], v[i - 1], v[0], v[i - 1], v[i], clip);
+            if (i - 1 < vertexCount)
+                addTriangle(v[0], v[i - 2], v[i - 1], clip);
+            break;
+        }
+
+        case Quads:
+            for (std::size_t i = 3; i < vertexCount; i += 4)
+                addTrianglePair(v[i - 3], v[i - 2], v[i - 1], v[i - 3], v[i - 1], v[i], clip);
+            break;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void SoftwareRasterizer::render(unsigned int threadCount)
+{
+    if (!m_clear && m_triangles.empty())
+        return;
+
+    // Bin the triangles into the tiles that they overlap
+    unsigned int columns = (m_width + tileSize - 1) / tileSize;
+    unsigned int rows    = (m_height + tileSize - 1) / tileSize;
+
+    m_bins.resize(columns * rows);
+    for (std::size_t i = 0; i < m_bins.size(); ++i)
+        m_bins[i].clear();
+
+    for (std::size_t i = 0; i < m_triangles.size(); ++i)
+    {
+        const IntRect& bounds = m_triangles[i].bounds;
+        int firstColumn = bounds.left / tileSize;
+        int lastColumn  = (bounds.left + bounds.width - 1) / tileSize;
+        int firstRow    = bounds.top / tileSize;
+        int lastRow     = (bounds.top + bounds.height - 1) / tileSize;
+
+        for (int row = firstRow; row <= lastRow; ++row)
+            for (int column = firstColumn; column <= lastColumn; ++column)
+                m_bins[row * columns + column].push_back(static_cast<Uint32>(i));
+    }
+
+    // Rasterize the tiles, the calling thread takes part
+    m_nextTile = 0;
+    threadCount = std::min(threadCount, static_cast<unsigned int>(m_bins.size()));
+
+    std::vector<Thread*> workers;
+    for (unsigned int i = 1; i < threadCount; ++i)
+    {
+        workers.push_back(new Thread(&SoftwareRasterizer::rasterizeTiles, this));
+        workers.back()->launch();
+    }
+
+    rasterizeTiles();
+
+    for (std::vector<Thread*>::iterator it = workers.begin(); it != workers.end(); ++it)
+    {
+        (*it)->wait();
+        delete *it;
+    }
+
+    m_clear = false;
+    m_triangles.clear();
+    m_states.clear();
+
+    // Forget the textures that were not used since the previous render
+    for (std::map<Uint64, TextureData>::iterator it = m_textures.begin(); it != m_textures.end();)
+    {
+        if (it->second.frame < m_frame)
+            m_textures.erase(it++);
+        else
+            ++it;
+    }
+
+    ++m_frame;
+}
+
+
+////////////////////////////////////////////////////////////
+const Uint8* SoftwareRasterizer::getPixels() const
+{
+    return m_pixels.empty() ? NULL : &m_pixels[0];
+}
+
+
+////////////////////////////////////////////////////////////
+const SoftwareRasterizer::TextureData* SoftwareRasterizer::getTextureData(const Texture& texture)
+{
+    std::map<Uint64, TextureData>::iterator it = m_textures.find(texture.m_cacheId);
+
+    // The texture is read back once, then sampled from memory until its contents change
+    if (it == m_textures.end())
+    {
+        Image image = texture.copyToImage();
+
+        it = m_textures.insert(std::make_pair(texture.m_cacheId, TextureData())).first;
+        TextureData& data = it->second;
+        data.width  = static_cast<int>(image.getSize().x);
+        data.height = static_cast<int>(image.getSize().y);
+        if (image.getPixelsPtr())
+            data.pixels.assign(image.getPixelsPtr(), image.getPixelsPtr() + data.width * data.height * 4);
+    }
+
+    it->second.frame = m_frame;
+
+    return &it->second;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoftwareRasterizer::addTriangle(const Vertex& v0, const Vertex& v1, const Vertex& v2, const IntRect& viewport)
+{
+    float minX = std::min(v0.position.x, std::min(v1.position.x, v2.position.x));
+    float maxX = std::max(v0.position.x, std::max(v1.position.x, v2.position.x));
+    float minY = std::min(v0.position.y, std::min(v1.position.y, v2.position.y));
+    float maxY = std::max(v0.position.y, std::max(v1.position.y, v2.position.y));
+
+    // Reject the triangles with invalid coordinates and the ones outside of the viewport
+    if (!isFinite(minX) || !isFinite(maxX) || !isFinite(minY) || !isFinite(maxY))
+        return;
+
+    if ((maxX < viewport.left) || (minX > viewport.left + viewport.width) ||
+        (maxY < viewport.top)  || (minY > viewport.top + viewport.height))
+        return;
+
+    if ((minX >= -guardBand) && (maxX <= guardBand) && (minY >= -guardBand) && (maxY <= guardBand))
+    {
+        setupTriangle(v0, v1, v2, viewport, false);
+        return;
+    }
+
+    // Clip the triangle against the guard band, then split the resulting polygon
+    Vertex polygon[8] = {v0, v1, v2};
+    Vertex clipped[8];
+    std::size_t count = 3;
+
+    count = clipPolygon(polygon, count, clipped, false, 1.f);
+    count = clipPolygon(clipped, count, polygon, false, -1.f);
+    count = clipPolygon(polygon, count, clipped, true, 1.f);
+    count = clipPolygon(clipped, count, polygon, true, -1.f);
+
+    for (std::size_t i = 2; i < count; ++i)
+        setupTriangle(polygon[0], polygon[i - 1], polygon[i], viewport, false);
+}
+
+
+////////////////////////////////////////////////////////////
+void SoftwareRasterizer::addTrianglePair(const Vertex& a0, const Vertex& a1, const Vertex& a2,
+                                         const Vertex& b0, const Vertex& b1, const Vertex& b2, const IntRect& viewport)
+{
+    const Vertex* first[3]  = {&a0, &a1, &a2};
+    const Vertex* second[3] = {&b0, &b1, &b2};
+
+    // The triangles must share two vertices: find the other vertex of each one
+    int shared = 0;
+    const Vertex* otherSecond = NULL;
+    bool matched[3] = {false, false, false};
+    for (int i = 0; i < 3; ++i)
+    {
+        bool found = false;
+        for (int j = 0; (j < 3) && !found; ++j)
+        {
+            if (!matched[j] && isSame(*second[i], *first[j]))
+            {
+                matched[j] = true;
+                found = true;
+            }
+        }
+
+        if (found)
+            ++shared;
+        else
+            otherSecond = second[i];
+    }
+
+    if (shared == 2)
+    {
+        const Vertex* otherFirst = !matched[0] ? first[0] : (!matched[1] ? first[1] : first[2]);
+        const Vertex* diagonal[2];
+        for (int i = 0, j = 0; i < 3; ++i)
+        {
+            if (matched[i])
+                diagonal[j++] = first[i];
+        }
+
+        // They form an axis-aligned rectangle if the shared vertices are opposite corners...
+        const Vector2f& p0 = diagonal[0]->position;
+        const Vector2f& p1 = diagonal[1]->position;
+        const Vector2f& q0 = otherFirst->position;
+        const Vector2f& q1 = otherSecond->position;
+        bool rectangle = (p0.x != p1.x) && (p0.y != p1.y) &&
+                         (((q0 == Vector2f(p0.x, p1.y)) && (q1 == Vector2f(p1.x, p0.y))) ||
+                          ((q0 == Vector2f(p1.x, p0.y)) && (q1 == Vector2f(p0.x, p1.y))));
+
+        // ... and if the attributes of the two triangles lie on the same planes
+        rectangle = rectangle &&
+                    (otherFirst->texCoords + otherSecond->texCoords == diagonal[0]->texCoords + diagonal[1]->texCoords) &&
+                    (otherFirst->color.r + otherSecond->color.r == diagonal[0]->color.r + diagonal[1]->color.r) &&
+                    (otherFirst->color.g + otherSecond->color.g == diagonal[0]->color.g + diagonal[1]->color.g) &&
+                    (otherFirst->color.b + otherSecond->color.b == diagonal[0]->color.b + diagonal[1]->color.b) &&
+                    (otherFirst->color.a + otherSecond->color.a == diagonal[0]->color.a + diagonal[1]->color.a);
+
+        if (rectangle)
+        {
+            float left   = std::min(p0.x, p1.x);
+            float right  = std::max(p0.x, p1.x);
+            float top    = std::min(p0.y, p1.y);
+            float bottom = std::max(p0.y, p1.y);
+
+            if ((right < viewport.left) || (left > viewport.left + viewport.width) ||
+                (bottom < viewport.top) || (top > viewport.top + viewport.height))
+                return;
+
+            if ((left >= -guardBand) && (right <= guardBand) && (top >= -guardBand) && (bottom <= guardBand))
+            {
+                setupTriangle(*diagonal[0], *otherFirst, *diagonal[1], viewport, true);
+                return;
+            }
+        }
+    }
+
+    addTriangle(a0, a1, a2, viewport);
+    addTriangle(b0, b1, b2, viewport);
+}
+
+
+////////////////////////////////////////////////////////////
+void SoftwareRasterizer::setupTriangle(const Vertex& v0, const Vertex& v1, const Vertex& v2, const IntRect& viewport, bool rectangle)
+{
+    const Vertex* vertices[3] = {&v0, &v1, &v2};
+
+    // Snap the vertices to the subpixel grid
+    Int64 x[3];
+    Int64 y[3];
+    for (int i = 0; i < 3; ++i)
+    {
+        x[i] = static_cast<Int64>(std::floor(vertices[i]->position.x * static_cast<double>(subpixels) + 0.5));
+        y[i] = static_cast<Int64>(std::floor(vertices[i]->position.y * static_cast<double>(subpixels) + 0.5));
+    }
+
+    // Skip degenerate triangles, and orient the others so that the inside is positive
+    Int64 area = (x[1] - x[0]) * (y[2] - y[0]) - (y[1] - y[0]) * (x[2] - x[0]);
+    if (area == 0)
+        return;
+
+    if (area < 0)
+    {
+        std::swap(vertices[1], vertices[2]);
+        std::swap(x[1], x[2]);
+        std::swap(y[1], y[2]);
+    }
+
+    // Find the pixels whose center may be covered; the centers on the right
+    // and bottom sides of rectangles are outside, like with two triangles
+    const Int64 half = subpixels / 2;
+    Int64 minX   = std::min(x[0], std::min(x[1], x[2])) - half;
+    Int64 maxX   = std::max(x[0], std::max(x[1], x[2])) - half;
+    Int64 minY   = std::min(y[0], std::min(y[1], y[2])) - half;
+    Int64 maxY   = std::max(y[0], std::max(y[1], y[2])) - half;
+    Int64 left   = ceilDivide(minX, subpixels);
+    Int64 right  = rectangle ? ceilDivide(maxX, subpixels) - 1 : floorDivide(maxX, subpixels);
+    Int64 top    = ceilDivide(minY, subpixels);
+    Int64 bottom = rectangle ? ceilDivide(maxY, subpixels) - 1 : floorDivide(maxY, subpixels);
+
+    left   = std::max(left,   static_cast<Int64>(viewport.left));
+    right  = std::min(right,  static_cast<Int64>(viewport.left + viewport.width - 1));
+    top    = std::max(top,    static_cast<Int64>(viewport.top));
+    bottom = std::min(bottom, static_cast<Int64>(viewport.top + viewport.height - 1));
+
+    if ((left > right) || (top > bottom))
+        return;
+
+    Triangle triangle;
+    triangle.bounds = IntRect(static_cast<int>(left), static_cast<int>(top),
+                              static_cast<int>(right - left + 1), static_cast<int>(bottom - top + 1));
+
+    // Edge functions evaluated at the pixel centers; pixels exactly on an edge
+    // belong to the triangle only if it's a top or left edge. Rectangles are
+    // entirely defined by their bounds, their edge functions are left null
+    for (int i = 0; i < 3; ++i)
+    {
+        if (rectangle)
+        {
+            triangle.a[i] = 0;
+            triangle.b[i] = 0;
+            triangle.c[i] = 0;
+            continue;
+        }
+
+        int j = (i + 1) % 3;
+        Int64 dx = x[j] - x[i];
+        Int64 dy = y[j] - y[i];
+        bool topLeft = (dy < 0) || ((dy == 0) && (dx > 0));
+
+        triangle.a[i] = -dy * subpixels;
+        triangle.b[i] = dx * subpixels;
+        triangle.c[i] = dx * (half - y[i]) - dy * (half - x[i]) - (topLeft ? 0 : 1);
+    }
+
+    // Planes of the attributes, from the snapped positions
+    double x0  = x[0] / static_cast<double>(subpixels);
+    double y0  = y[0] / static_cast<double>(subpixels);
+    double d1x = (x[1] - x[0]) / static_cast<double>(subpixels);
+    double d1y = (y[1] - y[0]) / static_cast<double>(subpixels);
+    double d2x = (x[2] - x[0]) / static_cast<double>(subpixels);
+    double d2y = (y[2] - y[0]) / static_cast<double>(subpixels);
+    double determinant = d1x * d2y - d2x * d1y;
+
+    float attributes[3][6];
+    for (int i = 0; i < 3; ++i)
+    {
+        attributes[i][0] = vertices[i]->color.r;
+        attributes[i][1] = vertices[i]->color.g;
+        attributes[i][2] = vertices[i]->color.b;
+        attributes[i][3] = vertices[i]->color.a;
+        attributes[i][4] = vertices[i]->texCoords.x;
+        attributes[i][5] = vertices[i]->texCoords.y;
+    }
+
+    for (int k = 0; k < 6; ++k)
+    {
+        double delta1 = attributes[1][k] - attributes[0][k];
+        double delta2 = attributes[2][k] - attributes[0][k];
+        double stepX  = (delta1 * d2y - delta2 * d1y) / determinant;
+        double stepY  = (delta2 * d1x - delta1 * d2x) / determinant;
+
+        triangle.base[k]  = static_cast<float>(attributes[0][k] + stepX * (0.5 - x0) + stepY * (0.5 - y0));
+        triangle.stepX[k] = static_cast<float>(stepX);
+        triangle.stepY[k] = static_cast<float>(stepY);
+    }
+
+    triangle.flat = (v0.color == v1.color) && (v0.color == v2.color);
+    triangle.color[0] = v0.color.r;
+    triangle.color[1] = v0.color.g;
+    triangle.color[2] = v0.color.b;
+    triangle.color[3] = v0.color.a;
+    triangle.state = static_cast<Uint32>(m_states.size() - 1);
+
+    m_triangles.push_back(triangle);
+}
+
+
+////////////////////////////////////////////////////////////
+void SoftwareRasterizer::addLine(const Vertex& v0, const Vertex& v1, const IntRect& viewport)
+{
+    Vector2f direction = v1.position - v0.position;
+    float length = std::sqrt(direction.x * direction.x + direction.y * direction.y);
+    if (!(length > 0.f))
+        return;
+
+    // A quad one pixel wide covers the same pixels as an aliased line
+    Vector2f normal(-direction.y / length / 2.f, direction.x / length / 2.f);
+
+    Vertex corners[4] = {v0, v0, v1, v1};
+    corners[0].position += normal;
+    corners[1].position -= normal;
+    corners[2].position -= normal;
+    corners[3].position += normal;
+
+    addTrianglePair(corners[0], corners[1], corners[2], corners[0], corners[2], corners[3], viewport);
+}
+
+
+////////////////////////////////////////////////////////////
+void SoftwareRasterizer::addPoint(const Vertex& v, const IntRect& viewport)
+{
+    Vertex corners[4] = {v, v, v, v};
+    corners[0].position += Vector2f(-0.5f, -0.5f);
+    corners[1].position += Vector2f( 0.5f, -0.5f);
+    corners[2].position += Vector2f( 0.5f,  0.5f);
+    corners[3].position += Vector2f(-0.5f,  0.5f);
+
+    addTrianglePair(corners[0], corners[1], corners[2], corners[0], corners[2], corners[3], viewport);
+}
+
+
+////////////////////////////////////////////////////////////
+void SoftwareRasterizer::rasterizeTiles()
+{
+    for (;;)
+    {
+        std::size_t index;
+        {
+            Lock lock(m_tileMutex);
+
+            if (m_nextTile >= m_bins.size())
+                return;
+
+            index = m_nextTile++;
+        }
+
+        rasterizeTile(index);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void SoftwareRasterizer::rasterizeTile(std::size_t index)
+{
+    unsigned int columns = (m_width + tileSize - 1) / tileSize;
+
+    int tileLeft   = static_cast<int>(index % columns) * tileSize;
+    int tileTop    = static_cast<int>(index / columns) * tileSize;
+    int tileRight  = std::min(tileLeft + tileSize, static_cast<int>(m_width)) - 1;
+    int tileBottom = std::min(tileTop + tileSize, static_cast<int>(m_height)) - 1;
+
+    if (m_clear)
+    {
+        for (int y = tileTop; y <= tileBottom; ++y)
+            fillPixels(&m_pixels[(static_cast<std::size_t>(y) * m_width + tileLeft) * 4], tileRight - tileLeft + 1, m_clearColor);
+    }
+
+    Uint8 buffer[tileSize * 4];
+
+    const std::vector<Uint32>& bin = m_bins[index];
+    for (std::vector<Uint32>::const_iterator it = bin.begin(); it != bin.end(); ++it)
+    {
+        const Triangle& triangle = m_triangles[*it];
+        const IntRect& bounds = triangle.bounds;
+
+        int left   = std::max(bounds.left, tileLeft);
+        int right  = std::min(bounds.left + bounds.width - 1, tileRight);
+        int top    = std::max(bounds.top, tileTop);
+        int bottom = std::min(bounds.top + bounds.height - 1, tileBottom);
+
+        // Horizontal edges don't depend on X: they only restrict the range of rows
+        for (int i = 0; i < 3; ++i)
+        {
+            if (triangle.a[i] != 0)
+                continue;
+
+            // b * y + c >= 0 means y >= -c / b if b > 0, y <= c / -b otherwise
+            if (triangle.b[i] > 0)
+                top = static_cast<int>(std::max(static_cast<Int64>(top), ceilDivide(-triangle.c[i], triangle.b[i])));
+            else if (triangle.b[i] < 0)
+                bottom = static_cast<int>(std::min(static_cast<Int64>(bottom), floorDivide(triangle.c[i], -triangle.b[i])));
+            else if (triangle.c[i] < 0)
+                bottom = top - 1;
+        }
+
+        if ((left > right) || (top > bottom))
+            continue;
+
+        // The range of pixels inside each edge on a row is given by the quotient of the
+        // edge function and its X coefficient; it is stepped from row to row without dividing
+        Int64 quotient[3];
+        Int64 remainder[3];
+        Int64 divisor[3];
+        Int64 stepQuotient[3];
+        Int64 stepRemainder[3];
+        for (int i = 0; i < 3; ++i)
+        {
+            Int64 value = triangle.b[i] * top + triangle.c[i];
+            divisor[i]  = (triangle.a[i] > 0) ? triangle.a[i] : -triangle.a[i];
+
+            if (divisor[i] == 0)
+                continue;
+
+            quotient[i]      = floorDivide(value, divisor[i]);
+            remainder[i]     = value - quotient[i] * divisor[i];
+            stepQuotient[i]  = floorDivide(triangle.b[i], divisor[i]);
+            stepRemainder[i] = triangle.b[i] - stepQuotient[i] * divisor[i];
+        }
+
+        for (int y = top; y <= bottom; ++y)
+        {
+            Int64 first = left;
+            Int64 last  = right;
+            for (int i = 0; i < 3; ++i)
+            {
+                if (divisor[i] == 0)
+                    continue;
+
+                // a * x + value >= 0 means x >= -value / a if a > 0, x <= value / -a otherwise
+                if (triangle.a[i] > 0)
+                    first = std::max(first, -quotient[i]);
+                else
+                    last = std::min(last, quotient[i]);
+
+                quotient[i]  += stepQuotient[i];
+                remainder[i] += stepRemainder[i];
+                if (remainder[i] >= divisor[i])
+                {
+                    quotient[i]  += 1;
+                    remainder[i] -= divisor[i];
+                }
+            }
+
+            if (first <= last)
+                drawSpan(triangle, static_cast<int>(first), y, static_cast<int>(last - first + 1), buffer);
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void SoftwareRasterizer::drawSpan(const Triangle& triangle, int x, int y, int count, Uint8* buffer)
+{
+    const DrawState& state = m_states[triangle.state];
+    Uint8* destination = &m_pixels[(static_cast<std::size_t>(y) * m_width + x) * 4];
+
+    if (!state.texture && triangle.flat)
+    {
+        // Opaque fills don't depend on the destination, fully transparent ones don't change it
+        if ((state.blendMode == BlendNone) || ((state.blendMode == BlendAlpha) && (triangle.color[3] == 255)))
+        {
+            fillPixels(destination, count, triangle.color);
+            return;
+        }
+
+        if ((state.blendMode == BlendAlpha) && (triangle.color[3] == 0))
+            return;
+
+        fillPixels(buffer, count, triangle.color);
+    }
+    else
+    {
+        float fx = static_cast<float>(x);
+        float fy = static_cast<float>(y);
+
+        if (state.texture)
+        {
+            const TextureData& texture = *state.texture;
+            float u = triangle.base[4] + triangle.stepX[4] * fx + triangle.stepY[4] * fy;
+            float v = triangle.base[5] + triangle.stepX[5] * fx + triangle.stepY[5] * fy;
+            sampleTexture(&texture.pixels[0], texture.width, texture.height, state.smooth, state.repeated,
+                          u, v, triangle.stepX[4], triangle.stepX[5], count, buffer);
+        }
+
+        if (triangle.flat)
+        {
+            // White leaves the texels unchanged
+            const Uint8 white[] = {255, 255, 255, 255};
+            if (std::memcmp(triangle.color, white, 4) != 0)
+                modulatePixels(buffer, count, triangle.color);
+        }
+        else
+        {
+            float color[4];
+            for (int c = 0; c < 4; ++c)
+                color[c] = triangle.base[c] + triangle.stepX[c] * fx + triangle.stepY[c] * fy;
+
+            if (state.texture)
+            {
+                Uint8 colors[tileSize * 4];
+                interpolatePixels(colors, count, color, triangle.stepX);
+                for (int i = 0; i < count * 4; ++i)
+                    buffer[i] = static_cast<Uint8>(buffer[i] * colors[i] / 255);
+            }
+            else
+            {
+                interpolatePixels(buffer, count, color, triangle.stepX);
+            }
+        }
+    }
+
+    writePixels(destination, buffer, count, state.blendMode);
+}
+
+} // namespace priv
+
+} // namespace sf
@@ -0,0 +1,293 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2016 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_SOFTWARERASTERIZER_HPP
+#define SFML_SOFTWARERASTERIZER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/BlendMode.hpp>
+#include <SFML/Graphics/PrimitiveType.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/RenderStates.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <map>
+#include <vector>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Rasterizer executing the draws of a render target
+///        on the CPU
+///
+/// Draws are transformed and set up when they are submitted,
+/// then binned into tiles of 64x64 pixels. render() rasterizes
+/// the tiles in parallel, each one executing its primitives
+/// in submission order.
+///
+////////////////////////////////////////////////////////////
+class SoftwareRasterizer : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    SoftwareRasterizer();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Resize the color buffer
+    ///
+    /// The contents are reset to transparent black, and the
+    /// pending draws are discarded.
+    ///
+    /// \param width  New width, in pixels
+    /// \param height New height, in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    void resize(unsigned int width, unsigned int height);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Clear the whole color buffer
+    ///
+    /// As glClear, this ignores the viewport. The pending
+    /// draws are discarded since they would be overwritten.
+    ///
+    /// \param color Fill color
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear(const Color& color);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Submit primitives
+    ///
+    /// \param vertices      Pointer to the vertices
+    /// \param vertexCount   Number of vertices in the array
+    /// \param type          Type of primitives to draw
+    /// \param states        Render states to use for drawing
+    /// \param viewTransform Transform of the current view
+    /// \param viewport      Viewport of the current view, in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    void draw(const Vertex* vertices, std::size_t vertexCount, PrimitiveType type,
+              const RenderStates& states, const Transform& viewTransform, const IntRect& viewport);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Rasterize the pending draws into the color buffer
+    ///
+    /// \param threadCount Maximum number of threads to use, including the calling one
+    ///
+    ////////////////////////////////////////////////////////////
+    void render(unsigned int threadCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the RGBA pixels of the color buffer
+    ///
+    /// \return Pointer to the pixels, rows top to bottom
+    ///
+    ////////////////////////////////////////////////////////////
+    const Uint8* getPixels() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief CPU copy of a texture
+    ///
+    ////////////////////////////////////////////////////////////
+    struct TextureData
+    {
+        std::vector<Uint8> pixels; ///< RGBA pixels of the texture
+        int                width;  ///< Width of the texture
+        int                height; ///< Height of the texture
+        Uint64             frame;  ///< Last frame that used the texture
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief States shared by the primitives of a draw
+    ///
+    ////////////////////////////////////////////////////////////
+    struct DrawState
+    {
+        BlendMode          blendMode; ///< Blending mode
+        const TextureData* texture;   ///< Texture to sample, or NULL
+        bool               smooth;    ///< Sample the texture with bilinear filtering?
+        bool               repeated;  ///< Repeat the texture instead of clamping the coordinates?
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Triangle ready to be rasterized
+    ///
+    /// A pixel (x, y) of the bounds is covered if
+    /// a[i] * x + b[i] * y + c[i] >= 0 for the 3 edges, which are computed from vertices snapped to
+    /// 1/256 pixel so that adjacent triangles never overlap nor
+    /// leave gaps. Attributes (r, g, b, a, u, v) are evaluated as
+    /// base + stepX * x + stepY * y at the pixel centers.
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Triangle
+    {
+        Int64   a[3];     ///< X coefficient of each edge function
+        Int64   b[3];     ///< Y coefficient of each edge function
+        Int64   c[3];     ///< Constant term of each edge function
+        IntRect bounds;   ///< Covered pixels, clipped to the viewport
+        float   base[6];  ///< Attributes at pixel (0, 0)
+        float   stepX[6]; ///< Change of the attributes for one pixel along X
+        float   stepY[6]; ///< Change of the attributes for one pixel along Y
+        Uint8   color[4]; ///< Color of the vertices, if they share the same
+        bool    flat;     ///< Do the vertices share the same color?
+        Uint32  state;    ///< Index of the draw state
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the CPU copy of a texture, reading it back if needed
+    ///
+    /// \param texture Texture to copy
+    ///
+    /// \return Pointer to the copy
+    ///
+    ////////////////////////////////////////////////////////////
+    const TextureData* getTextureData(const Texture& texture);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Clip a triangle that exceeds the guard band, then add it
+    ///
+    /// \param v0       First vertex, in pixel coordinates
+    /// \param v1       Second vertex, in pixel coordinates
+    /// \param v2       Third vertex, in pixel coordinates
+    /// \param viewport Rectangle to clip the triangle to
+    ///
+    ////////////////////////////////////////////////////////////
+    void addTriangle(const Vertex& v0, const Vertex& v1, const Vertex& v2, const IntRect& viewport);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add two triangles
+    ///
+    /// If they form an axis-aligned rectangle, they are set up
+    /// as a single primitive which covers the same pixels.
+    ///
+    /// \param a0       First vertex of the first triangle, in pixel coordinates
+    /// \param a1       Second vertex of the first triangle, in pixel coordinates
+    /// \param a2       Third vertex of the first triangle, in pixel coordinates
+    /// \param b0       First vertex of the second triangle, in pixel coordinates
+    /// \param b1       Second vertex of the second triangle, in pixel coordinates
+    /// \param b2       Third vertex of the second triangle, in pixel coordinates
+    /// \param viewport Rectangle to clip the triangles to
+    ///
+    ////////////////////////////////////////////////////////////
+    void addTrianglePair(const Vertex& a0, const Vertex& a1, const Vertex& a2,
+                         const Vertex& b0, const Vertex& b1, const Vertex& b2, const IntRect& viewport);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set up a triangle that fits in the guard band
+    ///
+    /// \param v0        First vertex, in pixel coordinates
+    /// \param v1        Second vertex, in pixel coordinates
+    /// \param v2        Third vertex, in pixel coordinates
+    /// \param viewport  Rectangle to clip the triangle to
+    /// \param rectangle Is the triangle half of an axis-aligned rectangle, v0 and v2
+    ///                  being opposite corners? If so the whole rectangle is set up
+    ///
+    ////////////////////////////////////////////////////////////
+    void setupTriangle(const Vertex& v0, const Vertex& v1, const Vertex& v2, const IntRect& viewport, bool rectangle);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a line as a quad one pixel wide
+    ///
+    /// \param v0       First end, in pixel coordinates
+    /// \param v1       Second end, in pixel coordinates
+    /// \param viewport Rectangle to clip the line to
+    ///
+    ////////////////////////////////////////////////////////////
+    void addLine(const Vertex& v0, const Vertex& v1, const IntRect& viewport);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a point as a square of one pixel
+    ///
+    /// \param v        Point, in pixel coordinates
+    /// \param viewport Rectangle to clip the point to
+    ///
+    ////////////////////////////////////////////////////////////
+    void addPoint(const Vertex& v, const IntRect& viewport);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Rasterize the tiles until there is none left
+    ///
+    /// This is the function run by the worker threads.
+    ///
+    ////////////////////////////////////////////////////////////
+    void rasterizeTiles();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Rasterize the primitives of a tile
+    ///
+    /// \param index Index of the tile
+    ///
+    ////////////////////////////////////////////////////////////
+    void rasterizeTile(std::size_t index);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Shade and write a horizontal span of a triangle
+    ///
+    /// \param triangle Triangle to draw
+    /// \param x        First pixel of the span
+    /// \param y        Row of the span
+    /// \param count    Number of pixels
+    /// \param buffer   Scratch buffer of at least count pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    void drawSpan(const Triangle& triangle, int x, int y, int count, Uint8* buffer);
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    unsigned int                       m_width;         ///< Width of the color buffer
+    unsigned int                       m_height;        ///< Height of the color buffer
+    std::vector<Uint8>                 m_pixels;        ///< RGBA pixels of the color buffer
+    bool                               m_clear;         ///< Is a clear pending?
+    Uint8                              m_clearColor[4]; ///< Color of the pending clear
+    std::vector<Vertex>                m_vertices;      ///< Vertices of the current draw, in pixel coordinates
+    std::vector<Triangle>              m_triangles;     ///< Pending triangles, in submission order
+    std::vector<DrawState>             m_states;        ///< States of the pending triangles
+    std::map<Uint64, TextureData>      m_textures;      ///< CPU copies of the textures, by cache identifier
+    Uint64                             m_frame;         ///< Number of renders so far
+    bool                               m_shaderIgnored; ///< Has the lack of shader support been reported?
+    std::vector<std::vector<Uint32> >  m_bins;          ///< Triangles overlapping each tile
+    Mutex                              m_tileMutex;     ///< Mutex protecting the next tile to rasterize
+    std::size_t                        m_nextTile;      ///< Next tile to rasterize
+};
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_SOFTWARERASTERIZER_HPP
@@ -0,0 +1,125 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2016 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/SoftwareRenderTarget.hpp>
+#include <SFML/Graphics/SoftwareRasterizer.hpp>
+#include <SFML/System/Thread.hpp>
+#include <SFML/System/Err.hpp>
+
+
+namespace
+{
+    // Largest width or height of a target, which keeps the edge functions of the rasterizer in range
+    const unsigned int maximumSize = 16384;
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+SoftwareRenderTarget::SoftwareRenderTarget() :
+m_image      (),
+m_threadCount(0)
+{
+    m_rasterizer = new priv::SoftwareRasterizer;
+}
+
+
+////////////////////////////////////////////////////////////
+SoftwareRenderTarget::~SoftwareRenderTarget()
+{
+    delete m_rasterizer;
+}
+
+
+////////////////////////////////////////////////////////////
+bool SoftwareRenderTarget::create(unsigned int width, unsigned int height)
+{
+    if ((width == 0) || (height == 0) || (width > maximumSize) || (height > maximumSize))
+    {
+        err() << "Impossible to create software render target (invalid size: " << width << "x" << height
+              << ", maximum is " << maximumSize << "x" << maximumSize << ")" << std::endl;
+        return false;
+    }
+
+    m_rasterizer->resize(width, height);
+    m_image.create(width, height, Color::Transparent);
+
+    // We can now initialize the render target part
+    RenderTarget::initialize();
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoftwareRenderTarget::setThreadCount(unsigned int count)
+{
+    m_threadCount = count;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int SoftwareRenderTarget::getThreadCount() const
+{
+    return m_threadCount;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoftwareRenderTarget::display()
+{
+    if (!m_rasterizer->getPixels())
+        return;
+
+    m_rasterizer->render(m_threadCount ? m_threadCount : Thread::getHardwareConcurrency());
+    m_image.create(m_image.getSize().x, m_image.getSize().y, m_rasterizer->getPixels());
+}
+
+
+////////////////////////////////////////////////////////////
+Vector2u SoftwareRenderTarget::getSize() const
+{
+    return m_image.getSize();
+}
+
+
+////////////////////////////////////////////////////////////
+const Image& SoftwareRenderTarget::getImage() const
+{
+    return m_image;
+}
+
+
+////////////////////////////////////////////////////////////
+bool SoftwareRenderTarget::activate(bool)
+{
+    return false;
+}
+
+} // namespace sf
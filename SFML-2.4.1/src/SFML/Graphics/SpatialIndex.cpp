@@ -0,0 +1,399 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2016 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/SpatialIndex.hpp>
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/View.hpp>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+
+namespace
+{
+    // Objects that cover more cells than this, horizontally or vertically, are stored apart
+    const int maxCellSpan = 4;
+
+    // Initial number of buckets (the table grows with the number of objects)
+    const std::size_t minBucketCount = 64;
+
+    // Cell coordinates are clamped to this range, so that they fit in an int
+    const float maxCellCoordinate = 1073741824.f;
+
+    // Make the size of a rectangle positive
+    sf::FloatRect normalize(const sf::FloatRect& rect)
+    {
+        sf::FloatRect result = rect;
+        if (result.width < 0)
+        {
+            result.left += result.width;
+            result.width = -result.width;
+        }
+        if (result.height < 0)
+        {
+            result.top += result.height;
+            result.height = -result.height;
+        }
+        return result;
+    }
+
+    // Check whether two (normalized) rectangles overlap, their borders excluded
+    bool overlap(const sf::FloatRect& a, const sf::FloatRect& b)
+    {
+        return (a.left < b.left + b.width) && (b.left < a.left + a.width) &&
+               (a.top < b.top + b.height) && (b.top < a.top + a.height);
+    }
+
+    // Get the cell that contains a coordinate
+    int getCell(float coordinate, float cellSize)
+    {
+        float cell = std::floor(coordinate / cellSize);
+
+        // NaN ends up in the first cell
+        if (!(cell > -maxCellCoordinate))
+            return static_cast<int>(-maxCellCoordinate);
+        if (!(cell < maxCellCoordinate))
+            return static_cast<int>(maxCellCoordinate);
+        return static_cast<int>(cell);
+    }
+
+    // Remove an identifier from a list (the order is not preserved)
+    void removeId(std::vector<std::size_t>& ids, std::size_t id)
+    {
+        std::vector<std::size_t>::iterator it = std::find(ids.begin(), ids.end(), id);
+        if (it != ids.end())
+        {
+            *it = ids.back();
+            ids.pop_back();
+        }
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+SpatialIndex::SpatialIndex(float cellSize) :
+m_cellSize    (cellSize > 0 ? cellSize : 1.f),
+m_objects     (),
+m_freeIds     (),
+m_buckets     (minBucketCount),
+m_largeObjects(),
+m_nextOrder   (0),
+m_stamp       (0),
+m_found       ()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t SpatialIndex::insert(const Drawable& drawable, const FloatRect& bounds)
+{
+    return insert(drawable, NULL, NULL, bounds);
+}
+
+
+////////////////////////////////////////////////////////////
+void SpatialIndex::remove(std::size_t id)
+{
+    if ((id >= m_objects.size()) || !m_objects[id].drawable)
+        return;
+
+    unlink(id);
+    m_objects[id].drawable = NULL;
+    m_freeIds.push_back(id);
+}
+
+
+////////////////////////////////////////////////////////////
+void SpatialIndex::update(std::size_t id)
+{
+    if ((id >= m_objects.size()) || !m_objects[id].drawable || !m_objects[id].getBounds)
+        return;
+
+    move(id, m_objects[id].getBounds(m_objects[id].source));
+}
+
+
+////////////////////////////////////////////////////////////
+void SpatialIndex::update(std::size_t id, const FloatRect& bounds)
+{
+    if ((id >= m_objects.size()) || !m_objects[id].drawable)
+        return;
+
+    move(id, bounds);
+}
+
+
+////////////////////////////////////////////////////////////
+void SpatialIndex::update()
+{
+    for (std::size_t i = 0; i < m_objects.size(); ++i)
+    {
+        if (m_objects[i].drawable && m_objects[i].getBounds)
+            move(i, m_objects[i].getBounds(m_objects[i].source));
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void SpatialIndex::clear()
+{
+    m_objects.clear();
+    m_freeIds.clear();
+    m_buckets.clear();
+    m_buckets.resize(minBucketCount);
+    m_largeObjects.clear();
+    m_nextOrder = 0;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t SpatialIndex::getObjectCount() const
+{
+    return m_objects.size() - m_freeIds.size();
+}
+
+
+////////////////////////////////////////////////////////////
+void SpatialIndex::query(const FloatRect& area, std::vector<const Drawable*>& drawables) const
+{
+    find(normalize(area));
+
+    drawables.clear();
+    drawables.reserve(m_found.size());
+    for (std::size_t i = 0; i < m_found.size(); ++i)
+        drawables.push_back(m_objects[m_found[i].second].drawable);
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t SpatialIndex::drawVisible(RenderTarget& target, const View& view, const RenderStates& states) const
+{
+    // The visible area is the view's rectangle (in normalized device coordinates)
+    // brought back to the coordinate system of the objects
+    Transform toObjects = states.transform.getInverse() * view.getInverseTransform();
+    find(toObjects.transformRect(FloatRect(-1.f, -1.f, 2.f, 2.f)));
+
+    for (std::size_t i = 0; i < m_found.size(); ++i)
+        target.draw(*m_objects[m_found[i].second].drawable, states);
+
+    return m_found.size();
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t SpatialIndex::insert(const Drawable& drawable, const void* object, FloatRect (*getBounds)(const void*), const FloatRect& bounds)
+{
+    std::size_t id;
+    if (!m_freeIds.empty())
+    {
+        id = m_freeIds.back();
+        m_freeIds.pop_back();
+    }
+    else
+    {
+        id = m_objects.size();
+        m_objects.push_back(Object());
+    }
+
+    Object& entry = m_objects[id];
+    entry.drawable = &drawable;
+    entry.source = object;
+    entry.getBounds = getBounds;
+    entry.bounds = normalize(bounds);
+    entry.order = m_nextOrder++;
+    entry.stamp = 0;
+
+    IntRect cells;
+    entry.cells = getCells(entry.bounds, maxCellSpan, cells) ? cells : IntRect();
+    link(id);
+
+    // Keep about one object per bucket, so that the buckets stay short
+    if (getObjectCount() > m_buckets.size())
+        rehash(m_buckets.size() * 2);
+
+    return id;
+}
+
+
+////////////////////////////////////////////////////////////
+bool SpatialIndex::getCells(const FloatRect& rect, Int64 maxSpan, IntRect& cells) const
+{
+    int left = getCell(rect.left, m_cellSize);
+    int top = getCell(rect.top, m_cellSize);
+    int right = getCell(rect.left + rect.width, m_cellSize);
+    int bottom = getCell(rect.top + rect.height, m_cellSize);
+
+    // The clamped cells can be 2^31 apart, which doesn't fit in an int; NaN
+    // or infinite bounds can also end before they start
+    Int64 columns = static_cast<Int64>(right) - left + 1;
+    Int64 rows = static_cast<Int64>(bottom) - top + 1;
+    maxSpan = std::min(maxSpan, static_cast<Int64>(std::numeric_limits<int>::max()));
+    if ((columns <= 0) || (rows <= 0) || (columns > maxSpan) || (rows > maxSpan))
+        return false;
+
+    cells = IntRect(left, top, static_cast<int>(columns), static_cast<int>(rows));
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t SpatialIndex::getBucket(int x, int y) const
+{
+    Uint32 hash = (static_cast<Uint32>(x) * 73856093u) ^ (static_cast<Uint32>(y) * 19349663u);
+    return hash & (m_buckets.size() - 1);
+}
+
+
+////////////////////////////////////////////////////////////
+void SpatialIndex::link(std::size_t id)
+{
+    const IntRect& cells = m_objects[id].cells;
+    if (cells.width == 0)
+    {
+        m_largeObjects.push_back(id);
+        return;
+    }
+
+    for (int y = cells.top; y < cells.top + cells.height; ++y)
+        for (int x = cells.left; x < cells.left + cells.width; ++x)
+            m_buckets[getBucket(x, y)].push_back(id);
+}
+
+
+////////////////////////////////////////////////////////////
+void SpatialIndex::unlink(std::size_t id)
+{
+    const IntRect& cells = m_objects[id].cells;
+    if (cells.width == 0)
+    {
+        removeId(m_largeObjects, id);
+        return;
+    }
+
+    for (int y = cells.top; y < cells.top + cells.height; ++y)
+        for (int x = cells.left; x < cells.left + cells.width; ++x)
+            removeId(m_buckets[getBucket(x, y)], id);
+}
+
+
+////////////////////////////////////////////////////////////
+void SpatialIndex::move(std::size_t id, const FloatRect& bounds)
+{
+    Object& entry = m_objects[id];
+    entry.bounds = normalize(bounds);
+
+    // Only the objects that changed cells have to be moved in the grid
+    IntRect cells;
+    if (!getCells(entry.bounds, maxCellSpan, cells))
+        cells = IntRect();
+
+    if (cells != entry.cells)
+    {
+        unlink(id);
+        entry.cells = cells;
+        link(id);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void SpatialIndex::rehash(std::size_t bucketCount)
+{
+    m_buckets.clear();
+    m_buckets.resize(bucketCount);
+
+    for (std::size_t i = 0; i < m_objects.size(); ++i)
+    {
+        if (m_objects[i].drawable && (m_objects[i].cells.width > 0))
+            link(i);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void SpatialIndex::find(const FloatRect& area) const
+{
+    m_found.clear();
+
+    // Objects that cover several cells are found several times:
+    // the stamp of the query tells which ones were already tested
+    if (++m_stamp == 0)
+    {
+        for (std::size_t i = 0; i < m_objects.size(); ++i)
+            m_objects[i].stamp = 0;
+        m_stamp = 1;
+    }
+
+    IntRect cells;
+    if (!getCells(area, static_cast<Int64>(m_objects.size()), cells) ||
+        (static_cast<Uint64>(cells.width) * static_cast<Uint64>(cells.height) > m_objects.size()))
+    {
+        // The area covers more cells than there are objects (or can't be split
+        // in cells): testing all of them is cheaper
+        for (std::size_t i = 0; i < m_objects.size(); ++i)
+        {
+            if (m_objects[i].drawable && overlap(m_objects[i].bounds, area))
+                m_found.push_back(std::make_pair(m_objects[i].order, i));
+        }
+    }
+    else
+    {
+        for (int y = cells.top; y < cells.top + cells.height; ++y)
+        {
+            for (int x = cells.left; x < cells.left + cells.width; ++x)
+            {
+                const std::vector<std::size_t>& bucket = m_buckets[getBucket(x, y)];
+                for (std::size_t i = 0; i < bucket.size(); ++i)
+                {
+                    const Object& object = m_objects[bucket[i]];
+                    if (object.stamp != m_stamp)
+                    {
+                        object.stamp = m_stamp;
+                        if (overlap(object.bounds, area))
+                            m_found.push_back(std::make_pair(object.order, bucket[i]));
+                    }
+                }
+            }
+        }
+
+        for (std::size_t i = 0; i < m_largeObjects.size(); ++i)
+        {
+            const Object& object = m_objects[m_largeObjects[i]];
+            if (overlap(object.bounds, area))
+                m_found.push_back(std::make_pair(object.order, m_largeObjects[i]));
+        }
+    }
+
+    // Draw in insertion order
+    std::sort(m_found.begin(), m_found.end());
+}
+
+} // namespace sf
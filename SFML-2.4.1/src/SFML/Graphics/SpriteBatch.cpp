@@ -0,0 +1,505 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2016 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/SpriteBatch.hpp>
+#include <SFML/Graphics/SpriteExpansion.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/Window/Context.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Err.hpp>
+#include <cmath>
+
+
+#ifndef SFML_OPENGL_ES
+
+#if defined(SFML_SYSTEM_MACOS) || defined(SFML_SYSTEM_IOS)
+
+    #define castToGlHandle(x) reinterpret_cast<GLEXT_GLhandle>(static_cast<ptrdiff_t>(x))
+
+#else
+
+    #define castToGlHandle(x) (x)
+
+#endif
+
+#endif
+
+namespace
+{
+    sf::Mutex isAvailableMutex;
+
+    // Attributes of the internal shader; the first one is per vertex, the others per sprite
+    enum Attribute
+    {
+        CornerAttribute,
+        PositionAttribute,
+        TextureRectAttribute,
+        ColorAttribute,
+        RotationAttribute,
+        ScaleAttribute,
+        OriginAttribute,
+        AttributeCount
+    };
+
+    const char* attributeNames[AttributeCount] = {"corner", "position", "textureRect", "color", "rotation", "scale", "origin"};
+
+    // Corners of the two triangles of a sprite, relatively to its size
+    const float corners[12] = {0.f, 0.f, 1.f, 0.f, 0.f, 1.f, 0.f, 1.f, 1.f, 0.f, 1.f, 1.f};
+
+    // The vertex shader applies the same transform as sf::Transformable,
+    // and lets the texture matrix normalize the texture coordinates
+    const char vertexSource[] =
+        "attribute vec2 corner;\n"
+        "attribute vec2 position;\n"
+        "attribute vec4 textureRect;\n"
+        "attribute vec4 color;\n"
+        "attribute float rotation;\n"
+        "attribute vec2 scale;\n"
+        "attribute vec2 origin;\n"
+        "\n"
+        "void main()\n"
+        "{\n"
+        "    vec2 local = (corner * abs(textureRect.zw) - origin) * scale;\n"
+        "    float angle = radians(rotation);\n"
+        "    float c = cos(angle);\n"
+        "    float s = sin(angle);\n"
+        "    vec2 world = position + vec2(c * local.x - s * local.y, s * local.x + c * local.y);\n"
+        "    gl_Position = gl_ModelViewProjectionMatrix * vec4(world, 0.0, 1.0);\n"
+        "    gl_TexCoord[0] = gl_TextureMatrix[0] * vec4(textureRect.xy + corner * textureRect.zw, 0.0, 1.0);\n"
+        "    gl_FrontColor = color;\n"
+        "}\n";
+
+    const char fragmentSource[] =
+        "uniform sampler2D texture;\n"
+        "\n"
+        "void main()\n"
+        "{\n"
+        "    gl_FragColor = gl_Color * texture2D(texture, gl_TexCoord[0].xy);\n"
+        "}\n";
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+SpriteBatch::SpriteBatch() :
+m_texture      (NULL),
+m_verticesDirty(true),
+m_buffer       (0),
+m_bufferDirty  (true),
+m_shaderFailed (false)
+{
+    for (int i = 0; i < AttributeCount; ++i)
+        m_attributes[i] = -1;
+}
+
+
+////////////////////////////////////////////////////////////
+SpriteBatch::SpriteBatch(const Texture& texture) :
+m_texture      (&texture),
+m_verticesDirty(true),
+m_buffer       (0),
+m_bufferDirty  (true),
+m_shaderFailed (false)
+{
+    for (int i = 0; i < AttributeCount; ++i)
+        m_attributes[i] = -1;
+}
+
+
+////////////////////////////////////////////////////////////
+SpriteBatch::~SpriteBatch()
+{
+#ifndef SFML_OPENGL_ES
+
+    if (m_buffer)
+    {
+        TransientContextLock lock;
+
+        GLuint buffer = static_cast<GLuint>(m_buffer);
+        glCheck(GLEXT_glDeleteBuffers(1, &buffer));
+    }
+
+#endif
+}
+
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::setTexture(const Texture& texture)
+{
+    m_texture = &texture;
+}
+
+
+////////////////////////////////////////////////////////////
+const Texture* SpriteBatch::getTexture() const
+{
+    return m_texture;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t SpriteBatch::add(const Vector2f& position, const IntRect& textureRect, const Color& color,
+                             float rotation, const Vector2f& scale, const Vector2f& origin)
+{
+    m_positions.push_back(position);
+    m_textureRects.push_back(textureRect);
+    m_colors.push_back(color);
+    m_rotations.push_back(rotation);
+    m_scales.push_back(scale);
+    m_origins.push_back(origin);
+    invalidate();
+
+    return m_positions.size() - 1;
+}
+
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::resize(std::size_t count)
+{
+    m_positions.resize(count, Vector2f(0.f, 0.f));
+    m_textureRects.resize(count, IntRect());
+    m_colors.resize(count, Color::White);
+    m_rotations.resize(count, 0.f);
+    m_scales.resize(count, Vector2f(1.f, 1.f));
+    m_origins.resize(count, Vector2f(0.f, 0.f));
+    invalidate();
+}
+
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::clear()
+{
+    resize(0);
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t SpriteBatch::getSpriteCount() const
+{
+    return m_positions.size();
+}
+
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::setPosition(std::size_t index, const Vector2f& position)
+{
+    m_positions[index] = position;
+    invalidate();
+}
+
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::setTextureRect(std::size_t index, const IntRect& textureRect)
+{
+    m_textureRects[index] = textureRect;
+    invalidate();
+}
+
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::setColor(std::size_t index, const Color& color)
+{
+    m_colors[index] = color;
+    invalidate();
+}
+
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::setRotation(std::size_t index, float angle)
+{
+    angle = static_cast<float>(std::fmod(angle, 360.f));
+    if (angle < 0)
+        angle += 360.f;
+
+    m_rotations[index] = angle;
+    invalidate();
+}
+
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::setScale(std::size_t index, const Vector2f& scale)
+{
+    m_scales[index] = scale;
+    invalidate();
+}
+
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::setOrigin(std::size_t index, const Vector2f& origin)
+{
+    m_origins[index] = origin;
+    invalidate();
+}
+
+
+////////////////////////////////////////////////////////////
+const Vector2f& SpriteBatch::getPosition(std::size_t index) const
+{
+    return m_positions[index];
+}
+
+
+////////////////////////////////////////////////////////////
+const IntRect& SpriteBatch::getTextureRect(std::size_t index) const
+{
+    return m_textureRects[index];
+}
+
+
+////////////////////////////////////////////////////////////
+const Color& SpriteBatch::getColor(std::size_t index) const
+{
+    return m_colors[index];
+}
+
+
+////////////////////////////////////////////////////////////
+float SpriteBatch::getRotation(std::size_t index) const
+{
+    return m_rotations[index];
+}
+
+
+////////////////////////////////////////////////////////////
+const Vector2f& SpriteBatch::getScale(std::size_t index) const
+{
+    return m_scales[index];
+}
+
+
+////////////////////////////////////////////////////////////
+const Vector2f& SpriteBatch::getOrigin(std::size_t index) const
+{
+    return m_origins[index];
+}
+
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::getVertices(std::vector<Vertex>& vertices) const
+{
+    std::size_t count = m_positions.size();
+    vertices.resize(count * 6);
+
+    if (count > 0)
+        priv::expandSprites(&m_positions[0], &m_textureRects[0], &m_colors[0], &m_rotations[0],
+                            &m_scales[0], &m_origins[0], count, &vertices[0]);
+}
+
+
+////////////////////////////////////////////////////////////
+bool SpriteBatch::isInstancingAvailable()
+{
+    // Check it first, it has its own lock
+    bool shaders = Shader::isAvailable();
+
+    Lock lock(isAvailableMutex);
+
+    static bool checked = false;
+    static bool available = false;
+
+    if (!checked)
+    {
+        checked = true;
+
+        TransientContextLock contextLock;
+
+        // Make sure that extensions are initialized
+        sf::priv::ensureExtensionsInit();
+
+        available = shaders                    &&
+                    GLEXT_vertex_buffer_object &&
+                    GLEXT_draw_instanced       &&
+                    GLEXT_instanced_arrays;
+    }
+
+    return available;
+}
+
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::draw(RenderTarget& target, RenderStates states) const
+{
+    if (m_positions.empty())
+        return;
+
+    states.texture = m_texture;
+    states.coordinateType = Texture::Pixels;
+
+    // The internal shader replaces the user shader, and render queues and software
+    // targets take vertices: they all need the expanded sprites
+    if (m_texture && !states.shader && !target.m_queue && !target.m_rasterizer && !m_shaderFailed && isInstancingAvailable())
+    {
+        if (drawInstanced(target, states))
+            return;
+
+        m_shaderFailed = true;
+    }
+
+    if (m_verticesDirty)
+    {
+        getVertices(m_vertices);
+        m_verticesDirty = false;
+    }
+
+    target.draw(&m_vertices[0], m_vertices.size(), Triangles, states);
+}
+
+
+////////////////////////////////////////////////////////////
+bool SpriteBatch::drawInstanced(RenderTarget& target, RenderStates states) const
+{
+#ifndef SFML_OPENGL_ES
+
+    if (!target.makeActive())
+        return true;
+
+    // Create the internal shader on first use
+    if (!m_shader.getNativeHandle())
+    {
+        if (!m_shader.loadFromMemory(vertexSource, fragmentSource))
+        {
+            err() << "Failed to create the shader of a sprite batch, falling back to drawing without instancing" << std::endl;
+            return false;
+        }
+
+        m_shader.setUniform("texture", Shader::CurrentTexture);
+
+        for (int i = 0; i < AttributeCount; ++i)
+        {
+            glCheck(m_attributes[i] = GLEXT_glGetAttribLocation(castToGlHandle(m_shader.getNativeHandle()), attributeNames[i]));
+            if (m_attributes[i] == -1)
+            {
+                err() << "Failed to find the attribute \"" << attributeNames[i] << "\" in the shader of a sprite batch, "
+                      << "falling back to drawing without instancing" << std::endl;
+                return false;
+            }
+        }
+    }
+
+    // Layout of the attributes of the sprites in the buffer: one array after the other
+    std::size_t count = m_positions.size();
+    const void* arrays[AttributeCount] = {NULL, &m_positions[0], &m_textureRects[0], &m_colors[0],
+                                          &m_rotations[0], &m_scales[0], &m_origins[0]};
+    static const GLint     components[AttributeCount] = {2, 2, 4, 4, 1, 2, 2};
+    static const GLenum    types[AttributeCount]      = {GL_FLOAT, GL_FLOAT, GL_INT, GL_UNSIGNED_BYTE, GL_FLOAT, GL_FLOAT, GL_FLOAT};
+    static const GLboolean normalized[AttributeCount] = {GL_FALSE, GL_FALSE, GL_FALSE, GL_TRUE, GL_FALSE, GL_FALSE, GL_FALSE};
+    static const std::size_t sizes[AttributeCount]    = {0, sizeof(Vector2f), sizeof(IntRect), sizeof(Color),
+                                                         sizeof(float), sizeof(Vector2f), sizeof(Vector2f)};
+    std::size_t offsets[AttributeCount] = {0};
+    for (int i = 1; i < AttributeCount - 1; ++i)
+        offsets[i + 1] = offsets[i] + sizes[i] * count;
+    std::size_t bufferSize = offsets[AttributeCount - 1] + sizes[AttributeCount - 1] * count;
+
+    if (!m_buffer)
+    {
+        GLuint buffer = 0;
+        glCheck(GLEXT_glGenBuffers(1, &buffer));
+        m_buffer = static_cast<unsigned int>(buffer);
+    }
+
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, m_buffer));
+
+    // Upload the attributes only if they changed since the last draw
+    if (m_bufferDirty)
+    {
+        glCheck(GLEXT_glBufferData(GLEXT_GL_ARRAY_BUFFER, bufferSize, NULL, GLEXT_GL_STREAM_DRAW));
+        for (int i = 1; i < AttributeCount; ++i)
+            glCheck(GLEXT_glBufferSubData(GLEXT_GL_ARRAY_BUFFER, offsets[i], sizes[i] * count, arrays[i]));
+
+        m_bufferDirty = false;
+    }
+
+    states.shader = &m_shader;
+    target.setupDraw(false, states);
+
+    // The conventional arrays are not read by the shader, and may point to released memory
+    glCheck(glDisableClientState(GL_VERTEX_ARRAY));
+    glCheck(glDisableClientState(GL_COLOR_ARRAY));
+    glCheck(glDisableClientState(GL_TEXTURE_COORD_ARRAY));
+
+    // The attributes of the sprites advance once per instance, from the buffer...
+    const char* base = NULL;
+    for (int i = 1; i < AttributeCount; ++i)
+    {
+        GLuint location = static_cast<GLuint>(m_attributes[i]);
+        glCheck(GLEXT_glVertexAttribPointer(location, components[i], types[i], normalized[i], 0, base + offsets[i]));
+        glCheck(GLEXT_glVertexAttribDivisor(location, 1));
+        glCheck(GLEXT_glEnableVertexAttribArray(location));
+    }
+
+    // ... and the corners once per vertex, from client memory
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, 0));
+    GLuint cornerLocation = static_cast<GLuint>(m_attributes[CornerAttribute]);
+    glCheck(GLEXT_glVertexAttribPointer(cornerLocation, 2, GL_FLOAT, GL_FALSE, 0, corners));
+    glCheck(GLEXT_glEnableVertexAttribArray(cornerLocation));
+
+    glCheck(GLEXT_glDrawArraysInstanced(GL_TRIANGLES, 0, 6, static_cast<GLsizei>(count)));
+
+    // Restore the states expected by the render target
+    for (int i = 0; i < AttributeCount; ++i)
+    {
+        GLuint location = static_cast<GLuint>(m_attributes[i]);
+        if (i != CornerAttribute)
+            glCheck(GLEXT_glVertexAttribDivisor(location, 0));
+        glCheck(GLEXT_glDisableVertexAttribArray(location));
+    }
+
+    glCheck(glEnableClientState(GL_VERTEX_ARRAY));
+    glCheck(glEnableClientState(GL_COLOR_ARRAY));
+    glCheck(glEnableClientState(GL_TEXTURE_COORD_ARRAY));
+
+    target.cleanupDraw(states);
+
+    // The vertex pointers of the render target were not set by this draw
+    target.m_cache.useVertexCache = false;
+
+    return true;
+
+#else
+
+    (void)target;
+    (void)states;
+
+    return false;
+
+#endif
+}
+
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::invalidate()
+{
+    m_verticesDirty = true;
+    m_bufferDirty = true;
+}
+
+} // namespace sf
@@ -0,0 +1,96 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2016 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/SpriteExpansion.hpp>
+#include <cmath>
+#include <cstdlib>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+void expandSprites(const Vector2f* positions, const IntRect* textureRects, const Color* colors, const float* rotations,
+                   const Vector2f* scales, const Vector2f* origins, std::size_t count, Vertex* vertices)
+{
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const IntRect&  rect     = textureRects[i];
+        const Vector2f& position = positions[i];
+        const Vector2f& scale    = scales[i];
+        const Vector2f& origin   = origins[i];
+
+        // Same computation as sf::Transformable::getTransform
+        float cosine = 1.f;
+        float sine   = 0.f;
+        if (rotations[i] != 0.f)
+        {
+            float angle = -rotations[i] * 3.141592654f / 180.f;
+            cosine = static_cast<float>(std::cos(angle));
+            sine   = static_cast<float>(std::sin(angle));
+        }
+        float sxc = scale.x * cosine;
+        float syc = scale.y * cosine;
+        float sxs = scale.x * sine;
+        float sys = scale.y * sine;
+        float tx  = -origin.x * sxc - origin.y * sys + position.x;
+        float ty  =  origin.x * sxs - origin.y * syc + position.y;
+
+        // Corners of the sprite, like sf::Sprite (negative sizes flip the texture, not the geometry)
+        float width  = static_cast<float>(std::abs(rect.width));
+        float height = static_cast<float>(std::abs(rect.height));
+        Vertex* quad = &vertices[i * 6];
+        quad[0].position = Vector2f(tx, ty);
+        quad[1].position = Vector2f(sxc * width + tx, -sxs * width + ty);
+        quad[2].position = Vector2f(sys * height + tx, syc * height + ty);
+        quad[5].position = Vector2f(sxc * width + sys * height + tx, -sxs * width + syc * height + ty);
+
+        float left   = static_cast<float>(rect.left);
+        float right  = left + rect.width;
+        float top    = static_cast<float>(rect.top);
+        float bottom = top + rect.height;
+        quad[0].texCoords = Vector2f(left, top);
+        quad[1].texCoords = Vector2f(right, top);
+        quad[2].texCoords = Vector2f(left, bottom);
+        quad[5].texCoords = Vector2f(right, bottom);
+
+        for (int j = 0; j < 6; ++j)
+            quad[j].color = colors[i];
+
+        // The second triangle shares the diagonal of the first one
+        quad[3].position  = quad[2].position;
+        quad[3].texCoords = quad[2].texCoords;
+        quad[4].position  = quad[1].position;
+        quad[4].texCoords = quad[1].texCoords;
+    }
+}
+
+} // namespace priv
+
+} // namespace sf
@@ -0,0 +1,69 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2016 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_SPRITEEXPANSION_HPP
+#define SFML_SPRITEEXPANSION_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <cstddef>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Expand sprites into triangles
+///
+/// Each sprite produces 6 vertices (2 triangles), with the
+/// same transform as sf::Transformable and the same corners
+/// and texture coordinates as sf::Sprite. This is what
+/// sf::SpriteBatch draws when instancing is not available;
+/// it doesn't use OpenGL.
+///
+/// \param positions    Position of each sprite
+/// \param textureRects Texture rectangle of each sprite
+/// \param colors       Color of each sprite
+/// \param rotations    Rotation of each sprite, in degrees
+/// \param scales       Scale factors of each sprite
+/// \param origins      Origin of each sprite
+/// \param count        Number of sprites
+/// \param vertices     Array of count * 6 vertices to fill
+///
+////////////////////////////////////////////////////////////
+void expandSprites(const Vector2f* positions, const IntRect* textureRects, const Color* colors, const float* rotations,
+                   const Vector2f* scales, const Vector2f* origins, std::size_t count, Vertex* vertices);
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_SPRITEEXPANSION_HPP
@@ -27,13 +27,18 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/Texture.hpp>
 #include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/ImageView.hpp>
+#include <SFML/Graphics/CompressedImage.hpp>
 #include <SFML/Graphics/GLCheck.hpp>
 #include <SFML/Graphics/TextureSaver.hpp>
 #include <SFML/Window/Context.hpp>
 #include <SFML/Window/Window.hpp>
 #include <SFML/System/Mutex.hpp>
 #include <SFML/System/Lock.hpp>
+#include <SFML/System/FileInputStream.hpp>
+#include <SFML/System/MemoryInputStream.hpp>
 #include <SFML/System/Err.hpp>
+#include <algorithm>
 #include <cassert>
 #include <cstring>
 
@@ -53,6 +58,56 @@ namespace
 
         return id++;
     }
+
+    // Check whether the driver can sample from a compressed format
+    bool isCompressedFormatSupported(unsigned int format)
+    {
+        using namespace sf::priv;
+
+        // Desktop drivers don't always list all the formats that they support
+        // (especially in core profiles), so the extensions are checked first
+        if ((format >= CompressedRgbDxt1) && (format <= CompressedRgbaDxt5) && GLEXT_texture_compression_s3tc)
+            return true;
+        else if ((format >= 0x8C4C) && (format <= 0x8C4F) && GLEXT_texture_compression_s3tc && GLEXT_texture_sRGB)
+            return true;
+        else if ((format >= CompressedRgbEtc2) && (format <= 0x9279) && GLEXT_ES3_compatibility)
+            return true;
+        else if ((format >= CompressedRgbaAstc4x4) && (format <= 0x93DD) && GLEXT_texture_compression_astc_ldr)
+            return true;
+
+        GLint count = 0;
+        glCheck(glGetIntegerv(GLEXT_GL_NUM_COMPRESSED_TEXTURE_FORMATS, &count));
+        if (count <= 0)
+            return false;
+
+        std::vector<GLint> formats(count);
+        glCheck(glGetIntegerv(GLEXT_GL_COMPRESSED_TEXTURE_FORMATS, &formats[0]));
+
+        return std::find(formats.begin(), formats.end(), static_cast<GLint>(format)) != formats.end();
+    }
+
+    // Check whether images form a full mipmap chain, down to 1x1
+    bool isCompleteMipmapChain(const std::vector<sf::Image>& levels)
+    {
+        if (levels.empty())
+            return false;
+
+        sf::Vector2u size = levels[0].getSize();
+        std::size_t count = 1;
+        while ((std::max(size.x, size.y) >> count) > 0)
+            ++count;
+
+        if (levels.size() != count)
+            return false;
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            if (levels[i].getSize() != sf::Vector2u(std::max(size.x >> i, 1u), std::max(size.y >> i, 1u)))
+                return false;
+        }
+
+        return true;
+    }
 }
 
 
@@ -69,6 +124,7 @@ m_isRepeated   (false),
 m_pixelsFlipped(false),
 m_fboAttachment(false),
 m_hasMipmap    (false),
+m_isCompressed (false),
 m_cacheId      (getUniqueId())
 {
 }
@@ -85,6 +141,7 @@ m_isRepeated   (copy.m_isRepeated),
 m_pixelsFlipped(false),
 m_fboAttachment(false),
 m_hasMipmap    (false),
+m_isCompressed (false),
 m_cacheId      (getUniqueId())
 {
     if (copy.m_texture)
@@ -200,6 +257,7 @@ bool Texture::create(unsigned int width, unsigned int height)
     m_cacheId = getUniqueId();
 
     m_hasMipmap = false;
+    m_isCompressed = false;
 
     return true;
 }
@@ -297,6 +355,212 @@ bool Texture::loadFromImage(const Image& image, const IntRect& area)
 }
 
 
+////////////////////////////////////////////////////////////
+bool Texture::loadFromCompressedFile(const std::string& filename)
+{
+    FileInputStream stream;
+    if (!stream.open(filename))
+    {
+        err() << "Failed to load compressed image \"" << filename << "\". Reason: Unable to open file" << std::endl;
+        return false;
+    }
+
+    return loadFromCompressedStream(stream);
+}
+
+
+////////////////////////////////////////////////////////////
+bool Texture::loadFromCompressedMemory(const void* data, std::size_t size)
+{
+    if (!data || (size == 0))
+    {
+        err() << "Failed to load compressed image from memory, no data provided" << std::endl;
+        return false;
+    }
+
+    MemoryInputStream stream;
+    stream.open(data, size);
+
+    return loadFromCompressedStream(stream);
+}
+
+
+////////////////////////////////////////////////////////////
+bool Texture::loadFromCompressedStream(InputStream& stream)
+{
+    priv::CompressedImage image;
+    if (!priv::loadCompressedImage(stream, image))
+        return false;
+
+    if (image.format == priv::UncompressedRgba8)
+    {
+        // Uncompressed chains (see Image::saveMipmapsToFile) are uploaded like regular images
+        std::vector<Image> levels(image.levels.size());
+        for (std::size_t i = 0; i < image.levels.size(); ++i)
+            levels[i].create(std::max(image.size.x >> i, 1u), std::max(image.size.y >> i, 1u), &image.levels[i][0]);
+
+        // Drop the mipmap if it can't be used
+        if (!isCompleteMipmapChain(levels) || (getValidSize(image.size.x) != image.size.x) || (getValidSize(image.size.y) != image.size.y))
+            levels.resize(1);
+
+        // The sRGB flag must stay unchanged if loading fails
+        bool previousSrgb = m_sRgb;
+        m_sRgb = m_sRgb || image.sRgb;
+        if (loadFromMipmaps(levels))
+            return true;
+
+        m_sRgb = previousSrgb;
+        return false;
+    }
+
+    TransientContextLock lock;
+
+    // Make sure that extensions are initialized
+    priv::ensureExtensionsInit();
+
+    // Find the format to upload: ETC1 data can be uploaded as ETC2, which is a superset of it
+    bool sRgb = image.sRgb || m_sRgb;
+    unsigned int format = 0;
+    if (GLEXT_texture_compression)
+    {
+        if (sRgb && (GLEXT_texture_sRGB || (image.format >= priv::CompressedRgbEtc2)))
+        {
+            if (isCompressedFormatSupported(priv::getSrgbFormat(image.format)))
+                format = priv::getSrgbFormat(image.format);
+        }
+        else
+        {
+            sRgb = false;
+            if (isCompressedFormatSupported(image.format))
+                format = image.format;
+            else if ((image.format == priv::CompressedRgbEtc1) && isCompressedFormatSupported(priv::CompressedRgbEtc2))
+                format = priv::CompressedRgbEtc2;
+        }
+    }
+
+    // Compressed textures cannot be padded, so the size must be valid as is
+    if ((getValidSize(image.size.x) != image.size.x) || (getValidSize(image.size.y) != image.size.y))
+        format = 0;
+
+    if (!format)
+    {
+        // The driver can't use the compressed data directly, decompress it on the CPU
+        std::vector<Uint8> pixels;
+        if (!priv::decompressImage(image, 0, pixels))
+        {
+            err() << "Failed to load compressed image, its format (0x" << std::hex << image.format << std::dec
+                  << ") is not supported by the graphics driver" << std::endl;
+            return false;
+        }
+
+        Image decompressed;
+        decompressed.create(image.size.x, image.size.y, &pixels[0]);
+
+        // The sRGB flag must stay unchanged if loading fails
+        bool previousSrgb = m_sRgb;
+        m_sRgb = m_sRgb || image.sRgb;
+        if (loadFromImage(decompressed))
+            return true;
+
+        m_sRgb = previousSrgb;
+        return false;
+    }
+
+    // Check the maximum texture size
+    unsigned int maxSize = getMaximumSize();
+    if ((image.size.x > maxSize) || (image.size.y > maxSize))
+    {
+        err() << "Failed to create texture, its size is too high "
+              << "(" << image.size.x << "x" << image.size.y << ", "
+              << "maximum is " << maxSize << "x" << maxSize << ")"
+              << std::endl;
+        return false;
+    }
+
+    // Mipmaps can only be used if the chain goes down to 1x1
+    std::size_t levelCount = 1;
+    while ((std::max(image.size.x, image.size.y) >> levelCount) > 0)
+        ++levelCount;
+    if (image.levels.size() < levelCount)
+        levelCount = 1;
+
+    // All the validity checks passed, we can store the new texture settings
+    m_size          = image.size;
+    m_actualSize    = image.size;
+    m_sRgb          = sRgb;
+    m_pixelsFlipped = false;
+    m_fboAttachment = false;
+
+    // Create the OpenGL texture if it doesn't exist yet
+    if (!m_texture)
+    {
+        GLuint texture;
+        glCheck(glGenTextures(1, &texture));
+        m_texture = static_cast<unsigned int>(texture);
+    }
+
+    // Make sure that the current texture binding will be preserved
+    priv::TextureSaver save;
+
+    static bool textureEdgeClamp = GLEXT_texture_edge_clamp || GLEXT_EXT_texture_edge_clamp;
+
+    // Upload the compressed levels as they are
+    glCheck(glBindTexture(GL_TEXTURE_2D, m_texture));
+    for (std::size_t i = 0; i < levelCount; ++i)
+    {
+        GLsizei width  = static_cast<GLsizei>(std::max(image.size.x >> i, 1u));
+        GLsizei height = static_cast<GLsizei>(std::max(image.size.y >> i, 1u));
+        GLsizei size   = static_cast<GLsizei>(image.levels[i].size());
+        glCheck(GLEXT_glCompressedTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(i), format, width, height, 0, size, &image.levels[i][0]));
+    }
+
+    m_hasMipmap = (levelCount > 1);
+    m_isCompressed = true;
+
+    glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, m_isRepeated ? GL_REPEAT : (textureEdgeClamp ? GLEXT_GL_CLAMP_TO_EDGE : GLEXT_GL_CLAMP)));
+    glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, m_isRepeated ? GL_REPEAT : (textureEdgeClamp ? GLEXT_GL_CLAMP_TO_EDGE : GLEXT_GL_CLAMP)));
+    glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, m_isSmooth ? GL_LINEAR : GL_NEAREST));
+    if (m_hasMipmap)
+        glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, m_isSmooth ? GL_LINEAR_MIPMAP_LINEAR : GL_NEAREST_MIPMAP_LINEAR));
+    else
+        glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, m_isSmooth ? GL_LINEAR : GL_NEAREST));
+    m_cacheId = getUniqueId();
+
+    // Force an OpenGL flush, so that the texture will appear updated
+    // in all contexts immediately (solves problems in multi-threaded apps)
+    glCheck(glFlush());
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Texture::loadFromMipmaps(const std::vector<Image>& levels)
+{
+    if (levels.size() == 1)
+        return loadFromImage(levels[0]);
+
+    if (!isCompleteMipmapChain(levels))
+    {
+        err() << "Failed to load texture from mipmaps, the levels don't form a complete chain" << std::endl;
+        return false;
+    }
+
+    Vector2u size = levels[0].getSize();
+    if ((getValidSize(size.x) != size.x) || (getValidSize(size.y) != size.y))
+    {
+        err() << "Failed to load texture from mipmaps, its size (" << size.x << "x" << size.y
+              << ") is not supported by the graphics driver" << std::endl;
+        return false;
+    }
+
+    if (!loadFromImage(levels[0]))
+        return false;
+
+    return uploadMipmap(levels);
+}
+
+
 ////////////////////////////////////////////////////////////
 Vector2u Texture::getSize() const
 {
@@ -400,6 +664,12 @@ void Texture::update(const Uint8* pixels, unsigned int width, unsigned int heigh
     assert(x + width <= m_size.x);
     assert(y + height <= m_size.y);
 
+    if (m_isCompressed)
+    {
+        err() << "Failed to update texture, it holds compressed data" << std::endl;
+        return;
+    }
+
     if (pixels && m_texture)
     {
         TransientContextLock lock;
@@ -437,6 +707,65 @@ void Texture::update(const Image& image, unsigned int x, unsigned int y)
 }
 
 
+////////////////////////////////////////////////////////////
+void Texture::update(const ImageView& view, unsigned int x, unsigned int y)
+{
+    Vector2u size = view.getSize();
+    if (view.isContiguous())
+    {
+        update(view.getPixelsPtr(), size.x, size.y, x, y);
+        return;
+    }
+
+    assert(x + size.x <= m_size.x);
+    assert(y + size.y <= m_size.y);
+
+    if (m_isCompressed)
+    {
+        err() << "Failed to update texture, it holds compressed data" << std::endl;
+        return;
+    }
+
+    if (view.getPixelsPtr() && m_texture)
+    {
+        TransientContextLock lock;
+
+        // Make sure that the current texture binding will be preserved
+        priv::TextureSaver save;
+
+        glCheck(glBindTexture(GL_TEXTURE_2D, m_texture));
+
+#ifndef SFML_OPENGL_ES
+
+        // Let the driver skip the padding of the rows, if it is a whole number of pixels
+        if (view.getStride() % 4 == 0)
+        {
+            glCheck(glPixelStorei(GL_UNPACK_ROW_LENGTH, static_cast<GLint>(view.getStride() / 4)));
+            glCheck(glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, size.x, size.y, GL_RGBA, GL_UNSIGNED_BYTE, view.getPixelsPtr()));
+            glCheck(glPixelStorei(GL_UNPACK_ROW_LENGTH, 0));
+        }
+        else
+
+#endif
+
+        {
+            // OpenGL ES has no row length, upload the rows one by one
+            for (unsigned int i = 0; i < size.y; ++i)
+                glCheck(glTexSubImage2D(GL_TEXTURE_2D, 0, x, y + i, size.x, 1, GL_RGBA, GL_UNSIGNED_BYTE, view.getRow(i)));
+        }
+
+        glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, m_isSmooth ? GL_LINEAR : GL_NEAREST));
+        m_hasMipmap = false;
+        m_pixelsFlipped = false;
+        m_cacheId = getUniqueId();
+
+        // Force an OpenGL flush, so that the texture data will appear updated
+        // in all contexts immediately (solves problems in multi-threaded apps)
+        glCheck(glFlush());
+    }
+}
+
+
 ////////////////////////////////////////////////////////////
 void Texture::update(const Window& window)
 {
@@ -450,6 +779,12 @@ void Texture::update(const Window& window, unsigned int x, unsigned int y)
     assert(x + window.getSize().x <= m_size.x);
     assert(y + window.getSize().y <= m_size.y);
 
+    if (m_isCompressed)
+    {
+        err() << "Failed to update texture, it holds compressed data" << std::endl;
+        return;
+    }
+
     if (m_texture && window.setActive(true))
     {
         TransientContextLock lock;
@@ -457,10 +792,22 @@ void Texture::update(const Window& window, unsigned int x, unsigned int y)
         // Make sure that the current texture binding will be preserved
         priv::TextureSaver save;
 
+        // Render textures may render through the context of the window: read from the window itself
+        GLint frameBuffer = 0;
+        if (GLEXT_framebuffer_object)
+        {
+            glCheck(glGetIntegerv(GLEXT_GL_FRAMEBUFFER_BINDING, &frameBuffer));
+            if (frameBuffer)
+                glCheck(GLEXT_glBindFramebuffer(GLEXT_GL_FRAMEBUFFER, 0));
+        }
+
         // Copy pixels from the back-buffer to the texture
         glCheck(glBindTexture(GL_TEXTURE_2D, m_texture));
         glCheck(glCopyTexSubImage2D(GL_TEXTURE_2D, 0, x, y, 0, 0, window.getSize().x, window.getSize().y));
         glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, m_isSmooth ? GL_LINEAR : GL_NEAREST));
+
+        if (frameBuffer)
+            glCheck(GLEXT_glBindFramebuffer(GLEXT_GL_FRAMEBUFFER, static_cast<GLuint>(frameBuffer)));
         m_hasMipmap = false;
         m_pixelsFlipped = true;
         m_cacheId = getUniqueId();
@@ -574,13 +921,36 @@ bool Texture::generateMipmap()
     if (!m_texture)
         return false;
 
+    if (m_isCompressed)
+    {
+        err() << "Failed to generate mipmap, the texture holds compressed data" << std::endl;
+        return false;
+    }
+
     TransientContextLock lock;
 
     // Make sure that extensions are initialized
     priv::ensureExtensionsInit();
 
     if (!GLEXT_framebuffer_object)
-        return false;
+    {
+        // Build the levels on the CPU instead; the texture must not be padded
+        if (m_size != m_actualSize)
+            return false;
+
+        Image image = copyToImage();
+        if (image.getSize() != m_size)
+            return false;
+
+        // Keep the orientation in which the pixels are stored
+        if (m_pixelsFlipped)
+            image.flipVertically();
+
+        std::vector<Image> levels;
+        image.createMipmaps(levels, Image::BoxFilter, m_sRgb);
+
+        return uploadMipmap(levels);
+    }
 
     // Make sure that the current texture binding will be preserved
     priv::TextureSaver save;
@@ -613,6 +983,56 @@ void Texture::invalidateMipmap()
 }
 
 
+////////////////////////////////////////////////////////////
+bool Texture::uploadMipmap(const std::vector<Image>& levels)
+{
+    if (!m_texture || (m_size != m_actualSize) || !isCompleteMipmapChain(levels) || (levels[0].getSize() != m_size))
+        return false;
+
+    TransientContextLock lock;
+
+    // Make sure that the current texture binding will be preserved
+    priv::TextureSaver save;
+
+    glCheck(glBindTexture(GL_TEXTURE_2D, m_texture));
+    for (std::size_t i = 1; i < levels.size(); ++i)
+    {
+        Vector2u size = levels[i].getSize();
+        glCheck(glTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(i), (m_sRgb ? GLEXT_GL_SRGB8_ALPHA8 : GL_RGBA), size.x, size.y, 0, GL_RGBA, GL_UNSIGNED_BYTE, levels[i].getPixelsPtr()));
+    }
+    glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, m_isSmooth ? GL_LINEAR_MIPMAP_LINEAR : GL_NEAREST_MIPMAP_LINEAR));
+
+    m_hasMipmap = true;
+
+    // Force an OpenGL flush, so that the texture will appear updated
+    // in all contexts immediately (solves problems in multi-threaded apps)
+    glCheck(glFlush());
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void Texture::updateFromPixelBuffer()
+{
+    if (!m_texture)
+        return;
+
+    TransientContextLock lock;
+
+    // Make sure that the current texture binding will be preserved
+    priv::TextureSaver save;
+
+    // With a pixel unpack buffer bound, the pixel pointer is an offset in the buffer
+    glCheck(glBindTexture(GL_TEXTURE_2D, m_texture));
+    glCheck(glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, m_size.x, m_size.y, GL_RGBA, GL_UNSIGNED_BYTE, NULL));
+    glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, m_isSmooth ? GL_LINEAR : GL_NEAREST));
+    m_hasMipmap = false;
+    m_pixelsFlipped = false;
+    m_cacheId = getUniqueId();
+}
+
+
 ////////////////////////////////////////////////////////////
 void Texture::bind(const Texture* texture, CoordinateType coordinateType)
 {
@@ -695,20 +1115,43 @@ Texture& Texture::operator =(const Texture& right)
 {
     Texture temp(right);
 
-    std::swap(m_size,          temp.m_size);
-    std::swap(m_actualSize,    temp.m_actualSize);
-    std::swap(m_texture,       temp.m_texture);
-    std::swap(m_isSmooth,      temp.m_isSmooth);
-    std::swap(m_isRepeated,    temp.m_isRepeated);
-    std::swap(m_pixelsFlipped, temp.m_pixelsFlipped);
-    std::swap(m_fboAttachment, temp.m_fboAttachment);
-    std::swap(m_hasMipmap,     temp.m_hasMipmap);
-    m_cacheId = getUniqueId();
+    swap(temp);
 
     return *this;
 }
 
 
+////////////////////////////////////////////////////////////
+void Texture::swap(Texture& right)
+{
+    std::swap(m_size,          right.m_size);
+    std::swap(m_actualSize,    right.m_actualSize);
+    std::swap(m_texture,       right.m_texture);
+    std::swap(m_isSmooth,      right.m_isSmooth);
+    std::swap(m_sRgb,          right.m_sRgb);
+    std::swap(m_isRepeated,    right.m_isRepeated);
+    std::swap(m_pixelsFlipped, right.m_pixelsFlipped);
+    std::swap(m_fboAttachment, right.m_fboAttachment);
+    std::swap(m_hasMipmap,     right.m_hasMipmap);
+    std::swap(m_isCompressed,  right.m_isCompressed);
+
+    // Render targets identify the bound texture by its id, both must be seen as new textures
+    m_cacheId       = getUniqueId();
+    right.m_cacheId = getUniqueId();
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t Texture::getMemoryUsage() const
+{
+    if (!m_texture)
+        return 0;
+
+    std::size_t bytes = static_cast<std::size_t>(m_actualSize.x) * m_actualSize.y * 4;
+    return m_hasMipmap ? bytes + bytes / 3 : bytes;
+}
+
+
 ////////////////////////////////////////////////////////////
 unsigned int Texture::getNativeHandle() const
 {
@@ -0,0 +1,223 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2016 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/TextureAtlas.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/RectanglePacker.hpp>
+#include <SFML/System/Err.hpp>
+#include <algorithm>
+#include <cassert>
+
+
+namespace
+{
+    // Sort images by decreasing height, then width, which packs better
+    struct LargerFirst
+    {
+        LargerFirst(const std::vector<sf::Image>& images) : images(&images) {}
+
+        bool operator ()(std::size_t left, std::size_t right) const
+        {
+            sf::Vector2u leftSize  = (*images)[left].getSize();
+            sf::Vector2u rightSize = (*images)[right].getSize();
+            if (leftSize.y != rightSize.y)
+                return leftSize.y > rightSize.y;
+            else
+                return leftSize.x > rightSize.x;
+        }
+
+        const std::vector<sf::Image>* images;
+    };
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+TextureAtlas::Region::Region() :
+page(0),
+rect()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+TextureAtlas::TextureAtlas() :
+m_pages  (),
+m_regions(),
+m_names  ()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+bool TextureAtlas::loadFromFiles(const std::vector<std::string>& filenames, unsigned int pageSize, unsigned int padding, unsigned int threadCount)
+{
+    std::vector<Image> images;
+    std::size_t loaded = Image::loadFromFiles(filenames, images, threadCount);
+
+    bool packed = loadFromImages(images, filenames, pageSize, padding);
+
+    return packed && (loaded == filenames.size());
+}
+
+
+////////////////////////////////////////////////////////////
+bool TextureAtlas::loadFromImages(const std::vector<Image>& images, const std::vector<std::string>& names, unsigned int pageSize, unsigned int padding)
+{
+    m_pages.clear();
+    m_regions.clear();
+    m_names.clear();
+    m_regions.resize(images.size());
+
+    pageSize = std::min(pageSize, Texture::getMaximumSize());
+
+    // Pack the largest images first
+    std::vector<std::size_t> order(images.size());
+    for (std::size_t i = 0; i < order.size(); ++i)
+        order[i] = i;
+    std::sort(order.begin(), order.end(), LargerFirst(images));
+
+    bool success = true;
+    std::vector<priv::RectanglePacker> packers;
+    for (std::vector<std::size_t>::const_iterator it = order.begin(); it != order.end(); ++it)
+    {
+        Vector2u size = images[*it].getSize();
+        if ((size.x == 0) || (size.y == 0))
+        {
+            // Failed to load, there's already an error message
+            success = false;
+            continue;
+        }
+
+        // Padding is added to the right and bottom, so it also separates images from their neighbours
+        unsigned int width  = size.x + padding;
+        unsigned int height = size.y + padding;
+
+        if ((size.x > pageSize) || (size.y > pageSize))
+        {
+            err() << "Failed to add image to texture atlas (its size is " << size.x << "x" << size.y
+                  << ", the maximum allowed is " << pageSize << "x" << pageSize << ")" << std::endl;
+            success = false;
+            continue;
+        }
+
+        // Try the existing pages, then a new one (where the padding may not fit
+        // for images as large as the page, but it's not needed there)
+        Vector2u position;
+        std::size_t page = 0;
+        while ((page < packers.size()) && !packers[page].insert(width, height, position))
+            ++page;
+
+        if (page == packers.size())
+        {
+            packers.push_back(priv::RectanglePacker(pageSize, pageSize));
+            packers.back().insert(std::min(width, pageSize), std::min(height, pageSize), position);
+        }
+
+        m_regions[*it].page = page;
+        m_regions[*it].rect = IntRect(position.x, position.y, size.x, size.y);
+    }
+
+    // Compose the pages, cropped to the area they use
+    std::vector<Image> pages(packers.size());
+    for (std::size_t i = 0; i < packers.size(); ++i)
+    {
+        Vector2u used = packers[i].getUsedSize();
+        pages[i].create(used.x, used.y, Color::Transparent);
+    }
+
+    for (std::size_t i = 0; i < images.size(); ++i)
+    {
+        const Region& region = m_regions[i];
+        if (region.rect.width > 0)
+            pages[region.page].copy(images[i], region.rect.left, region.rect.top);
+    }
+
+    m_pages.resize(pages.size());
+    for (std::size_t i = 0; i < pages.size(); ++i)
+    {
+        if (!m_pages[i].loadFromImage(pages[i]))
+            success = false;
+    }
+
+    // Index the packed images by name
+    for (std::size_t i = 0; i < names.size() && i < m_regions.size(); ++i)
+    {
+        if (m_regions[i].rect.width > 0)
+            m_names[names[i]] = i;
+    }
+
+    return success;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t TextureAtlas::getRegionCount() const
+{
+    return m_regions.size();
+}
+
+
+////////////////////////////////////////////////////////////
+const TextureAtlas::Region& TextureAtlas::getRegion(std::size_t index) const
+{
+    assert(index < m_regions.size());
+
+    return m_regions[index];
+}
+
+
+////////////////////////////////////////////////////////////
+bool TextureAtlas::findRegion(const std::string& name, Region& region) const
+{
+    std::map<std::string, std::size_t>::const_iterator it = m_names.find(name);
+    if (it == m_names.end())
+        return false;
+
+    region = m_regions[it->second];
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t TextureAtlas::getPageCount() const
+{
+    return m_pages.size();
+}
+
+
+////////////////////////////////////////////////////////////
+const Texture& TextureAtlas::getTexture(std::size_t page) const
+{
+    assert(page < m_pages.size());
+
+    return m_pages[page];
+}
+
+} // namespace sf
@@ -0,0 +1,235 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2016 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/TextureCache.hpp>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+TextureCache::Loader::~Loader()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+bool TextureCache::Loader::load(const std::string& key, Texture& texture)
+{
+    return texture.loadFromFile(key);
+}
+
+
+////////////////////////////////////////////////////////////
+void TextureCache::Loader::unload(Texture& texture)
+{
+    // Swap with an empty texture that has the same settings; the OpenGL texture is destroyed with it
+    Texture empty;
+    empty.setSmooth(texture.isSmooth());
+    empty.setRepeated(texture.isRepeated());
+    empty.setSrgb(texture.isSrgb());
+    texture.swap(empty);
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t TextureCache::Loader::getMemoryUsage(const Texture& texture)
+{
+    return texture.getMemoryUsage();
+}
+
+
+////////////////////////////////////////////////////////////
+TextureCache::TextureCache(std::size_t budget, Loader* loader) :
+m_defaultLoader(),
+m_loader       (loader ? loader : &m_defaultLoader),
+m_budget       (budget),
+m_entries      (),
+m_usage        (),
+m_residentBytes(0),
+m_hits         (0),
+m_misses       (0),
+m_failures     (0),
+m_evictions    (0)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+TextureCache::~TextureCache()
+{
+    clear();
+}
+
+
+////////////////////////////////////////////////////////////
+void TextureCache::setBudget(std::size_t budget)
+{
+    m_budget = budget;
+    evict(NULL);
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t TextureCache::getBudget() const
+{
+    return m_budget;
+}
+
+
+////////////////////////////////////////////////////////////
+Texture* TextureCache::get(const std::string& key)
+{
+    // Find the entry, or create it the first time the texture is requested
+    EntryTable::iterator it = m_entries.find(key);
+    if (it == m_entries.end())
+    {
+        Entry* entry = new Entry;
+        entry->resident = false;
+        entry->bytes = 0;
+        it = m_entries.insert(std::make_pair(key, entry)).first;
+    }
+
+    Entry& entry = *it->second;
+
+    if (entry.resident)
+    {
+        // Move the texture to the front of the usage list
+        m_usage.splice(m_usage.begin(), m_usage, entry.usage);
+        m_hits++;
+        return &entry.texture;
+    }
+
+    m_misses++;
+    if (!m_loader->load(key, entry.texture))
+    {
+        m_failures++;
+        return NULL;
+    }
+
+    entry.resident = true;
+    entry.bytes = m_loader->getMemoryUsage(entry.texture);
+    entry.usage = m_usage.insert(m_usage.begin(), &entry);
+    m_residentBytes += entry.bytes;
+
+    evict(&entry);
+
+    return &entry.texture;
+}
+
+
+////////////////////////////////////////////////////////////
+bool TextureCache::isResident(const std::string& key) const
+{
+    EntryTable::const_iterator it = m_entries.find(key);
+    return (it != m_entries.end()) && it->second->resident;
+}
+
+
+////////////////////////////////////////////////////////////
+void TextureCache::remove(const std::string& key)
+{
+    EntryTable::iterator it = m_entries.find(key);
+    if (it == m_entries.end())
+        return;
+
+    if (it->second->resident)
+        unload(*it->second);
+
+    delete it->second;
+    m_entries.erase(it);
+}
+
+
+////////////////////////////////////////////////////////////
+void TextureCache::clear()
+{
+    for (EntryTable::iterator it = m_entries.begin(); it != m_entries.end(); ++it)
+    {
+        if (it->second->resident)
+            unload(*it->second);
+
+        delete it->second;
+    }
+
+    m_entries.clear();
+}
+
+
+////////////////////////////////////////////////////////////
+TextureCache::Statistics TextureCache::getStatistics() const
+{
+    Statistics statistics;
+    statistics.hits          = m_hits;
+    statistics.misses        = m_misses;
+    statistics.failures      = m_failures;
+    statistics.evictions     = m_evictions;
+    statistics.hitRate       = (m_hits + m_misses > 0) ? static_cast<float>(m_hits) / (m_hits + m_misses) : 0.f;
+    statistics.textureCount  = m_entries.size();
+    statistics.residentCount = m_usage.size();
+    statistics.residentBytes = m_residentBytes;
+
+    return statistics;
+}
+
+
+////////////////////////////////////////////////////////////
+void TextureCache::resetStatistics()
+{
+    m_hits      = 0;
+    m_misses    = 0;
+    m_failures  = 0;
+    m_evictions = 0;
+}
+
+
+////////////////////////////////////////////////////////////
+void TextureCache::unload(Entry& entry)
+{
+    m_loader->unload(entry.texture);
+    m_usage.erase(entry.usage);
+    m_residentBytes -= entry.bytes;
+    entry.resident = false;
+    entry.bytes = 0;
+}
+
+
+////////////////////////////////////////////////////////////
+void TextureCache::evict(const Entry* keep)
+{
+    if (m_budget == 0)
+        return;
+
+    // Unload from the back of the usage list, where the least recently used textures are
+    while ((m_residentBytes > m_budget) && !m_usage.empty() && (m_usage.back() != keep))
+    {
+        unload(*m_usage.back());
+        m_evictions++;
+    }
+}
+
+} // namespace sf
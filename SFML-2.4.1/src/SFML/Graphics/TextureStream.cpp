@@ -0,0 +1,443 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2016 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/TextureStream.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/Graphics/TextureSaver.hpp>
+#include <SFML/Window/Context.hpp>
+#include <SFML/System/Err.hpp>
+#include <cstring>
+
+
+namespace
+{
+#ifndef SFML_OPENGL_ES
+
+    // Wait until a fence is signaled, then destroy it
+    void waitFence(void*& fence)
+    {
+        if (!fence)
+            return;
+
+        GLEXT_GLsync sync = static_cast<GLEXT_GLsync>(fence);
+
+        // Flush the first time so that the fence is guaranteed to be reached
+        GLbitfield flags = GLEXT_GL_SYNC_FLUSH_COMMANDS_BIT;
+        while (GLEXT_glClientWaitSync(sync, flags, 1000000000) == GLEXT_GL_TIMEOUT_EXPIRED)
+            flags = 0;
+
+        glCheck(GLEXT_glDeleteSync(sync));
+        fence = NULL;
+    }
+
+#endif
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+TextureStream::TextureStream() :
+m_texture     (NULL),
+m_size        (0, 0),
+m_actualSize  (0, 0),
+m_buffers     (),
+m_next        (0),
+m_lastTransfer(0),
+m_asynchronous(false)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+TextureStream::~TextureStream()
+{
+    cleanup();
+}
+
+
+////////////////////////////////////////////////////////////
+bool TextureStream::create(Texture& texture, unsigned int bufferCount)
+{
+    if (!texture.m_texture)
+    {
+        err() << "Failed to create texture stream, the texture is empty" << std::endl;
+        return false;
+    }
+
+    cleanup();
+
+    m_texture    = &texture;
+    m_size       = texture.m_size;
+    m_actualSize = texture.m_actualSize;
+    m_next       = 0;
+    m_buffers.resize(bufferCount > 0 ? bufferCount : 1);
+    for (std::size_t i = 0; i < m_buffers.size(); ++i)
+    {
+        m_buffers[i].buffer   = 0;
+        m_buffers[i].fence    = NULL;
+        m_buffers[i].transfer = 0;
+        m_buffers[i].download = false;
+        m_buffers[i].flipped  = false;
+    }
+
+#ifndef SFML_OPENGL_ES
+
+    TransientContextLock lock;
+
+    // Make sure that extensions are initialized
+    priv::ensureExtensionsInit();
+
+    m_asynchronous = GLEXT_vertex_buffer_object && GLEXT_pixel_buffer_object;
+
+    if (m_asynchronous)
+    {
+        // Downloads read the whole (padded) texture, so the buffers are allocated for its actual size
+        GLsizeiptrARB size = static_cast<GLsizeiptrARB>(m_actualSize.x) * m_actualSize.y * 4;
+        for (std::size_t i = 0; i < m_buffers.size(); ++i)
+        {
+            GLuint buffer = 0;
+            glCheck(GLEXT_glGenBuffers(1, &buffer));
+            glCheck(GLEXT_glBindBuffer(GLEXT_GL_PIXEL_UNPACK_BUFFER, buffer));
+            glCheck(GLEXT_glBufferData(GLEXT_GL_PIXEL_UNPACK_BUFFER, size, NULL, GLEXT_GL_STREAM_DRAW));
+            m_buffers[i].buffer = static_cast<unsigned int>(buffer);
+        }
+        glCheck(GLEXT_glBindBuffer(GLEXT_GL_PIXEL_UNPACK_BUFFER, 0));
+    }
+
+#endif
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+TextureStream::Transfer TextureStream::upload(const Uint8* pixels)
+{
+    if (!m_texture || !pixels)
+        return 0;
+
+    if (m_texture->getSize() != m_size)
+    {
+        err() << "Failed to upload pixels to texture stream, the texture has been resized" << std::endl;
+        return 0;
+    }
+
+    Buffer& buffer = nextBuffer(false);
+
+    if (!m_asynchronous)
+    {
+        m_texture->update(pixels);
+        return buffer.transfer;
+    }
+
+#ifndef SFML_OPENGL_ES
+
+    TransientContextLock lock;
+
+    // Orphan the previous storage of the buffer, so that the driver can give us
+    // new memory instead of waiting until the previous transfer is finished
+    GLsizeiptrARB size = static_cast<GLsizeiptrARB>(m_size.x) * m_size.y * 4;
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_PIXEL_UNPACK_BUFFER, buffer.buffer));
+    glCheck(GLEXT_glBufferData(GLEXT_GL_PIXEL_UNPACK_BUFFER, static_cast<GLsizeiptrARB>(m_actualSize.x) * m_actualSize.y * 4, NULL, GLEXT_GL_STREAM_DRAW));
+
+    void* destination = GLEXT_glMapBuffer(GLEXT_GL_PIXEL_UNPACK_BUFFER, GLEXT_GL_WRITE_ONLY);
+    if (destination)
+    {
+        std::memcpy(destination, pixels, static_cast<std::size_t>(size));
+        glCheck(GLEXT_glUnmapBuffer(GLEXT_GL_PIXEL_UNPACK_BUFFER));
+    }
+    else
+    {
+        // Mapping failed, let the driver copy the pixels
+        glCheck(GLEXT_glBufferData(GLEXT_GL_PIXEL_UNPACK_BUFFER, size, pixels, GLEXT_GL_STREAM_DRAW));
+    }
+
+    // The copy from the buffer to the texture is executed asynchronously
+    m_texture->updateFromPixelBuffer();
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_PIXEL_UNPACK_BUFFER, 0));
+
+    if (GLEXT_sync)
+        buffer.fence = GLEXT_glFenceSync(GLEXT_GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+    // Force an OpenGL flush, so that the texture will appear updated
+    // in all contexts immediately (solves problems in multi-threaded apps)
+    glCheck(glFlush());
+
+#endif
+
+    return buffer.transfer;
+}
+
+
+////////////////////////////////////////////////////////////
+TextureStream::Transfer TextureStream::upload(const Image& image)
+{
+    if (image.getSize() != m_size)
+    {
+        err() << "Failed to upload image to texture stream, its size doesn't match the texture" << std::endl;
+        return 0;
+    }
+
+    return upload(image.getPixelsPtr());
+}
+
+
+////////////////////////////////////////////////////////////
+TextureStream::Transfer TextureStream::download()
+{
+    if (!m_texture)
+        return 0;
+
+    if (m_texture->getSize() != m_size)
+    {
+        err() << "Failed to download pixels from texture stream, the texture has been resized" << std::endl;
+        return 0;
+    }
+
+    Buffer& buffer = nextBuffer(true);
+
+    if (!m_asynchronous)
+    {
+        buffer.image = m_texture->copyToImage();
+        return buffer.transfer;
+    }
+
+#ifndef SFML_OPENGL_ES
+
+    TransientContextLock lock;
+
+    // Make sure that the current texture binding will be preserved
+    priv::TextureSaver save;
+
+    // With a pixel pack buffer bound, glGetTexImage returns immediately
+    // and the pixels are copied to the buffer in the background
+    buffer.flipped = m_texture->m_pixelsFlipped;
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_PIXEL_PACK_BUFFER, buffer.buffer));
+    glCheck(glBindTexture(GL_TEXTURE_2D, m_texture->m_texture));
+    glCheck(glGetTexImage(GL_TEXTURE_2D, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL));
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_PIXEL_PACK_BUFFER, 0));
+
+    if (GLEXT_sync)
+        buffer.fence = GLEXT_glFenceSync(GLEXT_GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+    glCheck(glFlush());
+
+#endif
+
+    return buffer.transfer;
+}
+
+
+////////////////////////////////////////////////////////////
+bool TextureStream::isComplete(Transfer transfer) const
+{
+    Buffer* buffer = const_cast<TextureStream*>(this)->findBuffer(transfer);
+
+    // Reused buffers belong to transfers that are complete
+    if (!buffer || !buffer->fence)
+        return true;
+
+#ifndef SFML_OPENGL_ES
+
+    TransientContextLock lock;
+
+    GLenum status = GLEXT_glClientWaitSync(static_cast<GLEXT_GLsync>(buffer->fence), 0, 0);
+    return (status == GLEXT_GL_ALREADY_SIGNALED) || (status == GLEXT_GL_CONDITION_SATISFIED);
+
+#else
+
+    return true;
+
+#endif
+}
+
+
+////////////////////////////////////////////////////////////
+void TextureStream::wait(Transfer transfer)
+{
+    Buffer* buffer = findBuffer(transfer);
+    if (!buffer || !buffer->fence)
+        return;
+
+#ifndef SFML_OPENGL_ES
+
+    TransientContextLock lock;
+
+    waitFence(buffer->fence);
+
+#endif
+}
+
+
+////////////////////////////////////////////////////////////
+bool TextureStream::getImage(Transfer transfer, Image& image)
+{
+    Buffer* buffer = findBuffer(transfer);
+    if (!buffer || !buffer->download)
+    {
+        err() << "Failed to get image from texture stream, the transfer is not a pending download" << std::endl;
+        return false;
+    }
+
+    if (!m_asynchronous)
+    {
+        image = buffer->image;
+        return true;
+    }
+
+#ifndef SFML_OPENGL_ES
+
+    TransientContextLock lock;
+
+    waitFence(buffer->fence);
+
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_PIXEL_PACK_BUFFER, buffer->buffer));
+    const Uint8* source = static_cast<const Uint8*>(GLEXT_glMapBuffer(GLEXT_GL_PIXEL_PACK_BUFFER, GLEXT_GL_READ_ONLY));
+    if (!source)
+    {
+        glCheck(GLEXT_glBindBuffer(GLEXT_GL_PIXEL_PACK_BUFFER, 0));
+        err() << "Failed to get image from texture stream, the pixel buffer cannot be mapped" << std::endl;
+        return false;
+    }
+
+    // Copy the useful pixels, skipping the padding and handling flipped textures
+    std::vector<Uint8> pixels(m_size.x * m_size.y * 4);
+    int sourcePitch = m_actualSize.x * 4;
+    std::size_t pitch = m_size.x * 4;
+    if (buffer->flipped)
+    {
+        source += sourcePitch * (m_size.y - 1);
+        sourcePitch = -sourcePitch;
+    }
+
+    for (unsigned int i = 0; i < m_size.y; ++i)
+    {
+        std::memcpy(&pixels[i * pitch], source, pitch);
+        source += sourcePitch;
+    }
+
+    glCheck(GLEXT_glUnmapBuffer(GLEXT_GL_PIXEL_PACK_BUFFER));
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_PIXEL_PACK_BUFFER, 0));
+
+    image.create(m_size.x, m_size.y, &pixels[0]);
+
+#endif
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool TextureStream::isAsynchronous() const
+{
+    return m_asynchronous;
+}
+
+
+////////////////////////////////////////////////////////////
+void TextureStream::cleanup()
+{
+#ifndef SFML_OPENGL_ES
+
+    if (m_asynchronous)
+    {
+        TransientContextLock lock;
+
+        for (std::size_t i = 0; i < m_buffers.size(); ++i)
+        {
+            if (m_buffers[i].fence)
+                glCheck(GLEXT_glDeleteSync(static_cast<GLEXT_GLsync>(m_buffers[i].fence)));
+
+            GLuint buffer = static_cast<GLuint>(m_buffers[i].buffer);
+            if (buffer)
+                glCheck(GLEXT_glDeleteBuffers(1, &buffer));
+        }
+    }
+
+#endif
+
+    m_buffers.clear();
+    m_texture = NULL;
+    m_asynchronous = false;
+}
+
+
+////////////////////////////////////////////////////////////
+TextureStream::Buffer& TextureStream::nextBuffer(bool download)
+{
+    Buffer& buffer = m_buffers[m_next];
+    m_next = (m_next + 1) % m_buffers.size();
+
+#ifndef SFML_OPENGL_ES
+
+    // Uploads orphan the buffer storage, but downloads write into it
+    // and must not start before the previous transfer is finished
+    if (buffer.fence)
+    {
+        TransientContextLock lock;
+
+        if (download)
+        {
+            waitFence(buffer.fence);
+        }
+        else
+        {
+            glCheck(GLEXT_glDeleteSync(static_cast<GLEXT_GLsync>(buffer.fence)));
+            buffer.fence = NULL;
+        }
+    }
+
+#endif
+
+    buffer.transfer = ++m_lastTransfer;
+    buffer.download = download;
+    buffer.flipped  = false;
+    buffer.image    = Image();
+
+    return buffer;
+}
+
+
+////////////////////////////////////////////////////////////
+TextureStream::Buffer* TextureStream::findBuffer(Transfer transfer)
+{
+    if (transfer == 0)
+        return NULL;
+
+    for (std::size_t i = 0; i < m_buffers.size(); ++i)
+    {
+        if (m_buffers[i].transfer == transfer)
+            return &m_buffers[i];
+    }
+
+    return NULL;
+}
+
+} // namespace sf
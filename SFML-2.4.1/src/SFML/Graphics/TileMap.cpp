@@ -0,0 +1,468 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2016 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/TileMap.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/View.hpp>
+#include <algorithm>
+#include <cmath>
+
+
+namespace
+{
+    // Minimum number of chunks whose geometry is kept when they are not visible
+    const std::size_t minResidentChunks = 256;
+
+    // Get the range of chunks [first, last) covered by an interval of local coordinates
+    void getChunkRange(float begin, float end, float chunkSize, unsigned int count, unsigned int& first, unsigned int& last)
+    {
+        float low  = std::floor(begin / chunkSize);
+        float high = std::ceil(end / chunkSize);
+
+        // NaN gives an empty range
+        first = (low > 0.f) ? ((low < static_cast<float>(count)) ? static_cast<unsigned int>(low) : count) : 0;
+        last  = (high > 0.f) ? ((high < static_cast<float>(count)) ? static_cast<unsigned int>(high) : count) : 0;
+        if (!(low == low) || !(high == high) || (last < first))
+            last = first;
+    }
+
+    // Set the texture coordinates of the two triangles of a tile
+    void setTexCoords(sf::Vertex* vertices, const sf::IntRect& rect)
+    {
+        float left   = static_cast<float>(rect.left);
+        float top    = static_cast<float>(rect.top);
+        float right  = static_cast<float>(rect.left + rect.width);
+        float bottom = static_cast<float>(rect.top + rect.height);
+
+        vertices[0].texCoords = sf::Vector2f(left, top);
+        vertices[1].texCoords = sf::Vector2f(right, top);
+        vertices[2].texCoords = sf::Vector2f(left, bottom);
+        vertices[3].texCoords = sf::Vector2f(left, bottom);
+        vertices[4].texCoords = sf::Vector2f(right, top);
+        vertices[5].texCoords = sf::Vector2f(right, bottom);
+    }
+
+    // Order the chunk indices from the most recently drawn
+    template <typename T>
+    struct MoreRecent
+    {
+        explicit MoreRecent(const std::vector<T>& chunks) : chunks(chunks) {}
+
+        bool operator ()(std::size_t a, std::size_t b) const
+        {
+            return chunks[a].lastDrawn > chunks[b].lastDrawn;
+        }
+
+        const std::vector<T>& chunks;
+    };
+
+    template <typename T>
+    MoreRecent<T> moreRecent(const std::vector<T>& chunks)
+    {
+        return MoreRecent<T>(chunks);
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+TileMap::TileMap() :
+m_texture       (NULL),
+m_size          (0, 0),
+m_tileSize      (0, 0),
+m_layerCount    (0),
+m_chunkCount    (0, 0),
+m_tiles         (),
+m_tileRects     (),
+m_animations    (),
+m_time          (0),
+m_animationStamp(0),
+m_chunks        (),
+m_residentChunks(),
+m_drawCount     (0)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void TileMap::create(const Vector2u& size, const Vector2u& tileSize, unsigned int layerCount)
+{
+    m_size = size;
+    m_tileSize = tileSize;
+    m_layerCount = layerCount;
+    m_chunkCount.x = (size.x + ChunkSize - 1) / ChunkSize;
+    m_chunkCount.y = (size.y + ChunkSize - 1) / ChunkSize;
+
+    std::vector<Uint32>(static_cast<std::size_t>(size.x) * size.y * layerCount, 0).swap(m_tiles);
+
+    // Empty chunks don't need to be built
+    Chunk empty;
+    empty.built = true;
+    empty.resident = false;
+    empty.animationStamp = m_animationStamp;
+    empty.lastDrawn = 0;
+    std::vector<Chunk>(static_cast<std::size_t>(m_chunkCount.x) * m_chunkCount.y * layerCount, empty).swap(m_chunks);
+    m_residentChunks.clear();
+}
+
+
+////////////////////////////////////////////////////////////
+void TileMap::setTexture(const Texture& texture)
+{
+    // The default layout of the tileset depends on the size of the texture
+    m_texture = &texture;
+    invalidate();
+}
+
+
+////////////////////////////////////////////////////////////
+const Texture* TileMap::getTexture() const
+{
+    return m_texture;
+}
+
+
+////////////////////////////////////////////////////////////
+const Vector2u& TileMap::getSize() const
+{
+    return m_size;
+}
+
+
+////////////////////////////////////////////////////////////
+const Vector2u& TileMap::getTileSize() const
+{
+    return m_tileSize;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int TileMap::getLayerCount() const
+{
+    return m_layerCount;
+}
+
+
+////////////////////////////////////////////////////////////
+void TileMap::setTile(unsigned int x, unsigned int y, Uint32 tile, unsigned int layer)
+{
+    if ((x >= m_size.x) || (y >= m_size.y) || (layer >= m_layerCount))
+        return;
+
+    Uint32& current = m_tiles[(static_cast<std::size_t>(layer) * m_size.y + y) * m_size.x + x];
+    if (current == tile)
+        return;
+
+    current = tile;
+    m_chunks[(static_cast<std::size_t>(layer) * m_chunkCount.y + y / ChunkSize) * m_chunkCount.x + x / ChunkSize].built = false;
+}
+
+
+////////////////////////////////////////////////////////////
+Uint32 TileMap::getTile(unsigned int x, unsigned int y, unsigned int layer) const
+{
+    if ((x >= m_size.x) || (y >= m_size.y) || (layer >= m_layerCount))
+        return 0;
+
+    return m_tiles[(static_cast<std::size_t>(layer) * m_size.y + y) * m_size.x + x];
+}
+
+
+////////////////////////////////////////////////////////////
+void TileMap::setTileRect(Uint32 tile, const IntRect& rect)
+{
+    if (tile == 0)
+        return;
+
+    if (m_tileRects.size() < tile)
+        m_tileRects.resize(tile);
+    m_tileRects[tile - 1] = rect;
+
+    invalidate();
+}
+
+
+////////////////////////////////////////////////////////////
+IntRect TileMap::getTileRect(Uint32 tile) const
+{
+    if (tile == 0)
+        return IntRect();
+
+    // Current frame of an animation
+    if (!m_animations.empty())
+    {
+        std::map<Uint32, Animation>::const_iterator it = m_animations.find(tile);
+        if (it != m_animations.end())
+            return it->second.frames[it->second.current];
+    }
+
+    // Explicit area
+    if ((tile <= m_tileRects.size()) && (m_tileRects[tile - 1] != IntRect()))
+        return m_tileRects[tile - 1];
+
+    // Default layout: the tiles of the texture, row by row
+    if (!m_texture || (m_tileSize.x == 0) || (m_tileSize.y == 0))
+        return IntRect();
+
+    unsigned int columns = m_texture->getSize().x / m_tileSize.x;
+    if (columns == 0)
+        return IntRect();
+
+    unsigned int index = tile - 1;
+    return IntRect(static_cast<int>((index % columns) * m_tileSize.x), static_cast<int>((index / columns) * m_tileSize.y),
+                   static_cast<int>(m_tileSize.x), static_cast<int>(m_tileSize.y));
+}
+
+
+////////////////////////////////////////////////////////////
+void TileMap::setAnimation(Uint32 tile, const std::vector<IntRect>& frames, Time frameDuration)
+{
+    if (tile == 0)
+        return;
+
+    if (frames.empty())
+    {
+        if (m_animations.erase(tile) > 0)
+            invalidate();
+        return;
+    }
+
+    Animation& animation = m_animations[tile];
+    animation.frames = frames;
+    animation.frameDuration = frameDuration.asMicroseconds();
+    animation.current = (animation.frameDuration > 0) ? static_cast<std::size_t>((m_time / animation.frameDuration) % frames.size()) : 0;
+
+    // The animated tiles of the chunks must be listed again
+    invalidate();
+}
+
+
+////////////////////////////////////////////////////////////
+void TileMap::update(Time elapsed)
+{
+    m_time += elapsed.asMicroseconds();
+
+    bool changed = false;
+    for (std::map<Uint32, Animation>::iterator it = m_animations.begin(); it != m_animations.end(); ++it)
+    {
+        Animation& animation = it->second;
+        if (animation.frameDuration <= 0)
+            continue;
+
+        std::size_t current = static_cast<std::size_t>((m_time / animation.frameDuration) % animation.frames.size());
+        if (current != animation.current)
+        {
+            animation.current = current;
+            changed = true;
+        }
+    }
+
+    // Only the texture coordinates of the animated tiles are updated, when their chunk is drawn
+    if (changed)
+        ++m_animationStamp;
+}
+
+
+////////////////////////////////////////////////////////////
+FloatRect TileMap::getLocalBounds() const
+{
+    return FloatRect(0.f, 0.f, static_cast<float>(m_size.x * m_tileSize.x), static_cast<float>(m_size.y * m_tileSize.y));
+}
+
+
+////////////////////////////////////////////////////////////
+FloatRect TileMap::getGlobalBounds() const
+{
+    return getTransform().transformRect(getLocalBounds());
+}
+
+
+////////////////////////////////////////////////////////////
+void TileMap::draw(RenderTarget& target, RenderStates states) const
+{
+    if (!m_texture || m_chunks.empty())
+        return;
+
+    states.transform *= getTransform();
+    states.texture = m_texture;
+    states.coordinateType = Texture::Pixels;
+
+    // Find the chunks that intersect the view; targets that have no
+    // size (like the recorder of sf::RenderQueue) get the whole map
+    unsigned int firstX = 0;
+    unsigned int lastX = m_chunkCount.x;
+    unsigned int firstY = 0;
+    unsigned int lastY = m_chunkCount.y;
+    Vector2u targetSize = target.getSize();
+    if ((targetSize.x > 0) && (targetSize.y > 0))
+    {
+        // The visible area is the view's rectangle (in normalized device coordinates)
+        // brought back to the local coordinate system of the map
+        Transform toLocal = states.transform.getInverse() * target.getView().getInverseTransform();
+        FloatRect area = toLocal.transformRect(FloatRect(-1.f, -1.f, 2.f, 2.f));
+
+        getChunkRange(area.left, area.left + area.width, static_cast<float>(m_tileSize.x * ChunkSize), m_chunkCount.x, firstX, lastX);
+        getChunkRange(area.top, area.top + area.height, static_cast<float>(m_tileSize.y * ChunkSize), m_chunkCount.y, firstY, lastY);
+    }
+
+    ++m_drawCount;
+
+    std::size_t visible = 0;
+    for (unsigned int layer = 0; layer < m_layerCount; ++layer)
+    {
+        for (unsigned int y = firstY; y < lastY; ++y)
+        {
+            for (unsigned int x = firstX; x < lastX; ++x)
+            {
+                std::size_t index = (static_cast<std::size_t>(layer) * m_chunkCount.y + y) * m_chunkCount.x + x;
+                Chunk& chunk = m_chunks[index];
+
+                // Build the chunk if its tiles changed, or just update its animated tiles
+                if (!chunk.built)
+                {
+                    build(chunk, layer, x, y);
+                    if (!chunk.resident && !chunk.vertices.empty())
+                    {
+                        chunk.resident = true;
+                        m_residentChunks.push_back(index);
+                    }
+                }
+                else if (chunk.animationStamp != m_animationStamp)
+                {
+                    animate(chunk);
+                }
+
+                chunk.lastDrawn = m_drawCount;
+
+                if (!chunk.vertices.empty())
+                {
+                    target.draw(&chunk.vertices[0], chunk.vertices.size(), Triangles, states);
+                    ++visible;
+                }
+            }
+        }
+    }
+
+    // Don't let the geometry of the chunks seen while scrolling accumulate
+    std::size_t keep = std::max(minResidentChunks, visible * 2);
+    if (m_residentChunks.size() > keep * 2)
+        releaseChunks(keep);
+}
+
+
+////////////////////////////////////////////////////////////
+void TileMap::invalidate()
+{
+    for (std::vector<Chunk>::iterator it = m_chunks.begin(); it != m_chunks.end(); ++it)
+        it->built = false;
+}
+
+
+////////////////////////////////////////////////////////////
+void TileMap::build(Chunk& chunk, unsigned int layer, unsigned int chunkX, unsigned int chunkY) const
+{
+    unsigned int left = chunkX * ChunkSize;
+    unsigned int top = chunkY * ChunkSize;
+    unsigned int right = std::min(left + ChunkSize, m_size.x);
+    unsigned int bottom = std::min(top + ChunkSize, m_size.y);
+    float width = static_cast<float>(m_tileSize.x);
+    float height = static_cast<float>(m_tileSize.y);
+
+    // Keep the memory, a rebuilt chunk usually has about as many tiles as before
+    chunk.vertices.clear();
+    chunk.animatedTiles.clear();
+
+    for (unsigned int y = top; y < bottom; ++y)
+    {
+        const Uint32* row = &m_tiles[(static_cast<std::size_t>(layer) * m_size.y + y) * m_size.x];
+        for (unsigned int x = left; x < right; ++x)
+        {
+            Uint32 tile = row[x];
+            if (tile == 0)
+                continue;
+
+            IntRect rect = getTileRect(tile);
+            if ((rect.width == 0) || (rect.height == 0))
+                continue;
+
+            if (!m_animations.empty() && (m_animations.find(tile) != m_animations.end()))
+                chunk.animatedTiles.push_back(std::make_pair(chunk.vertices.size(), tile));
+
+            // Two triangles rather than a quad, so that it works with OpenGL ES
+            float px = static_cast<float>(x) * width;
+            float py = static_cast<float>(y) * height;
+            std::size_t first = chunk.vertices.size();
+            chunk.vertices.resize(first + 6);
+
+            Vertex* vertices = &chunk.vertices[first];
+            vertices[0].position = Vector2f(px, py);
+            vertices[1].position = Vector2f(px + width, py);
+            vertices[2].position = Vector2f(px, py + height);
+            vertices[3].position = Vector2f(px, py + height);
+            vertices[4].position = Vector2f(px + width, py);
+            vertices[5].position = Vector2f(px + width, py + height);
+            setTexCoords(vertices, rect);
+        }
+    }
+
+    chunk.built = true;
+    chunk.animationStamp = m_animationStamp;
+}
+
+
+////////////////////////////////////////////////////////////
+void TileMap::animate(Chunk& chunk) const
+{
+    for (std::size_t i = 0; i < chunk.animatedTiles.size(); ++i)
+        setTexCoords(&chunk.vertices[chunk.animatedTiles[i].first], getTileRect(chunk.animatedTiles[i].second));
+
+    chunk.animationStamp = m_animationStamp;
+}
+
+
+////////////////////////////////////////////////////////////
+void TileMap::releaseChunks(std::size_t keep) const
+{
+    std::nth_element(m_residentChunks.begin(), m_residentChunks.begin() + keep, m_residentChunks.end(), moreRecent(m_chunks));
+
+    for (std::size_t i = keep; i < m_residentChunks.size(); ++i)
+    {
+        Chunk& chunk = m_chunks[m_residentChunks[i]];
+        std::vector<Vertex>().swap(chunk.vertices);
+        std::vector<std::pair<std::size_t, Uint32> >().swap(chunk.animatedTiles);
+        chunk.built = false;
+        chunk.resident = false;
+    }
+
+    m_residentChunks.resize(keep);
+}
+
+} // namespace sf
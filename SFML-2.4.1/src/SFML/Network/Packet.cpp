@@ -28,6 +28,7 @@
 #include <SFML/Network/Packet.hpp>
 #include <SFML/Network/SocketImpl.hpp>
 #include <SFML/System/String.hpp>
+#include <algorithm>
 #include <cstring>
 #include <cwchar>
 
@@ -72,6 +73,16 @@ void Packet::clear()
 }
 
 
+////////////////////////////////////////////////////////////
+void Packet::swap(Packet& right)
+{
+    std::swap(m_data,    right.m_data);
+    std::swap(m_readPos, right.m_readPos);
+    std::swap(m_sendPos, right.m_sendPos);
+    std::swap(m_isValid, right.m_isValid);
+}
+
+
 ////////////////////////////////////////////////////////////
 const void* Packet::getData() const
 {
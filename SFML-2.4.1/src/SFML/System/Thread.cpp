@@ -77,6 +77,13 @@ void Thread::terminate()
 }
 
 
+////////////////////////////////////////////////////////////
+unsigned int Thread::getHardwareConcurrency()
+{
+    return priv::ThreadImpl::getHardwareConcurrency();
+}
+
+
 ////////////////////////////////////////////////////////////
 void Thread::run()
 {
@@ -0,0 +1,96 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2016 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/Unix/SemaphoreImpl.hpp>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+SemaphoreImpl::SemaphoreImpl(unsigned int count) :
+m_count(count)
+{
+    // Unnamed POSIX semaphores are not available on all the
+    // supported systems (OS X), so it's built on a condition
+    pthread_mutex_init(&m_mutex, NULL);
+    pthread_cond_init(&m_condition, NULL);
+}
+
+
+////////////////////////////////////////////////////////////
+SemaphoreImpl::~SemaphoreImpl()
+{
+    pthread_cond_destroy(&m_condition);
+    pthread_mutex_destroy(&m_mutex);
+}
+
+
+////////////////////////////////////////////////////////////
+void SemaphoreImpl::wait()
+{
+    pthread_mutex_lock(&m_mutex);
+
+    while (m_count == 0)
+        pthread_cond_wait(&m_condition, &m_mutex);
+    m_count--;
+
+    pthread_mutex_unlock(&m_mutex);
+}
+
+
+////////////////////////////////////////////////////////////
+bool SemaphoreImpl::tryWait()
+{
+    pthread_mutex_lock(&m_mutex);
+
+    bool available = (m_count > 0);
+    if (available)
+        m_count--;
+
+    pthread_mutex_unlock(&m_mutex);
+
+    return available;
+}
+
+
+////////////////////////////////////////////////////////////
+void SemaphoreImpl::post()
+{
+    pthread_mutex_lock(&m_mutex);
+    m_count++;
+    pthread_mutex_unlock(&m_mutex);
+
+    pthread_cond_signal(&m_condition);
+}
+
+} // namespace priv
+
+} // namespace sf
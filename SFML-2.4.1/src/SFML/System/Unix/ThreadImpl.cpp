@@ -29,6 +29,7 @@
 #include <SFML/System/Thread.hpp>
 #include <iostream>
 #include <cassert>
+#include <unistd.h>
 
 
 namespace sf
@@ -72,6 +73,15 @@ void ThreadImpl::terminate()
 }
 
 
+////////////////////////////////////////////////////////////
+unsigned int ThreadImpl::getHardwareConcurrency()
+{
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+
+    return count > 0 ? static_cast<unsigned int>(count) : 1;
+}
+
+
 ////////////////////////////////////////////////////////////
 void* ThreadImpl::entryPoint(void* userData)
 {
@@ -66,6 +66,14 @@ public:
     ////////////////////////////////////////////////////////////
     void terminate();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of threads that can run concurrently
+    ///
+    /// \return Number of logical processors (at least 1)
+    ///
+    ////////////////////////////////////////////////////////////
+    static unsigned int getHardwareConcurrency();
+
 private:
 
     ////////////////////////////////////////////////////////////
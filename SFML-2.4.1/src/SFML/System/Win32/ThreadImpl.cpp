@@ -73,6 +73,16 @@ void ThreadImpl::terminate()
 }
 
 
+////////////////////////////////////////////////////////////
+unsigned int ThreadImpl::getHardwareConcurrency()
+{
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+
+    return info.dwNumberOfProcessors > 0 ? static_cast<unsigned int>(info.dwNumberOfProcessors) : 1;
+}
+
+
 ////////////////////////////////////////////////////////////
 unsigned int __stdcall ThreadImpl::entryPoint(void* userData)
 {
@@ -29,6 +29,7 @@
 #include <SFML/System/ThreadLocalPtr.hpp>
 #include <SFML/System/Mutex.hpp>
 #include <SFML/System/Lock.hpp>
+#include <SFML/System/Semaphore.hpp>
 #include <SFML/System/Err.hpp>
 #include <SFML/OpenGL.hpp>
 #include <algorithm>
@@ -140,12 +141,39 @@ namespace
     // The hidden, inactive context that will be shared with all other contexts
     ContextType* sharedContext = NULL;
 
-    // This per-thread variable is set to point to the shared context
-    // if we had to acquire it when a TransientContextLock was required
-    sf::ThreadLocalPtr<sf::priv::GlContext> currentSharedContext(NULL);
+    // Inactive contexts shared with all the others, lent to the threads that
+    // need a context for a short time (TransientContextLock), oldest first
+    std::vector<sf::priv::GlContext*> transientContexts;
+
+    // Number of transient contexts, including the ones in use
+    std::size_t transientContextCount = 0;
+
+    // Maximum number of transient contexts: past that the ones of other threads
+    // are reused, and threads wait for one to be released if they are all in use
+    const std::size_t maxTransientContexts = 8;
+
+    // Number of transient contexts that can still be lent
+    sf::Semaphore transientContextSlots(static_cast<unsigned int>(maxTransientContexts));
+
+    // This per-thread variable holds the transient context that the thread used last
+    sf::ThreadLocalPtr<sf::priv::GlContext> threadTransientContext(NULL);
 
     // Supported OpenGL extensions
     std::vector<std::string> extensions;
+
+    // Functions called when a context is destroyed, to release the resources that it doesn't share
+    typedef std::set<std::pair<sf::ContextDestroyCallback, void*> > ContextDestroyCallbacks;
+    ContextDestroyCallbacks contextDestroyCallbacks;
+
+    // Unique identifier, used for identifying contexts when managing unshareable OpenGL resources
+    sf::Uint64 getUniqueId()
+    {
+        sf::Lock lock(mutex);
+
+        static sf::Uint64 id = 1; // start at 1, zero is "no context"
+
+        return id++;
+    }
 }
 
 
@@ -224,6 +252,12 @@ void GlContext::globalCleanup()
     if (!sharedContext)
         return;
 
+    // Destroy the transient contexts
+    for (std::vector<GlContext*>::iterator it = transientContexts.begin(); it != transientContexts.end(); ++it)
+        delete *it;
+    transientContextCount -= transientContexts.size();
+    transientContexts.clear();
+
     // Destroy the shared context
     delete sharedContext;
     sharedContext = NULL;
@@ -231,30 +265,75 @@ void GlContext::globalCleanup()
 
 
 ////////////////////////////////////////////////////////////
-void GlContext::acquireTransientContext()
+GlContext* GlContext::acquireTransientContext()
 {
     // If a capable context is already active on this thread
-    // there is no need to use the shared context for the operation
+    // there is no need to use a transient context for the operation
     if (currentContext)
+        return NULL;
+
+    // Each thread gets its own context, so that threads that load
+    // resources at the same time don't have to wait for each other,
+    // unless all the contexts are in use
+    transientContextSlots.wait();
+
+    GlContext* context = NULL;
     {
-        currentSharedContext = NULL;
-        return;
+        Lock lock(mutex);
+
+        // Prefer the context that the thread used last: its previous commands are
+        // in that context, and a fence only covers the commands of its context
+        std::vector<GlContext*>::iterator it = std::find(transientContexts.begin(), transientContexts.end(), threadTransientContext);
+
+        // Reuse the context of another thread only when there are too many of them,
+        // taking the one released the longest ago (its thread may have exited)
+        if ((it == transientContexts.end()) && (transientContextCount >= maxTransientContexts) && !transientContexts.empty())
+            it = transientContexts.begin();
+
+        if (it != transientContexts.end())
+        {
+            context = *it;
+            transientContexts.erase(it);
+        }
+        else
+        {
+            transientContextCount++;
+        }
     }
 
-    mutex.lock();
-    currentSharedContext = sharedContext;
-    sharedContext->setActive(true);
+    if (context)
+        context->setActive(true);
+    else
+        context = create();
+
+    threadTransientContext = context;
+
+    return context;
 }
 
 
 ////////////////////////////////////////////////////////////
-void GlContext::releaseTransientContext()
+void GlContext::releaseTransientContext(GlContext* context)
 {
-    if (!currentSharedContext)
+    if (!context)
         return;
 
-    sharedContext->setActive(false);
-    mutex.unlock();
+    context->setActive(false);
+
+    Lock lock(mutex);
+
+    // The shared context may have been destroyed while the context was in use
+    if (sharedContext)
+    {
+        transientContexts.push_back(context);
+    }
+    else
+    {
+        delete context;
+        transientContextCount--;
+    }
+
+    transientContextSlots.post();
 }
 
 
@@ -368,6 +447,54 @@ GlFunctionPointer GlContext::getFunction(const char* name)
 }
 
 
+////////////////////////////////////////////////////////////
+Uint64 GlContext::getActiveContextId()
+{
+    return currentContext ? currentContext->m_id : 0;
+}
+
+
+////////////////////////////////////////////////////////////
+void GlContext::registerContextDestroyCallback(ContextDestroyCallback callback, void* arg)
+{
+    Lock lock(mutex);
+
+    contextDestroyCallbacks.insert(std::make_pair(callback, arg));
+}
+
+
+////////////////////////////////////////////////////////////
+void GlContext::cleanupUnsharedResources()
+{
+    ContextDestroyCallbacks callbacks;
+    {
+        Lock lock(mutex);
+        callbacks = contextDestroyCallbacks;
+    }
+
+    if (callbacks.empty())
+        return;
+
+    // Save the current context so we can restore it later
+    GlContext* contextToRestore = currentContext;
+
+    // If this context is already active there is no need to save it
+    if (contextToRestore == this)
+        contextToRestore = NULL;
+
+    // Make this context active so resources can be freed (if it can't be, it has no resources)
+    if (setActive(true))
+    {
+        for (ContextDestroyCallbacks::const_iterator it = callbacks.begin(); it != callbacks.end(); ++it)
+            it->first(it->second);
+    }
+
+    // Make the originally active context active again
+    if (contextToRestore)
+        contextToRestore->setActive(true);
+}
+
+
 ////////////////////////////////////////////////////////////
 GlContext::~GlContext()
 {
@@ -441,7 +568,8 @@ bool GlContext::setActive(bool active)
 
 
 ////////////////////////////////////////////////////////////
-GlContext::GlContext()
+GlContext::GlContext() :
+m_id(getUniqueId())
 {
     // Nothing to do
 }
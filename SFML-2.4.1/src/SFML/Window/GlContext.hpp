@@ -75,14 +75,25 @@ public:
     ////////////////////////////////////////////////////////////
     /// \brief Acquires a context for short-term use on the current thread
     ///
+    /// If no context is active on the current thread, a context
+    /// shared with all the others is borrowed from a pool and
+    /// activated. Each thread gets its own, so that threads
+    /// that load resources don't wait for each other. At most
+    /// 8 such contexts exist: when they are all in use, this
+    /// function waits until another thread releases one.
+    ///
+    /// \return The borrowed context, or NULL if a context was already active
+    ///
     ////////////////////////////////////////////////////////////
-    static void acquireTransientContext();
+    static GlContext* acquireTransientContext();
 
     ////////////////////////////////////////////////////////////
     /// \brief Releases a context after short-term use on the current thread
     ///
+    /// \param context Context returned by acquireTransientContext (can be NULL)
+    ///
     ////////////////////////////////////////////////////////////
-    static void releaseTransientContext();
+    static void releaseTransientContext(GlContext* context);
 
     ////////////////////////////////////////////////////////////
     /// \brief Create a new context, not associated to a window
@@ -146,6 +157,23 @@ public:
     ////////////////////////////////////////////////////////////
     static GlFunctionPointer getFunction(const char* name);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the identifier of the context active on the current thread
+    ///
+    /// \return Identifier of the active context, or 0 if none is active
+    ///
+    ////////////////////////////////////////////////////////////
+    static Uint64 getActiveContextId();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Register a function to be called when a context is destroyed
+    ///
+    /// \param callback Function to be called when a context is destroyed
+    /// \param arg      Argument to pass when calling the function
+    ///
+    ////////////////////////////////////////////////////////////
+    static void registerContextDestroyCallback(ContextDestroyCallback callback, void* arg);
+
     ////////////////////////////////////////////////////////////
     /// \brief Destructor
     ///
@@ -220,6 +248,17 @@ protected:
     ////////////////////////////////////////////////////////////
     virtual bool makeCurrent(bool current) = 0;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Notify unshared resources of context destruction
+    ///
+    /// Calls the functions registered with
+    /// registerContextDestroyCallback, with this context active.
+    /// Derived classes must call it at the beginning of their
+    /// destructor, while the context can still be activated.
+    ///
+    ////////////////////////////////////////////////////////////
+    void cleanupUnsharedResources();
+
     ////////////////////////////////////////////////////////////
     /// \brief Evaluate a pixel format configuration
     ///
@@ -249,6 +288,11 @@ protected:
 
 private:
 
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    const Uint64 m_id; ///< Unique number that identifies the context
+
     ////////////////////////////////////////////////////////////
     /// \brief Perform various initializations after the context construction
     /// \param requestedSettings Requested settings during context creation
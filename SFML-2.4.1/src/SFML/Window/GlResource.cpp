@@ -79,9 +79,17 @@ void GlResource::ensureGlContext()
 }
 
 
+////////////////////////////////////////////////////////////
+void GlResource::registerContextDestroyCallback(ContextDestroyCallback callback, void* arg)
+{
+    priv::GlContext::registerContextDestroyCallback(callback, arg);
+}
+
+
 ////////////////////////////////////////////////////////////
 GlResource::TransientContextLock::TransientContextLock() :
-m_context(0)
+m_context         (0),
+m_transientContext(0)
 {
     Lock lock(mutex);
 
@@ -91,7 +99,7 @@ m_context(0)
         return;
     }
 
-    priv::GlContext::acquireTransientContext();
+    m_transientContext = priv::GlContext::acquireTransientContext();
 }
 
 
@@ -104,7 +112,7 @@ GlResource::TransientContextLock::~TransientContextLock()
         return;
     }
 
-    priv::GlContext::releaseTransientContext();
+    priv::GlContext::releaseTransientContext(m_transientContext);
 }
 
 } // namespace sf
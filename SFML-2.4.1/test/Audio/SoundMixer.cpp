@@ -0,0 +1,214 @@
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio.hpp>
+#include <TestUtilities.hpp>
+#include <cstdlib>
+#include <vector>
+
+
+namespace
+{
+    const unsigned int sampleRate = 44100;
+
+    // Create a mono buffer whose sample i is first + i * increment
+    void createRamp(sf::SoundBuffer& buffer, std::size_t count, int first, int increment, unsigned int rate = sampleRate)
+    {
+        std::vector<sf::Int16> samples(count);
+        for (std::size_t i = 0; i < count; ++i)
+            samples[i] = static_cast<sf::Int16>(first + static_cast<int>(i) * increment);
+        buffer.loadFromSamples(&samples[0], samples.size(), 1, rate);
+    }
+
+    // Check that the frames [first, last) of a stereo mix are (left, right)
+    bool checkFrames(const std::vector<sf::Int16>& mix, std::size_t first, std::size_t last, int left, int right)
+    {
+        for (std::size_t i = first; i < last; ++i)
+        {
+            if ((mix[i * 2] != left) || (mix[i * 2 + 1] != right))
+            {
+                std::cerr << "  frame " << i << " is (" << mix[i * 2] << ", " << mix[i * 2 + 1] << ")"
+                          << ", expected (" << left << ", " << right << ")" << std::endl;
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    // Render frames offline
+    std::vector<sf::Int16> render(sf::SoundMixer& mixer, std::size_t frameCount)
+    {
+        std::vector<sf::Int16> mix(frameCount * 2);
+        mixer.mix(&mix[0], frameCount);
+        return mix;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+/// Entry point of application
+///
+/// \return Application exit code
+///
+////////////////////////////////////////////////////////////
+int main()
+{
+    // The lengths are not multiples of 4, so that the SIMD kernels also process remainders
+    sf::SoundBuffer constant;
+    createRamp(constant, 1003, 1000, 0);
+
+    // Volume and panning
+    {
+        sf::SoundMixer mixer(sampleRate);
+        mixer.playVoice(constant);
+        std::vector<sf::Int16> mix = render(mixer, 1010);
+        CHECK(checkFrames(mix, 0, 1003, 1000, 1000));
+        CHECK(checkFrames(mix, 1003, 1010, 0, 0));
+        CHECK(mixer.getVoiceCount() == 0);
+
+        mixer.playVoice(constant, 50.f, 1.f, -1.f);
+        mixer.playVoice(constant, 25.f, 1.f, 0.5f);
+        mix = render(mixer, 999);
+        CHECK(checkFrames(mix, 0, 999, 625, 250));
+        CHECK(mixer.getVoiceCount() == 2);
+
+        mixer.stopAllVoices();
+        mix = render(mixer, 10);
+        CHECK(checkFrames(mix, 0, 10, 0, 0));
+    }
+
+    // Stereo voices keep their channels
+    {
+        std::vector<sf::Int16> samples;
+        for (int i = 0; i < 501; ++i)
+        {
+            samples.push_back(static_cast<sf::Int16>(-2000));
+            samples.push_back(static_cast<sf::Int16>(3000));
+        }
+
+        sf::SoundBuffer stereo;
+        stereo.loadFromSamples(&samples[0], samples.size(), 2, sampleRate);
+
+        sf::SoundMixer mixer(sampleRate);
+        mixer.playVoice(stereo, 50.f);
+        std::vector<sf::Int16> mix = render(mixer, 600);
+        CHECK(checkFrames(mix, 0, 501, -1000, 1500));
+        CHECK(checkFrames(mix, 501, 600, 0, 0));
+    }
+
+    // Resampling: linear interpolation between the source frames
+    {
+        sf::SoundBuffer ramp;
+        createRamp(ramp, 1001, 0, 10);
+
+        sf::SoundMixer mixer(sampleRate);
+        mixer.playVoice(ramp, 100.f, 2.f);
+        std::vector<sf::Int16> mix = render(mixer, 500);
+        for (std::size_t i = 0; i < 500; ++i)
+            CHECK(checkFrames(mix, i, i + 1, static_cast<int>(i) * 20, static_cast<int>(i) * 20));
+
+        mixer.stopAllVoices();
+        mixer.playVoice(ramp, 100.f, 0.5f);
+        mix = render(mixer, 1001);
+        for (std::size_t i = 0; i < 1001; ++i)
+            CHECK(checkFrames(mix, i, i + 1, static_cast<int>(i) * 5, static_cast<int>(i) * 5));
+
+        // A buffer at half the output rate plays at half the speed
+        sf::SoundBuffer slow;
+        createRamp(slow, 1001, 0, 10, sampleRate / 2);
+        mixer.stopAllVoices();
+        mixer.playVoice(slow);
+        mix = render(mixer, 1001);
+        for (std::size_t i = 0; i < 1001; ++i)
+            CHECK(checkFrames(mix, i, i + 1, static_cast<int>(i) * 5, static_cast<int>(i) * 5));
+    }
+
+    // Looping voices wrap around
+    {
+        sf::SoundBuffer ramp;
+        createRamp(ramp, 7, 100, 100);
+
+        sf::SoundMixer mixer(sampleRate);
+        sf::SoundMixer::VoiceId voice = mixer.playVoice(ramp, 100.f, 1.f, 0.f, 0, true);
+        std::vector<sf::Int16> mix = render(mixer, 71);
+        for (std::size_t i = 0; i < 71; ++i)
+            CHECK(checkFrames(mix, i, i + 1, 100 + static_cast<int>(i % 7) * 100, 100 + static_cast<int>(i % 7) * 100));
+
+        CHECK(mixer.isVoicePlaying(voice));
+        mixer.stopVoice(voice);
+        CHECK(!mixer.isVoicePlaying(voice));
+    }
+
+    // The mix saturates instead of wrapping around
+    {
+        sf::SoundBuffer loud;
+        createRamp(loud, 5, 30000, 0);
+
+        sf::SoundMixer mixer(sampleRate);
+        mixer.playVoice(loud);
+        mixer.playVoice(loud);
+        mixer.playVoice(loud, 100.f, 1.f, 1.f);
+        std::vector<sf::Int16> mix = render(mixer, 5);
+        CHECK(checkFrames(mix, 0, 5, 32767, 32767));
+
+        sf::SoundBuffer quiet;
+        createRamp(quiet, 5, -30000, 0);
+        mixer.playVoice(quiet);
+        mixer.playVoice(quiet);
+        mix = render(mixer, 5);
+        CHECK(checkFrames(mix, 0, 5, -32768, -32768));
+    }
+
+    // Culling: the least important voice makes room for a new one
+    {
+        sf::SoundMixer mixer(sampleRate, 2);
+        sf::SoundMixer::VoiceId low = mixer.playVoice(constant, 100.f, 1.f, 0.f, 0);
+        sf::SoundMixer::VoiceId high = mixer.playVoice(constant, 10.f, 1.f, 0.f, 1);
+        CHECK(mixer.getVoiceCount() == 2);
+
+        // Lower priority than all the voices: the new voice is culled
+        CHECK(mixer.playVoice(constant, 100.f, 1.f, 0.f, -1) == sf::SoundMixer::InvalidVoice);
+        CHECK(mixer.getCulledVoiceCount() == 1);
+
+        // Same priority and quieter: the new voice is culled
+        CHECK(mixer.playVoice(constant, 50.f, 1.f, 0.f, 0) == sf::SoundMixer::InvalidVoice);
+        CHECK(mixer.isVoicePlaying(low));
+        CHECK(mixer.getCulledVoiceCount() == 2);
+
+        // Higher priority: the lowest priority voice is replaced, even if it is louder
+        sf::SoundMixer::VoiceId replacement = mixer.playVoice(constant, 20.f, 1.f, 0.f, 1);
+        CHECK(replacement != sf::SoundMixer::InvalidVoice);
+        CHECK(!mixer.isVoicePlaying(low));
+        CHECK(mixer.isVoicePlaying(high));
+        CHECK(mixer.getCulledVoiceCount() == 3);
+
+        // Same priority and louder: the quietest voice is replaced
+        sf::SoundMixer::VoiceId loud = mixer.playVoice(constant, 90.f, 1.f, 0.f, 1);
+        CHECK(loud != sf::SoundMixer::InvalidVoice);
+        CHECK(!mixer.isVoicePlaying(high));
+        CHECK(mixer.isVoicePlaying(replacement));
+        CHECK(mixer.getVoiceCount() == 2);
+        CHECK(mixer.getCulledVoiceCount() == 4);
+
+        std::vector<sf::Int16> mix = render(mixer, 1003);
+        CHECK(checkFrames(mix, 0, 1003, 1100, 1100));
+    }
+
+    // Rendering to a sound buffer
+    {
+        sf::SoundMixer mixer(sampleRate);
+        mixer.playVoice(constant, 100.f, 1.f, 0.f, 0, true);
+
+        sf::SoundBuffer rendered;
+        CHECK(mixer.renderToBuffer(rendered, sf::milliseconds(100)));
+        CHECK(rendered.getChannelCount() == 2);
+        CHECK(rendered.getSampleRate() == sampleRate);
+        CHECK(rendered.getSampleCount() == sampleRate / 10 * 2);
+
+        std::vector<sf::Int16> mix(rendered.getSamples(), rendered.getSamples() + rendered.getSampleCount());
+        CHECK(checkFrames(mix, 0, sampleRate / 10, 1000, 1000));
+    }
+
+    return getExitCode();
+}
@@ -0,0 +1,111 @@
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics.hpp>
+#include <cstdio>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+
+namespace
+{
+    const std::size_t fileCount = 1000;
+    const unsigned int imageSize = 128;
+
+    std::string getFilename(std::size_t index)
+    {
+        std::ostringstream stream;
+        stream << "image-benchmark-" << std::setw(4) << std::setfill('0') << index << ".png";
+        return stream.str();
+    }
+
+    // Write a sprite-like PNG: a gradient with some noise, so that it doesn't compress to nothing
+    bool createFile(const std::string& filename, unsigned int& seed)
+    {
+        sf::Image image;
+        image.create(imageSize, imageSize);
+        for (unsigned int y = 0; y < imageSize; ++y)
+        {
+            for (unsigned int x = 0; x < imageSize; ++x)
+            {
+                seed = seed * 1103515245 + 12345;
+                sf::Uint8 noise = static_cast<sf::Uint8>((seed >> 16) & 0x1F);
+                image.setPixel(x, y, sf::Color(static_cast<sf::Uint8>(x * 2 + noise),
+                                               static_cast<sf::Uint8>(y * 2 + noise),
+                                               static_cast<sf::Uint8>(x + y),
+                                               (x + y) % 7 ? 255 : 0));
+            }
+        }
+
+        return image.saveToFile(filename);
+    }
+
+    void printResult(const std::string& name, std::size_t loaded, const sf::Time& elapsed)
+    {
+        double seconds = elapsed.asSeconds();
+
+        std::cout << std::left << std::setw(28) << name << std::right
+                  << std::setw(8) << loaded
+                  << std::setw(12) << std::fixed << std::setprecision(3) << seconds
+                  << std::setw(12) << std::setprecision(0) << loaded / seconds << std::endl;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+/// Entry point of application
+///
+/// \return Application exit code
+///
+////////////////////////////////////////////////////////////
+int main()
+{
+    // The PNG files are written in the working directory, and removed at the end
+    std::vector<std::string> filenames;
+    unsigned int seed = 42;
+    for (std::size_t i = 0; i < fileCount; ++i)
+    {
+        filenames.push_back(getFilename(i));
+        if (!createFile(filenames.back(), seed))
+            return EXIT_FAILURE;
+    }
+
+    std::cout << fileCount << " PNG files of " << imageSize << "x" << imageSize << " pixels" << std::endl;
+    std::cout << "mode                          images    time (s)    images/s" << std::endl;
+
+    // The reference: loadFromFile in a loop
+    std::vector<sf::Image> images(fileCount);
+    sf::Clock clock;
+    std::size_t loaded = 0;
+    for (std::size_t i = 0; i < fileCount; ++i)
+    {
+        if (images[i].loadFromFile(filenames[i]))
+            loaded++;
+    }
+    printResult("loadFromFile loop", loaded, clock.getElapsedTime());
+
+    // loadFromFiles, with an increasing number of threads
+    const unsigned int threadCounts[] = {1, 2, 4, 8, 0};
+    for (std::size_t t = 0; t < sizeof(threadCounts) / sizeof(*threadCounts); ++t)
+    {
+        std::ostringstream name;
+        if (threadCounts[t] > 0)
+            name << "loadFromFiles, " << threadCounts[t] << " thread(s)";
+        else
+            name << "loadFromFiles, all cores";
+
+        images.clear();
+        clock.restart();
+        loaded = sf::Image::loadFromFiles(filenames, images, threadCounts[t]);
+        printResult(name.str(), loaded, clock.getElapsedTime());
+    }
+
+    for (std::size_t i = 0; i < fileCount; ++i)
+        std::remove(filenames[i].c_str());
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,156 @@
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+
+namespace
+{
+    const unsigned int width = 6000;
+    const unsigned int height = 4000;
+    const std::size_t chunkSize = 64 * 1024;
+
+    // A panorama-like picture: smooth gradients with some noise, encoded in memory
+    bool createFile(std::vector<sf::Uint8>& file, const std::string& format)
+    {
+        std::vector<sf::Uint8> pixels(width * height * 4);
+        unsigned int seed = 1;
+        for (unsigned int y = 0; y < height; ++y)
+        {
+            for (unsigned int x = 0; x < width; ++x)
+            {
+                seed = seed * 1103515245 + 12345;
+                sf::Uint8* pixel = &pixels[(y * width + x) * 4];
+                pixel[0] = static_cast<sf::Uint8>(x / 24 + ((seed >> 16) & 7));
+                pixel[1] = static_cast<sf::Uint8>(y / 16 + ((seed >> 20) & 7));
+                pixel[2] = static_cast<sf::Uint8>((x + y) / 40);
+                pixel[3] = 255;
+            }
+        }
+
+        sf::ImageView view(&pixels[0], width, height);
+        return view.saveToMemory(file, format, sf::Image::SaveSettings(1, sf::Image::SaveSettings::PngFilterNone));
+    }
+
+    bool readFile(const std::string& filename, std::vector<sf::Uint8>& file)
+    {
+        std::ifstream stream(filename.c_str(), std::ios::binary);
+        if (!stream)
+            return false;
+
+        file.assign(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+        return !file.empty();
+    }
+
+    void printResult(const std::string& name, double firstBand, double complete)
+    {
+        std::cout << std::left << std::setw(32) << name << std::right << std::fixed << std::setprecision(1);
+        if (firstBand >= 0.0)
+            std::cout << std::setw(14) << firstBand;
+        else
+            std::cout << std::setw(14) << "-";
+        std::cout << std::setw(14) << complete << std::endl;
+    }
+
+    // Feed the file in chunks, as if it was arriving from the network or a slow disk
+    void measureIncremental(const std::string& name, const std::vector<sf::Uint8>& file, const sf::IntRect& region)
+    {
+        sf::ImageDecoder decoder;
+        decoder.setRegion(region);
+
+        sf::Clock clock;
+        double firstBand = -1.0;
+        std::size_t offset = 0;
+        sf::ImageDecoder::Status status = sf::ImageDecoder::NeedMoreData;
+        while (status == sf::ImageDecoder::NeedMoreData)
+        {
+            if (offset < file.size())
+            {
+                std::size_t size = std::min(chunkSize, file.size() - offset);
+                decoder.feed(&file[offset], size);
+                offset += size;
+            }
+            else
+            {
+                decoder.close();
+            }
+
+            status = decoder.decode();
+
+            sf::ImageView band;
+            unsigned int top;
+            if (decoder.getNextBand(band, top) && (firstBand < 0.0))
+                firstBand = clock.getElapsedTime().asSeconds() * 1000.0;
+        }
+
+        if (status == sf::ImageDecoder::Error)
+            std::cout << name << ": decoding failed" << std::endl;
+        else
+            printResult(name, firstBand, clock.getElapsedTime().asSeconds() * 1000.0);
+    }
+
+    void measure(const std::string& format, const std::vector<sf::Uint8>& file)
+    {
+        std::cout << format << ", " << file.size() / 1000 << " KB, fed in chunks of " << chunkSize / 1024 << " KB" << std::endl;
+        std::cout << "mode                            first band (ms) complete (ms)" << std::endl;
+
+        sf::Image image;
+        sf::Clock clock;
+        image.loadFromMemory(&file[0], file.size());
+        printResult("whole file, loadFromMemory", -1.0, clock.getElapsedTime().asSeconds() * 1000.0);
+
+        measureIncremental("incremental", file, sf::IntRect());
+        measureIncremental("incremental, 640x360 region", file, sf::IntRect(image.getSize().x / 2, 200, 640, 360));
+        std::cout << std::endl;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+/// Entry point of application
+///
+/// Usage: benchmark-image-decoder [image files...]
+/// (default: a generated 6000x4000 JPEG and PNG)
+///
+/// \return Application exit code
+///
+////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+    std::vector<sf::Uint8> file;
+    if (argc > 1)
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            if (!readFile(argv[i], file))
+            {
+                std::cerr << "Failed to read " << argv[i] << std::endl;
+                return EXIT_FAILURE;
+            }
+
+            measure(argv[i], file);
+        }
+
+        return EXIT_SUCCESS;
+    }
+
+    // JPEG is decoded incrementally, the other formats in one go once the input is complete
+    const char* formats[] = {"jpg", "png"};
+    for (std::size_t i = 0; i < sizeof(formats) / sizeof(*formats); ++i)
+    {
+        if (!createFile(file, formats[i]))
+            return EXIT_FAILURE;
+
+        measure(formats[i], file);
+    }
+
+    return EXIT_SUCCESS;
+}
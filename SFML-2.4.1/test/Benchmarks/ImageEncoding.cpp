@@ -0,0 +1,151 @@
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics.hpp>
+#include <cstdio>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+
+namespace
+{
+    const unsigned int width = 1280;
+    const unsigned int height = 720;
+    const std::size_t queueFrameCount = 64;
+
+    // A frame that looks like a game screenshot: flat areas, gradients and some noise
+    void createFrame(sf::Image& image)
+    {
+        image.create(width, height);
+
+        unsigned int seed = 1;
+        for (unsigned int y = 0; y < height; ++y)
+        {
+            for (unsigned int x = 0; x < width; ++x)
+            {
+                seed = seed * 1103515245 + 12345;
+                sf::Uint8 noise = static_cast<sf::Uint8>((seed >> 16) & 0x0F);
+                if ((x / 160 + y / 120) % 3 == 0)
+                    image.setPixel(x, y, sf::Color(40, 90, 160));
+                else
+                    image.setPixel(x, y, sf::Color(static_cast<sf::Uint8>(x / 5 + noise), static_cast<sf::Uint8>(y / 3 + noise), static_cast<sf::Uint8>((x + y) / 8)));
+            }
+        }
+    }
+
+    // Encode the frame in memory for at least half a second
+    void measure(const std::string& name, const sf::Image& image, const std::string& format, const sf::Image::SaveSettings& settings)
+    {
+        std::vector<sf::Uint8> output;
+        std::size_t frames = 0;
+        sf::Clock clock;
+        do
+        {
+            image.saveToMemory(output, format, settings);
+            ++frames;
+        }
+        while (clock.getElapsedTime() < sf::seconds(0.5f));
+
+        double seconds = clock.getElapsedTime().asSeconds();
+        double megabytes = static_cast<double>(width * height * 4) * frames / 1000000.0;
+
+        std::cout << std::left << std::setw(28) << name << std::right
+                  << std::setw(10) << std::fixed << std::setprecision(1) << frames / seconds
+                  << std::setw(12) << megabytes / seconds
+                  << std::setw(12) << std::setprecision(0) << output.size() / 1000.0 << std::endl;
+    }
+
+    std::string getFilename(std::size_t index)
+    {
+        std::ostringstream stream;
+        stream << "encoding-benchmark-" << std::setw(2) << std::setfill('0') << index << ".png";
+        return stream.str();
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+/// Entry point of application
+///
+/// \return Application exit code
+///
+////////////////////////////////////////////////////////////
+int main()
+{
+    sf::Image frame;
+    createFrame(frame);
+
+    typedef sf::Image::SaveSettings Settings;
+
+    std::cout << "Encoding of a " << width << "x" << height << " frame in memory" << std::endl;
+    std::cout << "settings                      frames/s   input MB/s   size (KB)" << std::endl;
+
+    // PNG: compression levels with the default filter, then the filters at the default level
+    const unsigned int levels[] = {0, 1, 3, 6, 9};
+    for (std::size_t i = 0; i < sizeof(levels) / sizeof(*levels); ++i)
+    {
+        std::ostringstream name;
+        name << "png, level " << levels[i] << ", adaptive";
+        measure(name.str(), frame, "png", Settings(levels[i], Settings::PngFilterAdaptive));
+    }
+
+    const char* filterNames[] = {"none", "sub", "up", "average", "paeth"};
+    for (int filter = Settings::PngFilterNone; filter < Settings::PngFilterAdaptive; ++filter)
+    {
+        std::ostringstream name;
+        name << "png, level 6, " << filterNames[filter];
+        measure(name.str(), frame, "png", Settings(6, static_cast<Settings::PngFilter>(filter)));
+    }
+
+    // JPEG: qualities with the default subsampling, then the subsamplings at the default quality
+    const unsigned int qualities[] = {50, 75, 90, 100};
+    for (std::size_t i = 0; i < sizeof(qualities) / sizeof(*qualities); ++i)
+    {
+        std::ostringstream name;
+        name << "jpg, quality " << qualities[i] << ", 4:2:0";
+        measure(name.str(), frame, "jpg", Settings(6, Settings::PngFilterAdaptive, qualities[i], Settings::Subsampling420));
+    }
+
+    const char* subsamplingNames[] = {"4:4:4", "4:2:2"};
+    for (int subsampling = Settings::Subsampling444; subsampling < Settings::Subsampling420; ++subsampling)
+    {
+        std::ostringstream name;
+        name << "jpg, quality 90, " << subsamplingNames[subsampling];
+        measure(name.str(), frame, "jpg", Settings(6, Settings::PngFilterAdaptive, 90, static_cast<Settings::ChromaSubsampling>(subsampling)));
+    }
+
+    // The save queue, writing PNG files with the fastest filter in the working directory
+    std::cout << std::endl << "ImageSaveQueue, " << queueFrameCount << " PNG files (level 1, no filter)" << std::endl;
+    std::cout << "threads                       frames/s" << std::endl;
+
+    const unsigned int threadCounts[] = {1, 2, 4, 0};
+    for (std::size_t t = 0; t < sizeof(threadCounts) / sizeof(*threadCounts); ++t)
+    {
+        sf::Clock clock;
+        {
+            sf::ImageSaveQueue queue(threadCounts[t]);
+            for (std::size_t i = 0; i < queueFrameCount; ++i)
+                queue.push(frame, getFilename(i), Settings(1, Settings::PngFilterNone));
+            queue.wait();
+        }
+        double seconds = clock.getElapsedTime().asSeconds();
+
+        std::ostringstream name;
+        if (threadCounts[t] > 0)
+            name << threadCounts[t];
+        else
+            name << "all cores";
+
+        std::cout << std::left << std::setw(28) << name.str() << std::right
+                  << std::setw(10) << std::fixed << std::setprecision(1) << queueFrameCount / seconds << std::endl;
+    }
+
+    for (std::size_t i = 0; i < queueFrameCount; ++i)
+        std::remove(getFilename(i).c_str());
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,182 @@
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics.hpp>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+
+#if __cplusplus >= 201103L
+    #define NO_EXCEPTION noexcept
+#else
+    #define NO_EXCEPTION throw()
+#endif
+
+
+////////////////////////////////////////////////////////////
+// The global allocation functions are replaced to measure
+// the current and peak heap usage of the program
+////////////////////////////////////////////////////////////
+namespace
+{
+    std::size_t currentBytes = 0;
+    std::size_t peakBytes = 0;
+
+    // Each block is preceded by its size, on enough bytes to keep the alignment
+    const std::size_t headerSize = 16;
+
+    void* allocate(std::size_t size)
+    {
+        void* block = std::malloc(size + headerSize);
+        if (!block)
+            throw std::bad_alloc();
+
+        *static_cast<std::size_t*>(block) = size;
+        currentBytes += size;
+        if (currentBytes > peakBytes)
+            peakBytes = currentBytes;
+
+        return static_cast<char*>(block) + headerSize;
+    }
+
+    void deallocate(void* pointer)
+    {
+        if (!pointer)
+            return;
+
+        void* block = static_cast<char*>(pointer) - headerSize;
+        currentBytes -= *static_cast<std::size_t*>(block);
+        std::free(block);
+    }
+}
+
+void* operator new(std::size_t size)                { return allocate(size); }
+void* operator new[](std::size_t size)              { return allocate(size); }
+void  operator delete(void* pointer) NO_EXCEPTION   { deallocate(pointer); }
+void  operator delete[](void* pointer) NO_EXCEPTION { deallocate(pointer); }
+#ifdef __cpp_sized_deallocation
+void  operator delete(void* pointer, std::size_t) NO_EXCEPTION   { deallocate(pointer); }
+void  operator delete[](void* pointer, std::size_t) NO_EXCEPTION { deallocate(pointer); }
+#endif
+
+
+namespace
+{
+    const unsigned int width = 3840;
+    const unsigned int height = 2160;
+    const std::size_t frameCount = 8;
+
+    // Pixels owned by someone else, like the frames of a camera or the output of a video decoder
+    std::vector<sf::Uint8> createExternalFrame(unsigned int seed)
+    {
+        std::vector<sf::Uint8> pixels(width * height * 4);
+        for (std::size_t i = 0; i < pixels.size(); ++i)
+        {
+            seed = seed * 1103515245 + 12345;
+            pixels[i] = static_cast<sf::Uint8>(seed >> 16);
+        }
+
+        return pixels;
+    }
+
+    // The peak is measured from the heap usage when a workload starts
+    std::size_t startBytes = 0;
+    sf::Clock clock;
+
+    void start()
+    {
+        startBytes = currentBytes;
+        peakBytes = currentBytes;
+        clock.restart();
+    }
+
+    void printResult(const std::string& name)
+    {
+        double milliseconds = clock.getElapsedTime().asSeconds() * 1000.0;
+
+        std::cout << std::left << std::setw(40) << name << std::right
+                  << std::setw(12) << std::fixed << std::setprecision(1) << (peakBytes - startBytes) / 1000000.0
+                  << std::setw(12) << milliseconds << std::endl;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+/// Entry point of application
+///
+/// \return Application exit code
+///
+////////////////////////////////////////////////////////////
+int main()
+{
+    const std::vector<sf::Uint8> external = createExternalFrame(1);
+    const sf::IntRect area(960, 540, 1920, 1080);
+
+    std::cout << width << "x" << height << " frames (" << width * height * 4 / 1000000 << " MB each), heap usage above the start of each workload" << std::endl;
+    std::cout << "workload                                 peak (MB)   time (ms)" << std::endl;
+
+    // Collect decoded frames into a vector
+    {
+        start();
+        std::vector<sf::Image> frames;
+        for (std::size_t i = 0; i < frameCount; ++i)
+        {
+            sf::Image frame;
+            frame.create(width, height, &external[0]);
+            frames.push_back(frame);
+        }
+        printResult("collect 8 frames, copies");
+    }
+    {
+        start();
+        std::vector<sf::Image> frames;
+        for (std::size_t i = 0; i < frameCount; ++i)
+        {
+            sf::Image frame;
+            frame.create(width, height, &external[0]);
+            frames.push_back(sf::Image());
+            frames.back().swap(frame);
+        }
+        printResult("collect 8 frames, swap");
+    }
+
+    // Paste an external buffer into an image
+    sf::Image canvas;
+    canvas.create(width, height);
+    {
+        start();
+        sf::Image copy;
+        copy.create(width, height, &external[0]);
+        canvas.copy(copy, 0, 0);
+        printResult("paste external pixels, through an image");
+    }
+    {
+        start();
+        canvas.copy(sf::ImageView(&external[0], width, height), 0, 0);
+        printResult("paste external pixels, view");
+    }
+
+    // Encode a region of an external buffer
+    std::vector<sf::Uint8> output;
+    {
+        start();
+        sf::Image frame;
+        frame.create(width, height, &external[0]);
+        sf::Image region;
+        region.create(area.width, area.height);
+        region.copy(frame, 0, 0, area);
+        region.saveToMemory(output, "bmp");
+        printResult("save a region to BMP, through images");
+    }
+    output = std::vector<sf::Uint8>();
+    {
+        start();
+        sf::ImageView(&external[0], width, height).getSubView(area).saveToMemory(output, "bmp");
+        printResult("save a region to BMP, view");
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,149 @@
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+
+namespace
+{
+    const unsigned int sampleRate = 44100;
+    const unsigned int duration = 600;
+    const int seekCount = 200;
+
+    // Write a 10-minute stereo track, with content that changes over time so that the encoders can't collapse it
+    bool createTrack(const std::string& filename)
+    {
+        sf::OutputSoundFile file;
+        if (!file.openFromFile(filename, sampleRate, 2))
+            return false;
+
+        std::vector<sf::Int16> samples(sampleRate * 2);
+        for (unsigned int second = 0; second < duration; ++second)
+        {
+            double frequency = 0.01 + static_cast<double>(second % 60) * 0.001;
+            for (std::size_t i = 0; i < samples.size(); i += 2)
+            {
+                double t = static_cast<double>(second * sampleRate + i / 2);
+                samples[i] = static_cast<sf::Int16>(8000.0 * std::sin(t * frequency));
+                samples[i + 1] = static_cast<sf::Int16>(6000.0 * std::sin(t * frequency * 1.5 + 1.0));
+            }
+            file.write(&samples[0], samples.size());
+        }
+
+        return true;
+    }
+
+    // Seek to random positions and read the first chunk after each seek, like Music::setPlayingOffset does;
+    // print the mean and worst latencies in milliseconds
+    void measure(sf::InputSoundFile& file, const std::string& name)
+    {
+        std::vector<sf::Int16> chunk(file.getSampleRate() * file.getChannelCount() / 40);
+        sf::Uint64 frameCount = file.getSampleCount() / file.getChannelCount();
+
+        // Same positions for every measurement
+        unsigned int seed = 1;
+        double total = 0.0;
+        double worst = 0.0;
+        for (int i = 0; i < seekCount; ++i)
+        {
+            seed = seed * 1103515245 + 12345;
+            sf::Uint64 frame = (static_cast<sf::Uint64>((seed >> 8) & 0xFFFFFF) * frameCount) >> 24;
+
+            sf::Clock clock;
+            file.seek(frame * file.getChannelCount());
+            file.read(&chunk[0], chunk.size());
+            double milliseconds = static_cast<double>(clock.getElapsedTime().asMicroseconds()) / 1000.0;
+
+            total += milliseconds;
+            worst = std::max(worst, milliseconds);
+        }
+
+        std::cout << std::left << std::setw(30) << name << std::right << std::fixed << std::setprecision(3)
+                  << std::setw(12) << total / seekCount << std::setw(12) << worst << std::endl;
+    }
+
+    bool benchmark(const std::string& filename)
+    {
+        std::string cacheFilename = filename + ".index";
+        std::remove(cacheFilename.c_str());
+
+        sf::InputSoundFile file;
+        if (!file.openFromFile(filename))
+            return false;
+
+        std::cout << filename << " (" << file.getDuration().asSeconds() << " s)" << std::endl;
+        std::cout << "seek                            mean (ms)  worst (ms)" << std::endl;
+        measure(file, "without index");
+
+        // First open: the index is built by scanning the file, and saved
+        sf::Clock clock;
+        if (!file.buildSeekIndex(cacheFilename))
+        {
+            std::cout << "no seek index for this format" << std::endl;
+            return true;
+        }
+        double buildTime = static_cast<double>(clock.getElapsedTime().asMicroseconds()) / 1000.0;
+        measure(file, "seek index");
+
+        // Next opens: the index is loaded from its cache file
+        sf::InputSoundFile cached;
+        if (!cached.openFromFile(filename))
+            return false;
+        clock.restart();
+        cached.buildSeekIndex(cacheFilename);
+        double loadTime = static_cast<double>(clock.getElapsedTime().asMicroseconds()) / 1000.0;
+        measure(cached, "seek index, from the cache");
+
+        std::cout << "index built in " << std::setprecision(1) << buildTime << " ms, loaded from the cache in "
+                  << loadTime << " ms" << std::endl << std::endl;
+
+        std::remove(cacheFilename.c_str());
+        return true;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+/// Entry point of application
+///
+/// Usage: benchmark-input-sound-file [files...]
+/// (default: a generated 10-minute track, in OGG and FLAC)
+///
+/// \return Application exit code
+///
+////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+    std::vector<std::string> filenames(argv + 1, argv + argc);
+    bool generated = filenames.empty();
+    if (generated)
+    {
+        filenames.push_back("seek-track.ogg");
+        filenames.push_back("seek-track.flac");
+        for (std::size_t i = 0; i < filenames.size(); ++i)
+        {
+            if (!createTrack(filenames[i]))
+                return EXIT_FAILURE;
+        }
+    }
+
+    bool success = true;
+    for (std::size_t i = 0; i < filenames.size(); ++i)
+        success = benchmark(filenames[i]) && success;
+
+    if (generated)
+    {
+        for (std::size_t i = 0; i < filenames.size(); ++i)
+            std::remove(filenames[i].c_str());
+    }
+
+    return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
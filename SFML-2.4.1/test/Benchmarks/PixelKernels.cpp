@@ -0,0 +1,119 @@
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/PixelKernels.hpp>
+#include <SFML/System/Clock.hpp>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+
+namespace
+{
+    // A 4K image
+    const unsigned int width = 3840;
+    const unsigned int height = 2160;
+    const std::size_t pixelCount = static_cast<std::size_t>(width) * height;
+
+    std::vector<sf::Uint8> destination;
+    std::vector<sf::Uint8> source;
+    std::vector<sf::Uint8> mip;
+
+    // The operations of sf::Image, on whole 4K images
+    void fill()
+    {
+        const sf::Uint8 color[] = {10, 20, 30, 255};
+        sf::priv::fillPixels(&destination[0], pixelCount, color);
+    }
+
+    void blend()
+    {
+        // Image::copy with applyAlpha blends the source row by row
+        for (unsigned int y = 0; y < height; ++y)
+            sf::priv::blendPixels(&destination[y * width * 4], &source[y * width * 4], width);
+    }
+
+    void mask()
+    {
+        const sf::Uint8 color[] = {0, 0, 0, 255};
+        sf::priv::maskPixels(&destination[0], pixelCount, color, 0);
+    }
+
+    void flipHorizontally()
+    {
+        for (unsigned int y = 0; y < height; ++y)
+            sf::priv::reversePixels(&destination[y * width * 4], width);
+    }
+
+    void flipVertically()
+    {
+        for (unsigned int y = 0; y < height / 2; ++y)
+            sf::priv::swapBytes(&destination[y * width * 4], &destination[(height - y - 1) * width * 4], width * 4);
+    }
+
+    void downsample()
+    {
+        sf::priv::downsampleBox(&source[0], width, height, &mip[0], false);
+    }
+
+    // Return the throughput of an operation, in megapixels per second
+    double measure(void (*operation)())
+    {
+        const int iterations = 10;
+
+        operation();
+
+        sf::Clock clock;
+        for (int i = 0; i < iterations; ++i)
+            operation();
+
+        double seconds = clock.getElapsedTime().asSeconds() / iterations;
+        return static_cast<double>(pixelCount) / seconds / 1000000.0;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+/// Entry point of application
+///
+/// \return Application exit code
+///
+////////////////////////////////////////////////////////////
+int main()
+{
+    destination.resize(pixelCount * 4);
+    source.resize(pixelCount * 4);
+    mip.resize(pixelCount);
+
+    unsigned int seed = 1;
+    for (std::size_t i = 0; i < source.size(); ++i)
+    {
+        seed = seed * 1103515245 + 12345;
+        source[i] = static_cast<sf::Uint8>(seed >> 16);
+        destination[i] = static_cast<sf::Uint8>(seed >> 24);
+    }
+
+    const sf::priv::PixelInstructionSet instructionSets[] = {sf::priv::PixelScalar, sf::priv::PixelSse2, sf::priv::PixelAvx2, sf::priv::PixelNeon};
+    const char* names[] = {"scalar", "SSE2", "AVX2", "NEON"};
+
+    std::cout << width << "x" << height << " images, throughput in Mpixels/s" << std::endl;
+    std::cout << "kernels      fill     blend      mask    flip H    flip V  mipmap" << std::endl;
+
+    for (std::size_t i = 0; i < sizeof(instructionSets) / sizeof(*instructionSets); ++i)
+    {
+        if (!sf::priv::isPixelInstructionSetSupported(instructionSets[i]))
+            continue;
+
+        sf::priv::setPixelInstructionSet(instructionSets[i]);
+        std::cout << std::left << std::setw(7) << names[i] << std::right << std::fixed << std::setprecision(0)
+                  << std::setw(10) << measure(fill)
+                  << std::setw(10) << measure(blend)
+                  << std::setw(10) << measure(mask)
+                  << std::setw(10) << measure(flipHorizontally)
+                  << std::setw(10) << measure(flipVertically)
+                  << std::setw(8) << measure(downsample) << std::endl;
+    }
+
+    return EXIT_SUCCESS;
+}
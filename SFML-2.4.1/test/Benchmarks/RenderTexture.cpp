@@ -0,0 +1,115 @@
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics.hpp>
+#include <GlCallCounter.hpp>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+
+namespace
+{
+    // Like a user interface that caches its widgets in render textures
+    const std::size_t widgetCount = 60;
+    const std::size_t switchCount = 1000;
+    const int frames = 100;
+
+    sf::Vector2f getWidgetPosition(std::size_t index)
+    {
+        return sf::Vector2f(static_cast<float>(index % 10) * 80.f, static_cast<float>(index / 10) * 40.f);
+    }
+
+    void printResult(const std::string& name, std::size_t calls, double milliseconds)
+    {
+        std::cout << std::left << std::setw(32) << name << std::right;
+        if (isGlCallCountAvailable())
+            std::cout << std::setw(16) << calls / frames;
+        else
+            std::cout << std::setw(16) << "-";
+        std::cout << std::setw(12) << std::fixed << std::setprecision(2) << milliseconds / frames << std::endl;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+/// Entry point of application
+///
+/// \return Application exit code
+///
+////////////////////////////////////////////////////////////
+int main()
+{
+    sf::RenderWindow window(sf::VideoMode(800, 600), "SFML render texture benchmark");
+
+    std::vector<sf::RenderTexture*> widgets;
+    for (std::size_t i = 0; i < widgetCount; ++i)
+    {
+        widgets.push_back(new sf::RenderTexture);
+        if (!widgets.back()->create(64, 32))
+            return EXIT_FAILURE;
+    }
+
+    sf::RectangleShape content(sf::Vector2f(48.f, 16.f));
+    content.setPosition(8.f, 8.f);
+    content.setFillColor(sf::Color(200, 120, 40));
+    content.setOutlineThickness(2.f);
+
+    std::cout << widgetCount << " widgets of 64x32, redrawn and composited " << switchCount / 2 << " times per frame" << std::endl;
+    std::cout << "drawing                         GL calls/frame    ms/frame" << std::endl;
+
+    // Each widget update draws into a render texture, then draws it into the window: 2 switches
+    resetGlCallCount();
+    sf::Clock clock;
+    for (int frame = 0; frame < frames; ++frame)
+    {
+        window.clear();
+        for (std::size_t i = 0; i < switchCount / 2; ++i)
+        {
+            sf::RenderTexture& widget = *widgets[i % widgetCount];
+            widget.clear(sf::Color(40, 40, 60));
+            widget.draw(content);
+            widget.display();
+
+            sf::Sprite sprite(widget.getTexture());
+            sprite.setPosition(getWidgetPosition(i % widgetCount));
+            window.draw(sprite);
+        }
+        window.display();
+    }
+    double switching = clock.getElapsedTime().asMicroseconds() / 1000.0;
+    printResult("1000 target switches", getGlCallCount(), switching);
+
+    // The same draws in the window only, to isolate the cost of the switches
+    resetGlCallCount();
+    clock.restart();
+    for (int frame = 0; frame < frames; ++frame)
+    {
+        window.clear();
+        for (std::size_t i = 0; i < switchCount / 2; ++i)
+        {
+            sf::Vector2f position = getWidgetPosition(i % widgetCount);
+            content.setPosition(position + sf::Vector2f(8.f, 8.f));
+            window.draw(content);
+
+            sf::Sprite sprite(widgets[i % widgetCount]->getTexture());
+            sprite.setPosition(position);
+            window.draw(sprite);
+        }
+        window.display();
+    }
+    double direct = clock.getElapsedTime().asMicroseconds() / 1000.0;
+    printResult("no switch", getGlCallCount(), direct);
+
+    std::cout << "cost of a switch: " << std::setprecision(2) << (switching - direct) / frames / switchCount * 1000.0 << " us" << std::endl;
+
+    if (!isGlCallCountAvailable())
+        std::cout << "(OpenGL calls can't be counted on this system)" << std::endl;
+
+    for (std::size_t i = 0; i < widgetCount; ++i)
+        delete widgets[i];
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,127 @@
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics.hpp>
+#include <GlCallCounter.hpp>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+
+namespace
+{
+    // Like a post-processing pass: 40 parameters, of which a few are animated
+    const std::size_t uniformCount = 40;
+    const std::size_t animatedCount = 10;
+    const int frames = 500;
+
+    std::string getUniformName(std::size_t index)
+    {
+        std::ostringstream stream;
+        stream << "parameter" << index;
+        return stream.str();
+    }
+
+    std::string createFragmentShader()
+    {
+        std::ostringstream stream;
+        for (std::size_t i = 0; i < uniformCount; ++i)
+            stream << "uniform float " << getUniformName(i) << ";\n";
+
+        // Use every uniform, so that none is optimized out
+        stream << "void main()\n{\n    float sum = 0.0;\n";
+        for (std::size_t i = 0; i < uniformCount; ++i)
+            stream << "    sum += " << getUniformName(i) << ";\n";
+        stream << "    gl_FragColor = gl_Color * fract(sum);\n}\n";
+
+        return stream.str();
+    }
+
+    float getValue(std::size_t index, int frame)
+    {
+        return (index < animatedCount) ? static_cast<float>(frame % 100) / 100.f : static_cast<float>(index) / uniformCount;
+    }
+
+    void printResult(const std::string& name, std::size_t calls, double milliseconds)
+    {
+        std::cout << std::left << std::setw(24) << name << std::right;
+        if (isGlCallCountAvailable())
+            std::cout << std::setw(16) << calls / frames;
+        else
+            std::cout << std::setw(16) << "-";
+        std::cout << std::setw(14) << std::fixed << std::setprecision(3) << milliseconds / frames << std::endl;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+/// Entry point of application
+///
+/// \return Application exit code
+///
+////////////////////////////////////////////////////////////
+int main()
+{
+    if (!sf::Shader::isAvailable())
+    {
+        std::cerr << "Shaders are not available on this system" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    sf::RenderTexture target;
+    sf::Shader shader;
+    if (!target.create(256, 256) || !shader.loadFromMemory(createFragmentShader(), sf::Shader::Fragment))
+        return EXIT_FAILURE;
+
+    sf::RectangleShape quad(sf::Vector2f(256.f, 256.f));
+    std::vector<std::string> names;
+    std::vector<sf::Shader::UniformHandle> handles;
+    for (std::size_t i = 0; i < uniformCount; ++i)
+    {
+        names.push_back(getUniformName(i));
+        handles.push_back(shader.getUniformHandle(names.back()));
+    }
+
+    std::cout << uniformCount << " float uniforms set every frame, " << animatedCount << " of them changing" << std::endl;
+    std::cout << "uniforms set            GL calls/frame     ms/frame" << std::endl;
+
+    // Each uniform set by name binds the program, uploads the value and restores the previous program
+    {
+        resetGlCallCount();
+        sf::Clock clock;
+        for (int frame = 0; frame < frames; ++frame)
+        {
+            for (std::size_t i = 0; i < uniformCount; ++i)
+                shader.setUniform(names[i], getValue(i, frame));
+
+            target.clear();
+            target.draw(quad, &shader);
+            target.display();
+        }
+        printResult("by name", getGlCallCount(), clock.getElapsedTime().asMicroseconds() / 1000.0);
+    }
+
+    // The staged uniforms are uploaded when the shader is bound, and only when their value changed
+    {
+        resetGlCallCount();
+        sf::Clock clock;
+        for (int frame = 0; frame < frames; ++frame)
+        {
+            for (std::size_t i = 0; i < uniformCount; ++i)
+                shader.setUniform(handles[i], getValue(i, frame));
+
+            target.clear();
+            target.draw(quad, &shader);
+            target.display();
+        }
+        printResult("by handle", getGlCallCount(), clock.getElapsedTime().asMicroseconds() / 1000.0);
+    }
+
+    if (!isGlCallCountAvailable())
+        std::cout << "(OpenGL calls can't be counted on this system)" << std::endl;
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,134 @@
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics.hpp>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+
+namespace
+{
+    const std::size_t shapeCount = 10000;
+
+    // Animate the circles and rectangles for a few frames, and return the update time per frame in milliseconds.
+    // Resizing a shape rebuilds its geometry, so this measures Shape::update without drawing
+    double measure(std::vector<sf::CircleShape>& circles, std::vector<sf::RectangleShape>& rectangles)
+    {
+        const int frames = 20;
+
+        sf::Clock clock;
+        for (int frame = 0; frame < frames; ++frame)
+        {
+            float size = 5.f + static_cast<float>(frame % 10);
+            for (std::size_t i = 0; i < circles.size(); ++i)
+                circles[i].setRadius(size + static_cast<float>(i % 7));
+            for (std::size_t i = 0; i < rectangles.size(); ++i)
+                rectangles[i].setSize(sf::Vector2f(size + static_cast<float>(i % 5), size * 2.f));
+        }
+
+        return clock.getElapsedTime().asMicroseconds() / 1000.0 / frames;
+    }
+
+    // Submit all the shapes to a render queue, which transforms them and converts fans and strips to triangles,
+    // and return the time per frame in milliseconds
+    double measureQueue(const std::vector<sf::CircleShape>& circles, const std::vector<sf::RectangleShape>& rectangles)
+    {
+        const int frames = 20;
+
+        sf::RenderQueue queue;
+        sf::Clock clock;
+        for (int frame = 0; frame < frames; ++frame)
+        {
+            queue.clear();
+            for (std::size_t i = 0; i < circles.size(); ++i)
+                queue.add(circles[i]);
+            for (std::size_t i = 0; i < rectangles.size(); ++i)
+                queue.add(rectangles[i]);
+        }
+
+        return clock.getElapsedTime().asMicroseconds() / 1000.0 / frames;
+    }
+
+    void append(sf::VertexArray& batch, const sf::Shape& shape)
+    {
+        const sf::Transform& transform = shape.getTransform();
+        const sf::VertexArray* arrays[] = {&shape.getFillVertices(), &shape.getOutlineVertices()};
+        for (int a = 0; a < 2; ++a)
+        {
+            for (std::size_t i = 0; i < arrays[a]->getVertexCount(); ++i)
+            {
+                sf::Vertex vertex = (*arrays[a])[i];
+                vertex.position = transform.transformPoint(vertex.position);
+                batch.append(vertex);
+            }
+        }
+    }
+
+    // Append the triangle lists of all the shapes to a single array, that one draw call can render,
+    // and return the time per frame in milliseconds
+    double measureAppend(const std::vector<sf::CircleShape>& circles, const std::vector<sf::RectangleShape>& rectangles)
+    {
+        const int frames = 20;
+
+        sf::VertexArray batch(sf::Triangles);
+        sf::Clock clock;
+        for (int frame = 0; frame < frames; ++frame)
+        {
+            batch.clear();
+            for (std::size_t i = 0; i < circles.size(); ++i)
+                append(batch, circles[i]);
+            for (std::size_t i = 0; i < rectangles.size(); ++i)
+                append(batch, rectangles[i]);
+        }
+
+        return clock.getElapsedTime().asMicroseconds() / 1000.0 / frames;
+    }
+
+    void printResult(const char* name, double milliseconds)
+    {
+        std::cout << std::left << std::setw(40) << name << std::right
+                  << std::setw(10) << std::fixed << std::setprecision(2) << milliseconds << std::endl;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+/// Entry point of application
+///
+/// \return Application exit code
+///
+////////////////////////////////////////////////////////////
+int main()
+{
+    std::vector<sf::CircleShape> circles(shapeCount, sf::CircleShape(10.f, 30));
+    std::vector<sf::RectangleShape> rectangles(shapeCount, sf::RectangleShape(sf::Vector2f(10.f, 20.f)));
+    for (std::size_t i = 0; i < shapeCount; ++i)
+    {
+        sf::Vector2f position(static_cast<float>(i % 100) * 12.f, static_cast<float>(i / 100) * 12.f);
+        circles[i].setPosition(position);
+        circles[i].setOutlineThickness(2.f);
+        rectangles[i].setPosition(position);
+        rectangles[i].setRotation(static_cast<float>(i % 360));
+        rectangles[i].setOutlineThickness(2.f);
+    }
+
+    std::cout << shapeCount << " circles (30 points) and " << shapeCount << " rectangles, with outlines" << std::endl;
+    std::cout << "workload                                ms/frame" << std::endl;
+
+    printResult("update, fan + strip", measure(circles, rectangles));
+    printResult("submit to a render queue, fan + strip", measureQueue(circles, rectangles));
+
+    for (std::size_t i = 0; i < shapeCount; ++i)
+    {
+        circles[i].setTriangleList(true);
+        rectangles[i].setTriangleList(true);
+    }
+
+    printResult("update, triangle list", measure(circles, rectangles));
+    printResult("submit to a render queue, triangle list", measureQueue(circles, rectangles));
+    printResult("append to one array, triangle list", measureAppend(circles, rectangles));
+
+    return EXIT_SUCCESS;
+}
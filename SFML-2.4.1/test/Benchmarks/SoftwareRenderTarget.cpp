@@ -0,0 +1,106 @@
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics.hpp>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+
+
+namespace
+{
+    // Render a drawable repeatedly, and return the average time of a frame in milliseconds
+    double measure(sf::SoftwareRenderTarget& target, const sf::Drawable& drawable, const sf::RenderStates& states)
+    {
+        const int frames = 10;
+
+        sf::Clock clock;
+        for (int i = 0; i < frames; ++i)
+        {
+            target.clear(sf::Color::Black);
+            target.draw(drawable, states);
+            target.display();
+        }
+
+        return clock.getElapsedTime().asMicroseconds() / 1000.0 / frames;
+    }
+
+    void report(const char* name, double milliseconds, double pixels)
+    {
+        std::cout << std::setw(24) << name << std::setw(12) << std::fixed << std::setprecision(2) << milliseconds
+                  << std::setw(12) << std::setprecision(0) << pixels / milliseconds / 1000.0 << std::endl;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+/// Entry point of application
+///
+/// \return Application exit code
+///
+////////////////////////////////////////////////////////////
+int main()
+{
+    // Untextured scenes only: textured ones read their textures back through OpenGL
+    const unsigned int width  = 1920;
+    const unsigned int height = 1080;
+
+    sf::SoftwareRenderTarget target;
+    if (!target.create(width, height))
+        return EXIT_FAILURE;
+
+    // Full-screen gradients, 8 layers blended on top of each other
+    sf::VertexArray gradients(sf::Triangles);
+    for (int i = 0; i < 8; ++i)
+    {
+        sf::Color top(static_cast<sf::Uint8>(i * 30), 100, 200, 128);
+        sf::Color bottom(200, static_cast<sf::Uint8>(i * 30), 50, 128);
+        gradients.append(sf::Vertex(sf::Vector2f(0.f, 0.f), top));
+        gradients.append(sf::Vertex(sf::Vector2f(width, 0.f), top));
+        gradients.append(sf::Vertex(sf::Vector2f(0.f, height), bottom));
+        gradients.append(sf::Vertex(sf::Vector2f(0.f, height), bottom));
+        gradients.append(sf::Vertex(sf::Vector2f(width, 0.f), top));
+        gradients.append(sf::Vertex(sf::Vector2f(width, height), bottom));
+    }
+    double gradientPixels = 8.0 * width * height;
+
+    // 20k small opaque rectangles, like sprites or tiles
+    sf::VertexArray rectangles(sf::Quads);
+    for (int i = 0; i < 20000; ++i)
+    {
+        sf::Vector2f position(static_cast<float>((i * 97) % (width - 16)), static_cast<float>((i * 61) % (height - 16)));
+        sf::Color color(static_cast<sf::Uint8>(i), static_cast<sf::Uint8>(i / 3), static_cast<sf::Uint8>(i / 7));
+        rectangles.append(sf::Vertex(position, color));
+        rectangles.append(sf::Vertex(position + sf::Vector2f(16.f, 0.f), color));
+        rectangles.append(sf::Vertex(position + sf::Vector2f(16.f, 16.f), color));
+        rectangles.append(sf::Vertex(position + sf::Vector2f(0.f, 16.f), color));
+    }
+    double rectanglePixels = 20000.0 * 16 * 16;
+
+    // 20k small rotated translucent triangles
+    sf::VertexArray triangles(sf::Triangles);
+    for (int i = 0; i < 20000; ++i)
+    {
+        sf::Vector2f position(static_cast<float>((i * 89) % (width - 20)), static_cast<float>((i * 53) % (height - 20)));
+        sf::Color color(static_cast<sf::Uint8>(i), 128, static_cast<sf::Uint8>(i / 5), 160);
+        triangles.append(sf::Vertex(position + sf::Vector2f(3.f, 0.f), color));
+        triangles.append(sf::Vertex(position + sf::Vector2f(20.f, 7.f), color));
+        triangles.append(sf::Vertex(position + sf::Vector2f(0.f, 20.f), color));
+    }
+    double trianglePixels = 20000.0 * 185;
+
+    unsigned int threadCounts[] = {1, 0};
+    for (int i = 0; i < 2; ++i)
+    {
+        target.setThreadCount(threadCounts[i]);
+        unsigned int threadCount = threadCounts[i] ? threadCounts[i] : sf::Thread::getHardwareConcurrency();
+        std::cout << width << "x" << height << ", " << threadCount << " thread(s)" << std::endl;
+
+        std::cout << std::setw(24) << "scene" << std::setw(12) << "ms/frame" << std::setw(12) << "Mpix/s" << std::endl;
+        report("gradients (alpha)", measure(target, gradients, sf::BlendAlpha), gradientPixels);
+        report("rectangles (opaque)", measure(target, rectangles, sf::BlendAlpha), rectanglePixels);
+        report("triangles (alpha)", measure(target, triangles, sf::BlendAlpha), trianglePixels);
+    }
+
+    return EXIT_SUCCESS;
+}
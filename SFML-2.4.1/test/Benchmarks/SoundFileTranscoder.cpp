@@ -0,0 +1,126 @@
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio.hpp>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+
+namespace
+{
+    const std::size_t fileCount = 32;
+    const unsigned int sampleRate = 44100;
+    const unsigned int duration = 10;
+
+    std::string getFilename(const std::string& prefix, std::size_t index, const std::string& extension)
+    {
+        std::ostringstream stream;
+        stream << prefix << std::setw(2) << std::setfill('0') << index << "." << extension;
+        return stream.str();
+    }
+
+    // Write a stereo file of a few seconds of tones, one per file, like a directory of sound effects
+    bool createInput(const std::string& filename, std::size_t index)
+    {
+        sf::OutputSoundFile file;
+        if (!file.openFromFile(filename, sampleRate, 2))
+            return false;
+
+        std::vector<sf::Int16> samples(sampleRate * 2);
+        double frequency = 0.02 + static_cast<double>(index) * 0.002;
+        for (unsigned int second = 0; second < duration; ++second)
+        {
+            for (std::size_t i = 0; i < samples.size(); i += 2)
+            {
+                double t = static_cast<double>(second * sampleRate + i / 2);
+                samples[i] = static_cast<sf::Int16>(8000.0 * std::sin(t * frequency));
+                samples[i + 1] = static_cast<sf::Int16>(6000.0 * std::sin(t * frequency * 1.5));
+            }
+            file.write(&samples[0], samples.size());
+        }
+
+        return true;
+    }
+
+    void printResult(const std::string& name, const sf::SoundFileTranscoder& transcoder, const sf::Time& elapsed)
+    {
+        sf::SoundFileTranscoder::Statistics statistics = transcoder.getStatistics();
+        double seconds = elapsed.asSeconds();
+        double audioSeconds = static_cast<double>(statistics.sampleCount) / (sampleRate * 2);
+
+        std::cout << std::left << std::setw(20) << name << std::right
+                  << std::setw(8) << statistics.fileCount
+                  << std::setw(12) << std::fixed << std::setprecision(2) << seconds
+                  << std::setw(12) << std::setprecision(1) << statistics.fileCount / seconds
+                  << std::setw(12) << std::setprecision(0) << audioSeconds / seconds
+                  << std::setw(14) << statistics.getDecodeThroughput() / 1000000.f
+                  << std::setw(14) << statistics.getEncodeThroughput() / 1000000.f << std::endl;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+/// Entry point of application
+///
+/// Usage: benchmark-sound-file-transcoder [output extension]
+/// (default: ogg)
+///
+/// \return Application exit code
+///
+////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+    std::string extension = (argc > 1) ? argv[1] : "ogg";
+
+    // The input directory: WAV files written in the working directory, removed at the end
+    std::vector<std::string> inputs;
+    std::vector<std::string> outputs;
+    for (std::size_t i = 0; i < fileCount; ++i)
+    {
+        inputs.push_back(getFilename("transcoder-input-", i, "wav"));
+        outputs.push_back(getFilename("transcoder-output-", i, extension));
+        if (!createInput(inputs.back(), i))
+            return EXIT_FAILURE;
+    }
+
+    std::cout << fileCount << " stereo WAV files of " << duration << " s, converted to " << extension << std::endl;
+    std::cout << "mode                   files    time (s)     files/s   audio s/s  decode (Ms/s)  encode (Ms/s)" << std::endl;
+
+    sf::SoundFileTranscoder transcoder;
+
+    // One file after the other, each one pipelined over two threads
+    sf::Clock clock;
+    for (std::size_t i = 0; i < fileCount; ++i)
+        transcoder.transcode(inputs[i], outputs[i]);
+    printResult("pipelined", transcoder, clock.getElapsedTime());
+
+    // Batch mode, one file per worker thread
+    const unsigned int threadCounts[] = {1, 2, 4, 8, 0};
+    for (std::size_t t = 0; t < sizeof(threadCounts) / sizeof(*threadCounts); ++t)
+    {
+        std::ostringstream name;
+        if (threadCounts[t] > 0)
+            name << "batch, " << threadCounts[t] << " thread(s)";
+        else
+            name << "batch, all cores";
+
+        transcoder.resetStatistics();
+        clock.restart();
+        transcoder.transcodeBatch(inputs, outputs, threadCounts[t]);
+        printResult(name.str(), transcoder, clock.getElapsedTime());
+    }
+
+    for (std::size_t i = 0; i < fileCount; ++i)
+    {
+        std::remove(inputs[i].c_str());
+        std::remove(outputs[i].c_str());
+    }
+
+    return EXIT_SUCCESS;
+}
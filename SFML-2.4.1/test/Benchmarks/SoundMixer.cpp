@@ -0,0 +1,86 @@
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio.hpp>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+
+namespace
+{
+    const unsigned int sampleRate = 44100;
+
+    // Mix one second of audio in chunks of 25 ms, like the streaming thread does, and return
+    // the number of voices mixed per millisecond (milliseconds of voice audio per millisecond of CPU)
+    double measure(sf::SoundMixer& mixer, std::size_t voiceCount)
+    {
+        const std::size_t chunkFrames = sampleRate / 40;
+        std::vector<sf::Int16> samples(chunkFrames * 2);
+
+        sf::Clock clock;
+        for (int i = 0; i < 40; ++i)
+            mixer.mix(&samples[0], chunkFrames);
+        double milliseconds = static_cast<double>(clock.getElapsedTime().asMicroseconds()) / 1000.0;
+
+        return static_cast<double>(voiceCount) * 1000.0 / milliseconds;
+    }
+
+    // Create a looping sine wave
+    void createTone(sf::SoundBuffer& buffer, unsigned int channelCount)
+    {
+        std::vector<sf::Int16> samples(sampleRate * channelCount);
+        for (std::size_t i = 0; i < samples.size(); ++i)
+            samples[i] = static_cast<sf::Int16>(8000.0 * std::sin(static_cast<double>(i / channelCount) * 0.05));
+        buffer.loadFromSamples(&samples[0], samples.size(), channelCount, sampleRate);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+/// Entry point of application
+///
+/// \return Application exit code
+///
+////////////////////////////////////////////////////////////
+int main()
+{
+    // The voices are mixed offline, the audio device is not used
+    sf::SoundBuffer mono;
+    sf::SoundBuffer stereo;
+    createTone(mono, 1);
+    createTone(stereo, 2);
+
+    const std::size_t counts[] = {16, 64, 256, 1024};
+
+    std::cout << "voices  mono (voices/ms)  stereo (voices/ms)  resampled (voices/ms)" << std::endl;
+
+    for (std::size_t c = 0; c < sizeof(counts) / sizeof(*counts); ++c)
+    {
+        std::size_t count = counts[c];
+        sf::SoundMixer mixer(sampleRate, count);
+
+        // Same rate as the output: the samples are just converted
+        for (std::size_t i = 0; i < count; ++i)
+            mixer.playVoice(mono, 50.f, 1.f, static_cast<float>(i % 21) / 10.f - 1.f, 0, true);
+        double monoRate = measure(mixer, count);
+
+        mixer.stopAllVoices();
+        for (std::size_t i = 0; i < count; ++i)
+            mixer.playVoice(stereo, 50.f, 1.f, static_cast<float>(i % 21) / 10.f - 1.f, 0, true);
+        double stereoRate = measure(mixer, count);
+
+        // Every voice has its own pitch: linear interpolation
+        mixer.stopAllVoices();
+        for (std::size_t i = 0; i < count; ++i)
+            mixer.playVoice(mono, 50.f, 0.8f + static_cast<float>(i % 40) * 0.01f, static_cast<float>(i % 21) / 10.f - 1.f, 0, true);
+        double resampledRate = measure(mixer, count);
+
+        std::cout << std::setw(6) << count << std::setw(18) << static_cast<int>(monoRate)
+                  << std::setw(20) << static_cast<int>(stereoRate) << std::setw(23) << static_cast<int>(resampledRate) << std::endl;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,109 @@
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics.hpp>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+
+namespace
+{
+    // Small deterministic generator, so that the scenes are the same on every run
+    unsigned int seed = 1;
+    float getRandom(float first, float last)
+    {
+        seed = seed * 1103515245 + 12345;
+        return first + (last - first) * static_cast<float>((seed >> 16) & 0x7FFF) / 32767.f;
+    }
+
+    double getMicroseconds(const sf::Clock& clock, int iterations)
+    {
+        return static_cast<double>(clock.getElapsedTime().asMicroseconds()) / iterations;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+/// Entry point of application
+///
+/// \return Application exit code
+///
+////////////////////////////////////////////////////////////
+int main()
+{
+    // The objects are spread with the same density whatever their number, so that a 1920x1080
+    // view always shows about 1300 of them; culling is measured without drawing
+    const std::size_t counts[] = {1000, 10000, 50000, 200000};
+    const sf::FloatRect viewArea(0.f, 0.f, 1920.f, 1080.f);
+    const int iterations = 100;
+
+    std::cout << "objects  visible  insert (us)  query (us)  test all (us)  move 10% (us)" << std::endl;
+
+    for (std::size_t c = 0; c < sizeof(counts) / sizeof(*counts); ++c)
+    {
+        std::size_t count = counts[c];
+        float extent = std::sqrt(static_cast<float>(count)) * 40.f;
+
+        std::vector<sf::RectangleShape> shapes(count, sf::RectangleShape(sf::Vector2f(16.f, 16.f)));
+        for (std::size_t i = 0; i < count; ++i)
+            shapes[i].setPosition(getRandom(0.f, extent), getRandom(0.f, extent));
+
+        // Building the index
+        sf::SpatialIndex index;
+        sf::Clock clock;
+        std::vector<std::size_t> ids(count);
+        for (std::size_t i = 0; i < count; ++i)
+            ids[i] = index.insert(shapes[i]);
+        double insert = getMicroseconds(clock, 1);
+
+        // Scrolling views, culled by the index and by testing every object
+        std::vector<const sf::Drawable*> visible;
+        std::size_t visibleCount = 0;
+        clock.restart();
+        for (int i = 0; i < iterations; ++i)
+        {
+            sf::FloatRect area = viewArea;
+            area.left = (extent - area.width) * static_cast<float>(i) / iterations;
+            area.top = (extent - area.height) * static_cast<float>(i) / iterations;
+            index.query(area, visible);
+            visibleCount += visible.size();
+        }
+        double query = getMicroseconds(clock, iterations);
+
+        clock.restart();
+        for (int i = 0; i < iterations; ++i)
+        {
+            sf::FloatRect area = viewArea;
+            area.left = (extent - area.width) * static_cast<float>(i) / iterations;
+            area.top = (extent - area.height) * static_cast<float>(i) / iterations;
+            visible.clear();
+            for (std::size_t j = 0; j < count; ++j)
+            {
+                if (shapes[j].getGlobalBounds().intersects(area))
+                    visible.push_back(&shapes[j]);
+            }
+        }
+        double testAll = getMicroseconds(clock, iterations);
+
+        // Moving a tenth of the objects and updating the index
+        clock.restart();
+        for (int i = 0; i < iterations; ++i)
+        {
+            for (std::size_t j = i % 10; j < count; j += 10)
+            {
+                shapes[j].move(getRandom(-8.f, 8.f), getRandom(-8.f, 8.f));
+                index.update(ids[j]);
+            }
+        }
+        double move = getMicroseconds(clock, iterations);
+
+        std::cout << std::setw(7) << count << std::setw(9) << visibleCount / iterations
+                  << std::setw(13) << static_cast<int>(insert) << std::setw(12) << static_cast<int>(query)
+                  << std::setw(15) << static_cast<int>(testAll) << std::setw(15) << static_cast<int>(move) << std::endl;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,148 @@
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics.hpp>
+#include <GlCallCounter.hpp>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+
+namespace
+{
+    // Sprites that alternate between two textures, like a scene drawn from several atlas pages
+    const std::size_t spriteCount = 10000;
+    const int frames = 50;
+
+    sf::Vector2f getPosition(std::size_t index)
+    {
+        return sf::Vector2f(static_cast<float>(index * 37 % 1000), static_cast<float>(index * 91 % 740));
+    }
+
+    // Two triangles covering a 16x16 region of a texture, in pixels or normalized coordinates
+    void makeQuad(sf::Vertex* quad, const sf::Vector2f& position, const sf::Texture& texture, sf::Texture::CoordinateType coordinateType)
+    {
+        sf::Vector2f scale(1.f, 1.f);
+        if (coordinateType == sf::Texture::Normalized)
+            scale = sf::Vector2f(1.f / texture.getSize().x, 1.f / texture.getSize().y);
+
+        const float u[6] = {0.f, 1.f, 0.f, 0.f, 1.f, 1.f};
+        const float v[6] = {0.f, 0.f, 1.f, 1.f, 0.f, 1.f};
+        for (int i = 0; i < 6; ++i)
+        {
+            quad[i].position  = position + sf::Vector2f(u[i] * 16.f, v[i] * 16.f);
+            quad[i].texCoords = sf::Vector2f(u[i] * 16.f * scale.x, v[i] * 16.f * scale.y);
+            quad[i].color     = sf::Color::White;
+        }
+    }
+
+    // Draw the sprites as sf::Sprite instances, which are pre-transformed on the CPU
+    void drawSprites(sf::RenderTarget& target, const sf::Texture* textures[2])
+    {
+        sf::Sprite sprite;
+        for (std::size_t i = 0; i < spriteCount; ++i)
+        {
+            sprite.setTexture(*textures[i % 2]);
+            sprite.setTextureRect(sf::IntRect(0, 0, 16, 16));
+            sprite.setPosition(getPosition(i));
+            target.draw(sprite);
+        }
+    }
+
+    // Draw the sprites as 6 vertices each, which need the texture matrix of their texture
+    void drawQuads(sf::RenderTarget& target, const sf::Texture* textures[2], const std::vector<sf::Vertex>& vertices, sf::Texture::CoordinateType coordinateType)
+    {
+        sf::RenderStates states;
+        states.coordinateType = coordinateType;
+        for (std::size_t i = 0; i < spriteCount; ++i)
+        {
+            states.texture = textures[i % 2];
+            target.draw(&vertices[i * 6], 6, sf::Triangles, states);
+        }
+    }
+
+    void createQuads(std::vector<sf::Vertex>& vertices, const sf::Texture* textures[2], sf::Texture::CoordinateType coordinateType)
+    {
+        vertices.resize(spriteCount * 6);
+        for (std::size_t i = 0; i < spriteCount; ++i)
+            makeQuad(&vertices[i * 6], getPosition(i), *textures[i % 2], coordinateType);
+    }
+
+    void printResult(const std::string& name, std::size_t calls, double milliseconds)
+    {
+        std::cout << std::left << std::setw(44) << name << std::right;
+        if (isGlCallCountAvailable())
+            std::cout << std::setw(16) << calls / frames;
+        else
+            std::cout << std::setw(16) << "-";
+        std::cout << std::setw(12) << std::fixed << std::setprecision(2) << milliseconds / frames << std::endl;
+    }
+
+    // Draw the sprites for a number of frames, with the OpenGL calls of the draws only
+    void measure(const std::string& name, sf::RenderTexture& target, const sf::Texture* textures[2],
+                 const std::vector<sf::Vertex>* vertices, sf::Texture::CoordinateType coordinateType)
+    {
+        std::size_t calls = 0;
+        sf::Clock clock;
+        for (int frame = 0; frame < frames; ++frame)
+        {
+            target.clear();
+
+            resetGlCallCount();
+            if (vertices)
+                drawQuads(target, textures, *vertices, coordinateType);
+            else
+                drawSprites(target, textures);
+            calls += getGlCallCount();
+
+            target.display();
+        }
+
+        printResult(name, calls, clock.getElapsedTime().asMicroseconds() / 1000.0);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+/// Entry point of application
+///
+/// \return Application exit code
+///
+////////////////////////////////////////////////////////////
+int main()
+{
+    sf::RenderTexture target;
+    if (!target.create(1024, 768))
+        return EXIT_FAILURE;
+
+    // Two pages of different sizes, and two pages of the same size
+    sf::Texture small, large, pageA, pageB;
+    if (!small.create(256, 256) || !large.create(1024, 512) || !pageA.create(512, 512) || !pageB.create(512, 512))
+        return EXIT_FAILURE;
+
+    const sf::Texture* differentSizes[2] = {&small, &large};
+    const sf::Texture* sameSizes[2] = {&pageA, &pageB};
+
+    std::cout << spriteCount << " sprites of 16x16, switching between two textures at every sprite" << std::endl;
+    std::cout << "drawing                                     GL calls/frame    ms/frame" << std::endl;
+
+    measure("sprites, different sizes", target, differentSizes, NULL, sf::Texture::Pixels);
+    measure("sprites, same size", target, sameSizes, NULL, sf::Texture::Pixels);
+
+    std::vector<sf::Vertex> vertices;
+    createQuads(vertices, differentSizes, sf::Texture::Pixels);
+    measure("6 vertices, pixels, different sizes", target, differentSizes, &vertices, sf::Texture::Pixels);
+
+    createQuads(vertices, sameSizes, sf::Texture::Pixels);
+    measure("6 vertices, pixels, same size", target, sameSizes, &vertices, sf::Texture::Pixels);
+
+    createQuads(vertices, differentSizes, sf::Texture::Normalized);
+    measure("6 vertices, normalized, different sizes", target, differentSizes, &vertices, sf::Texture::Normalized);
+
+    if (!isGlCallCountAvailable())
+        std::cout << "(OpenGL calls can't be counted on this system)" << std::endl;
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,65 @@
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics.hpp>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+
+namespace
+{
+    // Measure the expansion of the sprites into vertices, and return the number of sprites per millisecond
+    double measure(const sf::SpriteBatch& batch, std::vector<sf::Vertex>& vertices)
+    {
+        const int iterations = 50;
+
+        sf::Clock clock;
+        for (int i = 0; i < iterations; ++i)
+            batch.getVertices(vertices);
+
+        double milliseconds = clock.getElapsedTime().asMicroseconds() / 1000.0 / iterations;
+        return batch.getSpriteCount() / milliseconds;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+/// Entry point of application
+///
+/// \return Application exit code
+///
+////////////////////////////////////////////////////////////
+int main()
+{
+    // The CPU expansion is the path used without instancing, it is measured without drawing
+    const std::size_t counts[] = {1000, 10000, 50000, 200000};
+
+    std::cout << "sprites  rotated (sprites/ms)  unrotated (sprites/ms)" << std::endl;
+
+    for (std::size_t c = 0; c < sizeof(counts) / sizeof(*counts); ++c)
+    {
+        std::size_t count = counts[c];
+
+        sf::SpriteBatch batch;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            sf::Vector2f position(static_cast<float>(i % 1920), static_cast<float>(i % 1080));
+            float rotation = static_cast<float>(i % 360) + 0.5f;
+            batch.add(position, sf::IntRect(0, 0, 8, 8), sf::Color::White, rotation, sf::Vector2f(1.f, 1.f), sf::Vector2f(4.f, 4.f));
+        }
+
+        std::vector<sf::Vertex> vertices;
+        double rotated = measure(batch, vertices);
+
+        for (std::size_t i = 0; i < count; ++i)
+            batch.setRotation(i, 0.f);
+        double unrotated = measure(batch, vertices);
+
+        std::cout << std::setw(7) << count << std::setw(22) << static_cast<int>(rotated)
+                  << std::setw(24) << static_cast<int>(unrotated) << std::endl;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,123 @@
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics.hpp>
+#include <SFML/System.hpp>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+
+namespace
+{
+    const unsigned int size = 1024;
+    const std::size_t textureCount = 32;
+
+    // Uploads a range of the textures on its own thread, then marks the end of its uploads with a fence
+    class Loader
+    {
+    public:
+
+        Loader(const sf::Image& image, std::vector<sf::Texture>& textures, std::size_t first, std::size_t last) :
+        m_image   (image),
+        m_textures(textures),
+        m_first   (first),
+        m_last    (last),
+        m_thread  (&Loader::run, this)
+        {
+        }
+
+        void launch()
+        {
+            m_thread.launch();
+        }
+
+        // Wait until the thread is done, then until the graphics card is done with its uploads
+        bool wait()
+        {
+            m_thread.wait();
+            return m_fence.wait(sf::seconds(10.f));
+        }
+
+    private:
+
+        void run()
+        {
+            for (std::size_t i = m_first; i < m_last; ++i)
+                m_textures[i].loadFromImage(m_image);
+
+            m_fence.insert();
+        }
+
+        const sf::Image&          m_image;
+        std::vector<sf::Texture>& m_textures;
+        std::size_t               m_first;
+        std::size_t               m_last;
+        sf::GpuFence              m_fence;
+        sf::Thread                m_thread;
+    };
+}
+
+
+////////////////////////////////////////////////////////////
+/// Entry point of application
+///
+/// \return Application exit code
+///
+////////////////////////////////////////////////////////////
+int main()
+{
+    sf::Image image;
+    image.create(size, size);
+    for (unsigned int y = 0; y < size; ++y)
+        for (unsigned int x = 0; x < size; ++x)
+            image.setPixel(x, y, sf::Color(static_cast<sf::Uint8>(x), static_cast<sf::Uint8>(y), static_cast<sf::Uint8>(x ^ y)));
+
+    double megabytes = static_cast<double>(size * size * 4) * textureCount / 1000000.0;
+
+    std::cout << textureCount << " textures of " << size << "x" << size << " (" << megabytes << " MB) uploaded by loader threads"
+              << (sf::GpuFence::isAvailable() ? "" : ", without fences (glFinish)") << std::endl;
+    std::cout << "threads     time (ms)      MB/s   speed-up" << std::endl;
+
+    double reference = 0.0;
+    const std::size_t threadCounts[] = {1, 2, 3, 4, 6, 8};
+    for (std::size_t t = 0; t < sizeof(threadCounts) / sizeof(*threadCounts); ++t)
+    {
+        std::size_t threadCount = threadCounts[t];
+        std::vector<sf::Texture> textures(textureCount);
+
+        std::vector<Loader*> loaders;
+        for (std::size_t i = 0; i < threadCount; ++i)
+            loaders.push_back(new Loader(image, textures, textureCount * i / threadCount, textureCount * (i + 1) / threadCount));
+
+        // The render thread sees the textures once all the fences are signaled
+        sf::Clock clock;
+        for (std::size_t i = 0; i < threadCount; ++i)
+            loaders[i]->launch();
+
+        bool complete = true;
+        for (std::size_t i = 0; i < threadCount; ++i)
+            complete = loaders[i]->wait() && complete;
+
+        double seconds = clock.getElapsedTime().asSeconds();
+        if (t == 0)
+            reference = seconds;
+
+        for (std::size_t i = 0; i < threadCount; ++i)
+            delete loaders[i];
+
+        if (!complete)
+        {
+            std::cerr << "The uploads didn't complete in time" << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        std::cout << std::setw(7) << threadCount << std::fixed << std::setprecision(1)
+                  << std::setw(14) << seconds * 1000.0
+                  << std::setw(10) << megabytes / seconds
+                  << std::setw(11) << std::setprecision(2) << reference / seconds << std::endl;
+    }
+
+    return EXIT_SUCCESS;
+}
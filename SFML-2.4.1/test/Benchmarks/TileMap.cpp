@@ -0,0 +1,172 @@
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics.hpp>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+
+namespace
+{
+    const unsigned int mapSize = 4096;
+    const unsigned int tileSize = 16;
+    const int frames = 200;
+
+    // Small deterministic generator, so that the maps are the same on every run
+    unsigned int seed = 1;
+    unsigned int getRandom(unsigned int count)
+    {
+        seed = seed * 1103515245 + 12345;
+        return ((seed >> 8) & 0xFFFFFF) % count;
+    }
+
+    // Tile at a position of the generated map: ground everywhere, a few
+    // decorations on the second layer, and animated water (tile 1)
+    sf::Uint32 getGround(unsigned int x, unsigned int y)
+    {
+        return ((x / 32 + y / 32) % 7 == 0) ? 1 : 2 + (x * 7 + y * 13) % 200;
+    }
+
+    sf::Uint32 getDecoration(unsigned int x, unsigned int y)
+    {
+        return ((x * 31 + y * 17) % 11 == 0) ? 202 + (x + y) % 50 : 0;
+    }
+
+    void printResult(const char* name, const sf::Clock& clock, int count)
+    {
+        double milliseconds = static_cast<double>(clock.getElapsedTime().asMicroseconds()) / 1000.0 / count;
+        std::cout << std::left << std::setw(40) << name << std::right << std::setw(10)
+                  << std::fixed << std::setprecision(3) << milliseconds << std::endl;
+    }
+
+    // Center of the view for a frame, scrolling diagonally across the map
+    sf::Vector2f getScrollCenter(int frame, float speed)
+    {
+        float offset = 960.f + static_cast<float>(frame) * speed;
+        return sf::Vector2f(offset, offset * 0.75f);
+    }
+
+    void drawFrame(sf::RenderTexture& target, const sf::TileMap& map)
+    {
+        target.clear();
+        target.draw(map);
+        target.display();
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+/// Entry point of application
+///
+/// \return Application exit code
+///
+////////////////////////////////////////////////////////////
+int main()
+{
+    // The map is drawn to a 1080p render texture: the frames include the submission to OpenGL
+    sf::RenderTexture target;
+    if (!target.create(1920, 1080))
+        return EXIT_FAILURE;
+
+    // A tileset of 16x16 tiles of 16x16 pixels
+    sf::Image image;
+    image.create(256, 256);
+    for (unsigned int y = 0; y < 256; ++y)
+        for (unsigned int x = 0; x < 256; ++x)
+            image.setPixel(x, y, sf::Color(static_cast<sf::Uint8>(x), static_cast<sf::Uint8>(y), static_cast<sf::Uint8>(x ^ y)));
+
+    sf::Texture tileset;
+    if (!tileset.loadFromImage(image))
+        return EXIT_FAILURE;
+
+    std::vector<sf::IntRect> water;
+    for (int i = 0; i < 4; ++i)
+        water.push_back(sf::IntRect(i * 16, 240, 16, 16));
+
+    std::cout << mapSize << "x" << mapSize << " tiles, 2 layers, 1920x1080 view" << std::endl;
+    std::cout << std::left << std::setw(40) << "workload" << std::right << std::setw(10) << "ms" << std::endl;
+
+    // Filling the whole map, tile by tile
+    sf::TileMap map;
+    sf::Clock clock;
+    map.create(sf::Vector2u(mapSize, mapSize), sf::Vector2u(tileSize, tileSize), 2);
+    map.setTexture(tileset);
+    map.setAnimation(1, water, sf::milliseconds(100));
+    for (unsigned int y = 0; y < mapSize; ++y)
+    {
+        for (unsigned int x = 0; x < mapSize; ++x)
+        {
+            map.setTile(x, y, getGround(x, y), 0);
+            map.setTile(x, y, getDecoration(x, y), 1);
+        }
+    }
+    printResult("fill the map", clock, 1);
+
+    sf::View view(getScrollCenter(0, 0.f), sf::Vector2f(1920.f, 1080.f));
+    target.setView(view);
+
+    // First frame: the visible chunks are built
+    clock.restart();
+    drawFrame(target, map);
+    printResult("first frame", clock, 1);
+
+    // Still view: the chunks are only drawn
+    clock.restart();
+    for (int i = 0; i < frames; ++i)
+        drawFrame(target, map);
+    printResult("still view, per frame", clock, frames);
+
+    // Still view with the water animation
+    clock.restart();
+    for (int i = 0; i < frames; ++i)
+    {
+        map.update(sf::milliseconds(16));
+        drawFrame(target, map);
+    }
+    printResult("animated water, per frame", clock, frames);
+
+    // Scrolling: the chunks that enter the view are built, the old ones are released
+    const float speeds[] = {4.f, 32.f};
+    for (std::size_t s = 0; s < sizeof(speeds) / sizeof(*speeds); ++s)
+    {
+        clock.restart();
+        for (int i = 0; i < frames; ++i)
+        {
+            view.setCenter(getScrollCenter(i, speeds[s]));
+            target.setView(view);
+            drawFrame(target, map);
+        }
+        printResult(speeds[s] < 10.f ? "scroll 4 px, per frame" : "scroll 32 px, per frame", clock, frames);
+    }
+
+    // Editing: changed tiles rebuild their chunk when it's drawn, other chunks don't cost anything
+    view.setCenter(getScrollCenter(0, 0.f));
+    target.setView(view);
+    drawFrame(target, map);
+
+    const unsigned int editCounts[] = {10, 1000};
+    for (std::size_t e = 0; e < sizeof(editCounts) / sizeof(*editCounts); ++e)
+    {
+        clock.restart();
+        for (int i = 0; i < frames; ++i)
+        {
+            for (unsigned int j = 0; j < editCounts[e]; ++j)
+                map.setTile(getRandom(1920 / tileSize), getRandom(1080 / tileSize), 2 + getRandom(200), 0);
+            drawFrame(target, map);
+        }
+        printResult(editCounts[e] < 100 ? "edit 10 visible tiles, per frame" : "edit 1000 visible tiles, per frame", clock, frames);
+    }
+
+    clock.restart();
+    for (int i = 0; i < frames; ++i)
+    {
+        for (unsigned int j = 0; j < 1000; ++j)
+            map.setTile(getRandom(mapSize), getRandom(mapSize), 2 + getRandom(200), 0);
+        drawFrame(target, map);
+    }
+    printResult("edit 1000 tiles anywhere, per frame", clock, frames);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,249 @@
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <GlCallCounter.hpp>
+#include <SFML/Config.hpp>
+
+#if defined(SFML_SYSTEM_LINUX) && !defined(SFML_OPENGL_ES)
+
+    #include <cstring>
+    #include <dlfcn.h>
+
+    #define SFML_COUNT_GL_CALLS
+
+#endif
+
+
+namespace
+{
+    std::size_t callCount = 0;
+}
+
+
+#ifdef SFML_COUNT_GL_CALLS
+
+////////////////////////////////////////////////////////////
+// The core functions are linked directly by the graphics
+// module: the definitions below take precedence over the
+// ones of libGL, count the call and forward it to the
+// original function. The OpenGL headers are not included,
+// so that these definitions don't clash with their
+// declarations.
+////////////////////////////////////////////////////////////
+namespace
+{
+    typedef unsigned int   GLenum;
+    typedef unsigned int   GLbitfield;
+    typedef unsigned int   GLuint;
+    typedef int            GLint;
+    typedef int            GLsizei;
+    typedef unsigned char  GLboolean;
+    typedef float          GLfloat;
+    typedef float          GLclampf;
+    typedef unsigned int   GLhandleARB;
+    typedef char           GLcharARB;
+    typedef std::ptrdiff_t GLintptr;
+    typedef std::ptrdiff_t GLsizeiptr;
+
+    typedef void (*FunctionPointer)();
+
+    // Find the function that a definition of this file replaces; libGL
+    // is opened explicitly in case nothing else made the program load it
+    void* getOriginal(const char* name)
+    {
+        void* function = dlsym(RTLD_NEXT, name);
+        if (!function)
+        {
+            static void* library = dlopen("libGL.so.1", RTLD_LAZY | RTLD_GLOBAL);
+            if (library)
+                function = dlsym(library, name);
+        }
+
+        return function;
+    }
+}
+
+#define SFML_COUNTED_GL_FUNCTION(ReturnType, name, parameters, arguments)                              \
+    extern "C" ReturnType name parameters                                                              \
+    {                                                                                                  \
+        typedef ReturnType (*Function) parameters;                                                     \
+        static Function function = reinterpret_cast<Function>(getOriginal(#name));                     \
+        ++callCount;                                                                                   \
+        return function arguments;                                                                     \
+    }
+
+SFML_COUNTED_GL_FUNCTION(void, glBindTexture, (GLenum target, GLuint texture), (target, texture))
+SFML_COUNTED_GL_FUNCTION(void, glBlendFunc, (GLenum source, GLenum destination), (source, destination))
+SFML_COUNTED_GL_FUNCTION(void, glClear, (GLbitfield mask), (mask))
+SFML_COUNTED_GL_FUNCTION(void, glClearColor, (GLclampf red, GLclampf green, GLclampf blue, GLclampf alpha), (red, green, blue, alpha))
+SFML_COUNTED_GL_FUNCTION(void, glColorPointer, (GLint size, GLenum type, GLsizei stride, const void* pointer), (size, type, stride, pointer))
+SFML_COUNTED_GL_FUNCTION(void, glDisable, (GLenum capability), (capability))
+SFML_COUNTED_GL_FUNCTION(void, glDisableClientState, (GLenum array), (array))
+SFML_COUNTED_GL_FUNCTION(void, glDrawArrays, (GLenum mode, GLint first, GLsizei count), (mode, first, count))
+SFML_COUNTED_GL_FUNCTION(void, glEnable, (GLenum capability), (capability))
+SFML_COUNTED_GL_FUNCTION(void, glEnableClientState, (GLenum array), (array))
+SFML_COUNTED_GL_FUNCTION(void, glFlush, (), ())
+SFML_COUNTED_GL_FUNCTION(void, glGetIntegerv, (GLenum name, GLint* values), (name, values))
+SFML_COUNTED_GL_FUNCTION(void, glLoadIdentity, (), ())
+SFML_COUNTED_GL_FUNCTION(void, glLoadMatrixf, (const GLfloat* matrix), (matrix))
+SFML_COUNTED_GL_FUNCTION(void, glMatrixMode, (GLenum mode), (mode))
+SFML_COUNTED_GL_FUNCTION(void, glPopMatrix, (), ())
+SFML_COUNTED_GL_FUNCTION(void, glPushMatrix, (), ())
+SFML_COUNTED_GL_FUNCTION(void, glTexCoordPointer, (GLint size, GLenum type, GLsizei stride, const void* pointer), (size, type, stride, pointer))
+SFML_COUNTED_GL_FUNCTION(void, glTexParameteri, (GLenum target, GLenum name, GLint value), (target, name, value))
+SFML_COUNTED_GL_FUNCTION(void, glTexSubImage2D, (GLenum target, GLint level, GLint x, GLint y, GLsizei width, GLsizei height, GLenum format, GLenum type, const void* pixels), (target, level, x, y, width, height, format, type, pixels))
+SFML_COUNTED_GL_FUNCTION(void, glVertexPointer, (GLint size, GLenum type, GLsizei stride, const void* pointer), (size, type, stride, pointer))
+SFML_COUNTED_GL_FUNCTION(void, glViewport, (GLint x, GLint y, GLsizei width, GLsizei height), (x, y, width, height))
+
+
+////////////////////////////////////////////////////////////
+// The extension functions are loaded by the window module
+// through glXGetProcAddressARB: it is replaced to return a
+// counting wrapper, which forwards the call to the function
+// that the original one returned
+////////////////////////////////////////////////////////////
+#define SFML_COUNTED_GL_EXTENSION(ReturnType, name, parameters, arguments)                             \
+    FunctionPointer name##Original = 0;                                                                \
+    ReturnType name##Counted parameters                                                                \
+    {                                                                                                  \
+        typedef ReturnType (*Function) parameters;                                                     \
+        ++callCount;                                                                                   \
+        return reinterpret_cast<Function>(name##Original) arguments;                                   \
+    }
+
+namespace
+{
+    SFML_COUNTED_GL_EXTENSION(void, glActiveTextureARB, (GLenum texture), (texture))
+    SFML_COUNTED_GL_EXTENSION(void, glClientActiveTextureARB, (GLenum texture), (texture))
+    SFML_COUNTED_GL_EXTENSION(void, glBlendEquationEXT, (GLenum mode), (mode))
+    SFML_COUNTED_GL_EXTENSION(void, glBlendEquationSeparateEXT, (GLenum modeRgb, GLenum modeAlpha), (modeRgb, modeAlpha))
+    SFML_COUNTED_GL_EXTENSION(void, glBlendFuncSeparateEXT, (GLenum sourceRgb, GLenum destinationRgb, GLenum sourceAlpha, GLenum destinationAlpha), (sourceRgb, destinationRgb, sourceAlpha, destinationAlpha))
+    SFML_COUNTED_GL_EXTENSION(void, glBindBufferARB, (GLenum target, GLuint buffer), (target, buffer))
+    SFML_COUNTED_GL_EXTENSION(void, glBufferDataARB, (GLenum target, GLsizeiptr size, const void* data, GLenum usage), (target, size, data, usage))
+    SFML_COUNTED_GL_EXTENSION(void, glBufferSubDataARB, (GLenum target, GLintptr offset, GLsizeiptr size, const void* data), (target, offset, size, data))
+    SFML_COUNTED_GL_EXTENSION(void*, glMapBufferARB, (GLenum target, GLenum access), (target, access))
+    SFML_COUNTED_GL_EXTENSION(GLboolean, glUnmapBufferARB, (GLenum target), (target))
+    SFML_COUNTED_GL_EXTENSION(GLhandleARB, glGetHandleARB, (GLenum name), (name))
+    SFML_COUNTED_GL_EXTENSION(void, glUseProgramObjectARB, (GLhandleARB program), (program))
+    SFML_COUNTED_GL_EXTENSION(GLint, glGetUniformLocationARB, (GLhandleARB program, const GLcharARB* name), (program, name))
+    SFML_COUNTED_GL_EXTENSION(void, glUniform1fARB, (GLint location, GLfloat x), (location, x))
+    SFML_COUNTED_GL_EXTENSION(void, glUniform2fARB, (GLint location, GLfloat x, GLfloat y), (location, x, y))
+    SFML_COUNTED_GL_EXTENSION(void, glUniform3fARB, (GLint location, GLfloat x, GLfloat y, GLfloat z), (location, x, y, z))
+    SFML_COUNTED_GL_EXTENSION(void, glUniform4fARB, (GLint location, GLfloat x, GLfloat y, GLfloat z, GLfloat w), (location, x, y, z, w))
+    SFML_COUNTED_GL_EXTENSION(void, glUniform1iARB, (GLint location, GLint x), (location, x))
+    SFML_COUNTED_GL_EXTENSION(void, glUniform2iARB, (GLint location, GLint x, GLint y), (location, x, y))
+    SFML_COUNTED_GL_EXTENSION(void, glUniform3iARB, (GLint location, GLint x, GLint y, GLint z), (location, x, y, z))
+    SFML_COUNTED_GL_EXTENSION(void, glUniform4iARB, (GLint location, GLint x, GLint y, GLint z, GLint w), (location, x, y, z, w))
+    SFML_COUNTED_GL_EXTENSION(void, glUniform1fvARB, (GLint location, GLsizei count, const GLfloat* values), (location, count, values))
+    SFML_COUNTED_GL_EXTENSION(void, glUniform2fvARB, (GLint location, GLsizei count, const GLfloat* values), (location, count, values))
+    SFML_COUNTED_GL_EXTENSION(void, glUniform3fvARB, (GLint location, GLsizei count, const GLfloat* values), (location, count, values))
+    SFML_COUNTED_GL_EXTENSION(void, glUniform4fvARB, (GLint location, GLsizei count, const GLfloat* values), (location, count, values))
+    SFML_COUNTED_GL_EXTENSION(void, glUniformMatrix3fvARB, (GLint location, GLsizei count, GLboolean transpose, const GLfloat* values), (location, count, transpose, values))
+    SFML_COUNTED_GL_EXTENSION(void, glUniformMatrix4fvARB, (GLint location, GLsizei count, GLboolean transpose, const GLfloat* values), (location, count, transpose, values))
+    SFML_COUNTED_GL_EXTENSION(void, glVertexAttribPointerARB, (GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const void* pointer), (index, size, type, normalized, stride, pointer))
+    SFML_COUNTED_GL_EXTENSION(void, glEnableVertexAttribArrayARB, (GLuint index), (index))
+    SFML_COUNTED_GL_EXTENSION(void, glDisableVertexAttribArrayARB, (GLuint index), (index))
+    SFML_COUNTED_GL_EXTENSION(void, glVertexAttribDivisorARB, (GLuint index, GLuint divisor), (index, divisor))
+    SFML_COUNTED_GL_EXTENSION(void, glDrawArraysInstancedARB, (GLenum mode, GLint first, GLsizei count, GLsizei instances), (mode, first, count, instances))
+    SFML_COUNTED_GL_EXTENSION(void, glBindFramebufferEXT, (GLenum target, GLuint framebuffer), (target, framebuffer))
+    SFML_COUNTED_GL_EXTENSION(void, glBindRenderbufferEXT, (GLenum target, GLuint renderbuffer), (target, renderbuffer))
+    SFML_COUNTED_GL_EXTENSION(void, glFramebufferTexture2DEXT, (GLenum target, GLenum attachment, GLenum textureTarget, GLuint texture, GLint level), (target, attachment, textureTarget, texture, level))
+    SFML_COUNTED_GL_EXTENSION(void, glGenerateMipmapEXT, (GLenum target), (target))
+
+    struct Extension
+    {
+        const char*      name;
+        FunctionPointer* original;
+        FunctionPointer  counted;
+    };
+
+    #define SFML_GL_EXTENSION_ENTRY(name) {#name, &name##Original, reinterpret_cast<FunctionPointer>(&name##Counted)}
+
+    const Extension extensions[] =
+    {
+        SFML_GL_EXTENSION_ENTRY(glActiveTextureARB),
+        SFML_GL_EXTENSION_ENTRY(glClientActiveTextureARB),
+        SFML_GL_EXTENSION_ENTRY(glBlendEquationEXT),
+        SFML_GL_EXTENSION_ENTRY(glBlendEquationSeparateEXT),
+        SFML_GL_EXTENSION_ENTRY(glBlendFuncSeparateEXT),
+        SFML_GL_EXTENSION_ENTRY(glBindBufferARB),
+        SFML_GL_EXTENSION_ENTRY(glBufferDataARB),
+        SFML_GL_EXTENSION_ENTRY(glBufferSubDataARB),
+        SFML_GL_EXTENSION_ENTRY(glMapBufferARB),
+        SFML_GL_EXTENSION_ENTRY(glUnmapBufferARB),
+        SFML_GL_EXTENSION_ENTRY(glGetHandleARB),
+        SFML_GL_EXTENSION_ENTRY(glUseProgramObjectARB),
+        SFML_GL_EXTENSION_ENTRY(glGetUniformLocationARB),
+        SFML_GL_EXTENSION_ENTRY(glUniform1fARB),
+        SFML_GL_EXTENSION_ENTRY(glUniform2fARB),
+        SFML_GL_EXTENSION_ENTRY(glUniform3fARB),
+        SFML_GL_EXTENSION_ENTRY(glUniform4fARB),
+        SFML_GL_EXTENSION_ENTRY(glUniform1iARB),
+        SFML_GL_EXTENSION_ENTRY(glUniform2iARB),
+        SFML_GL_EXTENSION_ENTRY(glUniform3iARB),
+        SFML_GL_EXTENSION_ENTRY(glUniform4iARB),
+        SFML_GL_EXTENSION_ENTRY(glUniform1fvARB),
+        SFML_GL_EXTENSION_ENTRY(glUniform2fvARB),
+        SFML_GL_EXTENSION_ENTRY(glUniform3fvARB),
+        SFML_GL_EXTENSION_ENTRY(glUniform4fvARB),
+        SFML_GL_EXTENSION_ENTRY(glUniformMatrix3fvARB),
+        SFML_GL_EXTENSION_ENTRY(glUniformMatrix4fvARB),
+        SFML_GL_EXTENSION_ENTRY(glVertexAttribPointerARB),
+        SFML_GL_EXTENSION_ENTRY(glEnableVertexAttribArrayARB),
+        SFML_GL_EXTENSION_ENTRY(glDisableVertexAttribArrayARB),
+        SFML_GL_EXTENSION_ENTRY(glVertexAttribDivisorARB),
+        SFML_GL_EXTENSION_ENTRY(glDrawArraysInstancedARB),
+        SFML_GL_EXTENSION_ENTRY(glBindFramebufferEXT),
+        SFML_GL_EXTENSION_ENTRY(glBindRenderbufferEXT),
+        SFML_GL_EXTENSION_ENTRY(glFramebufferTexture2DEXT),
+        SFML_GL_EXTENSION_ENTRY(glGenerateMipmapEXT)
+    };
+}
+
+extern "C" FunctionPointer glXGetProcAddressARB(const unsigned char* name)
+{
+    typedef FunctionPointer (*Function)(const unsigned char*);
+    static Function function = reinterpret_cast<Function>(getOriginal("glXGetProcAddressARB"));
+
+    FunctionPointer original = function(name);
+    if (!original)
+        return original;
+
+    for (std::size_t i = 0; i < sizeof(extensions) / sizeof(*extensions); ++i)
+    {
+        if (std::strcmp(reinterpret_cast<const char*>(name), extensions[i].name) == 0)
+        {
+            *extensions[i].original = original;
+            return extensions[i].counted;
+        }
+    }
+
+    return original;
+}
+
+#endif // SFML_COUNT_GL_CALLS
+
+
+////////////////////////////////////////////////////////////
+bool isGlCallCountAvailable()
+{
+#ifdef SFML_COUNT_GL_CALLS
+    return true;
+#else
+    return false;
+#endif
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t getGlCallCount()
+{
+    return callCount;
+}
+
+
+////////////////////////////////////////////////////////////
+void resetGlCallCount()
+{
+    callCount = 0;
+}
@@ -0,0 +1,39 @@
+#ifndef SFML_GLCALLCOUNTER_HPP
+#define SFML_GLCALLCOUNTER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <cstddef>
+
+
+////////////////////////////////////////////////////////////
+/// Tell whether the OpenGL calls can be counted
+///
+/// The calls are counted by interposing the OpenGL entry
+/// points, which is only implemented on Linux with desktop
+/// OpenGL; elsewhere the count stays at 0.
+///
+////////////////////////////////////////////////////////////
+bool isGlCallCountAvailable();
+
+////////////////////////////////////////////////////////////
+/// Get the number of OpenGL calls made by the program
+/// since the last reset
+///
+/// Only the functions used while drawing are counted:
+/// state changes and queries, binds, uniforms, buffer
+/// updates and draws. Resource creation and deletion are
+/// not counted, nor the glGetError calls made by the checks
+/// of debug builds.
+///
+////////////////////////////////////////////////////////////
+std::size_t getGlCallCount();
+
+////////////////////////////////////////////////////////////
+/// Reset the number of OpenGL calls to 0
+///
+////////////////////////////////////////////////////////////
+void resetGlCallCount();
+
+#endif // SFML_GLCALLCOUNTER_HPP
@@ -0,0 +1,276 @@
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/CompressedImage.hpp>
+#include <SFML/System/MemoryInputStream.hpp>
+#include <TestUtilities.hpp>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+
+namespace
+{
+    void writeUint32(std::vector<sf::Uint8>& file, sf::Uint32 value)
+    {
+        for (int i = 0; i < 4; ++i)
+            file.push_back(static_cast<sf::Uint8>(value >> (i * 8)));
+    }
+
+    // Build a little-endian KTX file; each level holds the given data
+    std::vector<sf::Uint8> createKtx(unsigned int format, unsigned int width, unsigned int height, sf::Uint32 levelCount, const std::vector<sf::Uint8>& level)
+    {
+        static const sf::Uint8 identifier[12] = {0xAB, 'K', 'T', 'X', ' ', '1', '1', 0xBB, '\r', '\n', 0x1A, '\n'};
+        std::vector<sf::Uint8> file(identifier, identifier + 12);
+
+        const sf::Uint32 fields[13] = {0x04030201, 0, 1, 0, format, 0x1908, width, height, 0, 0, 1, levelCount, 0};
+        for (int i = 0; i < 13; ++i)
+            writeUint32(file, fields[i]);
+
+        for (sf::Uint32 i = 0; (i < levelCount) && (i < 16); ++i)
+        {
+            writeUint32(file, static_cast<sf::Uint32>(level.size()));
+            file.insert(file.end(), level.begin(), level.end());
+            file.resize((file.size() + 3) & ~static_cast<std::size_t>(3), 0);
+        }
+
+        return file;
+    }
+
+    // Build a DDS file with the DXT1 format
+    std::vector<sf::Uint8> createDds(unsigned int width, unsigned int height, sf::Uint32 levelCount, const std::vector<sf::Uint8>& data)
+    {
+        std::vector<sf::Uint8> file(128, 0);
+        std::memcpy(&file[0], "DDS ", 4);
+
+        const sf::Uint32 fields[][2] =
+        {
+            {4, 124}, {8, 0x20000}, {12, height}, {16, width}, {28, levelCount}, {80, 0x4}, {84, 0x31545844}
+        };
+        for (std::size_t i = 0; i < sizeof(fields) / sizeof(*fields); ++i)
+        {
+            for (int j = 0; j < 4; ++j)
+                file[fields[i][0] + j] = static_cast<sf::Uint8>(fields[i][1] >> (j * 8));
+        }
+
+        file.insert(file.end(), data.begin(), data.end());
+        return file;
+    }
+
+    bool load(const std::vector<sf::Uint8>& file, sf::priv::CompressedImage& image)
+    {
+        sf::MemoryInputStream stream;
+        stream.open(&file[0], file.size());
+        return sf::priv::loadCompressedImage(stream, image);
+    }
+
+    // Load a 4x4 image made of a single block, and decompress it
+    std::vector<sf::Uint8> decodeBlock(unsigned int format, const std::vector<sf::Uint8>& block)
+    {
+        sf::priv::CompressedImage image;
+        std::vector<sf::Uint8> pixels;
+        if (CHECK(load(createKtx(format, 4, 4, 1, block), image)))
+            CHECK(sf::priv::decompressImage(image, 0, pixels) && (pixels.size() == 4 * 4 * 4));
+
+        pixels.resize(4 * 4 * 4);
+        return pixels;
+    }
+
+    // Check the color of a texel, reporting it if it's wrong
+    bool checkTexel(const std::vector<sf::Uint8>& pixels, unsigned int x, unsigned int y, int r, int g, int b, int a = 255)
+    {
+        const sf::Uint8* texel = &pixels[(y * 4 + x) * 4];
+        bool equal = (texel[0] == r) && (texel[1] == g) && (texel[2] == b) && (texel[3] == a);
+        if (!equal)
+        {
+            std::cerr << "texel (" << x << ", " << y << ") is (" << int(texel[0]) << ", " << int(texel[1]) << ", " << int(texel[2]) << ", " << int(texel[3])
+                      << "), expected (" << r << ", " << g << ", " << b << ", " << a << ")" << std::endl;
+        }
+
+        return CHECK(equal);
+    }
+
+    // A BC1 color block; the indices of each row are 0, 1, 2, 3 from left to right
+    std::vector<sf::Uint8> createDxtColorBlock(sf::Uint16 color0, sf::Uint16 color1)
+    {
+        sf::Uint8 block[8] =
+        {
+            static_cast<sf::Uint8>(color0), static_cast<sf::Uint8>(color0 >> 8),
+            static_cast<sf::Uint8>(color1), static_cast<sf::Uint8>(color1 >> 8),
+            0xE4, 0xE4, 0xE4, 0xE4
+        };
+
+        return std::vector<sf::Uint8>(block, block + 8);
+    }
+
+    // An ETC block, given as its two big-endian words
+    std::vector<sf::Uint8> createEtcBlock(sf::Uint32 high, sf::Uint32 low)
+    {
+        std::vector<sf::Uint8> block;
+        for (int i = 3; i >= 0; --i)
+            block.push_back(static_cast<sf::Uint8>(high >> (i * 8)));
+        for (int i = 3; i >= 0; --i)
+            block.push_back(static_cast<sf::Uint8>(low >> (i * 8)));
+
+        return block;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+/// Entry point of application
+///
+/// \return Application exit code
+///
+////////////////////////////////////////////////////////////
+int main()
+{
+    using namespace sf::priv;
+
+    const std::vector<sf::Uint8> dxt1Block = createDxtColorBlock(0xF800, 0x001F);
+
+    // Valid files load
+    {
+        CompressedImage image;
+        CHECK(load(createKtx(CompressedRgbDxt1, 4, 4, 1, dxt1Block), image));
+        CHECK((image.format == CompressedRgbDxt1) && (image.size == sf::Vector2u(4, 4)) && (image.levels.size() == 1));
+
+        CHECK(load(createDds(4, 4, 3, std::vector<sf::Uint8>(3 * 8, 0)), image));
+        CHECK((image.format == CompressedRgbaDxt1) && (image.levels.size() == 3));
+    }
+
+    // Truncated files are rejected
+    {
+        CompressedImage image;
+        std::vector<sf::Uint8> file = createKtx(CompressedRgbDxt1, 4, 4, 1, dxt1Block);
+
+        std::vector<sf::Uint8> truncated(file.begin(), file.begin() + 40);
+        CHECK(!load(truncated, image));
+
+        truncated.assign(file.begin(), file.end() - 1);
+        CHECK(!load(truncated, image));
+
+        // The level is smaller than its size says
+        truncated = createKtx(CompressedRgbDxt1, 4, 4, 1, std::vector<sf::Uint8>(dxt1Block.begin(), dxt1Block.begin() + 4));
+        CHECK(!load(truncated, image));
+
+        // The second level is missing
+        truncated = createKtx(CompressedRgbDxt1, 8, 8, 1, std::vector<sf::Uint8>(4 * 8, 0));
+        truncated[12 + 11 * 4] = 2;
+        CHECK(!load(truncated, image));
+
+        truncated = createDds(8, 8, 4, std::vector<sf::Uint8>(4 * 8 + 8 + 8 + 7, 0));
+        CHECK(!load(truncated, image));
+
+        truncated = createDds(4, 4, 1, std::vector<sf::Uint8>());
+        truncated.resize(100);
+        CHECK(!load(truncated, image));
+    }
+
+    // Level counts above the ones of a complete chain are rejected, before anything is allocated
+    {
+        CompressedImage image;
+        CHECK(!load(createKtx(CompressedRgbDxt1, 4, 4, 4, dxt1Block), image));
+        CHECK(!load(createKtx(CompressedRgbDxt1, 4, 4, 0xFFFFFFFF, dxt1Block), image));
+        CHECK(!load(createDds(4, 4, 4, std::vector<sf::Uint8>(4 * 8, 0)), image));
+        CHECK(!load(createDds(4, 4, 0xFFFFFFFF, std::vector<sf::Uint8>(4 * 8, 0)), image));
+    }
+
+    // BC1 with color0 > color1: 4 opaque colors
+    {
+        const std::vector<sf::Uint8> decoded[] = {decodeBlock(CompressedRgbDxt1, dxt1Block), decodeBlock(CompressedRgbaDxt1, dxt1Block)};
+        for (int i = 0; i < 2; ++i)
+        {
+            checkTexel(decoded[i], 0, 0, 255, 0, 0);
+            checkTexel(decoded[i], 1, 1, 0, 0, 255);
+            checkTexel(decoded[i], 2, 2, 170, 0, 85);
+            checkTexel(decoded[i], 3, 3, 85, 0, 170);
+        }
+    }
+
+    // BC1 with color0 <= color1: 3 colors and black, transparent only in the RGBA variant
+    {
+        const std::vector<sf::Uint8> block = createDxtColorBlock(0x001F, 0xF800);
+
+        std::vector<sf::Uint8> pixels = decodeBlock(CompressedRgbDxt1, block);
+        checkTexel(pixels, 0, 0, 0, 0, 255);
+        checkTexel(pixels, 1, 0, 255, 0, 0);
+        checkTexel(pixels, 2, 0, 127, 0, 127);
+        checkTexel(pixels, 3, 0, 0, 0, 0, 255);
+
+        pixels = decodeBlock(CompressedRgbaDxt1, block);
+        checkTexel(pixels, 2, 0, 127, 0, 127);
+        checkTexel(pixels, 3, 0, 0, 0, 0, 0);
+
+        // The color blocks of BC2 always use 4 colors; the alphas are 0, 1, 2, ... 15 (x17)
+        std::vector<sf::Uint8> dxt3Block;
+        for (int i = 0; i < 8; ++i)
+            dxt3Block.push_back(static_cast<sf::Uint8>((i * 2) | ((i * 2 + 1) << 4)));
+        dxt3Block.insert(dxt3Block.end(), block.begin(), block.end());
+
+        pixels = decodeBlock(CompressedRgbaDxt3, dxt3Block);
+        checkTexel(pixels, 0, 0, 0, 0, 255, 0);
+        checkTexel(pixels, 2, 0, 85, 0, 170, 34);
+        checkTexel(pixels, 3, 0, 170, 0, 85, 51);
+        checkTexel(pixels, 3, 3, 170, 0, 85, 255);
+    }
+
+    // ETC1, individual mode: both sub-blocks 0x88 with table 0 (+2, +8); texel (0, 0) uses index 1, the others index 0
+    const std::vector<sf::Uint8> etcIndividual = createEtcBlock(0x88888800, 0x00000001);
+    {
+        std::vector<sf::Uint8> pixels = decodeBlock(CompressedRgbEtc1, etcIndividual);
+        checkTexel(pixels, 0, 0, 144, 144, 144);
+        checkTexel(pixels, 1, 0, 138, 138, 138);
+        checkTexel(pixels, 3, 3, 138, 138, 138);
+
+        // Index 2 and 3 subtract the modifiers: texel (1, 0) uses index 3
+        pixels = decodeBlock(CompressedRgbEtc1, createEtcBlock(0x88888800, 0x00100010));
+        checkTexel(pixels, 1, 0, 128, 128, 128);
+    }
+
+    // ETC1, differential mode: 16 (132) and 16 + 1 (140), table 0 (+2), left and right halves
+    {
+        const sf::Uint32 high = (16u << 27) | (1u << 24) | (16u << 19) | (1u << 16) | (16u << 11) | (1u << 8) | 2u;
+        std::vector<sf::Uint8> pixels = decodeBlock(CompressedRgbEtc1, createEtcBlock(high, 0));
+        checkTexel(pixels, 0, 0, 134, 134, 134);
+        checkTexel(pixels, 1, 3, 134, 134, 134);
+        checkTexel(pixels, 2, 0, 142, 142, 142);
+        checkTexel(pixels, 3, 3, 142, 142, 142);
+
+        // Flipped: top and bottom halves
+        pixels = decodeBlock(CompressedRgbEtc1, createEtcBlock(high | 1, 0));
+        checkTexel(pixels, 3, 1, 134, 134, 134);
+        checkTexel(pixels, 0, 2, 142, 142, 142);
+    }
+
+    // EAC alpha: base 128, multiplier 1, table 0; index 4 (+2) everywhere but texel (0, 0), index 7 (+14)
+    {
+        sf::Uint64 indices = 0;
+        for (int j = 0; j < 16; ++j)
+            indices |= static_cast<sf::Uint64>(j == 0 ? 7 : 4) << (45 - j * 3);
+
+        std::vector<sf::Uint8> block;
+        block.push_back(128);
+        block.push_back(0x10);
+        for (int i = 5; i >= 0; --i)
+            block.push_back(static_cast<sf::Uint8>(indices >> (i * 8)));
+        block.insert(block.end(), etcIndividual.begin(), etcIndividual.end());
+
+        std::vector<sf::Uint8> pixels = decodeBlock(CompressedRgbaEtc2, block);
+        checkTexel(pixels, 0, 0, 144, 144, 144, 142);
+        checkTexel(pixels, 1, 0, 138, 138, 138, 130);
+        checkTexel(pixels, 3, 3, 138, 138, 138, 130);
+    }
+
+    // Images smaller than a block keep the texels inside them
+    {
+        CompressedImage image;
+        std::vector<sf::Uint8> pixels;
+        CHECK(load(createKtx(CompressedRgbDxt1, 2, 1, 1, dxt1Block), image));
+        CHECK(decompressImage(image, 0, pixels));
+        CHECK((pixels.size() == 2 * 4) && (pixels[0] == 255) && (pixels[6] == 255));
+    }
+
+    return getExitCode();
+}
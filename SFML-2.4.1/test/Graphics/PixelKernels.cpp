@@ -0,0 +1,346 @@
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/PixelKernels.hpp>
+#include <TestUtilities.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+
+namespace
+{
+    // Small deterministic generator, so that the data is the same on every platform
+    unsigned int seed = 1;
+    unsigned int getRandom()
+    {
+        seed = seed * 1103515245 + 12345;
+        return (seed >> 16) & 0x7FFF;
+    }
+
+    // Random pixels; a third of the alphas are 0 or 255, which the kernels may handle apart
+    std::vector<sf::Uint8> getRandomPixels(std::size_t count)
+    {
+        std::vector<sf::Uint8> pixels(count * 4 + 1);
+        for (std::size_t i = 0; i < pixels.size(); ++i)
+            pixels[i] = static_cast<sf::Uint8>(getRandom());
+
+        for (std::size_t i = 3; i < count * 4; i += 4)
+        {
+            switch (getRandom() % 6)
+            {
+                case 0: pixels[i] = 0;   break;
+                case 1: pixels[i] = 255; break;
+                default: break;
+            }
+        }
+
+        return pixels;
+    }
+
+    // The kernels are run on odd offsets of the buffers, so that the vector loads are not aligned
+    sf::Uint8* unaligned(std::vector<sf::Uint8>& pixels)
+    {
+        return &pixels[1];
+    }
+
+    const char* getName(sf::priv::PixelInstructionSet instructionSet)
+    {
+        switch (instructionSet)
+        {
+            case sf::priv::PixelSse2: return "SSE2";
+            case sf::priv::PixelAvx2: return "AVX2";
+            case sf::priv::PixelNeon: return "NEON";
+            default:                  return "scalar";
+        }
+    }
+
+    // Run a kernel with an instruction set, then with the scalar code, and check that the results are identical
+    template <typename Kernel>
+    void compare(sf::priv::PixelInstructionSet instructionSet, Kernel kernel, const char* name)
+    {
+        // Every count up to a few vector widths (remainders), then larger ones
+        for (std::size_t count = 0; count < 300; count += (count < 70) ? 1 : 37)
+        {
+            seed = static_cast<unsigned int>(count) + 1;
+            std::vector<sf::Uint8> vector = getRandomPixels(count);
+            std::vector<sf::Uint8> other = getRandomPixels(count);
+            std::vector<sf::Uint8> scalar = vector;
+            std::vector<sf::Uint8> scalarOther = other;
+
+            sf::priv::setPixelInstructionSet(instructionSet);
+            kernel(vector, other, count);
+            sf::priv::setPixelInstructionSet(sf::priv::PixelScalar);
+            kernel(scalar, scalarOther, count);
+
+            if (!CHECK((vector == scalar) && (other == scalarOther)))
+            {
+                std::cerr << "  " << name << " with " << getName(instructionSet) << " differs from the scalar code for "
+                          << count << " pixels" << std::endl;
+                return;
+            }
+        }
+    }
+
+    void fill(std::vector<sf::Uint8>& pixels, std::vector<sf::Uint8>& other, std::size_t count)
+    {
+        sf::priv::fillPixels(unaligned(pixels), count, &other[0]);
+    }
+
+    void blend(std::vector<sf::Uint8>& pixels, std::vector<sf::Uint8>& other, std::size_t count)
+    {
+        sf::priv::blendPixels(unaligned(pixels), unaligned(other), count);
+    }
+
+    void modulate(std::vector<sf::Uint8>& pixels, std::vector<sf::Uint8>& other, std::size_t count)
+    {
+        sf::priv::modulatePixels(unaligned(pixels), count, &other[0]);
+    }
+
+    void interpolate(std::vector<sf::Uint8>& pixels, std::vector<sf::Uint8>& other, std::size_t)
+    {
+        // Gradients that overshoot on both ends, and land on halves
+        const float color[] = {-20.f, 0.5f, 300.f, 127.5f};
+        const float step[] = {0.75f + other[0] / 256.f, 2.5f, -1.25f, 0.f};
+        sf::priv::interpolatePixels(unaligned(pixels), (pixels.size() - 1) / 4, color, step);
+    }
+
+    void mask(std::vector<sf::Uint8>& pixels, std::vector<sf::Uint8>& other, std::size_t count)
+    {
+        // Make a few pixels match the key
+        const sf::Uint8 key[] = {10, 20, 30, 40};
+        for (std::size_t i = 0; i < count; i += 3)
+        {
+            for (int c = 0; c < 4; ++c)
+                unaligned(pixels)[i * 4 + c] = key[c];
+        }
+
+        sf::priv::maskPixels(unaligned(pixels), count, key, other[0]);
+    }
+
+    void reverse(std::vector<sf::Uint8>& pixels, std::vector<sf::Uint8>&, std::size_t count)
+    {
+        sf::priv::reversePixels(unaligned(pixels), count);
+    }
+
+    void swap(std::vector<sf::Uint8>& pixels, std::vector<sf::Uint8>& other, std::size_t count)
+    {
+        sf::priv::swapBytes(unaligned(pixels), unaligned(other), count * 4 - (count > 0 ? 1 : 0));
+    }
+
+    // The images are count pixels wide, and 3 rows high (an odd height)
+    void downsample(std::vector<sf::Uint8>& pixels, std::vector<sf::Uint8>& other, std::size_t count, bool kaiser, bool sRgb)
+    {
+        unsigned int width = static_cast<unsigned int>(count / 3);
+        if (width == 0)
+            return;
+
+        if (kaiser)
+            sf::priv::downsampleKaiser(unaligned(pixels), width, 3, unaligned(other), sRgb);
+        else
+            sf::priv::downsampleBox(unaligned(pixels), width, 3, unaligned(other), sRgb);
+    }
+
+    void downsampleBox(std::vector<sf::Uint8>& pixels, std::vector<sf::Uint8>& other, std::size_t count)
+    {
+        downsample(pixels, other, count, false, false);
+    }
+
+    void downsampleBoxSrgb(std::vector<sf::Uint8>& pixels, std::vector<sf::Uint8>& other, std::size_t count)
+    {
+        downsample(pixels, other, count, false, true);
+    }
+
+    void downsampleKaiser(std::vector<sf::Uint8>& pixels, std::vector<sf::Uint8>& other, std::size_t count)
+    {
+        downsample(pixels, other, count, true, true);
+    }
+
+    // Exact conversions between sRGB and linear components, the references of the mipmap kernels
+    double toLinear(int value)
+    {
+        double component = value / 255.0;
+        return (component <= 0.04045) ? component / 12.92 : std::pow((component + 0.055) / 1.055, 2.4);
+    }
+
+    int toSrgb(double linear)
+    {
+        double component = (linear <= 0.0031308) ? linear * 12.92 : 1.055 * std::pow(linear, 1.0 / 2.4) - 0.055;
+        return static_cast<int>(component * 255.0 + 0.5);
+    }
+
+    // Check the components of a downsampled image against reference values
+    bool checkComponents(const std::vector<sf::Uint8>& actual, const std::vector<int>& expected, int tolerance, const char* name)
+    {
+        for (std::size_t i = 0; i < expected.size(); ++i)
+        {
+            if (std::abs(actual[i] - expected[i]) > tolerance)
+            {
+                std::cerr << "  " << name << ": component " << i << " is " << int(actual[i]) << ", expected " << expected[i] << std::endl;
+                return CHECK(false);
+            }
+        }
+
+        return true;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+/// Entry point of application
+///
+/// \return Application exit code
+///
+////////////////////////////////////////////////////////////
+int main()
+{
+    sf::priv::PixelInstructionSet best = sf::priv::getPixelInstructionSet();
+    CHECK(sf::priv::isPixelInstructionSetSupported(best));
+    CHECK(sf::priv::isPixelInstructionSetSupported(sf::priv::PixelScalar));
+
+    // The scalar code follows the documented formulas
+    {
+        sf::priv::setPixelInstructionSet(sf::priv::PixelScalar);
+        for (int i = 0; i < 1000; ++i)
+        {
+            std::vector<sf::Uint8> destination = getRandomPixels(1);
+            std::vector<sf::Uint8> source = getRandomPixels(1);
+            std::vector<sf::Uint8> expected = destination;
+
+            int alpha = source[3];
+            for (int c = 0; c < 3; ++c)
+                expected[c] = static_cast<sf::Uint8>((source[c] * alpha + destination[c] * (255 - alpha)) / 255);
+            expected[3] = static_cast<sf::Uint8>(alpha + destination[3] * (255 - alpha) / 255);
+
+            sf::priv::blendPixels(&destination[0], &source[0], 1);
+            if (!CHECK(destination == expected))
+                break;
+        }
+    }
+
+    // Every vector instruction set gives exactly the results of the scalar code
+    const sf::priv::PixelInstructionSet instructionSets[] = {sf::priv::PixelSse2, sf::priv::PixelAvx2, sf::priv::PixelNeon};
+    for (std::size_t i = 0; i < sizeof(instructionSets) / sizeof(*instructionSets); ++i)
+    {
+        sf::priv::PixelInstructionSet instructionSet = instructionSets[i];
+        if (!sf::priv::isPixelInstructionSetSupported(instructionSet))
+        {
+            std::cout << getName(instructionSet) << " is not supported, skipped" << std::endl;
+            continue;
+        }
+
+        compare(instructionSet, fill, "fillPixels");
+        compare(instructionSet, blend, "blendPixels");
+        compare(instructionSet, modulate, "modulatePixels");
+        compare(instructionSet, interpolate, "interpolatePixels");
+        compare(instructionSet, mask, "maskPixels");
+        compare(instructionSet, reverse, "reversePixels");
+        compare(instructionSet, swap, "swapBytes");
+        compare(instructionSet, downsampleBox, "downsampleBox");
+        compare(instructionSet, downsampleBoxSrgb, "downsampleBox (sRGB)");
+        compare(instructionSet, downsampleKaiser, "downsampleKaiser (sRGB)");
+    }
+
+    // The mipmap kernels give the reference results, with the best instruction set
+    sf::priv::setPixelInstructionSet(best);
+    {
+        // Box filter on a 7x5 image: the last column and row are repeated
+        const unsigned int width = 7;
+        const unsigned int height = 5;
+        seed = 7;
+        std::vector<sf::Uint8> source = getRandomPixels(width * height);
+        std::vector<sf::Uint8> destination(3 * 2 * 4);
+        std::vector<int> linear;
+        std::vector<int> sRgb;
+        for (unsigned int y = 0; y < 2; ++y)
+        {
+            for (unsigned int x = 0; x < 3; ++x)
+            {
+                for (unsigned int c = 0; c < 4; ++c)
+                {
+                    unsigned int rows[] = {y * 2, std::min(y * 2 + 1, height - 1)};
+                    unsigned int columns[] = {x * 2, std::min(x * 2 + 1, width - 1)};
+                    int sum = 0;
+                    double linearSum = 0.0;
+                    for (int i = 0; i < 4; ++i)
+                    {
+                        int value = source[(rows[i / 2] * width + columns[i % 2]) * 4 + c];
+                        sum += value;
+                        linearSum += toLinear(value);
+                    }
+
+                    linear.push_back((sum + 2) / 4);
+                    sRgb.push_back((c < 3) ? toSrgb(linearSum / 4) : (sum + 2) / 4);
+                }
+            }
+        }
+
+        sf::priv::downsampleBox(&source[0], width, height, &destination[0], false);
+        checkComponents(destination, linear, 0, "downsampleBox");
+
+        // The sRGB conversions use tables, which may be one step away from the exact values
+        sf::priv::downsampleBox(&source[0], width, height, &destination[0], true);
+        checkComponents(destination, sRgb, 1, "downsampleBox (sRGB)");
+
+        // Black and white average to the middle gray of the linear space, not to 128
+        const sf::Uint8 checker[] = {0, 0, 0, 255, 255, 255, 255, 255, 255, 255, 255, 255, 0, 0, 0, 255};
+        sf::priv::downsampleBox(checker, 2, 2, &destination[0], true);
+        checkComponents(destination, std::vector<int>(3, toSrgb(0.5)), 0, "downsampleBox (sRGB)");
+    }
+    {
+        // Kaiser filter on a step edge, along a row then along a column; the negative lobes
+        // sharpen the edge, and the overshoot on both sides is clamped
+        std::vector<sf::Uint8> source(12 * 4, 255);
+        for (std::size_t i = 0; i < 6 * 4; ++i)
+            source[i] = (i % 4 == 3) ? 255 : 0;
+
+        const int linear[] = {0, 0, 19, 236, 255, 255};
+        const int sRgb[] = {0, 0, 77, 247, 255, 255};
+        std::vector<int> linearComponents;
+        std::vector<int> sRgbComponents;
+        for (int i = 0; i < 6; ++i)
+        {
+            linearComponents.insert(linearComponents.end(), 3, linear[i]);
+            linearComponents.push_back(255);
+            sRgbComponents.insert(sRgbComponents.end(), 3, sRgb[i]);
+            sRgbComponents.push_back(255);
+        }
+
+        std::vector<sf::Uint8> destination(6 * 4);
+        for (int vertical = 0; vertical < 2; ++vertical)
+        {
+            unsigned int width = vertical ? 1 : 12;
+            unsigned int height = vertical ? 12 : 1;
+            sf::priv::downsampleKaiser(&source[0], width, height, &destination[0], false);
+            checkComponents(destination, linearComponents, 0, "downsampleKaiser");
+            sf::priv::downsampleKaiser(&source[0], width, height, &destination[0], true);
+            checkComponents(destination, sRgbComponents, 1, "downsampleKaiser (sRGB)");
+        }
+
+        // A uniform image stays uniform
+        std::vector<sf::Uint8> uniform(8 * 8 * 4);
+        for (std::size_t i = 0; i < uniform.size(); ++i)
+            uniform[i] = (i % 4 == 3) ? 200 : 77;
+        std::vector<int> expected(uniform.begin(), uniform.begin() + 4 * 4 * 4);
+        destination.resize(4 * 4 * 4);
+        sf::priv::downsampleKaiser(&uniform[0], 8, 8, &destination[0], false);
+        checkComponents(destination, expected, 0, "downsampleKaiser");
+        sf::priv::downsampleKaiser(&uniform[0], 8, 8, &destination[0], true);
+        checkComponents(destination, expected, 1, "downsampleKaiser (sRGB)");
+    }
+
+    // Unsupported instruction sets are ignored
+    sf::priv::setPixelInstructionSet(best);
+    for (std::size_t i = 0; i < sizeof(instructionSets) / sizeof(*instructionSets); ++i)
+    {
+        if (!sf::priv::isPixelInstructionSetSupported(instructionSets[i]))
+        {
+            sf::priv::setPixelInstructionSet(instructionSets[i]);
+            CHECK(sf::priv::getPixelInstructionSet() == best);
+        }
+    }
+
+    return getExitCode();
+}
@@ -0,0 +1,185 @@
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics.hpp>
+#include <TestUtilities.hpp>
+#include <algorithm>
+#include <vector>
+
+
+namespace
+{
+    // Draw i covers the row i and the column i of the target, so the
+    // pixels (i, j) and (j, i) show which of draws i and j ran last
+    const unsigned int drawCount = 16;
+
+    // Blend modes that all overwrite the destination with an opaque color: they
+    // make different states for the queue, but only the order of the draws matters
+    const unsigned int blendModeCount = 3;
+    sf::BlendMode getBlendMode(unsigned int index)
+    {
+        switch (index)
+        {
+            case 0:  return sf::BlendNone;
+            case 1:  return sf::BlendAlpha;
+            default: return sf::BlendMode(sf::BlendMode::SrcAlpha, sf::BlendMode::Zero);
+        }
+    }
+
+    struct Draw
+    {
+        unsigned int index;
+        int          layer;
+        unsigned int blendMode;
+        float        depth;
+    };
+
+    // The order documented by sf::RenderQueue: layer, then the states in
+    // order of their first use, then depth; equal draws keep their order
+    struct ExecutionOrder
+    {
+        unsigned int rank[blendModeCount];
+
+        bool operator ()(const Draw& left, const Draw& right) const
+        {
+            if (left.layer != right.layer)
+                return left.layer < right.layer;
+            if (left.blendMode != right.blendMode)
+                return rank[left.blendMode] < rank[right.blendMode];
+            return left.depth < right.depth;
+        }
+    };
+
+    // Small deterministic generator, so that the draws are the same on every platform
+    unsigned int seed = 1;
+    unsigned int getRandom(unsigned int range)
+    {
+        seed = seed * 1103515245 + 12345;
+        return (seed >> 16) % range;
+    }
+
+    sf::Color getColor(unsigned int index)
+    {
+        return sf::Color(static_cast<sf::Uint8>(index * 16), static_cast<sf::Uint8>(255 - index * 16), 128);
+    }
+
+    std::size_t countChanges(const std::vector<Draw>& draws)
+    {
+        std::size_t changes = 0;
+        for (std::size_t i = 1; i < draws.size(); ++i)
+        {
+            if (draws[i].blendMode != draws[i - 1].blendMode)
+                ++changes;
+        }
+
+        return changes;
+    }
+
+    void testRound(sf::RenderQueue& queue, sf::SoftwareRenderTarget& target)
+    {
+        const float size = static_cast<float>(drawCount);
+
+        // Submit draws with random layers, states and depths
+        std::vector<Draw> draws(drawCount);
+        queue.clear();
+        for (unsigned int i = 0; i < drawCount; ++i)
+        {
+            Draw& draw = draws[i];
+            draw.index     = i;
+            draw.layer     = static_cast<int>(getRandom(3)) - 1;
+            draw.blendMode = getRandom(blendModeCount);
+            draw.depth     = static_cast<float>(getRandom(3)) / 2.f;
+
+            const float position = static_cast<float>(i);
+            const sf::Color color = getColor(i);
+            sf::Vertex vertices[8] =
+            {
+                sf::Vertex(sf::Vector2f(0.f, position), color),
+                sf::Vertex(sf::Vector2f(size, position), color),
+                sf::Vertex(sf::Vector2f(size, position + 1.f), color),
+                sf::Vertex(sf::Vector2f(0.f, position + 1.f), color),
+                sf::Vertex(sf::Vector2f(position, 0.f), color),
+                sf::Vertex(sf::Vector2f(position + 1.f, 0.f), color),
+                sf::Vertex(sf::Vector2f(position + 1.f, size), color),
+                sf::Vertex(sf::Vector2f(position, size), color)
+            };
+
+            queue.add(vertices, 8, sf::Quads, sf::RenderStates(getBlendMode(draw.blendMode)), draw.layer, draw.depth);
+        }
+
+        CHECK(queue.getCommandCount() == drawCount);
+
+        // Compute the expected order of execution
+        ExecutionOrder order;
+        std::fill(order.rank, order.rank + blendModeCount, drawCount);
+        for (unsigned int i = 0, used = 0; i < drawCount; ++i)
+        {
+            if (order.rank[draws[i].blendMode] == drawCount)
+                order.rank[draws[i].blendMode] = used++;
+        }
+
+        std::vector<Draw> executed = draws;
+        std::stable_sort(executed.begin(), executed.end(), order);
+
+        std::vector<unsigned int> position(drawCount);
+        for (unsigned int i = 0; i < drawCount; ++i)
+            position[executed[i].index] = i;
+
+        // Execute the queue, and check every pair of draws
+        target.clear(sf::Color::Black);
+        target.draw(queue);
+        target.display();
+
+        const sf::Image& image = target.getImage();
+        for (unsigned int i = 0; i < drawCount; ++i)
+        {
+            for (unsigned int j = 0; j < drawCount; ++j)
+            {
+                unsigned int last = (position[i] > position[j]) ? i : j;
+                CHECK_COLOR(image.getPixel(i, j), getColor(last));
+            }
+        }
+
+        // The draws that share their states are merged, and the changes are counted in both orders
+        sf::RenderQueue::Statistics statistics = queue.getStatistics();
+        CHECK(statistics.commandCount == drawCount);
+        CHECK(statistics.stateChanges == countChanges(executed));
+        CHECK(statistics.batchCount == countChanges(executed) + 1);
+        CHECK(statistics.submissionStateChanges == countChanges(draws));
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+/// Entry point of application
+///
+/// \return Application exit code
+///
+////////////////////////////////////////////////////////////
+int main()
+{
+    sf::SoftwareRenderTarget target;
+    if (!CHECK(target.create(drawCount, drawCount)))
+        return getExitCode();
+
+    sf::RenderQueue queue;
+    for (int round = 0; round < 100; ++round)
+        testRound(queue, target);
+
+    // Drawing a queue again executes the same draws
+    sf::Image first = target.getImage();
+    target.clear(sf::Color::Black);
+    target.draw(queue);
+    target.display();
+    CHECK(std::equal(first.getPixelsPtr(), first.getPixelsPtr() + drawCount * drawCount * 4, target.getImage().getPixelsPtr()));
+
+    // An empty queue draws nothing
+    queue.clear();
+    CHECK(queue.getCommandCount() == 0);
+    target.clear(sf::Color::Black);
+    target.draw(queue);
+    target.display();
+    CHECK_COLOR(target.getImage().getPixel(0, 0), sf::Color::Black);
+
+    return getExitCode();
+}
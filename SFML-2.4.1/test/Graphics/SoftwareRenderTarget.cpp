@@ -0,0 +1,413 @@
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics.hpp>
+#include <TestUtilities.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+
+namespace
+{
+    // Colors of the golden images: '.' is the clear color, '#' the drawn one
+    const sf::Color background(0, 0, 0);
+    const sf::Color foreground(200, 100, 50);
+
+    // Check a rendered image against a golden image, given row by row
+    void checkGolden(const sf::Image& image, const char* const* rows, const sf::Color& drawn, int line)
+    {
+        sf::Vector2u size = image.getSize();
+        for (unsigned int y = 0; y < size.y; ++y)
+        {
+            for (unsigned int x = 0; x < size.x; ++x)
+            {
+                sf::Color expected = (rows[y][x] == '#') ? drawn : background;
+                if (!checkColor(image.getPixel(x, y), expected, "pixel of golden image", __FILE__, line))
+                {
+                    std::cerr << "  at (" << x << ", " << y << ")" << std::endl;
+                    return;
+                }
+            }
+        }
+    }
+
+    void render(sf::SoftwareRenderTarget& target, const sf::Drawable& drawable, const sf::RenderStates& states = sf::RenderStates::Default)
+    {
+        target.clear(background);
+        target.draw(drawable, states);
+        target.display();
+    }
+
+    sf::VertexArray makeRectangle(float left, float top, float width, float height, const sf::Color& color)
+    {
+        sf::VertexArray rectangle(sf::Quads, 4);
+        rectangle[0] = sf::Vertex(sf::Vector2f(left, top), color);
+        rectangle[1] = sf::Vertex(sf::Vector2f(left + width, top), color);
+        rectangle[2] = sf::Vertex(sf::Vector2f(left + width, top + height), color);
+        rectangle[3] = sf::Vertex(sf::Vector2f(left, top + height), color);
+        return rectangle;
+    }
+
+    // Small deterministic generator, so that the scenes are the same on every platform
+    unsigned int seed = 1;
+    float getRandom(float first, float last)
+    {
+        seed = seed * 1103515245 + 12345;
+        return first + (last - first) * static_cast<float>((seed >> 16) & 0x7FFF) / 32767.f;
+    }
+
+    ////////////////////////////////////////////////////////////
+    void testTriangles(sf::SoftwareRenderTarget& target)
+    {
+        // Two triangles sharing a horizontal edge through the pixel centers of row 5:
+        // the row belongs to the lower triangle only (top-left rule), so a translucent
+        // color is blended once everywhere
+        const sf::Color translucent(255, 255, 255, 128);
+        sf::VertexArray triangles(sf::Triangles, 6);
+        triangles[0] = sf::Vertex(sf::Vector2f(0.f, 1.5f), translucent);
+        triangles[1] = sf::Vertex(sf::Vector2f(8.f, 5.5f), translucent);
+        triangles[2] = sf::Vertex(sf::Vector2f(0.f, 5.5f), translucent);
+        triangles[3] = sf::Vertex(sf::Vector2f(0.f, 5.5f), translucent);
+        triangles[4] = sf::Vertex(sf::Vector2f(8.f, 5.5f), translucent);
+        triangles[5] = sf::Vertex(sf::Vector2f(8.f, 7.5f), translucent);
+
+        const char* golden[] =
+        {
+            "........",
+            "........",
+            "##......",
+            "####....",
+            "######..",
+            "########",
+            "....####",
+            "........"
+        };
+
+        render(target, triangles);
+        checkGolden(target.getImage(), golden, sf::Color(128, 128, 128), __LINE__);
+
+        // The same triangles, drawn separately and in the other order
+        target.clear(background);
+        target.draw(&triangles[3], 3, sf::Triangles);
+        target.draw(&triangles[0], 3, sf::Triangles);
+        target.display();
+        checkGolden(target.getImage(), golden, sf::Color(128, 128, 128), __LINE__);
+
+        // A horizontal top edge through the pixel centers of the first row of a tile:
+        // the row is inside, the rows above it (in the previous tile) are not
+        sf::SoftwareRenderTarget tall;
+        tall.create(4, 80);
+        sf::VertexArray triangle(sf::Triangles, 3);
+        triangle[0] = sf::Vertex(sf::Vector2f(0.f, 64.5f), foreground);
+        triangle[1] = sf::Vertex(sf::Vector2f(40.f, 64.5f), foreground);
+        triangle[2] = sf::Vertex(sf::Vector2f(0.f, 80.f), foreground);
+        render(tall, triangle);
+        CHECK_COLOR(tall.getImage().getPixel(0, 63), background);
+        CHECK_COLOR(tall.getImage().getPixel(0, 64), foreground);
+        CHECK_COLOR(tall.getImage().getPixel(3, 70), foreground);
+
+        // The same triangle upside down: the bottom edge of the first tile is outside
+        triangle[0].position = sf::Vector2f(0.f, 63.5f);
+        triangle[1].position = sf::Vector2f(0.f, 40.f);
+        triangle[2].position = sf::Vector2f(40.f, 63.5f);
+        render(tall, triangle);
+        CHECK_COLOR(tall.getImage().getPixel(0, 62), foreground);
+        CHECK_COLOR(tall.getImage().getPixel(0, 63), background);
+        CHECK_COLOR(tall.getImage().getPixel(0, 64), background);
+    }
+
+    ////////////////////////////////////////////////////////////
+    void testRectangles(sf::SoftwareRenderTarget& target)
+    {
+        // Pixels are covered if their center is inside, the right and bottom sides are outside
+        sf::RectangleShape rectangle(sf::Vector2f(4.f, 3.f));
+        rectangle.setPosition(1.5f, 2.25f);
+        rectangle.setFillColor(foreground);
+
+        const char* golden[] =
+        {
+            "........",
+            "........",
+            ".####...",
+            ".####...",
+            ".####...",
+            "........",
+            "........",
+            "........"
+        };
+
+        render(target, rectangle);
+        checkGolden(target.getImage(), golden, foreground, __LINE__);
+
+        // A rectangle that is not axis-aligned is two triangles: a square turned into
+        // a diamond covers the pixels at less than 3.2 (Manhattan distance) from its center
+        rectangle.setSize(sf::Vector2f(4.5255f, 4.5255f));
+        rectangle.setOrigin(2.26274f, 2.26274f);
+        rectangle.setPosition(4.f, 4.f);
+        rectangle.setRotation(45.f);
+
+        const char* rotated[] =
+        {
+            "........",
+            "...##...",
+            "..####..",
+            ".######.",
+            ".######.",
+            "..####..",
+            "...##...",
+            "........"
+        };
+
+        render(target, rectangle);
+        checkGolden(target.getImage(), rotated, foreground, __LINE__);
+    }
+
+    ////////////////////////////////////////////////////////////
+    void testLinesAndPoints(sf::SoftwareRenderTarget& target)
+    {
+        // Lines are quads one pixel wide, points are squares of one pixel
+        sf::VertexArray primitives(sf::Lines, 4);
+        primitives[0] = sf::Vertex(sf::Vector2f(1.f, 6.5f), foreground);
+        primitives[1] = sf::Vertex(sf::Vector2f(6.f, 6.5f), foreground);
+        primitives[2] = sf::Vertex(sf::Vector2f(0.5f, 0.f), foreground);
+        primitives[3] = sf::Vertex(sf::Vector2f(0.5f, 4.f), foreground);
+        sf::Vertex point(sf::Vector2f(6.5f, 1.5f), foreground);
+
+        const char* golden[] =
+        {
+            "#.......",
+            "#.....#.",
+            "#.......",
+            "#.......",
+            "........",
+            "........",
+            ".#####..",
+            "........"
+        };
+
+        target.clear(background);
+        target.draw(primitives);
+        target.draw(&point, 1, sf::Points);
+        target.display();
+        checkGolden(target.getImage(), golden, foreground, __LINE__);
+
+        // Strips and fans are drawn like the triangles they're made of
+        sf::VertexArray strip(sf::LineStrip, 3);
+        strip[0] = sf::Vertex(sf::Vector2f(1.f, 1.5f), foreground);
+        strip[1] = sf::Vertex(sf::Vector2f(6.5f, 1.5f), foreground);
+        strip[2] = sf::Vertex(sf::Vector2f(6.5f, 8.f), foreground);
+        sf::VertexArray fan(sf::TriangleFan, 4);
+        fan[0] = sf::Vertex(sf::Vector2f(1.f, 3.f), foreground);
+        fan[1] = sf::Vertex(sf::Vector2f(4.f, 3.f), foreground);
+        fan[2] = sf::Vertex(sf::Vector2f(4.f, 6.f), foreground);
+        fan[3] = sf::Vertex(sf::Vector2f(1.f, 6.f), foreground);
+
+        const char* strips[] =
+        {
+            "........",
+            ".######.",
+            "......#.",
+            ".###..#.",
+            ".###..#.",
+            ".###..#.",
+            "......#.",
+            "......#."
+        };
+
+        target.clear(background);
+        target.draw(strip);
+        target.draw(fan);
+        target.display();
+        checkGolden(target.getImage(), strips, foreground, __LINE__);
+    }
+
+    ////////////////////////////////////////////////////////////
+    void testView(sf::SoftwareRenderTarget& target)
+    {
+        // The view maps (0, 0, 16, 16) to the target, the viewport restricts drawing to its right half
+        sf::View view(sf::FloatRect(0.f, 0.f, 16.f, 16.f));
+        view.setViewport(sf::FloatRect(0.5f, 0.f, 0.5f, 1.f));
+        target.setView(view);
+
+        const char* golden[] =
+        {
+            "........",
+            "....###.",
+            "....###.",
+            "........",
+            "........",
+            "........",
+            "........",
+            "........"
+        };
+
+        render(target, makeRectangle(-8.f, 2.f, 20.f, 4.f, foreground));
+        checkGolden(target.getImage(), golden, foreground, __LINE__);
+
+        target.setView(target.getDefaultView());
+    }
+
+    ////////////////////////////////////////////////////////////
+    void testBlending(sf::SoftwareRenderTarget& target)
+    {
+        sf::VertexArray rectangle = makeRectangle(0.f, 0.f, 8.f, 8.f, sf::Color(100, 60, 20, 255));
+
+        // Additive blending accumulates
+        target.clear(background);
+        target.draw(rectangle, sf::BlendAdd);
+        target.draw(rectangle, sf::BlendAdd);
+        target.display();
+        CHECK_COLOR(target.getImage().getPixel(3, 3), sf::Color(200, 120, 40));
+
+        // Multiplicative blending scales the destination
+        target.clear(sf::Color(255, 128, 0));
+        target.draw(rectangle, sf::BlendMultiply);
+        target.display();
+        CHECK_COLOR(target.getImage().getPixel(3, 3), sf::Color(100, 30, 0));
+
+        // No blending copies the source, alpha included
+        rectangle = makeRectangle(0.f, 0.f, 8.f, 8.f, sf::Color(10, 20, 30, 40));
+        target.clear(sf::Color::White);
+        target.draw(rectangle, sf::BlendNone);
+        target.display();
+        CHECK_COLOR(target.getImage().getPixel(3, 3), sf::Color(10, 20, 30, 40));
+
+        // Alpha blending mixes the source and the destination by the source alpha
+        rectangle = makeRectangle(0.f, 0.f, 8.f, 8.f, sf::Color(255, 0, 0, 51));
+        target.clear(sf::Color(0, 0, 255));
+        target.draw(rectangle, sf::BlendAlpha);
+        target.display();
+        CHECK_COLOR(target.getImage().getPixel(3, 3), sf::Color(51, 0, 204));
+    }
+
+    ////////////////////////////////////////////////////////////
+    void testGradients(sf::SoftwareRenderTarget& target)
+    {
+        // Colors are interpolated at the pixel centers
+        sf::VertexArray gradient = makeRectangle(0.f, 0.f, 8.f, 8.f, sf::Color::Black);
+        gradient[1].color = sf::Color(255, 0, 0);
+        gradient[2].color = sf::Color(255, 0, 255);
+        gradient[3].color = sf::Color(0, 0, 255);
+
+        render(target, gradient);
+        const sf::Image& image = target.getImage();
+        int maxError = 0;
+        for (unsigned int y = 0; y < 8; ++y)
+        {
+            for (unsigned int x = 0; x < 8; ++x)
+            {
+                sf::Color pixel = image.getPixel(x, y);
+                int red  = static_cast<int>(255.f * (x + 0.5f) / 8.f + 0.5f);
+                int blue = static_cast<int>(255.f * (y + 0.5f) / 8.f + 0.5f);
+                maxError = std::max(maxError, std::abs(pixel.r - red));
+                maxError = std::max(maxError, std::abs(pixel.b - blue));
+                CHECK(pixel.g == 0);
+            }
+        }
+
+        CHECK(maxError <= 1);
+    }
+
+    ////////////////////////////////////////////////////////////
+    void testSharedEdges()
+    {
+        // Two different triangulations of random convex polygons must cover the
+        // same pixels, exactly once: shared edges leave neither gaps nor overlaps
+        sf::SoftwareRenderTarget first;
+        sf::SoftwareRenderTarget second;
+        first.create(100, 100);
+        second.create(100, 100);
+
+        const sf::Color increment(1, 1, 1);
+        for (int polygon = 0; polygon < 50; ++polygon)
+        {
+            std::vector<float> angles(12);
+            for (std::size_t i = 0; i < angles.size(); ++i)
+                angles[i] = getRandom(0.f, 6.2831853f);
+            std::sort(angles.begin(), angles.end());
+
+            sf::Vector2f center(getRandom(30.f, 70.f), getRandom(30.f, 70.f));
+            sf::Vector2f radius(getRandom(10.f, 45.f), getRandom(10.f, 45.f));
+            std::vector<sf::Vertex> points;
+            for (std::size_t i = 0; i < angles.size(); ++i)
+            {
+                sf::Vector2f point(center.x + radius.x * std::cos(angles[i]), center.y + radius.y * std::sin(angles[i]));
+                points.push_back(sf::Vertex(point, increment));
+            }
+
+            // A fan from the first point, and a fan from the middle point
+            std::vector<sf::Vertex> other(points.begin() + points.size() / 2, points.end());
+            other.insert(other.end(), points.begin(), points.begin() + points.size() / 2);
+
+            first.clear(background);
+            first.draw(&points[0], points.size(), sf::TriangleFan, sf::BlendAdd);
+            first.display();
+            second.clear(background);
+            second.draw(&other[0], other.size(), sf::TriangleFan, sf::BlendAdd);
+            second.display();
+
+            const sf::Uint8* pixels = first.getImage().getPixelsPtr();
+            CHECK(std::equal(pixels, pixels + 100 * 100 * 4, second.getImage().getPixelsPtr()));
+
+            bool once = true;
+            for (std::size_t i = 0; i < 100 * 100 * 4; i += 4)
+                once = once && (pixels[i] <= 1);
+            CHECK(once);
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    void testThreads()
+    {
+        // The tiles are rendered in submission order: the thread count doesn't change the result
+        sf::VertexArray triangles(sf::Triangles);
+        for (int i = 0; i < 3000; ++i)
+        {
+            sf::Color color(static_cast<sf::Uint8>(getRandom(0.f, 255.f)), static_cast<sf::Uint8>(getRandom(0.f, 255.f)),
+                            static_cast<sf::Uint8>(getRandom(0.f, 255.f)), static_cast<sf::Uint8>(getRandom(0.f, 255.f)));
+            sf::Vector2f position(getRandom(-20.f, 300.f), getRandom(-20.f, 220.f));
+            for (int j = 0; j < 3; ++j)
+                triangles.append(sf::Vertex(position + sf::Vector2f(getRandom(-30.f, 30.f), getRandom(-30.f, 30.f)), color));
+        }
+
+        sf::SoftwareRenderTarget single;
+        sf::SoftwareRenderTarget multiple;
+        single.create(283, 197);
+        multiple.create(283, 197);
+        single.setThreadCount(1);
+        multiple.setThreadCount(4);
+
+        render(single, triangles);
+        render(multiple, triangles);
+
+        const sf::Uint8* pixels = single.getImage().getPixelsPtr();
+        CHECK(std::equal(pixels, pixels + 283 * 197 * 4, multiple.getImage().getPixelsPtr()));
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+/// Entry point of application
+///
+/// \return Application exit code
+///
+////////////////////////////////////////////////////////////
+int main()
+{
+    sf::SoftwareRenderTarget target;
+    if (!CHECK(target.create(8, 8)))
+        return getExitCode();
+
+    testTriangles(target);
+    testRectangles(target);
+    testLinesAndPoints(target);
+    testView(target);
+    testBlending(target);
+    testGradients(target);
+    testSharedEdges();
+    testThreads();
+
+    return getExitCode();
+}
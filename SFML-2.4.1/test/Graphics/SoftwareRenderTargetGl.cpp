@@ -0,0 +1,169 @@
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics.hpp>
+#include <TestUtilities.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <string>
+
+
+namespace
+{
+    const unsigned int width  = 160;
+    const unsigned int height = 120;
+
+    // Small deterministic generator, so that the scenes are the same on every platform
+    unsigned int seed = 1;
+    float getRandom(float first, float last)
+    {
+        seed = seed * 1103515245 + 12345;
+        return first + (last - first) * static_cast<float>((seed >> 16) & 0x7FFF) / 32767.f;
+    }
+
+    // Render a drawable with OpenGL and on the CPU, and compare the images. OpenGL
+    // doesn't fully specify rasterization and filtering: channels may differ by a
+    // few units, and a few pixels on the edges may be covered differently
+    void compare(sf::RenderTexture& reference, sf::SoftwareRenderTarget& target, const sf::Drawable& drawable,
+                 const sf::RenderStates& states, const std::string& name)
+    {
+        reference.clear(sf::Color(30, 60, 90));
+        reference.draw(drawable, states);
+        reference.display();
+        sf::Image expected = reference.getTexture().copyToImage();
+
+        target.clear(sf::Color(30, 60, 90));
+        target.draw(drawable, states);
+        target.display();
+        const sf::Image& actual = target.getImage();
+
+        unsigned int different = 0;
+        for (unsigned int y = 0; y < height; ++y)
+        {
+            for (unsigned int x = 0; x < width; ++x)
+            {
+                sf::Color a = actual.getPixel(x, y);
+                sf::Color b = expected.getPixel(x, y);
+                int difference = std::max(std::max(std::abs(a.r - b.r), std::abs(a.g - b.g)),
+                                          std::max(std::abs(a.b - b.b), std::abs(a.a - b.a)));
+                if (difference > 3)
+                    ++different;
+            }
+        }
+
+        if (!CHECK(different <= width * height / 200))
+        {
+            std::cerr << "  " << name << ": " << different << " pixels differ" << std::endl;
+            expected.saveToFile(name + "-gl.png");
+            actual.saveToFile(name + "-software.png");
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+/// Entry point of application
+///
+/// \return Application exit code
+///
+////////////////////////////////////////////////////////////
+int main()
+{
+    // The reference images are rendered by OpenGL: this test needs a context
+    sf::RenderTexture reference;
+    if (!CHECK(reference.create(width, height)))
+        return getExitCode();
+
+    sf::SoftwareRenderTarget target;
+    if (!CHECK(target.create(width, height)))
+        return getExitCode();
+
+    // A texture with sharp details, for the filtering and wrapping modes
+    sf::Image image;
+    image.create(16, 16);
+    for (unsigned int y = 0; y < 16; ++y)
+    {
+        for (unsigned int x = 0; x < 16; ++x)
+        {
+            sf::Uint8 checker = ((x + y) % 2) ? 255 : 0;
+            image.setPixel(x, y, sf::Color(static_cast<sf::Uint8>(x * 16), static_cast<sf::Uint8>(y * 16), checker, static_cast<sf::Uint8>(128 + x * 8)));
+        }
+    }
+
+    sf::Texture texture;
+    if (!CHECK(texture.loadFromImage(image)))
+        return getExitCode();
+
+    // Untextured shapes: fills and outlines, convex polygons, circles
+    {
+        sf::CircleShape circle(30.f, 40);
+        circle.setPosition(10.3f, 20.7f);
+        circle.setFillColor(sf::Color(250, 120, 10));
+        circle.setOutlineColor(sf::Color(10, 200, 100, 160));
+        circle.setOutlineThickness(4.5f);
+        compare(reference, target, circle, sf::RenderStates::Default, "circle");
+
+        sf::RectangleShape rectangle(sf::Vector2f(70.f, 35.f));
+        rectangle.setPosition(80.f, 60.f);
+        rectangle.setRotation(-20.f);
+        rectangle.setFillColor(sf::Color(0, 0, 255, 100));
+        compare(reference, target, rectangle, sf::RenderStates::Default, "rectangle");
+    }
+
+    // Random triangles with gradients, in every blend mode
+    {
+        sf::VertexArray triangles(sf::Triangles);
+        for (int i = 0; i < 60 * 3; ++i)
+        {
+            sf::Color color(static_cast<sf::Uint8>(getRandom(0.f, 255.f)), static_cast<sf::Uint8>(getRandom(0.f, 255.f)),
+                            static_cast<sf::Uint8>(getRandom(0.f, 255.f)), static_cast<sf::Uint8>(getRandom(0.f, 255.f)));
+            triangles.append(sf::Vertex(sf::Vector2f(getRandom(-10.f, 170.f), getRandom(-10.f, 130.f)), color));
+        }
+
+        compare(reference, target, triangles, sf::BlendAlpha, "triangles-alpha");
+        compare(reference, target, triangles, sf::BlendAdd, "triangles-add");
+        compare(reference, target, triangles, sf::BlendMultiply, "triangles-multiply");
+        compare(reference, target, triangles, sf::BlendNone, "triangles-none");
+    }
+
+    // Lines and points
+    {
+        sf::VertexArray lines(sf::Lines);
+        sf::VertexArray points(sf::Points);
+        for (int i = 0; i < 40; ++i)
+        {
+            lines.append(sf::Vertex(sf::Vector2f(getRandom(0.f, 160.f), static_cast<float>(i * 3) + 0.5f), sf::Color::White));
+            lines.append(sf::Vertex(sf::Vector2f(getRandom(0.f, 160.f), static_cast<float>(i * 3) + 0.5f), sf::Color::Yellow));
+            points.append(sf::Vertex(sf::Vector2f(std::floor(getRandom(0.f, 160.f)) + 0.5f, std::floor(getRandom(0.f, 120.f)) + 0.5f), sf::Color::Red));
+        }
+
+        compare(reference, target, lines, sf::RenderStates::Default, "lines");
+        compare(reference, target, points, sf::RenderStates::Default, "points");
+    }
+
+    // Sprites: nearest and bilinear filtering, repeated textures, flips, rotations, views
+    {
+        sf::Sprite sprite(texture);
+        sprite.setScale(4.f, 3.f);
+        sprite.setPosition(12.f, 7.f);
+        compare(reference, target, sprite, sf::RenderStates::Default, "sprite-nearest");
+
+        texture.setSmooth(true);
+        compare(reference, target, sprite, sf::RenderStates::Default, "sprite-smooth");
+
+        texture.setRepeated(true);
+        sprite.setTextureRect(sf::IntRect(-8, 40, 40, -40));
+        sprite.setRotation(15.f);
+        compare(reference, target, sprite, sf::RenderStates::Default, "sprite-repeated");
+
+        sf::View view(sf::Vector2f(60.f, 40.f), sf::Vector2f(100.f, 80.f));
+        view.setRotation(10.f);
+        view.setViewport(sf::FloatRect(0.1f, 0.2f, 0.8f, 0.7f));
+        reference.setView(view);
+        target.setView(view);
+        compare(reference, target, sprite, sf::RenderStates::Default, "sprite-view");
+    }
+
+    return getExitCode();
+}
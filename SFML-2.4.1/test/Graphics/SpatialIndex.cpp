@@ -0,0 +1,194 @@
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics.hpp>
+#include <TestUtilities.hpp>
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+#include <vector>
+
+
+namespace
+{
+    // Small deterministic generator, so that the scenes are the same on every platform
+    unsigned int seed = 1;
+    float getRandom(float first, float last)
+    {
+        seed = seed * 1103515245 + 12345;
+        return first + (last - first) * static_cast<float>((seed >> 16) & 0x7FFF) / 32767.f;
+    }
+
+    sf::FloatRect getRandomRect(float extent, float maxSize)
+    {
+        return sf::FloatRect(getRandom(-extent, extent), getRandom(-extent, extent), getRandom(0.f, maxSize), getRandom(0.f, maxSize));
+    }
+
+    // Same test as the index: the rectangles overlap if their interiors intersect
+    bool overlap(const sf::FloatRect& a, const sf::FloatRect& b)
+    {
+        return (a.left < b.left + b.width) && (b.left < a.left + a.width) &&
+               (a.top < b.top + b.height) && (b.top < a.top + a.height);
+    }
+
+    // Check a query against a test of every live object, in insertion order
+    bool checkQuery(const sf::SpatialIndex& index, const std::vector<sf::RectangleShape>& shapes,
+                    const std::vector<sf::FloatRect>& bounds, const std::vector<bool>& alive, const sf::FloatRect& area)
+    {
+        std::vector<const sf::Drawable*> expected;
+        for (std::size_t i = 0; i < shapes.size(); ++i)
+        {
+            if (alive[i] && overlap(bounds[i], area))
+                expected.push_back(&shapes[i]);
+        }
+
+        std::vector<const sf::Drawable*> found;
+        index.query(area, found);
+        return found == expected;
+    }
+
+    // Check that an object with the given bounds is stored, found and moved without losing it
+    void checkBounds(float cellSize, const sf::FloatRect& bounds, const sf::FloatRect& area, bool visible)
+    {
+        sf::RectangleShape shape;
+        sf::SpatialIndex index(cellSize);
+        std::size_t id = index.insert(shape, bounds);
+
+        // Far objects, so that the index looks in the cells of the area instead of testing every object
+        sf::RectangleShape far;
+        for (int i = 0; i < 1000; ++i)
+            index.insert(far, sf::FloatRect(1e6f + static_cast<float>(i) * cellSize, 1e6f, 1.f, 1.f));
+
+        std::vector<const sf::Drawable*> found;
+        index.query(area, found);
+        CHECK(found.size() == (visible ? 1u : 0u));
+
+        // Back to small bounds, and again to the tested ones
+        index.update(id, sf::FloatRect(area.left, area.top, 1.f, 1.f));
+        index.query(area, found);
+        CHECK(found.size() == 1);
+
+        index.update(id, bounds);
+        index.query(area, found);
+        CHECK(found.size() == (visible ? 1u : 0u));
+
+        index.remove(id);
+        index.query(area, found);
+        CHECK(found.empty());
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+/// Entry point of application
+///
+/// \return Application exit code
+///
+////////////////////////////////////////////////////////////
+int main()
+{
+    // Random objects of every size, queried with random areas, then moved and removed
+    const float cellSizes[] = {1.f, 16.f, 256.f};
+    for (std::size_t c = 0; c < sizeof(cellSizes) / sizeof(*cellSizes); ++c)
+    {
+        const std::size_t count = 500;
+
+        sf::SpatialIndex index(cellSizes[c]);
+        std::vector<sf::RectangleShape> shapes(count);
+        std::vector<sf::FloatRect> bounds(count);
+        std::vector<bool> alive(count, true);
+        std::vector<std::size_t> ids(count);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            bounds[i] = getRandomRect(1000.f, (i % 10 == 0) ? 2000.f : 40.f);
+            ids[i] = index.insert(shapes[i], bounds[i]);
+        }
+
+        CHECK(index.getObjectCount() == count);
+        for (int i = 0; i < 50; ++i)
+            CHECK(checkQuery(index, shapes, bounds, alive, getRandomRect(1200.f, (i % 5 == 0) ? 3000.f : 100.f)));
+
+        for (std::size_t i = 0; i < count; i += 3)
+        {
+            bounds[i] = getRandomRect(1000.f, 60.f);
+            index.update(ids[i], bounds[i]);
+        }
+        for (std::size_t i = 1; i < count; i += 7)
+        {
+            alive[i] = false;
+            index.remove(ids[i]);
+        }
+
+        for (int i = 0; i < 50; ++i)
+            CHECK(checkQuery(index, shapes, bounds, alive, getRandomRect(1200.f, (i % 5 == 0) ? 3000.f : 100.f)));
+    }
+
+    // Objects read their own bounds on update
+    {
+        sf::SpatialIndex index(32.f);
+        sf::RectangleShape shape(sf::Vector2f(10.f, 10.f));
+        index.insert(shape);
+
+        std::vector<const sf::Drawable*> found;
+        index.query(sf::FloatRect(500.f, 500.f, 20.f, 20.f), found);
+        CHECK(found.empty());
+
+        shape.setPosition(505.f, 505.f);
+        index.update();
+        index.query(sf::FloatRect(500.f, 500.f, 20.f, 20.f), found);
+        CHECK(found.size() == 1);
+    }
+
+    // Bounds whose cells are too far apart for an int, or which can't be split in cells
+    {
+        const float infinity = std::numeric_limits<float>::infinity();
+        const sf::FloatRect area(-5.f, -5.f, 10.f, 10.f);
+
+        checkBounds(1.f, sf::FloatRect(-3e9f, -3e9f, 6e9f, 6e9f), area, true);
+        checkBounds(1.f, sf::FloatRect(-3e9f, -1.f, 6e9f, 2.f), area, true);
+        checkBounds(1.f, sf::FloatRect(-1e30f, -1e30f, 2e30f, 2e30f), area, true);
+        checkBounds(256.f, sf::FloatRect(-infinity, -infinity, infinity, infinity), area, false);
+        checkBounds(256.f, sf::FloatRect(0.f, 0.f, infinity, 1.f), area, true);
+        checkBounds(1.f, sf::FloatRect(0.f, 0.f, std::numeric_limits<float>::quiet_NaN(), 1.f), area, false);
+        checkBounds(1.f, sf::FloatRect(3e9f, 3e9f, 1.f, 1.f), area, false);
+
+        // Huge query areas
+        sf::SpatialIndex index(1.f);
+        sf::RectangleShape shape;
+        index.insert(shape, sf::FloatRect(1e9f, -1e9f, 1.f, 1.f));
+
+        std::vector<const sf::Drawable*> found;
+        index.query(sf::FloatRect(-3e9f, -3e9f, 6e9f, 6e9f), found);
+        CHECK(found.size() == 1);
+        index.query(sf::FloatRect(-infinity, -infinity, infinity, infinity), found);
+        CHECK(found.empty());
+    }
+
+    // Only the visible objects are drawn
+    {
+        sf::SoftwareRenderTarget target;
+        if (!CHECK(target.create(100, 100)))
+            return getExitCode();
+
+        sf::SpatialIndex index(16.f);
+        std::vector<sf::RectangleShape> shapes(100, sf::RectangleShape(sf::Vector2f(8.f, 8.f)));
+        for (std::size_t i = 0; i < shapes.size(); ++i)
+        {
+            shapes[i].setPosition(static_cast<float>(i % 10) * 50.f, static_cast<float>(i / 10) * 50.f);
+            index.insert(shapes[i]);
+        }
+
+        // The view shows the 2x2 shapes at the top left corner
+        target.clear();
+        CHECK(index.drawVisible(target, target.getView()) == 4);
+
+        sf::RenderStates states;
+        states.transform.translate(-100.f, -100.f);
+        CHECK(index.drawVisible(target, target.getView(), states) == 4);
+        target.display();
+        CHECK_COLOR(target.getImage().getPixel(3, 3), sf::Color::White);
+        CHECK_COLOR(target.getImage().getPixel(53, 53), sf::Color::White);
+    }
+
+    return getExitCode();
+}
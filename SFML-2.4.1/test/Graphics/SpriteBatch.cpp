@@ -0,0 +1,142 @@
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/SpriteExpansion.hpp>
+#include <SFML/Graphics/Transformable.hpp>
+#include <TestUtilities.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+
+namespace
+{
+    // Small deterministic generator, so that the sprites are the same on every platform
+    unsigned int seed = 1;
+    int getRandom(int first, int last)
+    {
+        seed = seed * 1103515245 + 12345;
+        return first + static_cast<int>((seed >> 16) % static_cast<unsigned int>(last - first + 1));
+    }
+
+    // Attributes of the sprites, in the same layout as sf::SpriteBatch
+    struct Sprites
+    {
+        void add(const sf::Vector2f& position, const sf::IntRect& textureRect, const sf::Color& color,
+                 float rotation, const sf::Vector2f& scale, const sf::Vector2f& origin)
+        {
+            positions.push_back(position);
+            textureRects.push_back(textureRect);
+            colors.push_back(color);
+            rotations.push_back(rotation);
+            scales.push_back(scale);
+            origins.push_back(origin);
+        }
+
+        void expand(std::vector<sf::Vertex>& vertices) const
+        {
+            vertices.resize(positions.size() * 6);
+            sf::priv::expandSprites(&positions[0], &textureRects[0], &colors[0], &rotations[0],
+                                    &scales[0], &origins[0], positions.size(), &vertices[0]);
+        }
+
+        std::vector<sf::Vector2f> positions;
+        std::vector<sf::IntRect>  textureRects;
+        std::vector<sf::Color>    colors;
+        std::vector<float>        rotations;
+        std::vector<sf::Vector2f> scales;
+        std::vector<sf::Vector2f> origins;
+    };
+
+    // Largest distance between the expanded corners and the ones computed by sf::Transformable
+    float maxError = 0.f;
+
+    // Check the 6 vertices of an expanded sprite against the same sprite transformed by sf::Transformable
+    void checkSprite(const Sprites& sprites, std::size_t index, const sf::Vertex* quad)
+    {
+        sf::Transformable transformable;
+        transformable.setPosition(sprites.positions[index]);
+        transformable.setRotation(sprites.rotations[index]);
+        transformable.setScale(sprites.scales[index]);
+        transformable.setOrigin(sprites.origins[index]);
+        const sf::Transform& transform = transformable.getTransform();
+
+        // Two triangles, (top-left, top-right, bottom-left) and (bottom-left, top-right, bottom-right);
+        // negative sizes of the texture rectangle flip the texture, not the geometry
+        const sf::IntRect& rect = sprites.textureRects[index];
+        float width  = static_cast<float>(std::abs(rect.width));
+        float height = static_cast<float>(std::abs(rect.height));
+        const float u[6] = {0.f, 1.f, 0.f, 0.f, 1.f, 1.f};
+        const float v[6] = {0.f, 0.f, 1.f, 1.f, 0.f, 1.f};
+
+        for (int i = 0; i < 6; ++i)
+        {
+            sf::Vector2f expected = transform.transformPoint(u[i] * width, v[i] * height);
+            maxError = std::max(maxError, std::fabs(quad[i].position.x - expected.x));
+            maxError = std::max(maxError, std::fabs(quad[i].position.y - expected.y));
+
+            CHECK(quad[i].texCoords.x == rect.left + u[i] * rect.width);
+            CHECK(quad[i].texCoords.y == rect.top + v[i] * rect.height);
+            CHECK_COLOR(quad[i].color, sprites.colors[index]);
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+/// Entry point of application
+///
+/// \return Application exit code
+///
+////////////////////////////////////////////////////////////
+int main()
+{
+    // Random sprites, with rotations, flips, negative scales and origins outside the sprite
+    Sprites sprites;
+    const std::size_t count = 1000;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        sf::Vector2f position(static_cast<float>(getRandom(-100, 900)), static_cast<float>(getRandom(-100, 700)));
+        sf::IntRect textureRect(getRandom(0, 64), getRandom(0, 64), getRandom(-32, 32), getRandom(-32, 32));
+        sf::Color color(static_cast<sf::Uint8>(getRandom(0, 255)), static_cast<sf::Uint8>(getRandom(0, 255)),
+                        static_cast<sf::Uint8>(getRandom(0, 255)), static_cast<sf::Uint8>(getRandom(0, 255)));
+        float rotation = (i % 4 == 0) ? 0.f : static_cast<float>(getRandom(0, 719)) / 2.f;
+        sf::Vector2f scale(static_cast<float>(getRandom(-20, 20)) / 8.f, static_cast<float>(getRandom(-20, 20)) / 8.f);
+        sf::Vector2f origin(static_cast<float>(getRandom(-8, 40)), static_cast<float>(getRandom(-8, 40)));
+
+        sprites.add(position, textureRect, color, rotation, scale, origin);
+    }
+
+    std::vector<sf::Vertex> vertices;
+    sprites.expand(vertices);
+    for (std::size_t i = 0; i < count; ++i)
+        checkSprite(sprites, i, &vertices[i * 6]);
+
+    // The coordinates go up to about 1000 units, single precision is good to about 1e-4 there
+    CHECK(maxError < 1e-3f);
+
+    // A sprite without transformation is its texture rectangle, moved to its position
+    Sprites simple;
+    simple.add(sf::Vector2f(10.f, 20.f), sf::IntRect(0, 0, 16, 8), sf::Color::White, 0.f, sf::Vector2f(1.f, 1.f), sf::Vector2f(0.f, 0.f));
+    simple.expand(vertices);
+    if (CHECK(vertices.size() == 6))
+    {
+        CHECK(vertices[0].position == sf::Vector2f(10.f, 20.f));
+        CHECK(vertices[5].position == sf::Vector2f(26.f, 28.f));
+        CHECK(vertices[5].texCoords == sf::Vector2f(16.f, 8.f));
+        CHECK_COLOR(vertices[0].color, sf::Color::White);
+    }
+
+    // A sprite with an empty texture rectangle, like the default ones of sf::SpriteBatch::resize, is degenerate
+    Sprites empty;
+    empty.add(sf::Vector2f(3.f, 4.f), sf::IntRect(), sf::Color::White, 0.f, sf::Vector2f(1.f, 1.f), sf::Vector2f(0.f, 0.f));
+    empty.expand(vertices);
+    if (CHECK(vertices.size() == 6))
+    {
+        for (int i = 1; i < 6; ++i)
+            CHECK(vertices[i].position == vertices[0].position);
+    }
+
+    return getExitCode();
+}
@@ -0,0 +1,222 @@
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/TextureCache.hpp>
+#include <TestUtilities.hpp>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+
+namespace
+{
+    // Loader that doesn't touch the textures, so that no OpenGL call is made;
+    // it records the loads and unloads, and reports the sizes it's told to
+    class MockLoader : public sf::TextureCache::Loader
+    {
+    public:
+
+        virtual bool load(const std::string& key, sf::Texture& texture)
+        {
+            events.push_back("load " + key);
+            if (failing.count(key))
+                return false;
+
+            keys[&texture] = key;
+            return true;
+        }
+
+        virtual void unload(sf::Texture& texture)
+        {
+            events.push_back("unload " + keys[&texture]);
+            keys.erase(&texture);
+        }
+
+        virtual std::size_t getMemoryUsage(const sf::Texture& texture)
+        {
+            std::map<std::string, std::size_t>::const_iterator it = sizes.find(keys[&texture]);
+            return (it != sizes.end()) ? it->second : 100;
+        }
+
+        // Get the recorded events, and forget them
+        std::string takeEvents()
+        {
+            std::string result;
+            for (std::size_t i = 0; i < events.size(); ++i)
+                result += (i > 0 ? ", " : "") + events[i];
+
+            events.clear();
+            return result;
+        }
+
+        std::map<const sf::Texture*, std::string> keys;
+        std::map<std::string, std::size_t>       sizes;
+        std::set<std::string>                    failing;
+        std::vector<std::string>                 events;
+    };
+
+    bool checkEvents(MockLoader& loader, const std::string& expected)
+    {
+        std::string events = loader.takeEvents();
+        if (events != expected)
+            std::cerr << "events are \"" << events << "\", expected \"" << expected << "\"" << std::endl;
+
+        return CHECK(events == expected);
+    }
+
+    // Check which of the keys "a" to "e" are resident
+    bool checkResident(const sf::TextureCache& cache, const std::string& expected)
+    {
+        std::string resident;
+        for (char key = 'a'; key <= 'e'; ++key)
+        {
+            if (cache.isResident(std::string(1, key)))
+                resident += key;
+        }
+
+        if (resident != expected)
+            std::cerr << "resident textures are \"" << resident << "\", expected \"" << expected << "\"" << std::endl;
+
+        return CHECK(resident == expected);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+/// Entry point of application
+///
+/// \return Application exit code
+///
+////////////////////////////////////////////////////////////
+int main()
+{
+    // Textures are loaded on the first request only, and the requests are counted
+    {
+        MockLoader loader;
+        sf::TextureCache cache(0, &loader);
+        sf::Texture* a = cache.get("a");
+        CHECK(a != NULL);
+        CHECK(cache.get("b") != NULL);
+        CHECK(cache.get("a") == a);
+        CHECK(cache.get("a") == a);
+        checkEvents(loader, "load a, load b");
+
+        sf::TextureCache::Statistics statistics = cache.getStatistics();
+        CHECK((statistics.hits == 2) && (statistics.misses == 2) && (statistics.failures == 0) && (statistics.evictions == 0));
+        CHECK(statistics.hitRate == 0.5f);
+        CHECK((statistics.textureCount == 2) && (statistics.residentCount == 2) && (statistics.residentBytes == 200));
+
+        // Resetting the counters doesn't unload anything
+        cache.resetStatistics();
+        statistics = cache.getStatistics();
+        CHECK((statistics.hits == 0) && (statistics.misses == 0) && (statistics.hitRate == 0.f));
+        CHECK((statistics.residentCount == 2) && (statistics.residentBytes == 200));
+        checkResident(cache, "ab");
+    }
+
+    // The least recently used textures are evicted first
+    {
+        MockLoader loader;
+        sf::TextureCache cache(300, &loader);
+        cache.get("a");
+        cache.get("b");
+        cache.get("c");
+        cache.get("a");
+        checkEvents(loader, "load a, load b, load c");
+
+        cache.get("d");
+        checkEvents(loader, "load d, unload b");
+        checkResident(cache, "acd");
+
+        cache.get("b");
+        checkEvents(loader, "load b, unload c");
+        checkResident(cache, "abd");
+
+        sf::TextureCache::Statistics statistics = cache.getStatistics();
+        CHECK((statistics.hits == 1) && (statistics.misses == 5) && (statistics.evictions == 2));
+        CHECK((statistics.textureCount == 4) && (statistics.residentCount == 3) && (statistics.residentBytes == 300));
+
+        // Shrinking the budget evicts immediately, from the least recently used
+        cache.setBudget(150);
+        CHECK(cache.getBudget() == 150);
+        checkEvents(loader, "unload a, unload d");
+        checkResident(cache, "b");
+        CHECK(cache.getStatistics().evictions == 4);
+        CHECK(cache.getStatistics().residentBytes == 100);
+
+        // No budget, no eviction
+        cache.setBudget(0);
+        cache.get("a");
+        cache.get("c");
+        cache.get("d");
+        checkEvents(loader, "load a, load c, load d");
+        checkResident(cache, "abcd");
+    }
+
+    // A texture larger than the budget evicts all the others, but stays resident itself
+    {
+        MockLoader loader;
+        loader.sizes["e"] = 500;
+        sf::TextureCache cache(300, &loader);
+        cache.get("a");
+        cache.get("b");
+        CHECK(cache.get("e") != NULL);
+        checkEvents(loader, "load a, load b, load e, unload a, unload b");
+        checkResident(cache, "e");
+        CHECK(cache.getStatistics().residentBytes == 500);
+
+        // The next one evicts it
+        cache.get("a");
+        checkEvents(loader, "load a, unload e");
+        checkResident(cache, "a");
+    }
+
+    // Failed loads are counted, leave nothing resident, and are retried on the next request
+    {
+        MockLoader loader;
+        loader.failing.insert("c");
+        sf::TextureCache cache(200, &loader);
+        cache.get("a");
+        cache.get("b");
+        CHECK(cache.get("c") == NULL);
+        CHECK(cache.get("c") == NULL);
+        checkEvents(loader, "load a, load b, load c, load c");
+        checkResident(cache, "ab");
+
+        sf::TextureCache::Statistics statistics = cache.getStatistics();
+        CHECK((statistics.misses == 4) && (statistics.failures == 2) && (statistics.evictions == 0));
+        CHECK((statistics.residentCount == 2) && (statistics.residentBytes == 200));
+
+        loader.failing.clear();
+        CHECK(cache.get("c") != NULL);
+        checkEvents(loader, "load c, unload a");
+    }
+
+    // Removed textures are unloaded, and so are all the textures when the cache is cleared or destroyed
+    {
+        MockLoader loader;
+        {
+            sf::TextureCache cache(0, &loader);
+            cache.get("a");
+            cache.get("b");
+            cache.get("c");
+            cache.remove("b");
+            cache.remove("e");
+            checkEvents(loader, "load a, load b, load c, unload b");
+            checkResident(cache, "ac");
+            CHECK((cache.getStatistics().textureCount == 2) && (cache.getStatistics().residentBytes == 200));
+
+            cache.clear();
+            checkEvents(loader, "unload a, unload c");
+            CHECK((cache.getStatistics().textureCount == 0) && (cache.getStatistics().residentBytes == 0));
+
+            cache.get("d");
+        }
+        checkEvents(loader, "load d, unload d");
+    }
+
+    return getExitCode();
+}
@@ -0,0 +1,69 @@
+#ifndef SFML_TESTUTILITIES_HPP
+#define SFML_TESTUTILITIES_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Color.hpp>
+#include <cstdlib>
+#include <iostream>
+
+
+////////////////////////////////////////////////////////////
+/// Check a condition; a failed check is reported with its
+/// location, and makes the test fail without stopping it
+///
+////////////////////////////////////////////////////////////
+#define CHECK(condition) checkCondition((condition), #condition, __FILE__, __LINE__)
+
+////////////////////////////////////////////////////////////
+/// Check that two colors are equal, reporting both if not
+///
+////////////////////////////////////////////////////////////
+#define CHECK_COLOR(actual, expected) checkColor((actual), (expected), #actual, __FILE__, __LINE__)
+
+
+namespace
+{
+    // Number of failed checks
+    int failureCount = 0;
+
+    inline bool checkCondition(bool condition, const char* expression, const char* file, int line)
+    {
+        if (!condition)
+        {
+            std::cerr << file << ":" << line << ": check failed: " << expression << std::endl;
+            ++failureCount;
+        }
+
+        return condition;
+    }
+
+    inline bool checkColor(const sf::Color& actual, const sf::Color& expected, const char* expression, const char* file, int line)
+    {
+        if (actual != expected)
+        {
+            std::cerr << file << ":" << line << ": check failed: " << expression
+                      << " is (" << int(actual.r) << ", " << int(actual.g) << ", " << int(actual.b) << ", " << int(actual.a) << ")"
+                      << ", expected (" << int(expected.r) << ", " << int(expected.g) << ", " << int(expected.b) << ", " << int(expected.a) << ")"
+                      << std::endl;
+            ++failureCount;
+        }
+
+        return actual == expected;
+    }
+
+    // Exit code of the test, reporting the number of failed checks
+    inline int getExitCode()
+    {
+        if (failureCount > 0)
+        {
+            std::cerr << failureCount << " check(s) failed" << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        return EXIT_SUCCESS;
+    }
+}
+
+#endif // SFML_TESTUTILITIES_HPP